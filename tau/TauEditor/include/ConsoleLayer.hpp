@@ -5,11 +5,14 @@
 #include <vector>
 #include <String.hpp>
 #include <console/ConsoleController.hpp>
+#include <console/ConsoleVariable.hpp>
 #include <events/WindowEvent.hpp>
 #include <camera/Camera3D.hpp>
+#include <allocator/AllocationTracker.hpp>
 #include "State.hpp"
 #include "TextHandler.hpp"
 #include "GameRecorder.hpp"
+#include "I18n.hpp"
 #include "Globals.hpp"
 
 class Camera2DController;
@@ -28,7 +31,7 @@ private:
     const GlyphSetHandle& _consolasBoldItalic;
     const glm::mat4& _ortho;
     Camera3D& _camera;
-    float _textScale;
+    Console::CVar<f32> _textScale;
 
     Console::Controller _ch;
     std::vector<DynString> _strings;
@@ -123,7 +126,7 @@ public:
     { }
 
     [[nodiscard]] const char* name() const noexcept override { return "gr"; }
-    [[nodiscard]] const char* usage() const noexcept override { return "gr <cmd{enum{start|stop|play}}>"; }
+    [[nodiscard]] const char* usage() const noexcept override { return "gr <cmd{enum{start|stop|play|seek}}> <(start|play)[file{path}]> <(seek)<frame{u32}>>"; }
     [[nodiscard]] const char* info() const noexcept override { return "Controls the game recorder."; }
     [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept override;
 };
@@ -142,3 +145,40 @@ public:
     [[nodiscard]] const char* info() const noexcept override { return "Sets the saturation level."; }
     [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept override;
 };
+
+class ShaderBundleCommand final : public Console::Command
+{
+public:
+    [[nodiscard]] const char* name() const noexcept override { return "shaderBundle"; }
+    [[nodiscard]] const char* usage() const noexcept override { return "shaderBundle <cmd{enum{compile}}> <in{path}> <out{path}>"; }
+    [[nodiscard]] const char* info() const noexcept override { return "Compiles a text shader bundle into its binary form."; }
+    [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept override;
+};
+
+class I18nCommand final : public Console::Command
+{
+private:
+    I18n _i18n;
+public:
+    [[nodiscard]] const char* name() const noexcept override { return "i18n"; }
+    [[nodiscard]] const char* usage() const noexcept override { return "i18n <cmd{enum{compile|load|get}}> <(compile)<in{path}> <out{path}>> <(load)<file{path}>> <(get)<key{string}>>"; }
+    [[nodiscard]] const char* info() const noexcept override { return "Compiles legacy language files, or loads and queries a language."; }
+    [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept override;
+};
+
+class MemoryCommand final : public Console::Command
+{
+private:
+    AllocationTracker::Snapshot _baseline;
+public:
+    MemoryCommand() noexcept
+        : _baseline(AllocationTracker::snapshot())
+    { }
+
+    [[nodiscard]] const char* name() const noexcept override { return "memory"; }
+    [[nodiscard]] const char* usage() const noexcept override { return "memory snapshot|diff|profile|budget <tag{str}> <softKiB{u32}> <hardKiB{u32}>"; }
+    [[nodiscard]] const char* info() const noexcept override { return "Shows the memory of each allocation tag, the change since the last snapshot, sets tag budgets, or writes the tags to the profile."; }
+    [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept override;
+private:
+    static void print(const AllocationTracker::Snapshot& snapshot, Console::Controller* consoleHandler) noexcept;
+};
@@ -4,6 +4,7 @@
 #include <vector>
 #include <Safeties.hpp>
 #include <camera/Camera3D.hpp>
+#include <renderer/CullingBVH.hpp>
 #include <shader/ShaderProgram.hpp>
 #include <shader/Uniform.hpp>
 #include <texture/Texture.hpp>
@@ -78,6 +79,11 @@ private:
     glm::mat4 _modelViewMatrix;
 
     std::vector<CPPRef<RenderableObject>> _objects;
+    CullingBVH _culling;
+    /**
+     * Indices into _objects, refilled every frame.
+     */
+    std::vector<u32> _visibleObjects;
 
     vr::TrackedDevicePose_t _poses[vr::k_unMaxTrackedDeviceCount];
     vr::TrackedDevicePose_t _validPoses[vr::k_unMaxTrackedDeviceCount];
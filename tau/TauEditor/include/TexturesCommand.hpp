@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Objects.hpp>
+#include <console/ConsoleController.hpp>
+#include "Globals.hpp"
+
+/**
+ *   Measures the time to first frame of a scene of textures,
+ * which needs a graphics device. Decode throughput is measured
+ * without one by the TextureDecode benchmarks in UnitTest.
+ */
+class TexturesCommand final : public Console::Command
+{
+private:
+    Globals& _globals;
+public:
+    TexturesCommand(Globals& globals) noexcept
+        : _globals(globals)
+    { }
+
+    [[nodiscard]] const char* name() const noexcept override { return "textures"; }
+    [[nodiscard]] const char* usage() const noexcept override { return "textures bench <file{path}> [count{u32}]"; }
+    [[nodiscard]] const char* info() const noexcept override { return "Compares loading a scene of textures one at a time against decoding them on worker threads."; }
+    [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept override;
+private:
+    i32 bench(const char* path, u32 count, Console::Controller* consoleHandler) noexcept;
+};
@@ -0,0 +1,23 @@
+#version 430 core
+
+in VertexData 
+{
+    vec2 texCoord;
+} vertexIn;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(binding = 1) uniform Color
+{
+    vec4 textColor;
+};
+
+layout(location = 0) uniform sampler2D textBMP;
+
+void main()
+{
+    float dist = texture(textBMP, vertexIn.texCoord).r;
+    // Half a screen pixel of distance either side of the edge.
+    float width = fwidth(dist) * 0.5;
+    fragColor = vec4(textColor.xyz, smoothstep(0.5 - width, 0.5 + width, dist));
+}
@@ -0,0 +1,22 @@
+struct PSInput
+{
+    float4 position : SV_POSITION;
+    float2 texCoord : TEXCOORD;
+};
+
+cbuffer Color : register(b1)
+{
+    float4 textColor;
+};
+
+Texture2D<float> textBMP;
+SamplerState textBMPSampler;
+
+float4 psMain(PSInput input) : SV_TARGET
+{
+    float dist = textBMP.Sample(textBMPSampler, input.texCoord);
+    // Half a screen pixel of distance either side of the edge.
+    float width = fwidth(dist) * 0.5;
+    
+    return float4(textColor.xyz, smoothstep(0.5 - width, 0.5 + width, dist));
+}
@@ -5,15 +5,21 @@
 #include <Windows.h>
 #include <EnumBitFields.hpp>
 #include <system/Window.hpp>
+#include <shader/bundle/ShaderBundleBinary.hpp>
+#include <Timings.hpp>
+#include <VFS.hpp>
+#include <thread>
+#include <algorithm>
 
 #include "TERenderer.hpp"
 #include "ControlEvent.hpp"
+#include "TexturesCommand.hpp"
 
 ConsoleLayer::ConsoleLayer(Globals& globals, TextHandler& th, const GlyphSetHandle& consolas, const GlyphSetHandle& consolasBold, const GlyphSetHandle& consolasItalic, const GlyphSetHandle& consolasBoldItalic, const glm::mat4& ortho, Camera3D& camera, float textScale) noexcept
     : ILayer(false),
       _globals(globals), _th(th),
       _consolas(consolas), _consolasBold(consolasBold), _consolasItalic(consolasItalic), _consolasBoldItalic(consolasBoldItalic),
-      _ortho(ortho), _camera(camera), _textScale(textScale),
+      _ortho(ortho), _camera(camera), _textScale("con_textScale", "The text scale of the console.", textScale),
       _ch({ ccPrint, ccPrintLn, ccPrintNL, ccPrintF }, this),
       _strings(), _lineBuilder(), _inputBuilder(), _columnMarker(true)
 {
@@ -22,13 +28,19 @@ ConsoleLayer::ConsoleLayer(Globals& globals, TextHandler& th, const GlyphSetHand
     _ch.addCommand(new SetCameraCommand(this));
     _ch.addCommand(new GameRecorderCommand(globals.gr));
     _ch.addCommand(new SetSaturationCommand(globals));
+    _ch.addCommand(new ShaderBundleCommand);
+    _ch.addCommand(new I18nCommand);
+    _ch.addCommand(new TexturesCommand(globals));
+    _ch.addCommand(new MemoryCommand);
     // _ch.addCommand(new LoadFontCommand(th, rl));
     _ch.addCommand(new Console::dc::BoolAliasCommand);
     _ch.addCommand(new Console::dc::ExitCommand);
     _ch.addCommand(new Console::dc::ParseNumCommand);
     _ch.addCommand(new Console::dc::AliasCommand);
+    _ch.addCommand(new Console::dc::ExecCommand);
     _ch.addCommand(new Console::dc::HelpCommand);
     _ch.addCommand(new Console::dc::InfoCommand);
+    _ch.addCVar(&_textScale);
 }
 
 void ConsoleLayer::print(const DynString& str) noexcept
@@ -41,7 +53,8 @@ void ConsoleLayer::onRender() noexcept
     if(_visible && _consolas)
     {
         constexpr float xOffset = 5.0f;
-        const float textOffset = 50.0f * _textScale;
+        const float textScale = _textScale.get();
+        const float textOffset = 50.0f * textScale;
         const float maxY = 0.0f;
         float y = static_cast<float>(_globals.window.height() / 2 - textOffset);
         const float x = -static_cast<float>(_globals.window.width() / 2) + xOffset;
@@ -50,17 +63,17 @@ void ConsoleLayer::onRender() noexcept
         { _inputBuilder.append('|'); }
         else
         { _inputBuilder.append(' '); }
-        y += _th.renderTextLineWrapped(_globals.rc, _consolas, _inputBuilder.c_str(), x, y, _textScale, { 0, 255, 255 }, _ortho, _globals.window, -textOffset);
+        y += _th.renderTextLineWrapped(_globals.rc, _consolas, _inputBuilder.c_str(), x, y, textScale, { 0, 255, 255 }, _ortho, _globals.window, -textOffset);
         _inputBuilder.backspace();
 
         if(_lineBuilder.length() > 0)
         {
-            y += _th.renderTextLineWrapped(_globals.rc, _consolas, _lineBuilder.c_str(), x, y, _textScale, { 0, 120, 255 }, _ortho, _globals.window, -textOffset);
+            y += _th.renderTextLineWrapped(_globals.rc, _consolas, _lineBuilder.c_str(), x, y, textScale, { 0, 120, 255 }, _ortho, _globals.window, -textOffset);
         }
 
         for(auto it = _strings.rbegin(); it != _strings.rend(); ++it)
         {
-            y += _th.renderTextLineWrapped(_globals.rc, _consolas, *it, x, y, _textScale, { 255, 255, 255 }, _ortho, _globals.window, -textOffset);
+            y += _th.renderTextLineWrapped(_globals.rc, _consolas, *it, x, y, textScale, { 255, 255, 255 }, _ortho, _globals.window, -textOffset);
             if(y - textOffset < maxY)
             { break; }
         }
@@ -70,6 +83,8 @@ void ConsoleLayer::onRender() noexcept
 void ConsoleLayer::onUpdate(const float fixedDelta) noexcept
 {
     UNUSED(fixedDelta);
+    _ch.flushCVarChanges();
+
     static u64 _count = 0;
     ++_count;
     if(_count >= 16)
@@ -198,7 +213,7 @@ i32 SetTextScaleCommand::execute(const char* commandName, const char* args[], u3
     {
         Console::ParseIntError error;
         const float scale = consoleHandler->parseF32(args[0], &error);
-        _cl->_textScale = scale;
+        _cl->_textScale.set(scale);
         return 0;
     }
     return 1;
@@ -269,7 +284,7 @@ i32 SetCameraCommand::execute(const char* commandName, const char* args[], u32 a
 i32 GameRecorderCommand::execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept
 {
     UNUSED(commandName);
-    if(argCount != 1)
+    if(argCount < 1 || argCount > 2)
     {
         consoleHandler->printf("Usage: %s", usage());
         return 1;
@@ -277,18 +292,47 @@ i32 GameRecorderCommand::execute(const char* commandName, const char* args[], u3
 
     if(strcmp(args[0], "start") == 0)
     {
-        _gr.startRecording();
+        if(argCount == 2)
+        { _gr.startRecording(VFS::Instance().openFile(args[1], FileProps::WriteOverwrite)); }
+        else
+        { _gr.startRecording(); }
         consoleHandler->println("Started recording.");
     }
     else if(strcmp(args[0], "stop") == 0)
     {
         _gr.stopRecording();
-        consoleHandler->println("Stopped recording.");
+        consoleHandler->printf("Stopped recording, %u frames.", _gr.frameCount());
     }
     else if(strcmp(args[0], "play") == 0)
     {
+        if(argCount == 2 && !_gr.openReplay(VFS::Instance().openFile(args[1], FileProps::Read)))
+        {
+            consoleHandler->printf("Unable to open replay `%s`.", args[1]);
+            return -1;
+        }
         _gr.beginPlayBack();
     }
+    else if(argCount == 2 && strcmp(args[0], "seek") == 0)
+    {
+        Console::ParseIntError error;
+        const u32 frame = consoleHandler->parseU32(args[1], &error);
+        if(error != Console::ParseIntError::None)
+        {
+            consoleHandler->printf("Invalid frame `%s`.", args[1]);
+            return -1;
+        }
+
+        if(!_gr.seek(frame))
+        {
+            consoleHandler->printf("Unable to seek to frame %u of %u.", frame, _gr.frameCount());
+            return -1;
+        }
+    }
+    else
+    {
+        consoleHandler->printf("Usage: %s", usage());
+        return 1;
+    }
 
     return 0;
 }
@@ -330,3 +374,173 @@ i32 SetSaturationCommand::execute(const char* commandName, const char* args[], u
 
     return 0;
 }
+
+i32 ShaderBundleCommand::execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept
+{
+    UNUSED(commandName);
+    if(argCount == 3 && strcmp(args[0], "compile") == 0)
+    {
+        const CPPRef<IFile> input = VFS::Instance().openFile(args[1], FileProps::Read);
+        const CPPRef<IFile> output = VFS::Instance().openFile(args[2], FileProps::WriteOverwrite);
+
+        ShaderBundleCompiler::Error error;
+        if(!ShaderBundleCompiler::compile(input, output, &error))
+        {
+            consoleHandler->printf("Failed to compile `%s`, error %d.", args[1], static_cast<int>(error));
+            return -1;
+        }
+
+        consoleHandler->printf("Compiled `%s` to `%s`.", args[1], args[2]);
+        return 0;
+    }
+    consoleHandler->printf("Usage: %s", usage());
+    return 1;
+}
+
+i32 I18nCommand::execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept
+{
+    UNUSED(commandName);
+    if(argCount == 3 && strcmp(args[0], "compile") == 0)
+    {
+        const CPPRef<IFile> input = VFS::Instance().openFile(args[1], FileProps::Read);
+        const CPPRef<IFile> output = VFS::Instance().openFile(args[2], FileProps::WriteOverwrite);
+
+        I18nTableBuilder::Error error;
+        if(!I18nTableBuilder::compile(input, output, &error))
+        {
+            consoleHandler->printf("Failed to compile `%s`, error %d.", args[1], static_cast<int>(error));
+            return -1;
+        }
+
+        consoleHandler->printf("Compiled `%s` to `%s`.", args[1], args[2]);
+        return 0;
+    }
+    else if(argCount == 2 && strcmp(args[0], "load") == 0)
+    {
+        const u64 start = microTime();
+        if(!_i18n.loadTranslations(VFS::Instance().openFile(args[1], FileProps::Read)))
+        {
+            consoleHandler->printf("Failed to load `%s`.", args[1]);
+            return -1;
+        }
+        const u64 time = microTime() - start;
+
+        consoleHandler->printf("Loaded %u translations for `%ls` in %lluus.", _i18n.count(), _i18n.language(), time);
+        return 0;
+    }
+    else if(argCount == 2 && strcmp(args[0], "get") == 0)
+    {
+        I18n::Error error;
+        const wchar_t* const translation = _i18n.translate(args[1], &error);
+        if(error != I18n::Error::NoError)
+        {
+            consoleHandler->printf("Unknown translation key `%s`.", args[1]);
+            return 1;
+        }
+
+        consoleHandler->printf("%ls", translation);
+        return 0;
+    }
+
+    consoleHandler->printf("Usage: %s", usage());
+    return 1;
+}
+
+i32 MemoryCommand::execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept
+{
+    UNUSED(commandName);
+    if(argCount == 1 && strcmp(args[0], "snapshot") == 0)
+    {
+        _baseline = AllocationTracker::snapshot();
+        print(_baseline, consoleHandler);
+        return 0;
+    }
+
+    if(argCount == 1 && strcmp(args[0], "diff") == 0)
+    {
+        const AllocationTracker::Snapshot current = AllocationTracker::snapshot();
+        consoleHandler->printf("Since the last snapshot:");
+        print(AllocationTracker::diff(_baseline, current), consoleHandler);
+        return 0;
+    }
+
+    if(argCount == 1 && strcmp(args[0], "profile") == 0)
+    {
+        TimingsWriter::writeMemory(AllocationTracker::snapshot());
+        consoleHandler->printf("Wrote the allocation tags to the profile.");
+        return 0;
+    }
+
+    if(argCount == 4 && strcmp(args[0], "budget") == 0)
+    {
+        Console::ParseIntError error;
+        const u32 softKiB = consoleHandler->parseU32(args[2], &error);
+        if(error != Console::ParseIntError::None)
+        {
+            consoleHandler->printf("Invalid soft budget `%s`.", args[2]);
+            return -1;
+        }
+
+        const u32 hardKiB = consoleHandler->parseU32(args[3], &error);
+        if(error != Console::ParseIntError::None)
+        {
+            consoleHandler->printf("Invalid hard budget `%s`.", args[3]);
+            return -1;
+        }
+
+        const AllocationTag tag = AllocationTracker::registerTag(args[1]);
+        if(tag == AllocationTracker::Untagged)
+        {
+            consoleHandler->printf("Every allocation tag is in use.");
+            return 1;
+        }
+
+        AllocationTracker::setBudget(tag, static_cast<u64>(softKiB) * 1024, static_cast<u64>(hardKiB) * 1024);
+        consoleHandler->printf("Budget of %s set to %uKiB soft, %uKiB hard.", AllocationTracker::tagName(tag), softKiB, hardKiB);
+        return 0;
+    }
+
+    consoleHandler->printf("Usage: %s", usage());
+    return 1;
+}
+
+void MemoryCommand::print(const AllocationTracker::Snapshot& snapshot, Console::Controller* consoleHandler) noexcept
+{
+    consoleHandler->printf("%-20s %12s %12s %10s %10s %9s %s", "Tag", "KiB", "Peak KiB", "Allocs", "Live", "Rejected", "Budget KiB");
+    for(const AllocationTracker::TagStats& tag : snapshot.tags)
+    {
+        if(!tag.allocations && !tag.bytes)
+        { continue; }
+
+        const bool overSoft = tag.softBudget && tag.bytes > 0 && static_cast<u64>(tag.bytes) > tag.softBudget;
+        consoleHandler->printf("%-20s %12.1f %12.1f %10lld %10lld %9lld %llu/%llu%s", tag.name,
+                               static_cast<double>(tag.bytes) / 1024.0, static_cast<double>(tag.peakBytes) / 1024.0,
+                               tag.allocations, tag.liveAllocations, tag.rejected,
+                               tag.softBudget / 1024, tag.hardBudget / 1024, overSoft ? " OVER" : "");
+    }
+
+    if(snapshot.callSites.empty())
+    { return; }
+
+    /**
+     *   Each sample stands for `sampleInterval` allocations, so
+     * the sampled bytes scaled by it estimate the bytes
+     * allocated from the call site.
+     */
+    ::std::vector<const AllocationTracker::CallSite*> sites;
+    sites.reserve(snapshot.callSites.size());
+    for(const AllocationTracker::CallSite& site : snapshot.callSites)
+    { sites.push_back(&site); }
+
+    const uSys shown = ::std::min(sites.size(), static_cast<uSys>(8));
+    ::std::partial_sort(sites.begin(), sites.begin() + shown, sites.end(), [](const AllocationTracker::CallSite* a, const AllocationTracker::CallSite* b) { return a->sampledBytes > b->sampledBytes; });
+
+    consoleHandler->printf("Top call sites, sampled every %llu allocations:", snapshot.sampleInterval);
+    for(uSys i = 0; i < shown; ++i)
+    {
+        const AllocationTracker::CallSite& site = *sites[i];
+        consoleHandler->printf("  %s: %lld samples, ~%.1f KiB", AllocationTracker::tagName(site.tag), site.samples, static_cast<double>(site.sampledBytes) * static_cast<double>(snapshot.sampleInterval) / 1024.0);
+        for(u32 j = 0; j < site.depth && j < 4; ++j)
+        { consoleHandler->printf("    %p", site.frames[j]); }
+    }
+}
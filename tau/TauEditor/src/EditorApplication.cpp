@@ -19,6 +19,7 @@
 #include <graphics/DepthStencilState.hpp>
 #include <graphics/RasterizerState.hpp>
 #include <graphics/BlendingState.hpp>
+#include <graphics/StateCache.hpp>
 
 #include <vr/VRUtils.hpp>
 
@@ -148,7 +149,7 @@ bool TauEditorApplication::init(int argCount, char* args[]) noexcept
         const DepthStencilArgs dsArgs(tau::rec);
 
         IDepthStencilStateBuilder::Error error;
-        const NullableRef<IDepthStencilState> dsState = _graphicsInterface->createDepthStencilState().buildTauRef(dsArgs, &error);
+        const NullableRef<IDepthStencilState> dsState = _graphicsInterface->stateCache().depthStencilState(dsArgs, &error);
 
         if(error != IDepthStencilStateBuilder::Error::NoError)
         {
@@ -168,7 +169,7 @@ bool TauEditorApplication::init(int argCount, char* args[]) noexcept
         const RasterizerArgs rsArgs(tau::rec);
 
         IRasterizerStateBuilder::Error error;
-        const NullableRef<IRasterizerState> rsState = _graphicsInterface->createRasterizerState().buildTauRef(rsArgs, &error);
+        const NullableRef<IRasterizerState> rsState = _graphicsInterface->stateCache().rasterizerState(rsArgs, &error);
 
         if(error != IRasterizerStateBuilder::Error::NoError)
         {
@@ -194,7 +195,7 @@ bool TauEditorApplication::init(int argCount, char* args[]) noexcept
         bsArgs.frameBuffers[0].alphaDstFactor = BlendingArgs::BlendFactor::InvSrcAlpha;
 
         IBlendingStateBuilder::Error error;
-        const NullableRef<IBlendingState> bsState = _graphicsInterface->createBlendingState().buildTauRef(bsArgs, &error);
+        const NullableRef<IBlendingState> bsState = _graphicsInterface->stateCache().blendingState(bsArgs, &error);
 
         if(error != IBlendingStateBuilder::Error::NoError)
         {
@@ -238,6 +239,9 @@ bool TauEditorApplication::init(int argCount, char* args[]) noexcept
     _renderer = new TERenderer(*_globals);
     _globals->renderer = _renderer;
 
+    if(_renderer->textHandler().sdfShaderError() != IShaderBuilder::Error::NoError)
+    { _logger->error("Unable to build the SDF text shader, error {}. SDF glyph sets are disabled.", static_cast<int>(_renderer->textHandler().sdfShaderError())); }
+
     if(_config.useVR)
     {
         if(vr::VR_IsRuntimeInstalled() && vr::VR_IsHmdPresent())
@@ -312,6 +316,11 @@ void TauEditorApplication::onException(ExceptionData& ex) noexcept
 void TauEditorApplication::update(const float fixedDelta) noexcept
 {
     PERF();
+    if(_gr.recording())
+    { _gr.addBeginUpdate(); }
+    else if(_gr.playing())
+    { _gr.playUpdate(); }
+
     ResourceLoader::update();
     _renderer->update(fixedDelta);
 }
@@ -319,6 +328,10 @@ void TauEditorApplication::update(const float fixedDelta) noexcept
 void TauEditorApplication::render(const DeltaTime& delta) noexcept
 {
     PERF();
+    if(_gr.recording())
+    { _gr.addBeginRender(); }
+    else if(_gr.playing())
+    { _gr.playRender(); }
 
     if(_vr)
     {
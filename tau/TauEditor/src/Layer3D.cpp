@@ -9,10 +9,13 @@
 #include "texture/FITextureLoader.hpp"
 #include "Timings.hpp"
 #include "system/GraphicsInterface.hpp"
+#include "graphics/StateCache.hpp"
 #include <EnumBitFields.hpp>
 #include "TERenderer.hpp"
 #include "ControlEvent.hpp"
 #include "model/MeshGenerator.hpp"
+#include <algorithm>
+#include <cmath>
 
 #include "system/SystemInterface.hpp"
 #include <shader/bundle/ShaderBundleParser.hpp>
@@ -259,6 +262,18 @@ Layer3D::Layer3D(Globals& globals) noexcept
     // _modelViewMatrix = glmExt::rotateDegrees(_modelViewMatrix, 180.0f, glm::vec3(1.0f, 0.0f, 0.0f));
     _uniforms.data().modelMatrix = _modelViewMatrix;
 
+    {
+        // The largest scale of the model matrix, for transforming the bounding spheres.
+        const float scale = ::std::sqrt(::std::max({ glm::dot(glm::vec3(_modelViewMatrix[0]), glm::vec3(_modelViewMatrix[0])),
+                                                     glm::dot(glm::vec3(_modelViewMatrix[1]), glm::vec3(_modelViewMatrix[1])),
+                                                     glm::dot(glm::vec3(_modelViewMatrix[2]), glm::vec3(_modelViewMatrix[2])) }));
+        for(uSys i = 0; i < _objects.size(); ++i)
+        {
+            const RenderableObject& ro = *_objects[i];
+            (void) _culling.insert(ro.bounds().transform(_modelViewMatrix), ro.boundingRadius() * scale, static_cast<u32>(i));
+        }
+    }
+
     _pointLight.position() = Vector3f(0.0f, 10.0f, 5.0f);
     _pointLight.ambient({255, 255, 255});
     _pointLight.diffuse({255, 255, 255});
@@ -291,7 +306,7 @@ Layer3D::Layer3D(Globals& globals) noexcept
         bsArgs.frameBuffers[0].alphaDstFactor = BlendingArgs::BlendFactor::InvSrcAlpha;
 
         IBlendingStateBuilder::Error error;
-        _deferredBSState = globals.gi.createBlendingState().buildTauRef(bsArgs, &error);
+        _deferredBSState = globals.gi.stateCache().blendingState(bsArgs, &error);
 
         if(error != IBlendingStateBuilder::Error::NoError)
         {
@@ -355,7 +370,7 @@ void Layer3D::onUpdate(float fixedDelta) noexcept
 {
     PERF();
 
-    if(_globals.gameState == State::Game && !_globals.vr)
+    if(_globals.gameState == State::Game && !_globals.vr && !_globals.gr.playing())
     {
         const u32 screenCenterW = _globals.window.width() >> 1;
         const u32 screenCenterH = _globals.window.height() >> 1;
@@ -443,10 +458,14 @@ void Layer3D::onRender() noexcept
             _shader->bind(context);
             _uniforms.data().viewMatrix = _camera->viewMatrix();
 
+            _culling.maintain();
+            _culling.cull(_camera->frustum(), _visibleObjects);
+
             _uniforms.upload(context, EShader::Stage::Vertex, _bindMap.mapUniformBindPoint(0, EShader::Stage::Vertex));
             // _uniforms.upload(context, EShader::Stage::Vertex, 0);
-            for(const CPPRef<RenderableObject>& ro : _objects)
+            for(const u32 index : _visibleObjects)
             {
+                const CPPRef<RenderableObject>& ro = _objects[index];
                 TextureIndices indices(0, 0, 0, &_bindMap);
                 // TextureIndices indices(0, 0, 0, null);
                 ro->material().upload(context, _materialUniforms, EShader::Stage::Pixel, _bindMap.mapUniformBindPoint(0, EShader::Stage::Pixel), indices);
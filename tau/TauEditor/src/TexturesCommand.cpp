@@ -0,0 +1,60 @@
+#include "TexturesCommand.hpp"
+#include <texture/FITextureLoader.hpp>
+#include <Timings.hpp>
+#include <cstring>
+#include <vector>
+
+i32 TexturesCommand::execute(const char* commandName, const char* args[], u32 argCount, Console::Controller* consoleHandler) noexcept
+{
+    UNUSED(commandName);
+    if((argCount == 2 || argCount == 3) && strcmp(args[0], "bench") == 0)
+    {
+        u32 count = 500;
+        if(argCount == 3)
+        {
+            Console::ParseIntError error;
+            count = consoleHandler->parseU32(args[2], &error);
+            if(error != Console::ParseIntError::None)
+            {
+                consoleHandler->printf("Invalid count `%s`.", args[2]);
+                return -1;
+            }
+        }
+        return bench(args[1], count ? count : 1, consoleHandler);
+    }
+
+    consoleHandler->printf("Usage: %s", usage());
+    return 1;
+}
+
+i32 TexturesCommand::bench(const char* const path, const u32 count, Console::Controller* consoleHandler) noexcept
+{
+    if(!TextureLoader::loadTexture(_globals.gi, _globals.rc, path))
+    {
+        consoleHandler->printf("Failed to load `%s`.", path);
+        return -1;
+    }
+
+    /**
+     *   A scene of `count` textures is ready for its first frame
+     * once every texture has been created.
+     */
+    ::std::vector<NullableRef<IResource>> textures(count);
+    const ::std::vector<const char*> fileNames(count, path);
+
+    const u64 serialStart = microTime();
+    for(u32 i = 0; i < count; ++i)
+    { textures[i] = TextureLoader::loadTexture(_globals.gi, _globals.rc, path); }
+    const u64 serialTime = microTime() - serialStart;
+
+    textures.clear();
+    textures.resize(count);
+
+    const u64 pipelinedStart = microTime();
+    TextureLoader::loadTextures(_globals.gi, _globals.rc, fileNames.data(), count, textures.data());
+    const u64 pipelinedTime = microTime() - pipelinedStart;
+
+    consoleHandler->printf("Time to first frame of %u textures: serial %lluus, pipelined %lluus, %.2fx faster.", count, serialTime, pipelinedTime, pipelinedTime ? static_cast<double>(serialTime) / pipelinedTime : 0.0);
+
+    return 0;
+}
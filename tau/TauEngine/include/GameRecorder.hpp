@@ -1,13 +1,49 @@
 #pragma once
 
 #include <vector>
+#include <list>
+#include <future>
 #include <unordered_map>
 #include <RunTimeType.hpp>
+#include <NumTypes.hpp>
+#include <Objects.hpp>
+#include <IFile.hpp>
 
+/**
+ * Records and replays the inputs of a game session.
+ *
+ *   Each registered blip type supplies a serializer, blips are
+ * copied into a byte stream the moment they are added, so the
+ * caller retains ownership of `Blip::data`. Blips of types
+ * without a serializer are ignored.
+ *
+ *   The stream is split into chunks of
+ * {@link GameRecorder::keyframeInterval() @endlink} update
+ * ticks. Every chunk begins with a keyframe, the
+ * `initialBlip` state of every handler, followed by the update
+ * and render blips of each tick. Within a chunk each blip is
+ * stored as the XOR delta against the previous blip of the same
+ * stream and type, run length and varint encoded, so slowly
+ * changing state costs a few bytes per tick. Completed chunks
+ * are LZ compressed on a worker thread and then appended to the
+ * output file, or kept in memory if recording without a file.
+ *
+ *   Seeking performs a binary search over the chunk index,
+ * decompresses a single chunk, applies its keyframe, then
+ * replays at most `keyframeInterval - 1` ticks.
+ *
+ * The file layout is:
+ *
+ *   FileHeader
+ *   (ChunkHeader, u8[compressedSize])...
+ *   ChunkIndexEntry[chunkCount]
+ *   FileTrailer
+ */
 class GameRecorder final
 {
+    DELETE_CM(GameRecorder);
 public:
-    enum class BlipType
+    enum class BlipType : u8
     {
         Initial,
         Update,
@@ -31,39 +67,189 @@ public:
 
     typedef bool(*__cdecl blipHandler_f)(Blip& blip, void* userParam);
     typedef Blip(*__cdecl initialBlip_f)(void* userParam);
+    /**
+     * Writes the payload of a blip.
+     *
+     * @return
+     *      The number of bytes written, or 0 if the blip should
+     *    not be recorded.
+     */
+    typedef uSys(*__cdecl blipSerialize_f)(const Blip& blip, u8* buffer, uSys bufferSize, void* userParam);
+
+    struct BlipSerializer final
+    {
+        /**
+         *   Identifies the blip type within a replay. Unlike the
+         * RTT this must be stable between runs. 0 is reserved.
+         */
+        u32 streamID;
+        blipSerialize_f serialize;
+    };
+
     struct HandlerGroup final
     {
         blipHandler_f blipHandler;
         initialBlip_f initialBlip;
+        BlipSerializer serializer;
         void* userParam;
     };
+
+    static constexpr u32 Magic = 0x52524754; // TGRR
+    static constexpr u16 Version = 1;
+    static constexpr u32 DefaultKeyframeInterval = 256;
+    static constexpr uSys MaxBlipSize = 4096;
+
+    struct FileHeader final
+    {
+        u32 magic;
+        u16 version;
+        u16 headerSize;
+        u32 keyframeInterval;
+        u32 reserved;
+    };
+
+    struct ChunkHeader final
+    {
+        u32 firstFrame;
+        u32 frameCount;
+        u32 rawSize;
+        /**
+         *   If this is equal to `rawSize` the chunk is stored
+         * uncompressed.
+         */
+        u32 compressedSize;
+    };
+
+    struct ChunkIndexEntry final
+    {
+        ChunkHeader header;
+        /**
+         * The offset of the chunk header.
+         */
+        u64 offset;
+    };
+
+    struct FileTrailer final
+    {
+        u64 indexOffset;
+        u32 chunkCount;
+        u32 magic;
+    };
+private:
+    struct Chunk final
+    {
+        ChunkHeader header;
+        u64 offset;
+        /**
+         * Only populated when recording without a file.
+         */
+        ::std::vector<u8> data;
+    };
+
+    using DeltaBases = ::std::unordered_map<u64, ::std::vector<u8>>;
 private:
-    std::vector<Blip> _blips;
-    std::unordered_map<RunTimeType<Blip>, HandlerGroup> _handlers;
+    ::std::unordered_map<RunTimeType<Blip>, HandlerGroup> _handlers;
+    ::std::unordered_map<u32, RunTimeType<Blip>> _streams;
     bool _recording;
     bool _playing;
-    std::size_t _playbackIndex;
+
+    u32 _keyframeInterval;
+    CPPRef<IFile> _file;
+    u64 _fileOffset;
+    ::std::vector<Chunk> _chunks;
+    ::std::list<::std::future<Chunk>> _pendingChunks;
+
+    ::std::vector<u8> _recordBuffer;
+    ::std::vector<u8> _encodeBuffer;
+    DeltaBases _recordBases;
+    u32 _frame;
+    u32 _chunkFirstFrame;
+
+    ::std::vector<u8> _playbackBuffer;
+    DeltaBases _playbackBases;
+    uSys _playbackChunk;
+    uSys _playbackIndex;
+    u32 _playbackFrame;
 public:
     GameRecorder() noexcept
-        : _recording(false), _playing(false), _playbackIndex(0)
+        : _recording(false)
+        , _playing(false)
+        , _keyframeInterval(DefaultKeyframeInterval)
+        , _fileOffset(0)
+        , _frame(0)
+        , _chunkFirstFrame(0)
+        , _playbackChunk(0)
+        , _playbackIndex(0)
+        , _playbackFrame(0)
     { }
 
+    ~GameRecorder() noexcept;
+
     [[nodiscard]] bool recording() const noexcept { return _recording; }
     [[nodiscard]] bool playing() const noexcept { return _playing; }
 
-    void startRecording();
+    [[nodiscard]] u32 keyframeInterval() const noexcept { return _keyframeInterval; }
+    void keyframeInterval(const u32 keyframeInterval) noexcept { _keyframeInterval = keyframeInterval ? keyframeInterval : 1; }
+
+    /**
+     * The number of update ticks recorded or loaded.
+     */
+    [[nodiscard]] u32 frameCount() const noexcept;
+    [[nodiscard]] u32 playbackFrame() const noexcept { return _playbackFrame; }
+
+    /**
+     * Records into memory.
+     */
+    void startRecording() noexcept;
+
+    /**
+     *   Records into a file, the file is finalized by
+     * {@link GameRecorder::stopRecording() @endlink}.
+     */
+    void startRecording(const CPPRef<IFile>& file) noexcept;
 
-    void stopRecording();
+    void stopRecording() noexcept;
 
     void addBlip(const Blip& blip) noexcept;
 
-    void addBlipHandler(RunTimeType<Blip> type, blipHandler_f handler, initialBlip_f initial, void* userParam);
+    void addBlipHandler(RunTimeType<Blip> type, blipHandler_f handler, initialBlip_f initial, void* userParam) noexcept;
+    void addBlipHandler(RunTimeType<Blip> type, blipHandler_f handler, initialBlip_f initial, const BlipSerializer& serializer, void* userParam) noexcept;
 
+    /**
+     * Begins a new update tick.
+     */
     void addBeginUpdate() noexcept;
     void addBeginRender() noexcept;
 
-    void beginPlayBack();
+    /**
+     * Loads the chunk index of a finalized replay file.
+     */
+    [[nodiscard]] bool openReplay(const CPPRef<IFile>& file) noexcept;
+
+    void beginPlayBack() noexcept;
+
+    /**
+     *   Restores the state at the beginning of the update tick
+     * `frame` and continues playback from there.
+     */
+    bool seek(u32 frame) noexcept;
 
     void playUpdate() noexcept;
     void playRender() noexcept;
+private:
+    void writeRecord(u32 streamID, BlipType type, const u8* data, uSys size) noexcept;
+    void writeKeyframe() noexcept;
+    void flushChunk() noexcept;
+    void drainChunks(bool wait) noexcept;
+
+    [[nodiscard]] bool loadChunk(uSys chunk) noexcept;
+    [[nodiscard]] bool peekRecord(u32* streamID, BlipType* type) const noexcept;
+    /**
+     * Decodes and dispatches the record at the playback index.
+     */
+    bool playRecord() noexcept;
+    /**
+     * Plays records until a frame marker is reached.
+     */
+    void playUntilMarker() noexcept;
 };
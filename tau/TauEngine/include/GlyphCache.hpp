@@ -0,0 +1,324 @@
+/**
+ * @file
+ *
+ * Describes a lazily populated glyph atlas.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <future>
+#include <unordered_map>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+#include <DynArray.hpp>
+
+#include "DLL.hpp"
+
+class IResource;
+class ICommandList;
+class IGraphicsInterface;
+
+struct GlyphCacheArgs final
+{
+    DEFAULT_DESTRUCT(GlyphCacheArgs);
+    DEFAULT_CM_PU(GlyphCacheArgs);
+public:
+    /**
+     *   The width and height of each atlas page. This is rounded
+     * up to a multiple of 256, so that the rows of the staging
+     * texture are tightly packed on every API.
+     */
+    u32 pageSize;
+    /**
+     *   The page budget, once every page is full the least
+     * recently used page is evicted.
+     */
+    u32 maxPages;
+    /**
+     * The number of glyphs that can be rasterized concurrently.
+     */
+    u32 workerCount;
+    /**
+     * Empty texels between glyphs to prevent bleeding.
+     */
+    u32 padding;
+public:
+    GlyphCacheArgs() noexcept
+        : pageSize(1024)
+        , maxPages(4)
+        , workerCount(2)
+        , padding(1)
+    { }
+};
+
+struct CachedGlyph final
+{
+    enum class State : u8
+    {
+        /**
+         * Queued or being rasterized, the metrics are not yet known.
+         */
+        Pending = 0,
+        Resident,
+        /**
+         * The glyph has an advance but no bitmap, such as a space.
+         */
+        Blank,
+        /**
+         * The font does not contain the glyph.
+         */
+        Missing,
+        /**
+         *   The glyph is larger than an atlas page. It keeps its
+         * metrics so the pen still advances, but it is never drawn.
+         */
+        Oversized
+    };
+
+    State state;
+    u16 page;
+    u16 x;
+    u16 y;
+    u16 width;
+    u16 height;
+    i16 bearingX;
+    i16 bearingY;
+    /**
+     * 26.6 fixed point.
+     */
+    u32 advance;
+};
+
+/**
+ *   The quads for a string, grouped by atlas page so that each
+ * page can be drawn with a single call. Every glyph is 6
+ * vertices, each vertex is 2 floats in both `positions` and
+ * `texCoords`.
+ */
+struct GlyphBatch final
+{
+    DEFAULT_CONSTRUCT_PU(GlyphBatch);
+    DEFAULT_DESTRUCT(GlyphBatch);
+    DEFAULT_CM_PU(GlyphBatch);
+public:
+    struct Range final
+    {
+        u32 page;
+        u32 firstVertex;
+        u32 vertexCount;
+    };
+
+    struct Quad final
+    {
+        u32 page;
+        float x0, y0, x1, y1;
+        float u0, v0, u1, v1;
+    };
+public:
+    ::std::vector<float> positions;
+    ::std::vector<float> texCoords;
+    ::std::vector<Range> ranges;
+    /**
+     * Glyphs that were skipped because they are not yet resident.
+     */
+    u32 pendingGlyphs;
+    /**
+     * The pen position after the last glyph.
+     */
+    float endX;
+
+    /**
+     * Scratch space, retained to avoid reallocating every frame.
+     */
+    ::std::vector<Quad> quads;
+    ::std::vector<u32> pageCounts;
+
+    void clear() noexcept
+    {
+        positions.clear();
+        texCoords.clear();
+        ranges.clear();
+        quads.clear();
+        pendingGlyphs = 0;
+        endX = 0.0f;
+    }
+};
+
+/**
+ * A glyph atlas that rasterizes glyphs the first time they are used.
+ *
+ *   Looking up a glyph that is not cached queues it, the queue
+ * is rasterized on worker threads and the results are packed
+ * into atlas pages by {@link GlyphCache::update @endlink}.
+ * This allows fonts with very large character sets, such as
+ * CJK fonts, to be used without rasterizing the entire range
+ * up front.
+ *
+ *   FreeType faces are not thread safe, so every worker owns a
+ * face created from the shared font data.
+ *
+ *   Glyphs are packed into fixed size pages using rows of
+ * similar heights. Once the page budget is exhausted the least
+ * recently used page is evicted, every glyph within it returns
+ * to the uncached state and will be rasterized again on its
+ * next use. A page used in the current frame is never evicted.
+ *
+ *   Each page texture is created once. Afterwards only the rows
+ * that were modified are written to the page's staging texture
+ * and copied into the page by
+ * {@link GlyphCache::upload @endlink}.
+ *
+ *   Pointers returned by {@link GlyphCache::find @endlink} are
+ * valid until the next call to
+ * {@link GlyphCache::update @endlink}.
+ */
+class TAU_DLL GlyphCache final
+{
+    DELETE_CM(GlyphCache);
+public:
+    struct Page final
+    {
+        struct Shelf final
+        {
+            u32 y;
+            u32 height;
+            u32 x;
+        };
+
+        ::std::vector<u8> pixels;
+        ::std::vector<Shelf> shelves;
+        ::std::vector<u32> glyphs;
+        u32 shelfTop;
+        /**
+         * The rows modified since the last upload, [dirtyTop, dirtyBottom).
+         */
+        u32 dirtyTop;
+        u32 dirtyBottom;
+        u64 lastUsed;
+        NullableRef<IResource> texture;
+        NullableRef<IResource> staging;
+
+        [[nodiscard]] bool dirty() const noexcept { return dirtyTop < dirtyBottom; }
+
+        void markDirty(const u32 top, const u32 bottom) noexcept
+        {
+            if(!dirty())
+            {
+                dirtyTop = top;
+                dirtyBottom = bottom;
+                return;
+            }
+
+            dirtyTop = ::std::min(dirtyTop, top);
+            dirtyBottom = ::std::max(dirtyBottom, bottom);
+        }
+    };
+
+    struct Stats final
+    {
+        u64 rasterized;
+        u64 evictions;
+        u64 uploads;
+        u64 uploadedBytes;
+    };
+private:
+    struct Rasterized final
+    {
+        u32 codepoint;
+        CachedGlyph glyph;
+        ::std::vector<u8> pixels;
+    };
+
+    struct Job final
+    {
+        uSys face;
+        ::std::future<::std::vector<Rasterized>> future;
+    };
+private:
+    FT_Library _ft;
+    RefDynArray<u8> _fontData;
+    FT_UInt _pixelHeight;
+    GlyphCacheArgs _args;
+
+    ::std::vector<FT_Face> _faces;
+    ::std::vector<bool> _faceBusy;
+
+    ::std::unordered_map<u32, CachedGlyph> _glyphs;
+    ::std::vector<Page> _pages;
+    ::std::vector<u32> _queue;
+    ::std::list<Job> _jobs;
+
+    u64 _frame;
+    Stats _stats;
+public:
+    GlyphCache(FT_Library ft, const RefDynArray<u8>& fontData, FT_UInt pixelHeight, const GlyphCacheArgs& args) noexcept;
+
+    ~GlyphCache() noexcept;
+
+    /**
+     * Creates the worker faces.
+     */
+    [[nodiscard]] FT_Error init() noexcept;
+
+    [[nodiscard]] const GlyphCacheArgs& args() const noexcept { return _args; }
+    [[nodiscard]] const ::std::vector<Page>& pages() const noexcept { return _pages; }
+    [[nodiscard]] const Stats& stats() const noexcept { return _stats; }
+    [[nodiscard]] uSys glyphCount() const noexcept { return _glyphs.size(); }
+
+    /**
+     * Whether or not there are glyphs queued or being rasterized.
+     */
+    [[nodiscard]] bool busy() const noexcept { return !_queue.empty() || !_jobs.empty(); }
+
+    /**
+     *   Finds a glyph, queueing it for rasterization if it is not
+     * cached. A resident glyph marks its page as used this frame.
+     */
+    const CachedGlyph* find(u32 codepoint) noexcept;
+
+    /**
+     * Queues every glyph of a UTF-16 string.
+     */
+    void prefetch(const wchar_t* str, uSys length) noexcept;
+
+    /**
+     *   Generates the quads for a UTF-16 string. Glyphs that are
+     * not yet resident are queued and skipped.
+     */
+    void buildQuads(const wchar_t* str, uSys length, float x, float y, float scale, GlyphBatch& batch) noexcept;
+
+    /**
+     *   Dispatches queued glyphs and packs finished glyphs into
+     * the atlas. This should be called once per frame after all
+     * text has been built.
+     *
+     * @param[in] wait
+     *      Block until every queued glyph is resident.
+     */
+    void update(bool wait = false) noexcept;
+
+    /**
+     *   Creates the texture of any new page, and records copies of
+     * the modified rows of every other page. This should be
+     * called after {@link GlyphCache::update @endlink}.
+     */
+    void upload(IGraphicsInterface& gi, ICommandList& cmdList) noexcept;
+private:
+    void dispatch() noexcept;
+    void collect(bool wait) noexcept;
+    void integrate(Rasterized& rasterized) noexcept;
+    [[nodiscard]] bool place(u32 width, u32 height, u16* page, u16* x, u16* y) noexcept;
+    [[nodiscard]] static bool placeInPage(Page& page, u32 pageSize, u32 width, u32 height, u16* x, u16* y) noexcept;
+    void evict(u16 page) noexcept;
+    [[nodiscard]] bool createTextures(IGraphicsInterface& gi, Page& page) const noexcept;
+
+    static ::std::vector<Rasterized> rasterize(FT_Face face, ::std::vector<u32> codepoints) noexcept;
+};
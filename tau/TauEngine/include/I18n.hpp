@@ -1,38 +1,81 @@
 #pragma once
 
-#pragma warning(push, 0)
-#include <unordered_map>
-#pragma warning(pop)
-
 #include <Objects.hpp>
 #include <IFile.hpp>
+#include <MappedFile.hpp>
 #include <String.hpp>
 
+#include "I18nTable.hpp"
 #include "DLL.hpp"
 
+/**
+ * Looks up translated strings.
+ *
+ *   Translations are stored in the flat binary format
+ * described by {@link I18nTable.hpp @endlink}, the file is
+ * memory mapped and queried in place, so a lookup never
+ * allocates. Legacy `LaNg` files are converted to the binary
+ * format in memory when they are loaded.
+ *
+ *   Loading a new language simply remaps the table. Strings
+ * returned by {@link I18n::translate @endlink} point into the
+ * mapping and are only valid until the next successful load.
+ */
 class TAU_DLL I18n final
 {
     DEFAULT_CONSTRUCT_PU(I18n);
     DEFAULT_DESTRUCT(I18n);
     DEFAULT_CM_PU(I18n);
-public:
-    using I18nMap = ::std::unordered_map<DynString, WDynString>;
-private:
-    I18nMap _translations;
-    WDynString _language;
 public:
     enum class Error
     {
         NoError = 0,
         UnknownTranslationKey
     };
+private:
+    CPPRef<MappedFile> _table;
+    const i18n::bin::Header* _header = null;
+    const i32* _seeds = null;
+    const i18n::bin::Entry* _entries = null;
+    const char* _keys = null;
+    const wchar_t* _values = null;
 public:
-    [[nodiscard]] inline const WDynString& language() const noexcept { return _language; }
-    [[nodiscard]] inline const I18nMap& operator()() const noexcept { return _translations; }
+    [[nodiscard]] u32 count() const noexcept { return _header ? _header->entryCount : 0; }
+
+    [[nodiscard]] const wchar_t* language() const noexcept
+    { return _header ? _values + _header->language.offset : L""; }
 
-    [[nodiscard]] inline const WDynString& operator[](const DynString& key) const noexcept { return translate(key); }
+    [[nodiscard]] inline const wchar_t* operator[](const DynString& key) const noexcept { return translate(key); }
+    [[nodiscard]] inline const wchar_t* operator[](const char* key) const noexcept { return translate(key); }
 
+    /**
+     *   Loads either a binary translation table or a legacy
+     * `LaNg` file. On failure the current language is retained.
+     */
     bool loadTranslations(const CPPRef<IFile>& file) noexcept;
 
-    [[nodiscard]] const WDynString& translate(const DynString& key, [[tau::out]] Error* error = null) const noexcept;
+    /**
+     * Maps a binary translation table directly from its path.
+     */
+    bool loadTranslations(const wchar_t* path) noexcept;
+
+    /**
+     * @return
+     *      The null terminated translation, or an empty string if
+     *    the key is unknown.
+     */
+    [[nodiscard]] const wchar_t* translate(const char* key, uSys length, [[tau::out]] Error* error = null) const noexcept;
+
+    [[nodiscard]] const wchar_t* translate(const DynString& key, [[tau::out]] Error* error = null) const noexcept
+    { return translate(key.c_str(), key.length(), error); }
+
+    [[nodiscard]] const wchar_t* translate(const char* key, [[tau::out]] Error* error = null) const noexcept
+    { return translate(key, strLength(key), error); }
+private:
+    /**
+     *   Validates the table layout and swaps it in. The layout is
+     * checked once here, so each lookup only has to bounds check
+     * the entry it lands on.
+     */
+    bool swapTable(const CPPRef<MappedFile>& table) noexcept;
 };
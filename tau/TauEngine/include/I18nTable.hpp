@@ -0,0 +1,190 @@
+/**
+ * @file
+ *
+ * Describes the compiled binary form of a translation table.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <vector>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+#include <String.hpp>
+#include <IFile.hpp>
+
+#include "DLL.hpp"
+
+/**
+ *   The binary format is a flat image intended to be memory
+ * mapped and queried in place. Every offset is relative to the
+ * beginning of the file, every structure is 4 byte aligned,
+ * and all values are stored little endian.
+ *
+ * The layout of the file is:
+ *
+ *   Header
+ *   i32 seeds[header.entryCount]
+ *   Entry entries[header.entryCount]
+ *   Key Table   (char)
+ *   Value Table (UTF-16, null terminated)
+ *
+ *   Keys are located with a minimal perfect hash. The 64 bit
+ * hash of a key selects a seed, if the seed is negative the
+ * key lives in entry `-seed - 1`, otherwise the seed is mixed
+ * back into the hash to select the entry. Every entry is
+ * occupied, so a key that is not in the table still resolves
+ * to an entry; the stored hash and key must be compared before
+ * the value is used.
+ *
+ *   The language name is stored in the value table.
+ */
+namespace i18n::bin {
+/**
+ * "TLNG" in little endian.
+ */
+static constexpr u32 Magic = 0x474E4C54;
+static constexpr u16 Version = 1;
+
+struct StringRef final
+{
+    u32 offset;
+    u32 length;
+};
+
+struct Header final
+{
+    u32 magic;
+    u16 version;
+    u16 headerSize;
+    u32 fileSize;
+    u32 entryCount;
+    u32 seedOffset;
+    u32 entryOffset;
+    u32 keyTableOffset;
+    u32 keyTableSize;
+    u32 valueTableOffset;
+    /**
+     * The size in UTF-16 code units.
+     */
+    u32 valueTableSize;
+    /**
+     * Into the value table.
+     */
+    StringRef language;
+};
+
+struct Entry final
+{
+    /**
+     * The low 32 bits of the key hash.
+     */
+    u32 hash;
+    /**
+     * Into the key table.
+     */
+    StringRef key;
+    /**
+     *   Into the value table, the length does not include the
+     * null terminator.
+     */
+    StringRef value;
+};
+
+static_assert(sizeof(Header) == 48, "i18n::bin::Header must be tightly packed.");
+static_assert(sizeof(Entry) == 20, "i18n::bin::Entry must be tightly packed.");
+
+/**
+ * 64 bit FNV-1a.
+ */
+[[nodiscard]] inline u64 hashKey(const char* const key, const uSys length) noexcept
+{
+    u64 hash = 0xCBF29CE484222325ull;
+    for(uSys i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<u8>(key[i]);
+        hash *= 0x00000100000001B3ull;
+    }
+    return hash;
+}
+
+[[nodiscard]] inline u32 bucket(const u64 hash, const u32 entryCount) noexcept
+{ return static_cast<u32>((hash >> 32) % entryCount); }
+
+/**
+ * Re-mixes the key hash with a seed, this is the finalizer of SplitMix64.
+ */
+[[nodiscard]] inline u32 slot(const u64 hash, const i32 seed, const u32 entryCount) noexcept
+{
+    u64 z = hash ^ (static_cast<u64>(seed) * 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return static_cast<u32>(z % entryCount);
+}
+}
+
+/**
+ * Builds the binary translation table.
+ *
+ *   This is intended to be run offline, though it is also used
+ * to convert legacy `LaNg` files when they are loaded.
+ */
+class TAU_DLL I18nTableBuilder final
+{
+    DEFAULT_CONSTRUCT_PU(I18nTableBuilder);
+    DEFAULT_DESTRUCT(I18nTableBuilder);
+    DEFAULT_CM_PU(I18nTableBuilder);
+public:
+    enum class Error
+    {
+        NoError = 0,
+        InvalidFile,
+        DuplicateKey,
+        /**
+         * Two different keys have the same 64 bit hash.
+         */
+        HashCollision,
+        /**
+         * No seed could be found for a bucket.
+         */
+        PerfectHashFailed,
+        TooLarge,
+        SystemMemoryAllocationFailure,
+        WriteFailed
+    };
+private:
+    struct Translation final
+    {
+        DynString key;
+        ::std::vector<u16> value;
+    };
+private:
+    ::std::vector<Translation> _translations;
+    ::std::vector<u16> _language;
+public:
+    [[nodiscard]] uSys count() const noexcept { return _translations.size(); }
+
+    void language(const wchar_t* language, uSys length) noexcept;
+
+    void add(const DynString& key, const wchar_t* value, uSys length) noexcept;
+
+    /**
+     * Reads a legacy `LaNg` file.
+     */
+    bool loadLegacy(const CPPRef<IFile>& file, [[tau::out]] Error* error = null) noexcept;
+
+    /**
+     * Builds the flat binary image.
+     */
+    bool build(::std::vector<u8>& out, [[tau::out]] Error* error = null) const noexcept;
+
+    bool write(const CPPRef<IFile>& file, [[tau::out]] Error* error = null) const noexcept;
+
+    /**
+     * Converts a legacy `LaNg` file to the binary format.
+     */
+    static bool compile(const CPPRef<IFile>& input, const CPPRef<IFile>& output, [[tau::out]] Error* error = null) noexcept;
+};
@@ -0,0 +1,117 @@
+/**
+ * @file
+ *
+ * Generates signed distance field glyphs from font outlines.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <vector>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+#include <DynArray.hpp>
+
+#include "DLL.hpp"
+
+struct SDFArgs final
+{
+    DEFAULT_DESTRUCT(SDFArgs);
+    DEFAULT_CM_PU(SDFArgs);
+public:
+    /**
+     *   The pixel size the outlines are sampled at. Glyphs can
+     * be drawn well above this size as long as the spread covers
+     * the filter width.
+     */
+    u32 emSize;
+    /**
+     *   The distance in pixels, either side of the edge, that is
+     * representable. This is also the padding around each glyph.
+     */
+    float spread;
+    /**
+     * The maximum distance in pixels between a curve and its flattened segments.
+     */
+    float flatness;
+    /**
+     * The number of glyphs that are generated concurrently.
+     */
+    u32 workerCount;
+public:
+    SDFArgs() noexcept
+        : emSize(32)
+        , spread(4.0f)
+        , flatness(0.1f)
+        , workerCount(2)
+    { }
+};
+
+struct SDFGlyph final
+{
+    u32 codepoint;
+    u16 width;
+    u16 height;
+    /**
+     * Includes the padding.
+     */
+    i16 bearingX;
+    i16 bearingY;
+    /**
+     * 26.6 fixed point.
+     */
+    u32 advance;
+    /**
+     *   Row major, top down. A value of 128 lies on the outline,
+     * larger values are inside the glyph.
+     */
+    ::std::vector<u8> pixels;
+};
+
+/**
+ * Computes single channel signed distance fields from FreeType outlines.
+ *
+ *   The outline of each glyph is flattened into line segments.
+ * The distance of each texel is then the distance to the
+ * nearest segment, and the sign is found from the nonzero
+ * winding number of the texel. Segments are stored as a
+ * structure of arrays and both the distance and winding are
+ * computed against four segments at once with SSE.
+ *
+ *   Because the field stores distances instead of coverage a
+ * single atlas can be magnified or minified by the text shader
+ * without needing a bitmap set per scale.
+ */
+class TAU_DLL SDFGenerator final
+{
+    DELETE_CONSTRUCT(SDFGenerator);
+    DELETE_DESTRUCT(SDFGenerator);
+    DELETE_CM(SDFGenerator);
+public:
+    /**
+     *   Generates a single glyph. The face must be exclusively
+     * owned by the calling thread, its pixel size is set to
+     * `args.emSize`.
+     *
+     * @return
+     *      False if the glyph could not be loaded or is not an
+     *    outline. A glyph without contours, such as a space,
+     *    succeeds with an empty bitmap.
+     */
+    static bool generate(FT_Face face, u32 codepoint, const SDFArgs& args, SDFGlyph* out) noexcept;
+
+    /**
+     *   Generates a set of glyphs, split across
+     * `args.workerCount` threads. Each worker creates its own
+     * face from `fontData`.
+     *
+     * @return
+     *      One entry per code point, code points that failed to
+     *    generate have a width and height of 0 and no advance.
+     */
+    static ::std::vector<SDFGlyph> generate(FT_Library ft, const RefDynArray<u8>& fontData, const u32* codepoints, uSys count, const SDFArgs& args) noexcept;
+};
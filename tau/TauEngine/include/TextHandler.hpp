@@ -10,11 +10,15 @@
 
 #include <DynArray.hpp>
 #include <String.hpp>
+#include <TexturePacker2D.hpp>
 
 #include "DLL.hpp"
+#include "GlyphCache.hpp"
+#include "SDFGenerator.hpp"
 #include "maths/Vector2f.hpp"
 #include "maths/Vector3f.hpp"
 #include "shader/Uniform.hpp"
+#include "shader/Shader.hpp"
 #include "ResourceLoader.hpp"
 #include "graphics/Resource.hpp"
 
@@ -62,6 +66,19 @@ public:
     uSys glyphCount;
     DynArray<GlyphCharacter> glyphs;
     NullableRef<IResource> texture;
+    /**
+     *   The texture stores signed distances instead of coverage,
+     * it is drawn with the SDF shader at any scale.
+     */
+    bool sdf;
+    /**
+     * The distance range of the field in pixels at `emSize`.
+     */
+    float spread;
+    /**
+     * The pixel size the glyphs were generated at.
+     */
+    u32 emSize;
 
     GlyphSet(const DynString& _setName, const wchar_t _minGlyph, const wchar_t _maxGlyph) noexcept
         : setName(_setName)
@@ -70,6 +87,9 @@ public:
         , glyphCount(_maxGlyph - _minGlyph + 1)
         , glyphs(glyphCount)
         , texture(nullptr)
+        , sdf(false)
+        , spread(0.0f)
+        , emSize(0)
     { }
 };
 
@@ -112,6 +132,13 @@ public:
     {
         Vector3f color;
     };
+
+    /**
+     * The number of glyphs drawn by a single batched draw call.
+     */
+    static constexpr uSys MaxBatchGlyphs = 1024;
+private:
+    using GlyphPacker = TexturePacker2D<wchar_t, u16>;
 private:
     static NullableRef<IRasterizerState> rs;
 private:
@@ -120,30 +147,79 @@ private:
     // std::vector<GlyphSet> _glyphSets;
 
     CPPRef<IShaderProgram> _shader;
+    CPPRef<IShaderProgram> _sdfShader;
+    IShaderBuilder::Error _sdfShaderError;
     CPPRef<IVertexArray> _va;
     CPPRef<IVertexBuffer> _positionBuffer;
     UniformBlockS<ProjectionUniforms> _viewUniforms;
     UniformBlockS<ColorUniforms> _colorUniforms;
     NullableRef<ISingleTextureUploader> _textureUploader;
+
+    CPPRef<IVertexArray> _batchVA;
+    CPPRef<IVertexBuffer> _batchPositionBuffer;
+    CPPRef<IVertexBuffer> _batchTexCoordBuffer;
+    GlyphBatch _batch;
 public:
-    TextHandler(IGraphicsInterface& gi, IRenderingContext& context, const char* vfsMount, const char* path, const char* vertexName, const char* pixelName) noexcept;
+    TextHandler(IGraphicsInterface& gi, IRenderingContext& context, const char* vfsMount, const char* path, const char* vertexName, const char* pixelName, const char* sdfPixelName = null) noexcept;
 
     ~TextHandler() noexcept;
 
     [[nodiscard]] FT_Error init() noexcept;
 
+    [[nodiscard]] FT_Library library() const noexcept { return _ft; }
+
+    /**
+     *   Why the SDF shader could not be built. Unless this is
+     * NoError SDF glyph sets can't be generated.
+     */
+    [[nodiscard]] IShaderBuilder::Error sdfShaderError() const noexcept { return _sdfShaderError; }
+
     [[nodiscard]] FileData* loadTTFFile(const char* fileName, FT_UInt pixelWidth, FT_UInt pixelHeight) const noexcept;
     [[nodiscard]] int loadTTFFile(const char* fileName, FT_UInt pixelWidth, FT_UInt pixelHeight, ResourceLoader::finalizeLoadT_f<FinalizeData, FileData> finalizeLoad, void* userParam) noexcept;
 
+    /**
+     * Creates a glyph cache for a font, glyphs are rasterized on first use.
+     */
+    [[nodiscard]] CPPRef<GlyphCache> createGlyphCache(const FileData& file, FT_UInt pixelHeight, const GlyphCacheArgs& args = GlyphCacheArgs()) const noexcept;
+
     GlyphSetHandle generateBitmapCharacters(IGraphicsInterface& gi, IRenderingContext& context, const DynString& glyphSetName, wchar_t minChar, wchar_t maxChar, bool smooth, FT_Face face) noexcept;
+    /**
+     *   Generates a signed distance field glyph set. Unlike a
+     * bitmap set a single SDF set can be drawn at any scale, the
+     * glyph metrics are in pixels at `args.emSize`. Requires the
+     * handler to have been created with an SDF pixel shader.
+     *
+     * @return
+     *      Null if the SDF shader could not be built, see
+     *    {@link TextHandler::sdfShaderError() @endlink}.
+     */
+    GlyphSetHandle generateSDFCharacters(IGraphicsInterface& gi, IRenderingContext& context, const DynString& glyphSetName, wchar_t minChar, wchar_t maxChar, const FileData& file, const SDFArgs& args = SDFArgs()) noexcept;
 
     void renderText(IRenderingContext& context, GlyphSetHandle glyphSetHandle, const char* str, float x, float y, float scale, Vector3f color, const glm::mat4& proj) noexcept;
+    /**
+     *   Renders a UTF-16 string from a glyph cache with one draw
+     * call per atlas page. Glyphs that are not yet resident are
+     * skipped, they will appear once
+     * {@link GlyphCache::update @endlink} has packed them and
+     * {@link GlyphCache::upload @endlink} has copied them.
+     *
+     * @return
+     *      The pen position after the last glyph.
+     */
+    float renderText(IRenderingContext& context, GlyphCache& cache, const wchar_t* str, uSys length, float x, float y, float scale, Vector3f color, const glm::mat4& proj) noexcept;
     float renderTextLineWrapped(IRenderingContext& context, GlyphSetHandle glyphSetHandle, const char* str, float x, float y, float scale, Vector3f color, const glm::mat4& proj, const Window& window, float lineHeight) noexcept;
 
     float computeLength(GlyphSetHandle glyphSetHandle, const char* str, float scale) const noexcept;
     float computeHeight(GlyphSetHandle glyphSetHandle, const char* str, float scale, float x, const Window& window, float lineHeight) const noexcept;
 private:
     static FileData* __cdecl load2(RefDynArray<u8> file, LoadData* ld) noexcept;
+
+    /**
+     *   Packs glyph bitmaps into a single R8 texture and sets the
+     * atlas coordinates of each glyph. `bitmaps` is indexed by
+     * code point relative to the set's minimum glyph.
+     */
+    static NullableRef<IResource> packGlyphs(IGraphicsInterface& gi, GlyphSet& gs, DynArray<GlyphPacker::Texture>& textures, uSys count, const ::std::vector<::std::vector<u8>>& bitmaps) noexcept;
 };
 
 WDynString findSystemFont(const WDynString& fontName) noexcept;
@@ -9,6 +9,7 @@
 #include <Safeties.hpp>
 #include <Objects.hpp>
 #include <String.hpp>
+#include <allocator/AllocationTracker.hpp>
 #include "DLL.hpp"
 #include "system/Mutex.hpp"
 
@@ -113,6 +114,12 @@ public:
     static void end() noexcept;
 
     static void write(const ProfileResult& pr) noexcept;
+
+    /**
+     *   Writes the bytes in use by each tag as counters, which the
+     * trace viewer plots alongside the timings.
+     */
+    static void writeMemory(const AllocationTracker::Snapshot& snapshot, u64 time = microTime()) noexcept;
 private:
     static void writeHeader(const char* name) noexcept;
     static void writeFooter() noexcept;
@@ -4,6 +4,7 @@
 #include <glm/gtc/quaternion.hpp>
 
 #include "maths/Vector3f.hpp"
+#include "maths/Frustum.hpp"
 #include "system/Keyboard.hpp"
 #include "Timings.hpp"
 #include "GameRecorder.hpp"
@@ -42,6 +43,7 @@ public:
     [[nodiscard]] const glm::mat4& viewRotMatrix() const noexcept { return _viewRotMatrix; }
     /** _projectionMatrix * _viewMatrix */
     [[nodiscard]] const glm::mat4& compoundedMatrix() const noexcept { return _compoundedMatrix; }
+    [[nodiscard]] Frustum frustum() const noexcept { return Frustum(_compoundedMatrix); }
 
     void setProjection(float width, float height, float fov, float zNear, float zFar) noexcept;
     void setProjection(const Window& window, float fov, float zNear, float zFar) noexcept;
@@ -228,6 +230,12 @@ public:
 
     static bool __cdecl blipHandler(GameRecorder::Blip& blip, void* userParam) noexcept;
     static GameRecorder::Blip __cdecl initialBlip(void* userParam) noexcept;
+    static uSys __cdecl serializeBlip(const GameRecorder::Blip& blip, u8* buffer, uSys bufferSize, void* userParam) noexcept;
+
+    /**
+     * The stable identifier of the camera within replays.
+     */
+    static constexpr u32 CameraStreamID = 1;
 
     static RunTimeType<GameRecorder::Blip> cameraBlip() noexcept;
 private:
@@ -259,6 +267,10 @@ private:
     Keyboard::Key _keyDown;
 
     GameRecorder* _recorder;
+    /**
+     * The storage for the most recent initial blip.
+     */
+    BlipDataInitial _initialBlipData;
 public:
     FreeCamCamera3DController(const Window& window, float fov, float zNear, float zFar,
                               const float normalSpeed, const float fastSpeed, const float rotateSpeed, const bool lookY,
@@ -278,11 +290,12 @@ public:
           _keyForwards(keyForwards), _keyBackwards(keyBackwards),
           _keyLeft(keyLeft), _keyRight(keyRight),
           _keyUp(keyUp), _keyDown(keyDown),
-          _recorder(recorder)
+          _recorder(recorder),
+          _initialBlipData { }
     {
         if(recorder)
         {
-            recorder->addBlipHandler(cameraBlip(), blipHandler, initialBlip, this);
+            recorder->addBlipHandler(cameraBlip(), blipHandler, initialBlip, { CameraStreamID, serializeBlip }, this);
         }
     }
 private:
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <NumTypes.hpp>
-#include <unordered_map>
+#include <vector>
+#include <atomic>
 #include <String.hpp>
 #include <DLL.hpp>
 #include <cstdarg>
@@ -9,6 +10,8 @@
 #include "ConsoleCommand.hpp"
 
 namespace Console {
+class CVarBase;
+
 #define NO_COMMAND_FOUND 849216 /* It's a number, nothing special. */
 
 enum class BoolFromStr : i8
@@ -38,10 +41,33 @@ struct PrintFunctions final
 
 class TAU_DLL Controller final
 {
-    DEFAULT_COPY(Controller);
+    DELETE_CM(Controller);
 public:
+    /**
+     * The most tokens a single command line can be split into.
+     */
+    static constexpr u32 MaxTokens = 32;
+private:
+    /**
+     *   An open addressed table slot. Aliases get their own slot
+     * pointing at the same command.
+     */
+    struct CommandEntry final
+    {
+        uSys hash;
+        DynString name;
+        Command* command;
+    };
 private:
-    std::unordered_map<DynString, Command*> _commands;
+    ::std::vector<CommandEntry> _commandTable;
+    u32 _commandCount;
+    u32 _tableShift;
+    ::std::vector<Command*> _ownedCommands;
+    /**
+     *   CVars changed since the last call to flushCVarChanges,
+     * linked through CVarBase::_nextChanged.
+     */
+    ::std::atomic<CVarBase*> _changedCVars;
     PrintFunctions _printFunctions;
     void* _userParam;
 public:
@@ -51,10 +77,41 @@ public:
 
     ~Controller() noexcept;
 
+    /**
+     * Takes ownership of the command.
+     */
     void addCommand(Command* command) noexcept;
 
+    /**
+     *   Registers a console variable, the controller doesn't take
+     * ownership of it so it has to outlive the controller.
+     */
+    void addCVar(CVarBase* cvar) noexcept;
+
+    /**
+     *   Splits the command on spaces in a stack buffer, without any
+     * heap allocations unless the line is longer than VLA_MAX_LEN.
+     * Arguments can be quoted to include spaces, a quote or
+     * backslash within quotes can be escaped with a backslash.
+     */
     i32 runCommand(const char* command) noexcept;
 
+    /**
+     *   Runs every line of a script. Empty lines and lines starting
+     * with `#` or `//` are skipped.
+     *
+     * @return
+     *      The number of lines that failed.
+     */
+    u32 runScript(const char* script, uSys length) noexcept;
+
+    /**
+     *   Invokes the change callback of every CVar changed since the
+     * last call. This should be called once per frame from the
+     * thread that owns whatever the callbacks touch.
+     */
+    void flushCVarChanges() noexcept;
+
     inline i32 operator ()(const char* command) noexcept { return runCommand(command); }
 
     inline void print(const char* str)       const noexcept { _printFunctions.print_f(_userParam, str); }
@@ -70,16 +127,18 @@ public:
         va_end(args);
     }
 
-    inline const char* usage(const DynString name) noexcept 
+    [[nodiscard]] Command* findCommand(const char* name) const noexcept;
+
+    inline const char* usage(const char* const name) const noexcept 
     {
-        if(_commands.count(name)) { return _commands[name]->usage(); }
-        return nullptr;
+        const Command* const command = findCommand(name);
+        return command ? command->usage() : nullptr;
     }
 
-    inline const char* info(const DynString name) noexcept
+    inline const char* info(const char* const name) const noexcept
     {
-        if(_commands.count(name)) { return _commands[name]->info(); }
-        return nullptr;
+        const Command* const command = findCommand(name);
+        return command ? command->info() : nullptr;
     }
 
     bool addAlias(DynString commandName, DynString aliasName) noexcept;
@@ -91,6 +150,15 @@ public:
     static i64 parseI64(const char* RESTRICT str, ParseIntError* RESTRICT error) noexcept;
     static f32 parseF32(const char* RESTRICT str, ParseIntError* RESTRICT error) noexcept;
     static f64 parseF64(const char* RESTRICT str, ParseIntError* RESTRICT error) noexcept;
+private:
+    i32 runLine(char* line) noexcept;
+
+    [[nodiscard]] Command* findCommand(const char* name, uSys hash) const noexcept;
+    void insertCommand(const char* name, uSys hash, Command* command) noexcept;
+
+    void queueChanged(CVarBase* cvar) noexcept;
+
+    friend class CVarBase;
 };
 
 namespace dc //default_commands
@@ -133,6 +201,15 @@ namespace dc //default_commands
         [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept override;
     };
 
+    class TAU_DLL ExecCommand final : public Command
+    {
+    public:
+        [[nodiscard]] const char* name() const noexcept override { return "exec"; }
+        [[nodiscard]] const char* usage() const noexcept override { return "exec <file{path}>"; }
+        [[nodiscard]] const char* info() const noexcept override { return "Runs every line of a config script."; }
+        [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept override;
+    };
+
     class TAU_DLL HelpCommand final : public Command
     {
     public:
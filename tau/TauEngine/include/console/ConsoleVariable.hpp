@@ -0,0 +1,156 @@
+#pragma once
+
+#include <NumTypes.hpp>
+#include <Objects.hpp>
+#include <DLL.hpp>
+#include <atomic>
+#include <type_traits>
+#include "ConsoleCommand.hpp"
+#include "ConsoleController.hpp"
+
+namespace Console {
+
+/**
+ *   A console variable. It is run like any other command, with no
+ * arguments it prints its value, with one it sets it.
+ *
+ *   Setting a value doesn't invoke the change callback right away.
+ * The variable is queued on its controller and the callback is
+ * invoked by Controller::flushCVarChanges, so callbacks only run
+ * at frame boundaries and only once per frame no matter how often
+ * the variable was set.
+ */
+class TAU_DLL TAU_NOVTABLE CVarBase : public Command
+{
+    DEFAULT_DESTRUCT_VI(CVarBase);
+    DELETE_CM(CVarBase);
+public:
+    using ChangeCallback = void(__cdecl *)(CVarBase& cvar, void* userParam);
+private:
+    const char* _name;
+    const char* _info;
+    ChangeCallback _callback;
+    void* _userParam;
+    Controller* _controller;
+    CVarBase* _nextChanged;
+    ::std::atomic<bool> _changed;
+protected:
+    CVarBase(const char* const name, const char* const info, const ChangeCallback callback, void* const userParam) noexcept
+        : _name(name)
+        , _info(info)
+        , _callback(callback)
+        , _userParam(userParam)
+        , _controller(nullptr)
+        , _nextChanged(nullptr)
+        , _changed(false)
+    { }
+public:
+    [[nodiscard]] const char* name() const noexcept override { return _name; }
+    [[nodiscard]] const char* info() const noexcept override { return _info; }
+
+    [[nodiscard]] i32 execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept override;
+protected:
+    /**
+     * Returns false if `str` isn't a valid value.
+     */
+    [[nodiscard]] virtual bool parse(const char* str) noexcept = 0;
+    virtual void print(Controller* consoleHandler) const noexcept = 0;
+
+    /**
+     * Queues the change callback, unless it is already queued.
+     */
+    void markChanged() noexcept;
+private:
+    friend class Controller;
+};
+
+/**
+ *   A typed console variable for bool, i32, u32 or f32.
+ *
+ *   The value is kept in its own cache line, so reading it from hot
+ * code is a single relaxed atomic load that never contends with
+ * anything else.
+ */
+template<typename _T>
+class CVar final : public CVarBase
+{
+    DEFAULT_DESTRUCT(CVar);
+    DELETE_CM(CVar);
+    static_assert(::std::is_same_v<_T, bool> || ::std::is_same_v<_T, i32> || ::std::is_same_v<_T, u32> || ::std::is_same_v<_T, f32>, "CVar only supports bool, i32, u32 and f32.");
+private:
+    alignas(64) ::std::atomic<_T> _value;
+public:
+    CVar(const char* const name, const char* const info, const _T defaultValue, const ChangeCallback callback = nullptr, void* const userParam = nullptr) noexcept
+        : CVarBase(name, info, callback, userParam)
+        , _value(defaultValue)
+    { }
+
+    [[nodiscard]] _T get() const noexcept { return _value.load(::std::memory_order_relaxed); }
+    [[nodiscard]] operator _T() const noexcept { return _value.load(::std::memory_order_relaxed); }
+
+    void set(const _T value) noexcept
+    {
+        if(_value.exchange(value, ::std::memory_order_relaxed) != value)
+        { markChanged(); }
+    }
+
+    CVar<_T>& operator=(const _T value) noexcept
+    {
+        set(value);
+        return *this;
+    }
+
+    [[nodiscard]] const char* usage() const noexcept override
+    {
+        if constexpr(::std::is_same_v<_T, bool>)
+        { return "<cvar> [value{boolean}]"; }
+        else if constexpr(::std::is_same_v<_T, i32>)
+        { return "<cvar> [value{i32}]"; }
+        else if constexpr(::std::is_same_v<_T, u32>)
+        { return "<cvar> [value{u32}]"; }
+        else
+        { return "<cvar> [value{f32}]"; }
+    }
+protected:
+    [[nodiscard]] bool parse(const char* const str) noexcept override
+    {
+        if constexpr(::std::is_same_v<_T, bool>)
+        {
+            const BoolFromStr value = Controller::parseBool(str);
+            if(value == BoolFromStr::Unknown)
+            { return false; }
+            set(value == BoolFromStr::True);
+        }
+        else
+        {
+            ParseIntError error;
+            _T value;
+            if constexpr(::std::is_same_v<_T, i32>)
+            { value = Controller::parseI32(str, &error); }
+            else if constexpr(::std::is_same_v<_T, u32>)
+            { value = Controller::parseU32(str, &error); }
+            else
+            { value = Controller::parseF32(str, &error); }
+
+            if(error != ParseIntError::None)
+            { return false; }
+            set(value);
+        }
+
+        return true;
+    }
+
+    void print(Controller* const consoleHandler) const noexcept override
+    {
+        if constexpr(::std::is_same_v<_T, bool>)
+        { consoleHandler->printf("%s = %s\n", name(), get() ? "true" : "false"); }
+        else if constexpr(::std::is_same_v<_T, i32>)
+        { consoleHandler->printf("%s = %d\n", name(), get()); }
+        else if constexpr(::std::is_same_v<_T, u32>)
+        { consoleHandler->printf("%s = %u\n", name(), get()); }
+        else
+        { consoleHandler->printf("%s = %f\n", name(), static_cast<f64>(get())); }
+    }
+};
+
+}
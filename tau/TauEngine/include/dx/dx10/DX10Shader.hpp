@@ -101,6 +101,8 @@ public:
 
     [[nodiscard]] ID3D10Blob* shaderBlob() const noexcept { return _shaderBlob; }
 
+    [[nodiscard]] u64 inputSignature() const noexcept override;
+
     void bind(DX10RenderingContext& context) noexcept override;
     void unbind(DX10RenderingContext& context) noexcept override;
 };
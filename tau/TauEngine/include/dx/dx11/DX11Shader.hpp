@@ -94,6 +94,8 @@ public:
 
     [[nodiscard]] ID3DBlob* shaderBlob() const noexcept { return _shaderBlob; }
 
+    [[nodiscard]] u64 inputSignature() const noexcept override;
+
     void bind(DX11RenderingContext& context) noexcept override;
     void unbind(DX11RenderingContext& context) noexcept override;
 };
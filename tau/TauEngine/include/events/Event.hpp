@@ -77,6 +77,7 @@ public:
     { return _T::getStaticType() == getEventType(); }
 private:
     friend class EventDispatcher;
+    friend class EventBus;
 };
 
 class ExampleEvent final : public Event
@@ -0,0 +1,174 @@
+#pragma once
+
+#pragma warning(push, 0)
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+#pragma warning(pop)
+
+#include <DLL.hpp>
+#include <NumTypes.hpp>
+#include <Objects.hpp>
+#include "events/Event.hpp"
+
+/**
+ *   A queue of events which any thread can post to, delivered
+ * on a single thread once per frame.
+ *
+ *   Events are constructed by value in an arena owned by the
+ * current frame, posting only takes a few atomic operations and
+ * never locks. There are two frames, dispatch switches producers
+ * over to the other one, waits for any post still in progress on
+ * the old one, then delivers its events and resets its arena.
+ *
+ *   Handlers are kept in a table indexed by the dense index of
+ * the event type. Events are grouped by type before delivery,
+ * every handler of a type is then run over all of the events of
+ * that type in the order they were posted. Events from a single
+ * thread are delivered in the order they were posted only if
+ * they have the same type.
+ *
+ *   Like EventDispatcher only the exact type of an event is
+ * matched, and once an interceptable event is intercepted the
+ * handlers after it don't see it.
+ *
+ *   Handlers may post events, which are delivered on the next
+ * dispatch. Subscribing and unsubscribing must happen on the
+ * dispatching thread, and not from within a handler.
+ */
+class TAU_DLL EventBus final
+{
+    DELETE_CM(EventBus);
+public:
+    /**
+     * Returns true if the event was intercepted.
+     */
+    using Handler = bool(__cdecl *)(void* userParam, Event& e) noexcept;
+
+    /**
+     *   Receives every event of a type at once, including the
+     * ones intercepted by an earlier handler.
+     */
+    using BatchHandler = void(__cdecl *)(void* userParam, Event* const* events, uSys count) noexcept;
+
+    /**
+     * The size of the blocks the frame arenas are allocated in.
+     */
+    static constexpr uSys ChunkSize = 64 * 1024;
+    static constexpr uSys MaxEventAlignment = 16;
+private:
+    struct Node final
+    {
+        Node* next;
+        Event* event;
+        u32 typeIndex;
+    };
+
+    struct Chunk;
+
+    struct alignas(64) Frame final
+    {
+        ::std::atomic<Node*> head;
+        ::std::atomic<Chunk*> chunk;
+        ::std::atomic<u32> writers;
+    };
+
+    struct HandlerEntry final
+    {
+        Handler handler;
+        BatchHandler batchHandler;
+        void* userParam;
+    };
+
+    static constexpr uSys NodeSize = (sizeof(Node) + MaxEventAlignment - 1) & ~(MaxEventAlignment - 1);
+private:
+    Frame _frames[2];
+    ::std::atomic<u32> _current;
+
+    ::std::vector<::std::vector<HandlerEntry>> _handlers;
+
+    /**
+     * Scratch used by dispatch, kept to avoid reallocating it.
+     */
+    ::std::vector<Node*> _nodes;
+    ::std::vector<Event*> _sorted;
+    ::std::vector<u32> _typeOffsets;
+public:
+    EventBus() noexcept;
+
+    /**
+     * Destroys any pending events without delivering them.
+     */
+    ~EventBus() noexcept;
+
+    /**
+     *   Constructs an event of type `_T` in the current frame. This
+     * can be called from any thread. Returns false if the frame
+     * arena couldn't grow.
+     */
+    template<typename _T, typename... _Args>
+    bool post(_Args&&... args) noexcept
+    {
+        static_assert(alignof(_T) <= MaxEventAlignment, "Events are aligned to at most MaxEventAlignment bytes.");
+
+        Frame& frame = beginPost();
+        u8* const storage = allocate(frame, NodeSize + sizeof(_T));
+        if(!storage)
+        {
+            endPost(frame);
+            return false;
+        }
+
+        Node* const node = reinterpret_cast<Node*>(storage);
+        node->event = new(storage + NodeSize) _T(::std::forward<_Args>(args)...);
+        node->typeIndex = _T::getStaticType().index();
+        push(frame, node);
+
+        endPost(frame);
+        return true;
+    }
+
+    /**
+     * Delivers every event posted before this call. Returns the number of events.
+     */
+    uSys dispatch() noexcept;
+
+    void subscribe(const Event::EventType& type, Handler handler, void* userParam) noexcept;
+    void subscribeBatch(const Event::EventType& type, BatchHandler handler, void* userParam) noexcept;
+
+    /**
+     *   Subscribes a member function with the same signature as the
+     * ones passed to EventDispatcher::dispatch.
+     *
+     *   bus.subscribe<WindowKeyEvent, &ConsoleLayer::onKeyPress>(this);
+     */
+    template<typename _T, auto _Func, typename _C>
+    void subscribe(_C* const instance) noexcept
+    {
+        subscribe(_T::getStaticType(), [](void* const userParam, Event& e) noexcept -> bool
+        { return (static_cast<_C*>(userParam)->*_Func)(static_cast<_T&>(e)); }, instance);
+    }
+
+    /**
+     * Removes every handler registered with `userParam`.
+     */
+    void unsubscribe(const void* userParam) noexcept;
+private:
+    Frame& beginPost() noexcept;
+    void endPost(Frame& frame) noexcept;
+    static u8* allocate(Frame& frame, uSys size) noexcept;
+    static void push(Frame& frame, Node* node) noexcept;
+
+    static Chunk* createChunk(uSys capacity, uSys used) noexcept;
+    static void destroyChunks(Chunk* chunk) noexcept;
+
+    /**
+     *   Takes the events of a frame nobody is posting to any more,
+     * in the order they were posted.
+     */
+    void collect(Frame& frame) noexcept;
+    void release(Frame& frame) noexcept;
+
+    void addHandler(u32 typeIndex, const HandlerEntry& entry) noexcept;
+};
@@ -18,6 +18,14 @@ private:
     GLStateManager _glStateManager;
     GLenum _currentDrawType;
     GLenum _currentIndexSize;
+
+    /**
+     *   Ids of the states last applied to the state manager,
+     * 0 when unknown. States without an id are always applied.
+     */
+    u32 _blendingStateId;
+    u32 _depthStencilStateId;
+    u32 _rasterizerStateId;
 public:
     void executeCommandLists(uSys count, const ICommandList* const * lists) noexcept override;
 
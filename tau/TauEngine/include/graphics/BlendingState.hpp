@@ -180,16 +180,29 @@ class TAU_DLL TAU_NOVTABLE IBlendingState
     DEFAULT_CM_PO(IBlendingState);
 protected:
     BlendingArgs _args;
+private:
+    u32 _stateId;
 protected:
     IBlendingState(const BlendingArgs& args) noexcept
         : _args(args)
+        , _stateId(0)
     { }
 public:
     [[nodiscard]] const BlendingArgs& args() const noexcept { return _args; }
 
+    /**
+     *   A unique id assigned when the state is interned by a
+     * StateCache, 0 if it wasn't. Equal non-zero ids are the
+     * same object, so redundant binds can be skipped with an
+     * integer compare.
+     */
+    [[nodiscard]] u32 stateId() const noexcept { return _stateId; }
+
     RTT_BASE_IMPL(IBlendingState);
     RTT_BASE_CHECK(IBlendingState);
     RTT_BASE_CAST(IBlendingState);
+private:
+    friend class StateCache;
 };
 
 class TAU_DLL TAU_NOVTABLE IBlendingStateBuilder
@@ -55,7 +55,30 @@ public:
         Matrix3x4Double,
         Matrix4x2Double,
         Matrix4x3Double,
-        Matrix4x4Double
+        Matrix4x4Double,
+        /**
+         *   Packed vertex formats. These are stored in fewer bits
+         * and widened to floats by the input assembler, the shader
+         * sees a float vector with the same number of components.
+         *
+         *   There are no 3 component variants, neither DirectX nor
+         * most GL drivers fetch 3 component 8 or 16 bit vertices,
+         * pad them to 4 components instead.
+         */
+        Vector2Half,
+        Vector4Half,
+        Vector2SNorm8,
+        Vector4SNorm8,
+        Vector2UNorm8,
+        Vector4UNorm8,
+        Vector2SNorm16,
+        Vector4SNorm16,
+        Vector2UNorm16,
+        Vector4UNorm16,
+        /**
+         * 10 bits for each of x, y and z and 2 bits for w, x in the low bits.
+         */
+        Vector4UNorm10_10_10_2
     };
 
     class Typed
@@ -120,9 +143,30 @@ public:
     static bool isBool(Type type) noexcept;
     static bool isInt(Type type) noexcept;
     static bool isUInt(Type type) noexcept;
+
+    /**
+     * Is this a single or half precision type, doubles are isDouble.
+     */
     static bool isFloat(Type type) noexcept;
     static bool isDouble(Type type) noexcept;
     static bool isValidInput(Type type) noexcept;
+
+    /**
+     * Is this one of the packed vertex formats.
+     */
+    static bool isPacked(Type type) noexcept;
+
+    /**
+     *   Is this mapped to [-1, 1] or [0, 1] by the input assembler,
+     * regardless of the normalized flag of the element.
+     */
+    static bool isNormalized(Type type) noexcept;
+
+    /**
+     *   The type the shader receives. This is the float vector a
+     * packed format is widened to, and the type itself otherwise.
+     */
+    static Type shaderType(Type type) noexcept;
 };
 
 class ShaderSemantic final
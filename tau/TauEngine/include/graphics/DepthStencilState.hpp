@@ -100,16 +100,26 @@ class TAU_DLL TAU_NOVTABLE IDepthStencilState
     DEFAULT_CM_PO(IDepthStencilState);
 protected:
     DepthStencilArgs _args;
+private:
+    u32 _stateId;
 protected:
     IDepthStencilState(const DepthStencilArgs& args) noexcept
         : _args(args)
+        , _stateId(0)
     { }
 public:
     [[nodiscard]] const DepthStencilArgs& args() const noexcept { return _args; }
 
+    /**
+     * 0 unless the state was interned by a StateCache.
+     */
+    [[nodiscard]] u32 stateId() const noexcept { return _stateId; }
+
     RTT_BASE_IMPL(IDepthStencilState);
     RTT_BASE_CHECK(IDepthStencilState);
     RTT_BASE_CAST(IDepthStencilState);
+private:
+    friend class StateCache;
 };
 
 class TAU_DLL TAU_NOVTABLE IDepthStencilStateBuilder
@@ -103,6 +103,9 @@ using GPUDescriptorHandle = TDescriptorHandle<u64, 1>;
  *   Unlike DirectX12 you are expected to destroy tables. This
  * is because the descriptor table is intended to contain
  * allocations for all of the Tau descriptor objects.
+ *
+ *   Tables are sub-allocated from the heap with a
+ * DescriptorHeapAllocator.
  */
 class TAU_DLL TAU_NOVTABLE IDescriptorHeap
 {
@@ -0,0 +1,103 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <allocator/DescriptorTableAllocator.hpp>
+
+#include "DescriptorHeap.hpp"
+
+/**
+ * A table allocated from a DescriptorHeapAllocator.
+ */
+struct DescriptorTable final
+{
+    DEFAULT_CONSTRUCT_PU(DescriptorTable);
+    DEFAULT_DESTRUCT(DescriptorTable);
+    DEFAULT_CM_PU(DescriptorTable);
+public:
+    CPUDescriptorHandle cpu;
+    /**
+     * Null if the heap isn't shader visible.
+     */
+    GPUDescriptorHandle gpu;
+    DescriptorRange range;
+public:
+    DescriptorTable(const CPUDescriptorHandle _cpu, const GPUDescriptorHandle _gpu, const DescriptorRange& _range) noexcept
+        : cpu(_cpu)
+        , gpu(_gpu)
+        , range(_range)
+    { }
+
+    [[nodiscard]] u32 count() const noexcept { return range.count; }
+
+    [[nodiscard]] operator bool() const noexcept { return range.valid(); }
+};
+
+/**
+ * Allocates descriptor tables from a descriptor heap.
+ *
+ *   This ties a DescriptorTableAllocator to a heap, turning
+ * the ranges it allocates into handles. See
+ * DescriptorTableAllocator for how the heap is split between
+ * persistent and transient tables, and how frees are deferred
+ * until the GPU has finished with them.
+ */
+class DescriptorHeapAllocator final
+{
+    DEFAULT_DESTRUCT(DescriptorHeapAllocator);
+    DELETE_CM(DescriptorHeapAllocator);
+private:
+    NullableRef<IDescriptorHeap> _heap;
+    DescriptorTableAllocator _allocator;
+public:
+    /**
+     *   The heap needs to hold at least `persistentCount +
+     * transientCount` descriptors.
+     */
+    DescriptorHeapAllocator(const NullableRef<IDescriptorHeap>& heap, const u32 persistentCount, const u32 transientCount, const u32 maxFramesInFlight = 3) noexcept
+        : _heap(heap)
+        , _allocator(persistentCount, transientCount, maxFramesInFlight)
+    { }
+
+    [[nodiscard]] const NullableRef<IDescriptorHeap>& heap() const noexcept { return _heap; }
+    [[nodiscard]] const DescriptorTableAllocator& allocator() const noexcept { return _allocator; }
+
+    [[nodiscard]] DescriptorTable allocateTable(const u32 numDescriptors) noexcept
+    { return table(_allocator.allocate(numDescriptors)); }
+
+    /**
+     *   The table remains valid until the fence of the current
+     * frame completes.
+     */
+    void destroyTable(const DescriptorTable& table) noexcept
+    { _allocator.free(table.range); }
+
+    /**
+     * The table is only valid for the current frame.
+     */
+    [[nodiscard]] DescriptorTable allocateTransientTable(const u32 numDescriptors) noexcept
+    { return table(_allocator.allocateTransient(numDescriptors)); }
+
+    /**
+     * @see DescriptorTableAllocator::beginFrame
+     */
+    bool beginFrame(const u64 frameFence, const u64 completedFence) noexcept
+    { return _allocator.beginFrame(frameFence, completedFence); }
+private:
+    [[nodiscard]] DescriptorTable table(const DescriptorRange& range) const noexcept
+    {
+        if(!range)
+        { return DescriptorTable(CPUDescriptorHandle(0), GPUDescriptorHandle(0), range); }
+
+        const uSys stride = _heap->getOffsetStride();
+        const GPUDescriptorHandle gpuBase = _heap->getBaseGPUHandle();
+
+        return DescriptorTable(
+            CPUDescriptorHandle(_heap->getBaseCPUHandle(), range.offset, stride),
+            gpuBase ? GPUDescriptorHandle(gpuBase, range.offset, stride) : gpuBase,
+            range);
+    }
+};
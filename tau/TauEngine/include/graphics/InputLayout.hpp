@@ -19,13 +19,25 @@ class IRenderingContext;
 
 class TAU_DLL TAU_NOVTABLE IInputLayout
 {
-    DEFAULT_CONSTRUCT_PU(IInputLayout);
     DEFAULT_DESTRUCT_VI(IInputLayout);
     DEFAULT_CM_PO(IInputLayout);
+private:
+    u32 _stateId;
 public:
+    IInputLayout() noexcept
+        : _stateId(0)
+    { }
+
+    /**
+     * 0 unless the layout was interned by a StateCache.
+     */
+    [[nodiscard]] u32 stateId() const noexcept { return _stateId; }
+
     RTT_BASE_IMPL(IInputLayout);
     RTT_BASE_CHECK(IInputLayout);
     RTT_BASE_CAST(IInputLayout);
+private:
+    friend class StateCache;
 };
 
 struct InputLayoutArgs final
@@ -41,16 +41,25 @@ class TAU_DLL TAU_NOVTABLE IPipelineState
     DEFAULT_CM_PO(IPipelineState);
 private:
     PipelineArgs _args;
+    u32 _stateId;
 public:
     IPipelineState(const PipelineArgs& args) noexcept
         : _args(args)
+        , _stateId(0)
     { }
 
     [[nodiscard]] const PipelineArgs& args() const noexcept { return _args; }
 
+    /**
+     * 0 unless the pipeline was interned by a StateCache.
+     */
+    [[nodiscard]] u32 stateId() const noexcept { return _stateId; }
+
     RTT_BASE_IMPL(IPipelineState);
     RTT_BASE_CHECK(IPipelineState);
     RTT_BASE_CAST(IPipelineState);
+private:
+    friend class StateCache;
 };
 
 class TAU_DLL SimplePipelineState final : public IPipelineState
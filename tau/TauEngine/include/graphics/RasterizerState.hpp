@@ -69,16 +69,26 @@ class TAU_DLL TAU_NOVTABLE IRasterizerState
     DEFAULT_CM_PO(IRasterizerState);
 protected:
     RasterizerArgs _args;
+private:
+    u32 _stateId;
 protected:
     IRasterizerState(const RasterizerArgs& args) noexcept
         : _args(args)
+        , _stateId(0)
     { }
 public:
     [[nodiscard]] const RasterizerArgs& args() const noexcept { return _args; }
 
+    /**
+     * 0 unless the state was interned by a StateCache.
+     */
+    [[nodiscard]] u32 stateId() const noexcept { return _stateId; }
+
     RTT_BASE_IMPL(IRasterizerState);
     RTT_BASE_CHECK(IRasterizerState);
     RTT_BASE_CAST(IRasterizerState);
+private:
+    friend class StateCache;
 };
 
 class TAU_DLL TAU_NOVTABLE IRasterizerStateBuilder
@@ -66,8 +66,11 @@ public:
  * specializations from IResource. Lower level API's are free
  * to implement the various potential structures in their own
  * classes.
+ *
+ *   Resources are released on the thread that created them when
+ * using biased reference counting.
  */
-class TAU_DLL TAU_NOVTABLE IResource
+class TAU_DLL TAU_NOVTABLE IResource : public RCPDeferredRelease
 {
     DELETE_CM(IResource);
 protected:
@@ -15,6 +15,12 @@ struct ResourceHeapArgs final
     EGraphics::ResourceHeapUsageType usage;
 };
 
+/**
+ *   Heaps are meant to hold many resources, TLSFBlockAllocator
+ * can be used to sub-allocate resources out of them. None of
+ * the GL, DX10 or DX11 backends do so yet, each of their
+ * resources is still its own API object.
+ */
 class TAU_DLL TAU_NOVTABLE IResourceHeapBuilder
 {
     DEFAULT_CONSTRUCT_PO(IResourceHeapBuilder);
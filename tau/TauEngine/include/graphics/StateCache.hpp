@@ -0,0 +1,155 @@
+/**
+ * @file
+ *
+ * Describes a cache that interns pipeline state objects.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+
+#include "BlendingState.hpp"
+#include "DepthStencilState.hpp"
+#include "RasterizerState.hpp"
+#include "InputLayout.hpp"
+#include "PipelineState.hpp"
+#include "DLL.hpp"
+
+class IGraphicsInterface;
+
+/**
+ * Interns state objects by their description.
+ *
+ *   Requesting a state whose description matches one already
+ * in the cache returns the existing object instead of building
+ * a new one in the backend. Every object built by the cache is
+ * given a unique, densely allocated id (see
+ * {@link IBlendingState::stateId() @endlink}), so the command
+ * queues can skip binding a state that is already bound with a
+ * single integer compare instead of diffing every field.
+ *
+ *   Descriptions are compared by value, with any fields the
+ * backends ignore left out. Blending states without
+ * independent blending only compare the first framebuffer
+ * beyond whether blending is enabled. Pipelines compare the
+ * identity of the objects they reference, so their states
+ * should come from the same cache.
+ *
+ *   Shader programs aren't reference counted, so the cache
+ * can't keep one alive and a new program may reuse the address
+ * of a destroyed one. Pipelines are keyed on an id the cache
+ * assigns to each program instead, which
+ * {@link StateCache::releaseShaderProgram(ShaderProgram) @endlink}
+ * retires before the program is destroyed.
+ *
+ *   The cache holds a reference to everything it has built,
+ * {@link StateCache::collect() @endlink} releases the objects
+ * nothing else references. The cache is not thread safe.
+ */
+class TAU_DLL StateCache final
+{
+    DEFAULT_DESTRUCT(StateCache);
+    DELETE_CM(StateCache);
+public:
+    struct Stats final
+    {
+        u64 hits;
+        u64 misses;
+    };
+private:
+    struct Key final
+    {
+        u64 hash;
+        ::std::vector<u64> words;
+
+        [[nodiscard]] bool operator ==(const Key& other) const noexcept
+        { return hash == other.hash && words == other.words; }
+    };
+
+    struct KeyHash final
+    {
+        [[nodiscard]] uSys operator()(const Key& key) const noexcept
+        { return static_cast<uSys>(key.hash); }
+    };
+
+    template<typename _T>
+    using Table = ::std::unordered_map<Key, NullableRef<_T>, KeyHash>;
+private:
+    IBlendingStateBuilder& _blendingStateBuilder;
+    IDepthStencilStateBuilder& _depthStencilStateBuilder;
+    IRasterizerStateBuilder& _rasterizerStateBuilder;
+    IInputLayoutBuilder& _inputLayoutBuilder;
+
+    Table<IBlendingState> _blendingStates;
+    Table<IDepthStencilState> _depthStencilStates;
+    Table<IRasterizerState> _rasterizerStates;
+    Table<IInputLayout> _inputLayouts;
+    Table<IPipelineState> _pipelineStates;
+
+    ::std::unordered_map<const void*, u64> _shaderPrograms;
+
+    Stats _stats;
+public:
+    /**
+     *   Builds states with the given builders, this allows the
+     * cache to be used with a headless backend.
+     */
+    StateCache(IBlendingStateBuilder& blendingStateBuilder, IDepthStencilStateBuilder& depthStencilStateBuilder, IRasterizerStateBuilder& rasterizerStateBuilder, IInputLayoutBuilder& inputLayoutBuilder) noexcept;
+
+    explicit StateCache(IGraphicsInterface& gi) noexcept;
+
+    [[nodiscard]] NullableRef<IBlendingState> blendingState(const BlendingArgs& args, [[tau::out]] IBlendingStateBuilder::Error* error = null) noexcept;
+    [[nodiscard]] NullableRef<IDepthStencilState> depthStencilState(const DepthStencilArgs& args, [[tau::out]] IDepthStencilStateBuilder::Error* error = null) noexcept;
+    [[nodiscard]] NullableRef<IRasterizerState> rasterizerState(const RasterizerArgs& args, [[tau::out]] IRasterizerStateBuilder::Error* error = null) noexcept;
+    [[nodiscard]] NullableRef<IInputLayout> inputLayout(const InputLayoutArgs& args, [[tau::out]] IInputLayoutBuilder::Error* error = null) noexcept;
+
+    /**
+     *   Pipeline builders are not exposed by the graphics
+     * interface, so the builder is passed per call.
+     */
+    [[nodiscard]] NullableRef<IPipelineState> pipelineState(const PipelineStateBuilder& builder, const PipelineArgs& args, [[tau::out]] PipelineStateBuilder::Error* error = null) noexcept;
+
+    /**
+     *   Releases every state that is only referenced by the
+     * cache. Returns the number of states released.
+     */
+    uSys collect() noexcept;
+
+    /**
+     *   Retires the id of a shader program, this has to be called
+     * before the program is destroyed. Pipelines built from it
+     * are never returned again, even to a program created at the
+     * same address, and are released by
+     * {@link StateCache::collect() @endlink} once nothing else
+     * references them.
+     */
+    void releaseShaderProgram(ShaderProgram program) noexcept;
+
+    void clear() noexcept;
+
+    [[nodiscard]] const Stats& stats() const noexcept { return _stats; }
+
+    [[nodiscard]] uSys size() const noexcept
+    { return _blendingStates.size() + _depthStencilStates.size() + _rasterizerStates.size() + _inputLayouts.size() + _pipelineStates.size(); }
+private:
+    template<typename _T, typename _Build>
+    [[nodiscard]] NullableRef<_T> intern(Table<_T>& table, Key&& key, ::std::atomic<u32>& ids, const _Build& build) noexcept;
+
+    template<typename _T>
+    static uSys collect(Table<_T>& table) noexcept;
+
+    [[nodiscard]] u64 shaderProgramId(ShaderProgram program) noexcept;
+
+    [[nodiscard]] static Key makeKey(const BlendingArgs& args) noexcept;
+    [[nodiscard]] static Key makeKey(const DepthStencilArgs& args) noexcept;
+    [[nodiscard]] static Key makeKey(const RasterizerArgs& args) noexcept;
+    [[nodiscard]] static Key makeKey(const InputLayoutArgs& args) noexcept;
+    [[nodiscard]] static Key makeKey(const PipelineArgs& args, u64 shaderProgramId) noexcept;
+};
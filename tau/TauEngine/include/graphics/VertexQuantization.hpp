@@ -0,0 +1,79 @@
+/**
+ * @file
+ *
+ * Batch converters from float vertex attributes to the packed
+ * vertex formats of ShaderDataType.
+ */
+#pragma once
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include "DLL.hpp"
+
+/**
+ *   Every converter processes 4 vertices at a time with SSE4.1
+ * and finishes the remainder with the scalar code, both produce
+ * bit identical results. Sources and destinations only need the
+ * alignment of their element type.
+ */
+class TAU_DLL VertexQuantization final
+{
+    DELETE_CONSTRUCT(VertexQuantization);
+    DELETE_DESTRUCT(VertexQuantization);
+    DELETE_CM(VertexQuantization);
+public:
+    /**
+     *   Converts `count` floats to half floats, rounding to nearest
+     * even. Values too large for a half become infinity, NaNs stay
+     * NaNs.
+     */
+    static void floatToHalf(const f32* src, u16* dst, uSys count) noexcept;
+
+    static void halfToFloat(const u16* src, f32* dst, uSys count) noexcept;
+
+    /**
+     *   Encodes `count` normals, stored as xyz triplets, into 2
+     * SNorm16 components using an octahedral mapping. The normals
+     * don't need to be normalized, zero length normals encode to
+     * (0, 0).
+     *
+     *   This is intended for Vector2SNorm16 attributes, the error
+     * is below 0.01 degrees.
+     */
+    static void encodeOctahedral(const f32* normals, i16* dst, uSys count) noexcept;
+
+    /**
+     * Decodes normals written by encodeOctahedral into xyz triplets.
+     */
+    static void decodeOctahedral(const i16* src, f32* normals, uSys count) noexcept;
+
+    /**
+     *   Encodes `count` unit vectors, stored as xyz triplets, into
+     * the xyz components of Vector4UNorm10_10_10_2, mapping [-1, 1]
+     * to [0, 1]. W is set to 1.
+     */
+    static void encodeUnitVectors(const f32* vectors, u32* dst, uSys count) noexcept;
+
+    /**
+     *   The bounds of `count` vectors of `components` floats.
+     * `min` and `max` receive `components` floats.
+     */
+    static void computeBounds(const f32* src, uSys count, uSys components, f32* min, f32* max) noexcept;
+
+    /**
+     *   Quantizes `count` vectors of `components` floats, between 1
+     * and 4, to UNorm16 with `min` mapped to 0 and `max` to 1. The
+     * values are recovered with `min + unorm * (max - min)`.
+     *
+     *   This is intended for texture coordinates and positions in
+     * Vector2UNorm16 and Vector4UNorm16 attributes.
+     */
+    static void quantizeUNorm16(const f32* src, u16* dst, uSys count, uSys components, const f32* min, const f32* max) noexcept;
+
+    /**
+     *   Forces the scalar code for every converter, used to compare
+     * both paths.
+     */
+    static void forceScalar(bool scalar) noexcept;
+    [[nodiscard]] static bool scalarForced() noexcept;
+};
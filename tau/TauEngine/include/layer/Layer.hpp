@@ -50,6 +50,16 @@ public:
     virtual void onDetach() noexcept { }
 
     virtual void onUpdate(float fixedDelta) noexcept { }
+
+    /**
+     *   Window events and ControlEvents are sent synchronously
+     * through every layer. They aren't on EventBus yet because
+     * ControlEvents point to data on the stack of the console
+     * command sending them, and window messages expect to be
+     * handled before they return. Events posted from other
+     * threads should go through an EventBus dispatched from
+     * onUpdate instead.
+     */
     virtual void onEvent(Event& e) noexcept { }
 
     /**
@@ -0,0 +1,110 @@
+#pragma once
+
+#pragma warning(push, 0)
+#include <glm/mat4x4.hpp>
+#include <cmath>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include "maths/Vector3f.hpp"
+
+struct BoundingSphere final
+{
+    DEFAULT_DESTRUCT(BoundingSphere);
+    DEFAULT_CM_PU(BoundingSphere);
+public:
+    Vector3f center;
+    float radius;
+public:
+    BoundingSphere() noexcept
+        : center(0.0f)
+        , radius(0.0f)
+    { }
+
+    BoundingSphere(const Vector3f& _center, const float _radius) noexcept
+        : center(_center)
+        , radius(_radius)
+    { }
+};
+
+/**
+ *   An axis aligned bounding box, stored as its center and half
+ * extents rather than its corners. That is the form the plane
+ * tests want, the corners are only needed when merging.
+ */
+struct BoundingBox final
+{
+    DEFAULT_DESTRUCT(BoundingBox);
+    DEFAULT_CM_PU(BoundingBox);
+public:
+    Vector3f center;
+    Vector3f extent;
+public:
+    BoundingBox() noexcept
+        : center(0.0f)
+        , extent(0.0f)
+    { }
+
+    BoundingBox(const Vector3f& _center, const Vector3f& _extent) noexcept
+        : center(_center)
+        , extent(_extent)
+    { }
+
+    [[nodiscard]] static BoundingBox fromMinMax(const Vector3f& min, const Vector3f& max) noexcept
+    {
+        return BoundingBox(Vector3f((min.x() + max.x()) * 0.5f, (min.y() + max.y()) * 0.5f, (min.z() + max.z()) * 0.5f),
+                           Vector3f((max.x() - min.x()) * 0.5f, (max.y() - min.y()) * 0.5f, (max.z() - min.z()) * 0.5f));
+    }
+
+    [[nodiscard]] Vector3f min() const noexcept
+    { return Vector3f(center.x() - extent.x(), center.y() - extent.y(), center.z() - extent.z()); }
+
+    [[nodiscard]] Vector3f max() const noexcept
+    { return Vector3f(center.x() + extent.x(), center.y() + extent.y(), center.z() + extent.z()); }
+
+    [[nodiscard]] float surfaceArea() const noexcept
+    { return 8.0f * (extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x()); }
+
+    /**
+     * The smallest sphere centered on the box that contains it.
+     */
+    [[nodiscard]] BoundingSphere sphere() const noexcept
+    { return BoundingSphere(center, extent.length()); }
+
+    [[nodiscard]] BoundingBox merge(const BoundingBox& other) const noexcept
+    {
+        const Vector3f aMin = min();
+        const Vector3f aMax = max();
+        const Vector3f bMin = other.min();
+        const Vector3f bMax = other.max();
+        return fromMinMax(Vector3f(::std::fmin(aMin.x(), bMin.x()), ::std::fmin(aMin.y(), bMin.y()), ::std::fmin(aMin.z(), bMin.z())),
+                          Vector3f(::std::fmax(aMax.x(), bMax.x()), ::std::fmax(aMax.y(), bMax.y()), ::std::fmax(aMax.z(), bMax.z())));
+    }
+
+    /**
+     *   Transforms the box by an affine matrix, the result is the
+     * box around the transformed box. The center is transformed
+     * as a point, each new extent is the sum of the old extents
+     * weighted by the absolute values of the matrix's rows.
+     */
+    [[nodiscard]] BoundingBox transform(const glm::mat4& matrix) const noexcept
+    {
+        const float c[3] = { center.x(), center.y(), center.z() };
+        const float e[3] = { extent.x(), extent.y(), extent.z() };
+        float newCenter[3];
+        float newExtent[3];
+
+        for(uSys row = 0; row < 3; ++row)
+        {
+            newCenter[row] = matrix[3][row];
+            newExtent[row] = 0.0f;
+            for(uSys column = 0; column < 3; ++column)
+            {
+                newCenter[row] += matrix[column][row] * c[column];
+                newExtent[row] += ::std::fabs(matrix[column][row]) * e[column];
+            }
+        }
+
+        return BoundingBox(Vector3f(newCenter[0], newCenter[1], newCenter[2]), Vector3f(newExtent[0], newExtent[1], newExtent[2]));
+    }
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#pragma warning(push, 0)
+#include <glm/mat4x4.hpp>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include "maths/Bounds.hpp"
+#include "DLL.hpp"
+
+/**
+ *   The planes of a view frustum, extracted from a view
+ * projection matrix. Normals point inwards and are normalized,
+ * a point p is inside a plane when dot(normal, p) + d >= 0.
+ *
+ *   The planes are stored as a structure of arrays padded to 8
+ * so that a bounding volume can be tested against 4 planes at
+ * once. The padding planes contain everything.
+ */
+class TAU_DLL Frustum final
+{
+    DEFAULT_DESTRUCT(Frustum);
+    DEFAULT_CM_PU(Frustum);
+public:
+    enum Plane : uSys
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far
+    };
+
+    enum class Result
+    {
+        Outside = 0,
+        Intersecting,
+        Inside
+    };
+
+    static constexpr uSys PLANE_COUNT = 6;
+    static constexpr uSys PADDED_PLANE_COUNT = 8;
+private:
+    alignas(16) float _normalX[PADDED_PLANE_COUNT];
+    alignas(16) float _normalY[PADDED_PLANE_COUNT];
+    alignas(16) float _normalZ[PADDED_PLANE_COUNT];
+    alignas(16) float _distance[PADDED_PLANE_COUNT];
+public:
+    /**
+     * A frustum that contains everything.
+     */
+    Frustum() noexcept;
+
+    /**
+     *   Extracts the planes from a matrix that maps into OpenGL
+     * clip space, where visible points satisfy -w <= z <= w. For
+     * a Direct3D projection, where 0 <= z <= w, the near plane
+     * ends up behind the real one, which is conservative.
+     */
+    explicit Frustum(const glm::mat4& viewProjection) noexcept;
+
+    [[nodiscard]] const float* normalX() const noexcept { return _normalX; }
+    [[nodiscard]] const float* normalY() const noexcept { return _normalY; }
+    [[nodiscard]] const float* normalZ() const noexcept { return _normalZ; }
+    [[nodiscard]] const float* distance() const noexcept { return _distance; }
+
+    [[nodiscard]] Result classify(const BoundingBox& box) const noexcept;
+
+    [[nodiscard]] bool intersects(const BoundingBox& box) const noexcept;
+    [[nodiscard]] bool intersects(const BoundingSphere& sphere) const noexcept;
+};
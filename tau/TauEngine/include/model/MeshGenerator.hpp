@@ -5,6 +5,7 @@
 
 #include "maths/Vector2f.hpp"
 #include "maths/Vector3f.hpp"
+#include "graphics/BufferDescriptor.hpp"
 
 class TAU_DLL MeshGenerator final
 {
@@ -40,6 +41,41 @@ public:
         }
     };
 
+    /**
+     *   A Mesh with its attributes quantized and interleaved into
+     * a single vertex buffer laid out by `descriptor`.
+     *
+     *   Positions are Vector4UNorm16 relative to the bounds of the
+     * mesh, normals are octahedral Vector2SNorm16, tangents are
+     * Vector4UNorm10_10_10_2 and texture coordinates are
+     * Vector2UNorm16 relative to their bounds. The shader recovers
+     * positions and texture coordinates with `offset + value * scale`,
+     * the w component of positions is always 1.
+     *
+     *   Tangents and texture coordinates are only present if the
+     * source mesh had them.
+     */
+    struct QuantizedMesh final
+    {
+        uSys vertexCount;
+        uSys indiceCount;
+        u8* vertices;
+        u32* indices;
+        BufferDescriptor descriptor;
+        float positionOffset[3];
+        float positionScale[3];
+        float textureOffset[2];
+        float textureScale[2];
+
+        void destroy()
+        {
+            delete[] vertices;
+            delete[] indices;
+            vertices = null;
+            indices = null;
+        }
+    };
+
     struct Triangle final
     {
         Vector3f position[3];
@@ -96,6 +132,12 @@ public:
     };
 public:
     static Mesh generateMesh(const EditableMesh& mesh, const GenerationArgs& args) noexcept;
+
+    /**
+     *   Quantizes a mesh into packed vertex formats. The indices
+     * are copied, `mesh` is left untouched.
+     */
+    static QuantizedMesh quantizeMesh(const Mesh& mesh) noexcept;
     
     /**
      * top -> cube[0]
@@ -6,6 +6,7 @@
 #include <Objects.hpp>
 #include "VertexArray.hpp"
 #include "model/Material.hpp"
+#include "maths/Bounds.hpp"
 
 class IGraphicsInterface;
 class IRenderingContext;
@@ -24,6 +25,8 @@ private:
     NullableRef<IRasterizerState>& _rs;
     i32 _illumination;
     Material _material;
+    BoundingBox _bounds;
+    float _boundingRadius;
 public:
     RenderableObject(IGraphicsInterface& gi, IRenderingContext& context, const objl::Mesh& mesh, const char* materialFolder, const CPPRef<IShader>& shader, bool counterClockwise = true, DrawType drawType = DrawType::SeparatedTriangles) noexcept;
 
@@ -35,6 +38,15 @@ public:
     [[nodiscard]] CPPRef<ITexture> reflectiveTexture() const noexcept { return _reflectiveTexture; }
     [[nodiscard]] const Material& material() const noexcept { return _material; }
     [[nodiscard]] i32 illumination() const noexcept { return _illumination; }
+    /**
+     * The bounds of the mesh in model space.
+     */
+    [[nodiscard]] const BoundingBox& bounds() const noexcept { return _bounds; }
+    /**
+     *   The radius of the sphere around the center of the bounds
+     * that contains every vertex.
+     */
+    [[nodiscard]] float boundingRadius() const noexcept { return _boundingRadius; }
 
     [[nodiscard]] inline size_t hashCode() const noexcept { return reinterpret_cast<size_t>(_va.get()); }
 
@@ -0,0 +1,161 @@
+/**
+ * @file
+ *
+ * A bounding volume hierarchy for frustum culling renderables.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <vector>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include "maths/Bounds.hpp"
+#include "maths/Frustum.hpp"
+#include "DLL.hpp"
+
+/**
+ *   A dynamic bounding volume hierarchy over the bounds of
+ * renderables, used to produce the list of objects inside a
+ * frustum.
+ *
+ *   The bounds are kept as a structure of arrays in the order
+ * of the leaves, so that each leaf is tested 4 objects at a time
+ * and an entirely visible subtree is a contiguous range. Objects
+ * are referred to by a proxy that stays valid while they are
+ * moved around by rebuilds.
+ *
+ *   Splits are at the median of the longest axis, so the shape
+ * of the tree depends only on the number of objects. The levels
+ * below the top are grouped into treelets which are rebuilt in
+ * place once moving objects have degraded them, and which are
+ * the unit of work when culling on multiple threads.
+ *
+ *   Objects inserted since the last full rebuild are kept
+ * outside of the tree and tested linearly, removed objects are
+ * left in place as empty boxes. Once either exceeds a quarter of
+ * the tree the whole tree is rebuilt.
+ */
+class TAU_DLL CullingBVH final
+{
+    DEFAULT_DESTRUCT(CullingBVH);
+    DEFAULT_CM_PU(CullingBVH);
+public:
+    using Proxy = u32;
+
+    static constexpr Proxy INVALID_PROXY = 0xFFFFFFFF;
+    static constexpr u32 LEAF_SIZE = 8;
+    static constexpr u32 TREELET_SIZE = 4096;
+    /**
+     *   A treelet is rebuilt once the surface area of its nodes
+     * has grown by this much relative to its root since it was
+     * built.
+     */
+    static constexpr float REBUILD_THRESHOLD = 1.5f;
+private:
+    /**
+     *   Interior nodes have a count of 0, their left child is the
+     * next node and their right child is `index`. Leaves cover
+     * the objects [index, index + count).
+     */
+    struct Node final
+    {
+        float centerX;
+        float centerY;
+        float centerZ;
+        float extentX;
+        float extentY;
+        float extentZ;
+        u32 index;
+        u32 count;
+    };
+
+    struct Treelet final
+    {
+        u32 node;
+        u32 nodeCount;
+        u32 first;
+        u32 count;
+        float builtCost;
+        bool dirty;
+    };
+private:
+    ::std::vector<float> _centerX;
+    ::std::vector<float> _centerY;
+    ::std::vector<float> _centerZ;
+    ::std::vector<float> _extentX;
+    ::std::vector<float> _extentY;
+    ::std::vector<float> _extentZ;
+    ::std::vector<float> _radius;
+    ::std::vector<u32> _userId;
+    ::std::vector<Proxy> _proxies;
+
+    ::std::vector<u32> _slots;
+    ::std::vector<Proxy> _freeProxies;
+
+    ::std::vector<Node> _nodes;
+    ::std::vector<Treelet> _treelets;
+    /**
+     * The nodes above the treelets, in the order they were built.
+     */
+    ::std::vector<u32> _topNodes;
+
+    u32 _treeCount;
+    u32 _removedCount;
+    u32 _treeletDepth;
+    bool _moved;
+public:
+    CullingBVH() noexcept;
+
+    [[nodiscard]] Proxy insert(const BoundingBox& box, u32 userId) noexcept;
+    /**
+     *   `radius` is that of a sphere around the center of the box
+     * that also contains the object. For meshes that are close to
+     * round it is tighter than the corners of the box, objects
+     * are rejected if either is outside a plane.
+     */
+    [[nodiscard]] Proxy insert(const BoundingBox& box, float radius, u32 userId) noexcept;
+    void update(Proxy proxy, const BoundingBox& box) noexcept;
+    void update(Proxy proxy, const BoundingBox& box, float radius) noexcept;
+    void remove(Proxy proxy) noexcept;
+
+    /**
+     *   Refits the tree around any moved objects and rebuilds
+     * at most `treeletBudget` of the most degraded treelets.
+     * Performs a full rebuild if enough objects have been
+     * inserted or removed. This should be called once per frame
+     * before culling.
+     */
+    void maintain(uSys treeletBudget = 4) noexcept;
+
+    void rebuild() noexcept;
+
+    /**
+     *   Writes the user id of every object that intersects the
+     * frustum into `visible`, replacing its contents. The order
+     * is the same regardless of the worker count.
+     *
+     *   The tree must not be modified while this is running.
+     */
+    void cull(const Frustum& frustum, ::std::vector<u32>& visible, uSys workerCount = 1) const noexcept;
+
+    [[nodiscard]] uSys size() const noexcept { return _proxies.size() - _removedCount; }
+    [[nodiscard]] uSys nodeCount() const noexcept { return _nodes.size(); }
+    [[nodiscard]] uSys treeletCount() const noexcept { return _treelets.size(); }
+    [[nodiscard]] uSys pendingCount() const noexcept { return _proxies.size() - _treeCount; }
+private:
+    void setBounds(u32 slot, const BoundingBox& box, float radius) noexcept;
+    void swapSlots(u32 a, u32 b) noexcept;
+
+    u32 build(u32 node, u32 first, u32 count, u32 depth, bool topLevel) noexcept;
+    void fitLeaf(Node& node) const noexcept;
+    void fitInterior(u32 node) noexcept;
+    void refit(u32 firstNode, u32 nodeCount) noexcept;
+    [[nodiscard]] float treeletCost(const Treelet& treelet) const noexcept;
+    void rebuildTreelet(Treelet& treelet) noexcept;
+    [[nodiscard]] Treelet* treeletOf(u32 slot) noexcept;
+
+    void cullTreelet(const Frustum& frustum, const Treelet& treelet, u32* out, u32& outCount) const noexcept;
+    void cullRange(const Frustum& frustum, u32 first, u32 count, u32* out, u32& outCount) const noexcept;
+};
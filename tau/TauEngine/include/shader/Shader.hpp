@@ -26,6 +26,16 @@ public:
     [[nodiscard]] virtual uSys mapUniform(const uSys virtualIndex) const noexcept { return virtualIndex; }
     [[nodiscard]] virtual uSys mapTexture(const uSys virtualIndex) const noexcept { return virtualIndex; }
 
+    /**
+     *   Identifies the vertex inputs of the shader. Vertex shaders
+     * with the same input signature accept the same input layouts,
+     * so layouts can be shared between them.
+     *
+     *   Backends that don't validate input layouts against the
+     * shader return 0.
+     */
+    [[nodiscard]] virtual u64 inputSignature() const noexcept { return 0; }
+
     RTTD_BASE_IMPL(IShader);
     RTTD_BASE_CHECK(IShader);
     RTTD_BASE_CAST(IShader);
@@ -0,0 +1,308 @@
+/**
+ * @file
+ *
+ * Describes the compiled binary form of a shader bundle.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <vector>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+#include <IFile.hpp>
+#include <MappedFile.hpp>
+
+#include "shader/bundle/ShaderBundleVisitor.hpp"
+#include "shader/bundle/ShaderBundleLexer.hpp"
+#include "shader/EShader.hpp"
+#include "RenderingMode.hpp"
+#include "DLL.hpp"
+
+class ShaderInfoExtractorVisitor;
+
+/**
+ *   The binary format is a flat image intended to be memory
+ * mapped and read in place. Every offset is relative to the
+ * beginning of the file, every structure is 4 byte aligned,
+ * and all values are stored little endian.
+ *
+ * The layout of the file is:
+ *
+ *   Header
+ *   APIBlock[header.apiBlockCount]
+ *   (Stage, Binding[stage.uniformCount + stage.textureCount])...
+ *   String Table
+ *
+ *   Uniform bindings are stored before texture bindings within
+ * a stage. Strings are null terminated, the length stored in
+ * a StringRef does not include the terminator.
+ */
+namespace sbp::bin {
+/**
+ * "TSBB" in little endian.
+ */
+static constexpr u32 Magic = 0x42425354;
+static constexpr u16 Version = 1;
+
+static constexpr uSys StageCount = 5;
+
+struct StringRef final
+{
+    u32 offset;
+    u32 length;
+};
+
+struct Header final
+{
+    u32 magic;
+    u16 version;
+    u16 headerSize;
+    u32 fileSize;
+    /**
+     * FNV-1a of every byte following the header.
+     */
+    u32 checksum;
+    u32 apiBlockCount;
+    u32 apiBlockOffset;
+    u32 stringTableOffset;
+    u32 stringTableSize;
+};
+
+struct APIBlock final
+{
+    /**
+     * A bit mask of RenderingMode::Mode's.
+     */
+    u32 apiMask;
+    /**
+     *   The offset of each stage, indexed by
+     * `EShader::Stage - 1`. An offset of 0 means the stage is
+     * not present.
+     */
+    u32 stageOffsets[StageCount];
+
+    [[nodiscard]] bool hasAPI(const RenderingMode::Mode mode) const noexcept
+    { return apiMask & (1u << static_cast<u32>(mode)); }
+};
+
+struct Binding final
+{
+    enum Type : u32
+    {
+        Number = 1,
+        Str
+    };
+
+    CommonRenderingModelToken crmTarget;
+    Type type;
+    /**
+     * Either the bind point or the string table offset.
+     */
+    u32 value;
+    /**
+     * Only valid for texture bindings.
+     */
+    u32 sampler;
+};
+
+struct Stage final
+{
+    u32 stage;
+    StringRef fileName;
+    u16 uniformCount;
+    u16 textureCount;
+
+    [[nodiscard]] const Binding* bindings() const noexcept
+    { return reinterpret_cast<const Binding*>(this + 1); }
+
+    [[nodiscard]] const Binding* uniforms() const noexcept { return bindings(); }
+    [[nodiscard]] const Binding* textures() const noexcept { return bindings() + uniformCount; }
+};
+
+static_assert(sizeof(Header) == 32, "sbp::bin::Header must be tightly packed.");
+static_assert(sizeof(APIBlock) == 24, "sbp::bin::APIBlock must be tightly packed.");
+static_assert(sizeof(Binding) == 16, "sbp::bin::Binding must be tightly packed.");
+static_assert(sizeof(Stage) == 16, "sbp::bin::Stage must be tightly packed.");
+
+[[nodiscard]] TAU_DLL u32 checksum(const u8* data, uSys length) noexcept;
+}
+
+/**
+ * Serializes a parsed shader bundle into the binary format.
+ *
+ *   This is intended to be run offline, the runtime then loads
+ * the result through {@link CompiledShaderBundle @endlink}
+ * without ever invoking the lexer or parser.
+ */
+class TAU_DLL ShaderBundleCompiler final : public IShaderBundleVisitor
+{
+    DEFAULT_DESTRUCT(ShaderBundleCompiler);
+    DELETE_CM(ShaderBundleCompiler);
+public:
+    enum class Error
+    {
+        NoError = 0,
+        InvalidFile,
+        ParseError,
+        /**
+         * An API block did not contain any shader stages.
+         */
+        EmptyAPIBlock,
+        /**
+         * A stage was declared without a file.
+         */
+        MissingFile,
+        TooManyBindings,
+        WriteFailure
+    };
+private:
+    struct PendingStage final
+    {
+        sbp::bin::Stage stage;
+        ::std::vector<sbp::bin::Binding> uniforms;
+        ::std::vector<sbp::bin::Binding> textures;
+    };
+
+    struct PendingAPIBlock final
+    {
+        u32 apiMask;
+        /**
+         * Indices into `_stages`, -1 if the stage is not present.
+         */
+        iSys stages[sbp::bin::StageCount];
+    };
+private:
+    ::std::vector<PendingAPIBlock> _apiBlocks;
+    ::std::vector<PendingStage> _stages;
+    ::std::vector<char> _strings;
+    iSys _currentStage;
+    Error _error;
+public:
+    ShaderBundleCompiler() noexcept
+        : _currentStage(-1)
+        , _error(Error::NoError)
+    { }
+
+    /**
+     * Parses a text bundle and writes the compiled form.
+     */
+    static bool compile(const CPPRef<IFile>& bundle, const CPPRef<IFile>& output, [[tau::out]] Error* error) noexcept;
+
+    /**
+     * Produces the compiled image for an already parsed bundle.
+     */
+    [[nodiscard]] bool compile(const sbp::AST& ast, ::std::vector<u8>& image, [[tau::out]] Error* error) noexcept;
+
+    void visit(const sbp::AST* expr) noexcept override
+    { IShaderBundleVisitor::visit(expr); }
+
+    void visit(const sbp::AST& expr) noexcept override
+    { IShaderBundleVisitor::visit(expr); }
+
+    void visit(const sbp::RootAST& expr) noexcept override
+    { IShaderBundleVisitor::visit(expr); }
+
+    void visit(const sbp::FileAST& expr) noexcept override;
+    void visit(const sbp::UniformBindingAST& expr) noexcept override;
+    void visit(const sbp::TextureParamsBlockAST& expr) noexcept override;
+    void visit(const sbp::ShaderStageBlockAST& expr) noexcept override;
+    void visit(const sbp::APIBlockAST& expr) noexcept override;
+private:
+    [[nodiscard]] sbp::bin::StringRef addString(const char* str, uSys length) noexcept;
+};
+
+/**
+ * A validated, read only view of a compiled shader bundle.
+ *
+ *   The file is memory mapped when possible, all accessors
+ * point directly into the mapped image.
+ */
+class TAU_DLL CompiledShaderBundle final
+{
+    DEFAULT_DESTRUCT(CompiledShaderBundle);
+    DEFAULT_CM_PU(CompiledShaderBundle);
+public:
+    enum class Error
+    {
+        NoError = 0,
+        InvalidFile,
+        InvalidMagic,
+        UnsupportedVersion,
+        /**
+         *   The file size, checksum, or one of the offsets did not
+         * match the contents of the file.
+         */
+        CorruptFile
+    };
+public:
+    [[nodiscard]] static CompiledShaderBundle load(const CPPRef<IFile>& file, [[tau::out]] Error* error) noexcept;
+private:
+    CPPRef<MappedFile> _file;
+    const sbp::bin::Header* _header;
+private:
+    CompiledShaderBundle(const CPPRef<MappedFile>& file) noexcept
+        : _file(file)
+        , _header(file ? file->at<sbp::bin::Header>(0) : nullptr)
+    { }
+public:
+    [[nodiscard]] bool valid() const noexcept { return _header; }
+    [[nodiscard]] operator bool() const noexcept { return _header; }
+
+    [[nodiscard]] const sbp::bin::Header& header() const noexcept { return *_header; }
+
+    [[nodiscard]] const sbp::bin::APIBlock* apiBlocks() const noexcept
+    { return _file->at<sbp::bin::APIBlock>(_header->apiBlockOffset); }
+
+    /**
+     * Finds the first API block that supports the mode.
+     */
+    [[nodiscard]] const sbp::bin::APIBlock* findAPI(RenderingMode::Mode mode) const noexcept;
+
+    [[nodiscard]] const sbp::bin::Stage* stage(const sbp::bin::APIBlock& block, const EShader::Stage stage) const noexcept
+    {
+        const u32 offset = block.stageOffsets[static_cast<uSys>(stage) - 1];
+        return offset ? _file->at<sbp::bin::Stage>(offset) : nullptr;
+    }
+
+    [[nodiscard]] const char* string(const sbp::bin::StringRef& ref) const noexcept
+    { return _file->at<char>(_header->stringTableOffset + ref.offset); }
+
+    [[nodiscard]] const char* string(const u32 offset) const noexcept
+    { return _file->at<char>(_header->stringTableOffset + offset); }
+
+    /**
+     *   Populates the visitor with the same information it
+     * would have extracted from the parsed text bundle.
+     */
+    void extract(ShaderInfoExtractorVisitor& visitor) const noexcept;
+private:
+    [[nodiscard]] bool validate(Error* error) const noexcept;
+};
+
+/**
+ * Loads either a text or compiled shader bundle.
+ */
+class TAU_DLL ShaderBundleLoader final
+{
+    DELETE_CONSTRUCT(ShaderBundleLoader);
+    DELETE_DESTRUCT(ShaderBundleLoader);
+    DELETE_CM(ShaderBundleLoader);
+public:
+    static constexpr const wchar_t* TextExtension = L"tausi";
+    static constexpr const wchar_t* BinaryExtension = L"tausb";
+
+    [[nodiscard]] static bool isBundle(const CPPRef<IFile>& file) noexcept;
+    [[nodiscard]] static bool isCompiledBundle(const CPPRef<IFile>& file) noexcept;
+
+    /**
+     *   Resets the visitor and fills it with the stages targeting
+     * the visitor's rendering mode.
+     *
+     *   Compiled bundles (`.tausb`) are mapped and read in place,
+     * anything else is run through the lexer and parser.
+     */
+    static bool load(const CPPRef<IFile>& file, ShaderInfoExtractorVisitor& visitor) noexcept;
+};
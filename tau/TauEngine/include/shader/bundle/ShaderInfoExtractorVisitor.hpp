@@ -148,6 +148,8 @@ public:
         , _currentStage(static_cast<EShader::Stage>(0))
     { }
 
+    [[nodiscard]] RenderingMode::Mode targetMode() const noexcept { return _targetMode; }
+
     [[nodiscard]] const sbp::ShaderInfo&   vertexInfo() const noexcept { return _vertexInfo;   }
     [[nodiscard]] const sbp::ShaderInfo& tessCtrlInfo() const noexcept { return _tessCtrlInfo; }
     [[nodiscard]] const sbp::ShaderInfo& tessEvalInfo() const noexcept { return _tessEvalInfo; }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Objects.hpp>
+#include <Safeties.hpp>
 
 #include "DLL.hpp"
 #include "GraphicsAccelerator.hpp"
@@ -22,6 +23,7 @@ class IDescriptorHeapBuilder;
 class IDescriptorLayoutBuilder;
 class ITextureViewBuilder;
 class IRenderingContextBuilder;
+class StateCache;
 
 class TAU_DLL TAU_NOVTABLE IGraphicsInterface
 {
@@ -29,13 +31,22 @@ class TAU_DLL TAU_NOVTABLE IGraphicsInterface
     DEFAULT_CM_PO(IGraphicsInterface);
 protected:
     RenderingMode _mode;
+private:
+    CPPRef<StateCache> _stateCache;
 protected:
     IGraphicsInterface(const RenderingMode& mode) noexcept
         : _mode(mode)
+        , _stateCache(null)
     { }
 public:
     [[nodiscard]] const RenderingMode& renderingMode() const noexcept { return _mode; }
 
+    /**
+     *   The state cache shared by everything built with this
+     * interface, it is created the first time it is used.
+     */
+    [[nodiscard]] StateCache& stateCache() noexcept;
+
     [[nodiscard]] virtual IGraphicsCapabilities& capabilities() noexcept = 0;
 
     [[nodiscard]] virtual IShaderBuilder& createShader() noexcept = 0;
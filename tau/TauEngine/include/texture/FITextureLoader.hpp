@@ -6,6 +6,8 @@
 #include <DLL.hpp>
 #include <Objects.hpp>
 #include <Safeties.hpp>
+#include <IFile.hpp>
+#include <vector>
 #pragma warning(pop)
 
 #include "graphics/Resource.hpp"
@@ -14,6 +16,17 @@
 class IRenderingContext;
 class IGraphicsInterface;
 
+/**
+ *   A texture decoded into tightly packed RGBA8. The rows are
+ * stored bottom up, the same as they are within FreeImage.
+ */
+struct DecodedTexture final
+{
+    u32 width;
+    u32 height;
+    ::std::vector<u8> pixels;
+};
+
 class TAU_DLL TextureLoader final
 {
     DELETE_CONSTRUCT(TextureLoader);
@@ -62,4 +75,42 @@ public:
     static NullableRef<IResource> loadTexture(IGraphicsInterface& gi, IRenderingContext& context, const char* RESTRICT fileName, TextureLoadError* RESTRICT error = null) noexcept;
 
     static NullableRef<IResource> loadTextureCube(IGraphicsInterface& gi, IRenderingContext& context, const char* RESTRICT folderPath, const char* RESTRICT fileExtension, TextureLoadError* RESTRICT error = null) noexcept;
+
+    /**
+     *   Loads a batch of textures, decoding them concurrently on
+     * worker threads. Each texture is created on the calling
+     * thread as soon as its decode finishes, so uploading the
+     * first textures overlaps decoding the rest.
+     *
+     *   Textures that fail to load are set to the missing
+     * texture.
+     *
+     * @param[out] textures
+     *      An array of `count` textures.
+     * @param[out] errors
+     *      An optional array of `count` errors.
+     * @param[in] workerCount
+     *      The maximum number of concurrent decodes, 0 uses one
+     *    per hardware thread.
+     */
+    static void loadTextures(IGraphicsInterface& gi, IRenderingContext& context, const char* const* fileNames, uSys count, NullableRef<IResource>* textures, TextureLoadError* errors = null, u32 workerCount = 0) noexcept;
+
+    /**
+     *   Decodes an encoded image held in memory. This does not
+     * touch the graphics interface and is safe to call from any
+     * thread.
+     *
+     * @param[in] nameHint
+     *      Used to guess the format if it can't be determined
+     *    from the data, may be null.
+     */
+    static TextureLoadError decodeTexture(const u8* data, uSys size, const wchar_t* nameHint, DecodedTexture* texture) noexcept;
+
+    /**
+     *   Decodes an entire file. Files on disk are memory mapped
+     * and decoded in place.
+     */
+    static TextureLoadError decodeTexture(const CPPRef<IFile>& file, DecodedTexture* texture) noexcept;
+
+    static NullableRef<IResource> createTexture(IGraphicsInterface& gi, const DecodedTexture& texture) noexcept;
 };
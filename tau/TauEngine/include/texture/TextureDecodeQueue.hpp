@@ -0,0 +1,97 @@
+/**
+ * @file
+ *
+ * Describes a queue of textures decoded on worker threads.
+ */
+#pragma once
+
+#pragma warning(push, 0)
+#include <vector>
+#include <deque>
+#include <list>
+#include <future>
+#pragma warning(pop)
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+#include <IFile.hpp>
+
+#include "texture/FITextureLoader.hpp"
+#include "DLL.hpp"
+
+/**
+ *   Decodes textures on worker threads. Requests are decoded in
+ * the order they were pushed, with at most one request per
+ * worker in flight at a time.
+ *
+ *   The queue only decodes, creating the textures is left to
+ * the thread that polls the results, as the graphics interface
+ * is not safe to use from the workers.
+ */
+class TAU_DLL TextureDecodeQueue final
+{
+    DELETE_CM(TextureDecodeQueue);
+public:
+    struct Result final
+    {
+        u32 id;
+        TextureLoader::TextureLoadError error;
+        DecodedTexture texture;
+    };
+private:
+    struct Request final
+    {
+        u32 id;
+        CPPRef<IFile> file;
+        const u8* data;
+        uSys size;
+    };
+private:
+    u32 _workerCount;
+    ::std::deque<Request> _requests;
+    ::std::list<::std::future<Result>> _jobs;
+public:
+    /**
+     * @param[in] workerCount
+     *      0 uses one worker per hardware thread.
+     */
+    TextureDecodeQueue(u32 workerCount = 0) noexcept;
+
+    /**
+     * Waits for the decodes in flight, queued requests are discarded.
+     */
+    ~TextureDecodeQueue() noexcept;
+
+    [[nodiscard]] u32 workerCount() const noexcept { return _workerCount; }
+
+    /**
+     * Whether or not there are requests queued or being decoded.
+     */
+    [[nodiscard]] bool busy() const noexcept { return !_requests.empty() || !_jobs.empty(); }
+
+    /**
+     * Queues an entire file to be decoded.
+     */
+    void push(u32 id, const CPPRef<IFile>& file) noexcept;
+
+    /**
+     *   Queues an encoded image held in memory. The memory must
+     * stay valid until its result has been polled.
+     */
+    void push(u32 id, const u8* data, uSys size) noexcept;
+
+    /**
+     *   Dispatches queued requests to idle workers and appends
+     * every finished decode to `results`.
+     *
+     * @param[in] wait
+     *      Block until at least one decode has finished, unless
+     *    the queue is not busy.
+     */
+    void poll(::std::vector<Result>& results, bool wait) noexcept;
+private:
+    void dispatch() noexcept;
+
+    static Result decode(Request request) noexcept;
+};
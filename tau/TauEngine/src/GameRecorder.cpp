@@ -1,127 +1,565 @@
 #include "GameRecorder.hpp"
+#include <LZ.hpp>
+#include <VarInt.hpp>
 
-void GameRecorder::startRecording()
+#pragma warning(push, 0)
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#pragma warning(pop)
+
+static inline u64 streamKey(const u32 streamID, const GameRecorder::BlipType type) noexcept
+{ return (static_cast<u64>(streamID) << 8) | static_cast<u64>(type); }
+
+static inline void appendVarInt(::std::vector<u8>& buffer, const u64 value) noexcept
 {
-    for(const auto& pair : _handlers)
+    u8 tmp[VarInt::MaxBytes];
+    const uSys size = VarInt::encode(value, tmp);
+    buffer.insert(buffer.end(), tmp, tmp + size);
+}
+
+/**
+ *   Encodes `data` as the XOR against `base` (zero padded) as
+ * alternating runs of unchanged and changed bytes.
+ */
+static void encodeDelta(const ::std::vector<u8>& base, const u8* const data, const uSys size, ::std::vector<u8>& out) noexcept
+{
+    out.clear();
+    appendVarInt(out, size);
+
+    const auto deltaAt = [&](const uSys i) -> u8
+    { return static_cast<u8>(data[i] ^ (i < base.size() ? base[i] : 0)); };
+
+    uSys i = 0;
+    while(i < size)
     {
-        addBlip(pair.second.initialBlip(pair.second.userParam));
+        const uSys zeroStart = i;
+        while(i < size && deltaAt(i) == 0)
+        { ++i; }
+        const uSys zeroRun = i - zeroStart;
+
+        if(i == size)
+        { break; }
+
+        /**
+         *   A single unchanged byte is cheaper to keep in the
+         * literal run than to start a new pair of runs.
+         */
+        const uSys literalStart = i;
+        while(i < size && (deltaAt(i) != 0 || (i + 1 < size && deltaAt(i + 1) != 0)))
+        { ++i; }
+        const uSys literalRun = i - literalStart;
+
+        appendVarInt(out, zeroRun);
+        appendVarInt(out, literalRun);
+        for(uSys j = literalStart; j < i; ++j)
+        { out.push_back(deltaAt(j)); }
     }
+}
+
+static bool decodeDelta(::std::vector<u8>& base, const u8* ptr, const u8* const end) noexcept
+{
+    u64 size;
+    uSys read = VarInt::decode(ptr, end, &size);
+    if(!read || size > GameRecorder::MaxBlipSize)
+    { return false; }
+    ptr += read;
+
+    base.resize(static_cast<uSys>(size), 0);
+
+    uSys i = 0;
+    while(ptr < end)
+    {
+        u64 zeroRun;
+        u64 literalRun;
+
+        read = VarInt::decode(ptr, end, &zeroRun);
+        if(!read) { return false; }
+        ptr += read;
+
+        read = VarInt::decode(ptr, end, &literalRun);
+        if(!read) { return false; }
+        ptr += read;
+
+        i += static_cast<uSys>(zeroRun);
+        if(i + literalRun > base.size() || literalRun > static_cast<u64>(end - ptr))
+        { return false; }
+
+        for(u64 j = 0; j < literalRun; ++j)
+        { base[i++] ^= *ptr++; }
+    }
+
+    return true;
+}
+
+GameRecorder::~GameRecorder() noexcept
+{
+    stopRecording();
+    drainChunks(true);
+}
+
+u32 GameRecorder::frameCount() const noexcept
+{
+    if(_recording)
+    { return _frame; }
+
+    if(_chunks.empty())
+    { return 0; }
+
+    const ChunkHeader& last = _chunks.back().header;
+    return last.firstFrame + last.frameCount;
+}
+
+void GameRecorder::startRecording() noexcept
+{
+    startRecording(nullptr);
+}
+
+void GameRecorder::startRecording(const CPPRef<IFile>& file) noexcept
+{
+    stopRecording();
+    _playing = false;
+
+    _file = file;
+    _fileOffset = 0;
+    _chunks.clear();
+    _frame = 0;
+    _chunkFirstFrame = 0;
+    _recordBuffer.clear();
+    _recordBases.clear();
+
+    if(_file)
+    {
+        const FileHeader header { Magic, Version, static_cast<u16>(sizeof(FileHeader)), _keyframeInterval, 0 };
+        _file->writeType(header);
+        _fileOffset = sizeof(FileHeader);
+    }
+
     _recording = true;
+    writeKeyframe();
 }
 
-void GameRecorder::stopRecording()
+void GameRecorder::stopRecording() noexcept
 {
+    if(!_recording)
+    { return; }
+
+    flushChunk();
+    drainChunks(true);
     _recording = false;
+
+    if(_file)
+    {
+        const u64 indexOffset = _fileOffset;
+        for(const Chunk& chunk : _chunks)
+        {
+            const ChunkIndexEntry entry { chunk.header, chunk.offset };
+            _file->writeType(entry);
+        }
+
+        const FileTrailer trailer { indexOffset, static_cast<u32>(_chunks.size()), Magic };
+        _file->writeType(trailer);
+    }
 }
 
 void GameRecorder::addBlip(const Blip& blip) noexcept
 {
-    _blips.push_back(blip);
+    if(!_recording)
+    { return; }
+
+    const auto it = _handlers.find(blip.blipRTT);
+    if(it == _handlers.end() || !it->second.serializer.serialize || !it->second.serializer.streamID)
+    { return; }
+
+    const HandlerGroup& hg = it->second;
+
+    u8 buffer[MaxBlipSize];
+    const uSys size = hg.serializer.serialize(blip, buffer, MaxBlipSize, hg.userParam);
+    if(!size || size > MaxBlipSize)
+    { return; }
+
+    writeRecord(hg.serializer.streamID, blip.type, buffer, size);
 }
 
-void GameRecorder::addBlipHandler(RunTimeType<Blip> type, blipHandler_f handler, initialBlip_f initial, void* userParam)
+void GameRecorder::addBlipHandler(const RunTimeType<Blip> type, const blipHandler_f handler, const initialBlip_f initial, void* const userParam) noexcept
 {
-    _handlers[type] = {handler, initial, userParam};
+    addBlipHandler(type, handler, initial, { 0, nullptr }, userParam);
 }
 
-static RunTimeType<GameRecorder::Blip> getRTT() noexcept
+void GameRecorder::addBlipHandler(const RunTimeType<Blip> type, const blipHandler_f handler, const initialBlip_f initial, const BlipSerializer& serializer, void* const userParam) noexcept
 {
-#if TAU_RTTI_DEBUG
-    static RunTimeType<GameRecorder::Blip> _rtt("GameRecorder::Blip");
-#else
-    static RunTimeType<GameRecorder::Blip> _rtt = RunTimeType<GameRecorder::Blip>::define();
-#endif
-    return _rtt;
+    _handlers.insert_or_assign(type, HandlerGroup { handler, initial, serializer, userParam });
+    if(serializer.streamID)
+    { _streams.insert_or_assign(serializer.streamID, type); }
 }
 
 void GameRecorder::addBeginUpdate() noexcept
 {
-    _blips.emplace_back(BlipType::Update, getRTT(), nullptr);
+    if(!_recording)
+    { return; }
+
+    if(_frame - _chunkFirstFrame >= _keyframeInterval)
+    {
+        flushChunk();
+        _chunkFirstFrame = _frame;
+        writeKeyframe();
+    }
+
+    writeRecord(0, BlipType::Update, nullptr, 0);
+    ++_frame;
+
+    drainChunks(false);
 }
 
 void GameRecorder::addBeginRender() noexcept
 {
-    _blips.emplace_back(BlipType::Render, getRTT(), nullptr);
+    if(!_recording)
+    { return; }
+
+    writeRecord(0, BlipType::Render, nullptr, 0);
 }
 
-void GameRecorder::beginPlayBack()
+void GameRecorder::writeRecord(const u32 streamID, const BlipType type, const u8* const data, const uSys size) noexcept
 {
-    _playing = true;
-    for(_playbackIndex = 0; _playbackIndex < _blips.size(); ++_playbackIndex)
+    appendVarInt(_recordBuffer, (static_cast<u64>(streamID) << 2) | static_cast<u64>(type));
+
+    if(!streamID)
+    { return; }
+
+    ::std::vector<u8>& base = _recordBases[streamKey(streamID, type)];
+    encodeDelta(base, data, size, _encodeBuffer);
+    base.assign(data, data + size);
+
+    appendVarInt(_recordBuffer, _encodeBuffer.size());
+    _recordBuffer.insert(_recordBuffer.end(), _encodeBuffer.begin(), _encodeBuffer.end());
+}
+
+void GameRecorder::writeKeyframe() noexcept
+{
+    for(const auto& pair : _handlers)
     {
-        auto& blip = _blips[_playbackIndex];
-        if(blip.type != BlipType::Initial)
-        {
-            break;
-        }
-        if(_handlers.count(blip.blipRTT) != 0)
-        {
-            const auto& hg = _handlers[blip.blipRTT];
-            hg.blipHandler(blip, hg.userParam);
-        }
+        if(pair.second.initialBlip && pair.second.serializer.streamID)
+        { addBlip(pair.second.initialBlip(pair.second.userParam)); }
     }
-    if(_playbackIndex >= _blips.size())
+}
+
+static GameRecorder::ChunkHeader compressChunk(GameRecorder::ChunkHeader header, const ::std::vector<u8>& raw, ::std::vector<u8>& out) noexcept
+{
+    out.resize(LZ::compressBound(raw.size()));
+    const uSys size = LZ::compress(raw.data(), raw.size(), out.data(), out.size());
+
+    if(!size || size >= raw.size())
     {
-        _playing = false;
+        out = raw;
+        header.compressedSize = header.rawSize;
+    }
+    else
+    {
+        out.resize(size);
+        header.compressedSize = static_cast<u32>(size);
     }
+
+    return header;
 }
 
-void GameRecorder::playUpdate() noexcept
+void GameRecorder::flushChunk() noexcept
 {
-    if(_blips[_playbackIndex].type == BlipType::Update && _blips[_playbackIndex].blipRTT != getRTT())
+    if(_frame == _chunkFirstFrame)
     {
+        _recordBuffer.clear();
+        _recordBases.clear();
         return;
     }
 
-    for(++_playbackIndex; _playbackIndex < _blips.size(); ++_playbackIndex)
+    const ChunkHeader header { _chunkFirstFrame, _frame - _chunkFirstFrame, static_cast<u32>(_recordBuffer.size()), 0 };
+
+    _pendingChunks.push_back(::std::async(::std::launch::async, [header](const ::std::vector<u8> raw) -> Chunk
     {
-        auto& blip = _blips[_playbackIndex];
-        if(blip.type != BlipType::Update)
+        Chunk chunk;
+        chunk.offset = 0;
+        chunk.header = compressChunk(header, raw, chunk.data);
+        return chunk;
+    }, ::std::move(_recordBuffer)));
+
+    _recordBuffer = { };
+    _recordBases.clear();
+}
+
+void GameRecorder::drainChunks(const bool wait) noexcept
+{
+    while(!_pendingChunks.empty())
+    {
+        ::std::future<Chunk>& future = _pendingChunks.front();
+        if(!wait && future.wait_for(::std::chrono::seconds(0)) != ::std::future_status::ready)
+        { break; }
+
+        Chunk chunk = future.get();
+        _pendingChunks.pop_front();
+
+        if(_file)
         {
-            break;
+            chunk.offset = _fileOffset;
+            _file->writeType(chunk.header);
+            _file->writeBytes(chunk.data.data(), chunk.data.size());
+            _fileOffset += sizeof(ChunkHeader) + chunk.data.size();
+            chunk.data = { };
         }
-        if(_blips[_playbackIndex].blipRTT == getRTT())
+
+        _chunks.push_back(::std::move(chunk));
+    }
+}
+
+bool GameRecorder::openReplay(const CPPRef<IFile>& file) noexcept
+{
+    if(!file || _recording)
+    { return false; }
+
+    _playing = false;
+    _chunks.clear();
+    _file = nullptr;
+
+    const i64 size = file->size();
+    if(size < static_cast<i64>(sizeof(FileHeader) + sizeof(FileTrailer)))
+    { return false; }
+
+    FileHeader header;
+    file->setPos(0);
+    if(file->readType(&header) != sizeof(header) || header.magic != Magic || header.version != Version)
+    { return false; }
+
+    FileTrailer trailer;
+    file->setPos(static_cast<uSys>(size) - sizeof(FileTrailer));
+    if(file->readType(&trailer) != sizeof(trailer) || trailer.magic != Magic)
+    { return false; }
+
+    if(trailer.indexOffset + static_cast<u64>(trailer.chunkCount) * sizeof(ChunkIndexEntry) > static_cast<u64>(size) - sizeof(FileTrailer))
+    { return false; }
+
+    file->setPos(static_cast<uSys>(trailer.indexOffset));
+    _chunks.reserve(trailer.chunkCount);
+    for(u32 i = 0; i < trailer.chunkCount; ++i)
+    {
+        ChunkIndexEntry entry;
+        if(file->readType(&entry) != sizeof(entry))
         {
-            break;
+            _chunks.clear();
+            return false;
         }
-        if(_handlers.count(blip.blipRTT) != 0)
+
+        Chunk chunk;
+        chunk.header = entry.header;
+        chunk.offset = entry.offset;
+        _chunks.push_back(::std::move(chunk));
+    }
+
+    _file = file;
+    _keyframeInterval = header.keyframeInterval;
+    return true;
+}
+
+bool GameRecorder::loadChunk(const uSys chunkIndex) noexcept
+{
+    if(chunkIndex >= _chunks.size())
+    { return false; }
+
+    const Chunk& chunk = _chunks[chunkIndex];
+
+    ::std::vector<u8> fileData;
+    const u8* compressed = chunk.data.data();
+    if(chunk.data.empty())
+    {
+        if(!_file)
+        { return false; }
+
+        fileData.resize(chunk.header.compressedSize);
+        _file->setPos(static_cast<uSys>(chunk.offset + sizeof(ChunkHeader)));
+        if(_file->readBytes(fileData.data(), fileData.size()) != static_cast<i64>(fileData.size()))
+        { return false; }
+        compressed = fileData.data();
+    }
+
+    _playbackBuffer.resize(chunk.header.rawSize);
+    if(chunk.header.compressedSize == chunk.header.rawSize)
+    {
+        ::std::memcpy(_playbackBuffer.data(), compressed, chunk.header.rawSize);
+    }
+    else if(LZ::decompress(compressed, chunk.header.compressedSize, _playbackBuffer.data(), _playbackBuffer.size()) != chunk.header.rawSize)
+    {
+        return false;
+    }
+
+    _playbackBases.clear();
+    _playbackChunk = chunkIndex;
+    _playbackIndex = 0;
+    _playbackFrame = chunk.header.firstFrame;
+    return true;
+}
+
+bool GameRecorder::peekRecord(u32* const streamID, BlipType* const type) const noexcept
+{
+    if(_playbackIndex >= _playbackBuffer.size())
+    { return false; }
+
+    u64 header;
+    const u8* const begin = _playbackBuffer.data();
+    if(!VarInt::decode(begin + _playbackIndex, begin + _playbackBuffer.size(), &header))
+    { return false; }
+
+    *streamID = static_cast<u32>(header >> 2);
+    *type = static_cast<BlipType>(header & 3);
+    return true;
+}
+
+bool GameRecorder::playRecord() noexcept
+{
+    const u8* const begin = _playbackBuffer.data();
+    const u8* const end = begin + _playbackBuffer.size();
+
+    u64 header;
+    uSys read = VarInt::decode(begin + _playbackIndex, end, &header);
+    if(!read)
+    { return false; }
+    _playbackIndex += read;
+
+    const u32 streamID = static_cast<u32>(header >> 2);
+    const BlipType type = static_cast<BlipType>(header & 3);
+
+    if(!streamID)
+    { return true; }
+
+    u64 length;
+    read = VarInt::decode(begin + _playbackIndex, end, &length);
+    if(!read || length > static_cast<u64>(end - (begin + _playbackIndex + read)))
+    { return false; }
+    _playbackIndex += read;
+
+    const u8* const payload = begin + _playbackIndex;
+    _playbackIndex += static_cast<uSys>(length);
+
+    const auto stream = _streams.find(streamID);
+    if(stream == _streams.end())
+    { return true; }
+
+    ::std::vector<u8>& base = _playbackBases[streamKey(streamID, type)];
+    if(!decodeDelta(base, payload, payload + length))
+    { return false; }
+
+    const auto handler = _handlers.find(stream->second);
+    if(handler != _handlers.end() && handler->second.blipHandler)
+    {
+        Blip blip(type, stream->second, base.data());
+        handler->second.blipHandler(blip, handler->second.userParam);
+    }
+
+    return true;
+}
+
+void GameRecorder::playUntilMarker() noexcept
+{
+    u32 streamID;
+    BlipType type;
+    while(peekRecord(&streamID, &type) && streamID != 0)
+    {
+        if(!playRecord())
         {
-            const auto& hg = _handlers[blip.blipRTT];
-            hg.blipHandler(blip, hg.userParam);
+            _playing = false;
+            return;
         }
     }
-    if(_playbackIndex >= _blips.size())
+}
+
+void GameRecorder::beginPlayBack() noexcept
+{
+    seek(0);
+}
+
+bool GameRecorder::seek(const u32 frame) noexcept
+{
+    if(_recording || frame >= frameCount())
     {
         _playing = false;
+        return false;
     }
-}
 
-void GameRecorder::playRender() noexcept
-{
-    if(_blips[_playbackIndex].type == BlipType::Render && _blips[_playbackIndex].blipRTT != getRTT())
+    const auto it = ::std::upper_bound(_chunks.begin(), _chunks.end(), frame, [](const u32 f, const Chunk& chunk)
+    { return f < chunk.header.firstFrame; });
+
+    if(it == _chunks.begin() || !loadChunk(static_cast<uSys>((it - _chunks.begin()) - 1)))
     {
-        return;
+        _playing = false;
+        return false;
     }
 
-    for(++_playbackIndex; _playbackIndex < _blips.size(); ++_playbackIndex)
+    u32 streamID;
+    BlipType type;
+    while(peekRecord(&streamID, &type))
     {
-        auto& blip = _blips[_playbackIndex];
-        if(blip.type != BlipType::Render)
+        if(streamID == 0 && type == BlipType::Update)
+        {
+            if(_playbackFrame == frame)
+            { break; }
+            ++_playbackFrame;
+        }
+
+        if(!playRecord())
         {
-            break;
+            _playing = false;
+            return false;
         }
-        if(_blips[_playbackIndex].blipRTT == getRTT())
+    }
+
+    _playing = true;
+    return true;
+}
+
+void GameRecorder::playUpdate() noexcept
+{
+    if(!_playing)
+    { return; }
+
+    u32 streamID;
+    BlipType type;
+
+    if(_playbackIndex >= _playbackBuffer.size())
+    {
+        if(!loadChunk(_playbackChunk + 1))
         {
-            break;
+            _playing = false;
+            return;
         }
-        if(_handlers.count(blip.blipRTT) != 0)
+        playUntilMarker();
+    }
+
+    while(peekRecord(&streamID, &type) && !(streamID == 0 && type == BlipType::Update))
+    {
+        if(!playRecord())
         {
-            const auto& hg = _handlers[blip.blipRTT];
-            hg.blipHandler(blip, hg.userParam);
+            _playing = false;
+            return;
         }
     }
-    if(_playbackIndex >= _blips.size())
+
+    if(!peekRecord(&streamID, &type))
     {
         _playing = false;
+        return;
     }
+
+    (void) playRecord();
+    ++_playbackFrame;
+    playUntilMarker();
+}
+
+void GameRecorder::playRender() noexcept
+{
+    if(!_playing)
+    { return; }
+
+    u32 streamID;
+    BlipType type;
+    if(!peekRecord(&streamID, &type) || streamID != 0 || type != BlipType::Render)
+    { return; }
+
+    (void) playRecord();
+    playUntilMarker();
 }
@@ -0,0 +1,521 @@
+#include "GlyphCache.hpp"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#include <cstring>
+#pragma warning(pop)
+
+#include "graphics/Resource.hpp"
+#include "graphics/CommandList.hpp"
+#include "system/GraphicsInterface.hpp"
+
+/**
+ *   Decodes the next code point of a UTF-16 string, unpaired
+ * surrogates are passed through unchanged.
+ */
+static inline u32 nextCodepoint(const wchar_t* const str, const uSys length, uSys& i) noexcept
+{
+    const u32 c = static_cast<u16>(str[i++]);
+    if(c >= 0xD800 && c <= 0xDBFF && i < length)
+    {
+        const u32 low = static_cast<u16>(str[i]);
+        if(low >= 0xDC00 && low <= 0xDFFF)
+        {
+            ++i;
+            return 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+        }
+    }
+    return c;
+}
+
+GlyphCache::GlyphCache(const FT_Library ft, const RefDynArray<u8>& fontData, const FT_UInt pixelHeight, const GlyphCacheArgs& args) noexcept
+    : _ft(ft)
+    , _fontData(fontData)
+    , _pixelHeight(pixelHeight)
+    , _args(args)
+    , _frame(1)
+    , _stats{ 0, 0, 0, 0 }
+{
+    if(_args.workerCount == 0)
+    { _args.workerCount = 1; }
+    if(_args.maxPages == 0)
+    { _args.maxPages = 1; }
+    if(_args.maxPages > 0xFFFF)
+    { _args.maxPages = 0xFFFF; }
+    if(_args.pageSize > 0xFF00)
+    { _args.pageSize = 0xFF00; }
+    _args.pageSize = (_args.pageSize + 255) & ~255u;
+}
+
+GlyphCache::~GlyphCache() noexcept
+{
+    for(Job& job : _jobs)
+    { job.future.wait(); }
+
+    for(const FT_Face face : _faces)
+    { FT_Done_Face(face); }
+}
+
+FT_Error GlyphCache::init() noexcept
+{
+    for(u32 i = 0; i < _args.workerCount; ++i)
+    {
+        FT_Face face;
+        const FT_Error error = FT_New_Memory_Face(_ft, _fontData.arr(), static_cast<FT_Long>(_fontData.size() - 1), 0, &face);
+        if(error)
+        { return error; }
+
+        FT_Set_Pixel_Sizes(face, 0, _pixelHeight);
+
+        _faces.push_back(face);
+        _faceBusy.push_back(false);
+    }
+
+    return 0;
+}
+
+const CachedGlyph* GlyphCache::find(const u32 codepoint) noexcept
+{
+    const auto it = _glyphs.find(codepoint);
+    if(it != _glyphs.end())
+    {
+        if(it->second.state == CachedGlyph::State::Resident)
+        { _pages[it->second.page].lastUsed = _frame; }
+        return &it->second;
+    }
+
+    CachedGlyph glyph;
+    ::std::memset(&glyph, 0, sizeof(glyph));
+    glyph.state = CachedGlyph::State::Pending;
+
+    _queue.push_back(codepoint);
+    return &_glyphs.emplace(codepoint, glyph).first->second;
+}
+
+void GlyphCache::prefetch(const wchar_t* const str, const uSys length) noexcept
+{
+    for(uSys i = 0; i < length;)
+    { (void) find(nextCodepoint(str, length, i)); }
+}
+
+void GlyphCache::buildQuads(const wchar_t* const str, const uSys length, float x, const float y, const float scale, GlyphBatch& batch) noexcept
+{
+    batch.clear();
+
+    const float invPageSize = 1.0f / static_cast<float>(_args.pageSize);
+
+    for(uSys i = 0; i < length;)
+    {
+        const CachedGlyph* const glyph = find(nextCodepoint(str, length, i));
+
+        if(glyph->state == CachedGlyph::State::Pending)
+        {
+            ++batch.pendingGlyphs;
+            continue;
+        }
+
+        if(glyph->state == CachedGlyph::State::Resident)
+        {
+            GlyphBatch::Quad quad;
+            quad.page = glyph->page;
+            quad.x0 = x + glyph->bearingX * scale;
+            quad.y0 = y - (glyph->height - glyph->bearingY) * scale;
+            quad.x1 = quad.x0 + glyph->width * scale;
+            quad.y1 = quad.y0 + glyph->height * scale;
+            quad.u0 = glyph->x * invPageSize;
+            quad.v0 = glyph->y * invPageSize;
+            quad.u1 = (glyph->x + glyph->width) * invPageSize;
+            quad.v1 = (glyph->y + glyph->height) * invPageSize;
+            batch.quads.push_back(quad);
+        }
+
+        x += (glyph->advance >> 6) * scale;
+    }
+
+    batch.endX = x;
+
+    /**
+     *   Counting sort the quads by page, this keeps the string
+     * order within a page and is linear in the glyph count.
+     */
+    batch.pageCounts.assign(_pages.size(), 0);
+    for(const GlyphBatch::Quad& quad : batch.quads)
+    { ++batch.pageCounts[quad.page]; }
+
+    u32 vertex = 0;
+    for(uSys page = 0; page < batch.pageCounts.size(); ++page)
+    {
+        const u32 count = batch.pageCounts[page];
+        if(!count)
+        { continue; }
+
+        batch.ranges.push_back({ static_cast<u32>(page), vertex, count * 6 });
+        batch.pageCounts[page] = vertex;
+        vertex += count * 6;
+    }
+
+    batch.positions.resize(vertex * 2);
+    batch.texCoords.resize(vertex * 2);
+
+    for(const GlyphBatch::Quad& quad : batch.quads)
+    {
+        const u32 base = batch.pageCounts[quad.page];
+        batch.pageCounts[quad.page] += 6;
+
+        const float positions[12] = {
+            quad.x0, quad.y1,
+            quad.x0, quad.y0,
+            quad.x1, quad.y0,
+
+            quad.x0, quad.y1,
+            quad.x1, quad.y0,
+            quad.x1, quad.y1
+        };
+
+        const float texCoords[12] = {
+            quad.u0, quad.v0,
+            quad.u0, quad.v1,
+            quad.u1, quad.v1,
+
+            quad.u0, quad.v0,
+            quad.u1, quad.v1,
+            quad.u1, quad.v0
+        };
+
+        ::std::memcpy(batch.positions.data() + base * 2, positions, sizeof(positions));
+        ::std::memcpy(batch.texCoords.data() + base * 2, texCoords, sizeof(texCoords));
+    }
+}
+
+void GlyphCache::update(const bool wait) noexcept
+{
+    do
+    {
+        dispatch();
+        collect(wait);
+    } while(wait && busy());
+
+    ++_frame;
+}
+
+void GlyphCache::dispatch() noexcept
+{
+    if(_queue.empty())
+    { return; }
+
+    uSys idle = 0;
+    for(const bool busy : _faceBusy)
+    {
+        if(!busy)
+        { ++idle; }
+    }
+
+    if(!idle)
+    { return; }
+
+    const uSys perJob = (_queue.size() + idle - 1) / idle;
+    uSys begin = 0;
+
+    for(uSys face = 0; face < _faces.size() && begin < _queue.size(); ++face)
+    {
+        if(_faceBusy[face])
+        { continue; }
+
+        const uSys end = ::std::min(begin + perJob, _queue.size());
+        ::std::vector<u32> codepoints(_queue.begin() + begin, _queue.begin() + end);
+        begin = end;
+
+        _faceBusy[face] = true;
+        _jobs.push_back({ face, ::std::async(::std::launch::async, rasterize, _faces[face], ::std::move(codepoints)) });
+    }
+
+    _queue.clear();
+}
+
+void GlyphCache::collect(const bool wait) noexcept
+{
+    for(auto it = _jobs.begin(); it != _jobs.end();)
+    {
+        if(!wait && it->future.wait_for(::std::chrono::seconds(0)) != ::std::future_status::ready)
+        {
+            ++it;
+            continue;
+        }
+
+        ::std::vector<Rasterized> results = it->future.get();
+        _faceBusy[it->face] = false;
+        it = _jobs.erase(it);
+
+        for(Rasterized& rasterized : results)
+        { integrate(rasterized); }
+    }
+}
+
+void GlyphCache::integrate(Rasterized& rasterized) noexcept
+{
+    const auto it = _glyphs.find(rasterized.codepoint);
+    if(it == _glyphs.end())
+    { return; }
+
+    ++_stats.rasterized;
+
+    CachedGlyph& glyph = it->second;
+
+    if(rasterized.glyph.state != CachedGlyph::State::Resident)
+    {
+        glyph = rasterized.glyph;
+        return;
+    }
+
+    if(rasterized.glyph.width + _args.padding > _args.pageSize ||
+       rasterized.glyph.height + _args.padding > _args.pageSize)
+    {
+        glyph = rasterized.glyph;
+        glyph.state = CachedGlyph::State::Oversized;
+        return;
+    }
+
+    u16 page, x, y;
+    if(!place(rasterized.glyph.width, rasterized.glyph.height, &page, &x, &y))
+    {
+        /**
+         *   Every page is in use this frame. Forget the glyph so
+         * that it is requested again next frame.
+         */
+        _glyphs.erase(it);
+        return;
+    }
+
+    glyph = rasterized.glyph;
+    glyph.page = page;
+    glyph.x = x;
+    glyph.y = y;
+
+    Page& target = _pages[page];
+    for(u32 row = 0; row < glyph.height; ++row)
+    {
+        ::std::memcpy(target.pixels.data() + static_cast<uSys>(y + row) * _args.pageSize + x,
+                      rasterized.pixels.data() + static_cast<uSys>(row) * glyph.width,
+                      glyph.width);
+    }
+
+    target.glyphs.push_back(rasterized.codepoint);
+    target.lastUsed = _frame;
+    target.markDirty(y, y + glyph.height);
+}
+
+bool GlyphCache::place(const u32 width, const u32 height, u16* const page, u16* const x, u16* const y) noexcept
+{
+    const u32 paddedWidth = width + _args.padding;
+    const u32 paddedHeight = height + _args.padding;
+
+    for(uSys i = 0; i < _pages.size(); ++i)
+    {
+        if(placeInPage(_pages[i], _args.pageSize, paddedWidth, paddedHeight, x, y))
+        {
+            *page = static_cast<u16>(i);
+            return true;
+        }
+    }
+
+    if(_pages.size() < _args.maxPages)
+    {
+        Page newPage;
+        newPage.pixels.assign(static_cast<uSys>(_args.pageSize) * _args.pageSize, 0);
+        newPage.shelfTop = 0;
+        newPage.dirtyTop = 0;
+        newPage.dirtyBottom = 0;
+        newPage.lastUsed = _frame;
+        _pages.push_back(::std::move(newPage));
+
+        *page = static_cast<u16>(_pages.size() - 1);
+        return placeInPage(_pages.back(), _args.pageSize, paddedWidth, paddedHeight, x, y);
+    }
+
+    uSys lru = _pages.size();
+    for(uSys i = 0; i < _pages.size(); ++i)
+    {
+        if(_pages[i].lastUsed < _frame && (lru == _pages.size() || _pages[i].lastUsed < _pages[lru].lastUsed))
+        { lru = i; }
+    }
+
+    if(lru == _pages.size())
+    { return false; }
+
+    evict(static_cast<u16>(lru));
+
+    *page = static_cast<u16>(lru);
+    return placeInPage(_pages[lru], _args.pageSize, paddedWidth, paddedHeight, x, y);
+}
+
+bool GlyphCache::placeInPage(Page& page, const u32 pageSize, const u32 width, const u32 height, u16* const x, u16* const y) noexcept
+{
+    /**
+     *   Use the shortest shelf the glyph fits in, as long as it
+     * doesn't waste more than a quarter of the shelf height.
+     */
+    Page::Shelf* best = null;
+    for(Page::Shelf& shelf : page.shelves)
+    {
+        if(shelf.height >= height && shelf.height - height <= shelf.height / 4 && shelf.x + width <= pageSize)
+        {
+            if(!best || shelf.height < best->height)
+            { best = &shelf; }
+        }
+    }
+
+    if(!best)
+    {
+        if(page.shelfTop + height > pageSize)
+        { return false; }
+
+        page.shelves.push_back({ page.shelfTop, height, 0 });
+        page.shelfTop += height;
+        best = &page.shelves.back();
+    }
+
+    *x = static_cast<u16>(best->x);
+    *y = static_cast<u16>(best->y);
+    best->x += width;
+    return true;
+}
+
+void GlyphCache::evict(const u16 page) noexcept
+{
+    Page& target = _pages[page];
+
+    for(const u32 codepoint : target.glyphs)
+    { _glyphs.erase(codepoint); }
+
+    target.glyphs.clear();
+    target.shelves.clear();
+    target.shelfTop = 0;
+    target.lastUsed = _frame;
+    target.markDirty(0, _args.pageSize);
+    ::std::fill(target.pixels.begin(), target.pixels.end(), static_cast<u8>(0));
+
+    ++_stats.evictions;
+}
+
+void GlyphCache::upload(IGraphicsInterface& gi, ICommandList& cmdList) noexcept
+{
+    for(Page& page : _pages)
+    {
+        if(!page.dirty())
+        { continue; }
+
+        if(!page.texture)
+        {
+            if(!createTextures(gi, page))
+            { continue; }
+
+            _stats.uploadedBytes += page.pixels.size();
+        }
+        else
+        {
+            /**
+             *   Rows are a multiple of 256 bytes wide, so the dirty
+             * rows are contiguous in both the pixels and the staging
+             * texture.
+             */
+            const uSys begin = static_cast<uSys>(page.dirtyTop) * _args.pageSize;
+            const uSys end = static_cast<uSys>(page.dirtyBottom) * _args.pageSize;
+            const ResourceMapRange writeRange(begin, end);
+
+            u8* const mapping = reinterpret_cast<u8*>(page.staging->map(0, 0, ResourceMapRange::none(), &writeRange));
+            if(!mapping)
+            { continue; }
+
+            ::std::memcpy(mapping + begin, page.pixels.data() + begin, end - begin);
+            page.staging->unmap(0, 0, &writeRange);
+
+            const ETexture::Coord coord { 0, page.dirtyTop, 0 };
+            const ETexture::EBox box { 0, _args.pageSize, page.dirtyTop, page.dirtyBottom, 0, 1 };
+            cmdList.copyTexture(page.texture, 0, coord, page.staging, 0, &box);
+
+            _stats.uploadedBytes += end - begin;
+        }
+
+        page.dirtyTop = 0;
+        page.dirtyBottom = 0;
+        ++_stats.uploads;
+    }
+}
+
+bool GlyphCache::createTextures(IGraphicsInterface& gi, Page& page) const noexcept
+{
+    const u8* const raw = page.pixels.data();
+
+    ResourceTexture2DArgs args;
+    args.width = _args.pageSize;
+    args.height = _args.pageSize;
+    args.arrayCount = 1;
+    args.mipLevels = 1;
+    args.dataFormat = ETexture::Format::Red8UnsignedInt;
+    args.flags = ETexture::BindFlags::ShaderAccess;
+    args.usageType = EResource::UsageType::Default;
+    args.initialBuffers = reinterpret_cast<const void* const*>(&raw);
+
+    IResourceBuilder::Error error;
+    const NullableRef<IResource> texture = gi.createResource().buildTauRef(args, nullptr, &error);
+    if(error != IResourceBuilder::Error::NoError)
+    { return false; }
+
+    args.flags = ETexture::BindFlags::None;
+    args.usageType = EResource::UsageType::Upload;
+
+    const NullableRef<IResource> staging = gi.createResource().buildTauRef(args, nullptr, &error);
+    if(error != IResourceBuilder::Error::NoError)
+    { return false; }
+
+    page.texture = texture;
+    page.staging = staging;
+    return true;
+}
+
+::std::vector<GlyphCache::Rasterized> GlyphCache::rasterize(const FT_Face face, const ::std::vector<u32> codepoints) noexcept
+{
+    ::std::vector<Rasterized> results(codepoints.size());
+
+    for(uSys i = 0; i < codepoints.size(); ++i)
+    {
+        Rasterized& result = results[i];
+        result.codepoint = codepoints[i];
+        ::std::memset(&result.glyph, 0, sizeof(result.glyph));
+
+        const FT_UInt index = FT_Get_Char_Index(face, codepoints[i]);
+        if(!index || FT_Load_Glyph(face, index, FT_LOAD_RENDER))
+        {
+            result.glyph.state = CachedGlyph::State::Missing;
+            continue;
+        }
+
+        const FT_GlyphSlot slot = face->glyph;
+        result.glyph.advance = static_cast<u32>(slot->advance.x);
+        result.glyph.bearingX = static_cast<i16>(slot->bitmap_left);
+        result.glyph.bearingY = static_cast<i16>(slot->bitmap_top);
+
+        if(!slot->bitmap.buffer || !slot->bitmap.width || !slot->bitmap.rows)
+        {
+            result.glyph.state = CachedGlyph::State::Blank;
+            continue;
+        }
+
+        result.glyph.state = CachedGlyph::State::Resident;
+        result.glyph.width = static_cast<u16>(slot->bitmap.width);
+        result.glyph.height = static_cast<u16>(slot->bitmap.rows);
+
+        /**
+         * The pitch may include row padding, so copy row by row.
+         */
+        result.pixels.resize(static_cast<uSys>(slot->bitmap.width) * slot->bitmap.rows);
+        for(u32 row = 0; row < slot->bitmap.rows; ++row)
+        {
+            ::std::memcpy(result.pixels.data() + static_cast<uSys>(row) * slot->bitmap.width,
+                          slot->bitmap.buffer + static_cast<iSys>(row) * slot->bitmap.pitch,
+                          slot->bitmap.width);
+        }
+    }
+
+    return results;
+}
@@ -1,68 +1,92 @@
 #include <I18n.hpp>
 
-#pragma pack(push, 1)
-struct LangHeader
-{
-    u32 magic;
-    u32 translationCount;
-    u32 languageNameLength;
-};
-#pragma pack(pop)
+#pragma warning(push, 0)
+#include <cstring>
+#pragma warning(pop)
 
-#pragma pack(push, 1)
-struct TranslationHeader
-{
-    u32 keyLength;
-    u32 valueLength;
-};
-#pragma pack(pop)
+static_assert(sizeof(wchar_t) == sizeof(u16), "The translation table stores UTF-16 values.");
 
 bool I18n::loadTranslations(const CPPRef<IFile>& file) noexcept
 {
-    LangHeader header;
-    file->readType(&header);
+    if(!file)
+    { return false; }
+
+    u32 magic;
+    if(file->readType(&magic) != sizeof(magic))
+    { return false; }
+    file->advancePos(-static_cast<iSys>(sizeof(magic)));
+
+    if(magic == i18n::bin::Magic)
+    { return swapTable(MappedFile::map(file)); }
+
+    I18nTableBuilder builder;
+    if(!builder.loadLegacy(file))
+    { return false; }
+
+    ::std::vector<u8> image;
+    if(!builder.build(image))
+    { return false; }
 
-    if(header.magic == 0x4C614E67)
-    {
-        _translations.clear();
+    RefDynArray<u8> buffer(image.size());
+    ::std::memcpy(buffer.arr(), image.data(), image.size());
 
-        wchar_t* languageName = new wchar_t[header.languageNameLength + 1];
-        languageName[header.languageNameLength] = '\0';
-        if(file->readString(languageName, header.languageNameLength) != header.languageNameLength * sizeof(wchar_t))
-        { return false; }
+    return swapTable(CPPRef<MappedFile>(new(::std::nothrow) MappedFile(buffer, image.size())));
+}
+
+bool I18n::loadTranslations(const wchar_t* const path) noexcept
+{ return swapTable(MappedFile::map(path)); }
+
+bool I18n::swapTable(const CPPRef<MappedFile>& table) noexcept
+{
+    if(!table || table->size() < sizeof(i18n::bin::Header))
+    { return false; }
 
-        _language = WDynString::passControl(languageName);
+    const uSys size = table->size();
+    const i18n::bin::Header* const header = table->at<i18n::bin::Header>(0);
 
-        for(u32 i = 0; i < header.translationCount; ++i)
-        {
-            TranslationHeader tHeader;
-            if(file->readType(&tHeader) != sizeof(tHeader))
-            { return false; }
+    if(header->magic != i18n::bin::Magic ||
+       header->version != i18n::bin::Version ||
+       header->headerSize != sizeof(i18n::bin::Header) ||
+       header->fileSize > size)
+    { return false; }
 
-            char* key = new char[tHeader.keyLength + 1];
-            key[tHeader.keyLength] = '\0';
-            if(file->readString(key, tHeader.keyLength) != tHeader.keyLength * sizeof(char))
-            { return false; }
+    const u64 entryCount = header->entryCount;
 
-            wchar_t* value = new wchar_t[tHeader.valueLength + 1];
-            value[tHeader.valueLength] = '\0';
-            if(file->readString(value, tHeader.valueLength) != tHeader.valueLength * sizeof(wchar_t))
-            { return false; }
+    if((header->seedOffset & 3) || header->seedOffset + entryCount * sizeof(i32) > size ||
+       (header->entryOffset & 3) || header->entryOffset + entryCount * sizeof(i18n::bin::Entry) > size ||
+       static_cast<u64>(header->keyTableOffset) + header->keyTableSize > size ||
+       (header->valueTableOffset & 1) || header->valueTableOffset + static_cast<u64>(header->valueTableSize) * sizeof(u16) > size ||
+       static_cast<u64>(header->language.offset) + header->language.length >= header->valueTableSize)
+    { return false; }
 
-            _translations.emplace(DynString::passControl(key), WDynString::passControl(value));
-        }
-    }
+    _table = table;
+    _header = header;
+    _seeds = table->at<i32>(header->seedOffset);
+    _entries = table->at<i18n::bin::Entry>(header->entryOffset);
+    _keys = table->at<char>(header->keyTableOffset);
+    _values = table->at<wchar_t>(header->valueTableOffset);
 
     return true;
 }
 
-const WDynString& I18n::translate(const DynString& key, Error* const error) const noexcept
+const wchar_t* I18n::translate(const char* const key, const uSys length, Error* const error) const noexcept
 {
-    if(this->_translations.find(key) != this->_translations.end())
-    {
-        const WDynString& translation = _translations.at(key);
-        ERROR_CODE_V(Error::NoError, translation);
-    }
+    ERROR_CODE_COND_V(!_header || !_header->entryCount, Error::UnknownTranslationKey, L"");
+
+    const u32 entryCount = _header->entryCount;
+    const u64 hash = i18n::bin::hashKey(key, length);
+    const i32 seed = _seeds[i18n::bin::bucket(hash, entryCount)];
+    const u32 slot = seed < 0 ? static_cast<u32>(-(seed + 1)) : i18n::bin::slot(hash, seed, entryCount);
+
+    ERROR_CODE_COND_V(slot >= entryCount, Error::UnknownTranslationKey, L"");
+
+    const i18n::bin::Entry& entry = _entries[slot];
+
+    ERROR_CODE_COND_V(entry.hash != static_cast<u32>(hash) || entry.key.length != length, Error::UnknownTranslationKey, L"");
+    ERROR_CODE_COND_V(static_cast<u64>(entry.key.offset) + length > _header->keyTableSize, Error::UnknownTranslationKey, L"");
+    ERROR_CODE_COND_V(::std::memcmp(_keys + entry.key.offset, key, length) != 0, Error::UnknownTranslationKey, L"");
+    ERROR_CODE_COND_V(static_cast<u64>(entry.value.offset) + entry.value.length >= _header->valueTableSize, Error::UnknownTranslationKey, L"");
+    ERROR_CODE_COND_V(_values[entry.value.offset + entry.value.length] != L'\0', Error::UnknownTranslationKey, L"");
 
-    ERROR_CODE_V(Error::UnknownTranslationKey, WDynString());
+    ERROR_CODE_V(Error::NoError, _values + entry.value.offset);
 }
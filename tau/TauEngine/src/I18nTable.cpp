@@ -0,0 +1,283 @@
+#include "I18nTable.hpp"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#include <cstring>
+#pragma warning(pop)
+
+#pragma pack(push, 1)
+struct LangHeader
+{
+    u32 magic;
+    u32 translationCount;
+    u32 languageNameLength;
+};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+struct TranslationHeader
+{
+    u32 keyLength;
+    u32 valueLength;
+};
+#pragma pack(pop)
+
+static constexpr u32 LegacyMagic = 0x4C614E67;
+
+/**
+ *   Buckets average one key, so a bucket of a few keys will
+ * find a seed within a handful of attempts. This only guards
+ * against pathological input.
+ */
+static constexpr i32 MaxSeed = 1 << 24;
+
+void I18nTableBuilder::language(const wchar_t* const language, const uSys length) noexcept
+{ _language.assign(language, language + length); }
+
+void I18nTableBuilder::add(const DynString& key, const wchar_t* const value, const uSys length) noexcept
+{ _translations.push_back({ key, ::std::vector<u16>(value, value + length) }); }
+
+bool I18nTableBuilder::loadLegacy(const CPPRef<IFile>& file, Error* const error) noexcept
+{
+    ERROR_CODE_COND_F(!file, Error::InvalidFile);
+
+    LangHeader header;
+    ERROR_CODE_COND_F(file->readType(&header) != sizeof(header), Error::InvalidFile);
+    ERROR_CODE_COND_F(header.magic != LegacyMagic, Error::InvalidFile);
+
+    ::std::vector<wchar_t> value(header.languageNameLength);
+    ERROR_CODE_COND_F(file->readString(value.data(), header.languageNameLength) != static_cast<i64>(header.languageNameLength * sizeof(wchar_t)), Error::InvalidFile);
+    language(value.data(), value.size());
+
+    _translations.reserve(_translations.size() + header.translationCount);
+
+    for(u32 i = 0; i < header.translationCount; ++i)
+    {
+        TranslationHeader tHeader;
+        ERROR_CODE_COND_F(file->readType(&tHeader) != sizeof(tHeader), Error::InvalidFile);
+        ERROR_CODE_COND_F(static_cast<i64>(tHeader.keyLength) > file->size(), Error::InvalidFile);
+
+        char* key = new(::std::nothrow) char[tHeader.keyLength + 1];
+        ERROR_CODE_COND_F(!key, Error::SystemMemoryAllocationFailure);
+
+        key[tHeader.keyLength] = '\0';
+        if(file->readString(key, tHeader.keyLength) != static_cast<i64>(tHeader.keyLength * sizeof(char)))
+        {
+            delete[] key;
+            ERROR_CODE_F(Error::InvalidFile);
+        }
+
+        value.resize(tHeader.valueLength);
+        ERROR_CODE_COND_F(file->readString(value.data(), tHeader.valueLength) != static_cast<i64>(tHeader.valueLength * sizeof(wchar_t)), Error::InvalidFile);
+
+        add(DynString::passControl(key), value.data(), value.size());
+    }
+
+    ERROR_CODE_T(Error::NoError);
+}
+
+bool I18nTableBuilder::build(::std::vector<u8>& out, Error* const error) const noexcept
+{
+    ERROR_CODE_COND_F(_translations.size() >= 0x7FFFFFFF, Error::TooLarge);
+
+    const u32 entryCount = static_cast<u32>(_translations.size());
+
+    ::std::vector<u64> hashes(entryCount);
+    for(u32 i = 0; i < entryCount; ++i)
+    { hashes[i] = i18n::bin::hashKey(_translations[i].key.c_str(), _translations[i].key.length()); }
+
+    /**
+     *   Duplicate keys would both claim a slot, and two keys with
+     * the same 64 bit hash can never be separated by a seed.
+     */
+    {
+        ::std::vector<u32> order(entryCount);
+        for(u32 i = 0; i < entryCount; ++i)
+        { order[i] = i; }
+
+        ::std::sort(order.begin(), order.end(), [&hashes](const u32 a, const u32 b) { return hashes[a] < hashes[b]; });
+
+        for(u32 i = 1; i < entryCount; ++i)
+        {
+            if(hashes[order[i - 1]] == hashes[order[i]])
+            {
+                ERROR_CODE_COND_F(_translations[order[i - 1]].key.equals(_translations[order[i]].key), Error::DuplicateKey);
+                ERROR_CODE_F(Error::HashCollision);
+            }
+        }
+    }
+
+    ::std::vector<i32> seeds(entryCount, 0);
+    ::std::vector<u32> slots(entryCount, 0);
+
+    if(entryCount)
+    {
+        ::std::vector<::std::vector<u32>> buckets(entryCount);
+        for(u32 i = 0; i < entryCount; ++i)
+        { buckets[i18n::bin::bucket(hashes[i], entryCount)].push_back(i); }
+
+        ::std::vector<u32> bucketOrder(entryCount);
+        for(u32 i = 0; i < entryCount; ++i)
+        { bucketOrder[i] = i; }
+
+        ::std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&buckets](const u32 a, const u32 b) { return buckets[a].size() > buckets[b].size(); });
+
+        ::std::vector<bool> occupied(entryCount, false);
+        ::std::vector<u32> trial;
+
+        uSys b = 0;
+        for(; b < entryCount; ++b)
+        {
+            const ::std::vector<u32>& bucket = buckets[bucketOrder[b]];
+            if(bucket.size() <= 1)
+            { break; }
+
+            i32 seed = 1;
+            for(; seed < MaxSeed; ++seed)
+            {
+                trial.clear();
+                bool fits = true;
+                for(const u32 key : bucket)
+                {
+                    const u32 slot = i18n::bin::slot(hashes[key], seed, entryCount);
+                    if(occupied[slot] || ::std::find(trial.begin(), trial.end(), slot) != trial.end())
+                    {
+                        fits = false;
+                        break;
+                    }
+                    trial.push_back(slot);
+                }
+
+                if(fits)
+                { break; }
+            }
+
+            ERROR_CODE_COND_F(seed == MaxSeed, Error::PerfectHashFailed);
+
+            seeds[bucketOrder[b]] = seed;
+            for(uSys i = 0; i < bucket.size(); ++i)
+            {
+                occupied[trial[i]] = true;
+                slots[bucket[i]] = trial[i];
+            }
+        }
+
+        /**
+         * Single key buckets fill the remaining holes directly.
+         */
+        u32 freeSlot = 0;
+        for(; b < entryCount; ++b)
+        {
+            const ::std::vector<u32>& bucket = buckets[bucketOrder[b]];
+            if(bucket.empty())
+            { break; }
+
+            while(occupied[freeSlot])
+            { ++freeSlot; }
+
+            occupied[freeSlot] = true;
+            seeds[bucketOrder[b]] = -static_cast<i32>(freeSlot) - 1;
+            slots[bucket[0]] = freeSlot;
+        }
+    }
+
+    /**
+     *   Strings are laid out in slot order so that the key and
+     * value of neighbouring entries share pages.
+     */
+    ::std::vector<u32> bySlot(entryCount);
+    for(u32 i = 0; i < entryCount; ++i)
+    { bySlot[slots[i]] = i; }
+
+    uSys keyTableSize = 0;
+    uSys valueTableSize = _language.size() + 1;
+    for(const Translation& translation : _translations)
+    {
+        keyTableSize += translation.key.length();
+        valueTableSize += translation.value.size() + 1;
+    }
+
+    const uSys seedOffset = sizeof(i18n::bin::Header);
+    const uSys entryOffset = seedOffset + sizeof(i32) * entryCount;
+    const uSys keyTableOffset = entryOffset + sizeof(i18n::bin::Entry) * entryCount;
+    const uSys valueTableOffset = (keyTableOffset + keyTableSize + 3) & ~static_cast<uSys>(3);
+    const uSys fileSize = (valueTableOffset + valueTableSize * sizeof(u16) + 3) & ~static_cast<uSys>(3);
+
+    ERROR_CODE_COND_F(fileSize > 0xFFFFFFFF, Error::TooLarge);
+
+    out.assign(fileSize, 0);
+    u8* const base = out.data();
+
+    i18n::bin::Header* const header = reinterpret_cast<i18n::bin::Header*>(base);
+    header->magic = i18n::bin::Magic;
+    header->version = i18n::bin::Version;
+    header->headerSize = sizeof(i18n::bin::Header);
+    header->fileSize = static_cast<u32>(fileSize);
+    header->entryCount = entryCount;
+    header->seedOffset = static_cast<u32>(seedOffset);
+    header->entryOffset = static_cast<u32>(entryOffset);
+    header->keyTableOffset = static_cast<u32>(keyTableOffset);
+    header->keyTableSize = static_cast<u32>(keyTableSize);
+    header->valueTableOffset = static_cast<u32>(valueTableOffset);
+    header->valueTableSize = static_cast<u32>(valueTableSize);
+
+    if(entryCount)
+    { ::std::memcpy(base + seedOffset, seeds.data(), sizeof(i32) * entryCount); }
+
+    i18n::bin::Entry* const entries = reinterpret_cast<i18n::bin::Entry*>(base + entryOffset);
+    char* const keys = reinterpret_cast<char*>(base + keyTableOffset);
+    u16* const values = reinterpret_cast<u16*>(base + valueTableOffset);
+
+    u32 keyCursor = 0;
+    u32 valueCursor = 0;
+
+    header->language.offset = valueCursor;
+    header->language.length = static_cast<u32>(_language.size());
+    if(!_language.empty())
+    { ::std::memcpy(values + valueCursor, _language.data(), _language.size() * sizeof(u16)); }
+    valueCursor += static_cast<u32>(_language.size() + 1);
+
+    for(u32 slot = 0; slot < entryCount; ++slot)
+    {
+        const u32 index = bySlot[slot];
+        const Translation& translation = _translations[index];
+
+        i18n::bin::Entry& entry = entries[slot];
+        entry.hash = static_cast<u32>(hashes[index]);
+
+        entry.key.offset = keyCursor;
+        entry.key.length = static_cast<u32>(translation.key.length());
+        ::std::memcpy(keys + keyCursor, translation.key.c_str(), translation.key.length());
+        keyCursor += entry.key.length;
+
+        entry.value.offset = valueCursor;
+        entry.value.length = static_cast<u32>(translation.value.size());
+        if(!translation.value.empty())
+        { ::std::memcpy(values + valueCursor, translation.value.data(), translation.value.size() * sizeof(u16)); }
+        valueCursor += entry.value.length + 1;
+    }
+
+    ERROR_CODE_T(Error::NoError);
+}
+
+bool I18nTableBuilder::write(const CPPRef<IFile>& file, Error* const error) const noexcept
+{
+    ERROR_CODE_COND_F(!file, Error::InvalidFile);
+
+    ::std::vector<u8> image;
+    if(!build(image, error))
+    { return false; }
+
+    ERROR_CODE_COND_F(file->writeBytes(image.data(), image.size()) != static_cast<i64>(image.size()), Error::WriteFailed);
+
+    ERROR_CODE_T(Error::NoError);
+}
+
+bool I18nTableBuilder::compile(const CPPRef<IFile>& input, const CPPRef<IFile>& output, Error* const error) noexcept
+{
+    I18nTableBuilder builder;
+    if(!builder.loadLegacy(input, error))
+    { return false; }
+
+    return builder.write(output, error);
+}
@@ -0,0 +1,349 @@
+#include "SDFGenerator.hpp"
+
+#pragma warning(push, 0)
+#include FT_OUTLINE_H
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <list>
+#pragma warning(pop)
+
+/**
+ *   The flattened outline as a structure of arrays, padded to a
+ * multiple of 4 so that it can be processed 4 segments at a
+ * time.
+ */
+struct SDFSegments final
+{
+    ::std::vector<float> ax;
+    ::std::vector<float> ay;
+    ::std::vector<float> bx;
+    ::std::vector<float> by;
+    ::std::vector<float> dx;
+    ::std::vector<float> dy;
+    /**
+     * 1 / |b - a|^2, or 0 for a degenerate segment.
+     */
+    ::std::vector<float> invLengthSq;
+    /**
+     * dx / dy, used to find where a horizontal ray crosses the segment.
+     */
+    ::std::vector<float> dxdy;
+    /**
+     * +1 if the segment points up, -1 if it points down.
+     */
+    ::std::vector<float> direction;
+
+    void add(const float x0, const float y0, const float x1, const float y1) noexcept
+    {
+        const float segDX = x1 - x0;
+        const float segDY = y1 - y0;
+        const float lengthSq = segDX * segDX + segDY * segDY;
+
+        ax.push_back(x0);
+        ay.push_back(y0);
+        bx.push_back(x1);
+        by.push_back(y1);
+        dx.push_back(segDX);
+        dy.push_back(segDY);
+        invLengthSq.push_back(lengthSq > 0.0f ? 1.0f / lengthSq : 0.0f);
+        dxdy.push_back(segDY != 0.0f ? segDX / segDY : 0.0f);
+        direction.push_back(segDY > 0.0f ? 1.0f : -1.0f);
+    }
+
+    /**
+     *   Padding segments are far away and horizontal, so they
+     * never affect the distance or the winding.
+     */
+    void pad() noexcept
+    {
+        while(ax.size() & 3)
+        {
+            ax.push_back(1e18f);
+            ay.push_back(1e18f);
+            bx.push_back(1e18f);
+            by.push_back(1e18f);
+            dx.push_back(0.0f);
+            dy.push_back(0.0f);
+            invLengthSq.push_back(0.0f);
+            dxdy.push_back(0.0f);
+            direction.push_back(0.0f);
+        }
+    }
+
+    [[nodiscard]] uSys size() const noexcept { return ax.size(); }
+};
+
+struct SDFFlattener final
+{
+    SDFSegments& segments;
+    float flatness;
+    float x;
+    float y;
+
+    [[nodiscard]] u32 subdivisions(const float ddx, const float ddy, const float factor) const noexcept
+    {
+        /**
+         *   The deviation of a flattened curve is bounded by the
+         * magnitude of its second difference over the square of
+         * the number of segments.
+         */
+        const float dd = ::std::sqrt(ddx * ddx + ddy * ddy) * factor;
+        const u32 n = static_cast<u32>(::std::ceil(::std::sqrt(dd / flatness)));
+        return ::std::clamp<u32>(n, 1, 64);
+    }
+
+    void lineTo(const float toX, const float toY) noexcept
+    {
+        segments.add(x, y, toX, toY);
+        x = toX;
+        y = toY;
+    }
+};
+
+static inline float toPixels(const FT_Pos pos) noexcept
+{ return static_cast<float>(pos) / 64.0f; }
+
+static int sdfMoveTo(const FT_Vector* const to, void* const user) noexcept
+{
+    SDFFlattener* const flattener = reinterpret_cast<SDFFlattener*>(user);
+    flattener->x = toPixels(to->x);
+    flattener->y = toPixels(to->y);
+    return 0;
+}
+
+static int sdfLineTo(const FT_Vector* const to, void* const user) noexcept
+{
+    reinterpret_cast<SDFFlattener*>(user)->lineTo(toPixels(to->x), toPixels(to->y));
+    return 0;
+}
+
+static int sdfConicTo(const FT_Vector* const control, const FT_Vector* const to, void* const user) noexcept
+{
+    SDFFlattener* const flattener = reinterpret_cast<SDFFlattener*>(user);
+
+    const float x0 = flattener->x;
+    const float y0 = flattener->y;
+    const float x1 = toPixels(control->x);
+    const float y1 = toPixels(control->y);
+    const float x2 = toPixels(to->x);
+    const float y2 = toPixels(to->y);
+
+    const u32 n = flattener->subdivisions(x0 - 2.0f * x1 + x2, y0 - 2.0f * y1 + y2, 0.25f);
+
+    for(u32 i = 1; i <= n; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(n);
+        const float it = 1.0f - t;
+        flattener->lineTo(it * it * x0 + 2.0f * it * t * x1 + t * t * x2,
+                          it * it * y0 + 2.0f * it * t * y1 + t * t * y2);
+    }
+    return 0;
+}
+
+static int sdfCubicTo(const FT_Vector* const control0, const FT_Vector* const control1, const FT_Vector* const to, void* const user) noexcept
+{
+    SDFFlattener* const flattener = reinterpret_cast<SDFFlattener*>(user);
+
+    const float x0 = flattener->x;
+    const float y0 = flattener->y;
+    const float x1 = toPixels(control0->x);
+    const float y1 = toPixels(control0->y);
+    const float x2 = toPixels(control1->x);
+    const float y2 = toPixels(control1->y);
+    const float x3 = toPixels(to->x);
+    const float y3 = toPixels(to->y);
+
+    const float ddx = ::std::max(::std::abs(x0 - 2.0f * x1 + x2), ::std::abs(x1 - 2.0f * x2 + x3));
+    const float ddy = ::std::max(::std::abs(y0 - 2.0f * y1 + y2), ::std::abs(y1 - 2.0f * y2 + y3));
+    const u32 n = flattener->subdivisions(ddx, ddy, 0.75f);
+
+    for(u32 i = 1; i <= n; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(n);
+        const float it = 1.0f - t;
+        const float a = it * it * it;
+        const float b = 3.0f * it * it * t;
+        const float c = 3.0f * it * t * t;
+        const float d = t * t * t;
+        flattener->lineTo(a * x0 + b * x1 + c * x2 + d * x3,
+                          a * y0 + b * y1 + c * y2 + d * y3);
+    }
+    return 0;
+}
+
+/**
+ * Computes the squared distance and the winding number for a single texel.
+ */
+static inline void sdfTexel(const SDFSegments& segments, const float px, const float py, float* const distanceSq, i32* const winding) noexcept
+{
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpy = _mm_set1_ps(py);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 minDistSq = _mm_set1_ps(3.4e38f);
+    __m128 wind = _mm_setzero_ps();
+
+    for(uSys i = 0; i < segments.size(); i += 4)
+    {
+        const __m128 ax = _mm_loadu_ps(segments.ax.data() + i);
+        const __m128 ay = _mm_loadu_ps(segments.ay.data() + i);
+        const __m128 dx = _mm_loadu_ps(segments.dx.data() + i);
+        const __m128 dy = _mm_loadu_ps(segments.dy.data() + i);
+
+        // Distance to the closest point on the segment.
+        const __m128 pax = _mm_sub_ps(vpx, ax);
+        const __m128 pay = _mm_sub_ps(vpy, ay);
+        __m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(pax, dx), _mm_mul_ps(pay, dy)), _mm_loadu_ps(segments.invLengthSq.data() + i));
+        t = _mm_min_ps(_mm_max_ps(t, zero), one);
+        const __m128 ex = _mm_sub_ps(pax, _mm_mul_ps(t, dx));
+        const __m128 ey = _mm_sub_ps(pay, _mm_mul_ps(t, dy));
+        minDistSq = _mm_min_ps(minDistSq, _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)));
+
+        // Winding of a ray cast in the +x direction.
+        const __m128 aBelow = _mm_cmple_ps(ay, vpy);
+        const __m128 bBelow = _mm_cmple_ps(_mm_loadu_ps(segments.by.data() + i), vpy);
+        const __m128 crosses = _mm_xor_ps(aBelow, bBelow);
+        const __m128 crossX = _mm_add_ps(ax, _mm_mul_ps(pay, _mm_loadu_ps(segments.dxdy.data() + i)));
+        const __m128 hit = _mm_and_ps(crosses, _mm_cmplt_ps(vpx, crossX));
+        wind = _mm_add_ps(wind, _mm_and_ps(hit, _mm_loadu_ps(segments.direction.data() + i)));
+    }
+
+    alignas(16) float dist[4];
+    alignas(16) float windings[4];
+    _mm_store_ps(dist, minDistSq);
+    _mm_store_ps(windings, wind);
+
+    *distanceSq = ::std::min(::std::min(dist[0], dist[1]), ::std::min(dist[2], dist[3]));
+    *winding = static_cast<i32>(windings[0] + windings[1] + windings[2] + windings[3]);
+}
+
+bool SDFGenerator::generate(const FT_Face face, const u32 codepoint, const SDFArgs& args, SDFGlyph* const out) noexcept
+{
+    out->codepoint = codepoint;
+    out->width = 0;
+    out->height = 0;
+    out->bearingX = 0;
+    out->bearingY = 0;
+    out->advance = 0;
+    out->pixels.clear();
+
+    FT_Set_Pixel_Sizes(face, 0, args.emSize);
+
+    const FT_UInt index = FT_Get_Char_Index(face, codepoint);
+    if(!index || FT_Load_Glyph(face, index, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING))
+    { return false; }
+
+    const FT_GlyphSlot slot = face->glyph;
+    if(slot->format != FT_GLYPH_FORMAT_OUTLINE)
+    { return false; }
+
+    out->advance = static_cast<u32>(slot->advance.x);
+
+    if(slot->outline.n_contours == 0)
+    { return true; }
+
+    SDFSegments segments;
+    SDFFlattener flattener { segments, args.flatness > 0.0f ? args.flatness : 0.1f, 0.0f, 0.0f };
+
+    FT_Outline_Funcs funcs;
+    funcs.move_to = sdfMoveTo;
+    funcs.line_to = sdfLineTo;
+    funcs.conic_to = sdfConicTo;
+    funcs.cubic_to = sdfCubicTo;
+    funcs.shift = 0;
+    funcs.delta = 0;
+
+    if(FT_Outline_Decompose(&slot->outline, &funcs, &flattener))
+    { return false; }
+
+    segments.pad();
+
+    FT_BBox box;
+    FT_Outline_Get_CBox(&slot->outline, &box);
+
+    const i32 padding = static_cast<i32>(::std::ceil(args.spread));
+    const i32 left = static_cast<i32>(::std::floor(toPixels(box.xMin))) - padding;
+    const i32 right = static_cast<i32>(::std::ceil(toPixels(box.xMax))) + padding;
+    const i32 bottom = static_cast<i32>(::std::floor(toPixels(box.yMin))) - padding;
+    const i32 top = static_cast<i32>(::std::ceil(toPixels(box.yMax))) + padding;
+
+    const u32 width = static_cast<u32>(right - left);
+    const u32 height = static_cast<u32>(top - bottom);
+
+    out->width = static_cast<u16>(width);
+    out->height = static_cast<u16>(height);
+    out->bearingX = static_cast<i16>(left);
+    out->bearingY = static_cast<i16>(top);
+    out->pixels.resize(static_cast<uSys>(width) * height);
+
+    const float scale = 0.5f / args.spread;
+
+    for(u32 row = 0; row < height; ++row)
+    {
+        const float py = static_cast<float>(top - static_cast<i32>(row)) - 0.5f;
+        u8* const dst = out->pixels.data() + static_cast<uSys>(row) * width;
+
+        for(u32 column = 0; column < width; ++column)
+        {
+            const float px = static_cast<float>(left + static_cast<i32>(column)) + 0.5f;
+
+            float distanceSq;
+            i32 winding;
+            sdfTexel(segments, px, py, &distanceSq, &winding);
+
+            const float distance = winding != 0 ? ::std::sqrt(distanceSq) : -::std::sqrt(distanceSq);
+            const float value = ::std::clamp(0.5f + distance * scale, 0.0f, 1.0f);
+            dst[column] = static_cast<u8>(value * 255.0f + 0.5f);
+        }
+    }
+
+    return true;
+}
+
+::std::vector<SDFGlyph> SDFGenerator::generate(const FT_Library ft, const RefDynArray<u8>& fontData, const u32* const codepoints, const uSys count, const SDFArgs& args) noexcept
+{
+    ::std::vector<SDFGlyph> glyphs(count);
+
+    const uSys workerCount = ::std::max<uSys>(1, ::std::min<uSys>(args.workerCount, count));
+
+    /**
+     *   Faces are created up front, creating a face modifies the
+     * library, which is not thread safe.
+     */
+    ::std::vector<FT_Face> faces;
+    for(uSys i = 0; i < workerCount; ++i)
+    {
+        FT_Face face;
+        if(FT_New_Memory_Face(ft, fontData.arr(), static_cast<FT_Long>(fontData.size() - 1), 0, &face))
+        { break; }
+        faces.push_back(face);
+    }
+
+    if(faces.empty())
+    { return glyphs; }
+
+    /**
+     *   Glyphs are interleaved between workers so that clusters
+     * of complex glyphs are spread evenly.
+     */
+    ::std::list<::std::future<void>> futures;
+    for(uSys worker = 0; worker < faces.size(); ++worker)
+    {
+        futures.push_back(::std::async(::std::launch::async, [&, worker]()
+        {
+            for(uSys i = worker; i < count; i += faces.size())
+            { (void) generate(faces[worker], codepoints[i], args, &glyphs[i]); }
+        }));
+    }
+
+    for(::std::future<void>& future : futures)
+    { future.wait(); }
+
+    for(const FT_Face face : faces)
+    { FT_Done_Face(face); }
+
+    return glyphs;
+}
@@ -1,6 +1,7 @@
 #include "TauEngine.hpp"
 #include <NumTypes.hpp>
 #include <Utils.hpp>
+#include <ReferenceCountingPointer.hpp>
 
 #include "allocator/PageAllocator.hpp"
 #include "Timings.hpp"
@@ -137,6 +138,8 @@ void tauGameLoop(const u32 targetUPS, const update_f updateF, const render_f ren
             ++fps;
         }
 
+        rcpProcessPendingReleases();
+
         if(currentTime - counterTime >= 1000000)
         {
             counterTime = currentTime;
@@ -1,5 +1,6 @@
 #pragma warning(push, 0)
 #include <utility>
+#include <algorithm>
 #pragma warning(pop)
 
 #include <Utils.hpp>
@@ -26,6 +27,7 @@
 #include "system/Window.hpp"
 #include "graphics/RasterizerState.hpp"
 #include "system/GraphicsInterface.hpp"
+#include "graphics/StateCache.hpp"
 #include "texture/NullTexture.hpp"
 #include "texture/FITextureLoader.hpp"
 #include <EnumBitFields.hpp>
@@ -67,9 +69,11 @@ NullableRef<IRasterizerState> TextHandler::rs = nullptr;
 
 #define INSTANCE_COUNT 128
 
-TextHandler::TextHandler(IGraphicsInterface& gi, IRenderingContext& context, const char* const vfsMount, const char* const path, const char* const vertexName, const char* const pixelName) noexcept
+TextHandler::TextHandler(IGraphicsInterface& gi, IRenderingContext& context, const char* const vfsMount, const char* const path, const char* const vertexName, const char* const pixelName, const char* const sdfPixelName) noexcept
     : _ft(null)
     , _shader(IShaderProgram::create(gi))
+    , _sdfShader(null)
+    , _sdfShaderError(IShaderBuilder::Error::NoError)
     , _va(null)
     , _viewUniforms(gi.createBuffer())
     , _colorUniforms(gi.createBuffer())
@@ -92,6 +96,29 @@ TextHandler::TextHandler(IGraphicsInterface& gi, IRenderingContext& context, con
 
     _shader->link(context);
 
+    if(sdfPixelName)
+    {
+        shaderArgs.fileName = sdfPixelName;
+        shaderArgs.stage = EShader::Stage::Pixel;
+        CPPRef<IShader> sdfPixelShader = gi.createShader().buildCPPRef(shaderArgs, &_sdfShaderError);
+
+        if(_sdfShaderError == IShaderBuilder::Error::NoError && !sdfPixelShader)
+        { _sdfShaderError = IShaderBuilder::Error::InternalError; }
+
+        if(_sdfShaderError == IShaderBuilder::Error::NoError)
+        {
+            _sdfShader = IShaderProgram::create(gi);
+            if(_sdfShader)
+            {
+                _sdfShader->setVertexShader(context, vertexShader);
+                _sdfShader->setPixelShader(context, sdfPixelShader);
+                _sdfShader->link(context);
+            }
+            else
+            { _sdfShaderError = IShaderBuilder::Error::SystemMemoryAllocationFailure; }
+        }
+    }
+
     TextureSamplerArgs textureSamplerArgs;
     textureSamplerArgs.magFilter() = ETexture::Filter::Linear;
     textureSamplerArgs.minFilter() = ETexture::Filter::Linear;
@@ -141,6 +168,29 @@ TextHandler::TextHandler(IGraphicsInterface& gi, IRenderingContext& context, con
 
     _va = gi.createVertexArray().buildCPPRef(vaArgs, null);
 
+    VertexBufferArgs batchBufferArgs(1);
+    batchBufferArgs.type = EBuffer::Type::ArrayBuffer;
+    batchBufferArgs.usage = EBuffer::UsageType::DynamicDraw;
+    batchBufferArgs.elementCount = MaxBatchGlyphs * 6;
+    batchBufferArgs.initialBuffer = null;
+    batchBufferArgs.descriptor.addDescriptor(ShaderSemantic::Position, ShaderDataType::Vector2Float);
+
+    _batchPositionBuffer = gi.createVertexBuffer().buildCPPRef(batchBufferArgs, null);
+
+    batchBufferArgs.descriptor.reset(1);
+    batchBufferArgs.descriptor.addDescriptor(ShaderSemantic::TextureCoord, ShaderDataType::Vector2Float);
+
+    _batchTexCoordBuffer = gi.createVertexBuffer().buildCPPRef(batchBufferArgs, null);
+
+    VertexArrayArgs batchVAArgs(2);
+    batchVAArgs.shader = vertexShader.get();
+    batchVAArgs.buffers[0] = _batchPositionBuffer;
+    batchVAArgs.buffers[1] = _batchTexCoordBuffer;
+    batchVAArgs.drawCount = MaxBatchGlyphs * 6;
+    batchVAArgs.drawType = DrawType::SeparatedTriangles;
+
+    _batchVA = gi.createVertexArray().buildCPPRef(batchVAArgs, null);
+
     if(!rs)
     {
         RasterizerArgs rArgs = context.getDefaultRasterizerArgs();
@@ -151,7 +201,7 @@ TextHandler::TextHandler(IGraphicsInterface& gi, IRenderingContext& context, con
         else
         {
             rArgs.frontFaceCounterClockwise = true;
-            rs = gi.createRasterizerState().buildTauRef(rArgs, null);
+            rs = gi.stateCache().rasterizerState(rArgs);
         }
     }
 }
@@ -226,13 +276,27 @@ TextHandler::FileData* TextHandler::load2(RefDynArray<u8> file, LoadData* ld) no
     return new FileData { face, file };
 }
 
-GlyphSetHandle TextHandler::generateBitmapCharacters(IGraphicsInterface& gi, IRenderingContext& context, const DynString& glyphSetName, const wchar_t minChar, const wchar_t maxChar, const bool smooth, FT_Face face) noexcept
+CPPRef<GlyphCache> TextHandler::createGlyphCache(const FileData& file, const FT_UInt pixelHeight, const GlyphCacheArgs& args) const noexcept
 {
     PERF();
-    using Packer = TexturePacker2D<wchar_t, u16>;
+    const CPPRef<GlyphCache> cache(new(::std::nothrow) GlyphCache(_ft, file.data, pixelHeight, args));
+
+    if(!cache || cache->init())
+    { return nullptr; }
 
+    return cache;
+}
+
+GlyphSetHandle TextHandler::generateBitmapCharacters(IGraphicsInterface& gi, IRenderingContext& context, const DynString& glyphSetName, const wchar_t minChar, const wchar_t maxChar, const bool smooth, FT_Face face) noexcept
+{
+    PERF();
     GlyphSetHandle gs(DefaultTauAllocator::Instance(), glyphSetName, minChar, maxChar);
-    DynArray<Packer::Texture> textures(maxChar - minChar + 1);
+    DynArray<GlyphPacker::Texture> textures(maxChar - minChar + 1);
+    /**
+     *   Keep each bitmap from the sizing pass, otherwise every
+     * glyph would have to be rasterized a second time to blit it.
+     */
+    ::std::vector<::std::vector<u8>> bitmaps(maxChar - minChar + 1);
 
     uSys index = 0;
 
@@ -240,17 +304,83 @@ GlyphSetHandle TextHandler::generateBitmapCharacters(IGraphicsInterface& gi, IRe
     {
         if(FT_Load_Char(face, c, FT_LOAD_RENDER)) { continue; }
 
-        if(face->glyph->bitmap.buffer)
+        const FT_GlyphSlot slot = face->glyph;
+
+        auto& glyph = gs->glyphs[c - gs->minGlyph];
+        glyph.size = Vector2f(static_cast<float>(slot->bitmap.width), static_cast<float>(slot->bitmap.rows));
+        glyph.bearing = Vector2f(static_cast<float>(slot->bitmap_left), static_cast<float>(slot->bitmap_top));
+        glyph.advance = slot->advance.x;
+
+        if(slot->bitmap.buffer)
         {
+            ::std::vector<u8>& bitmap = bitmaps[c - minChar];
+            bitmap.resize(static_cast<uSys>(slot->bitmap.width) * slot->bitmap.rows);
+            for(uSys row = 0; row < slot->bitmap.rows; ++row)
+            { ::std::memcpy(bitmap.data() + row * slot->bitmap.width, slot->bitmap.buffer + static_cast<iSys>(row) * slot->bitmap.pitch, slot->bitmap.width); }
+
             textures[index].handle = c;
-            textures[index].width = face->glyph->bitmap.width;
-            textures[index].height = face->glyph->bitmap.rows;
+            textures[index].width = slot->bitmap.width;
+            textures[index].height = slot->bitmap.rows;
+            ++index;
+        }
+    }
+
+    gs->texture = packGlyphs(gi, *gs, textures, index, bitmaps);
+
+    return gs;
+}
+
+GlyphSetHandle TextHandler::generateSDFCharacters(IGraphicsInterface& gi, IRenderingContext& context, const DynString& glyphSetName, const wchar_t minChar, const wchar_t maxChar, const FileData& file, const SDFArgs& args) noexcept
+{
+    PERF();
+    if(!_sdfShader)
+    { return null; }
+
+    GlyphSetHandle gs(DefaultTauAllocator::Instance(), glyphSetName, minChar, maxChar);
+    gs->sdf = true;
+    gs->spread = args.spread;
+    gs->emSize = args.emSize;
+
+    ::std::vector<u32> codepoints(maxChar - minChar + 1);
+    for(uSys i = 0; i < codepoints.size(); ++i)
+    { codepoints[i] = static_cast<u32>(minChar + i); }
+
+    ::std::vector<SDFGlyph> sdfGlyphs = SDFGenerator::generate(_ft, file.data, codepoints.data(), codepoints.size(), args);
+
+    DynArray<GlyphPacker::Texture> textures(codepoints.size());
+    ::std::vector<::std::vector<u8>> bitmaps(codepoints.size());
+
+    uSys index = 0;
+
+    for(uSys i = 0; i < sdfGlyphs.size(); ++i)
+    {
+        SDFGlyph& sdfGlyph = sdfGlyphs[i];
+
+        auto& glyph = gs->glyphs[i];
+        glyph.size = Vector2f(static_cast<float>(sdfGlyph.width), static_cast<float>(sdfGlyph.height));
+        glyph.bearing = Vector2f(static_cast<float>(sdfGlyph.bearingX), static_cast<float>(sdfGlyph.bearingY));
+        glyph.advance = sdfGlyph.advance;
+
+        if(!sdfGlyph.pixels.empty())
+        {
+            bitmaps[i] = ::std::move(sdfGlyph.pixels);
+
+            textures[index].handle = static_cast<wchar_t>(minChar + i);
+            textures[index].width = sdfGlyph.width;
+            textures[index].height = sdfGlyph.height;
             ++index;
         }
     }
 
-    Packer packer(index);
-    packer.pack(textures.arr(), index, 65536, 1);
+    gs->texture = packGlyphs(gi, *gs, textures, index, bitmaps);
+
+    return gs;
+}
+
+NullableRef<IResource> TextHandler::packGlyphs(IGraphicsInterface& gi, GlyphSet& gs, DynArray<GlyphPacker::Texture>& textures, const uSys count, const ::std::vector<::std::vector<u8>>& bitmaps) noexcept
+{
+    GlyphPacker packer(count);
+    packer.pack(textures.arr(), count, 65536, 1);
 
     u8* const raw = reinterpret_cast<u8*>(operator new(packer.packedWidth() * packer.packedHeight(), ::std::nothrow));
 
@@ -258,26 +388,23 @@ GlyphSetHandle TextHandler::generateBitmapCharacters(IGraphicsInterface& gi, IRe
 
     for(const auto& loc : packer.allocatedSpaces())
     {
-        if(FT_Load_Char(face, loc.handle, FT_LOAD_RENDER)) { continue; }
+        auto& glyph = gs.glyphs[loc.handle - gs.minGlyph];
+        const ::std::vector<u8>& bitmap = bitmaps[loc.handle - gs.minGlyph];
 
-        const uSys width = face->glyph->bitmap.width;
-        const uSys maxY = loc.y + face->glyph->bitmap.rows;
+        const uSys width = static_cast<uSys>(glyph.size.x());
+        const uSys maxY = loc.y + static_cast<uSys>(glyph.size.y());
 
         uSys readIndex = 0;
 
         for(uSys y = loc.y; y < maxY; ++y)
         {
-            const uSys writeIndex = y * width + loc.x;
+            const uSys writeIndex = y * packer.packedWidth() + loc.x;
 
-            ::std::memcpy(raw + writeIndex, face->glyph->bitmap.buffer + readIndex, width);
+            ::std::memcpy(raw + writeIndex, bitmap.data() + readIndex, width);
             readIndex += width;
         }
 
-        auto& glyph = gs->glyphs[loc.handle - gs->minGlyph];
         glyph.coord = Vector2f(static_cast<float>(loc.x), static_cast<float>(loc.y));
-        glyph.size = Vector2f(static_cast<float>(face->glyph->bitmap.width), static_cast<float>(face->glyph->bitmap.rows));
-        glyph.bearing = Vector2f(static_cast<float>(face->glyph->bitmap_left), static_cast<float>(face->glyph->bitmap_top));
-        glyph.advance = face->glyph->advance.x;
     }
 
     ResourceTexture2DArgs args;
@@ -292,11 +419,11 @@ GlyphSetHandle TextHandler::generateBitmapCharacters(IGraphicsInterface& gi, IRe
     args.initialBuffers = reinterpret_cast<void* const*>(&raw);
 
     IResourceBuilder::Error error;
-    gs->texture = gi.createResource().buildTauRef(args, nullptr, &error);
+    NullableRef<IResource> texture = gi.createResource().buildTauRef(args, nullptr, &error);
 
     operator delete(raw, ::std::nothrow);
 
-    return gs;
+    return texture;
 }
 
 void TextHandler::renderText(IRenderingContext& context, GlyphSetHandle glyphSetHandle, const char* str, float x, float y, float scale, Vector3f color, const glm::mat4& proj) noexcept
@@ -304,8 +431,9 @@ void TextHandler::renderText(IRenderingContext& context, GlyphSetHandle glyphSet
     const NullableRef<IRasterizerState> tmpRS = context.setRasterizerState(rs);
     // const GlyphSet& glyphSet = _glyphSets[glyphSetHandle];
     const GlyphSet& glyphSet = *glyphSetHandle.get();
+    IShaderProgram& shader = glyphSet.sdf && _sdfShader ? *_sdfShader : *_shader;
 
-    _shader->bind(context);
+    shader.bind(context);
 
     _viewUniforms.data().projectionMatrix = proj;
     _viewUniforms.upload(context, EShader::Stage::Vertex, 0);
@@ -362,9 +490,68 @@ void TextHandler::renderText(IRenderingContext& context, GlyphSetHandle glyphSet
     _va->unbind(context);
     _viewUniforms.unbind(context, EShader::Stage::Vertex, 2);
     _colorUniforms.unbind(context, EShader::Stage::Pixel, 1);
+    shader.unbind(context);
+
+    (void) context.setRasterizerState(tmpRS);
+}
+
+float TextHandler::renderText(IRenderingContext& context, GlyphCache& cache, const wchar_t* const str, const uSys length, const float x, const float y, const float scale, const Vector3f color, const glm::mat4& proj) noexcept
+{
+    cache.buildQuads(str, length, x, y, scale, _batch);
+
+    if(_batch.ranges.empty())
+    { return _batch.endX; }
+
+    const NullableRef<IRasterizerState> tmpRS = context.setRasterizerState(rs);
+
+    _shader->bind(context);
+
+    _viewUniforms.data().projectionMatrix = proj;
+    _viewUniforms.upload(context, EShader::Stage::Vertex, 0);
+
+    _colorUniforms.data().color = color;
+    _colorUniforms.upload(context, EShader::Stage::Pixel, 1);
+
+    _batchVA->bind(context);
+    _batchVA->preDraw(context);
+
+    for(const GlyphBatch::Range& range : _batch.ranges)
+    {
+        const GlyphCache::Page& page = cache.pages()[range.page];
+        if(!page.texture)
+        { continue; }
+
+        _textureUploader->texture(page.texture->textureView());
+        (void) _textureUploader->upload(context, TextureIndices(0, 0, 0), EShader::Stage::Pixel);
+
+        for(uSys vertex = 0; vertex < range.vertexCount; vertex += MaxBatchGlyphs * 6)
+        {
+            const uSys count = ::std::min<uSys>(range.vertexCount - vertex, MaxBatchGlyphs * 6);
+            const uSys offset = (range.firstVertex + vertex) * 2;
+
+            _batchPositionBuffer->beginModification(context);
+            _batchPositionBuffer->modifyBuffer(0, count * 2 * sizeof(float), _batch.positions.data() + offset);
+            _batchPositionBuffer->endModification(context);
+
+            _batchTexCoordBuffer->beginModification(context);
+            _batchTexCoordBuffer->modifyBuffer(0, count * 2 * sizeof(float), _batch.texCoords.data() + offset);
+            _batchTexCoordBuffer->endModification(context);
+
+            _batchVA->draw(context, count);
+        }
+
+        (void) _textureUploader->unbind(context, TextureIndices(0, 0, 0), EShader::Stage::Pixel);
+    }
+
+    _batchVA->postDraw(context);
+    _batchVA->unbind(context);
+    _viewUniforms.unbind(context, EShader::Stage::Vertex, 2);
+    _colorUniforms.unbind(context, EShader::Stage::Pixel, 1);
     _shader->unbind(context);
 
     (void) context.setRasterizerState(tmpRS);
+
+    return _batch.endX;
 }
 
 float TextHandler::renderTextLineWrapped(IRenderingContext& context, GlyphSetHandle glyphSetHandle, const char* str, float x, float y, float scale, Vector3f color, const glm::mat4& proj, const Window& window, float lineHeight) noexcept
@@ -372,8 +559,9 @@ float TextHandler::renderTextLineWrapped(IRenderingContext& context, GlyphSetHan
     const NullableRef<IRasterizerState> tmpRS = context.setRasterizerState(rs);
     // const GlyphSet& glyphSet = _glyphSets[glyphSetHandle];
     const GlyphSet& glyphSet = *glyphSetHandle.get();
+    IShaderProgram& shader = glyphSet.sdf && _sdfShader ? *_sdfShader : *_shader;
 
-    _shader->bind(context);
+    shader.bind(context);
 
     _viewUniforms.data().projectionMatrix = proj;
     _viewUniforms.upload(context, EShader::Stage::Vertex, 0);
@@ -442,7 +630,7 @@ float TextHandler::renderTextLineWrapped(IRenderingContext& context, GlyphSetHan
     _va->unbind(context);
     _viewUniforms.unbind(context, EShader::Stage::Vertex, 2);
     _colorUniforms.unbind(context, EShader::Stage::Pixel, 1);
-    _shader->unbind(context);
+    shader.unbind(context);
 
     (void) context.setRasterizerState(tmpRS);
 
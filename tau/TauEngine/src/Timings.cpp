@@ -243,6 +243,49 @@ void TimingsWriter::write(const ProfileResult& pr) noexcept
     }
 }
 
+void TimingsWriter::writeMemory(const AllocationTracker::Snapshot& snapshot, const u64 time) noexcept
+{
+    Lock lock(_mutex);
+    if(_profileFile)
+    {
+        const std::string timeString = std::to_string(time);
+
+        for(const AllocationTracker::TagStats& tag : snapshot.tags)
+        {
+            if(!tag.allocations && !tag.bytes)
+            { continue; }
+
+            if(_profileCount++ > 0)
+            {
+                _profileFile->writeString(R"(,)");
+            }
+
+            _profileFile->writeString(R"({)");
+            _profileFile->writeString(R"("cat":"memory",)");
+            _profileFile->writeString(R"("name":"mem:)");
+            _profileFile->writeString(tag.name);
+            _profileFile->writeString(R"(",)");
+            _profileFile->writeString(R"("ph":"C",)");
+            _profileFile->writeString(R"("pid":"0",)");
+            _profileFile->writeString(R"("ts":)");
+            _profileFile->writeString(timeString.c_str());
+            _profileFile->writeString(R"(,)");
+            _profileFile->writeString(R"("args":{"bytes":)");
+            {
+                const std::string bytesString = std::to_string(tag.bytes);
+                _profileFile->writeString(bytesString.c_str());
+            }
+            _profileFile->writeString(R"(,"live":)");
+            {
+                const std::string liveString = std::to_string(tag.liveAllocations);
+                _profileFile->writeString(liveString.c_str());
+            }
+            _profileFile->writeString(R"(})");
+            _profileFile->writeString(R"(})");
+        }
+    }
+}
+
 void TimingsWriter::writeHeader(const char* name) noexcept
 {
     if(_profileFile)
@@ -6,6 +6,7 @@
 #include "system/Window.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <cstring>
 
 Camera3D::Camera3D(const Window& window, const float fov, const float zNear, const float zFar) noexcept
     : _position(0.0f), _pitch(0.0f), _yaw(0.0f), _roll(0.0f), _viewQuaternion(),
@@ -166,7 +167,8 @@ void FreeCamCamera3DController::update(const float fixedDelta, const i32 dMouseX
     checkKeys();
     if(_recorder && _recorder->recording())
     {
-        _recorder->addBlip(GameRecorder::Blip { GameRecorder::BlipType::Update, cameraBlip(), new BlipDataUpdate{ fixedDelta, _velocity, dMouseX, dMouseY } });
+        BlipDataUpdate data { fixedDelta, _velocity, dMouseX, dMouseY };
+        _recorder->addBlip(GameRecorder::Blip { GameRecorder::BlipType::Update, cameraBlip(), &data });
     }
     update(fixedDelta, _velocity, dMouseX, dMouseY);
 }
@@ -230,12 +232,30 @@ bool FreeCamCamera3DController::blipHandler(GameRecorder::Blip& blip, void* user
 GameRecorder::Blip FreeCamCamera3DController::initialBlip(void* userParam) noexcept
 {
     FreeCamCamera3DController& controller = *reinterpret_cast<FreeCamCamera3DController*>(userParam);
-    return { GameRecorder::BlipType::Initial, cameraBlip(), new BlipDataInitial{
+    controller._initialBlipData = {
         controller._camera._position,
         controller._camera._pitch,
         controller._camera._yaw,
         controller._rotateSpeed,
-    } };
+    };
+    return { GameRecorder::BlipType::Initial, cameraBlip(), &controller._initialBlipData };
+}
+
+uSys FreeCamCamera3DController::serializeBlip(const GameRecorder::Blip& blip, u8* const buffer, const uSys bufferSize, void*) noexcept
+{
+    uSys size;
+    switch(blip.type)
+    {
+        case GameRecorder::BlipType::Update:  size = sizeof(BlipDataUpdate);  break;
+        case GameRecorder::BlipType::Initial: size = sizeof(BlipDataInitial); break;
+        default: return 0;
+    }
+
+    if(size > bufferSize)
+    { return 0; }
+
+    ::std::memcpy(buffer, blip.data, size);
+    return size;
 }
 
 RunTimeType<GameRecorder::Blip> FreeCamCamera3DController::cameraBlip() noexcept
@@ -7,6 +7,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "system/GraphicsInterface.hpp"
+#include "graphics/StateCache.hpp"
 
 template<>
 class UniformAccessor<Skybox::Uniforms> final
@@ -137,11 +138,11 @@ Skybox::Skybox(IGraphicsInterface& gi, IRenderingContext& context, const char* c
     DepthStencilArgs dsArgs = context.getDefaultDepthStencilArgs();
     dsArgs.depthWriteMask = DepthStencilArgs::DepthWriteMask::Zero;
     dsArgs.depthCompareFunc = DepthStencilArgs::CompareFunc::LessThanOrEqual;
-    _skyboxDepthStencilState = gi.createDepthStencilState().buildTauRef(dsArgs, null);
+    _skyboxDepthStencilState = gi.stateCache().depthStencilState(dsArgs);
 
     RasterizerArgs rArgs = context.getDefaultRasterizerArgs();
     rArgs.frontFaceCounterClockwise = true;
-    _skyboxRasterizerState = gi.createRasterizerState().buildTauRef(rArgs, null);
+    _skyboxRasterizerState = gi.stateCache().rasterizerState(rArgs);
 }
 
 void Skybox::render(IRenderingContext& context, const Camera3D& camera) noexcept
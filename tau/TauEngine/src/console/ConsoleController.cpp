@@ -1,6 +1,9 @@
 #include <TauEngine.hpp>
 #include <console/ConsoleController.hpp>
+#include <console/ConsoleVariable.hpp>
 #include <VariableLengthArray.hpp>
+#include <TUMaths.hpp>
+#include <VFS.hpp>
 
 #pragma warning(push, 0)
 #include <cstdio>
@@ -10,7 +13,11 @@
 namespace Console {
 
 Controller::Controller() noexcept
-    : _commands(),
+    : _commandTable(),
+      _commandCount(0),
+      _tableShift(64),
+      _ownedCommands(),
+      _changedCVars(nullptr),
       _printFunctions({
       [](void*, const char* str) { fputs(str, stdout); },
       [](void*, const char* str) { puts(str); },
@@ -21,96 +28,295 @@ Controller::Controller() noexcept
 { }
 
 Controller::Controller(PrintFunctions printFunctions, void* userParam) noexcept
-    : _commands(), _printFunctions(printFunctions), _userParam(userParam)
+    : _commandTable(), _commandCount(0), _tableShift(64), _ownedCommands(), _changedCVars(nullptr), _printFunctions(printFunctions), _userParam(userParam)
 { }
 
 Controller::~Controller() noexcept
 {
-    for(auto& pair : _commands)
+    for(Command* command : _ownedCommands)
     {
-        delete pair.second;
+        delete command;
     }
 }
 
 void Controller::addCommand(Command* command) noexcept
 {
-    _commands[command->name()] = command;
+    _ownedCommands.push_back(command);
+    insertCommand(command->name(), findHashCode(command->name()), command);
 }
 
-static void splitCommand(const char* RESTRICT command, std::vector<const char*>& RESTRICT sections)
+void Controller::addCVar(CVarBase* cvar) noexcept
+{
+    cvar->_controller = this;
+    insertCommand(cvar->name(), findHashCode(cvar->name()), cvar);
+
+    // It may have been set before it was registered.
+    if(cvar->_changed.load(::std::memory_order_acquire))
+    { queueChanged(cvar); }
+}
+
+/**
+ *   Spreads the hash across the table. The string hash only mixes
+ * each character in with a multiply by 31, so its low bits barely
+ * depend on anything but the last few characters.
+ */
+[[nodiscard]] static inline uSys tableIndex(const uSys hash, const u32 shift) noexcept
+{ return static_cast<uSys>((static_cast<u64>(hash) * 0x9E3779B97F4A7C15ull) >> shift); }
+
+Command* Controller::findCommand(const char* name) const noexcept
+{
+    return findCommand(name, findHashCode(name));
+}
+
+Command* Controller::findCommand(const char* name, const uSys hash) const noexcept
+{
+    if(_commandTable.empty())
+    { return nullptr; }
+
+    const uSys mask = _commandTable.size() - 1;
+    for(uSys i = tableIndex(hash, _tableShift);; i = (i + 1) & mask)
+    {
+        const CommandEntry& entry = _commandTable[i];
+        if(!entry.command)
+        { return nullptr; }
+
+        if(entry.hash == hash && strcmp(entry.name.c_str(), name) == 0)
+        { return entry.command; }
+    }
+}
+
+void Controller::insertCommand(const char* name, const uSys hash, Command* command) noexcept
+{
+    // Keep the table at most half full so that probes stay short.
+    if((_commandCount + 1) * 2 > _commandTable.size())
+    {
+        ::std::vector<CommandEntry> oldTable(::std::move(_commandTable));
+        const uSys size = oldTable.empty() ? 32 : oldTable.size() * 2;
+
+        _commandTable = ::std::vector<CommandEntry>(size, CommandEntry { 0, DynString(), nullptr });
+        _tableShift = 64 - static_cast<u32>(_ctz(static_cast<u64>(size)));
+        _commandCount = 0;
+
+        for(const CommandEntry& entry : oldTable)
+        {
+            if(entry.command)
+            { insertCommand(entry.name.c_str(), entry.hash, entry.command); }
+        }
+    }
+
+    const uSys mask = _commandTable.size() - 1;
+    for(uSys i = tableIndex(hash, _tableShift);; i = (i + 1) & mask)
+    {
+        CommandEntry& entry = _commandTable[i];
+        if(!entry.command)
+        {
+            entry.hash = hash;
+            entry.name = DynString(name);
+            entry.command = command;
+            ++_commandCount;
+            return;
+        }
+
+        // Adding a command with the same name replaces it.
+        if(entry.hash == hash && strcmp(entry.name.c_str(), name) == 0)
+        {
+            entry.command = command;
+            return;
+        }
+    }
+}
+
+[[nodiscard]] static inline bool isSeparator(const char c) noexcept
+{ return c == ' ' || c == '\t' || c == '\r'; }
+
+/**
+ *   Splits a line into tokens in place. Each token is terminated
+ * by overwriting the separator following it, quoted tokens are
+ * unescaped by shifting them down over their quotes and
+ * backslashes. The hash of the first token is computed along the
+ * way, so the command lookup doesn't need another pass over it.
+ *
+ * @return
+ *      The number of tokens, or `maxTokens + 1` if there were
+ *    too many.
+ */
+static u32 tokenize(char* line, const char** const tokens, const u32 maxTokens, uSys* const firstHash) noexcept
 {
     u32 count = 0;
+    char* read = line;
 
-    while(*command != '\0')
+    while(true)
     {
-        if(*command == ' ')
+        while(isSeparator(*read))
+        { ++read; }
+
+        if(*read == '\0')
+        { break; }
+
+        if(count == maxTokens)
+        { return maxTokens + 1; }
+
+        uSys hash = 0;
+        char* write;
+
+        if(*read == '"')
+        {
+            ++read;
+            write = read;
+            tokens[count] = write;
+
+            while(*read != '\0' && *read != '"')
+            {
+                if(*read == '\\' && (read[1] == '"' || read[1] == '\\'))
+                { ++read; }
+
+                hash = 31u * hash + static_cast<uSys>(*read);
+                *write++ = *read++;
+            }
+
+            if(*read == '"')
+            { ++read; }
+        }
+        else
         {
-            char* str = new char[count + 1];
-            str[count] = '\0';
-            memcpy(str, command - count, count);
-            count = 0;
-            sections.push_back(str);
-            do
+            write = read;
+            tokens[count] = write;
+
+            while(*read != '\0' && !isSeparator(*read))
             {
-                ++command;
-            } while(*command == ' ');
-
-            if(*command == '\0') { break; }
-
-            // if(*command == '"')
-            // {
-            //     ++command;
-            //     do
-            //     {
-            //         ++count;
-            //         if(*command == '\\')
-            //         {
-            //             ++command;
-            //             if(*command == '"') { ++command; }
-            //         }
-            //     } while(*command != '"' && *command != '\0');
-            //
-            //     if(*command == '\0') { break; }
-            // }
-
-            continue;
+                hash = 31u * hash + static_cast<uSys>(*read);
+                *write++ = *read++;
+            }
         }
 
+        if(count == 0)
+        { *firstHash = hash; }
         ++count;
-        ++command;
+
+        // The terminator may overwrite the separator `read` is on.
+        const char next = *read;
+        *write = '\0';
+
+        if(next == '\0')
+        { break; }
+
+        if(isSeparator(next))
+        { ++read; }
     }
 
-    if(count)
+    return count;
+}
+
+i32 Controller::runLine(char* line) noexcept
+{
+    const char* sections[MaxTokens];
+    uSys hash = 0;
+    const u32 count = tokenize(line, sections, MaxTokens, &hash);
+
+    if(!count)
+    { return NO_COMMAND_FOUND; }
+
+    if(count > MaxTokens)
     {
-        char* str = new char[count + 1];
-        str[count] = '\0';
-        memcpy(str, command - count, count);
-        sections.push_back(str);
+        printf("Too many arguments, at most %u are supported.\n", MaxTokens - 1);
+        return -1;
     }
+
+    Command* const cc = findCommand(sections[0], hash);
+    if(!cc)
+    { return NO_COMMAND_FOUND; }
+
+    return cc->execute(sections[0], sections + 1, count - 1, this);
 }
 
 i32 Controller::runCommand(const char* command) noexcept
 {
-    std::vector<const char*> sections;
-    splitCommand(command, sections);
-    if(!sections.empty())
+    const uSys length = strlen(command);
+
+    if(length >= VLA_MAX_LEN)
     {
-        if(_commands.count(sections[0]))
-        {
-            Command* cc = _commands[sections[0]];
-            return cc->execute(sections[0], sections.data() + 1, static_cast<u32>(sections.size() - 1), this);
-        }
+        char* const line = new char[length + 1];
+        memcpy(line, command, length + 1);
+        const i32 ret = runLine(line);
+        delete[] line;
+        return ret;
     }
 
-    return NO_COMMAND_FOUND;
+    char line[VLA_MAX_LEN];
+    memcpy(line, command, length + 1);
+    return runLine(line);
+}
+
+u32 Controller::runScript(const char* script, const uSys length) noexcept
+{
+    const char* const end = script + length;
+    char buffer[VLA_MAX_LEN];
+    u32 failures = 0;
+
+    while(script < end)
+    {
+        const char* lineEnd = static_cast<const char*>(memchr(script, '\n', static_cast<uSys>(end - script)));
+        if(!lineEnd)
+        { lineEnd = end; }
+
+        const char* begin = script;
+        script = lineEnd + 1;
+
+        while(begin < lineEnd && isSeparator(*begin))
+        { ++begin; }
+
+        const uSys lineLength = static_cast<uSys>(lineEnd - begin);
+        if(!lineLength || *begin == '#' || (lineLength >= 2 && begin[0] == '/' && begin[1] == '/'))
+        { continue; }
+
+        char* const line = lineLength < VLA_MAX_LEN ? buffer : new char[lineLength + 1];
+        memcpy(line, begin, lineLength);
+        line[lineLength] = '\0';
+
+        if(runLine(line) != 0)
+        { ++failures; }
+
+        if(line != buffer)
+        { delete[] line; }
+    }
+
+    return failures;
+}
+
+void Controller::queueChanged(CVarBase* cvar) noexcept
+{
+    // Only ever pushed to concurrently, the list is taken as a whole, so there is no ABA problem.
+    CVarBase* head = _changedCVars.load(::std::memory_order_relaxed);
+    do
+    {
+        cvar->_nextChanged = head;
+    } while(!_changedCVars.compare_exchange_weak(head, cvar, ::std::memory_order_release, ::std::memory_order_relaxed));
+}
+
+void Controller::flushCVarChanges() noexcept
+{
+    CVarBase* cvar = _changedCVars.exchange(nullptr, ::std::memory_order_acquire);
+
+    while(cvar)
+    {
+        CVarBase* const next = cvar->_nextChanged;
+
+        // Cleared first so that a callback setting the cvar queues it again for the next frame.
+        cvar->_changed.store(false, ::std::memory_order_release);
+
+        if(cvar->_callback)
+        { cvar->_callback(*cvar, cvar->_userParam); }
+
+        cvar = next;
+    }
 }
 
 bool Controller::addAlias(const DynString commandName, const DynString aliasName) noexcept
 {
-    if(_commands.count(commandName))
+    Command* const cc = findCommand(commandName.c_str());
+    if(cc)
     {
-        Command* cc = _commands[commandName];
-        _commands[aliasName] = cc;
+        insertCommand(aliasName.c_str(), findHashCode(aliasName.c_str()), cc);
         return true;
     }
     return false;
@@ -424,18 +630,59 @@ i64 Controller::parseI64(const char* RESTRICT str, ParseIntError* RESTRICT error
 
 f32 Controller::parseF32(const char* RESTRICT str, ParseIntError* RESTRICT error) noexcept
 {
+    VALIDATE(str[0] != '\0', ParseIntError::ZeroLengthStr);
+
+    char* end;
+    const f32 ret = std::strtof(str, &end);
+
+    VALIDATE(end != str && *end == '\0', ParseIntError::InvalidCharacter);
+
     *error = ParseIntError::None;
-    return std::strtof(str, nullptr);
+    return ret;
 }
 
 f64 Controller::parseF64(const char* RESTRICT str, ParseIntError* RESTRICT error) noexcept
 {
+    VALIDATE(str[0] != '\0', ParseIntError::ZeroLengthStr);
+
+    char* end;
+    const f64 ret = std::strtod(str, &end);
+
+    VALIDATE(end != str && *end == '\0', ParseIntError::InvalidCharacter);
+
     *error = ParseIntError::None;
-    return std::strtod(str, nullptr);
+    return ret;
 }
 
 #undef VALIDATE
 
+void CVarBase::markChanged() noexcept
+{
+    // A cvar set before it was registered is queued by Controller::addCVar.
+    if(!_changed.exchange(true, ::std::memory_order_acq_rel) && _controller)
+    { _controller->queueChanged(this); }
+}
+
+i32 CVarBase::execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept
+{
+    if(argCount == 0)
+    {
+        print(consoleHandler);
+        return 0;
+    }
+
+    if(argCount == 1)
+    {
+        if(parse(args[0]))
+        { return 0; }
+
+        consoleHandler->printf("Invalid value `%s` for `%s`.\n", args[0], _name);
+    }
+
+    consoleHandler->printf("Usage: %s\n", usage());
+    return 1;
+}
+
 namespace dc
 {
 i32 BoolAliasCommand::execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept
@@ -600,32 +847,33 @@ i32 ParseNumCommand::execute(const char* commandName, const char* args[], u32 ar
         return -1;
     }
 
-#define PARSE_INT_TYPE(__TYPE, __FUNC, __PRINT_TYPE) \
-        if(streq(args[0], #__TYPE)) \
+    // The case labels are hashed at compile time, a colliding type name would fail to compile.
+#define PARSE_INT_TYPE(__TYPE, __FUNC, __PRINT_TYPE, __CAST) \
+        case cexpr::findHashCode(#__TYPE): \
         { \
+            if(!streq(args[0], #__TYPE)) { break; } \
             ParseIntError error; \
             const __TYPE x = Controller::__FUNC(args[1], &error); \
             if(error != ParseIntError::None) { consoleHandler->printf("Unknown Input: %s\n", args[1]); } \
-            else { consoleHandler->printf(#__TYPE ": " __PRINT_TYPE "\n", x); } \
+            else { consoleHandler->printf(#__TYPE ": " __PRINT_TYPE "\n", static_cast<__CAST>(x)); } \
+            return 0; \
         }
 
-            PARSE_INT_TYPE(i32, parseI32, "%d")
-        else
-            PARSE_INT_TYPE(u32, parseU32, "%u")
-        else
-            PARSE_INT_TYPE(i64, parseI64, "%ll")
-        else
-            PARSE_INT_TYPE(u64, parseU64, "%ull")
-        else
-            PARSE_INT_TYPE(u64, parseF32, "%f")
-        else
-            PARSE_INT_TYPE(u64, parseF64, "%f")
-        else
-        {
-        consoleHandler->printf("Unknown Type: %s\n", args[1]);
-        }
+    switch(findHashCode(args[0]))
+    {
+        PARSE_INT_TYPE(i32, parseI32, "%d", i32)
+        PARSE_INT_TYPE(u32, parseU32, "%u", u32)
+        PARSE_INT_TYPE(i64, parseI64, "%lld", long long)
+        PARSE_INT_TYPE(u64, parseU64, "%llu", unsigned long long)
+        PARSE_INT_TYPE(f32, parseF32, "%f", f64)
+        PARSE_INT_TYPE(f64, parseF64, "%f", f64)
+        default: break;
+    }
 
-        return 0;
+#undef PARSE_INT_TYPE
+
+    consoleHandler->printf("Unknown Type: %s\n", args[0]);
+    return 0;
 }
 
 i32 AliasCommand::execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept
@@ -637,6 +885,33 @@ i32 AliasCommand::execute(const char* commandName, const char* args[], u32 argCo
     return 1;
 }
 
+i32 ExecCommand::execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept
+{
+    if(argCount != 1)
+    {
+        consoleHandler->printf("Usage: %s\n", usage());
+        return 1;
+    }
+
+    const CPPRef<IFile> file = VFS::Instance().openFile(args[0], FileProps::Read);
+    if(!file)
+    {
+        consoleHandler->printf("Failed to open `%s`.\n", args[0]);
+        return -1;
+    }
+
+    // readFile appends a null terminator.
+    const RefDynArray<u8> script = file->readFile();
+    const u32 failures = consoleHandler->runScript(reinterpret_cast<const char*>(script.arr()), script.count() - 1);
+    if(failures)
+    {
+        consoleHandler->printf("%u lines of `%s` failed.\n", failures, args[0]);
+        return -2;
+    }
+
+    return 0;
+}
+
 i32 HelpCommand::execute(const char* commandName, const char* args[], u32 argCount, Controller* consoleHandler) noexcept
 {
     if(argCount == 1)
@@ -32,7 +32,7 @@ ID3DBlob* DXShaderStubGenerator::genShader(const uSys bufferCount, const BufferD
 
             char buf[14];
             genVarName(buf, varIndex++);
-            sb.append(getHLSLTypeName(element.type())).append(buf).append(getDXSemanticName(element.semantic()));
+            sb.append(getHLSLTypeName(ShaderDataType::shaderType(element.type()))).append(buf).append(getDXSemanticName(element.semantic()));
             if(semanticIndice == 0)
             {
                 ++semanticIndice;
@@ -188,6 +188,18 @@ uSys DX10InputLayoutBuilder::computeNumElements(const ShaderDataType::Type type)
         case ShaderDataType::Matrix4x3Double: return 4 * 3;
         case ShaderDataType::Matrix4x4Double: return 4 * 2;
         case ShaderDataType::Double: return 1;
+
+        case ShaderDataType::Vector2Half:
+        case ShaderDataType::Vector4Half:
+        case ShaderDataType::Vector2SNorm8:
+        case ShaderDataType::Vector4SNorm8:
+        case ShaderDataType::Vector2UNorm8:
+        case ShaderDataType::Vector4UNorm8:
+        case ShaderDataType::Vector2SNorm16:
+        case ShaderDataType::Vector4SNorm16:
+        case ShaderDataType::Vector2UNorm16:
+        case ShaderDataType::Vector4UNorm16:
+        case ShaderDataType::Vector4UNorm10_10_10_2: return 1;
         default: break;
     }
     return 0;
@@ -241,6 +253,18 @@ DXGI_FORMAT DX10InputLayoutBuilder::getDXType(const ShaderDataType::Type type) n
         case ShaderDataType::Matrix4x3Double: return DXGI_FORMAT_R32G32_UINT;
         case ShaderDataType::Matrix4x4Double: return DXGI_FORMAT_R32G32B32A32_UINT;
         case ShaderDataType::Double:          return DXGI_FORMAT_R32G32_UINT;
+
+        case ShaderDataType::Vector2Half:            return DXGI_FORMAT_R16G16_FLOAT;
+        case ShaderDataType::Vector4Half:            return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case ShaderDataType::Vector2SNorm8:          return DXGI_FORMAT_R8G8_SNORM;
+        case ShaderDataType::Vector4SNorm8:          return DXGI_FORMAT_R8G8B8A8_SNORM;
+        case ShaderDataType::Vector2UNorm8:          return DXGI_FORMAT_R8G8_UNORM;
+        case ShaderDataType::Vector4UNorm8:          return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case ShaderDataType::Vector2SNorm16:         return DXGI_FORMAT_R16G16_SNORM;
+        case ShaderDataType::Vector4SNorm16:         return DXGI_FORMAT_R16G16B16A16_SNORM;
+        case ShaderDataType::Vector2UNorm16:         return DXGI_FORMAT_R16G16_UNORM;
+        case ShaderDataType::Vector4UNorm16:         return DXGI_FORMAT_R16G16B16A16_UNORM;
+        case ShaderDataType::Vector4UNorm10_10_10_2: return DXGI_FORMAT_R10G10B10A2_UNORM;
         default: break;
     }
     return DXGI_FORMAT_UNKNOWN;
@@ -2,10 +2,11 @@
 
 #ifdef _WIN32
 #include <d3dcompiler.h>
+#include <string_view>
 #include <VFS.hpp>
 #include "dx/dx10/DX10GraphicsInterface.hpp"
 #include "dx/dx10/DX10RenderingContext.hpp"
-#include "shader/bundle/ShaderBundleParser.hpp"
+#include "shader/bundle/ShaderBundleBinary.hpp"
 #include "shader/bundle/ShaderInfoExtractorVisitor.hpp"
 
 void DX10VertexShader::bind(DX10RenderingContext& context) noexcept
@@ -26,6 +27,17 @@ void DX10GeometryShader::unbind(DX10RenderingContext& context) noexcept
 void DX10PixelShader::unbind(DX10RenderingContext& context) noexcept
 { context.d3dDevice()->PSSetShader(nullptr); }
 
+u64 DX10VertexShader::inputSignature() const noexcept
+{
+    ID3DBlob* signature;
+    if(FAILED(D3DGetInputSignatureBlob(_shaderBlob->GetBufferPointer(), _shaderBlob->GetBufferSize(), &signature)))
+    { return ::std::hash<::std::string_view>()(::std::string_view(static_cast<const char*>(_shaderBlob->GetBufferPointer()), _shaderBlob->GetBufferSize())); }
+
+    const u64 hash = ::std::hash<::std::string_view>()(::std::string_view(static_cast<const char*>(signature->GetBufferPointer()), signature->GetBufferSize()));
+    signature->Release();
+    return hash;
+}
+
 NullableRef<IShader> DX10ShaderBuilder::buildTauRef(const ShaderFileArgs& args, Error* const error, TauAllocator& allocator) const noexcept
 {
     DXShaderArgs dxArgs { };
@@ -104,9 +116,7 @@ bool DX10ShaderBuilder::processArgs(const ShaderFileArgs& args, DXShaderArgs* co
 {
     ERROR_CODE_COND_F(!args.file, Error::InvalidFile);
 
-    const WDynString path = args.file->name();
-
-    if(VFS::getFileExt(path, false) == L"tausi")
+    if(ShaderBundleLoader::isBundle(args.file))
     {
         return processBundle(args, dxArgs, error);
     }
@@ -125,13 +135,7 @@ bool DX10ShaderBuilder::processArgs(const ShaderSourceArgs& args, DXShaderArgs*
 
 bool DX10ShaderBuilder::processBundle(const ShaderFileArgs& args, DXShaderArgs* dxArgs, Error* error) const noexcept
 {
-    ShaderBundleParser parser(args.file);
-
-    ShaderBundleParser::Error parseError;
-    auto ast = parser.parse(&parseError);
-
-    _visitor->reset();
-    _visitor->visit(ast.get());
+    ERROR_CODE_COND_F(!ShaderBundleLoader::load(args.file, *_visitor), Error::InvalidFile);
     const sbp::ShaderInfo& info = _visitor->get(args.stage);
 
     const CPPRef<IFile> file = VFS::Instance().openFile(info.fileName, FileProps::Read);
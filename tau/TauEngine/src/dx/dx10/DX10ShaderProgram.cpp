@@ -2,7 +2,7 @@
 
 #ifdef _WIN32
 #include "dx/dx10/DX10Shader.hpp"
-#include "shader/bundle/ShaderBundleParser.hpp"
+#include "shader/bundle/ShaderBundleBinary.hpp"
 #include "shader/bundle/ShaderInfoExtractorVisitor.hpp"
 #include "VFS.hpp"
 #include "dx/dx10/DX10GraphicsInterface.hpp"
@@ -20,14 +20,8 @@ bool DX10ShaderProgramBuilder::processArgs(const ShaderProgramAutoArgs& args, DX
 {
     ERROR_CODE_COND_F(!args.bundleFile, Error::InvalidFile);
 
-    ShaderBundleParser parser(args.bundleFile);
-
-    ShaderBundleParser::Error parseError;
-    auto ast = parser.parse(&parseError);
-
     ShaderInfoExtractorVisitor visitor(RenderingMode::DirectX10);
-
-    visitor.visit(ast.get());
+    ERROR_CODE_COND_F(!ShaderBundleLoader::load(args.bundleFile, visitor), Error::InvalidFile);
 
     for(auto it = visitor.begin(); it != visitor.end(); ++it)
     {
@@ -2,10 +2,11 @@
 
 #ifdef _WIN32
 #include <d3dcompiler.h>
+#include <string_view>
 #include <VFS.hpp>
 #include "dx/dx11/DX11GraphicsInterface.hpp"
 #include "dx/dx11/DX11RenderingContext.hpp"
-#include "shader/bundle/ShaderBundleParser.hpp"
+#include "shader/bundle/ShaderBundleBinary.hpp"
 #include "shader/bundle/ShaderInfoExtractorVisitor.hpp"
 
 void DX11VertexShader::bind(DX11RenderingContext& context) noexcept
@@ -39,6 +40,17 @@ void DX11GeometryShader::unbind(DX11RenderingContext& context) noexcept
 void DX11PixelShader::unbind(DX11RenderingContext& context) noexcept
 { context.d3d11DeviceContext()->PSSetShader(NULL, NULL, 0); }
 
+u64 DX11VertexShader::inputSignature() const noexcept
+{
+    ID3DBlob* signature;
+    if(FAILED(D3DGetInputSignatureBlob(_shaderBlob->GetBufferPointer(), _shaderBlob->GetBufferSize(), &signature)))
+    { return ::std::hash<::std::string_view>()(::std::string_view(static_cast<const char*>(_shaderBlob->GetBufferPointer()), _shaderBlob->GetBufferSize())); }
+
+    const u64 hash = ::std::hash<::std::string_view>()(::std::string_view(static_cast<const char*>(signature->GetBufferPointer()), signature->GetBufferSize()));
+    signature->Release();
+    return hash;
+}
+
 DX11Shader* DX11ShaderBuilder::build(const ShaderArgs& args, Error* const error) const noexcept
 {
     DXShaderArgs dxArgs {};
@@ -248,9 +260,7 @@ bool DX11ShaderBuilder::processArgs(const ShaderArgs& args, DXShaderArgs* const
 {
     ERROR_CODE_COND_F(!args.file, Error::InvalidFile);
 
-    const DynString path = args.file->name();
-
-    if(VFS::getFileExt(path, false) == "tausi")
+    if(ShaderBundleLoader::isBundle(args.file))
     {
         return processBundle(args, dxArgs, error);
     }
@@ -262,13 +272,7 @@ bool DX11ShaderBuilder::processArgs(const ShaderArgs& args, DXShaderArgs* const
 
 bool DX11ShaderBuilder::processBundle(const ShaderArgs& args, DXShaderArgs* dxArgs, Error* error) const noexcept
 {
-    ShaderBundleParser parser(args.file);
-
-    ShaderBundleParser::Error parseError;
-    auto ast = parser.parse(&parseError);
-
-    _visitor->reset();
-    _visitor->visit(ast.get());
+    ERROR_CODE_COND_F(!ShaderBundleLoader::load(args.file, *_visitor), Error::InvalidFile);
     const sbp::ShaderInfo& info = _visitor->get(args.stage);
 
     const CPPRef<IFile> file = VFS::Instance().openFile(info.fileName, FileProps::Read);
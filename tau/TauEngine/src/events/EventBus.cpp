@@ -0,0 +1,266 @@
+#include "events/EventBus.hpp"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#include <thread>
+#pragma warning(pop)
+
+struct EventBus::Chunk final
+{
+    Chunk* next;
+    uSys capacity;
+    ::std::atomic<uSys> used;
+
+    [[nodiscard]] u8* data() noexcept { return reinterpret_cast<u8*>(this) + HeaderSize; }
+
+    static constexpr uSys HeaderSize = (sizeof(Chunk*) + sizeof(uSys) + sizeof(::std::atomic<uSys>) + MaxEventAlignment - 1) & ~(MaxEventAlignment - 1);
+};
+
+EventBus::Chunk* EventBus::createChunk(const uSys capacity, const uSys used) noexcept
+{
+    u8* const memory = new(::std::nothrow) u8[Chunk::HeaderSize + capacity];
+    if(!memory)
+    { return nullptr; }
+
+    Chunk* const chunk = reinterpret_cast<Chunk*>(memory);
+    chunk->next = nullptr;
+    chunk->capacity = capacity;
+    new(&chunk->used) ::std::atomic<uSys>(used);
+    return chunk;
+}
+
+void EventBus::destroyChunks(Chunk* chunk) noexcept
+{
+    while(chunk)
+    {
+        Chunk* const next = chunk->next;
+        delete[] reinterpret_cast<u8*>(chunk);
+        chunk = next;
+    }
+}
+
+EventBus::EventBus() noexcept
+    : _frames{ }
+    , _current(0)
+    , _handlers()
+    , _nodes()
+    , _sorted()
+    , _typeOffsets()
+{
+    for(Frame& frame : _frames)
+    {
+        frame.head.store(nullptr, ::std::memory_order_relaxed);
+        frame.chunk.store(createChunk(ChunkSize, 0), ::std::memory_order_relaxed);
+        frame.writers.store(0, ::std::memory_order_relaxed);
+    }
+}
+
+EventBus::~EventBus() noexcept
+{
+    for(Frame& frame : _frames)
+    {
+        collect(frame);
+        for(Node* const node : _nodes)
+        { node->event->~Event(); }
+        destroyChunks(frame.chunk.load(::std::memory_order_relaxed));
+    }
+}
+
+EventBus::Frame& EventBus::beginPost() noexcept
+{
+    while(true)
+    {
+        /**
+         *   Dispatch stores the new frame index before waiting for
+         * the writers of the old frame to leave. If the index is
+         * still the same after registering as a writer, dispatch
+         * will see this post and wait for it.
+         */
+        const u32 current = _current.load(::std::memory_order_seq_cst);
+        Frame& frame = _frames[current];
+        frame.writers.fetch_add(1, ::std::memory_order_seq_cst);
+        if(_current.load(::std::memory_order_seq_cst) == current)
+        { return frame; }
+        frame.writers.fetch_sub(1, ::std::memory_order_release);
+    }
+}
+
+void EventBus::endPost(Frame& frame) noexcept
+{ frame.writers.fetch_sub(1, ::std::memory_order_release); }
+
+u8* EventBus::allocate(Frame& frame, uSys size) noexcept
+{
+    size = (size + MaxEventAlignment - 1) & ~(MaxEventAlignment - 1);
+
+    Chunk* chunk = frame.chunk.load(::std::memory_order_acquire);
+    while(true)
+    {
+        if(chunk)
+        {
+            const uSys offset = chunk->used.fetch_add(size, ::std::memory_order_relaxed);
+            if(offset + size <= chunk->capacity)
+            { return chunk->data() + offset; }
+        }
+
+        Chunk* const newChunk = createChunk(::std::max(ChunkSize, size), size);
+        if(!newChunk)
+        { return nullptr; }
+        newChunk->next = chunk;
+
+        if(frame.chunk.compare_exchange_strong(chunk, newChunk, ::std::memory_order_acq_rel, ::std::memory_order_acquire))
+        { return newChunk->data(); }
+
+        /**
+         * Another thread installed a chunk first, allocate from that one.
+         */
+        delete[] reinterpret_cast<u8*>(newChunk);
+    }
+}
+
+void EventBus::push(Frame& frame, Node* const node) noexcept
+{
+    Node* head = frame.head.load(::std::memory_order_relaxed);
+    do
+    {
+        node->next = head;
+    } while(!frame.head.compare_exchange_weak(head, node, ::std::memory_order_release, ::std::memory_order_relaxed));
+}
+
+void EventBus::collect(Frame& frame) noexcept
+{
+    _nodes.clear();
+    for(Node* node = frame.head.exchange(nullptr, ::std::memory_order_acquire); node; node = node->next)
+    { _nodes.push_back(node); }
+    ::std::reverse(_nodes.begin(), _nodes.end());
+}
+
+void EventBus::release(Frame& frame) noexcept
+{
+    Chunk* const chunk = frame.chunk.load(::std::memory_order_relaxed);
+    if(!chunk)
+    { return; }
+
+    if(!chunk->next)
+    {
+        chunk->used.store(0, ::std::memory_order_relaxed);
+        return;
+    }
+
+    /**
+     *   The frame outgrew its arena, replace the chunks with a
+     * single one large enough to hold all of them so the next
+     * frame of the same size doesn't have to grow it again.
+     */
+    uSys capacity = 0;
+    for(Chunk* c = chunk; c; c = c->next)
+    { capacity += c->capacity; }
+
+    destroyChunks(chunk);
+    frame.chunk.store(createChunk(capacity, 0), ::std::memory_order_relaxed);
+}
+
+uSys EventBus::dispatch() noexcept
+{
+    const u32 current = _current.load(::std::memory_order_relaxed);
+    Frame& frame = _frames[current];
+    _current.store(current ^ 1, ::std::memory_order_seq_cst);
+
+    while(frame.writers.load(::std::memory_order_acquire) != 0)
+    { ::std::this_thread::yield(); }
+
+    collect(frame);
+    const uSys count = _nodes.size();
+    if(count == 0)
+    {
+        release(frame);
+        return 0;
+    }
+
+    u32 maxIndex = 0;
+    for(const Node* const node : _nodes)
+    { maxIndex = ::std::max(maxIndex, node->typeIndex); }
+
+    /**
+     *   Counting sort by type index, stable so that events of the
+     * same type keep the order they were posted in. After placing
+     * the events `_typeOffsets[i]` is the end of type `i`.
+     */
+    _typeOffsets.assign(maxIndex + 2, 0);
+    for(const Node* const node : _nodes)
+    { ++_typeOffsets[node->typeIndex + 1]; }
+    for(u32 i = 1; i < _typeOffsets.size(); ++i)
+    { _typeOffsets[i] += _typeOffsets[i - 1]; }
+
+    _sorted.resize(count);
+    for(const Node* const node : _nodes)
+    { _sorted[_typeOffsets[node->typeIndex]++] = node->event; }
+
+    const u32 handledTypes = static_cast<u32>(::std::min<uSys>(_handlers.size(), maxIndex + 1));
+    for(u32 type = 0; type < handledTypes; ++type)
+    {
+        const u32 begin = type == 0 ? 0 : _typeOffsets[type - 1];
+        const u32 end = _typeOffsets[type];
+        if(begin == end)
+        { continue; }
+
+        Event* const* const events = _sorted.data() + begin;
+        const uSys typeCount = end - begin;
+
+        /**
+         *   Whether an event can be intercepted is decided by its
+         * class, so it only needs to be asked once per type.
+         */
+        const bool interceptable = events[0]->canBeIntercepted();
+
+        for(const HandlerEntry& entry : _handlers[type])
+        {
+            if(entry.batchHandler)
+            {
+                entry.batchHandler(entry.userParam, events, typeCount);
+            }
+            else if(interceptable)
+            {
+                for(uSys i = 0; i < typeCount; ++i)
+                {
+                    Event& e = *events[i];
+                    if(!e._intercepted)
+                    { e._intercepted = entry.handler(entry.userParam, e); }
+                }
+            }
+            else
+            {
+                for(uSys i = 0; i < typeCount; ++i)
+                { (void) entry.handler(entry.userParam, *events[i]); }
+            }
+        }
+    }
+
+    for(Node* const node : _nodes)
+    { node->event->~Event(); }
+
+    release(frame);
+    return count;
+}
+
+void EventBus::subscribe(const Event::EventType& type, const Handler handler, void* const userParam) noexcept
+{ addHandler(type.index(), { handler, nullptr, userParam }); }
+
+void EventBus::subscribeBatch(const Event::EventType& type, const BatchHandler handler, void* const userParam) noexcept
+{ addHandler(type.index(), { nullptr, handler, userParam }); }
+
+void EventBus::unsubscribe(const void* const userParam) noexcept
+{
+    for(::std::vector<HandlerEntry>& handlers : _handlers)
+    {
+        handlers.erase(::std::remove_if(handlers.begin(), handlers.end(),
+                                        [userParam](const HandlerEntry& entry) { return entry.userParam == userParam; }),
+                       handlers.end());
+    }
+}
+
+void EventBus::addHandler(const u32 typeIndex, const HandlerEntry& entry) noexcept
+{
+    if(typeIndex >= _handlers.size())
+    { _handlers.resize(typeIndex + 1); }
+    _handlers[typeIndex].push_back(entry);
+}
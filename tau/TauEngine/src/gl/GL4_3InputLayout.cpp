@@ -117,7 +117,7 @@ bool GL4_3InputLayoutBuilder::processArgs(const InputLayoutArgs& args, GL4_3Inpu
 
             const GLint size = ShaderDataType::componentCount(uType);
             const GLenum type = getGLType(element.type());
-            const GLboolean normalized = element.normalized() ? GL_TRUE : GL_FALSE;
+            const GLboolean normalized = element.normalized() || ShaderDataType::isNormalized(element.type()) ? GL_TRUE : GL_FALSE;
 
             glArgs->strides[i] = descriptor.stride();
 
@@ -205,6 +205,18 @@ GLenum GL4_3InputLayoutBuilder::getGLType(const ShaderDataType::Type type) noexc
         case ShaderDataType::Matrix4x3Double:
         case ShaderDataType::Matrix4x4Double:
         case ShaderDataType::Double: return GL_DOUBLE;
+
+        case ShaderDataType::Vector2Half:
+        case ShaderDataType::Vector4Half: return GL_HALF_FLOAT;
+        case ShaderDataType::Vector2SNorm8:
+        case ShaderDataType::Vector4SNorm8: return GL_BYTE;
+        case ShaderDataType::Vector2UNorm8:
+        case ShaderDataType::Vector4UNorm8: return GL_UNSIGNED_BYTE;
+        case ShaderDataType::Vector2SNorm16:
+        case ShaderDataType::Vector4SNorm16: return GL_SHORT;
+        case ShaderDataType::Vector2UNorm16:
+        case ShaderDataType::Vector4UNorm16: return GL_UNSIGNED_SHORT;
+        case ShaderDataType::Vector4UNorm10_10_10_2: return GL_UNSIGNED_INT_2_10_10_10_REV;
         default: break;
     }
     return 0;
@@ -32,6 +32,14 @@ void GLCommandQueue::executeCommandLists(uSys count, const ICommandList* const *
     }
 #endif
 
+    /**
+     *   The state manager may have been modified since the last
+     * submission, so nothing is assumed to still be bound.
+     */
+    _blendingStateId = 0;
+    _depthStencilStateId = 0;
+    _rasterizerStateId = 0;
+
     for(uSys i = 0; i < count; ++i)
     {
         executeCommandList(lists[i]);
@@ -132,13 +140,25 @@ void GLCommandQueue::_setPipelineState(const GLCL::CommandSetPipelineState& cmd)
     _currentPipelineState = cmd.pipelineState;
 
     const GLBlendingState* const blendingState = static_cast<const GLBlendingState*>(_currentPipelineState->args().blendingState.get());
-    blendingState->apply(_glStateManager);
+    if(!blendingState->stateId() || blendingState->stateId() != _blendingStateId)
+    {
+        blendingState->apply(_glStateManager);
+        _blendingStateId = blendingState->stateId();
+    }
 
     const GLDepthStencilState* const depthStencilState = static_cast<const GLDepthStencilState*>(_currentPipelineState->args().depthStencilState.get());
-    depthStencilState->apply(_glStateManager);
+    if(!depthStencilState->stateId() || depthStencilState->stateId() != _depthStencilStateId)
+    {
+        depthStencilState->apply(_glStateManager);
+        _depthStencilStateId = depthStencilState->stateId();
+    }
 
     const GLRasterizerState* const rasterizerState = static_cast<const GLRasterizerState*>(_currentPipelineState->args().rasterizerState.get());
-    rasterizerState->apply(_glStateManager);
+    if(!rasterizerState->stateId() || rasterizerState->stateId() != _rasterizerStateId)
+    {
+        rasterizerState->apply(_glStateManager);
+        _rasterizerStateId = rasterizerState->stateId();
+    }
 
     const GLShaderProgram* shaderProgram = _currentPipelineState->args().shaderProgram.get<GLShaderProgram>();
     _glStateManager.bindShaderProgram(shaderProgram->programHandle());
@@ -11,7 +11,7 @@
 
 #include "Timings.hpp"
 #include "gl/GLShader.hpp"
-#include "shader/bundle/ShaderBundleParser.hpp"
+#include "shader/bundle/ShaderBundleBinary.hpp"
 #include "shader/bundle/ShaderInfoExtractorVisitor.hpp"
 
 static bool validateFail(GLuint shaderHandle, const char* type) noexcept;
@@ -234,9 +234,7 @@ bool GLShaderBuilder::processArgs(const ShaderArgs& args, GLShaderArgs* const gl
 	    default: ERROR_CODE_F(Error::InvalidShaderStage);
     }
 
-    const WDynString path = args.file->name();
-
-    if(VFS::getFileExt(path, false) == L"tausi")
+    if(ShaderBundleLoader::isBundle(args.file))
     {
         return processBundle(args, glArgs, glShaderStage, error);
     }
@@ -248,13 +246,7 @@ bool GLShaderBuilder::processArgs(const ShaderArgs& args, GLShaderArgs* const gl
 
 bool GLShaderBuilder::processBundle(const ShaderArgs& args, GLShaderArgs* const glArgs, const GLenum shaderStage, Error* const error) const noexcept
 {
-    ShaderBundleParser parser(args.file);
-
-    ShaderBundleParser::Error parseError;
-    auto ast = parser.parse(&parseError);
-
-    _visitor->reset();
-    _visitor->visit(ast.get());
+    ERROR_CODE_COND_F(!ShaderBundleLoader::load(args.file, *_visitor), Error::InvalidFile);
     const sbp::ShaderInfo& info = _visitor->get(args.stage);
 
     const CPPRef<IFile> file = VFS::Instance().openFile(info.fileName, FileProps::Read);
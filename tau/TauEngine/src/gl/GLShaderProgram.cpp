@@ -4,7 +4,7 @@
 
 #include "gl/GLShader.hpp"
 #include "gl/GLShaderProgram.hpp"
-#include "shader/bundle/ShaderBundleParser.hpp"
+#include "shader/bundle/ShaderBundleBinary.hpp"
 #include "shader/bundle/ShaderInfoExtractorVisitor.hpp"
 
 GLShaderProgram::~GLShaderProgram() noexcept
@@ -29,13 +29,7 @@ static GLenum glShaderStage(EShader::Stage stage) noexcept;
 
 bool GLShaderProgramBuilder::processBundle(const ShaderProgramArgs& args, GLShaderProgramArgs* glArgs, Error* error) noexcept
 {
-    ShaderBundleParser parser(args.bundleFile);
-
-    ShaderBundleParser::Error parseError;
-    auto ast = parser.parse(&parseError);
-
-    _visitor->reset();
-    _visitor->visit(ast.get());
+    ERROR_CODE_COND_F(!ShaderBundleLoader::load(args.bundleFile, *_visitor), Error::InvalidFile);
 
     const GLuint programHandle = glCreateProgram();
 
@@ -157,7 +157,7 @@ bool GLVertexArrayBuilder::processArgs(const VertexArrayArgs& args, GLVertexArra
 
             const GLint size = ShaderDataType::componentCount(uType);
             const GLenum type = GLVertexArray::getGLType(element.type());
-            const GLboolean normalized = element.normalized() ? GL_TRUE : GL_FALSE;
+            const GLboolean normalized = element.normalized() || ShaderDataType::isNormalized(element.type()) ? GL_TRUE : GL_FALSE;
             const GLsizei stride = descriptor.stride();
             const void* pointer = reinterpret_cast<const void*>(offset);
 
@@ -250,6 +250,18 @@ GLenum GLVertexArray::getGLType(const ShaderDataType::Type type) noexcept
         case ShaderDataType::Matrix4x3Double:
         case ShaderDataType::Matrix4x4Double:
         case ShaderDataType::Double: return GL_DOUBLE;
+
+        case ShaderDataType::Vector2Half:
+        case ShaderDataType::Vector4Half: return GL_HALF_FLOAT;
+        case ShaderDataType::Vector2SNorm8:
+        case ShaderDataType::Vector4SNorm8: return GL_BYTE;
+        case ShaderDataType::Vector2UNorm8:
+        case ShaderDataType::Vector4UNorm8: return GL_UNSIGNED_BYTE;
+        case ShaderDataType::Vector2SNorm16:
+        case ShaderDataType::Vector4SNorm16: return GL_SHORT;
+        case ShaderDataType::Vector2UNorm16:
+        case ShaderDataType::Vector4UNorm16: return GL_UNSIGNED_SHORT;
+        case ShaderDataType::Vector4UNorm10_10_10_2: return GL_UNSIGNED_INT_2_10_10_10_REV;
         default: break;
     }
     return 0;
@@ -43,7 +43,18 @@ static bool _dummy(ShaderDataType::Type type) noexcept
         case ShaderDataType::Matrix3x4Double: 
         case ShaderDataType::Matrix4x2Double: 
         case ShaderDataType::Matrix4x3Double: 
-        case ShaderDataType::Matrix4x4Double: return true;
+        case ShaderDataType::Matrix4x4Double: 
+        case ShaderDataType::Vector2Half: 
+        case ShaderDataType::Vector4Half: 
+        case ShaderDataType::Vector2SNorm8: 
+        case ShaderDataType::Vector4SNorm8: 
+        case ShaderDataType::Vector2UNorm8: 
+        case ShaderDataType::Vector4UNorm8: 
+        case ShaderDataType::Vector2SNorm16: 
+        case ShaderDataType::Vector4SNorm16: 
+        case ShaderDataType::Vector2UNorm16: 
+        case ShaderDataType::Vector4UNorm16: 
+        case ShaderDataType::Vector4UNorm10_10_10_2: return true;
         default: return false;
     }
 }
@@ -91,6 +102,17 @@ uSys ShaderDataType::size(const Type type) noexcept
         case Matrix4x2Double: return 4 * 2 * 8;
         case Matrix4x3Double: return 4 * 3 * 8;
         case Matrix4x4Double: return 4 * 4 * 8;
+        case Vector2Half: return 2 * 2;
+        case Vector4Half: return 4 * 2;
+        case Vector2SNorm8: return 2 * 1;
+        case Vector4SNorm8: return 4 * 1;
+        case Vector2UNorm8: return 2 * 1;
+        case Vector4UNorm8: return 4 * 1;
+        case Vector2SNorm16: return 2 * 2;
+        case Vector4SNorm16: return 4 * 2;
+        case Vector2UNorm16: return 2 * 2;
+        case Vector4UNorm16: return 4 * 2;
+        case Vector4UNorm10_10_10_2: return 4;
         default: return 0;
     }
 }
@@ -138,6 +160,17 @@ uSys ShaderDataType::componentCount(const Type type) noexcept
         case Matrix4x2Double: return 4 * 2;
         case Matrix4x3Double: return 4 * 3;
         case Matrix4x4Double: return 4 * 4;
+        case Vector2Half: return 2;
+        case Vector4Half: return 4;
+        case Vector2SNorm8: return 2;
+        case Vector4SNorm8: return 4;
+        case Vector2UNorm8: return 2;
+        case Vector4UNorm8: return 4;
+        case Vector2SNorm16: return 2;
+        case Vector4SNorm16: return 4;
+        case Vector2UNorm16: return 2;
+        case Vector4UNorm16: return 4;
+        case Vector4UNorm10_10_10_2: return 4;
         default: return 0;
     }
 }
@@ -229,7 +262,18 @@ bool ShaderDataType::isVector(const Type type) noexcept
         case Vector4Float: 
         case Vector2Double:
         case Vector3Double:
-        case Vector4Double: return true;
+        case Vector4Double:
+        case Vector2Half:
+        case Vector4Half:
+        case Vector2SNorm8:
+        case Vector4SNorm8:
+        case Vector2UNorm8:
+        case Vector4UNorm8:
+        case Vector2SNorm16:
+        case Vector4SNorm16:
+        case Vector2UNorm16:
+        case Vector4UNorm16:
+        case Vector4UNorm10_10_10_2: return true;
         default: return false;
     }
 }
@@ -356,7 +400,8 @@ bool ShaderDataType::isFloat(const Type type) noexcept
         case Vector2Float:  
         case Vector3Float:  
         case Vector4Float:  
-        case Vector4Double: 
+        case Vector2Half:
+        case Vector4Half:
         case Matrix2x2Float: 
         case Matrix2x3Float: 
         case Matrix2x4Float: 
@@ -410,11 +455,77 @@ bool ShaderDataType::isValidInput(const Type type) noexcept
         case Vector4Float:  
         case Vector2Double: 
         case Vector3Double: 
-        case Vector4Double: return true;
+        case Vector4Double: 
+        case Vector2Half:
+        case Vector4Half:
+        case Vector2SNorm8:
+        case Vector4SNorm8:
+        case Vector2UNorm8:
+        case Vector4UNorm8:
+        case Vector2SNorm16:
+        case Vector4SNorm16:
+        case Vector2UNorm16:
+        case Vector4UNorm16:
+        case Vector4UNorm10_10_10_2: return true;
+        default: return false;
+    }
+}
+
+bool ShaderDataType::isPacked(const Type type) noexcept
+{
+    switch(type)
+    {
+        case Vector2Half:
+        case Vector4Half:
+        case Vector2SNorm8:
+        case Vector4SNorm8:
+        case Vector2UNorm8:
+        case Vector4UNorm8:
+        case Vector2SNorm16:
+        case Vector4SNorm16:
+        case Vector2UNorm16:
+        case Vector4UNorm16:
+        case Vector4UNorm10_10_10_2: return true;
         default: return false;
     }
 }
 
+bool ShaderDataType::isNormalized(const Type type) noexcept
+{
+    switch(type)
+    {
+        case Vector2SNorm8:
+        case Vector4SNorm8:
+        case Vector2UNorm8:
+        case Vector4UNorm8:
+        case Vector2SNorm16:
+        case Vector4SNorm16:
+        case Vector2UNorm16:
+        case Vector4UNorm16:
+        case Vector4UNorm10_10_10_2: return true;
+        default: return false;
+    }
+}
+
+ShaderDataType::Type ShaderDataType::shaderType(const Type type) noexcept
+{
+    switch(type)
+    {
+        case Vector2Half:
+        case Vector2SNorm8:
+        case Vector2UNorm8:
+        case Vector2SNorm16:
+        case Vector2UNorm16: return Type::Vector2Float;
+        case Vector4Half:
+        case Vector4SNorm8:
+        case Vector4UNorm8:
+        case Vector4SNorm16:
+        case Vector4UNorm16:
+        case Vector4UNorm10_10_10_2: return Type::Vector4Float;
+        default: return type;
+    }
+}
+
 ShaderDataType::Type ShaderSemantic::associatedType(const Semantic semantic) noexcept
 {
     switch(semantic)
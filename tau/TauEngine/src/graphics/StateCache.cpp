@@ -0,0 +1,307 @@
+#include "graphics/StateCache.hpp"
+#include "system/GraphicsInterface.hpp"
+#include "shader/Shader.hpp"
+#include <allocator/AllocationTracker.hpp>
+
+#pragma warning(push, 0)
+#include <cstring>
+#pragma warning(pop)
+
+/**
+ *   Ids are shared between every cache, so two states built by
+ * different caches never have the same id.
+ */
+static ::std::atomic<u32> _blendingStateIds(0);
+static ::std::atomic<u32> _depthStencilStateIds(0);
+static ::std::atomic<u32> _rasterizerStateIds(0);
+static ::std::atomic<u32> _inputLayoutIds(0);
+static ::std::atomic<u32> _pipelineStateIds(0);
+
+/**
+ *   Never reused, a pipeline keyed on a released program can't
+ * be returned for a program that takes its address.
+ */
+static ::std::atomic<u64> _shaderProgramIds(0);
+
+/**
+ * Attributes the memory of every interned state to the cache.
+ */
+static TrackedAllocator& stateAllocator() noexcept
+{
+    static TrackedAllocator allocator("StateCache");
+    return allocator;
+}
+
+static u64 hashWords(const ::std::vector<u64>& words) noexcept
+{
+    u64 hash = 0xCBF29CE484222325ull;
+    for(const u64 word : words)
+    {
+        hash ^= word;
+        hash *= 0x00000100000001B3ull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+static inline u64 pointerWord(const void* const ptr) noexcept
+{ return static_cast<u64>(reinterpret_cast<uSys>(ptr)); }
+
+static inline u64 floatWord(const float f) noexcept
+{
+    u32 bits;
+    ::std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+StateCache::StateCache(IBlendingStateBuilder& blendingStateBuilder, IDepthStencilStateBuilder& depthStencilStateBuilder, IRasterizerStateBuilder& rasterizerStateBuilder, IInputLayoutBuilder& inputLayoutBuilder) noexcept
+    : _blendingStateBuilder(blendingStateBuilder)
+    , _depthStencilStateBuilder(depthStencilStateBuilder)
+    , _rasterizerStateBuilder(rasterizerStateBuilder)
+    , _inputLayoutBuilder(inputLayoutBuilder)
+    , _blendingStates()
+    , _depthStencilStates()
+    , _rasterizerStates()
+    , _inputLayouts()
+    , _pipelineStates()
+    , _shaderPrograms()
+    , _stats { 0, 0 }
+{ }
+
+StateCache::StateCache(IGraphicsInterface& gi) noexcept
+    : StateCache(gi.createBlendingState(), gi.createDepthStencilState(), gi.createRasterizerState(), gi.createInputLayout())
+{ }
+
+template<typename _T, typename _Build>
+NullableRef<_T> StateCache::intern(Table<_T>& table, Key&& key, ::std::atomic<u32>& ids, const _Build& build) noexcept
+{
+    const auto it = table.find(key);
+    if(it != table.end())
+    {
+        ++_stats.hits;
+        return it->second;
+    }
+
+    ++_stats.misses;
+
+    NullableRef<_T> state = build();
+    if(!state)
+    { return state; }
+
+    state->_stateId = ids.fetch_add(1, ::std::memory_order_relaxed) + 1;
+    // Without the cast emplace picks the forwarding constructor over the copy constructor.
+    (void) table.emplace(::std::move(key), static_cast<const NullableRef<_T>&>(state));
+    return state;
+}
+
+template<typename _T>
+uSys StateCache::collect(Table<_T>& table) noexcept
+{
+    uSys released = 0;
+    for(auto it = table.begin(); it != table.end();)
+    {
+        if(it->second.refCount() == 1)
+        {
+            it = table.erase(it);
+            ++released;
+        }
+        else
+        { ++it; }
+    }
+    return released;
+}
+
+NullableRef<IBlendingState> StateCache::blendingState(const BlendingArgs& args, IBlendingStateBuilder::Error* const error) noexcept
+{
+    if(error) { *error = IBlendingStateBuilder::Error::NoError; }
+    return intern(_blendingStates, makeKey(args), _blendingStateIds, [&]() { return _blendingStateBuilder.buildTauRef(args, error, stateAllocator()); });
+}
+
+NullableRef<IDepthStencilState> StateCache::depthStencilState(const DepthStencilArgs& args, IDepthStencilStateBuilder::Error* const error) noexcept
+{
+    if(error) { *error = IDepthStencilStateBuilder::Error::NoError; }
+    return intern(_depthStencilStates, makeKey(args), _depthStencilStateIds, [&]() { return _depthStencilStateBuilder.buildTauRef(args, error, stateAllocator()); });
+}
+
+NullableRef<IRasterizerState> StateCache::rasterizerState(const RasterizerArgs& args, IRasterizerStateBuilder::Error* const error) noexcept
+{
+    if(error) { *error = IRasterizerStateBuilder::Error::NoError; }
+    return intern(_rasterizerStates, makeKey(args), _rasterizerStateIds, [&]() { return _rasterizerStateBuilder.buildTauRef(args, error, stateAllocator()); });
+}
+
+NullableRef<IInputLayout> StateCache::inputLayout(const InputLayoutArgs& args, IInputLayoutBuilder::Error* const error) noexcept
+{
+    if(error) { *error = IInputLayoutBuilder::Error::NoError; }
+    return intern(_inputLayouts, makeKey(args), _inputLayoutIds, [&]() { return _inputLayoutBuilder.buildTauRef(args, error, stateAllocator()); });
+}
+
+NullableRef<IPipelineState> StateCache::pipelineState(const PipelineStateBuilder& builder, const PipelineArgs& args, PipelineStateBuilder::Error* const error) noexcept
+{
+    if(error) { *error = PipelineStateBuilder::NoError; }
+    return intern(_pipelineStates, makeKey(args, shaderProgramId(args.shaderProgram)), _pipelineStateIds, [&]() { return builder.build(args, error, stateAllocator()); });
+}
+
+uSys StateCache::collect() noexcept
+{
+    /**
+     *   Pipelines reference the other states, so they have to be
+     * released first for those states to become unreferenced.
+     */
+    uSys released = collect(_pipelineStates);
+    released += collect(_blendingStates);
+    released += collect(_depthStencilStates);
+    released += collect(_rasterizerStates);
+    released += collect(_inputLayouts);
+    return released;
+}
+
+void StateCache::releaseShaderProgram(const ShaderProgram program) noexcept
+{ (void) _shaderPrograms.erase(program.raw); }
+
+void StateCache::clear() noexcept
+{
+    _pipelineStates.clear();
+    _blendingStates.clear();
+    _depthStencilStates.clear();
+    _rasterizerStates.clear();
+    _inputLayouts.clear();
+    _shaderPrograms.clear();
+}
+
+u64 StateCache::shaderProgramId(const ShaderProgram program) noexcept
+{
+    if(!program.raw)
+    { return 0; }
+
+    const auto it = _shaderPrograms.find(program.raw);
+    if(it != _shaderPrograms.end())
+    { return it->second; }
+
+    const u64 id = _shaderProgramIds.fetch_add(1, ::std::memory_order_relaxed) + 1;
+    (void) _shaderPrograms.emplace(program.raw, id);
+    return id;
+}
+
+StateCache::Key StateCache::makeKey(const BlendingArgs& args) noexcept
+{
+    /**
+     *   Without independent blending the backends only use the
+     * first framebuffer, apart from whether blending is enabled.
+     */
+    const uSys described = args.independentBlending ? 8 : 1;
+
+    Key key;
+    key.words.reserve(1 + 8 + described * 6);
+    key.words.push_back(args.independentBlending);
+
+    for(uSys i = 0; i < 8; ++i)
+    { key.words.push_back(args.frameBuffers[i].enableBlending); }
+
+    for(uSys i = 0; i < described; ++i)
+    {
+        const BlendingArgs::FrameBufferBlendingArgs& frameBuffer = args.frameBuffers[i];
+        key.words.push_back(static_cast<u64>(frameBuffer.colorSrcFactor));
+        key.words.push_back(static_cast<u64>(frameBuffer.colorDstFactor));
+        key.words.push_back(static_cast<u64>(frameBuffer.alphaSrcFactor));
+        key.words.push_back(static_cast<u64>(frameBuffer.alphaDstFactor));
+        key.words.push_back(static_cast<u64>(frameBuffer.colorBlendOp));
+        key.words.push_back(static_cast<u64>(frameBuffer.alphaBlendOp));
+    }
+
+    key.hash = hashWords(key.words);
+    return key;
+}
+
+StateCache::Key StateCache::makeKey(const DepthStencilArgs& args) noexcept
+{
+    Key key;
+    key.words = {
+        args.enableDepthTest,
+        args.enableStencilTest,
+        static_cast<u64>(args.depthWriteMask),
+        static_cast<u64>(args.depthCompareFunc),
+        args.stencilReadMask,
+        args.stencilWriteMask,
+        static_cast<u64>(args.frontFace.failOp),
+        static_cast<u64>(args.frontFace.stencilPassDepthFailOp),
+        static_cast<u64>(args.frontFace.passOp),
+        static_cast<u64>(args.frontFace.compareFunc),
+        static_cast<u64>(args.backFace.failOp),
+        static_cast<u64>(args.backFace.stencilPassDepthFailOp),
+        static_cast<u64>(args.backFace.passOp),
+        static_cast<u64>(args.backFace.compareFunc)
+    };
+    key.hash = hashWords(key.words);
+    return key;
+}
+
+StateCache::Key StateCache::makeKey(const RasterizerArgs& args) noexcept
+{
+    Key key;
+    key.words = {
+        args.enableScissorTest,
+        args.frontFaceCounterClockwise,
+        static_cast<u64>(args.cullMode),
+        static_cast<u64>(args.fillMode),
+        static_cast<u64>(args.depthBias),
+        floatWord(args.slopeScaledDepthBias),
+        floatWord(args.depthBiasClamp)
+    };
+    key.hash = hashWords(key.words);
+    return key;
+}
+
+StateCache::Key StateCache::makeKey(const InputLayoutArgs& args) noexcept
+{
+    Key key;
+    /**
+     *   The cache doesn't own the shader, so a later shader can
+     * reuse its address. Key on what the backends validate the
+     * layout against instead of the pointer.
+     */
+    key.words.push_back(args.shader ? static_cast<u64>(args.shader->shaderStage()) + 1 : 0);
+    key.words.push_back(args.shader ? args.shader->inputSignature() : 0);
+    key.words.push_back(args.descriptorCount);
+
+    for(uSys i = 0; i < args.descriptorCount; ++i)
+    {
+        const BufferDescriptor& descriptor = args.descriptors[i];
+        const RefDynArray<BufferElementDescriptor>& elements = descriptor.elements();
+
+        key.words.push_back(descriptor.stride());
+        key.words.push_back(descriptor.instanced());
+        key.words.push_back(elements.count());
+
+        for(uSys j = 0; j < elements.count(); ++j)
+        {
+            const BufferElementDescriptor& element = elements.arr()[j];
+            key.words.push_back(static_cast<u64>(element.semantic()) | (static_cast<u64>(element.type()) << 16) | (static_cast<u64>(element.normalized()) << 32));
+        }
+    }
+
+    key.hash = hashWords(key.words);
+    return key;
+}
+
+StateCache::Key StateCache::makeKey(const PipelineArgs& args, const u64 shaderProgramId) noexcept
+{
+    Key key;
+    key.words = {
+        pointerWord(args.descriptorLayout.get()),
+        pointerWord(args.blendingState.get()),
+        pointerWord(args.depthStencilState.get()),
+        pointerWord(args.rasterizerState.get()),
+        shaderProgramId,
+        pointerWord(args.inputLayout.get()),
+        args.numRenderTargets
+    };
+    key.hash = hashWords(key.words);
+    return key;
+}
+
+StateCache& IGraphicsInterface::stateCache() noexcept
+{
+    if(!_stateCache)
+    { _stateCache = CPPRef<StateCache>(new(::std::nothrow) StateCache(*this)); }
+    return *_stateCache;
+}
@@ -0,0 +1,362 @@
+#include "graphics/VertexQuantization.hpp"
+
+#pragma warning(push, 0)
+#include <smmintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#pragma warning(pop)
+
+static ::std::atomic<bool> _scalarForced(false);
+
+static inline u32 floatBits(const f32 f) noexcept
+{
+    u32 ret;
+    ::std::memcpy(&ret, &f, sizeof(ret));
+    return ret;
+}
+
+static inline f32 bitsFloat(const u32 u) noexcept
+{
+    f32 ret;
+    ::std::memcpy(&ret, &u, sizeof(ret));
+    return ret;
+}
+
+/**
+ *   Loads 4 xyz triplets and transposes them into a register per
+ * component.
+ */
+static inline void loadTriplets(const f32* const src, __m128& x, __m128& y, __m128& z) noexcept
+{
+    const __m128 a = _mm_loadu_ps(src);     // x0 y0 z0 x1
+    const __m128 b = _mm_loadu_ps(src + 4); // y1 z1 x2 y2
+    const __m128 c = _mm_loadu_ps(src + 8); // z2 x3 y3 z3
+
+    const __m128 t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 3, 0)); // x0 x1 y1 x2
+    const __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+    const __m128 v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+
+    x = _mm_shuffle_ps(t, u, _MM_SHUFFLE(2, 0, 1, 0));
+    y = _mm_shuffle_ps(v, u, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(v, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+static inline u16 floatToHalf(const f32 value) noexcept
+{
+    u32 f = floatBits(value);
+    const u32 sign = f & 0x80000000u;
+    f ^= sign;
+
+    u32 ret;
+    if(f >= 0x47800000u)
+    {
+        // Infinity, NaN or too large for a half.
+        ret = f > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    }
+    else if(f < 0x38800000u)
+    {
+        // The half is denormal, let the FPU round the mantissa.
+        ret = floatBits(bitsFloat(f) + 0.5f) - 0x3F000000u;
+    }
+    else
+    {
+        const u32 mantissaOdd = (f >> 13) & 1;
+        f += ((15u - 127u) << 23) + 0xFFFu;
+        f += mantissaOdd;
+        ret = f >> 13;
+    }
+
+    return static_cast<u16>(ret | (sign >> 16));
+}
+
+static inline f32 halfToFloat(const u16 value) noexcept
+{
+    static constexpr u32 ShiftedExponent = 0x7C00u << 13;
+
+    u32 o = (value & 0x7FFFu) << 13;
+    const u32 exponent = o & ShiftedExponent;
+    o += (127u - 15u) << 23;
+
+    if(exponent == ShiftedExponent)
+    { o += (128u - 16u) << 23; }
+    else if(exponent == 0)
+    {
+        o += 1u << 23;
+        o = floatBits(bitsFloat(o) - bitsFloat(113u << 23));
+    }
+
+    return bitsFloat(o | (static_cast<u32>(value & 0x8000u) << 16));
+}
+
+static inline void encodeOctahedral(const f32 x, const f32 y, const f32 z, i16* const dst) noexcept
+{
+    const f32 l1 = (::std::abs(x) + ::std::abs(y)) + ::std::abs(z);
+
+    f32 px = 0.0f;
+    f32 py = 0.0f;
+    if(l1 > 0.0f)
+    {
+        px = x / l1;
+        py = y / l1;
+    }
+
+    if(z < 0.0f)
+    {
+        const f32 fx = (1.0f - ::std::abs(py)) * ::std::copysign(1.0f, px);
+        const f32 fy = (1.0f - ::std::abs(px)) * ::std::copysign(1.0f, py);
+        px = fx;
+        py = fy;
+    }
+
+    dst[0] = static_cast<i16>(::std::lrint(::std::min(::std::max(px, -1.0f), 1.0f) * 32767.0f));
+    dst[1] = static_cast<i16>(::std::lrint(::std::min(::std::max(py, -1.0f), 1.0f) * 32767.0f));
+}
+
+static inline u32 encodeUnitVector(const f32 x, const f32 y, const f32 z) noexcept
+{
+    const u32 qx = static_cast<u32>(::std::lrint(::std::min(::std::max(x * 511.5f + 511.5f, 0.0f), 1023.0f)));
+    const u32 qy = static_cast<u32>(::std::lrint(::std::min(::std::max(y * 511.5f + 511.5f, 0.0f), 1023.0f)));
+    const u32 qz = static_cast<u32>(::std::lrint(::std::min(::std::max(z * 511.5f + 511.5f, 0.0f), 1023.0f)));
+    return qx | (qy << 10) | (qz << 20) | (3u << 30);
+}
+
+static inline u16 quantizeUNorm16(const f32 value, const f32 min, const f32 scale) noexcept
+{ return static_cast<u16>(::std::lrint(::std::min(::std::max((value - min) * scale, 0.0f), 65535.0f))); }
+
+void VertexQuantization::floatToHalf(const f32* const src, u16* const dst, const uSys count) noexcept
+{
+    uSys i = 0;
+    if(!_scalarForced.load(::std::memory_order_relaxed))
+    {
+        const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i rebias = _mm_set1_epi32(static_cast<int>(((15u - 127u) << 23) + 0xFFFu));
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128i halfBits = _mm_set1_epi32(0x3F000000);
+        const __m128i denormalLimit = _mm_set1_epi32(0x38800000);
+        const __m128i overflowLimit = _mm_set1_epi32(0x477FFFFF);
+        const __m128i infinityBits = _mm_set1_epi32(0x7F800000);
+        const __m128i halfInfinity = _mm_set1_epi32(0x7C00);
+        const __m128i halfNaN = _mm_set1_epi32(0x7E00);
+
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i f = _mm_castps_si128(_mm_loadu_ps(src + i));
+            const __m128i sign = _mm_and_si128(f, signMask);
+            f = _mm_xor_si128(f, sign);
+
+            const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(f, 13), one);
+            const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(f, rebias), mantissaOdd), 13);
+            const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(f), half)), halfBits);
+            const __m128i special = _mm_blendv_epi8(halfInfinity, halfNaN, _mm_cmpgt_epi32(f, infinityBits));
+
+            __m128i ret = _mm_blendv_epi8(normal, denormal, _mm_cmplt_epi32(f, denormalLimit));
+            ret = _mm_blendv_epi8(ret, special, _mm_cmpgt_epi32(f, overflowLimit));
+            ret = _mm_or_si128(ret, _mm_srli_epi32(sign, 16));
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi32(ret, ret));
+        }
+    }
+
+    for(; i < count; ++i)
+    { dst[i] = ::floatToHalf(src[i]); }
+}
+
+void VertexQuantization::halfToFloat(const u16* const src, f32* const dst, const uSys count) noexcept
+{
+    uSys i = 0;
+    if(!_scalarForced.load(::std::memory_order_relaxed))
+    {
+        const __m128i magnitudeMask = _mm_set1_epi32(0x7FFF);
+        const __m128i signMask = _mm_set1_epi32(0x8000);
+        const __m128i shiftedExponent = _mm_set1_epi32(0x7C00 << 13);
+        const __m128i rebias = _mm_set1_epi32((127 - 15) << 23);
+        const __m128i infinityRebias = _mm_set1_epi32((128 - 16) << 23);
+        const __m128i denormalBias = _mm_set1_epi32(1 << 23);
+        const __m128 denormalMagic = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128i h = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+
+            __m128i o = _mm_slli_epi32(_mm_and_si128(h, magnitudeMask), 13);
+            const __m128i exponent = _mm_and_si128(o, shiftedExponent);
+            o = _mm_add_epi32(o, rebias);
+            o = _mm_add_epi32(o, _mm_and_si128(_mm_cmpeq_epi32(exponent, shiftedExponent), infinityRebias));
+
+            const __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, denormalBias)), denormalMagic));
+            o = _mm_blendv_epi8(o, denormal, _mm_cmpeq_epi32(exponent, _mm_setzero_si128()));
+            o = _mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, signMask), 16));
+
+            _mm_storeu_ps(dst + i, _mm_castsi128_ps(o));
+        }
+    }
+
+    for(; i < count; ++i)
+    { dst[i] = ::halfToFloat(src[i]); }
+}
+
+void VertexQuantization::encodeOctahedral(const f32* const normals, i16* const dst, const uSys count) noexcept
+{
+    uSys i = 0;
+    if(!_scalarForced.load(::std::memory_order_relaxed))
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 negOne = _mm_set1_ps(-1.0f);
+        const __m128 snormScale = _mm_set1_ps(32767.0f);
+
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128 x, y, z;
+            loadTriplets(normals + i * 3, x, y, z);
+
+            const __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z));
+            const __m128 valid = _mm_cmpgt_ps(l1, _mm_setzero_ps());
+
+            const __m128 px = _mm_and_ps(_mm_div_ps(x, l1), valid);
+            const __m128 py = _mm_and_ps(_mm_div_ps(y, l1), valid);
+
+            const __m128 fx = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, py)), _mm_or_ps(_mm_and_ps(px, signMask), one));
+            const __m128 fy = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, px)), _mm_or_ps(_mm_and_ps(py, signMask), one));
+
+            const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+            const __m128 ox = _mm_blendv_ps(px, fx, lower);
+            const __m128 oy = _mm_blendv_ps(py, fy, lower);
+
+            const __m128i qx = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ox, negOne), one), snormScale));
+            const __m128i qy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(oy, negOne), one), snormScale));
+
+            const __m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(qx, qy), _mm_unpackhi_epi32(qx, qy));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), packed);
+        }
+    }
+
+    for(; i < count; ++i)
+    { ::encodeOctahedral(normals[i * 3 + 0], normals[i * 3 + 1], normals[i * 3 + 2], dst + i * 2); }
+}
+
+void VertexQuantization::decodeOctahedral(const i16* const src, f32* const normals, const uSys count) noexcept
+{
+    for(uSys i = 0; i < count; ++i)
+    {
+        f32 x = ::std::max(static_cast<f32>(src[i * 2 + 0]) / 32767.0f, -1.0f);
+        f32 y = ::std::max(static_cast<f32>(src[i * 2 + 1]) / 32767.0f, -1.0f);
+        const f32 z = 1.0f - ::std::abs(x) - ::std::abs(y);
+
+        if(z < 0.0f)
+        {
+            const f32 fx = (1.0f - ::std::abs(y)) * ::std::copysign(1.0f, x);
+            const f32 fy = (1.0f - ::std::abs(x)) * ::std::copysign(1.0f, y);
+            x = fx;
+            y = fy;
+        }
+
+        const f32 length = ::std::sqrt(x * x + y * y + z * z);
+        normals[i * 3 + 0] = x / length;
+        normals[i * 3 + 1] = y / length;
+        normals[i * 3 + 2] = z / length;
+    }
+}
+
+void VertexQuantization::encodeUnitVectors(const f32* const vectors, u32* const dst, const uSys count) noexcept
+{
+    uSys i = 0;
+    if(!_scalarForced.load(::std::memory_order_relaxed))
+    {
+        const __m128 half = _mm_set1_ps(511.5f);
+        const __m128 max = _mm_set1_ps(1023.0f);
+        const __m128i w = _mm_set1_epi32(static_cast<int>(3u << 30));
+
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128 x, y, z;
+            loadTriplets(vectors + i * 3, x, y, z);
+
+            const __m128i qx = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(x, half), half), _mm_setzero_ps()), max));
+            const __m128i qy = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(y, half), half), _mm_setzero_ps()), max));
+            const __m128i qz = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(z, half), half), _mm_setzero_ps()), max));
+
+            const __m128i packed = _mm_or_si128(_mm_or_si128(qx, _mm_slli_epi32(qy, 10)), _mm_or_si128(_mm_slli_epi32(qz, 20), w));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+    }
+
+    for(; i < count; ++i)
+    { dst[i] = encodeUnitVector(vectors[i * 3 + 0], vectors[i * 3 + 1], vectors[i * 3 + 2]); }
+}
+
+void VertexQuantization::computeBounds(const f32* const src, const uSys count, const uSys components, f32* const min, f32* const max) noexcept
+{
+    for(uSys c = 0; c < components; ++c)
+    {
+        min[c] = count ? src[c] : 0.0f;
+        max[c] = min[c];
+    }
+
+    for(uSys i = 1; i < count; ++i)
+    {
+        for(uSys c = 0; c < components; ++c)
+        {
+            min[c] = ::std::min(min[c], src[i * components + c]);
+            max[c] = ::std::max(max[c], src[i * components + c]);
+        }
+    }
+}
+
+void VertexQuantization::quantizeUNorm16(const f32* const src, u16* const dst, const uSys count, const uSys components, const f32* const min, const f32* const max) noexcept
+{
+    if(components == 0 || components > 4)
+    { return; }
+
+    /**
+     *   The bounds are repeated over 12 floats, which holds a whole
+     * number of vectors of every size, so the SIMD loop works on
+     * the flattened array without caring where vectors start.
+     */
+    alignas(16) f32 mins[12];
+    alignas(16) f32 scales[12];
+    for(uSys i = 0; i < 12; ++i)
+    {
+        const uSys c = i % components;
+        mins[i] = min[c];
+        scales[i] = max[c] > min[c] ? 65535.0f / (max[c] - min[c]) : 0.0f;
+    }
+
+    const uSys total = count * components;
+    uSys i = 0;
+    if(!_scalarForced.load(::std::memory_order_relaxed))
+    {
+        const __m128 upper = _mm_set1_ps(65535.0f);
+        __m128 m[3], s[3];
+        for(uSys j = 0; j < 3; ++j)
+        {
+            m[j] = _mm_load_ps(mins + j * 4);
+            s[j] = _mm_load_ps(scales + j * 4);
+        }
+
+        for(; i + 12 <= total; i += 12)
+        {
+            __m128i q[3];
+            for(uSys j = 0; j < 3; ++j)
+            {
+                const __m128 v = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(src + i + j * 4), m[j]), s[j]);
+                q[j] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), upper));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi32(q[0], q[1]));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i + 8), _mm_packus_epi32(q[2], q[2]));
+        }
+    }
+
+    for(; i < total; ++i)
+    { dst[i] = ::quantizeUNorm16(src[i], mins[i % 12], scales[i % 12]); }
+}
+
+void VertexQuantization::forceScalar(const bool scalar) noexcept
+{ _scalarForced.store(scalar, ::std::memory_order_relaxed); }
+
+bool VertexQuantization::scalarForced() noexcept
+{ return _scalarForced.load(::std::memory_order_relaxed); }
@@ -0,0 +1,105 @@
+#include "maths/Frustum.hpp"
+
+#pragma warning(push, 0)
+#include <emmintrin.h>
+#include <cfloat>
+#include <cmath>
+#pragma warning(pop)
+
+Frustum::Frustum() noexcept
+{
+    for(uSys i = 0; i < PADDED_PLANE_COUNT; ++i)
+    {
+        _normalX[i] = 0.0f;
+        _normalY[i] = 0.0f;
+        _normalZ[i] = 0.0f;
+        _distance[i] = FLT_MAX;
+    }
+}
+
+Frustum::Frustum(const glm::mat4& viewProjection) noexcept
+    : Frustum()
+{
+    /**
+     *   Gribb and Hartmann, each plane is the sum or difference
+     * of the last row and one of the others. glm is column major
+     * so the rows are read across the columns.
+     */
+    const auto row = [&viewProjection](const uSys index, const float sign, float* const plane)
+    {
+        for(uSys i = 0; i < 4; ++i)
+        { plane[i] = viewProjection[i][3] + sign * viewProjection[i][index]; }
+    };
+
+    float planes[PLANE_COUNT][4];
+    row(0,  1.0f, planes[Left]);
+    row(0, -1.0f, planes[Right]);
+    row(1,  1.0f, planes[Bottom]);
+    row(1, -1.0f, planes[Top]);
+    row(2,  1.0f, planes[Near]);
+    row(2, -1.0f, planes[Far]);
+
+    for(uSys i = 0; i < PLANE_COUNT; ++i)
+    {
+        const float length = ::std::sqrt(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+        const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+        _normalX[i] = planes[i][0] * invLength;
+        _normalY[i] = planes[i][1] * invLength;
+        _normalZ[i] = planes[i][2] * invLength;
+        _distance[i] = length > 0.0f ? planes[i][3] * invLength : FLT_MAX;
+    }
+}
+
+static inline __m128 abs4(const __m128 x) noexcept
+{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), x); }
+
+Frustum::Result Frustum::classify(const BoundingBox& box) const noexcept
+{
+    const __m128 cx = _mm_set1_ps(box.center.x());
+    const __m128 cy = _mm_set1_ps(box.center.y());
+    const __m128 cz = _mm_set1_ps(box.center.z());
+    const __m128 ex = _mm_set1_ps(box.extent.x());
+    const __m128 ey = _mm_set1_ps(box.extent.y());
+    const __m128 ez = _mm_set1_ps(box.extent.z());
+
+    int outside = 0;
+    int inside = 0xFF;
+    for(uSys i = 0; i < PADDED_PLANE_COUNT; i += 4)
+    {
+        const __m128 nx = _mm_load_ps(_normalX + i);
+        const __m128 ny = _mm_load_ps(_normalY + i);
+        const __m128 nz = _mm_load_ps(_normalZ + i);
+        const __m128 d = _mm_load_ps(_distance + i);
+
+        const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), d));
+        const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs4(nx), ex), _mm_mul_ps(abs4(ny), ey)), _mm_mul_ps(abs4(nz), ez));
+
+        // Written so that a NaN box ends up outside.
+        outside |= _mm_movemask_ps(_mm_cmpnge_ps(dist, _mm_sub_ps(_mm_setzero_ps(), radius))) << i;
+        inside &= (_mm_movemask_ps(_mm_cmpge_ps(dist, radius)) << i) | ~(0xF << i);
+    }
+
+    if(outside)
+    { return Result::Outside; }
+    return inside == 0xFF ? Result::Inside : Result::Intersecting;
+}
+
+bool Frustum::intersects(const BoundingBox& box) const noexcept
+{ return classify(box) != Result::Outside; }
+
+bool Frustum::intersects(const BoundingSphere& sphere) const noexcept
+{
+    const __m128 cx = _mm_set1_ps(sphere.center.x());
+    const __m128 cy = _mm_set1_ps(sphere.center.y());
+    const __m128 cz = _mm_set1_ps(sphere.center.z());
+    const __m128 negRadius = _mm_set1_ps(-sphere.radius);
+
+    int outside = 0;
+    for(uSys i = 0; i < PADDED_PLANE_COUNT; i += 4)
+    {
+        const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(_normalX + i), cx), _mm_mul_ps(_mm_load_ps(_normalY + i), cy)),
+                                       _mm_add_ps(_mm_mul_ps(_mm_load_ps(_normalZ + i), cz), _mm_load_ps(_distance + i)));
+        outside |= _mm_movemask_ps(_mm_cmpnge_ps(dist, negRadius));
+    }
+    return !outside;
+}
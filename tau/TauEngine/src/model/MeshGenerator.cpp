@@ -1,4 +1,5 @@
 #include "model/MeshGenerator.hpp"
+#include "graphics/VertexQuantization.hpp"
 #include <cstring>
 
 static bool triangleEquals(MeshGenerator::Triangle& a, MeshGenerator::Triangle& b) noexcept;
@@ -127,6 +128,103 @@ MeshGenerator::Mesh MeshGenerator::generateMesh(const EditableMesh& mesh, const
     return Mesh{ totalVertices, vertexCount, positionsRet, normalsRet, null, null, texturesRet, indices };
 }
 
+MeshGenerator::QuantizedMesh MeshGenerator::quantizeMesh(const Mesh& mesh) noexcept
+{
+    const uSys vertexCount = mesh.vertexCount;
+    const bool hasTangents = mesh.tangents != null;
+    const bool hasTextures = mesh.textures != null;
+
+    BufferDescriptorBuilder builder(2 + (hasTangents ? 1 : 0) + (hasTextures ? 1 : 0), false);
+    builder.addDescriptor(ShaderSemantic::Position, ShaderDataType::Vector4UNorm16);
+    builder.addDescriptor(ShaderSemantic::Normal, ShaderDataType::Vector2SNorm16);
+    if(hasTangents)
+    { builder.addDescriptor(ShaderSemantic::Tangent, ShaderDataType::Vector4UNorm10_10_10_2); }
+    if(hasTextures)
+    { builder.addDescriptor(ShaderSemantic::TextureCoord, ShaderDataType::Vector2UNorm16); }
+
+    QuantizedMesh ret { 0, 0, null, null, builder.build(), { }, { }, { }, { } };
+    const uSys stride = ret.descriptor.stride();
+    const auto& elements = ret.descriptor.elements();
+
+    /**
+     *   The converters write packed arrays of each attribute into
+     * scratch, which are then interleaved.
+     */
+    const uSys positionsSize = vertexCount * 3 * sizeof(u16);
+    const uSys normalsSize = vertexCount * 2 * sizeof(i16);
+    const uSys tangentsSize = hasTangents ? vertexCount * sizeof(u32) : 0;
+    const uSys texturesSize = hasTextures ? vertexCount * 2 * sizeof(u16) : 0;
+
+    u8* const scratch = new(::std::nothrow) u8[positionsSize + normalsSize + tangentsSize + texturesSize];
+    ret.vertices = new(::std::nothrow) u8[vertexCount * stride];
+    ret.indices = new(::std::nothrow) u32[mesh.indiceCount];
+
+    if(!scratch || !ret.vertices || !ret.indices)
+    {
+        delete[] scratch;
+        ret.destroy();
+        return ret;
+    }
+
+    ret.vertexCount = vertexCount;
+    ret.indiceCount = mesh.indiceCount;
+    ::std::memcpy(ret.indices, mesh.indices, mesh.indiceCount * sizeof(u32));
+
+    // Tangents go first to keep them 4 byte aligned.
+    u32* const tangents = reinterpret_cast<u32*>(scratch);
+    u16* const positions = reinterpret_cast<u16*>(scratch + tangentsSize);
+    i16* const normals = reinterpret_cast<i16*>(scratch + tangentsSize + positionsSize);
+    u16* const textures = reinterpret_cast<u16*>(scratch + tangentsSize + positionsSize + normalsSize);
+
+    float min[3];
+    float max[3];
+    VertexQuantization::computeBounds(mesh.positions, vertexCount, 3, min, max);
+    VertexQuantization::quantizeUNorm16(mesh.positions, positions, vertexCount, 3, min, max);
+    for(uSys i = 0; i < 3; ++i)
+    {
+        ret.positionOffset[i] = min[i];
+        ret.positionScale[i] = max[i] - min[i];
+    }
+
+    VertexQuantization::encodeOctahedral(mesh.normals, normals, vertexCount);
+
+    if(hasTangents)
+    { VertexQuantization::encodeUnitVectors(mesh.tangents, tangents, vertexCount); }
+
+    if(hasTextures)
+    {
+        VertexQuantization::computeBounds(mesh.textures, vertexCount, 2, min, max);
+        VertexQuantization::quantizeUNorm16(mesh.textures, textures, vertexCount, 2, min, max);
+        for(uSys i = 0; i < 2; ++i)
+        {
+            ret.textureOffset[i] = min[i];
+            ret.textureScale[i] = max[i] - min[i];
+        }
+    }
+
+    const uSys normalOffset = elements[1].offset();
+    const uSys tangentOffset = hasTangents ? elements[2].offset() : 0;
+    const uSys textureOffset = hasTextures ? elements[elements.count() - 1].offset() : 0;
+    static constexpr u16 PositionW = 0xFFFF;
+
+    for(uSys i = 0; i < vertexCount; ++i)
+    {
+        u8* const vertex = ret.vertices + i * stride;
+        ::std::memcpy(vertex, positions + i * 3, 3 * sizeof(u16));
+        ::std::memcpy(vertex + 3 * sizeof(u16), &PositionW, sizeof(u16));
+        ::std::memcpy(vertex + normalOffset, normals + i * 2, 2 * sizeof(i16));
+
+        if(hasTangents)
+        { ::std::memcpy(vertex + tangentOffset, tangents + i, sizeof(u32)); }
+        if(hasTextures)
+        { ::std::memcpy(vertex + textureOffset, textures + i * 2, 2 * sizeof(u16)); }
+    }
+
+    delete[] scratch;
+
+    return ret;
+}
+
 MeshGenerator::EditableMesh MeshGenerator::generateCube() noexcept
 {
     EditableMesh ret{ 6, 0, new(::std::nothrow) Square[6], null };
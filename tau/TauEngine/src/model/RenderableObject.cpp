@@ -8,13 +8,16 @@
 #include "VFS.hpp"
 #include "graphics/RasterizerState.hpp"
 #include "system/GraphicsInterface.hpp"
+#include "graphics/StateCache.hpp"
 #include <glm/vec4.hpp>
+#include <algorithm>
+#include <cmath>
 
 NullableRef<IRasterizerState> RenderableObject::cwRS = nullptr;
 NullableRef<IRasterizerState> RenderableObject::ccwRS = nullptr;
 
 RenderableObject::RenderableObject(IGraphicsInterface& gi, IRenderingContext& context, const objl::Mesh& mesh, const char* materialFolder, const CPPRef<IShader>& shader, bool counterClockwise, const DrawType drawType) noexcept
-    : _va(null), _rs(cwRS)
+    : _va(null), _rs(cwRS), _boundingRadius(0.0f)
 {
     PERF();
     const size_t cnt1 = mesh.vertices.size();
@@ -31,8 +34,18 @@ RenderableObject::RenderableObject(IGraphicsInterface& gi, IRenderingContext& co
     u32 texIndex = 0;
     u32 tanIndex = 0;
 
+    float minPos[3] = {  INFINITY,  INFINITY,  INFINITY };
+    float maxPos[3] = { -INFINITY, -INFINITY, -INFINITY };
+
     for(objl::Vertex vertex : mesh.vertices)
     {
+        minPos[0] = ::std::min(minPos[0], vertex.position.x());
+        minPos[1] = ::std::min(minPos[1], vertex.position.y());
+        minPos[2] = ::std::min(minPos[2], vertex.position.z());
+        maxPos[0] = ::std::max(maxPos[0], vertex.position.x());
+        maxPos[1] = ::std::max(maxPos[1], vertex.position.y());
+        maxPos[2] = ::std::max(maxPos[2], vertex.position.z());
+
         positionsLoaded[posIndex++] = vertex.position.x();
         positionsLoaded[posIndex++] = vertex.position.y();
         positionsLoaded[posIndex++] = vertex.position.z();
@@ -49,6 +62,21 @@ RenderableObject::RenderableObject(IGraphicsInterface& gi, IRenderingContext& co
         texturesLoaded[texIndex++] = vertex.textureCoordinate.y();
     }
 
+    if(cnt1)
+    {
+        _bounds = BoundingBox::fromMinMax(Vector3f(minPos[0], minPos[1], minPos[2]), Vector3f(maxPos[0], maxPos[1], maxPos[2]));
+
+        float radiusSq = 0.0f;
+        for(uSys i = 0; i < cnt3; i += 3)
+        {
+            const float dx = positionsLoaded[i + 0] - _bounds.center.x();
+            const float dy = positionsLoaded[i + 1] - _bounds.center.y();
+            const float dz = positionsLoaded[i + 2] - _bounds.center.z();
+            radiusSq = ::std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+        }
+        _boundingRadius = ::std::sqrt(radiusSq);
+    }
+
     VertexBufferArgs pnBuilder(1);
     VertexBufferArgs texturesBuilder(1);
     IndexBufferArgs indicesBuilder;
@@ -155,7 +183,7 @@ RenderableObject::RenderableObject(IGraphicsInterface& gi, IRenderingContext& co
             else
             {
                 rArgs.frontFaceCounterClockwise = true;
-                ccwRS = gi.createRasterizerState().buildTauRef(rArgs, null);
+                ccwRS = gi.stateCache().rasterizerState(rArgs);
             }
         }
 
@@ -173,7 +201,7 @@ RenderableObject::RenderableObject(IGraphicsInterface& gi, IRenderingContext& co
             else
             {
                 rArgs.frontFaceCounterClockwise = false;
-                cwRS = gi.createRasterizerState().buildTauRef(rArgs, null);
+                cwRS = gi.stateCache().rasterizerState(rArgs);
             }
         }
 
@@ -5,6 +5,7 @@
 #include <maths/Maths.hpp>
 #include <model/OBJLoader.hpp>
 #include <memory>
+#include <allocator/LinearAllocator.hpp>
 #include "VFS.hpp"
 #include "Timings.hpp"
 
@@ -156,7 +157,9 @@ namespace objl
 
             const size_t len = strlen(in);
 
-            char* temp = new(std::nothrow) char[len + 1];
+            // Only lives for this call, so it comes off of the thread's scratch stack instead of the heap.
+            ScratchScope scratch;
+            char* temp = scratch.allocateArray<char>(len + 1);
             if(!temp) { return; }
             char* tempIndex = temp;
 
@@ -185,8 +188,6 @@ namespace objl
 
             *tempIndex = '\0';
             out.emplace_back(temp);
-
-            delete[] temp;
         }
 
         const char* tail(const char* in) noexcept
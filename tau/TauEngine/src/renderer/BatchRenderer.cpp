@@ -9,6 +9,7 @@
 #include "graphics/DepthStencilState.hpp"
 #include "graphics/RasterizerState.hpp"
 #include "graphics/InputLayout.hpp"
+#include "graphics/StateCache.hpp"
 #include "graphics/DescriptorHeap.hpp"
 #include <glm/mat3x3.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -108,19 +109,19 @@ void BatchRenderer::init(IGraphicsInterface& gi, ICommandList& cmdList) noexcept
         {
             BlendingArgs args(tau::Recommended);
             IBlendingStateBuilder::Error error;
-            blendingState = gi.createBlendingState().buildTauRef(args, &error);
+            blendingState = gi.stateCache().blendingState(args, &error);
         }
 
         {
             DepthStencilArgs args(tau::Recommended);
             IDepthStencilStateBuilder::Error error;
-            depthStencilState = gi.createDepthStencilState().buildTauRef(args, &error);
+            depthStencilState = gi.stateCache().depthStencilState(args, &error);
         }
 
         {
             RasterizerArgs args(tau::Recommended);
             IRasterizerStateBuilder::Error error;
-            rasterizerState = gi.createRasterizerState().buildTauRef(args, &error);
+            rasterizerState = gi.stateCache().rasterizerState(args, &error);
         }
 
         {
@@ -143,7 +144,7 @@ void BatchRenderer::init(IGraphicsInterface& gi, ICommandList& cmdList) noexcept
             args.descriptors = descriptors;
 
             IInputLayoutBuilder::Error error;
-            inputLayout = gi.createInputLayout().buildTauRef(args, &error);
+            inputLayout = gi.stateCache().inputLayout(args, &error);
         }
 
         PipelineArgs args;
@@ -0,0 +1,624 @@
+#include "renderer/CullingBVH.hpp"
+
+#pragma warning(push, 0)
+#include <emmintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <list>
+#pragma warning(pop)
+
+/**
+ *   Removed objects are given an inverted box. The plane tests
+ * always reject it, and when merged into a node's bounds it is
+ * the identity, so it never needs to be special cased.
+ */
+static constexpr float REMOVED_EXTENT = -1.0e30f;
+
+static u32 nodeCountFor(const u32 count) noexcept
+{
+    if(count <= CullingBVH::LEAF_SIZE)
+    { return 1; }
+    const u32 half = count / 2;
+    return 1 + nodeCountFor(half) + nodeCountFor(count - half);
+}
+
+CullingBVH::CullingBVH() noexcept
+    : _treeCount(0)
+    , _removedCount(0)
+    , _treeletDepth(0)
+    , _moved(false)
+{ }
+
+void CullingBVH::setBounds(const u32 slot, const BoundingBox& box, const float radius) noexcept
+{
+    _centerX[slot] = box.center.x();
+    _centerY[slot] = box.center.y();
+    _centerZ[slot] = box.center.z();
+    _extentX[slot] = box.extent.x();
+    _extentY[slot] = box.extent.y();
+    _extentZ[slot] = box.extent.z();
+    _radius[slot] = ::std::min(radius, box.extent.length());
+}
+
+CullingBVH::Proxy CullingBVH::insert(const BoundingBox& box, const u32 userId) noexcept
+{ return insert(box, box.extent.length(), userId); }
+
+CullingBVH::Proxy CullingBVH::insert(const BoundingBox& box, const float radius, const u32 userId) noexcept
+{
+    Proxy proxy;
+    if(_freeProxies.empty())
+    {
+        proxy = static_cast<Proxy>(_slots.size());
+        _slots.push_back(0);
+    }
+    else
+    {
+        proxy = _freeProxies.back();
+        _freeProxies.pop_back();
+    }
+
+    const u32 slot = static_cast<u32>(_proxies.size());
+    _slots[proxy] = slot;
+
+    _centerX.push_back(0.0f);
+    _centerY.push_back(0.0f);
+    _centerZ.push_back(0.0f);
+    _extentX.push_back(0.0f);
+    _extentY.push_back(0.0f);
+    _extentZ.push_back(0.0f);
+    _radius.push_back(0.0f);
+    _userId.push_back(userId);
+    _proxies.push_back(proxy);
+
+    setBounds(slot, box, radius);
+    return proxy;
+}
+
+void CullingBVH::update(const Proxy proxy, const BoundingBox& box) noexcept
+{ update(proxy, box, box.extent.length()); }
+
+void CullingBVH::update(const Proxy proxy, const BoundingBox& box, const float radius) noexcept
+{
+    const u32 slot = _slots[proxy];
+    setBounds(slot, box, radius);
+
+    if(slot < _treeCount)
+    {
+        treeletOf(slot)->dirty = true;
+        _moved = true;
+    }
+}
+
+void CullingBVH::remove(const Proxy proxy) noexcept
+{
+    const u32 slot = _slots[proxy];
+    _centerX[slot] = 0.0f;
+    _centerY[slot] = 0.0f;
+    _centerZ[slot] = 0.0f;
+    _extentX[slot] = REMOVED_EXTENT;
+    _extentY[slot] = REMOVED_EXTENT;
+    _extentZ[slot] = REMOVED_EXTENT;
+    _radius[slot] = REMOVED_EXTENT;
+    _proxies[slot] = INVALID_PROXY;
+    _freeProxies.push_back(proxy);
+    ++_removedCount;
+
+    if(slot < _treeCount)
+    {
+        treeletOf(slot)->dirty = true;
+        _moved = true;
+    }
+}
+
+CullingBVH::Treelet* CullingBVH::treeletOf(const u32 slot) noexcept
+{
+    // Treelets are built left to right, so they are sorted by their first object.
+    const auto it = ::std::upper_bound(_treelets.begin(), _treelets.end(), slot, [](const u32 s, const Treelet& treelet) { return s < treelet.first; });
+    return &*(it - 1);
+}
+
+void CullingBVH::swapSlots(const u32 a, const u32 b) noexcept
+{
+    ::std::swap(_centerX[a], _centerX[b]);
+    ::std::swap(_centerY[a], _centerY[b]);
+    ::std::swap(_centerZ[a], _centerZ[b]);
+    ::std::swap(_extentX[a], _extentX[b]);
+    ::std::swap(_extentY[a], _extentY[b]);
+    ::std::swap(_extentZ[a], _extentZ[b]);
+    ::std::swap(_radius[a], _radius[b]);
+    ::std::swap(_userId[a], _userId[b]);
+    ::std::swap(_proxies[a], _proxies[b]);
+
+    if(_proxies[a] != INVALID_PROXY)
+    { _slots[_proxies[a]] = a; }
+    if(_proxies[b] != INVALID_PROXY)
+    { _slots[_proxies[b]] = b; }
+}
+
+void CullingBVH::rebuild() noexcept
+{
+    u32 write = 0;
+    for(u32 read = 0; read < _proxies.size(); ++read)
+    {
+        if(_proxies[read] == INVALID_PROXY)
+        { continue; }
+
+        _centerX[write] = _centerX[read];
+        _centerY[write] = _centerY[read];
+        _centerZ[write] = _centerZ[read];
+        _extentX[write] = _extentX[read];
+        _extentY[write] = _extentY[read];
+        _extentZ[write] = _extentZ[read];
+        _radius[write] = _radius[read];
+        _userId[write] = _userId[read];
+        _proxies[write] = _proxies[read];
+        _slots[_proxies[write]] = write;
+        ++write;
+    }
+
+    _centerX.resize(write);
+    _centerY.resize(write);
+    _centerZ.resize(write);
+    _extentX.resize(write);
+    _extentY.resize(write);
+    _extentZ.resize(write);
+    _radius.resize(write);
+    _userId.resize(write);
+    _proxies.resize(write);
+
+    _treeCount = write;
+    _removedCount = 0;
+    _moved = false;
+
+    _treeletDepth = 0;
+    while((_treeCount >> _treeletDepth) > TREELET_SIZE)
+    { ++_treeletDepth; }
+
+    _treelets.clear();
+    _topNodes.clear();
+    _nodes.clear();
+
+    if(_treeCount == 0)
+    { return; }
+
+    _nodes.resize(nodeCountFor(_treeCount));
+    (void) build(0, 0, _treeCount, 0, true);
+
+    for(Treelet& treelet : _treelets)
+    { treelet.builtCost = treeletCost(treelet); }
+}
+
+u32 CullingBVH::build(const u32 node, const u32 first, const u32 count, const u32 depth, const bool topLevel) noexcept
+{
+    if(topLevel)
+    {
+        if(depth == _treeletDepth || count <= LEAF_SIZE)
+        {
+            const u32 end = build(node, first, count, depth, false);
+            _treelets.push_back({ node, end - node, first, count, 0.0f, false });
+            return end;
+        }
+        _topNodes.push_back(node);
+    }
+
+    if(count <= LEAF_SIZE)
+    {
+        _nodes[node].index = first;
+        _nodes[node].count = count;
+        fitLeaf(_nodes[node]);
+        return node + 1;
+    }
+
+    float minC[3] = {  INFINITY,  INFINITY,  INFINITY };
+    float maxC[3] = { -INFINITY, -INFINITY, -INFINITY };
+    for(u32 i = first; i < first + count; ++i)
+    {
+        minC[0] = ::std::min(minC[0], _centerX[i]);
+        minC[1] = ::std::min(minC[1], _centerY[i]);
+        minC[2] = ::std::min(minC[2], _centerZ[i]);
+        maxC[0] = ::std::max(maxC[0], _centerX[i]);
+        maxC[1] = ::std::max(maxC[1], _centerY[i]);
+        maxC[2] = ::std::max(maxC[2], _centerZ[i]);
+    }
+
+    uSys axis = 0;
+    if(maxC[1] - minC[1] > maxC[axis] - minC[axis])
+    { axis = 1; }
+    if(maxC[2] - minC[2] > maxC[axis] - minC[axis])
+    { axis = 2; }
+
+    const ::std::vector<float>& keys = axis == 0 ? _centerX : (axis == 1 ? _centerY : _centerZ);
+
+    /**
+     *   Quickselect directly on the structure of arrays, this
+     * keeps every pass sequential instead of chasing indices.
+     */
+    const u32 half = count / 2;
+    const i64 target = first + half;
+    i64 lo = first;
+    i64 hi = first + count - 1;
+    while(lo < hi)
+    {
+        const float pivot = keys[static_cast<uSys>(lo + (hi - lo) / 2)];
+        i64 i = lo;
+        i64 j = hi;
+        while(i <= j)
+        {
+            while(keys[static_cast<uSys>(i)] < pivot) { ++i; }
+            while(keys[static_cast<uSys>(j)] > pivot) { --j; }
+            if(i <= j)
+            {
+                swapSlots(static_cast<u32>(i), static_cast<u32>(j));
+                ++i;
+                --j;
+            }
+        }
+
+        if(target <= j)
+        { hi = j; }
+        else if(target >= i)
+        { lo = i; }
+        else
+        { break; }
+    }
+
+    const u32 right = build(node + 1, first, half, depth + 1, topLevel);
+    const u32 end = build(right, first + half, count - half, depth + 1, topLevel);
+    _nodes[node].index = right;
+    _nodes[node].count = 0;
+    fitInterior(node);
+    return end;
+}
+
+void CullingBVH::fitLeaf(Node& node) const noexcept
+{
+    float minB[3] = {  INFINITY,  INFINITY,  INFINITY };
+    float maxB[3] = { -INFINITY, -INFINITY, -INFINITY };
+    for(u32 i = node.index; i < node.index + node.count; ++i)
+    {
+        minB[0] = ::std::min(minB[0], _centerX[i] - _extentX[i]);
+        minB[1] = ::std::min(minB[1], _centerY[i] - _extentY[i]);
+        minB[2] = ::std::min(minB[2], _centerZ[i] - _extentZ[i]);
+        maxB[0] = ::std::max(maxB[0], _centerX[i] + _extentX[i]);
+        maxB[1] = ::std::max(maxB[1], _centerY[i] + _extentY[i]);
+        maxB[2] = ::std::max(maxB[2], _centerZ[i] + _extentZ[i]);
+    }
+
+    node.centerX = (minB[0] + maxB[0]) * 0.5f;
+    node.centerY = (minB[1] + maxB[1]) * 0.5f;
+    node.centerZ = (minB[2] + maxB[2]) * 0.5f;
+    node.extentX = (maxB[0] - minB[0]) * 0.5f;
+    node.extentY = (maxB[1] - minB[1]) * 0.5f;
+    node.extentZ = (maxB[2] - minB[2]) * 0.5f;
+}
+
+void CullingBVH::fitInterior(const u32 node) noexcept
+{
+    const Node& a = _nodes[node + 1];
+    const Node& b = _nodes[_nodes[node].index];
+
+    const float minX = ::std::min(a.centerX - a.extentX, b.centerX - b.extentX);
+    const float minY = ::std::min(a.centerY - a.extentY, b.centerY - b.extentY);
+    const float minZ = ::std::min(a.centerZ - a.extentZ, b.centerZ - b.extentZ);
+    const float maxX = ::std::max(a.centerX + a.extentX, b.centerX + b.extentX);
+    const float maxY = ::std::max(a.centerY + a.extentY, b.centerY + b.extentY);
+    const float maxZ = ::std::max(a.centerZ + a.extentZ, b.centerZ + b.extentZ);
+
+    Node& n = _nodes[node];
+    n.centerX = (minX + maxX) * 0.5f;
+    n.centerY = (minY + maxY) * 0.5f;
+    n.centerZ = (minZ + maxZ) * 0.5f;
+    n.extentX = (maxX - minX) * 0.5f;
+    n.extentY = (maxY - minY) * 0.5f;
+    n.extentZ = (maxZ - minZ) * 0.5f;
+}
+
+void CullingBVH::refit(const u32 firstNode, const u32 nodeCount) noexcept
+{
+    // Children always come after their parent.
+    for(u32 i = firstNode + nodeCount; i-- > firstNode;)
+    {
+        if(_nodes[i].count)
+        { fitLeaf(_nodes[i]); }
+        else
+        { fitInterior(i); }
+    }
+}
+
+static float surfaceArea(const float x, const float y, const float z) noexcept
+{
+    if(x < 0.0f || y < 0.0f || z < 0.0f)
+    { return 0.0f; }
+    return x * y + y * z + z * x;
+}
+
+float CullingBVH::treeletCost(const Treelet& treelet) const noexcept
+{
+    const Node& root = _nodes[treelet.node];
+    const float rootArea = surfaceArea(root.extentX, root.extentY, root.extentZ);
+    if(rootArea <= 0.0f)
+    { return 1.0f; }
+
+    float area = 0.0f;
+    for(u32 i = treelet.node; i < treelet.node + treelet.nodeCount; ++i)
+    { area += surfaceArea(_nodes[i].extentX, _nodes[i].extentY, _nodes[i].extentZ); }
+    return area / rootArea;
+}
+
+void CullingBVH::rebuildTreelet(Treelet& treelet) noexcept
+{
+    // The same number of objects always produces the same number of nodes.
+    (void) build(treelet.node, treelet.first, treelet.count, 0, false);
+    treelet.builtCost = treeletCost(treelet);
+}
+
+void CullingBVH::maintain(const uSys treeletBudget) noexcept
+{
+    const uSys pending = _proxies.size() - _treeCount;
+    if(pending + _removedCount > _treeCount / 4)
+    {
+        rebuild();
+        return;
+    }
+
+    if(!_moved)
+    { return; }
+
+    ::std::vector<::std::pair<float, Treelet*>> degraded;
+    for(Treelet& treelet : _treelets)
+    {
+        if(!treelet.dirty)
+        { continue; }
+
+        refit(treelet.node, treelet.nodeCount);
+        treelet.dirty = false;
+
+        const float ratio = treeletCost(treelet) / treelet.builtCost;
+        if(ratio > REBUILD_THRESHOLD)
+        { degraded.emplace_back(ratio, &treelet); }
+    }
+
+    const uSys rebuildCount = ::std::min(treeletBudget, degraded.size());
+    ::std::partial_sort(degraded.begin(), degraded.begin() + rebuildCount, degraded.end(),
+                        [](const ::std::pair<float, Treelet*>& a, const ::std::pair<float, Treelet*>& b) { return a.first > b.first; });
+    for(uSys i = 0; i < rebuildCount; ++i)
+    { rebuildTreelet(*degraded[i].second); }
+
+    for(auto it = _topNodes.rbegin(); it != _topNodes.rend(); ++it)
+    { fitInterior(*it); }
+
+    _moved = false;
+}
+
+static inline __m128 abs4(const __m128 x) noexcept
+{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), x); }
+
+/**
+ *   Tests a node against the planes in `mask`. Returns the
+ * planes the node straddles, or -1 if it is outside any of them.
+ */
+static int testNode(const Frustum& frustum, const float* const node, const int mask) noexcept
+{
+    const __m128 cx = _mm_set1_ps(node[0]);
+    const __m128 cy = _mm_set1_ps(node[1]);
+    const __m128 cz = _mm_set1_ps(node[2]);
+    const __m128 ex = _mm_set1_ps(node[3]);
+    const __m128 ey = _mm_set1_ps(node[4]);
+    const __m128 ez = _mm_set1_ps(node[5]);
+
+    int outside = 0;
+    int inside = 0;
+    for(uSys i = 0; i < Frustum::PADDED_PLANE_COUNT; i += 4)
+    {
+        const __m128 nx = _mm_load_ps(frustum.normalX() + i);
+        const __m128 ny = _mm_load_ps(frustum.normalY() + i);
+        const __m128 nz = _mm_load_ps(frustum.normalZ() + i);
+
+        const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_load_ps(frustum.distance() + i)));
+        const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs4(nx), ex), _mm_mul_ps(abs4(ny), ey)), _mm_mul_ps(abs4(nz), ez));
+
+        outside |= _mm_movemask_ps(_mm_cmpnge_ps(dist, _mm_sub_ps(_mm_setzero_ps(), radius))) << i;
+        inside |= _mm_movemask_ps(_mm_cmpge_ps(dist, radius)) << i;
+    }
+
+    if(outside & mask)
+    { return -1; }
+    return mask & ~inside;
+}
+
+/**
+ *   Tests objects 4 at a time against the planes in `mask`. An
+ * object is rejected if either its box or its sphere is behind a
+ * plane, so each plane uses whichever radius is smaller.
+ */
+static u32 testObjects(const Frustum& frustum, int mask, const float* const cx, const float* const cy, const float* const cz,
+                       const float* const ex, const float* const ey, const float* const ez, const float* const radius,
+                       const u32* const userId, const u32 first, const u32 count, u32* const out) noexcept
+{
+    u32 planes[Frustum::PADDED_PLANE_COUNT];
+    u32 planeCount = 0;
+    for(; mask; mask &= mask - 1)
+    {
+        u32 plane = 0;
+        while(!(mask & (1 << plane))) { ++plane; }
+        planes[planeCount++] = plane;
+    }
+
+    u32 written = 0;
+    u32 i = first;
+    for(; i + 4 <= first + count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(cx + i);
+        const __m128 y = _mm_loadu_ps(cy + i);
+        const __m128 z = _mm_loadu_ps(cz + i);
+        const __m128 w = _mm_loadu_ps(ex + i);
+        const __m128 h = _mm_loadu_ps(ey + i);
+        const __m128 d = _mm_loadu_ps(ez + i);
+        const __m128 r = _mm_loadu_ps(radius + i);
+
+        __m128 visible = _mm_cmpge_ps(r, _mm_set1_ps(0.0f));
+        for(u32 p = 0; p < planeCount; ++p)
+        {
+            const u32 plane = planes[p];
+            const __m128 nx = _mm_set1_ps(frustum.normalX()[plane]);
+            const __m128 ny = _mm_set1_ps(frustum.normalY()[plane]);
+            const __m128 nz = _mm_set1_ps(frustum.normalZ()[plane]);
+
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_add_ps(_mm_mul_ps(nz, z), _mm_set1_ps(frustum.distance()[plane])));
+            const __m128 boxRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs4(nx), w), _mm_mul_ps(abs4(ny), h)), _mm_mul_ps(abs4(nz), d));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(dist, _mm_sub_ps(_mm_setzero_ps(), _mm_min_ps(boxRadius, r))));
+        }
+
+        int bits = _mm_movemask_ps(visible);
+        for(; bits; bits &= bits - 1)
+        {
+            u32 lane = 0;
+            while(!(bits & (1 << lane))) { ++lane; }
+            out[written++] = userId[i + lane];
+        }
+    }
+
+    for(; i < first + count; ++i)
+    {
+        bool visible = radius[i] >= 0.0f;
+        for(u32 p = 0; p < planeCount && visible; ++p)
+        {
+            const u32 plane = planes[p];
+            const float nx = frustum.normalX()[plane];
+            const float ny = frustum.normalY()[plane];
+            const float nz = frustum.normalZ()[plane];
+            const float dist = nx * cx[i] + ny * cy[i] + nz * cz[i] + frustum.distance()[plane];
+            const float boxRadius = ::std::fabs(nx) * ex[i] + ::std::fabs(ny) * ey[i] + ::std::fabs(nz) * ez[i];
+            visible = dist >= -::std::min(boxRadius, radius[i]);
+        }
+
+        if(visible)
+        { out[written++] = userId[i]; }
+    }
+
+    return written;
+}
+
+void CullingBVH::cullRange(const Frustum& frustum, const u32 first, const u32 count, u32* const out, u32& outCount) const noexcept
+{
+    outCount = testObjects(frustum, (1 << Frustum::PLANE_COUNT) - 1, _centerX.data(), _centerY.data(), _centerZ.data(),
+                           _extentX.data(), _extentY.data(), _extentZ.data(), _radius.data(), _userId.data(), first, count, out);
+}
+
+void CullingBVH::cullTreelet(const Frustum& frustum, const Treelet& treelet, u32* const out, u32& outCount) const noexcept
+{
+    struct Entry final
+    {
+        u32 node;
+        int mask;
+    };
+
+    // Deep enough for a tree over 2^32 objects.
+    Entry stack[64];
+    uSys stackSize = 0;
+    stack[stackSize++] = { treelet.node, (1 << Frustum::PLANE_COUNT) - 1 };
+
+    u32 written = 0;
+    while(stackSize)
+    {
+        const Entry entry = stack[--stackSize];
+        const Node& node = _nodes[entry.node];
+
+        const int mask = testNode(frustum, &node.centerX, entry.mask);
+        if(mask < 0)
+        { continue; }
+
+        if(node.count)
+        {
+            written += testObjects(frustum, mask, _centerX.data(), _centerY.data(), _centerZ.data(), _extentX.data(), _extentY.data(), _extentZ.data(),
+                                   _radius.data(), _userId.data(), node.index, node.count, out + written);
+            continue;
+        }
+
+        if(!mask)
+        {
+            /**
+             *   Entirely inside, emit everything beneath it. The
+             * objects are the range between the leftmost and the
+             * rightmost leaves.
+             */
+            u32 left = entry.node;
+            while(!_nodes[left].count) { ++left; }
+            u32 right = entry.node;
+            while(!_nodes[right].count) { right = _nodes[right].index; }
+
+            for(u32 i = _nodes[left].index; i < _nodes[right].index + _nodes[right].count; ++i)
+            {
+                if(_proxies[i] != INVALID_PROXY)
+                { out[written++] = _userId[i]; }
+            }
+            continue;
+        }
+
+        // The left child is pushed last so the output stays in order.
+        stack[stackSize++] = { node.index, mask };
+        stack[stackSize++] = { entry.node + 1, mask };
+    }
+
+    outCount = written;
+}
+
+void CullingBVH::cull(const Frustum& frustum, ::std::vector<u32>& visible, uSys workerCount) const noexcept
+{
+    /**
+     *   Every unit of work writes into the output at the index of
+     * its first object, so they can run in any order. The results
+     * are compacted afterwards.
+     */
+    struct Work final
+    {
+        const Treelet* treelet;
+        u32 first;
+        u32 count;
+        u32 outCount;
+    };
+
+    ::std::vector<Work> work;
+    work.reserve(_treelets.size() + (_proxies.size() - _treeCount) / TREELET_SIZE + 1);
+    for(const Treelet& treelet : _treelets)
+    { work.push_back({ &treelet, treelet.first, treelet.count, 0 }); }
+    for(u32 first = _treeCount; first < _proxies.size(); first += TREELET_SIZE)
+    { work.push_back({ nullptr, first, ::std::min<u32>(TREELET_SIZE, static_cast<u32>(_proxies.size()) - first), 0 }); }
+
+    visible.resize(_proxies.size());
+    u32* const out = visible.data();
+
+    ::std::atomic<uSys> next(0);
+    const auto worker = [&]()
+    {
+        for(uSys i = next.fetch_add(1, ::std::memory_order_relaxed); i < work.size(); i = next.fetch_add(1, ::std::memory_order_relaxed))
+        {
+            Work& w = work[i];
+            if(w.treelet)
+            { cullTreelet(frustum, *w.treelet, out + w.first, w.outCount); }
+            else
+            { cullRange(frustum, w.first, w.count, out + w.first, w.outCount); }
+        }
+    };
+
+    workerCount = ::std::max<uSys>(1, ::std::min<uSys>(workerCount, work.size()));
+
+    ::std::list<::std::future<void>> futures;
+    for(uSys i = 1; i < workerCount; ++i)
+    { futures.push_back(::std::async(::std::launch::async, worker)); }
+    worker();
+
+    for(::std::future<void>& future : futures)
+    { future.wait(); }
+
+    uSys count = 0;
+    for(const Work& w : work)
+    {
+        if(w.first != count)
+        { ::std::copy(out + w.first, out + w.first + w.outCount, out + count); }
+        count += w.outCount;
+    }
+    visible.resize(count);
+}
@@ -0,0 +1,433 @@
+#include "shader/bundle/ShaderBundleBinary.hpp"
+#include "shader/bundle/ShaderBundleParser.hpp"
+#include "shader/bundle/ShaderInfoExtractorVisitor.hpp"
+#include "shader/bundle/ast/BlockAST.hpp"
+#include "shader/bundle/ast/FileAST.hpp"
+#include <VFS.hpp>
+
+#pragma warning(push, 0)
+#include <cstring>
+#pragma warning(pop)
+
+u32 sbp::bin::checksum(const u8* const data, const uSys length) noexcept
+{
+    u32 hash = 0x811C9DC5;
+    for(uSys i = 0; i < length; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+bool ShaderBundleCompiler::compile(const CPPRef<IFile>& bundle, const CPPRef<IFile>& output, Error* const error) noexcept
+{
+    ERROR_CODE_COND_F(!bundle || !output, Error::InvalidFile);
+
+    ShaderBundleParser parser(bundle);
+
+    ShaderBundleParser::Error parseError;
+    const NullableStrongRef<sbp::AST> ast = parser.parse(&parseError);
+
+    ERROR_CODE_COND_F(!ast || parseError != ShaderBundleParser::Error::NoError, Error::ParseError);
+
+    ShaderBundleCompiler compiler;
+    ::std::vector<u8> image;
+    if(!compiler.compile(*ast.get(), image, error))
+    { return false; }
+
+    ERROR_CODE_COND_F(output->writeBytes(image.data(), image.size()) != static_cast<i64>(image.size()), Error::WriteFailure);
+
+    ERROR_CODE_T(Error::NoError);
+}
+
+bool ShaderBundleCompiler::compile(const sbp::AST& ast, ::std::vector<u8>& image, Error* const error) noexcept
+{
+    _apiBlocks.clear();
+    _stages.clear();
+    _strings.clear();
+    _currentStage = -1;
+    _error = Error::NoError;
+
+    visit(ast);
+
+    ERROR_CODE_COND_F(_error != Error::NoError, _error);
+
+    uSys offset = sizeof(sbp::bin::Header);
+    const uSys apiBlockOffset = offset;
+    offset += sizeof(sbp::bin::APIBlock) * _apiBlocks.size();
+
+    ::std::vector<u32> stageOffsets(_stages.size());
+    for(uSys i = 0; i < _stages.size(); ++i)
+    {
+        const PendingStage& stage = _stages[i];
+        ERROR_CODE_COND_F(stage.uniforms.size() > 0xFFFF || stage.textures.size() > 0xFFFF, Error::TooManyBindings);
+
+        stageOffsets[i] = static_cast<u32>(offset);
+        offset += sizeof(sbp::bin::Stage);
+        offset += sizeof(sbp::bin::Binding) * (stage.uniforms.size() + stage.textures.size());
+    }
+
+    const uSys stringTableOffset = offset;
+    const uSys stringTableSize = (_strings.size() + 3) & ~static_cast<uSys>(3);
+    offset += stringTableSize;
+
+    image.assign(offset, 0);
+    u8* const base = image.data();
+
+    sbp::bin::APIBlock* const apiBlocks = reinterpret_cast<sbp::bin::APIBlock*>(base + apiBlockOffset);
+    for(uSys i = 0; i < _apiBlocks.size(); ++i)
+    {
+        apiBlocks[i].apiMask = _apiBlocks[i].apiMask;
+        for(uSys j = 0; j < sbp::bin::StageCount; ++j)
+        {
+            const iSys stageIndex = _apiBlocks[i].stages[j];
+            apiBlocks[i].stageOffsets[j] = stageIndex >= 0 ? stageOffsets[stageIndex] : 0;
+        }
+    }
+
+    for(uSys i = 0; i < _stages.size(); ++i)
+    {
+        const PendingStage& pending = _stages[i];
+        u8* const stageBase = base + stageOffsets[i];
+
+        sbp::bin::Stage stage = pending.stage;
+        stage.uniformCount = static_cast<u16>(pending.uniforms.size());
+        stage.textureCount = static_cast<u16>(pending.textures.size());
+        ::std::memcpy(stageBase, &stage, sizeof(stage));
+
+        u8* bindings = stageBase + sizeof(sbp::bin::Stage);
+        if(!pending.uniforms.empty())
+        {
+            ::std::memcpy(bindings, pending.uniforms.data(), sizeof(sbp::bin::Binding) * pending.uniforms.size());
+            bindings += sizeof(sbp::bin::Binding) * pending.uniforms.size();
+        }
+        if(!pending.textures.empty())
+        {
+            ::std::memcpy(bindings, pending.textures.data(), sizeof(sbp::bin::Binding) * pending.textures.size());
+        }
+    }
+
+    if(!_strings.empty())
+    { ::std::memcpy(base + stringTableOffset, _strings.data(), _strings.size()); }
+
+    sbp::bin::Header header;
+    header.magic = sbp::bin::Magic;
+    header.version = sbp::bin::Version;
+    header.headerSize = static_cast<u16>(sizeof(sbp::bin::Header));
+    header.fileSize = static_cast<u32>(image.size());
+    header.checksum = sbp::bin::checksum(base + sizeof(sbp::bin::Header), image.size() - sizeof(sbp::bin::Header));
+    header.apiBlockCount = static_cast<u32>(_apiBlocks.size());
+    header.apiBlockOffset = static_cast<u32>(apiBlockOffset);
+    header.stringTableOffset = static_cast<u32>(stringTableOffset);
+    header.stringTableSize = static_cast<u32>(stringTableSize);
+    ::std::memcpy(base, &header, sizeof(header));
+
+    ERROR_CODE_T(Error::NoError);
+}
+
+void ShaderBundleCompiler::visit(const sbp::FileAST& expr) noexcept
+{
+    if(_currentStage < 0)
+    { return; }
+
+    _stages[_currentStage].stage.fileName = addString(expr.filePath().c_str(), expr.filePath().length());
+}
+
+void ShaderBundleCompiler::visit(const sbp::UniformBindingAST& expr) noexcept
+{
+    if(_currentStage < 0)
+    { return; }
+
+    const sbp::UniformBindingAST* curr = &expr;
+    while(curr)
+    {
+        sbp::bin::Binding binding;
+        binding.crmTarget = curr->crmTarget();
+        binding.sampler = 0;
+
+        if(curr->bindPoint().type == sbp::BindingUnion::Str)
+        {
+            binding.type = sbp::bin::Binding::Str;
+            binding.value = addString(curr->bindPoint().str, ::std::strlen(curr->bindPoint().str)).offset;
+        }
+        else
+        {
+            binding.type = sbp::bin::Binding::Number;
+            binding.value = static_cast<u32>(curr->bindPoint().number);
+        }
+
+        _stages[_currentStage].uniforms.push_back(binding);
+        curr = curr->next().get();
+    }
+}
+
+void ShaderBundleCompiler::visit(const sbp::TextureParamsBlockAST& expr) noexcept
+{
+    if(_currentStage < 0)
+    { return; }
+
+    const sbp::TextureParamsBlockAST* curr = &expr;
+    while(curr)
+    {
+        sbp::bin::Binding binding;
+        binding.crmTarget = curr->crmTarget();
+        binding.sampler = curr->sampler();
+
+        if(curr->bindPoint().type == sbp::BindingUnion::Str)
+        {
+            binding.type = sbp::bin::Binding::Str;
+            binding.value = addString(curr->bindPoint().str, ::std::strlen(curr->bindPoint().str)).offset;
+        }
+        else
+        {
+            binding.type = sbp::bin::Binding::Number;
+            binding.value = static_cast<u32>(curr->bindPoint().number);
+        }
+
+        _stages[_currentStage].textures.push_back(binding);
+        curr = curr->next().get();
+    }
+}
+
+void ShaderBundleCompiler::visit(const sbp::ShaderStageBlockAST& expr) noexcept
+{
+    if(!expr.file())
+    {
+        if(_error == Error::NoError)
+        { _error = Error::MissingFile; }
+        return;
+    }
+
+    PendingStage stage;
+    stage.stage.stage = static_cast<u32>(expr.stage());
+    stage.stage.fileName = { 0, 0 };
+    stage.stage.uniformCount = 0;
+    stage.stage.textureCount = 0;
+
+    _currentStage = static_cast<iSys>(_stages.size());
+    _stages.push_back(::std::move(stage));
+
+    visit(expr.file().get());
+    visit(expr.uniforms().get());
+    visit(expr.textures().get());
+
+    _currentStage = -1;
+}
+
+void ShaderBundleCompiler::visit(const sbp::APIBlockAST& expr) noexcept
+{
+    const sbp::APIBlockAST* curr = &expr;
+    while(curr)
+    {
+        PendingAPIBlock block;
+        block.apiMask = static_cast<u32>(curr->apis().to_ulong());
+
+        const NullableStrongRef<sbp::ShaderStageBlockAST>* stages[sbp::bin::StageCount] = {
+            &curr->vertex(), &curr->tessCtrl(), &curr->tessEval(), &curr->geometry(), &curr->pixel()
+        };
+
+        bool empty = true;
+        for(uSys i = 0; i < sbp::bin::StageCount; ++i)
+        {
+            block.stages[i] = -1;
+            if(*stages[i])
+            {
+                block.stages[i] = static_cast<iSys>(_stages.size());
+                visit(stages[i]->get());
+                empty = false;
+            }
+        }
+
+        if(empty && _error == Error::NoError)
+        { _error = Error::EmptyAPIBlock; }
+
+        _apiBlocks.push_back(block);
+        curr = curr->next().get();
+    }
+}
+
+sbp::bin::StringRef ShaderBundleCompiler::addString(const char* const str, const uSys length) noexcept
+{
+    const sbp::bin::StringRef ref { static_cast<u32>(_strings.size()), static_cast<u32>(length) };
+    _strings.insert(_strings.end(), str, str + length);
+    _strings.push_back('\0');
+    return ref;
+}
+
+CompiledShaderBundle CompiledShaderBundle::load(const CPPRef<IFile>& file, Error* const error) noexcept
+{
+    ERROR_CODE_COND_V(!file, Error::InvalidFile, CompiledShaderBundle(nullptr));
+
+    const CPPRef<MappedFile> mapped = MappedFile::map(file);
+    ERROR_CODE_COND_V(!mapped || mapped->size() < sizeof(sbp::bin::Header), Error::InvalidFile, CompiledShaderBundle(nullptr));
+
+    CompiledShaderBundle bundle(mapped);
+    if(!bundle.validate(error))
+    { return CompiledShaderBundle(nullptr); }
+
+    ERROR_CODE_V(Error::NoError, bundle);
+}
+
+/**
+ *   Strings are read in place as C strings, so every string a
+ * bundle refers to has to be terminated within the table.
+ */
+static bool validString(const char* const table, const u32 tableSize, const u32 offset) noexcept
+{ return offset < tableSize && ::std::memchr(table + offset, '\0', tableSize - offset); }
+
+static bool validBindings(const sbp::bin::Binding* const bindings, const uSys count, const char* const table, const u32 tableSize) noexcept
+{
+    for(uSys i = 0; i < count; ++i)
+    {
+        if(bindings[i].type == sbp::bin::Binding::Str)
+        {
+            if(!validString(table, tableSize, bindings[i].value))
+            { return false; }
+        }
+        else if(bindings[i].type != sbp::bin::Binding::Number)
+        { return false; }
+    }
+    return true;
+}
+
+bool CompiledShaderBundle::validate(Error* const error) const noexcept
+{
+    const uSys size = _file->size();
+
+    ERROR_CODE_COND_F(_header->magic != sbp::bin::Magic, Error::InvalidMagic);
+    ERROR_CODE_COND_F(_header->version != sbp::bin::Version, Error::UnsupportedVersion);
+    ERROR_CODE_COND_F(_header->headerSize != sizeof(sbp::bin::Header), Error::CorruptFile);
+    ERROR_CODE_COND_F(_header->fileSize != size, Error::CorruptFile);
+
+    const u64 apiBlockEnd = static_cast<u64>(_header->apiBlockOffset) + static_cast<u64>(_header->apiBlockCount) * sizeof(sbp::bin::APIBlock);
+    const u64 stringTableEnd = static_cast<u64>(_header->stringTableOffset) + _header->stringTableSize;
+    ERROR_CODE_COND_F(apiBlockEnd > size || stringTableEnd > size, Error::CorruptFile);
+    ERROR_CODE_COND_F((_header->apiBlockOffset & 3) != 0 || (_header->stringTableOffset & 3) != 0, Error::CorruptFile);
+    ERROR_CODE_COND_F(_header->apiBlockOffset < sizeof(sbp::bin::Header) || apiBlockEnd > _header->stringTableOffset, Error::CorruptFile);
+
+    ERROR_CODE_COND_F(sbp::bin::checksum(_file->data() + sizeof(sbp::bin::Header), size - sizeof(sbp::bin::Header)) != _header->checksum, Error::CorruptFile);
+
+    const char* const table = string(0u);
+    const u32 tableSize = _header->stringTableSize;
+
+    const sbp::bin::APIBlock* const blocks = apiBlocks();
+    for(u32 i = 0; i < _header->apiBlockCount; ++i)
+    {
+        for(uSys j = 0; j < sbp::bin::StageCount; ++j)
+        {
+            const u32 offset = blocks[i].stageOffsets[j];
+            if(!offset)
+            { continue; }
+
+            ERROR_CODE_COND_F((offset & 3) != 0 || offset + sizeof(sbp::bin::Stage) > _header->stringTableOffset, Error::CorruptFile);
+
+            const sbp::bin::Stage* const stage = _file->at<sbp::bin::Stage>(offset);
+            const u64 bindingEnd = offset + sizeof(sbp::bin::Stage) + static_cast<u64>(stage->uniformCount + stage->textureCount) * sizeof(sbp::bin::Binding);
+            ERROR_CODE_COND_F(bindingEnd > _header->stringTableOffset, Error::CorruptFile);
+            ERROR_CODE_COND_F(static_cast<u64>(stage->fileName.offset) + stage->fileName.length >= tableSize, Error::CorruptFile);
+            ERROR_CODE_COND_F(table[stage->fileName.offset + stage->fileName.length] != '\0', Error::CorruptFile);
+            ERROR_CODE_COND_F(!validBindings(stage->bindings(), stage->uniformCount + stage->textureCount, table, tableSize), Error::CorruptFile);
+        }
+    }
+
+    ERROR_CODE_T(Error::NoError);
+}
+
+const sbp::bin::APIBlock* CompiledShaderBundle::findAPI(const RenderingMode::Mode mode) const noexcept
+{
+    const sbp::bin::APIBlock* const blocks = apiBlocks();
+    for(u32 i = 0; i < _header->apiBlockCount; ++i)
+    {
+        if(blocks[i].hasAPI(mode))
+        { return &blocks[i]; }
+    }
+    return nullptr;
+}
+
+void CompiledShaderBundle::extract(ShaderInfoExtractorVisitor& visitor) const noexcept
+{
+    visitor.reset();
+
+    const sbp::bin::APIBlock* const block = findAPI(visitor.targetMode());
+    if(!block)
+    { return; }
+
+    for(uSys i = 1; i <= sbp::bin::StageCount; ++i)
+    {
+        const EShader::Stage stageType = static_cast<EShader::Stage>(i);
+        const sbp::bin::Stage* const stage = this->stage(*block, stageType);
+        if(!stage)
+        { continue; }
+
+        sbp::ShaderInfo& info = visitor.get(stageType);
+        info.fileName = DynString(string(stage->fileName));
+
+        const sbp::bin::Binding* const uniforms = stage->uniforms();
+        for(u16 j = 0; j < stage->uniformCount; ++j)
+        {
+            if(uniforms[j].type == sbp::bin::Binding::Str)
+            { info.uniformPoints.emplace(uniforms[j].crmTarget, sbp::BindingUnion(string(uniforms[j].value))); }
+            else
+            { info.uniformPoints.emplace(uniforms[j].crmTarget, sbp::BindingUnion(uniforms[j].value)); }
+        }
+
+        const sbp::bin::Binding* const textures = stage->textures();
+        for(u16 j = 0; j < stage->textureCount; ++j)
+        {
+            if(textures[j].type == sbp::bin::Binding::Str)
+            { info.texturePoints.emplace(textures[j].crmTarget, sbp::BindingUnion(string(textures[j].value)), textures[j].sampler); }
+            else
+            { info.texturePoints.emplace(textures[j].crmTarget, sbp::BindingUnion(textures[j].value), textures[j].sampler); }
+        }
+    }
+}
+
+bool ShaderBundleLoader::isBundle(const CPPRef<IFile>& file) noexcept
+{
+    if(!file)
+    { return false; }
+
+    const WDynString path = file->name();
+    const WDynStringView ext = VFS::getFileExt(path, false);
+    return ext == TextExtension || ext == BinaryExtension;
+}
+
+bool ShaderBundleLoader::isCompiledBundle(const CPPRef<IFile>& file) noexcept
+{
+    if(!file)
+    { return false; }
+
+    const WDynString path = file->name();
+    return VFS::getFileExt(path, false) == BinaryExtension;
+}
+
+bool ShaderBundleLoader::load(const CPPRef<IFile>& file, ShaderInfoExtractorVisitor& visitor) noexcept
+{
+    visitor.reset();
+
+    if(!file)
+    { return false; }
+
+    if(isCompiledBundle(file))
+    {
+        CompiledShaderBundle::Error error;
+        const CompiledShaderBundle bundle = CompiledShaderBundle::load(file, &error);
+        if(!bundle)
+        { return false; }
+
+        bundle.extract(visitor);
+        return true;
+    }
+
+    ShaderBundleParser parser(file);
+
+    ShaderBundleParser::Error parseError;
+    const NullableStrongRef<sbp::AST> ast = parser.parse(&parseError);
+
+    if(!ast)
+    { return false; }
+
+    visitor.visit(ast.get());
+    return true;
+}
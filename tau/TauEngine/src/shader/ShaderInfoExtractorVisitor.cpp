@@ -36,9 +36,9 @@ void ShaderInfoExtractorVisitor::visit(const sbp::APIBlockAST& expr) noexcept
 
     if(!curr) { return; }
 
-    visit(expr.vertex().get());
-    visit(expr.tessCtrl().get());
-    visit(expr.tessEval().get());
-    visit(expr.geometry().get());
-    visit(expr.pixel().get());
+    visit(curr->vertex().get());
+    visit(curr->tessCtrl().get());
+    visit(curr->tessEval().get());
+    visit(curr->geometry().get());
+    visit(curr->pixel().get());
 }
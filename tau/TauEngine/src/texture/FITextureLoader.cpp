@@ -1,8 +1,11 @@
 #pragma warning(push, 0)
 #include <FreeImage.h>
+#include <smmintrin.h>
+#include <cstring>
 #pragma warning(pop)
 
 #include "texture/FITextureLoader.hpp"
+#include "texture/TextureDecodeQueue.hpp"
 #include "maths/Maths.hpp"
 #include "RenderingMode.hpp"
 #include "VFS.hpp"
@@ -10,6 +13,7 @@
 #include "system/GraphicsInterface.hpp"
 #include "system/RenderingContext.hpp"
 #include <EnumBitFields.hpp>
+#include <MappedFile.hpp>
 
 NullableRef<IResource> TextureLoader::_missingTexture = null;
 
@@ -200,73 +204,282 @@ NullableRef<IResource> TextureLoader::generateColorTexture(IGraphicsInterface& g
     return ret;
 }
 
-NullableRef<IResource> TextureLoader::loadTexture(IGraphicsInterface& gi, IRenderingContext& context, const char* RESTRICT fileName, TextureLoadError* RESTRICT const error) noexcept
+/**
+ *   FreeImage stores 24 and 32 bit pixels in the byte order
+ * given by the FI_RGBA_* macros, BGR(A) on little endian
+ * machines. These convert a scanline straight into RGBA.
+ */
+static void convertScanline32(const u8* const src, u8* const dst, const u32 width) noexcept
 {
-    PERF();
-#define ERR_EXIT(__ERR, __CHECK) \
-    if((__CHECK)) { \
-        if(error) { *error = __ERR; } \
-        if(texture) { FreeImage_Unload(texture); } \
-        return _missingTexture; }
+    const __m128i shuffle = _mm_setr_epi8(
+        FI_RGBA_RED,      FI_RGBA_GREEN,      FI_RGBA_BLUE,      FI_RGBA_ALPHA,
+        4 + FI_RGBA_RED,  4 + FI_RGBA_GREEN,  4 + FI_RGBA_BLUE,  4 + FI_RGBA_ALPHA,
+        8 + FI_RGBA_RED,  8 + FI_RGBA_GREEN,  8 + FI_RGBA_BLUE,  8 + FI_RGBA_ALPHA,
+        12 + FI_RGBA_RED, 12 + FI_RGBA_GREEN, 12 + FI_RGBA_BLUE, 12 + FI_RGBA_ALPHA);
+
+    u32 x = 0;
+    for(; x + 4 <= width; x += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_shuffle_epi8(pixels, shuffle));
+    }
 
-    const VFS::Container physPath = VFS::Instance().resolvePath(fileName);
+    for(; x < width; ++x)
+    {
+        dst[x * 4 + 0] = src[x * 4 + FI_RGBA_RED];
+        dst[x * 4 + 1] = src[x * 4 + FI_RGBA_GREEN];
+        dst[x * 4 + 2] = src[x * 4 + FI_RGBA_BLUE];
+        dst[x * 4 + 3] = src[x * 4 + FI_RGBA_ALPHA];
+    }
+}
+
+static void convertScanline24(const u8* const src, u8* const dst, const u32 width) noexcept
+{
+    const __m128i shuffle = _mm_setr_epi8(
+        FI_RGBA_RED,     FI_RGBA_GREEN,     FI_RGBA_BLUE,     -1,
+        3 + FI_RGBA_RED, 3 + FI_RGBA_GREEN, 3 + FI_RGBA_BLUE, -1,
+        6 + FI_RGBA_RED, 6 + FI_RGBA_GREEN, 6 + FI_RGBA_BLUE, -1,
+        9 + FI_RGBA_RED, 9 + FI_RGBA_GREEN, 9 + FI_RGBA_BLUE, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    /**
+     *   Each load reads 16 bytes to convert 4 pixels (12 bytes),
+     * so the vector loop stops while a full load still fits
+     * within the scanline.
+     */
+    u32 x = 0;
+    for(; x + 6 <= width; x += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha));
+    }
 
-    FIBITMAP* texture = null;
-    
-    ERR_EXIT(TextureLoadError::INVALID_PATH, physPath.basePath.length() == 0);
-    ERR_EXIT(TextureLoadError::INVALID_PATH, physPath.subPath.length() == 0);
+    for(; x < width; ++x)
+    {
+        dst[x * 4 + 0] = src[x * 3 + FI_RGBA_RED];
+        dst[x * 4 + 1] = src[x * 3 + FI_RGBA_GREEN];
+        dst[x * 4 + 2] = src[x * 3 + FI_RGBA_BLUE];
+        dst[x * 4 + 3] = 0xFF;
+    }
+}
+
+static void convertScanline8(const u8* const src, u8* const dst, const u32 width, const u32* const palette) noexcept
+{
+    for(u32 x = 0; x < width; ++x)
+    { ::std::memcpy(dst + x * 4, &palette[src[x]], 4); }
+}
+
+/**
+ *   Builds the RGBA value of every palette index, including
+ * the alpha from the transparency table.
+ */
+static void buildPalette(FIBITMAP* const bitmap, u32* const palette) noexcept
+{
+    const RGBQUAD* const colors = FreeImage_GetPalette(bitmap);
+    const BYTE* const transparency = FreeImage_IsTransparent(bitmap) ? FreeImage_GetTransparencyTable(bitmap) : null;
+    const u32 transparencyCount = transparency ? FreeImage_GetTransparencyCount(bitmap) : 0;
+
+    for(u32 i = 0; i < 256; ++i)
+    {
+        u8 rgba[4];
+        if(colors)
+        {
+            rgba[0] = colors[i].rgbRed;
+            rgba[1] = colors[i].rgbGreen;
+            rgba[2] = colors[i].rgbBlue;
+        }
+        else
+        {
+            rgba[0] = static_cast<u8>(i);
+            rgba[1] = static_cast<u8>(i);
+            rgba[2] = static_cast<u8>(i);
+        }
+        rgba[3] = i < transparencyCount ? transparency[i] : 0xFF;
+
+        ::std::memcpy(&palette[i], rgba, 4);
+    }
+}
+
+TextureLoader::TextureLoadError TextureLoader::decodeTexture(const u8* const data, const uSys size, const wchar_t* const nameHint, DecodedTexture* const texture) noexcept
+{
+    if(!data || !size)
+    { return TextureLoadError::NULL_TEXTURE_DATA; }
 
-    WDynString path = physPath.basePath + physPath.subPath;
-    DynString strPath = StringCast<char>(path);
+    FIMEMORY* const memory = FreeImage_OpenMemory(const_cast<BYTE*>(data), static_cast<DWORD>(size));
+    if(!memory)
+    { return TextureLoadError::TEXTURE_FAILED_TO_LOAD; }
 
-    const char* fileName = strPath.c_str();
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileTypeFromMemory(memory, 0);
 
-    FREE_IMAGE_FORMAT format = FreeImage_GetFileType(fileName);
+    if(format == FIF_UNKNOWN && nameHint)
+    { format = FreeImage_GetFIFFromFilenameU(nameHint); }
 
     if(format == FIF_UNKNOWN)
     {
-        format = FreeImage_GetFIFFromFilename(fileName);
-        ERR_EXIT(TextureLoadError::UNKNOWN_FORMAT, format == FIF_UNKNOWN)
+        FreeImage_CloseMemory(memory);
+        return TextureLoadError::UNKNOWN_FORMAT;
     }
 
-    if(FreeImage_FIFSupportsReading(format)) { texture = FreeImage_Load(format, fileName); }
+    FIBITMAP* bitmap = FreeImage_FIFSupportsReading(format) ? FreeImage_LoadFromMemory(format, memory, 0) : null;
+    FreeImage_CloseMemory(memory);
 
-    ERR_EXIT(TextureLoadError::TEXTURE_FAILED_TO_LOAD, !texture);
+    if(!bitmap)
+    { return TextureLoadError::TEXTURE_FAILED_TO_LOAD; }
 
-    FIBITMAP* tmp = FreeImage_ConvertTo32Bits(texture);
-    FreeImage_Unload(texture);
-    texture = tmp;
+    u32 bitsPerPixel = FreeImage_GetBPP(bitmap);
 
-    BYTE*     textureData  = FreeImage_GetBits(texture);
-    const u32 width        = FreeImage_GetWidth(texture);
-    const u32 height       = FreeImage_GetHeight(texture);
-    const u32 bitsPerPixel = FreeImage_GetBPP(texture);
+    /**
+     *   8, 24 and 32 bit images are converted directly from the
+     * decoded bitmap, anything else is first converted to 32 bits
+     * by FreeImage.
+     */
+    if(FreeImage_GetImageType(bitmap) != FIT_BITMAP || (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32))
+    {
+        FIBITMAP* const converted = FreeImage_ConvertTo32Bits(bitmap);
+        FreeImage_Unload(bitmap);
+        bitmap = converted;
+
+        if(!bitmap)
+        { return TextureLoadError::TEXTURE_FAILED_TO_LOAD; }
+
+        bitsPerPixel = FreeImage_GetBPP(bitmap);
+    }
+
+    const u32 width = FreeImage_GetWidth(bitmap);
+    const u32 height = FreeImage_GetHeight(bitmap);
+
+    TextureLoadError error = TextureLoadError::NONE;
+
+    if(!FreeImage_GetBits(bitmap))
+    { error = TextureLoadError::NULL_TEXTURE_DATA; }
+    else if(!width)
+    { error = TextureLoadError::NULL_WIDTH; }
+    else if(!height)
+    { error = TextureLoadError::NULL_HEIGHT; }
+
+    if(error != TextureLoadError::NONE)
+    {
+        FreeImage_Unload(bitmap);
+        return error;
+    }
+
+    u32 palette[256];
+    if(bitsPerPixel == 8)
+    { buildPalette(bitmap, palette); }
+
+    texture->width = width;
+    texture->height = height;
+    texture->pixels.resize(static_cast<uSys>(width) * height * 4);
+
+    for(u32 y = 0; y < height; ++y)
+    {
+        const u8* const src = FreeImage_GetScanLine(bitmap, static_cast<int>(y));
+        u8* const dst = texture->pixels.data() + static_cast<uSys>(y) * width * 4;
+
+        switch(bitsPerPixel)
+        {
+            case 8:  convertScanline8(src, dst, width, palette); break;
+            case 24: convertScanline24(src, dst, width); break;
+            default: convertScanline32(src, dst, width); break;
+        }
+    }
+
+    FreeImage_Unload(bitmap);
+
+    return TextureLoadError::NONE;
+}
+
+TextureLoader::TextureLoadError TextureLoader::decodeTexture(const CPPRef<IFile>& file, DecodedTexture* const texture) noexcept
+{
+    if(!file)
+    { return TextureLoadError::INVALID_PATH; }
+
+    const CPPRef<MappedFile> mapped = MappedFile::map(file);
+    if(!mapped)
+    { return TextureLoadError::TEXTURE_FAILED_TO_LOAD; }
 
-    ERR_EXIT(TextureLoadError::NULL_TEXTURE_DATA, !textureData);
-    ERR_EXIT(TextureLoadError::NULL_WIDTH, !width);
-    ERR_EXIT(TextureLoadError::NULL_HEIGHT, !height);
-    ERR_EXIT(TextureLoadError::BITS_PER_PIXEL_TOO_SMALL, bitsPerPixel < 8);
-    ERR_EXIT(TextureLoadError::BITS_PER_PIXEL_TOO_LARGE, bitsPerPixel > 32);
+    return decodeTexture(mapped->data(), mapped->size(), file->name(), texture);
+}
 
+NullableRef<IResource> TextureLoader::createTexture(IGraphicsInterface& gi, const DecodedTexture& texture) noexcept
+{
     ResourceTexture2DArgs args;
-    args.width = width;
-    args.height = height;
+    args.width = texture.width;
+    args.height = texture.height;
     args.arrayCount = 1;
     args.mipLevels = 0;
     args.dataFormat = ETexture::Format::RedGreenBlueAlpha8UnsignedInt;
     args.flags = ETexture::BindFlags::ShaderAccess | ETexture::BindFlags::RenderTarget | ETexture::BindFlags::GenerateMipmaps;
 
-    const void* initialBuffers[1] = { textureData };
+    const void* initialBuffers[1] = { texture.pixels.data() };
     args.initialBuffers = initialBuffers;
 
-    const NullableRef<IResource> ret = gi.createResource().buildTauRef(args, null);
+    return gi.createResource().buildTauRef(args, null);
+}
+
+NullableRef<IResource> TextureLoader::loadTexture(IGraphicsInterface& gi, IRenderingContext& context, const char* RESTRICT fileName, TextureLoadError* RESTRICT const error) noexcept
+{
+    PERF();
+    const CPPRef<IFile> file = VFS::Instance().openFile(fileName, FileProps::Read);
 
-    FreeImage_Unload(texture);
+    if(!file)
+    {
+        if(error) { *error = TextureLoadError::INVALID_PATH; }
+        return _missingTexture;
+    }
 
-    if(error) { *error = TextureLoadError::NONE; }
+    DecodedTexture texture;
+    const TextureLoadError decodeError = decodeTexture(file, &texture);
 
-    return ret;
-#undef ERR_EXIT
+    if(error) { *error = decodeError; }
+
+    if(decodeError != TextureLoadError::NONE)
+    { return _missingTexture; }
+
+    return createTexture(gi, texture);
+}
+
+void TextureLoader::loadTextures(IGraphicsInterface& gi, IRenderingContext& context, const char* const* const fileNames, const uSys count, NullableRef<IResource>* const textures, TextureLoadError* const errors, const u32 workerCount) noexcept
+{
+    PERF();
+    TextureDecodeQueue queue(workerCount);
+    ::std::vector<TextureDecodeQueue::Result> results;
+
+    const auto finish = [&]()
+    {
+        for(const TextureDecodeQueue::Result& result : results)
+        {
+            textures[result.id] = result.error == TextureLoadError::NONE ? createTexture(gi, result.texture) : _missingTexture;
+            if(errors) { errors[result.id] = result.error; }
+        }
+        results.clear();
+    };
+
+    for(uSys i = 0; i < count; ++i)
+    {
+        const CPPRef<IFile> file = VFS::Instance().openFile(fileNames[i], FileProps::Read);
+
+        if(!file)
+        {
+            textures[i] = _missingTexture;
+            if(errors) { errors[i] = TextureLoadError::INVALID_PATH; }
+            continue;
+        }
+
+        queue.push(static_cast<u32>(i), file);
+
+        /**
+         * Create anything that has already been decoded while the remaining files are opened.
+         */
+        queue.poll(results, false);
+        finish();
+    }
+
+    while(queue.busy())
+    {
+        queue.poll(results, true);
+        finish();
+    }
 }
 
 static const char* fileNames[6] = {
@@ -284,96 +497,61 @@ NullableRef<IResource> TextureLoader::loadTextureCube(IGraphicsInterface& gi, IR
 #define ERR_EXIT(__ERR, __CHECK) \
     if((__CHECK)) { \
         if(error) { *error = __ERR; } \
-        if(texture) { FreeImage_Unload(texture); } \
         return null; }
 
-    ResourceTexture2DArgs args;
-    args.arrayCount = 6;
-    args.mipLevels = 0;
-    args.dataFormat = ETexture::Format::RedGreenBlueAlpha8UnsignedInt;
-    args.flags = ETexture::BindFlags::ShaderAccess | ETexture::BindFlags::RenderTarget | ETexture::BindFlags::GenerateMipmaps;
-
-    const void* initialBuffers[6];
-    args.initialBuffers = initialBuffers;
-
-    u32 width = 0;
-    u32 height = 0;
-    u32 bitsPerPixel = 0;
-
-    FIBITMAP* textures[6];
+    /**
+     * The faces are independent, so all six are decoded at once.
+     */
+    TextureDecodeQueue queue(6);
 
     for(uSys i = 0; i < 6; ++i)
     {
-        const VFS::Container physPath = VFS::Instance().resolvePath(folderPath, fileNames[i],  fileExtension);
-
-        FIBITMAP* texture = null;
+        const VFS::Container physPath = VFS::Instance().resolvePath(folderPath, fileNames[i], fileExtension);
 
+        ERR_EXIT(TextureLoadError::INVALID_PATH, physPath.fileLoader == null);
         ERR_EXIT(TextureLoadError::INVALID_PATH, physPath.basePath.length() == 0);
         ERR_EXIT(TextureLoadError::INVALID_PATH, physPath.subPath.length() == 0);
 
-        WDynString path = physPath.basePath + physPath.subPath;
-        DynString strPath = StringCast<char>(path);
-
-        const char* fileName = strPath.c_str();
-
-        FREE_IMAGE_FORMAT format = FreeImage_GetFileType(fileName);
+        const CPPRef<IFile> file = physPath.fileLoader->load(physPath.basePath, physPath.subPath, FileProps::Read);
 
-        if(format == FIF_UNKNOWN)
-        {
-            format = FreeImage_GetFIFFromFilename(fileName);
-            ERR_EXIT(TextureLoadError::UNKNOWN_FORMAT, format == FIF_UNKNOWN)
-        }
-
-        if(FreeImage_FIFSupportsReading(format)) { texture = FreeImage_Load(format, fileName); }
-
-        ERR_EXIT(TextureLoadError::TEXTURE_FAILED_TO_LOAD, !texture);
+        ERR_EXIT(TextureLoadError::INVALID_PATH, !file);
 
-        FIBITMAP* tmp = FreeImage_ConvertTo32Bits(texture);
-        FreeImage_Unload(texture);
-        textures[i] = tmp;
-
-        BYTE* textureData = FreeImage_GetBits(textures[i]);
-        const u32 _width = FreeImage_GetWidth(textures[i]);
-        const u32 _height = FreeImage_GetHeight(textures[i]);
-        const u32 _bitsPerPixel = FreeImage_GetBPP(textures[i]);
+        queue.push(static_cast<u32>(i), file);
+    }
 
-        if(width == 0 && height == 0 && bitsPerPixel == 0)
-        {
-            width = _width;
-            height = _height;
-            bitsPerPixel = _bitsPerPixel;
-        }
-        else if(width != _width || height != _height || bitsPerPixel != _bitsPerPixel)
-        {
-            if(error)
-            {
-                *error = TextureLoadError::TEXTURE_SIZES_DONT_MATCH;
-            }
-            return null;
-        }
+    ::std::vector<TextureDecodeQueue::Result> results;
+    results.reserve(6);
 
-        ERR_EXIT(TextureLoadError::NULL_TEXTURE_DATA, !textureData);
-        ERR_EXIT(TextureLoadError::NULL_WIDTH, !width);
-        ERR_EXIT(TextureLoadError::NULL_HEIGHT, !height);
-        ERR_EXIT(TextureLoadError::BITS_PER_PIXEL_TOO_SMALL, bitsPerPixel < 8);
-        ERR_EXIT(TextureLoadError::BITS_PER_PIXEL_TOO_LARGE, bitsPerPixel > 32);
+    while(queue.busy())
+    { queue.poll(results, true); }
 
-        if(i == 0)
-        {
-            args.width = width;
-            args.height = height;
-        }
+    DecodedTexture faces[6];
 
-        initialBuffers[i] = textureData;
+    for(TextureDecodeQueue::Result& result : results)
+    {
+        ERR_EXIT(result.error, result.error != TextureLoadError::NONE);
+        faces[result.id] = ::std::move(result.texture);
     }
 
-    const NullableRef<IResource> ret = gi.createResource().buildTauRef(args, null);
+    ResourceTexture2DArgs args;
+    args.width = faces[0].width;
+    args.height = faces[0].height;
+    args.arrayCount = 6;
+    args.mipLevels = 0;
+    args.dataFormat = ETexture::Format::RedGreenBlueAlpha8UnsignedInt;
+    args.flags = ETexture::BindFlags::ShaderAccess | ETexture::BindFlags::RenderTarget | ETexture::BindFlags::GenerateMipmaps;
+
+    const void* initialBuffers[6];
+    args.initialBuffers = initialBuffers;
 
     for(uSys i = 0; i < 6; ++i)
     {
-        FreeImage_Unload(textures[i]);
+        ERR_EXIT(TextureLoadError::TEXTURE_SIZES_DONT_MATCH, faces[i].width != faces[0].width || faces[i].height != faces[0].height);
+        initialBuffers[i] = faces[i].pixels.data();
     }
 
+    const NullableRef<IResource> ret = gi.createResource().buildTauRef(args, null);
+
     if(error) { *error = TextureLoadError::NONE; }
 
     return ret;
@@ -0,0 +1,84 @@
+#include "texture/TextureDecodeQueue.hpp"
+
+#pragma warning(push, 0)
+#include <thread>
+#pragma warning(pop)
+
+TextureDecodeQueue::TextureDecodeQueue(const u32 workerCount) noexcept
+    : _workerCount(workerCount)
+    , _requests()
+    , _jobs()
+{
+    if(_workerCount == 0)
+    { _workerCount = ::std::thread::hardware_concurrency(); }
+    if(_workerCount == 0)
+    { _workerCount = 1; }
+}
+
+TextureDecodeQueue::~TextureDecodeQueue() noexcept
+{
+    for(::std::future<Result>& job : _jobs)
+    { job.wait(); }
+}
+
+void TextureDecodeQueue::push(const u32 id, const CPPRef<IFile>& file) noexcept
+{
+    _requests.push_back({ id, file, nullptr, 0 });
+    dispatch();
+}
+
+void TextureDecodeQueue::push(const u32 id, const u8* const data, const uSys size) noexcept
+{
+    _requests.push_back({ id, null, data, size });
+    dispatch();
+}
+
+void TextureDecodeQueue::poll(::std::vector<Result>& results, const bool wait) noexcept
+{
+    dispatch();
+
+    if(_jobs.empty())
+    { return; }
+
+    /**
+     *   Requests are dispatched in order and have similar costs,
+     * so the oldest job is the one most likely to finish first.
+     */
+    if(wait)
+    { _jobs.front().wait(); }
+
+    for(auto it = _jobs.begin(); it != _jobs.end();)
+    {
+        if(it->wait_for(::std::chrono::seconds(0)) != ::std::future_status::ready)
+        {
+            ++it;
+            continue;
+        }
+
+        results.push_back(it->get());
+        it = _jobs.erase(it);
+    }
+
+    dispatch();
+}
+
+void TextureDecodeQueue::dispatch() noexcept
+{
+    while(!_requests.empty() && _jobs.size() < _workerCount)
+    {
+        _jobs.push_back(::std::async(::std::launch::async, decode, ::std::move(_requests.front())));
+        _requests.pop_front();
+    }
+}
+
+TextureDecodeQueue::Result TextureDecodeQueue::decode(Request request) noexcept
+{
+    Result result { request.id, TextureLoader::TextureLoadError::NONE, { 0, 0, { } } };
+
+    if(request.file)
+    { result.error = TextureLoader::decodeTexture(request.file, &result.texture); }
+    else
+    { result.error = TextureLoader::decodeTexture(request.data, request.size, nullptr, &result.texture); }
+
+    return result;
+}
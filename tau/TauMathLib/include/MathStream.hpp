@@ -0,0 +1,71 @@
+#pragma once
+
+#include "TauMathLibInternal.h"
+#include "Matrix4x4f.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ *   Functions that process arrays of values at once. Vectors
+ * are stored as structures of arrays, one array per component,
+ * so that every SIMD lane holds a different element. Each
+ * function dispatches to the widest instruction set available,
+ * 4, 8 or 16 elements are processed per iteration and any
+ * remaining elements are processed with narrower lanes.
+ *
+ *   Unless noted otherwise the outputs may alias the inputs,
+ * but may not partially overlap them.
+ */
+namespace MathStream {
+
+/**
+ *   Transforms points by a matrix, w is taken to be 1. The
+ * resulting w is discarded, this does not apply a perspective
+ * divide.
+ */
+TAU_DLL void transformPoints(const Matrix4x4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, ::std::size_t count) NOEXCEPT;
+
+/**
+ *   Transforms directions by the upper 3x3 of a matrix. For
+ * normals the matrix should be the inverse transpose of the
+ * model matrix. The results are not normalized.
+ */
+TAU_DLL void transformNormals(const Matrix4x4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, ::std::size_t count) NOEXCEPT;
+
+/**
+ *   Normalizes 3 component vectors. Zero length vectors are
+ * left as zero rather than becoming NaN.
+ */
+TAU_DLL void normalize(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, ::std::size_t count) NOEXCEPT;
+
+/**
+ *   Tests spheres against a set of planes, such as a frustum.
+ * Each plane is (normal.x, normal.y, normal.z, d), a point is
+ * in front of the plane when dot(normal, point) + d >= 0.
+ *
+ *   `visible` receives 1 for every sphere that is not entirely
+ * behind any of the planes, and 0 otherwise.
+ */
+TAU_DLL void spheresVisible(const Vector4f* planes, ::std::size_t planeCount, const float* centerX, const float* centerY, const float* centerZ, const float* radius, ::std::uint8_t* visible, ::std::size_t count) NOEXCEPT;
+
+/**
+ *   Tests axis aligned bounding boxes, given as their center
+ * and half extents, against a set of planes. The planes are
+ * the same as with spheresVisible.
+ */
+TAU_DLL void aabbsVisible(const Vector4f* planes, ::std::size_t planeCount, const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, ::std::uint8_t* visible, ::std::size_t count) NOEXCEPT;
+
+/**
+ *   Splits 3 component vectors out of an interleaved array,
+ * such as a vertex buffer. `stride` is the distance between
+ * vectors in floats, and must be at least 3.
+ */
+TAU_DLL void aosToSoA(const float* aos, ::std::size_t stride, float* x, float* y, float* z, ::std::size_t count) NOEXCEPT;
+
+/**
+ *   Writes 3 component vectors into an interleaved array. Any
+ * floats between the vectors are left untouched.
+ */
+TAU_DLL void soaToAoS(const float* x, const float* y, const float* z, float* aos, ::std::size_t stride, ::std::size_t count) NOEXCEPT;
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "TauMathSimd.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ *   The stream functions for a single instruction set, these
+ * are built the same way as Matrix4x4fKernels. Matrices are
+ * passed as 16 column major floats and planes as 4 floats
+ * each.
+ */
+struct MathStreamKernels final
+{
+    void (*transformPoints)(const float* matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, ::std::size_t count) NOEXCEPT;
+    void (*transformNormals)(const float* matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, ::std::size_t count) NOEXCEPT;
+    void (*normalize)(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, ::std::size_t count) NOEXCEPT;
+    void (*spheresVisible)(const float* planes, ::std::size_t planeCount, const float* centerX, const float* centerY, const float* centerZ, const float* radius, ::std::uint8_t* visible, ::std::size_t count) NOEXCEPT;
+    void (*aabbsVisible)(const float* planes, ::std::size_t planeCount, const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, ::std::uint8_t* visible, ::std::size_t count) NOEXCEPT;
+    void (*aosToSoA)(const float* aos, ::std::size_t stride, float* x, float* y, float* z, ::std::size_t count) NOEXCEPT;
+    void (*soaToAoS)(const float* x, const float* y, const float* z, float* aos, ::std::size_t stride, ::std::size_t count) NOEXCEPT;
+};
+
+extern const MathStreamKernels mathStreamKernelsSSE41;
+extern const MathStreamKernels mathStreamKernelsAVX2;
+extern const MathStreamKernels mathStreamKernelsAVX512;
+
+/**
+ * The kernels for the active instruction set.
+ */
+const MathStreamKernels& mathStreamKernels() NOEXCEPT;
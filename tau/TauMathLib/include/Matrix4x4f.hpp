@@ -3,6 +3,7 @@
 #include <xmmintrin.h>
 #include "TauMathLibInternal.h"
 #include "Vector4f.hpp"
+#include "Matrix4x4fSimd.hpp"
 
 class TAU_DLL Matrix4x4f final
 {
@@ -32,6 +33,11 @@ public:
 
     static Matrix4x4f add(const Matrix4x4f& a, const Matrix4x4f& b) noexcept;
     static Matrix4x4f sub(const Matrix4x4f& a, const Matrix4x4f& b) noexcept;
+    /**
+     *   Like matrix4x4f_mul this computes `b * a` in column major
+     * terms, so `mul(a, b) * v == b * (a * v)`. The same holds
+     * for operator*.
+     */
     static Matrix4x4f mul(const Matrix4x4f& a, const Matrix4x4f& b) noexcept;
 
     static Matrix4x4f add(const Matrix4x4f& a, float b) noexcept;
@@ -42,6 +48,24 @@ public:
 
     static Vector4f mul(const Matrix4x4f& a, Vector4f b) noexcept;
     static Vector4f mul(Vector4f b, const Matrix4x4f& a) noexcept;
+
+    static Matrix4x4f transpose(const Matrix4x4f& a) noexcept;
+
+    /**
+     *   Inverts a general matrix. A singular matrix returns the
+     * zero matrix, and `invertible`, if provided, is set to
+     * false.
+     */
+    static Matrix4x4f inverse(const Matrix4x4f& a, bool* invertible = nullptr) noexcept;
+
+    /**
+     *   Inverts a matrix whose bottom row is (0, 0, 0, 1), such as
+     * any combination of translation, rotation and scale. This
+     * is considerably cheaper than the general inverse. A
+     * singular matrix returns the zero matrix, and `invertible`,
+     * if provided, is set to false.
+     */
+    static Matrix4x4f affineInverse(const Matrix4x4f& a, bool* invertible = nullptr) noexcept;
 public:
     inline Matrix4x4f() noexcept
     {
@@ -79,4 +103,23 @@ public:
     inline Matrix4x4f& operator=(const Matrix4x4f& copy) noexcept = default;
     inline Matrix4x4f& operator=(Matrix4x4f&& move) noexcept = default;
 
+    [[nodiscard]] inline const __m128* columns() const noexcept { return &col0; }
+    [[nodiscard]] inline       __m128* columns()       noexcept { return &col0; }
 };
+
+/**
+ *   The operators use the inline layer, the static functions
+ * are out of line and dispatch on the processor at runtime.
+ */
+[[nodiscard]] static inline Matrix4x4f operator*(const Matrix4x4f& a, const Matrix4x4f& b) noexcept
+{
+    Matrix4x4f ret;
+    TAU_MATH_SIMD_NS::matrix4x4f_mul(a.columns(), b.columns(), ret.columns());
+    return ret;
+}
+
+[[nodiscard]] static inline Vector4f operator*(const Matrix4x4f& a, const Vector4f b) noexcept
+{ return TAU_MATH_SIMD_NS::matrix4x4f_mulVector(a.columns(), b.vec); }
+
+[[nodiscard]] static inline Vector4f operator*(const Vector4f b, const Matrix4x4f& a) noexcept
+{ return TAU_MATH_SIMD_NS::matrix4x4f_mulVectorTransposed(a.columns(), b.vec); }
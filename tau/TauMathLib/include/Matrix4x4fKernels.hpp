@@ -0,0 +1,27 @@
+#pragma once
+
+#include "TauMathSimd.hpp"
+
+/**
+ *   The out of line matrix functions for a single instruction
+ * set. Every instruction set has its own table built in its own
+ * translation unit, the Matrix4x4f entry points call through
+ * the table for the active instruction set.
+ */
+struct Matrix4x4fKernels final
+{
+    void (*mul)(const __m128* a, const __m128* b, __m128* store) NOEXCEPT;
+    __m128 (*mulVector)(const __m128* a, __m128 b) NOEXCEPT;
+    __m128 (*mulVectorTransposed)(const __m128* a, __m128 b) NOEXCEPT;
+    void (*transpose)(const __m128* a, __m128* store) NOEXCEPT;
+    float (*inverse)(const __m128* a, __m128* store) NOEXCEPT;
+    float (*affineInverse)(const __m128* a, __m128* store) NOEXCEPT;
+};
+
+extern const Matrix4x4fKernels matrix4x4fKernelsSSE41;
+extern const Matrix4x4fKernels matrix4x4fKernelsAVX2;
+
+/**
+ * The kernels for the active instruction set.
+ */
+const Matrix4x4fKernels& matrix4x4fKernels() NOEXCEPT;
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "TauMathSimd.hpp"
+
+/**
+ *   Inline equivalents of the functions in Matrix4x4fIntrin.h,
+ * along with the inverse functions that have no IR version.
+ *
+ *   Matrices are column major, passed as 4 column vectors. The
+ * store may alias the input.
+ */
+namespace TAU_MATH_SIMD_NS {
+
+TAU_MATH_INLINE __m128 matrix4x4f_mulVector(const __m128* const a, const __m128 b) NOEXCEPT
+{
+    __m128 ret = _mm_mul_ps(a[0], splat<0>(b));
+    ret = madd(a[1], splat<1>(b), ret);
+    ret = madd(a[2], splat<2>(b), ret);
+    return madd(a[3], splat<3>(b), ret);
+}
+
+TAU_MATH_INLINE void matrix4x4f_transpose(const __m128* const a, __m128* const store) NOEXCEPT
+{
+    __m128 c0 = a[0];
+    __m128 c1 = a[1];
+    __m128 c2 = a[2];
+    __m128 c3 = a[3];
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    store[0] = c0;
+    store[1] = c1;
+    store[2] = c2;
+    store[3] = c3;
+}
+
+/**
+ * The vector is treated as a row vector, this is equivalent to transpose(a) * b.
+ */
+TAU_MATH_INLINE __m128 matrix4x4f_mulVectorTransposed(const __m128* const a, const __m128 b) NOEXCEPT
+{
+    __m128 transposed[4];
+    matrix4x4f_transpose(a, transposed);
+    return matrix4x4f_mulVector(transposed, b);
+}
+
+/**
+ *   Matches matrix4x4f_mul in Matrix4x4fIntrin.h, which with
+ * the column major layout computes `b * a`, the product that
+ * applies `a` first and then `b`.
+ */
+TAU_MATH_INLINE void matrix4x4f_mul(const __m128* const a, const __m128* const b, __m128* const store) NOEXCEPT
+{
+    const __m128* const lhs = b;
+    const __m128* const rhs = a;
+
+#if TAU_MATH_AVX
+    /**
+     *   Two columns of the result are computed at once, each
+     * column of `lhs` is duplicated into both halves of a 256 bit
+     * register.
+     */
+    const __m256 l0 = _mm256_set_m128(lhs[0], lhs[0]);
+    const __m256 l1 = _mm256_set_m128(lhs[1], lhs[1]);
+    const __m256 l2 = _mm256_set_m128(lhs[2], lhs[2]);
+    const __m256 l3 = _mm256_set_m128(lhs[3], lhs[3]);
+
+    const __m256 rhs01 = _mm256_set_m128(rhs[1], rhs[0]);
+    const __m256 rhs23 = _mm256_set_m128(rhs[3], rhs[2]);
+
+  #if TAU_MATH_FMA
+    #define TAU_MATH_MADD256(_A, _B, _C) _mm256_fmadd_ps(_A, _B, _C)
+  #else
+    #define TAU_MATH_MADD256(_A, _B, _C) _mm256_add_ps(_mm256_mul_ps(_A, _B), _C)
+  #endif
+
+    __m256 r01 = _mm256_mul_ps(l0, _mm256_shuffle_ps(rhs01, rhs01, 0x00));
+    __m256 r23 = _mm256_mul_ps(l0, _mm256_shuffle_ps(rhs23, rhs23, 0x00));
+    r01 = TAU_MATH_MADD256(l1, _mm256_shuffle_ps(rhs01, rhs01, 0x55), r01);
+    r23 = TAU_MATH_MADD256(l1, _mm256_shuffle_ps(rhs23, rhs23, 0x55), r23);
+    r01 = TAU_MATH_MADD256(l2, _mm256_shuffle_ps(rhs01, rhs01, 0xAA), r01);
+    r23 = TAU_MATH_MADD256(l2, _mm256_shuffle_ps(rhs23, rhs23, 0xAA), r23);
+    r01 = TAU_MATH_MADD256(l3, _mm256_shuffle_ps(rhs01, rhs01, 0xFF), r01);
+    r23 = TAU_MATH_MADD256(l3, _mm256_shuffle_ps(rhs23, rhs23, 0xFF), r23);
+
+  #undef TAU_MATH_MADD256
+
+    store[0] = _mm256_castps256_ps128(r01);
+    store[1] = _mm256_extractf128_ps(r01, 1);
+    store[2] = _mm256_castps256_ps128(r23);
+    store[3] = _mm256_extractf128_ps(r23, 1);
+#else
+    const __m128 c0 = matrix4x4f_mulVector(lhs, rhs[0]);
+    const __m128 c1 = matrix4x4f_mulVector(lhs, rhs[1]);
+    const __m128 c2 = matrix4x4f_mulVector(lhs, rhs[2]);
+    const __m128 c3 = matrix4x4f_mulVector(lhs, rhs[3]);
+    store[0] = c0;
+    store[1] = c1;
+    store[2] = c2;
+    store[3] = c3;
+#endif
+}
+
+/**
+ *   The helpers below operate on a 2x2 matrix packed into a
+ * single vector as (m00, m01, m10, m11).
+ */
+
+/**
+ * a * b
+ */
+TAU_MATH_INLINE __m128 matrix2x2f_mul(const __m128 a, const __m128 b) NOEXCEPT
+{ return madd(a, swizzle<0, 3, 0, 3>(b), _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b))); }
+
+/**
+ * adjugate(a) * b
+ */
+TAU_MATH_INLINE __m128 matrix2x2f_adjMul(const __m128 a, const __m128 b) NOEXCEPT
+{ return nmadd(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b), _mm_mul_ps(swizzle<3, 3, 0, 0>(a), b)); }
+
+/**
+ * a * adjugate(b)
+ */
+TAU_MATH_INLINE __m128 matrix2x2f_mulAdj(const __m128 a, const __m128 b) NOEXCEPT
+{ return nmadd(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b), _mm_mul_ps(a, swizzle<3, 0, 3, 0>(b))); }
+
+/**
+ *   Inverts a general matrix by splitting it into 2x2 blocks
+ * and applying the block inversion formula. The blocks are
+ * taken from the columns, which yields the inverse of the
+ * transpose laid out by rows, i.e. the inverse by columns.
+ *
+ * @return
+ *      The determinant. If it is 0 the matrix is singular and
+ *    the store is not modified.
+ */
+TAU_MATH_INLINE float matrix4x4f_inverse(const __m128* const m, __m128* const store) NOEXCEPT
+{
+    const __m128 a = _mm_movelh_ps(m[0], m[1]);
+    const __m128 b = _mm_movehl_ps(m[1], m[0]);
+    const __m128 c = _mm_movelh_ps(m[2], m[3]);
+    const __m128 d = _mm_movehl_ps(m[3], m[2]);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 subDeterminants = nmadd(shuffle<1, 3, 1, 3>(m[0], m[2]), shuffle<0, 2, 0, 2>(m[1], m[3]),
+                                         _mm_mul_ps(shuffle<0, 2, 0, 2>(m[0], m[2]), shuffle<1, 3, 1, 3>(m[1], m[3])));
+    const __m128 detA = splat<0>(subDeterminants);
+    const __m128 detB = splat<1>(subDeterminants);
+    const __m128 detC = splat<2>(subDeterminants);
+    const __m128 detD = splat<3>(subDeterminants);
+
+    const __m128 dAdjC = matrix2x2f_adjMul(d, c);
+    const __m128 aAdjB = matrix2x2f_adjMul(a, b);
+
+    // |D|A - B(D#C)
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), matrix2x2f_mul(b, dAdjC));
+    // |A|D - C(A#B)
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), matrix2x2f_mul(c, aAdjB));
+    // |B|C - D(A#B)#
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), matrix2x2f_mulAdj(d, aAdjB));
+    // |C|B - A(D#C)#
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), matrix2x2f_mulAdj(a, dAdjC));
+
+    // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+    const __m128 trace = hsum(_mm_mul_ps(aAdjB, swizzle<0, 2, 1, 3>(dAdjC)));
+    const __m128 determinant = _mm_sub_ps(madd(detB, detC, _mm_mul_ps(detA, detD)), trace);
+
+    const float det = _mm_cvtss_f32(determinant);
+    if(det == 0.0f)
+    { return 0.0f; }
+
+    const __m128 invDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+    x = _mm_mul_ps(x, invDeterminant);
+    y = _mm_mul_ps(y, invDeterminant);
+    z = _mm_mul_ps(z, invDeterminant);
+    w = _mm_mul_ps(w, invDeterminant);
+
+    // Applies the adjugate of each block while storing.
+    store[0] = shuffle<3, 1, 3, 1>(x, y);
+    store[1] = shuffle<2, 0, 2, 0>(x, y);
+    store[2] = shuffle<3, 1, 3, 1>(z, w);
+    store[3] = shuffle<2, 0, 2, 0>(z, w);
+
+    return det;
+}
+
+/**
+ *   Inverts a matrix whose bottom row is (0, 0, 0, 1), such as
+ * any combination of translation, rotation and scale. This is
+ * considerably cheaper than the general inverse.
+ *
+ * @return
+ *      The determinant of the upper 3x3. If it is 0 the matrix
+ *    is singular and the store is not modified.
+ */
+TAU_MATH_INLINE float matrix4x4f_affineInverse(const __m128* const m, __m128* const store) NOEXCEPT
+{
+    const __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 c0 = _mm_and_ps(m[0], wMask);
+    const __m128 c1 = _mm_and_ps(m[1], wMask);
+    const __m128 c2 = _mm_and_ps(m[2], wMask);
+
+    // The rows of the adjugate of the upper 3x3.
+    __m128 r0 = cross3(c1, c2);
+    __m128 r1 = cross3(c2, c0);
+    __m128 r2 = cross3(c0, c1);
+
+    const __m128 determinant = dot3(c0, r0);
+    const float det = _mm_cvtss_f32(determinant);
+    if(det == 0.0f)
+    { return 0.0f; }
+
+    const __m128 invDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), determinant);
+    r0 = _mm_mul_ps(r0, invDeterminant);
+    r1 = _mm_mul_ps(r1, invDeterminant);
+    r2 = _mm_mul_ps(r2, invDeterminant);
+    __m128 r3 = _mm_setzero_ps();
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    const __m128 t = m[3];
+    __m128 translation = _mm_mul_ps(r0, splat<0>(t));
+    translation = madd(r1, splat<1>(t), translation);
+    translation = madd(r2, splat<2>(t), translation);
+
+    store[0] = r0;
+    store[1] = r1;
+    store[2] = r2;
+    store[3] = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation);
+
+    return det;
+}
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "TauMathLibInternal.h"
+#include <immintrin.h>
+
+/**
+ *   The instruction sets the inline math layer is compiled for,
+ * these are derived from the flags of the translation unit that
+ * includes it. MSVC does not define the SSE4.1 or FMA macros,
+ * it only signals AVX and AVX2.
+ */
+#if defined(__SSE4_1__) || defined(__AVX__)
+  #define TAU_MATH_SSE41 1
+#else
+  #define TAU_MATH_SSE41 0
+#endif
+
+#if defined(__AVX__)
+  #define TAU_MATH_AVX 1
+#else
+  #define TAU_MATH_AVX 0
+#endif
+
+#if defined(__AVX512F__)
+  #define TAU_MATH_AVX512 1
+#else
+  #define TAU_MATH_AVX512 0
+#endif
+
+#if defined(__FMA__) || defined(__AVX2__)
+  #define TAU_MATH_FMA 1
+#else
+  #define TAU_MATH_FMA 0
+#endif
+
+#ifdef _MSC_VER
+  #define TAU_MATH_INLINE __forceinline
+#else
+  #define TAU_MATH_INLINE inline __attribute__((always_inline))
+#endif
+
+/**
+ *   The namespace the inline layer is placed in. Translation
+ * units that are compiled for a higher instruction set than
+ * the rest of the program must override this before including
+ * any of the SIMD headers. Otherwise the linker is free to pick
+ * their copy of an inline function for the entire program,
+ * which would then fault on older processors.
+ */
+#ifndef TAU_MATH_SIMD_NS
+  #define TAU_MATH_SIMD_NS simd
+#endif
+
+/**
+ * The instruction sets the out of line entry points are built for.
+ */
+enum class MathISA
+{
+    SSE41 = 0,
+    AVX2,
+    /**
+     *   Only the stream kernels have an AVX-512 version, the
+     * single value functions use the AVX2 version.
+     */
+    AVX512
+};
+
+/**
+ * Detects the highest supported instruction set of this processor.
+ */
+TAU_DLL MathISA mathDetectISA() NOEXCEPT;
+
+/**
+ * The instruction set the out of line entry points dispatch to.
+ */
+TAU_DLL MathISA mathActiveISA() NOEXCEPT;
+
+/**
+ *   Overrides the instruction set the out of line entry points
+ * dispatch to, this is clamped to the detected instruction set.
+ * Intended for testing and benchmarking each path.
+ *
+ * @return
+ *      The instruction set that is now active.
+ */
+TAU_DLL MathISA mathForceISA(MathISA isa) NOEXCEPT;
+
+namespace TAU_MATH_SIMD_NS {
+
+/**
+ * a * b + c
+ */
+TAU_MATH_INLINE __m128 madd(const __m128 a, const __m128 b, const __m128 c) NOEXCEPT
+{
+#if TAU_MATH_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+/**
+ * c - a * b
+ */
+TAU_MATH_INLINE __m128 nmadd(const __m128 a, const __m128 b, const __m128 c) NOEXCEPT
+{
+#if TAU_MATH_FMA
+    return _mm_fnmadd_ps(a, b, c);
+#else
+    return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+}
+
+template<int _X, int _Y, int _Z, int _W>
+TAU_MATH_INLINE __m128 swizzle(const __m128 a) NOEXCEPT
+{ return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(a), _MM_SHUFFLE(_W, _Z, _Y, _X))); }
+
+template<int _X, int _Y, int _Z, int _W>
+TAU_MATH_INLINE __m128 shuffle(const __m128 a, const __m128 b) NOEXCEPT
+{ return _mm_shuffle_ps(a, b, _MM_SHUFFLE(_W, _Z, _Y, _X)); }
+
+template<int _I>
+TAU_MATH_INLINE __m128 splat(const __m128 a) NOEXCEPT
+{ return swizzle<_I, _I, _I, _I>(a); }
+
+/**
+ * Sums every component, the result is in every lane.
+ */
+TAU_MATH_INLINE __m128 hsum(const __m128 a) NOEXCEPT
+{
+    const __m128 pairs = _mm_add_ps(a, swizzle<1, 0, 3, 2>(a));
+    return _mm_add_ps(pairs, swizzle<2, 3, 0, 1>(pairs));
+}
+
+/**
+ * The 4 component dot product, the result is in every lane.
+ */
+TAU_MATH_INLINE __m128 dot4(const __m128 a, const __m128 b) NOEXCEPT
+{
+#if TAU_MATH_SSE41
+    return _mm_dp_ps(a, b, 0xFF);
+#else
+    return hsum(_mm_mul_ps(a, b));
+#endif
+}
+
+/**
+ * The 3 component dot product, the result is in every lane.
+ */
+TAU_MATH_INLINE __m128 dot3(const __m128 a, const __m128 b) NOEXCEPT
+{
+#if TAU_MATH_SSE41
+    return _mm_dp_ps(a, b, 0x7F);
+#else
+    const __m128 mul = _mm_mul_ps(a, b);
+    return _mm_add_ps(_mm_add_ps(splat<0>(mul), splat<1>(mul)), splat<2>(mul));
+#endif
+}
+
+/**
+ * The 3 component cross product, the w component is 0 if a.w == b.w.
+ */
+TAU_MATH_INLINE __m128 cross3(const __m128 a, const __m128 b) NOEXCEPT
+{
+    const __m128 aYZX = swizzle<1, 2, 0, 3>(a);
+    const __m128 bYZX = swizzle<1, 2, 0, 3>(b);
+    const __m128 c = nmadd(aYZX, b, _mm_mul_ps(a, bYZX));
+    return swizzle<1, 2, 0, 3>(c);
+}
+
+}
@@ -2,6 +2,7 @@
 
 #include <xmmintrin.h>
 #include "TauMathLibInternal.h"
+#include "Vector4fSimd.hpp"
 
 class TAU_DLL Vector4f final
 {
@@ -90,13 +91,13 @@ public:
 };
 
 [[nodiscard]] static inline Vector4f operator+(const Vector4f a, const Vector4f b) noexcept
-{ return Vector4f::add(a, b); }
+{ return TAU_MATH_SIMD_NS::vector4f_add(a.vec, b.vec); }
 
 [[nodiscard]] static inline Vector4f operator-(const Vector4f a, const Vector4f b) noexcept
-{ return Vector4f::sub(a, b); }
+{ return TAU_MATH_SIMD_NS::vector4f_sub(a.vec, b.vec); }
 
 [[nodiscard]] static inline Vector4f operator*(const Vector4f a, const Vector4f b) noexcept
-{ return Vector4f::mul(a, b); }
+{ return TAU_MATH_SIMD_NS::vector4f_mul(a.vec, b.vec); }
 
 [[nodiscard]] static inline Vector4f operator/(const Vector4f a, const Vector4f b) noexcept
-{ return Vector4f::div(a, b); }
+{ return TAU_MATH_SIMD_NS::vector4f_div(a.vec, b.vec); }
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "TauMathSimd.hpp"
+
+/**
+ *   Inline equivalents of the functions in Vector4fIntrin.h.
+ * These can be inlined into the caller, unlike the IR versions
+ * which are always a call into the library.
+ */
+namespace TAU_MATH_SIMD_NS {
+
+TAU_MATH_INLINE __m128 vector4f_add(const __m128 a, const __m128 b) NOEXCEPT
+{ return _mm_add_ps(a, b); }
+
+TAU_MATH_INLINE __m128 vector4f_sub(const __m128 a, const __m128 b) NOEXCEPT
+{ return _mm_sub_ps(a, b); }
+
+TAU_MATH_INLINE __m128 vector4f_mul(const __m128 a, const __m128 b) NOEXCEPT
+{ return _mm_mul_ps(a, b); }
+
+TAU_MATH_INLINE __m128 vector4f_div(const __m128 a, const __m128 b) NOEXCEPT
+{ return _mm_div_ps(a, b); }
+
+TAU_MATH_INLINE __m128 vector4f_addScalar(const __m128 a, const float b) NOEXCEPT
+{ return _mm_add_ps(a, _mm_set1_ps(b)); }
+
+TAU_MATH_INLINE __m128 vector4f_subScalar(const __m128 a, const float b) NOEXCEPT
+{ return _mm_sub_ps(a, _mm_set1_ps(b)); }
+
+TAU_MATH_INLINE __m128 vector4f_mulScalar(const __m128 a, const float b) NOEXCEPT
+{ return _mm_mul_ps(a, _mm_set1_ps(b)); }
+
+TAU_MATH_INLINE __m128 vector4f_divScalar(const __m128 a, const float b) NOEXCEPT
+{ return _mm_div_ps(a, _mm_set1_ps(b)); }
+
+TAU_MATH_INLINE __m128 vector4f_divScalarInv(const float a, const __m128 b) NOEXCEPT
+{ return _mm_div_ps(_mm_set1_ps(a), b); }
+
+TAU_MATH_INLINE __m128 vector4f_neg(const __m128 a) NOEXCEPT
+{ return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+TAU_MATH_INLINE float vector4f_dot(const __m128 a, const __m128 b) NOEXCEPT
+{ return _mm_cvtss_f32(dot4(a, b)); }
+
+TAU_MATH_INLINE float vector4f_magnitudeSquared(const __m128 a) NOEXCEPT
+{ return _mm_cvtss_f32(dot4(a, a)); }
+
+TAU_MATH_INLINE float vector4f_magnitude(const __m128 a) NOEXCEPT
+{ return _mm_cvtss_f32(_mm_sqrt_ss(dot4(a, a))); }
+
+/**
+ * Uses the reciprocal square root approximation.
+ */
+TAU_MATH_INLINE float vector4f_inverseMagnitude(const __m128 a) NOEXCEPT
+{ return _mm_cvtss_f32(_mm_rsqrt_ss(dot4(a, a))); }
+
+/**
+ * Uses the reciprocal square root approximation.
+ */
+TAU_MATH_INLINE __m128 vector4f_normalizeFast(const __m128 a) NOEXCEPT
+{ return _mm_mul_ps(a, _mm_rsqrt_ps(dot4(a, a))); }
+
+TAU_MATH_INLINE __m128 vector4f_normalizeExact(const __m128 a) NOEXCEPT
+{ return _mm_div_ps(a, _mm_sqrt_ps(dot4(a, a))); }
+
+}
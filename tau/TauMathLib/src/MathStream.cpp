@@ -0,0 +1,23 @@
+#include "MathStream.hpp"
+#include "MathStreamKernels.hpp"
+
+void MathStream::transformPoints(const Matrix4x4f& matrix, const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().transformPoints(matrix.mRaw, x, y, z, outX, outY, outZ, count); }
+
+void MathStream::transformNormals(const Matrix4x4f& matrix, const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().transformNormals(matrix.mRaw, x, y, z, outX, outY, outZ, count); }
+
+void MathStream::normalize(const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().normalize(x, y, z, outX, outY, outZ, count); }
+
+void MathStream::spheresVisible(const Vector4f* const planes, const ::std::size_t planeCount, const float* const centerX, const float* const centerY, const float* const centerZ, const float* const radius, ::std::uint8_t* const visible, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().spheresVisible(reinterpret_cast<const float*>(planes), planeCount, centerX, centerY, centerZ, radius, visible, count); }
+
+void MathStream::aabbsVisible(const Vector4f* const planes, const ::std::size_t planeCount, const float* const centerX, const float* const centerY, const float* const centerZ, const float* const extentX, const float* const extentY, const float* const extentZ, ::std::uint8_t* const visible, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().aabbsVisible(reinterpret_cast<const float*>(planes), planeCount, centerX, centerY, centerZ, extentX, extentY, extentZ, visible, count); }
+
+void MathStream::aosToSoA(const float* const aos, const ::std::size_t stride, float* const x, float* const y, float* const z, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().aosToSoA(aos, stride, x, y, z, count); }
+
+void MathStream::soaToAoS(const float* const x, const float* const y, const float* const z, float* const aos, const ::std::size_t stride, const ::std::size_t count) NOEXCEPT
+{ mathStreamKernels().soaToAoS(x, y, z, aos, stride, count); }
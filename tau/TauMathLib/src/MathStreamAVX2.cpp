@@ -0,0 +1,7 @@
+/**
+ *   This file is compiled with AVX2 and FMA enabled, it is only
+ * called once the processor has been checked for support.
+ */
+#define TAU_MATH_SIMD_NS simd_avx2
+#define TAU_MATH_STREAM_KERNEL_TABLE mathStreamKernelsAVX2
+#include "MathStreamKernels.inl"
@@ -0,0 +1,7 @@
+/**
+ *   This file is compiled with AVX-512F enabled, it is only
+ * called once the processor has been checked for support.
+ */
+#define TAU_MATH_SIMD_NS simd_avx512
+#define TAU_MATH_STREAM_KERNEL_TABLE mathStreamKernelsAVX512
+#include "MathStreamKernels.inl"
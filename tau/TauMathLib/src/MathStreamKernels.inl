@@ -0,0 +1,372 @@
+/**
+ *   Builds a stream kernel table. The including file must
+ * define TAU_MATH_SIMD_NS and TAU_MATH_STREAM_KERNEL_TABLE
+ * before including this, and must not include any other header
+ * with inline functions outside of TAU_MATH_SIMD_NS.
+ *
+ *   Every kernel is written once against a lane type, it is
+ * then run with the widest lanes of the instruction set, and
+ * the tail with 4 and finally 1 lane.
+ */
+#include "MathStreamKernels.hpp"
+
+namespace TAU_MATH_SIMD_NS {
+
+struct Lane1 final
+{
+    using V = float;
+    using M = bool;
+    static constexpr ::std::size_t Width = 1;
+
+    static TAU_MATH_INLINE V load(const float* const p) NOEXCEPT { return *p; }
+    static TAU_MATH_INLINE void store(float* const p, const V v) NOEXCEPT { *p = v; }
+    static TAU_MATH_INLINE V set1(const float f) NOEXCEPT { return f; }
+    static TAU_MATH_INLINE V add(const V a, const V b) NOEXCEPT { return a + b; }
+    static TAU_MATH_INLINE V mul(const V a, const V b) NOEXCEPT { return a * b; }
+    static TAU_MATH_INLINE V div(const V a, const V b) NOEXCEPT { return a / b; }
+    static TAU_MATH_INLINE V madd(const V a, const V b, const V c) NOEXCEPT { return a * b + c; }
+    static TAU_MATH_INLINE V sqrt(const V a) NOEXCEPT { return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(a))); }
+    static TAU_MATH_INLINE V neg(const V a) NOEXCEPT { return -a; }
+    static TAU_MATH_INLINE M cmpGT(const V a, const V b) NOEXCEPT { return a > b; }
+    static TAU_MATH_INLINE M cmpGE(const V a, const V b) NOEXCEPT { return a >= b; }
+    static TAU_MATH_INLINE M maskAll() NOEXCEPT { return true; }
+    static TAU_MATH_INLINE M maskAnd(const M a, const M b) NOEXCEPT { return a && b; }
+    static TAU_MATH_INLINE V zeroUnless(const V v, const M m) NOEXCEPT { return m ? v : 0.0f; }
+    static TAU_MATH_INLINE ::std::uint32_t bits(const M m) NOEXCEPT { return m ? 1 : 0; }
+};
+
+struct Lane4 final
+{
+    using V = __m128;
+    using M = __m128;
+    static constexpr ::std::size_t Width = 4;
+
+    static TAU_MATH_INLINE V load(const float* const p) NOEXCEPT { return _mm_loadu_ps(p); }
+    static TAU_MATH_INLINE void store(float* const p, const V v) NOEXCEPT { _mm_storeu_ps(p, v); }
+    static TAU_MATH_INLINE V set1(const float f) NOEXCEPT { return _mm_set1_ps(f); }
+    static TAU_MATH_INLINE V add(const V a, const V b) NOEXCEPT { return _mm_add_ps(a, b); }
+    static TAU_MATH_INLINE V mul(const V a, const V b) NOEXCEPT { return _mm_mul_ps(a, b); }
+    static TAU_MATH_INLINE V div(const V a, const V b) NOEXCEPT { return _mm_div_ps(a, b); }
+    static TAU_MATH_INLINE V madd(const V a, const V b, const V c) NOEXCEPT { return TAU_MATH_SIMD_NS::madd(a, b, c); }
+    static TAU_MATH_INLINE V sqrt(const V a) NOEXCEPT { return _mm_sqrt_ps(a); }
+    static TAU_MATH_INLINE V neg(const V a) NOEXCEPT { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+    static TAU_MATH_INLINE M cmpGT(const V a, const V b) NOEXCEPT { return _mm_cmpgt_ps(a, b); }
+    static TAU_MATH_INLINE M cmpGE(const V a, const V b) NOEXCEPT { return _mm_cmpge_ps(a, b); }
+    static TAU_MATH_INLINE M maskAll() NOEXCEPT { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static TAU_MATH_INLINE M maskAnd(const M a, const M b) NOEXCEPT { return _mm_and_ps(a, b); }
+    static TAU_MATH_INLINE V zeroUnless(const V v, const M m) NOEXCEPT { return _mm_and_ps(v, m); }
+    static TAU_MATH_INLINE ::std::uint32_t bits(const M m) NOEXCEPT { return static_cast<::std::uint32_t>(_mm_movemask_ps(m)); }
+};
+
+#if TAU_MATH_AVX
+struct Lane8 final
+{
+    using V = __m256;
+    using M = __m256;
+    static constexpr ::std::size_t Width = 8;
+
+    static TAU_MATH_INLINE V load(const float* const p) NOEXCEPT { return _mm256_loadu_ps(p); }
+    static TAU_MATH_INLINE void store(float* const p, const V v) NOEXCEPT { _mm256_storeu_ps(p, v); }
+    static TAU_MATH_INLINE V set1(const float f) NOEXCEPT { return _mm256_set1_ps(f); }
+    static TAU_MATH_INLINE V add(const V a, const V b) NOEXCEPT { return _mm256_add_ps(a, b); }
+    static TAU_MATH_INLINE V mul(const V a, const V b) NOEXCEPT { return _mm256_mul_ps(a, b); }
+    static TAU_MATH_INLINE V div(const V a, const V b) NOEXCEPT { return _mm256_div_ps(a, b); }
+    static TAU_MATH_INLINE V madd(const V a, const V b, const V c) NOEXCEPT
+    {
+  #if TAU_MATH_FMA
+        return _mm256_fmadd_ps(a, b, c);
+  #else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+  #endif
+    }
+    static TAU_MATH_INLINE V sqrt(const V a) NOEXCEPT { return _mm256_sqrt_ps(a); }
+    static TAU_MATH_INLINE V neg(const V a) NOEXCEPT { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+    static TAU_MATH_INLINE M cmpGT(const V a, const V b) NOEXCEPT { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static TAU_MATH_INLINE M cmpGE(const V a, const V b) NOEXCEPT { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static TAU_MATH_INLINE M maskAll() NOEXCEPT { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static TAU_MATH_INLINE M maskAnd(const M a, const M b) NOEXCEPT { return _mm256_and_ps(a, b); }
+    static TAU_MATH_INLINE V zeroUnless(const V v, const M m) NOEXCEPT { return _mm256_and_ps(v, m); }
+    static TAU_MATH_INLINE ::std::uint32_t bits(const M m) NOEXCEPT { return static_cast<::std::uint32_t>(_mm256_movemask_ps(m)); }
+};
+#endif
+
+#if TAU_MATH_AVX512
+struct Lane16 final
+{
+    using V = __m512;
+    using M = __mmask16;
+    static constexpr ::std::size_t Width = 16;
+
+    static TAU_MATH_INLINE V load(const float* const p) NOEXCEPT { return _mm512_loadu_ps(p); }
+    static TAU_MATH_INLINE void store(float* const p, const V v) NOEXCEPT { _mm512_storeu_ps(p, v); }
+    static TAU_MATH_INLINE V set1(const float f) NOEXCEPT { return _mm512_set1_ps(f); }
+    static TAU_MATH_INLINE V add(const V a, const V b) NOEXCEPT { return _mm512_add_ps(a, b); }
+    static TAU_MATH_INLINE V mul(const V a, const V b) NOEXCEPT { return _mm512_mul_ps(a, b); }
+    static TAU_MATH_INLINE V div(const V a, const V b) NOEXCEPT { return _mm512_div_ps(a, b); }
+    static TAU_MATH_INLINE V madd(const V a, const V b, const V c) NOEXCEPT { return _mm512_fmadd_ps(a, b, c); }
+    static TAU_MATH_INLINE V sqrt(const V a) NOEXCEPT { return _mm512_sqrt_ps(a); }
+    static TAU_MATH_INLINE V neg(const V a) NOEXCEPT { return _mm512_sub_ps(_mm512_setzero_ps(), a); }
+    static TAU_MATH_INLINE M cmpGT(const V a, const V b) NOEXCEPT { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static TAU_MATH_INLINE M cmpGE(const V a, const V b) NOEXCEPT { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+    static TAU_MATH_INLINE M maskAll() NOEXCEPT { return static_cast<M>(0xFFFF); }
+    static TAU_MATH_INLINE M maskAnd(const M a, const M b) NOEXCEPT { return static_cast<M>(a & b); }
+    static TAU_MATH_INLINE V zeroUnless(const V v, const M m) NOEXCEPT { return _mm512_maskz_mov_ps(m, v); }
+    static TAU_MATH_INLINE ::std::uint32_t bits(const M m) NOEXCEPT { return static_cast<::std::uint32_t>(m); }
+};
+#endif
+
+#if TAU_MATH_AVX512
+  #define TAU_MATH_WIDE_LANE Lane16
+#elif TAU_MATH_AVX
+  #define TAU_MATH_WIDE_LANE Lane8
+#endif
+
+/**
+ *   Runs a kernel over [0, count) with the widest lanes first,
+ * each lane width picks up where the previous one stopped.
+ */
+#ifdef TAU_MATH_WIDE_LANE
+  #define TAU_MATH_RUN_LANES(_KERNEL, ...) do { \
+        ::std::size_t _i = _KERNEL<TAU_MATH_WIDE_LANE>(0, __VA_ARGS__); \
+        _i = _KERNEL<Lane4>(_i, __VA_ARGS__); \
+        (void) _KERNEL<Lane1>(_i, __VA_ARGS__); \
+    } while(0)
+#else
+  #define TAU_MATH_RUN_LANES(_KERNEL, ...) do { \
+        const ::std::size_t _i = _KERNEL<Lane4>(0, __VA_ARGS__); \
+        (void) _KERNEL<Lane1>(_i, __VA_ARGS__); \
+    } while(0)
+#endif
+
+template<typename _L>
+static TAU_MATH_INLINE void storeMask(::std::uint8_t* const out, const typename _L::M mask) NOEXCEPT
+{
+    const ::std::uint32_t bits = _L::bits(mask);
+    for(::std::size_t j = 0; j < _L::Width; ++j)
+    { out[j] = static_cast<::std::uint8_t>((bits >> j) & 1); }
+}
+
+template<typename _L>
+static TAU_MATH_INLINE ::std::size_t transformLanes(::std::size_t i, const float* const m, const bool translate, const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{
+    using V = typename _L::V;
+
+    const V m00 = _L::set1(m[0]), m01 = _L::set1(m[1]), m02 = _L::set1(m[2]);
+    const V m10 = _L::set1(m[4]), m11 = _L::set1(m[5]), m12 = _L::set1(m[6]);
+    const V m20 = _L::set1(m[8]), m21 = _L::set1(m[9]), m22 = _L::set1(m[10]);
+    const V t0 = _L::set1(translate ? m[12] : 0.0f);
+    const V t1 = _L::set1(translate ? m[13] : 0.0f);
+    const V t2 = _L::set1(translate ? m[14] : 0.0f);
+
+    for(; i + _L::Width <= count; i += _L::Width)
+    {
+        const V vx = _L::load(x + i);
+        const V vy = _L::load(y + i);
+        const V vz = _L::load(z + i);
+
+        _L::store(outX + i, _L::madd(m20, vz, _L::madd(m10, vy, _L::madd(m00, vx, t0))));
+        _L::store(outY + i, _L::madd(m21, vz, _L::madd(m11, vy, _L::madd(m01, vx, t1))));
+        _L::store(outZ + i, _L::madd(m22, vz, _L::madd(m12, vy, _L::madd(m02, vx, t2))));
+    }
+
+    return i;
+}
+
+template<typename _L>
+static TAU_MATH_INLINE ::std::size_t normalizeLanes(::std::size_t i, const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{
+    using V = typename _L::V;
+
+    const V zero = _L::set1(0.0f);
+    const V one = _L::set1(1.0f);
+
+    for(; i + _L::Width <= count; i += _L::Width)
+    {
+        const V vx = _L::load(x + i);
+        const V vy = _L::load(y + i);
+        const V vz = _L::load(z + i);
+
+        const V lengthSquared = _L::madd(vz, vz, _L::madd(vy, vy, _L::mul(vx, vx)));
+        const V inverseLength = _L::zeroUnless(_L::div(one, _L::sqrt(lengthSquared)), _L::cmpGT(lengthSquared, zero));
+
+        _L::store(outX + i, _L::mul(vx, inverseLength));
+        _L::store(outY + i, _L::mul(vy, inverseLength));
+        _L::store(outZ + i, _L::mul(vz, inverseLength));
+    }
+
+    return i;
+}
+
+template<typename _L>
+static TAU_MATH_INLINE ::std::size_t spheresVisibleLanes(::std::size_t i, const float* const planes, const ::std::size_t planeCount, const float* const centerX, const float* const centerY, const float* const centerZ, const float* const radius, ::std::uint8_t* const visible, const ::std::size_t count) NOEXCEPT
+{
+    using V = typename _L::V;
+    using M = typename _L::M;
+
+    for(; i + _L::Width <= count; i += _L::Width)
+    {
+        const V cx = _L::load(centerX + i);
+        const V cy = _L::load(centerY + i);
+        const V cz = _L::load(centerZ + i);
+        const V negRadius = _L::neg(_L::load(radius + i));
+
+        M inside = _L::maskAll();
+        for(::std::size_t p = 0; p < planeCount; ++p)
+        {
+            const float* const plane = planes + p * 4;
+            const V distance = _L::madd(_L::set1(plane[2]), cz, _L::madd(_L::set1(plane[1]), cy, _L::madd(_L::set1(plane[0]), cx, _L::set1(plane[3]))));
+            inside = _L::maskAnd(inside, _L::cmpGE(distance, negRadius));
+        }
+
+        storeMask<_L>(visible + i, inside);
+    }
+
+    return i;
+}
+
+template<typename _L>
+static TAU_MATH_INLINE ::std::size_t aabbsVisibleLanes(::std::size_t i, const float* const planes, const ::std::size_t planeCount, const float* const centerX, const float* const centerY, const float* const centerZ, const float* const extentX, const float* const extentY, const float* const extentZ, ::std::uint8_t* const visible, const ::std::size_t count) NOEXCEPT
+{
+    using V = typename _L::V;
+    using M = typename _L::M;
+
+    const V zero = _L::set1(0.0f);
+
+    for(; i + _L::Width <= count; i += _L::Width)
+    {
+        const V cx = _L::load(centerX + i);
+        const V cy = _L::load(centerY + i);
+        const V cz = _L::load(centerZ + i);
+        const V ex = _L::load(extentX + i);
+        const V ey = _L::load(extentY + i);
+        const V ez = _L::load(extentZ + i);
+
+        M inside = _L::maskAll();
+        for(::std::size_t p = 0; p < planeCount; ++p)
+        {
+            const float* const plane = planes + p * 4;
+            const float absX = plane[0] < 0.0f ? -plane[0] : plane[0];
+            const float absY = plane[1] < 0.0f ? -plane[1] : plane[1];
+            const float absZ = plane[2] < 0.0f ? -plane[2] : plane[2];
+
+            // The distance of the corner furthest along the normal.
+            V distance = _L::madd(_L::set1(plane[0]), cx, _L::set1(plane[3]));
+            distance = _L::madd(_L::set1(plane[1]), cy, distance);
+            distance = _L::madd(_L::set1(plane[2]), cz, distance);
+            distance = _L::madd(_L::set1(absX), ex, distance);
+            distance = _L::madd(_L::set1(absY), ey, distance);
+            distance = _L::madd(_L::set1(absZ), ez, distance);
+            inside = _L::maskAnd(inside, _L::cmpGE(distance, zero));
+        }
+
+        storeMask<_L>(visible + i, inside);
+    }
+
+    return i;
+}
+
+static void kernelTransformPoints(const float* const matrix, const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{ TAU_MATH_RUN_LANES(transformLanes, matrix, true, x, y, z, outX, outY, outZ, count); }
+
+static void kernelTransformNormals(const float* const matrix, const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{ TAU_MATH_RUN_LANES(transformLanes, matrix, false, x, y, z, outX, outY, outZ, count); }
+
+static void kernelNormalize(const float* const x, const float* const y, const float* const z, float* const outX, float* const outY, float* const outZ, const ::std::size_t count) NOEXCEPT
+{ TAU_MATH_RUN_LANES(normalizeLanes, x, y, z, outX, outY, outZ, count); }
+
+static void kernelSpheresVisible(const float* const planes, const ::std::size_t planeCount, const float* const centerX, const float* const centerY, const float* const centerZ, const float* const radius, ::std::uint8_t* const visible, const ::std::size_t count) NOEXCEPT
+{ TAU_MATH_RUN_LANES(spheresVisibleLanes, planes, planeCount, centerX, centerY, centerZ, radius, visible, count); }
+
+static void kernelAabbsVisible(const float* const planes, const ::std::size_t planeCount, const float* const centerX, const float* const centerY, const float* const centerZ, const float* const extentX, const float* const extentY, const float* const extentZ, ::std::uint8_t* const visible, const ::std::size_t count) NOEXCEPT
+{ TAU_MATH_RUN_LANES(aabbsVisibleLanes, planes, planeCount, centerX, centerY, centerZ, extentX, extentY, extentZ, visible, count); }
+
+/**
+ *   The conversions are bound by memory bandwidth rather than
+ * arithmetic, so every instruction set uses the same 4 wide
+ * shuffles.
+ */
+static void kernelAosToSoA(const float* const aos, const ::std::size_t stride, float* const x, float* const y, float* const z, const ::std::size_t count) NOEXCEPT
+{
+    ::std::size_t i = 0;
+
+    if(stride == 3)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            // (x0, y0, z0, x1), (y1, z1, x2, y2), (z2, x3, y3, z3)
+            const __m128 a = _mm_loadu_ps(aos + i * 3);
+            const __m128 b = _mm_loadu_ps(aos + i * 3 + 4);
+            const __m128 c = _mm_loadu_ps(aos + i * 3 + 8);
+
+            _mm_storeu_ps(x + i, shuffle<0, 3, 0, 2>(a, shuffle<2, 2, 1, 1>(b, c)));
+            _mm_storeu_ps(y + i, shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c)));
+            _mm_storeu_ps(z + i, shuffle<0, 2, 0, 2>(shuffle<2, 2, 1, 1>(a, b), shuffle<0, 0, 3, 3>(c, c)));
+        }
+    }
+    else
+    {
+        /**
+         *   Each vector is loaded with a 4th float, which is only
+         * known to be readable if another vector follows it.
+         */
+        for(; i + 4 < count; i += 4)
+        {
+            __m128 r0 = _mm_loadu_ps(aos + (i + 0) * stride);
+            __m128 r1 = _mm_loadu_ps(aos + (i + 1) * stride);
+            __m128 r2 = _mm_loadu_ps(aos + (i + 2) * stride);
+            __m128 r3 = _mm_loadu_ps(aos + (i + 3) * stride);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(x + i, r0);
+            _mm_storeu_ps(y + i, r1);
+            _mm_storeu_ps(z + i, r2);
+        }
+    }
+
+    for(; i < count; ++i)
+    {
+        x[i] = aos[i * stride + 0];
+        y[i] = aos[i * stride + 1];
+        z[i] = aos[i * stride + 2];
+    }
+}
+
+static void kernelSoaToAoS(const float* const x, const float* const y, const float* const z, float* const aos, const ::std::size_t stride, const ::std::size_t count) NOEXCEPT
+{
+    ::std::size_t i = 0;
+
+    if(stride == 3)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128 vx = _mm_loadu_ps(x + i);
+            const __m128 vy = _mm_loadu_ps(y + i);
+            const __m128 vz = _mm_loadu_ps(z + i);
+
+            _mm_storeu_ps(aos + i * 3, shuffle<0, 1, 0, 2>(_mm_unpacklo_ps(vx, vy), shuffle<0, 0, 1, 1>(vz, vx)));
+            _mm_storeu_ps(aos + i * 3 + 4, shuffle<0, 2, 0, 2>(shuffle<1, 1, 1, 1>(vy, vz), shuffle<2, 2, 2, 2>(vx, vy)));
+            _mm_storeu_ps(aos + i * 3 + 8, shuffle<0, 2, 0, 2>(shuffle<2, 2, 3, 3>(vz, vx), shuffle<3, 3, 3, 3>(vy, vz)));
+        }
+    }
+
+    for(; i < count; ++i)
+    {
+        aos[i * stride + 0] = x[i];
+        aos[i * stride + 1] = y[i];
+        aos[i * stride + 2] = z[i];
+    }
+}
+
+#undef TAU_MATH_RUN_LANES
+#undef TAU_MATH_WIDE_LANE
+
+}
+
+const MathStreamKernels TAU_MATH_STREAM_KERNEL_TABLE = {
+    TAU_MATH_SIMD_NS::kernelTransformPoints,
+    TAU_MATH_SIMD_NS::kernelTransformNormals,
+    TAU_MATH_SIMD_NS::kernelNormalize,
+    TAU_MATH_SIMD_NS::kernelSpheresVisible,
+    TAU_MATH_SIMD_NS::kernelAabbsVisible,
+    TAU_MATH_SIMD_NS::kernelAosToSoA,
+    TAU_MATH_SIMD_NS::kernelSoaToAoS
+};
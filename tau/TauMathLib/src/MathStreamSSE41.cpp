@@ -0,0 +1,3 @@
+#define TAU_MATH_SIMD_NS simd_sse41
+#define TAU_MATH_STREAM_KERNEL_TABLE mathStreamKernelsSSE41
+#include "MathStreamKernels.inl"
@@ -1,5 +1,6 @@
 #include "Matrix4x4f.hpp"
 #include "Matrix4x4fIntrin.h"
+#include "Matrix4x4fKernels.hpp"
 
 Matrix4x4f Matrix4x4f::add(const Matrix4x4f& a, const Matrix4x4f& b) noexcept
 {
@@ -18,7 +19,7 @@ Matrix4x4f Matrix4x4f::sub(const Matrix4x4f& a, const Matrix4x4f& b) noexcept
 Matrix4x4f Matrix4x4f::mul(const Matrix4x4f& a, const Matrix4x4f& b) noexcept
 {
     Matrix4x4f ret { };
-    matrix4x4f_mul(a.mRaw, b.mRaw, ret.mRaw);
+    matrix4x4fKernels().mul(a.columns(), b.columns(), ret.columns());
     return ret;
 }
 
@@ -58,11 +59,32 @@ Matrix4x4f Matrix4x4f::divFast(const Matrix4x4f& a, const float b) noexcept
 }
 
 Vector4f Matrix4x4f::mul(const Matrix4x4f& a, const Vector4f b) noexcept
-{ return Vector4f(matrix4x4f_mulVector(a.mRaw, b.vec)); }
+{ return Vector4f(matrix4x4fKernels().mulVector(a.columns(), b.vec)); }
 
 Vector4f Matrix4x4f::mul(const Vector4f b, const Matrix4x4f& a) noexcept
+{ return Vector4f(matrix4x4fKernels().mulVectorTransposed(a.columns(), b.vec)); }
+
+Matrix4x4f Matrix4x4f::transpose(const Matrix4x4f& a) noexcept
 {
-    Matrix4x4f transpose { };
-    matrix4x4f_transpose(a.mRaw, transpose.mRaw);
-    return Vector4f(matrix4x4f_mulVector(transpose.mRaw, b.vec));
+    Matrix4x4f ret { };
+    matrix4x4fKernels().transpose(a.columns(), ret.columns());
+    return ret;
+}
+
+Matrix4x4f Matrix4x4f::inverse(const Matrix4x4f& a, bool* const invertible) noexcept
+{
+    Matrix4x4f ret { };
+    const float determinant = matrix4x4fKernels().inverse(a.columns(), ret.columns());
+    if(invertible)
+    { *invertible = determinant != 0.0f; }
+    return ret;
+}
+
+Matrix4x4f Matrix4x4f::affineInverse(const Matrix4x4f& a, bool* const invertible) noexcept
+{
+    Matrix4x4f ret { };
+    const float determinant = matrix4x4fKernels().affineInverse(a.columns(), ret.columns());
+    if(invertible)
+    { *invertible = determinant != 0.0f; }
+    return ret;
 }
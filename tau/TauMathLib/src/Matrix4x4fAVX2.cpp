@@ -0,0 +1,7 @@
+/**
+ *   This file is compiled with AVX2 and FMA enabled, it is only
+ * called once the processor has been checked for support.
+ */
+#define TAU_MATH_SIMD_NS simd_avx2
+#define TAU_MATH_KERNEL_TABLE matrix4x4fKernelsAVX2
+#include "Matrix4x4fKernels.inl"
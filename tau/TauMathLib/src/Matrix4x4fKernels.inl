@@ -0,0 +1,39 @@
+/**
+ *   Builds a kernel table from the inline layer. The including
+ * file must define TAU_MATH_SIMD_NS and TAU_MATH_KERNEL_TABLE
+ * before including this, and must not include any other header
+ * with inline functions outside of TAU_MATH_SIMD_NS.
+ */
+#include "Matrix4x4fKernels.hpp"
+#include "Matrix4x4fSimd.hpp"
+
+namespace TAU_MATH_SIMD_NS {
+
+static void kernelMul(const __m128* const a, const __m128* const b, __m128* const store) NOEXCEPT
+{ matrix4x4f_mul(a, b, store); }
+
+static __m128 kernelMulVector(const __m128* const a, const __m128 b) NOEXCEPT
+{ return matrix4x4f_mulVector(a, b); }
+
+static __m128 kernelMulVectorTransposed(const __m128* const a, const __m128 b) NOEXCEPT
+{ return matrix4x4f_mulVectorTransposed(a, b); }
+
+static void kernelTranspose(const __m128* const a, __m128* const store) NOEXCEPT
+{ matrix4x4f_transpose(a, store); }
+
+static float kernelInverse(const __m128* const a, __m128* const store) NOEXCEPT
+{ return matrix4x4f_inverse(a, store); }
+
+static float kernelAffineInverse(const __m128* const a, __m128* const store) NOEXCEPT
+{ return matrix4x4f_affineInverse(a, store); }
+
+}
+
+const Matrix4x4fKernels TAU_MATH_KERNEL_TABLE = {
+    TAU_MATH_SIMD_NS::kernelMul,
+    TAU_MATH_SIMD_NS::kernelMulVector,
+    TAU_MATH_SIMD_NS::kernelMulVectorTransposed,
+    TAU_MATH_SIMD_NS::kernelTranspose,
+    TAU_MATH_SIMD_NS::kernelInverse,
+    TAU_MATH_SIMD_NS::kernelAffineInverse
+};
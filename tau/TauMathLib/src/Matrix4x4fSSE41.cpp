@@ -0,0 +1,3 @@
+#define TAU_MATH_SIMD_NS simd_sse41
+#define TAU_MATH_KERNEL_TABLE matrix4x4fKernelsSSE41
+#include "Matrix4x4fKernels.inl"
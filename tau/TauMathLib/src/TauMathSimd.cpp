@@ -0,0 +1,141 @@
+#include "TauMathSimd.hpp"
+#include "Matrix4x4fKernels.hpp"
+#include "MathStreamKernels.hpp"
+#include <atomic>
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#else
+  #include <cpuid.h>
+#endif
+
+static void cpuid(int* const registers, const int leaf, const int subLeaf) NOEXCEPT
+{
+#ifdef _MSC_VER
+    __cpuidex(registers, leaf, subLeaf);
+#else
+    unsigned eax, ebx, ecx, edx;
+    __cpuid_count(leaf, subLeaf, eax, ebx, ecx, edx);
+    registers[0] = static_cast<int>(eax);
+    registers[1] = static_cast<int>(ebx);
+    registers[2] = static_cast<int>(ecx);
+    registers[3] = static_cast<int>(edx);
+#endif
+}
+
+/**
+ * The register state the OS saves on a context switch.
+ */
+static unsigned long long xcr0() NOEXCEPT
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+MathISA mathDetectISA() NOEXCEPT
+{
+    int registers[4];
+    cpuid(registers, 0, 0);
+    const int maxLeaf = registers[0];
+
+    cpuid(registers, 1, 0);
+    const bool fma = (registers[2] & (1 << 12)) != 0;
+    const bool osxsave = (registers[2] & (1 << 27)) != 0;
+    const bool avx = (registers[2] & (1 << 28)) != 0;
+
+    if(maxLeaf < 7 || !fma || !osxsave || !avx)
+    { return MathISA::SSE41; }
+
+    const unsigned long long savedState = xcr0();
+    // The XMM and YMM registers.
+    if((savedState & 0x6) != 0x6)
+    { return MathISA::SSE41; }
+
+    cpuid(registers, 7, 0);
+    const bool avx2 = (registers[1] & (1 << 5)) != 0;
+    const bool avx512f = (registers[1] & (1 << 16)) != 0;
+
+    if(!avx2)
+    { return MathISA::SSE41; }
+
+    // The opmask registers and both halves of the ZMM registers.
+    if(avx512f && (savedState & 0xE0) == 0xE0)
+    { return MathISA::AVX512; }
+
+    return MathISA::AVX2;
+}
+
+static const Matrix4x4fKernels* kernelsFor(const MathISA isa) NOEXCEPT
+{
+    switch(isa)
+    {
+        case MathISA::AVX512:
+        case MathISA::AVX2: return &matrix4x4fKernelsAVX2;
+        case MathISA::SSE41:
+        default: return &matrix4x4fKernelsSSE41;
+    }
+}
+
+static const MathStreamKernels* streamKernelsFor(const MathISA isa) NOEXCEPT
+{
+    switch(isa)
+    {
+        case MathISA::AVX512: return &mathStreamKernelsAVX512;
+        case MathISA::AVX2: return &mathStreamKernelsAVX2;
+        case MathISA::SSE41:
+        default: return &mathStreamKernelsSSE41;
+    }
+}
+
+static ::std::atomic<int> activeISA(-1);
+static ::std::atomic<const Matrix4x4fKernels*> activeKernels(nullptr);
+static ::std::atomic<const MathStreamKernels*> activeStreamKernels(nullptr);
+
+MathISA mathActiveISA() NOEXCEPT
+{
+    (void) matrix4x4fKernels();
+    return static_cast<MathISA>(activeISA.load(::std::memory_order_relaxed));
+}
+
+MathISA mathForceISA(MathISA isa) NOEXCEPT
+{
+    const MathISA detected = mathDetectISA();
+    if(static_cast<int>(isa) > static_cast<int>(detected))
+    { isa = detected; }
+
+    activeISA.store(static_cast<int>(isa), ::std::memory_order_relaxed);
+    activeStreamKernels.store(streamKernelsFor(isa), ::std::memory_order_release);
+    activeKernels.store(kernelsFor(isa), ::std::memory_order_release);
+    return isa;
+}
+
+const Matrix4x4fKernels& matrix4x4fKernels() NOEXCEPT
+{
+    const Matrix4x4fKernels* kernels = activeKernels.load(::std::memory_order_acquire);
+    if(!kernels)
+    {
+        /**
+         *   Detection is idempotent, so threads racing to select
+         * the kernels all store the same values.
+         */
+        (void) mathForceISA(MathISA::AVX512);
+        kernels = activeKernels.load(::std::memory_order_acquire);
+    }
+    return *kernels;
+}
+
+const MathStreamKernels& mathStreamKernels() NOEXCEPT
+{
+    const MathStreamKernels* kernels = activeStreamKernels.load(::std::memory_order_acquire);
+    if(!kernels)
+    {
+        (void) mathForceISA(MathISA::AVX512);
+        kernels = activeStreamKernels.load(::std::memory_order_acquire);
+    }
+    return *kernels;
+}
@@ -17,6 +17,23 @@ _T atomicDecrement(volatile _T* t) noexcept = delete;
 template<typename _T>
 _T atomicExchange(volatile _T* t, _T value) noexcept = delete;
 
+/**
+ * @return
+ *      The value before the addition.
+ */
+template<typename _T>
+_T atomicAdd(volatile _T* t, _T value) noexcept = delete;
+
+/**
+ *   Stores `value` if `t` holds `comparand`.
+ *
+ * @return
+ *      The value before the operation, the exchange happened if
+ *    this is equal to `comparand`.
+ */
+template<typename _T>
+_T atomicCompareExchange(volatile _T* t, _T value, _T comparand) noexcept = delete;
+
 template<>
 inline i16 atomicIncrement<i16>(volatile i16* const t) noexcept
 { return _InterlockedIncrement16(t); }
@@ -115,4 +132,56 @@ template<>
 inline u64 atomicExchange<u64>(volatile u64* const t, const u64 value) noexcept
 { return _InterlockedExchange64(reinterpret_cast<volatile i64*>(t), value); }
 
+template<>
+inline i32 atomicAdd<i32>(volatile i32* const t, const i32 value) noexcept
+{
+    static_assert(sizeof(i32) == sizeof(long), "NumTypes i32 [int] does not match the size of long.");
+    return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(t), value);
+}
+
+template<>
+inline i64 atomicAdd<i64>(volatile i64* const t, const i64 value) noexcept
+{ return _InterlockedExchangeAdd64(t, value); }
+
+template<>
+inline u32 atomicAdd<u32>(volatile u32* const t, const u32 value) noexcept
+{
+    static_assert(sizeof(u32) == sizeof(long), "NumTypes u32 [unsigned int] does not match the size of long.");
+    return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(t), static_cast<long>(value));
+}
+
+template<>
+inline u64 atomicAdd<u64>(volatile u64* const t, const u64 value) noexcept
+{ return _InterlockedExchangeAdd64(reinterpret_cast<volatile i64*>(t), static_cast<i64>(value)); }
+
+template<>
+inline i32 atomicCompareExchange<i32>(volatile i32* const t, const i32 value, const i32 comparand) noexcept
+{
+    static_assert(sizeof(i32) == sizeof(long), "NumTypes i32 [int] does not match the size of long.");
+    return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(t), value, comparand);
+}
+
+template<>
+inline i64 atomicCompareExchange<i64>(volatile i64* const t, const i64 value, const i64 comparand) noexcept
+{ return _InterlockedCompareExchange64(t, value, comparand); }
+
+template<>
+inline u32 atomicCompareExchange<u32>(volatile u32* const t, const u32 value, const u32 comparand) noexcept
+{
+    static_assert(sizeof(u32) == sizeof(long), "NumTypes u32 [unsigned int] does not match the size of long.");
+    return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(t), static_cast<long>(value), static_cast<long>(comparand));
+}
+
+template<>
+inline u64 atomicCompareExchange<u64>(volatile u64* const t, const u64 value, const u64 comparand) noexcept
+{ return _InterlockedCompareExchange64(reinterpret_cast<volatile i64*>(t), static_cast<i64>(value), static_cast<i64>(comparand)); }
+
+template<typename _T>
+inline _T* atomicExchangePointer(_T* volatile* const t, _T* const value) noexcept
+{ return reinterpret_cast<_T*>(_InterlockedExchangePointer(reinterpret_cast<void* volatile*>(t), value)); }
+
+template<typename _T>
+inline _T* atomicCompareExchangePointer(_T* volatile* const t, _T* const value, _T* const comparand) noexcept
+{ return reinterpret_cast<_T*>(_InterlockedCompareExchangePointer(reinterpret_cast<void* volatile*>(t), value, comparand)); }
+
 #endif
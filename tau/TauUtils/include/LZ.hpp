@@ -0,0 +1,75 @@
+/**
+ * @file
+ *
+ * A small, fast LZ77 block compressor.
+ */
+#pragma once
+
+#include "Objects.hpp"
+#include "NumTypes.hpp"
+
+/**
+ *   A byte oriented LZ77 block codec in the style of LZ4.
+ * It favours speed over ratio and is intended for compressing
+ * runtime generated streams such as replays and caches.
+ *
+ *   Each sequence is a token byte, an optional literal length
+ * extension, the literals, a 16 bit little endian match
+ * offset, and an optional match length extension. The top
+ * nibble of the token is the literal length, the bottom nibble
+ * is the match length minus {@link LZ::MinMatch @endlink}. A
+ * nibble of 15 is followed by bytes that are summed until a
+ * byte other than 255 is read. The final sequence only
+ * contains literals.
+ *
+ *   Blocks are independent, the uncompressed size is not
+ * stored and must be tracked by the caller.
+ */
+class LZ final
+{
+    DELETE_CONSTRUCT(LZ);
+    DELETE_DESTRUCT(LZ);
+    DELETE_CM(LZ);
+public:
+    static constexpr uSys MinMatch = 4;
+    static constexpr uSys MaxOffset = 0xFFFF;
+    /**
+     * The number of bytes at the end of a block that are always
+     * stored as literals.
+     */
+    static constexpr uSys LastLiterals = 5;
+    /**
+     * Matches are not started this close to the end of a block.
+     */
+    static constexpr uSys MatchFindLimit = 12;
+    static constexpr uSys HashLog = 12;
+public:
+    /**
+     * The largest size a block of `length` bytes can compress to.
+     */
+    [[nodiscard]] static constexpr uSys compressBound(const uSys length) noexcept
+    { return length + length / 255 + 16; }
+
+    /**
+     * Compresses a block.
+     *
+     * @param[in] capacity
+     *      The size of `dst`, this must be at least
+     *    {@link LZ::compressBound(uSys) @endlink} of `length`.
+     * @return
+     *      The compressed size, or 0 if `dst` is too small.
+     */
+    static uSys compress(const u8* src, uSys length, u8* dst, uSys capacity) noexcept;
+
+    /**
+     * Decompresses a block.
+     *
+     * @param[in] capacity
+     *      The size of `dst`, this should be the original size
+     *    of the block.
+     * @return
+     *      The decompressed size, or 0 if the block is corrupt or
+     *    would overflow `dst`.
+     */
+    static uSys decompress(const u8* src, uSys length, u8* dst, uSys capacity) noexcept;
+};
@@ -7,11 +7,152 @@
 #include "AtomicIntrinsics.hpp"
 #include <type_traits>
 
+/**
+ *   The reference counting modes for ReferenceCountingPointer.
+ *
+ *   Non-atomic counting is the cheapest but pointers cannot be
+ * shared between threads. Atomic counting is always safe but
+ * every copy is a locked read-modify-write.
+ *
+ *   Biased counting is for objects that are mostly referenced by
+ * the thread that created them, such as resources owned by the
+ * render thread that loader threads occasionally hold. The
+ * creating thread counts without atomics, every other thread
+ * counts atomically. Threads that create objects need to call
+ * rcpProcessPendingReleases() regularly, see _BiasedRefCount.
+ *
+ *   Strong and weak pointers use atomic counting in the biased
+ * mode, weak pointers read the strong count from any thread.
+ */
+#define TAU_RCP_NONATOMIC 0
+#define TAU_RCP_ATOMIC    1
+#define TAU_RCP_BIASED    2
+
 #ifndef TAU_DEFAULT_ATOMIC
-  #define TAU_DEFAULT_ATOMIC 0
+  #define TAU_DEFAULT_ATOMIC TAU_RCP_NONATOMIC
 #endif
 
+/**
+ *   Objects deriving from this are destroyed on the thread that
+ * created them when using biased counting. If another thread
+ * releases the last reference the object is handed back to the
+ * creating thread, which destroys it the next time it calls
+ * rcpProcessPendingReleases(). This is intended for objects,
+ * such as graphics resources, that must be destroyed on a
+ * particular thread.
+ *
+ *   In the other modes this has no effect.
+ */
+struct RCPDeferredRelease { };
+
+/**
+ *   Merges and destroys the biased objects owned by the calling
+ * thread that other threads have released. This should be
+ * called regularly, such as once a frame, by every thread that
+ * creates reference counted objects, and does nothing unless
+ * biased counting is enabled.
+ *
+ * @return
+ *      The number of objects that were processed.
+ */
+uSys rcpProcessPendingReleases() noexcept;
+
 namespace _ReferenceCountingPointerUtils {
+struct _BiasedRefCount;
+
+/**
+ *   The objects owned by a thread that other threads have
+ * released. Other threads push onto it, only the owning thread
+ * pops.
+ *
+ *   Queues are never freed, if an object is released after its
+ * owning thread has exited it is leaked rather than touching
+ * freed memory.
+ */
+struct _BiasedRefCountQueue final
+{
+    DEFAULT_CONSTRUCT_PU(_BiasedRefCountQueue);
+    DEFAULT_DESTRUCT(_BiasedRefCountQueue);
+    DELETE_CM(_BiasedRefCountQueue);
+public:
+    _BiasedRefCount* volatile _head = nullptr;
+public:
+    /**
+     * The queue of the calling thread.
+     */
+    [[nodiscard]] static _BiasedRefCountQueue* local() noexcept;
+
+    void push(_BiasedRefCount* refCount) noexcept;
+
+    uSys process() noexcept;
+};
+
+/**
+ *   Biased reference counting, from "Biased Reference Counting:
+ * Minimizing Atomic Operations in Garbage Collection" by Choi,
+ * Shull and Torrellas.
+ *
+ *   The thread that creates the object is its owner, it counts
+ * its references in `_biased` without atomics. Every other
+ * thread counts in `_shared` atomically. The total is the sum of
+ * the two, so `_shared` may go negative when the owner hands
+ * out references that other threads then release.
+ *
+ *   When the owner's count reaches zero it merges, from then on
+ * every thread uses the shared count and the last release
+ * destroys the object. If another thread takes the shared count
+ * below zero the owner may never release its count on its own,
+ * so the object is queued for the owner to merge explicitly.
+ *
+ *   The low bits of `_shared` are flags, the count is stored
+ * above them. Each flag is only ever set by one party, and the
+ * decision to destroy the object is made by whichever atomic
+ * operation leaves a merged, unqueued count of zero, so exactly
+ * one thread destroys it.
+ */
+struct _BiasedRefCount final
+{
+    DEFAULT_DESTRUCT(_BiasedRefCount);
+    DELETE_CM(_BiasedRefCount);
+public:
+    using Destroy = void(*)(_BiasedRefCount*) noexcept;
+
+    static constexpr i64 Merged   = 1;
+    static constexpr i64 Queued   = 2;
+    static constexpr i64 Deferred = 4;
+    static constexpr i64 One      = 8;
+public:
+    uSys _biased;
+    volatile i64 _shared;
+    _BiasedRefCountQueue* _owner;
+    _BiasedRefCount* _next;
+    Destroy _destroy;
+public:
+    _BiasedRefCount(Destroy destroy, bool deferred) noexcept;
+
+    /**
+     * Exact on the owning thread while there are no other threads referencing the object.
+     */
+    [[nodiscard]] uSys count() const noexcept;
+
+    /**
+     * @return
+     *      The new count, other threads only see their share of it.
+     */
+    uSys addRef() noexcept;
+
+    /**
+     * @return
+     *      0 if the caller must destroy the object.
+     */
+    uSys release() noexcept;
+
+    /**
+     *   Called by the owner for each object in its queue. The
+     * object may be destroyed.
+     */
+    void processQueued() noexcept;
+};
 /**
  *   This does not store a direct _T because we may want to
  * cast it to a non-concrete interface, in which case the
@@ -24,7 +165,14 @@ struct _ReferenceCountDataObject final
 {
     DELETE_CM(_ReferenceCountDataObject);
 public:
+#if TAU_DEFAULT_ATOMIC == TAU_RCP_BIASED
+    /**
+     * This must be the first member, it is cast back to the data object to destroy it.
+     */
+    _BiasedRefCount _refCount;
+#else
     uSys _refCount;
+#endif
     TauAllocator& _allocator;
     // u8 _objRaw[sizeof(_T)];
 public:
@@ -36,6 +184,23 @@ public:
     [[nodiscard]]       _T* objPtr()       noexcept { return reinterpret_cast<_T*>(this + 1); }
     [[nodiscard]] const _T* objPtr() const noexcept { return reinterpret_cast<_T*>(this + 1); }
 
+#if TAU_DEFAULT_ATOMIC == TAU_RCP_BIASED
+    [[nodiscard]] uSys refCount() const noexcept { return _refCount.count(); }
+
+    uSys addRef() noexcept
+    { return _refCount.addRef(); }
+
+    uSys release() noexcept
+    { return _refCount.release(); }
+
+    static void destroyBiased(_BiasedRefCount* const refCount) noexcept
+    {
+        _ReferenceCountDataObject<_T>* const rcdo = reinterpret_cast<_ReferenceCountDataObject<_T>*>(refCount);
+        rcdo->_allocator.deallocateT(rcdo);
+    }
+#else
+    [[nodiscard]] uSys refCount() const noexcept { return _refCount; }
+
     uSys addRef() noexcept
     {
 #if TAU_DEFAULT_ATOMIC
@@ -65,6 +230,7 @@ public:
 
     uSys releaseAtomic() noexcept
     { return atomicDecrement(&_refCount); }
+#endif
 };
 
 /**
@@ -286,7 +452,7 @@ public:
     [[nodiscard]]       _T* get()       noexcept override { return _tPtr; }
     [[nodiscard]] const _T* get() const noexcept override { return _tPtr; }
 
-    [[nodiscard]] uSys refCount() const noexcept override { return _rcdo ? _rcdo->_refCount : 0; }
+    [[nodiscard]] uSys refCount() const noexcept override { return _rcdo ? _rcdo->refCount() : 0; }
 
     [[nodiscard]] RCDO<_T>*& _getBlock()       noexcept { return _rcdo; }
     [[nodiscard]] RCDO<_T>*  _getBlock() const noexcept { return _rcdo; }
@@ -12,7 +12,11 @@ namespace _ReferenceCountingPointerUtils {
 template<typename _T>
 template<typename... _Args>
 inline _ReferenceCountDataObject<_T>::_ReferenceCountDataObject(TauAllocator& allocator, _Args&&... args) noexcept
+#if TAU_DEFAULT_ATOMIC == TAU_RCP_BIASED
+    : _refCount(destroyBiased, ::std::is_base_of_v<RCPDeferredRelease, _T>)
+#else
     : _refCount(1)
+#endif
     , _allocator(allocator)
 { (void) new(this + 1) _T(_TauAllocatorUtils::_forward<_Args>(args)...); }
 
@@ -42,6 +42,10 @@
  * ensures that two entirely different types with the same
  * underlying RTTI value aren't identified as the same by
  * accident.
+ *
+ *   In both modes every type also has a dense index, starting at
+ * 1 and unique per template type, which can be used to index
+ * tables of per type data.
  */
 template<typename _T>
 class RunTimeType;
@@ -64,19 +68,28 @@ private:
     void* _uid;
     const char* _name;
     const RunTimeType<_T>* _parent;
+    u32 _index;
 public:
     RunTimeType(const char* const name, const RunTimeType<_T>* const parent = nullptr) noexcept
         : _uid(this)
         , _name(name)
         , _parent(parent)
+        , _index(nextIndex())
     { }
 
+    [[nodiscard]] u32 index() const noexcept { return _index; }
     [[nodiscard]] const char* name() const noexcept { return _name; }
     [[nodiscard]] const RunTimeType<_T>* parent() const noexcept { return _parent; }
 
     [[nodiscard]] bool operator ==(const RunTimeType<_T>& other) const noexcept { return _uid == other._uid; }
     [[nodiscard]] bool operator !=(const RunTimeType<_T>& other) const noexcept { return _uid != other._uid; }
 private:
+    static u32 nextIndex() noexcept
+    {
+        static volatile u32 currentIndex = 0;
+        return atomicIncrement(&currentIndex);
+    }
+
     friend struct std::hash<RunTimeType<_T>>;
 };
 #else
@@ -99,6 +112,7 @@ private:
         : _uid(uid)
     { }
 public:
+    [[nodiscard]] u32 index() const noexcept { return static_cast<u32>(_uid); }
     [[nodiscard]] const char* name() const noexcept { return nullptr; }
     [[nodiscard]] const RunTimeType<_T>* parent() const noexcept { return nullptr; }
 
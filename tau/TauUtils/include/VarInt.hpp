@@ -0,0 +1,100 @@
+/**
+ * @file
+ *
+ * LEB128 style variable length integer encoding.
+ */
+#pragma once
+
+#include "Objects.hpp"
+#include "NumTypes.hpp"
+
+class VarInt final
+{
+    DELETE_CONSTRUCT(VarInt);
+    DELETE_DESTRUCT(VarInt);
+    DELETE_CM(VarInt);
+public:
+    /**
+     * The largest number of bytes a 64 bit value can encode to.
+     */
+    static constexpr uSys MaxBytes = 10;
+
+    [[nodiscard]] static constexpr u64 zigZag(const i64 value) noexcept
+    { return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63); }
+
+    [[nodiscard]] static constexpr i64 unZigZag(const u64 value) noexcept
+    { return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1); }
+
+    [[nodiscard]] static constexpr uSys encodedSize(u64 value) noexcept
+    {
+        uSys size = 1;
+        while(value >= 0x80)
+        {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    /**
+     * Encodes a value, 7 bits at a time, least significant
+     * bits first.
+     *
+     *   The buffer must have room for at least
+     * {@link VarInt::MaxBytes @endlink} bytes.
+     *
+     * @return
+     *      The number of bytes written.
+     */
+    static uSys encode(u64 value, u8* const buffer) noexcept
+    {
+        uSys i = 0;
+        while(value >= 0x80)
+        {
+            buffer[i++] = static_cast<u8>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[i++] = static_cast<u8>(value);
+        return i;
+    }
+
+    /**
+     * Decodes a value.
+     *
+     * @return
+     *      The number of bytes read, or 0 if the buffer ended
+     *    before the value did or the value is too large.
+     */
+    static uSys decode(const u8* const buffer, const u8* const end, u64* const value) noexcept
+    {
+        u64 result = 0;
+        uSys i = 0;
+        for(u32 shift = 0; shift < 64; shift += 7)
+        {
+            if(buffer + i >= end)
+            { return 0; }
+
+            const u8 b = buffer[i++];
+            result |= static_cast<u64>(b & 0x7F) << shift;
+
+            if(!(b & 0x80))
+            {
+                *value = result;
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    static uSys encodeSigned(const i64 value, u8* const buffer) noexcept
+    { return encode(zigZag(value), buffer); }
+
+    static uSys decodeSigned(const u8* const buffer, const u8* const end, i64* const value) noexcept
+    {
+        u64 raw;
+        const uSys read = decode(buffer, end, &raw);
+        if(read)
+        { *value = unZigZag(raw); }
+        return read;
+    }
+};
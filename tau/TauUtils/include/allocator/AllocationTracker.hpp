@@ -0,0 +1,234 @@
+#pragma once
+
+#pragma warning(push, 0)
+#include <atomic>
+#include <vector>
+#pragma warning(pop)
+
+#include "Objects.hpp"
+#include "NumTypes.hpp"
+#include "TauAllocator.hpp"
+
+#ifndef TAU_ALLOCATION_TRACKING
+  #if !defined(TAU_PRODUCTION)
+    #define TAU_ALLOCATION_TRACKING 1
+  #else
+    #define TAU_ALLOCATION_TRACKING 0
+  #endif
+#endif
+
+using AllocationTag = u16;
+
+/**
+ * Attributes memory to the subsystems that allocated it.
+ *
+ *   Allocations are tagged with a subsystem registered through
+ * {@link AllocationTracker::registerTag(const char*) @endlink},
+ * usually by allocating through a TrackedAllocator. For each
+ * tag the tracker keeps the number of bytes in use, the peak,
+ * and a histogram of allocation sizes in power of two classes.
+ *
+ *   Everything is counted in a block owned by the thread doing
+ * the allocation and summed when a snapshot is taken, so
+ * tracking doesn't add contention between threads. The blocks of
+ * threads that have exited are reused by new threads, so their
+ * counts are never lost. A thread's byte count for a tag is
+ * published to the tag once it drifts by FlushBytes, the peak is
+ * only updated then and can be short by that much per thread.
+ *
+ *   Every `sampleInterval`th allocation on a thread records its
+ * call stack. Samples are aggregated by call site, which gives
+ * a statistical picture of where each tag's memory comes from
+ * without paying for a stack walk on every allocation.
+ *
+ *   Each tag can have a soft and a hard budget. Crossing the
+ * soft budget invokes the tag's callback, an allocation that
+ * would exceed the hard budget invokes the callback and fails.
+ * Tags with a budget publish their byte count on every
+ * allocation, which keeps the budget exact at the cost of an
+ * atomic add.
+ */
+class AllocationTracker final
+{
+    DELETE_CONSTRUCT(AllocationTracker);
+    DELETE_DESTRUCT(AllocationTracker);
+    DELETE_CM(AllocationTracker);
+public:
+    static constexpr u32 MaxTags = 64;
+    static constexpr u32 MaxTagNameLength = 31;
+    /**
+     * Size class `n` holds sizes in [2^(n-1), 2^n).
+     */
+    static constexpr u32 SizeClassCount = 32;
+    static constexpr u32 MaxStackDepth = 16;
+    static constexpr u32 MaxCallSites = 4096;
+    static constexpr u32 DefaultSampleInterval = 4096;
+    /**
+     *   How far a thread's byte count for a tag can drift before
+     * it is published to the tag.
+     */
+    static constexpr i64 FlushBytes = 16 * 1024;
+
+    /**
+     * Allocations that were never tagged.
+     */
+    static constexpr AllocationTag Untagged = 0;
+
+    enum class BudgetLevel
+    {
+        Soft,
+        Hard
+    };
+
+    /**
+     *   Invoked on the allocating thread with the number of bytes
+     * the tag would have in use.
+     */
+    typedef void(* BudgetCallback)(AllocationTag tag, BudgetLevel level, u64 bytes, u64 budget, void* userParam);
+
+    struct TagStats final
+    {
+        AllocationTag tag;
+        char name[MaxTagNameLength + 1];
+        i64 bytes;
+        i64 peakBytes;
+        i64 allocations;
+        i64 liveAllocations;
+        i64 rejected;
+        u64 softBudget;
+        u64 hardBudget;
+    };
+
+    struct CallSite final
+    {
+        AllocationTag tag;
+        u32 depth;
+        void* frames[MaxStackDepth];
+        i64 samples;
+        i64 sampledBytes;
+    };
+
+    struct Snapshot final
+    {
+        u64 sampleInterval;
+        ::std::vector<TagStats> tags;
+        /**
+         * The allocation counts of each tag, `SizeClassCount` per tag.
+         */
+        ::std::vector<i64> histogram;
+        ::std::vector<CallSite> callSites;
+
+        [[nodiscard]] i64 histogramCount(const AllocationTag tag, const u32 sizeClass) const noexcept
+        { return histogram[static_cast<uSys>(tag) * SizeClassCount + sizeClass]; }
+    };
+public:
+    /**
+     *   Returns the tag with the given name, registering it if it
+     * doesn't exist. Returns Untagged when every tag is in use.
+     */
+    [[nodiscard]] static AllocationTag registerTag(const char* name) noexcept;
+
+    [[nodiscard]] static const char* tagName(AllocationTag tag) noexcept;
+
+    /**
+     * A budget of 0 is unlimited.
+     */
+    static void setBudget(AllocationTag tag, u64 softBudget, u64 hardBudget, BudgetCallback callback = nullptr, void* userParam = nullptr) noexcept;
+
+    /**
+     * An interval of 0 disables call stack sampling.
+     */
+    static void setSampleInterval(u32 interval) noexcept;
+
+    [[nodiscard]] static u32 sizeClass(uSys size) noexcept;
+
+    /**
+     *   Records an allocation of `size` bytes. Returns false if
+     * the allocation would exceed the tag's hard budget, in which
+     * case nothing was recorded and the allocation should fail.
+     */
+    [[nodiscard]] static bool onAllocate(AllocationTag tag, uSys size) noexcept;
+
+    static void onDeallocate(AllocationTag tag, uSys size) noexcept;
+
+    [[nodiscard]] static Snapshot snapshot() noexcept;
+
+    /**
+     *   The change from `before` to `after`. Peaks and budgets
+     * are taken from `after`, call sites that weren't sampled in
+     * between are left out.
+     */
+    [[nodiscard]] static Snapshot diff(const Snapshot& before, const Snapshot& after) noexcept;
+};
+
+/**
+ *   Forwards to another allocator, attributing everything it
+ * allocates to a tag. Each allocation is prefixed with its size
+ * and tag so deallocations are attributed without a lookup.
+ *
+ *   When TAU_ALLOCATION_TRACKING is disabled this forwards
+ * directly to the backing allocator.
+ */
+class TrackedAllocator final : public TauAllocator
+{
+    DELETE_CM(TrackedAllocator);
+private:
+    struct Header final
+    {
+        uSys size;
+        uSys tag;
+    };
+private:
+    TauAllocator& _backing;
+    AllocationTag _tag;
+public:
+    TrackedAllocator(const AllocationTag tag, TauAllocator& backing = DefaultTauAllocator::Instance()) noexcept
+        : _backing(backing)
+        , _tag(tag)
+    { }
+
+    TrackedAllocator(const char* const tagName, TauAllocator& backing = DefaultTauAllocator::Instance()) noexcept
+        : _backing(backing)
+        , _tag(AllocationTracker::registerTag(tagName))
+    { }
+
+    ~TrackedAllocator() noexcept override = default;
+
+    [[nodiscard]] AllocationTag tag() const noexcept { return _tag; }
+    [[nodiscard]] TauAllocator& backing() const noexcept { return _backing; }
+
+    [[nodiscard]] void* allocate(const uSys size) noexcept override
+    {
+#if TAU_ALLOCATION_TRACKING
+        if(!AllocationTracker::onAllocate(_tag, size))
+        { return nullptr; }
+
+        Header* const header = reinterpret_cast<Header*>(_backing.allocate(sizeof(Header) + size));
+        if(!header)
+        {
+            AllocationTracker::onDeallocate(_tag, size);
+            return nullptr;
+        }
+
+        header->size = size;
+        header->tag = _tag;
+        return header + 1;
+#else
+        return _backing.allocate(size);
+#endif
+    }
+
+    void deallocate(void* const obj) noexcept override
+    {
+#if TAU_ALLOCATION_TRACKING
+        if(!obj)
+        { return; }
+
+        Header* const header = reinterpret_cast<Header*>(obj) - 1;
+        AllocationTracker::onDeallocate(static_cast<AllocationTag>(header->tag), header->size);
+        _backing.deallocate(header);
+#else
+        _backing.deallocate(obj);
+#endif
+    }
+};
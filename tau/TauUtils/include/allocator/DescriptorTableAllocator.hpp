@@ -0,0 +1,189 @@
+#pragma once
+
+#include "NumTypes.hpp"
+#include "Objects.hpp"
+#include "Utils.hpp"
+#include "DynArray.hpp"
+
+/**
+ * A contiguous range of descriptors within a heap.
+ */
+struct DescriptorRange final
+{
+    DEFAULT_DESTRUCT(DescriptorRange);
+    DEFAULT_CM_PU(DescriptorRange);
+public:
+    u32 offset;
+    u32 count;
+public:
+    DescriptorRange() noexcept
+        : offset(0)
+        , count(0)
+    { }
+
+    DescriptorRange(const u32 _offset, const u32 _count) noexcept
+        : offset(_offset)
+        , count(_count)
+    { }
+
+    [[nodiscard]] bool valid() const noexcept { return count; }
+    [[nodiscard]] operator bool() const noexcept { return count; }
+};
+
+/**
+ * Sub-allocates descriptor tables out of a descriptor heap.
+ *
+ *   This only deals in descriptor indices, it never touches the
+ * heap itself, so it works the same for every backend. The
+ * heap is split into two regions.
+ *
+ *   The first region holds persistent tables. These are
+ * allocated with a buddy allocator, each table takes up the
+ * next power of two descriptors. The bookkeeping lives entirely
+ * on the CPU as the heap may not be CPU visible. Freed tables
+ * may still be referenced by command lists in flight, so they
+ * aren't returned to the allocator until the fence of the frame
+ * they were freed in has completed.
+ *
+ *   The second region is a ring of transient tables. These are
+ * only valid for the frame they were allocated in and are
+ * never freed individually. Once the fence of a frame completes
+ * everything allocated during it is reclaimed at once.
+ *
+ *   Fence values are expected to increase every frame, and a
+ * frame's fence should be signaled once all of the command
+ * lists recorded during it have finished executing. Anything
+ * done before the first frame is given a fence of 0, so fences
+ * should start at 1.
+ */
+class DescriptorTableAllocator final
+{
+    DEFAULT_DESTRUCT(DescriptorTableAllocator);
+    DELETE_CM(DescriptorTableAllocator);
+public:
+    static constexpr u32 MaxOrder = 32;
+private:
+    static constexpr u32 InvalidIndex = 0xFFFFFFFF;
+    static constexpr u8 FreeBit = 0x80;
+    /**
+     *   Marks descriptors that don't start a block, never equal
+     * to a valid order with or without the free bit.
+     */
+    static constexpr u8 Interior = 0x7F;
+
+    struct PendingFree final
+    {
+        u64 fence;
+        u32 offset;
+        u32 count;
+    };
+
+    struct FrameMarker final
+    {
+        u64 fence;
+        u32 used;
+    };
+private:
+    u32 _persistentCount;
+    u32 _transientCount;
+
+    /**
+     *   Indexed by descriptor. Holds the order of the block and
+     * whether it is free at the start of a block, Interior
+     * everywhere else.
+     */
+    DynArray<u8> _blockState;
+    /**
+     * The links of the free list of each order, indexed by descriptor.
+     */
+    DynArray<u32> _freeNext;
+    DynArray<u32> _freePrev;
+    u32 _freeHeads[MaxOrder];
+    /**
+     * Bit `n` is set if there is a free block of order `n`.
+     */
+    u32 _freeOrders;
+    u32 _persistentFree;
+
+    DynArray<PendingFree> _pendingFrees;
+    u32 _pendingHead;
+    u32 _pendingCount;
+
+    u32 _transientHead;
+    u32 _transientUsed;
+    u32 _transientFrameUsed;
+
+    DynArray<FrameMarker> _frames;
+    u32 _frameHead;
+    u32 _frameCount;
+    u64 _frameFence;
+public:
+    /**
+     * @param[in] persistentCount
+     *      The number of descriptors at the start of the heap
+     *    reserved for persistent tables.
+     * @param[in] transientCount
+     *      The number of descriptors following the persistent
+     *    region reserved for transient tables.
+     * @param[in] maxFramesInFlight
+     *      The most frames that may be submitted without their
+     *    fence having completed.
+     */
+    DescriptorTableAllocator(u32 persistentCount, u32 transientCount, u32 maxFramesInFlight = 3) noexcept;
+
+    /**
+     *   Allocates a persistent table. Returns an invalid range if
+     * there isn't a large enough block free.
+     */
+    [[nodiscard]] DescriptorRange allocate(u32 count) noexcept;
+
+    /**
+     *   Frees a persistent table once the fence of the current
+     * frame has completed.
+     */
+    void free(const DescriptorRange& range) noexcept;
+
+    /**
+     *   Allocates a table that is only valid for the current frame.
+     * Returns an invalid range if the ring is full.
+     */
+    [[nodiscard]] DescriptorRange allocateTransient(u32 count) noexcept;
+
+    /**
+     *   Ends the current frame and starts a new one, reclaiming
+     * everything held by frames whose fence is at most
+     * `completedFence`.
+     *
+     *   Returns false, without starting a new frame, if there are
+     * already `maxFramesInFlight` frames whose fence hasn't
+     * completed. The caller should wait on the oldest frame and try
+     * again.
+     *
+     * @param[in] frameFence
+     *      The fence value that will be signaled when the new
+     *    frame has finished executing.
+     * @param[in] completedFence
+     *      The last fence value the GPU has signaled.
+     */
+    bool beginFrame(u64 frameFence, u64 completedFence) noexcept;
+
+    [[nodiscard]] u32 persistentCount() const noexcept { return _persistentCount; }
+    [[nodiscard]] u32 transientCount() const noexcept { return _transientCount; }
+
+    /**
+     *   The number of persistent descriptors that can be allocated,
+     * tables still waiting on a fence aren't included.
+     */
+    [[nodiscard]] u32 persistentFree() const noexcept { return _persistentFree; }
+    [[nodiscard]] u32 pendingFrees() const noexcept { return _pendingCount; }
+    /**
+     * Includes space skipped when wrapping around the ring.
+     */
+    [[nodiscard]] u32 transientUsed() const noexcept { return _transientUsed; }
+private:
+    void retire(u64 completedFence) noexcept;
+
+    void freeBlock(u32 offset, u32 order) noexcept;
+    void pushFree(u32 offset, u32 order) noexcept;
+    void removeFree(u32 offset, u32 order) noexcept;
+};
@@ -0,0 +1,260 @@
+#pragma once
+
+#include "Objects.hpp"
+#include "NumTypes.hpp"
+#include "TauAllocator.hpp"
+#include "PageAllocator.hpp"
+
+/**
+ * A variable size bump allocator over reserved pages.
+ *
+ *   Allocating only advances an offset, individual
+ * deallocations are ignored. Memory is released all at once,
+ * either by rewinding to a marker or by resetting the arena.
+ * This makes it suitable for temporaries whose lifetime ends at
+ * a known point, like the end of a frame or of a load.
+ *
+ *   Like the FixedBlockAllocator the pages are only reserved up
+ * front, they are committed `allocPages` at a time as the
+ * arena grows. Committed pages are kept when the arena is
+ * rewound, so a steady workload stops touching the page
+ * allocator after the first few frames.
+ */
+class LinearArenaAllocator final : public TauAllocator
+{
+    DELETE_CM(LinearArenaAllocator);
+public:
+    /**
+     * The default alignment, enough for any SSE type.
+     */
+    static constexpr uSys DefaultAlignment = 16;
+
+    using Marker = uSys;
+private:
+    uSys _allocPages;
+    uSys _numReservedPages;
+    u8* _pages;
+    uSys _committedBytes;
+    uSys _allocIndex;
+    uSys _highWater;
+public:
+    LinearArenaAllocator(PageCountVal numReservedPages = static_cast<PageCountVal>(16384), uSys allocPages = 16) noexcept;
+
+    ~LinearArenaAllocator() noexcept override;
+
+    [[nodiscard]] const void* head() const noexcept { return _pages; }
+    [[nodiscard]] uSys reservedPages() const noexcept { return _numReservedPages; }
+    [[nodiscard]] uSys committedPages() const noexcept { return _committedBytes / PageAllocator::pageSize(); }
+    [[nodiscard]] uSys allocIndex() const noexcept { return _allocIndex; }
+
+    /**
+     * The most bytes that have been in use at once.
+     */
+    [[nodiscard]] uSys highWater() const noexcept { return _highWater; }
+
+    [[nodiscard]] bool owns(const void* const ptr) const noexcept
+    { return ptr >= _pages && ptr < _pages + _allocIndex; }
+
+    [[nodiscard]] void* allocate(const uSys size, const AllocationAlignment alignment) noexcept
+    {
+        const uSys align = static_cast<uSys>(alignment);
+        const uSys start = (_allocIndex + align - 1) & ~(align - 1);
+
+        // Compared against the space left so that a huge size can't wrap `start + size`.
+        if((start > _committedBytes || size > _committedBytes - start) && !commit(start, size))
+        { return nullptr; }
+
+        const uSys end = start + size;
+        _allocIndex = end;
+        if(end > _highWater)
+        { _highWater = end; }
+        return _pages + start;
+    }
+
+    [[nodiscard]] void* allocate(const uSys size) noexcept override
+    { return allocate(size, static_cast<AllocationAlignment>(DefaultAlignment)); }
+
+    /**
+     * Individual allocations are released by rewinding.
+     */
+    void deallocate(void*) noexcept override { }
+
+    [[nodiscard]] Marker mark() const noexcept { return _allocIndex; }
+
+    /**
+     *   Releases everything allocated since `marker` was taken.
+     * Objects in the released range are not destructed.
+     */
+    void rewind(Marker marker) noexcept;
+
+    void reset() noexcept { rewind(0); }
+
+    /**
+     *   Decommits every page past the ones currently in use,
+     * keeping at least `keepPages` committed.
+     */
+    void trim(uSys keepPages = 0) noexcept;
+private:
+    [[nodiscard]] bool commit(uSys start, uSys size) noexcept;
+};
+
+/**
+ * A LIFO allocator for short lived scratch memory.
+ *
+ *   Each allocation is preceded by a small header recording
+ * where the previous allocation ended, so deallocating the most
+ * recent allocation pops it off the stack. Deallocating anything
+ * else is ignored, its memory is only reclaimed by rewinding to
+ * a marker taken before it.
+ *
+ *   Every thread has its own instance through
+ * {@link ScratchAllocator::threadLocal() @endlink}, which is
+ * typically used through a ScratchScope.
+ */
+class ScratchAllocator final : public TauAllocator
+{
+    DELETE_CM(ScratchAllocator);
+public:
+    struct Marker final
+    {
+        uSys index;
+        uSys top;
+    };
+private:
+    struct Header final
+    {
+        uSys previousTop;
+        uSys previousIndex;
+    };
+private:
+    LinearArenaAllocator _arena;
+    /**
+     * The offset of the topmost allocation, 0 when empty.
+     */
+    uSys _top;
+public:
+    ScratchAllocator(PageCountVal numReservedPages = static_cast<PageCountVal>(4096), uSys allocPages = 4) noexcept
+        : _arena(numReservedPages, allocPages)
+        , _top(0)
+    { }
+
+    ~ScratchAllocator() noexcept override = default;
+
+    [[nodiscard]] static ScratchAllocator& threadLocal() noexcept;
+
+    [[nodiscard]] const LinearArenaAllocator& arena() const noexcept { return _arena; }
+
+    [[nodiscard]] void* allocate(const uSys size, const AllocationAlignment alignment) noexcept
+    {
+        const uSys previousIndex = _arena.allocIndex();
+        const uSys align = static_cast<uSys>(alignment) < alignof(Header) ? alignof(Header) : static_cast<uSys>(alignment);
+        const uSys headerPad = (sizeof(Header) + align - 1) & ~(align - 1);
+
+        // The arena rejects anything past its reservation, as long as `headerPad + size` doesn't wrap.
+        if(size > ~static_cast<uSys>(0) - headerPad)
+        { return nullptr; }
+
+        u8* const block = reinterpret_cast<u8*>(_arena.allocate(headerPad + size, static_cast<AllocationAlignment>(align)));
+        if(!block)
+        { return nullptr; }
+
+        u8* const ret = block + headerPad;
+        Header* const header = reinterpret_cast<Header*>(ret) - 1;
+        header->previousTop = _top;
+        header->previousIndex = previousIndex;
+        _top = static_cast<uSys>(ret - reinterpret_cast<const u8*>(_arena.head()));
+        return ret;
+    }
+
+    [[nodiscard]] void* allocate(const uSys size) noexcept override
+    { return allocate(size, static_cast<AllocationAlignment>(LinearArenaAllocator::DefaultAlignment)); }
+
+    void deallocate(void* const obj) noexcept override
+    {
+        if(!obj || !_top || obj != reinterpret_cast<const u8*>(_arena.head()) + _top)
+        { return; }
+
+        const Header* const header = reinterpret_cast<const Header*>(obj) - 1;
+        _top = header->previousTop;
+        _arena.rewind(header->previousIndex);
+    }
+
+    [[nodiscard]] Marker mark() const noexcept { return { _arena.mark(), _top }; }
+
+    void rewind(const Marker& marker) noexcept
+    {
+        _top = marker.top;
+        _arena.rewind(marker.index);
+    }
+};
+
+/**
+ *   Takes a marker of a ScratchAllocator on construction and
+ * rewinds to it on destruction.
+ */
+class ScratchScope final
+{
+    DELETE_CM(ScratchScope);
+private:
+    ScratchAllocator& _allocator;
+    ScratchAllocator::Marker _marker;
+public:
+    ScratchScope(ScratchAllocator& allocator = ScratchAllocator::threadLocal()) noexcept
+        : _allocator(allocator)
+        , _marker(allocator.mark())
+    { }
+
+    ~ScratchScope() noexcept
+    { _allocator.rewind(_marker); }
+
+    [[nodiscard]] ScratchAllocator& allocator() noexcept { return _allocator; }
+
+    [[nodiscard]] operator TauAllocator&() noexcept { return _allocator; }
+
+    template<typename _T>
+    [[nodiscard]] _T* allocateArray(const uSys count) noexcept
+    { return reinterpret_cast<_T*>(_allocator.allocate(sizeof(_T) * count, static_cast<AllocationAlignment>(alignof(_T) > LinearArenaAllocator::DefaultAlignment ? alignof(_T) : LinearArenaAllocator::DefaultAlignment))); }
+};
+
+/**
+ * A set of linear arenas cycled once per frame.
+ *
+ *   Memory allocated during a frame stays valid until the same
+ * arena comes back around, `frameCount - 1` frames later. Two
+ * frames allow handing data to the next frame, three allow
+ * handing it to a renderer that runs a frame behind.
+ */
+class FrameArenaAllocator final : public TauAllocator
+{
+    DELETE_CM(FrameArenaAllocator);
+private:
+    LinearArenaAllocator* _arenas;
+    uSys _frameCount;
+    uSys _frameIndex;
+public:
+    FrameArenaAllocator(uSys frameCount = 2, PageCountVal numReservedPagesPerFrame = static_cast<PageCountVal>(16384), uSys allocPages = 16) noexcept;
+
+    ~FrameArenaAllocator() noexcept override;
+
+    [[nodiscard]] static FrameArenaAllocator& threadLocal() noexcept;
+
+    [[nodiscard]] uSys frameCount() const noexcept { return _frameCount; }
+    [[nodiscard]] uSys frameIndex() const noexcept { return _frameIndex; }
+
+    [[nodiscard]] LinearArenaAllocator& current() noexcept { return _arenas[_frameIndex]; }
+    [[nodiscard]] const LinearArenaAllocator& current() const noexcept { return _arenas[_frameIndex]; }
+
+    [[nodiscard]] void* allocate(const uSys size, const AllocationAlignment alignment) noexcept
+    { return _arenas[_frameIndex].allocate(size, alignment); }
+
+    [[nodiscard]] void* allocate(const uSys size) noexcept override
+    { return _arenas[_frameIndex].allocate(size); }
+
+    void deallocate(void*) noexcept override { }
+
+    /**
+     *   Moves on to the next arena and resets it, releasing the
+     * memory allocated `frameCount` frames ago.
+     */
+    void nextFrame() noexcept;
+};
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "NumTypes.hpp"
+#include "Objects.hpp"
+#include "Utils.hpp"
+#include "DynArray.hpp"
+
+/**
+ * A two level segregated fit allocator for a range of offsets.
+ *
+ *   This never touches the memory it manages, it only hands out
+ * offsets into it. This makes it suitable for sub-allocating
+ * GPU memory, which may not even be CPU visible.
+ *
+ *   Free blocks are kept in lists segregated first by their
+ * power of two and then linearly within that power of two.
+ * Finding a free block takes two bit scans, and adjacent free
+ * blocks are merged immediately when freeing, so both allocating
+ * and freeing are O(1).
+ *
+ *   The bookkeeping is kept in a pool of nodes, one per block,
+ * that is grown as needed. Blocks refer to each other by index
+ * so growing the pool doesn't invalidate anything.
+ */
+class TLSFAllocator final
+{
+    DELETE_CM(TLSFAllocator);
+public:
+    static constexpr u32 InvalidNode = 0xFFFFFFFF;
+
+    /**
+     * The number of linear subdivisions within each power of two.
+     */
+    static constexpr u32 SLLog2 = 5;
+    static constexpr u32 SLCount = 1 << SLLog2;
+    static constexpr u32 FLCount = 64 - SLLog2 + 1;
+
+    struct Allocation final
+    {
+        u64 offset;
+        u64 size;
+        u32 node;
+
+        [[nodiscard]] bool valid() const noexcept { return node != InvalidNode; }
+    };
+
+    struct Stats final
+    {
+        u64 size;
+        u64 used;
+        u64 largestFree;
+        u32 allocationCount;
+        u32 freeBlockCount;
+    };
+private:
+    struct Node final
+    {
+        u64 offset;
+        u64 size;
+        void* userData;
+        u32 prevPhys;
+        u32 nextPhys;
+        u32 prevFree;
+        /**
+         * Also links unused nodes in the pool.
+         */
+        u32 nextFree;
+        u8 isFree;
+        u8 alignmentLog2;
+    };
+private:
+    u64 _size;
+    u64 _used;
+    u32 _allocationCount;
+    u32 _freeBlockCount;
+
+    DynArray<Node> _nodes;
+    u32 _nodeCount;
+    u32 _unusedNodes;
+    u32 _firstPhys;
+
+    u64 _flBitmap;
+    u32 _slBitmaps[FLCount];
+    u32 _heads[FLCount][SLCount];
+public:
+    TLSFAllocator(u64 size, u32 initialNodes = 64) noexcept;
+    ~TLSFAllocator() noexcept = default;
+
+    /**
+     *   Returns an invalid allocation if there isn't a large enough
+     * free block or if the alignment isn't a power of two.
+     *
+     * @param[in] userData
+     *      Stored with the allocation, this is passed back when
+     *    iterating over allocations to defragment.
+     */
+    [[nodiscard]] Allocation allocate(u64 size, u64 alignment = 1, void* userData = nullptr) noexcept;
+
+    void free(u32 node) noexcept;
+    void free(const Allocation& allocation) noexcept { free(allocation.node); }
+
+    [[nodiscard]] u64 size() const noexcept { return _size; }
+    [[nodiscard]] u64 used() const noexcept { return _used; }
+    [[nodiscard]] u32 allocationCount() const noexcept { return _allocationCount; }
+    [[nodiscard]] bool empty() const noexcept { return !_allocationCount; }
+
+    /**
+     * The largest free block is found by walking a single free list.
+     */
+    [[nodiscard]] Stats stats() const noexcept;
+
+    /**
+     *   Iterates over every block, free or not, in order of offset.
+     * Returns InvalidNode past the last block.
+     */
+    [[nodiscard]] u32 firstNode() const noexcept { return _firstPhys; }
+    [[nodiscard]] u32 nextNode(const u32 node) const noexcept { return _nodes[node].nextPhys; }
+
+    [[nodiscard]] bool isFree(const u32 node) const noexcept { return _nodes[node].isFree; }
+    [[nodiscard]] u64 offset(const u32 node) const noexcept { return _nodes[node].offset; }
+    [[nodiscard]] u64 size(const u32 node) const noexcept { return _nodes[node].size; }
+    [[nodiscard]] u64 alignment(const u32 node) const noexcept { return 1ull << _nodes[node].alignmentLog2; }
+    [[nodiscard]] void* userData(const u32 node) const noexcept { return _nodes[node].userData; }
+private:
+    [[nodiscard]] u32 createNode() noexcept;
+    void releaseNode(u32 node) noexcept;
+
+    void insertFree(u32 node) noexcept;
+    void removeFree(u32 node) noexcept;
+    [[nodiscard]] u32 findFree(u64 size) const noexcept;
+    /**
+     *   The search rounds up to the next bin so that it never has to
+     * look at a block that's too small. Without this a block of
+     * exactly the right size could be missed when it's the last
+     * free block large enough.
+     */
+    [[nodiscard]] u32 findFreeExact(u64 size) const noexcept;
+};
+
+/**
+ * Sub-allocates resources out of large blocks of memory.
+ *
+ *   Each block is managed by a TLSFAllocator, the blocks
+ * themselves are created by the backend through createBlock. An
+ * allocation larger than half the block size gets a block of
+ * its own.
+ *
+ *   When a block becomes empty it is destroyed, unless it is the
+ * only empty block, in which case it is kept around so that
+ * allocating and freeing around a block boundary doesn't
+ * repeatedly create and destroy a block.
+ */
+class TLSFBlockAllocator
+{
+    DEFAULT_DESTRUCT_VI(TLSFBlockAllocator);
+    DELETE_CM(TLSFBlockAllocator);
+public:
+    static constexpr u32 InvalidBlock = 0xFFFFFFFF;
+
+    struct Allocation final
+    {
+        DEFAULT_DESTRUCT(Allocation);
+        DEFAULT_CM_PU(Allocation);
+    public:
+        /**
+         * The handle returned by createBlock.
+         */
+        void* blockHandle;
+        u64 offset;
+        u64 size;
+        u32 block;
+        u32 node;
+    public:
+        Allocation() noexcept
+            : blockHandle(nullptr)
+            , offset(0)
+            , size(0)
+            , block(InvalidBlock)
+            , node(TLSFAllocator::InvalidNode)
+        { }
+
+        Allocation(void* const _blockHandle, const u64 _offset, const u64 _size, const u32 _block, const u32 _node) noexcept
+            : blockHandle(_blockHandle)
+            , offset(_offset)
+            , size(_size)
+            , block(_block)
+            , node(_node)
+        { }
+
+        [[nodiscard]] bool valid() const noexcept { return block != InvalidBlock; }
+        [[nodiscard]] operator bool() const noexcept { return block != InvalidBlock; }
+    };
+
+    struct Stats final
+    {
+        u64 reserved;
+        u64 used;
+        u64 largestFree;
+        u32 blockCount;
+        u32 allocationCount;
+        u32 freeBlockCount;
+    };
+protected:
+    struct Block final
+    {
+        TLSFAllocator* allocator;
+        void* handle;
+        bool dedicated;
+    };
+protected:
+    u64 _blockSize;
+    DynArray<Block> _blocks;
+    u32 _blockCount;
+    /**
+     * The empty block kept around instead of being destroyed.
+     */
+    u32 _spareBlock;
+public:
+    /**
+     * @param[in] blockSize
+     *      The size of each block created for regular allocations.
+     * @param[in] maxBlocks
+     *      The maximum number of blocks that can exist at once.
+     */
+    TLSFBlockAllocator(u64 blockSize, u32 maxBlocks = 256) noexcept;
+
+    /**
+     * Destroys every block, this has to be called by the destructor of the implementation.
+     */
+    void release() noexcept;
+
+    /**
+     * @param[in] userData
+     *      Passed to moveAllocation when defragmenting.
+     */
+    [[nodiscard]] Allocation allocate(u64 size, u64 alignment = 1, void* userData = nullptr) noexcept;
+
+    void free(const Allocation& allocation) noexcept;
+
+    /**
+     *   Empties the least used block by moving its allocations
+     * into the other blocks, then destroys it. The moves are
+     * reported through moveAllocation.
+     *
+     * @param[in] maxBytes
+     *      Stops once this many bytes have been moved, which
+     *    allows defragmenting a little at a time.
+     * @return
+     *      The number of bytes moved.
+     */
+    u64 defragment(u64 maxBytes) noexcept;
+
+    [[nodiscard]] u64 blockSize() const noexcept { return _blockSize; }
+    [[nodiscard]] u32 blockCount() const noexcept { return _blockCount; }
+
+    [[nodiscard]] Stats stats() const noexcept;
+protected:
+    /**
+     *   Creates the backing memory of a block, such as a buffer or
+     * heap. Returns false if it couldn't be created.
+     */
+    virtual bool createBlock(u64 size, [[tau::out]] void** handle) noexcept = 0;
+
+    virtual void destroyBlock(void* handle) noexcept = 0;
+
+    /**
+     *   Copies an allocation to a new location while
+     * defragmenting. `to` replaces `from`, which is freed once this
+     * returns, so the owner identified by `userData` needs to
+     * update its allocation. If the copy is only recorded here and
+     * executed later the source block must be kept alive until it
+     * has finished, as the block may be destroyed once it is empty.
+     */
+    virtual void moveAllocation(const Allocation& from, const Allocation& to, void* userData) noexcept = 0;
+private:
+    [[nodiscard]] u32 createBlockSlot(u64 size, bool dedicated) noexcept;
+    void destroyBlockSlot(u32 block) noexcept;
+    [[nodiscard]] Allocation allocateExcluding(u64 size, u64 alignment, void* userData, u32 excludedBlock) noexcept;
+};
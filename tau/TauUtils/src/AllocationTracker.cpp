@@ -0,0 +1,441 @@
+#include "allocator/AllocationTracker.hpp"
+#include "TUMaths.hpp"
+
+#pragma warning(push, 0)
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#ifdef _WIN32
+  #include <Windows.h>
+#elif defined(__has_include)
+  #if __has_include(<execinfo.h>)
+    #include <execinfo.h>
+    #define TAU_HAS_EXECINFO 1
+  #endif
+#endif
+#pragma warning(pop)
+
+namespace {
+
+struct TagState final
+{
+    ::std::atomic<i64> bytes;
+    ::std::atomic<i64> peakBytes;
+    ::std::atomic<i64> rejected;
+    ::std::atomic<u64> softBudget;
+    ::std::atomic<u64> hardBudget;
+    ::std::atomic<AllocationTracker::BudgetCallback> callback;
+    ::std::atomic<void*> userParam;
+    char name[AllocationTracker::MaxTagNameLength + 1];
+};
+
+/**
+ *   Counters written only by the thread that owns the block,
+ * so they are updated with plain loads and stores. They are
+ * atomic so that snapshots can read them from other threads.
+ */
+struct ThreadState final
+{
+    ::std::atomic<bool> inUse;
+    ThreadState* next;
+    u32 sampleCountdown;
+    /**
+     * Bytes not yet published to the tag.
+     */
+    ::std::atomic<i64> pendingBytes[AllocationTracker::MaxTags];
+    ::std::atomic<i64> allocations[AllocationTracker::MaxTags];
+    ::std::atomic<i64> deallocations[AllocationTracker::MaxTags];
+    ::std::atomic<i64> histogram[AllocationTracker::MaxTags * AllocationTracker::SizeClassCount];
+};
+
+struct ThreadStateHolder final
+{
+    ThreadState* state;
+
+    ~ThreadStateHolder() noexcept
+    {
+        if(state)
+        { state->inUse.store(false, ::std::memory_order_release); }
+    }
+};
+
+struct CallSiteKey final
+{
+    u64 hash;
+
+    [[nodiscard]] bool operator ==(const CallSiteKey& other) const noexcept
+    { return hash == other.hash; }
+};
+
+struct CallSiteKeyHash final
+{
+    [[nodiscard]] uSys operator()(const CallSiteKey& key) const noexcept
+    { return static_cast<uSys>(key.hash); }
+};
+
+}
+
+static TagState _tags[AllocationTracker::MaxTags];
+static ::std::atomic<u32> _tagCount(1);
+static ::std::mutex _tagMutex;
+
+static ::std::atomic<ThreadState*> _threadStates(nullptr);
+static ::std::atomic<u32> _sampleInterval(AllocationTracker::DefaultSampleInterval);
+
+static ::std::mutex _callSiteMutex;
+static ::std::unordered_map<CallSiteKey, AllocationTracker::CallSite, CallSiteKeyHash>* _callSites = nullptr;
+
+static ThreadState* acquireThreadState() noexcept
+{
+    for(ThreadState* state = _threadStates.load(::std::memory_order_acquire); state; state = state->next)
+    {
+        bool expected = false;
+        if(state->inUse.compare_exchange_strong(expected, true, ::std::memory_order_acquire))
+        { return state; }
+    }
+
+    ThreadState* const state = new(::std::nothrow) ThreadState();
+    if(!state)
+    { return nullptr; }
+
+    state->inUse.store(true, ::std::memory_order_relaxed);
+    state->sampleCountdown = _sampleInterval.load(::std::memory_order_relaxed);
+    state->next = _threadStates.load(::std::memory_order_relaxed);
+    while(!_threadStates.compare_exchange_weak(state->next, state, ::std::memory_order_release, ::std::memory_order_relaxed)) { }
+    return state;
+}
+
+/**
+ *   The holder has a destructor, which makes every access to it
+ * go through a guard, so the hot path reads a plain pointer and
+ * only touches the holder once per thread.
+ */
+static thread_local ThreadState* _threadState = nullptr;
+
+static ThreadState* initThreadState() noexcept
+{
+    static thread_local ThreadStateHolder holder { nullptr };
+    holder.state = acquireThreadState();
+    _threadState = holder.state;
+    return _threadState;
+}
+
+static inline ThreadState* threadState() noexcept
+{
+    ThreadState* const state = _threadState;
+    return state ? state : initThreadState();
+}
+
+static inline void increment(::std::atomic<i64>& counter) noexcept
+{ counter.store(counter.load(::std::memory_order_relaxed) + 1, ::std::memory_order_relaxed); }
+
+static u32 captureStack(void** const frames) noexcept
+{
+    // Skip the frames within the tracker itself.
+    constexpr u32 Skip = 3;
+#ifdef _WIN32
+    return CaptureStackBackTrace(Skip, AllocationTracker::MaxStackDepth, frames, nullptr);
+#elif defined(TAU_HAS_EXECINFO)
+    void* all[AllocationTracker::MaxStackDepth + Skip];
+    const int depth = backtrace(all, AllocationTracker::MaxStackDepth + Skip);
+    if(depth <= static_cast<int>(Skip))
+    { return 0; }
+    ::std::memcpy(frames, all + Skip, sizeof(void*) * (depth - Skip));
+    return static_cast<u32>(depth - Skip);
+#else
+    (void) frames;
+    return 0;
+#endif
+}
+
+static void recordSample(const AllocationTag tag, const uSys size) noexcept
+{
+    AllocationTracker::CallSite site;
+    site.tag = tag;
+    site.depth = captureStack(site.frames);
+    site.samples = 1;
+    site.sampledBytes = static_cast<i64>(size);
+
+    u64 hash = 0xCBF29CE484222325ull ^ tag;
+    for(u32 i = 0; i < site.depth; ++i)
+    {
+        hash ^= static_cast<u64>(reinterpret_cast<uSys>(site.frames[i]));
+        hash *= 0x00000100000001B3ull;
+    }
+
+    ::std::lock_guard<::std::mutex> lock(_callSiteMutex);
+    if(!_callSites)
+    {
+        _callSites = new(::std::nothrow) ::std::unordered_map<CallSiteKey, AllocationTracker::CallSite, CallSiteKeyHash>();
+        if(!_callSites)
+        { return; }
+    }
+
+    const auto it = _callSites->find(CallSiteKey { hash });
+    if(it != _callSites->end())
+    {
+        ++it->second.samples;
+        it->second.sampledBytes += site.sampledBytes;
+    }
+    else if(_callSites->size() < AllocationTracker::MaxCallSites)
+    { (void) _callSites->emplace(CallSiteKey { hash }, site); }
+}
+
+static void notify(TagState& state, const AllocationTag tag, const AllocationTracker::BudgetLevel level, const i64 bytes, const u64 budget) noexcept
+{
+    const AllocationTracker::BudgetCallback callback = state.callback.load(::std::memory_order_acquire);
+    if(callback)
+    { callback(tag, level, static_cast<u64>(bytes), budget, state.userParam.load(::std::memory_order_relaxed)); }
+}
+
+static inline void updatePeak(TagState& state, const i64 bytes) noexcept
+{
+    i64 peak = state.peakBytes.load(::std::memory_order_relaxed);
+    while(bytes > peak && !state.peakBytes.compare_exchange_weak(peak, bytes, ::std::memory_order_relaxed)) { }
+}
+
+/**
+ *   Adds `delta` bytes to the tag and checks its budgets.
+ * `delta` ends with an allocation of `size` bytes, which is
+ * the only part rolled back if it would exceed the hard budget.
+ */
+static bool publish(TagState& state, const AllocationTag tag, const i64 delta, const i64 size, const u64 softBudget, const u64 hardBudget) noexcept
+{
+    const i64 before = state.bytes.fetch_add(delta, ::std::memory_order_relaxed);
+    const i64 after = before + delta;
+
+    if(hardBudget && after > 0 && static_cast<u64>(after) > hardBudget)
+    {
+        state.bytes.fetch_sub(size, ::std::memory_order_relaxed);
+        state.rejected.fetch_add(1, ::std::memory_order_relaxed);
+        updatePeak(state, after - size);
+        notify(state, tag, AllocationTracker::BudgetLevel::Hard, after, hardBudget);
+        return false;
+    }
+
+    if(softBudget && after > 0 && static_cast<u64>(before) <= softBudget && static_cast<u64>(after) > softBudget)
+    { notify(state, tag, AllocationTracker::BudgetLevel::Soft, after, softBudget); }
+
+    updatePeak(state, after);
+    return true;
+}
+
+AllocationTag AllocationTracker::registerTag(const char* const name) noexcept
+{
+    if(!name)
+    { return Untagged; }
+
+    ::std::lock_guard<::std::mutex> lock(_tagMutex);
+
+    const u32 count = _tagCount.load(::std::memory_order_relaxed);
+    for(u32 i = 1; i < count; ++i)
+    {
+        if(::std::strncmp(_tags[i].name, name, MaxTagNameLength) == 0)
+        { return static_cast<AllocationTag>(i); }
+    }
+
+    if(count == MaxTags)
+    { return Untagged; }
+
+    ::std::strncpy(_tags[count].name, name, MaxTagNameLength);
+    _tags[count].name[MaxTagNameLength] = '\0';
+    _tagCount.store(count + 1, ::std::memory_order_release);
+    return static_cast<AllocationTag>(count);
+}
+
+const char* AllocationTracker::tagName(const AllocationTag tag) noexcept
+{
+    if(tag == Untagged || tag >= _tagCount.load(::std::memory_order_acquire))
+    { return "untagged"; }
+    return _tags[tag].name;
+}
+
+void AllocationTracker::setBudget(const AllocationTag tag, const u64 softBudget, const u64 hardBudget, const BudgetCallback callback, void* const userParam) noexcept
+{
+    if(tag >= MaxTags)
+    { return; }
+
+    TagState& state = _tags[tag];
+    state.userParam.store(userParam, ::std::memory_order_relaxed);
+    state.callback.store(callback, ::std::memory_order_release);
+    state.softBudget.store(softBudget, ::std::memory_order_relaxed);
+    state.hardBudget.store(hardBudget, ::std::memory_order_relaxed);
+}
+
+void AllocationTracker::setSampleInterval(const u32 interval) noexcept
+{ _sampleInterval.store(interval, ::std::memory_order_relaxed); }
+
+u32 AllocationTracker::sizeClass(const uSys size) noexcept
+{
+    if(!size)
+    { return 0; }
+
+    const u32 sizeClass = 64 - static_cast<u32>(_clz(static_cast<u64>(size)));
+    return sizeClass < SizeClassCount ? sizeClass : SizeClassCount - 1;
+}
+
+bool AllocationTracker::onAllocate(AllocationTag tag, const uSys size) noexcept
+{
+    if(tag >= MaxTags)
+    { tag = Untagged; }
+
+    TagState& state = _tags[tag];
+    const u64 softBudget = state.softBudget.load(::std::memory_order_relaxed);
+    const u64 hardBudget = state.hardBudget.load(::std::memory_order_relaxed);
+
+    ThreadState* const thread = threadState();
+    if(!thread)
+    { return publish(state, tag, static_cast<i64>(size), static_cast<i64>(size), softBudget, hardBudget); }
+
+    // Budgeted tags are published on every allocation so the budgets are enforced exactly.
+    const i64 pending = thread->pendingBytes[tag].load(::std::memory_order_relaxed) + static_cast<i64>(size);
+    if(softBudget || hardBudget || pending >= FlushBytes)
+    {
+        thread->pendingBytes[tag].store(0, ::std::memory_order_relaxed);
+        if(!publish(state, tag, pending, static_cast<i64>(size), softBudget, hardBudget))
+        { return false; }
+    }
+    else
+    { thread->pendingBytes[tag].store(pending, ::std::memory_order_relaxed); }
+
+    increment(thread->allocations[tag]);
+    increment(thread->histogram[static_cast<uSys>(tag) * SizeClassCount + sizeClass(size)]);
+
+    const u32 interval = _sampleInterval.load(::std::memory_order_relaxed);
+    if(interval)
+    {
+        // Picks up a shorter interval without waiting out the old countdown.
+        if(thread->sampleCountdown > interval)
+        { thread->sampleCountdown = interval; }
+
+        if(thread->sampleCountdown <= 1)
+        {
+            thread->sampleCountdown = interval;
+            recordSample(tag, size);
+        }
+        else
+        { --thread->sampleCountdown; }
+    }
+
+    return true;
+}
+
+void AllocationTracker::onDeallocate(AllocationTag tag, const uSys size) noexcept
+{
+    if(tag >= MaxTags)
+    { tag = Untagged; }
+
+    ThreadState* const thread = threadState();
+    if(!thread)
+    {
+        _tags[tag].bytes.fetch_sub(static_cast<i64>(size), ::std::memory_order_relaxed);
+        return;
+    }
+
+    const i64 pending = thread->pendingBytes[tag].load(::std::memory_order_relaxed) - static_cast<i64>(size);
+    if(pending <= -FlushBytes)
+    {
+        thread->pendingBytes[tag].store(0, ::std::memory_order_relaxed);
+        _tags[tag].bytes.fetch_add(pending, ::std::memory_order_relaxed);
+    }
+    else
+    { thread->pendingBytes[tag].store(pending, ::std::memory_order_relaxed); }
+
+    increment(thread->deallocations[tag]);
+}
+
+AllocationTracker::Snapshot AllocationTracker::snapshot() noexcept
+{
+    Snapshot snapshot;
+    snapshot.sampleInterval = _sampleInterval.load(::std::memory_order_relaxed);
+
+    const u32 tagCount = _tagCount.load(::std::memory_order_acquire);
+    snapshot.tags.resize(tagCount);
+    snapshot.histogram.assign(static_cast<uSys>(tagCount) * SizeClassCount, 0);
+
+    for(u32 i = 0; i < tagCount; ++i)
+    {
+        const TagState& state = _tags[i];
+        TagStats& stats = snapshot.tags[i];
+        stats.tag = static_cast<AllocationTag>(i);
+        ::std::strncpy(stats.name, tagName(stats.tag), MaxTagNameLength);
+        stats.name[MaxTagNameLength] = '\0';
+        stats.bytes = state.bytes.load(::std::memory_order_relaxed);
+        stats.peakBytes = state.peakBytes.load(::std::memory_order_relaxed);
+        stats.allocations = 0;
+        stats.liveAllocations = 0;
+        stats.rejected = state.rejected.load(::std::memory_order_relaxed);
+        stats.softBudget = state.softBudget.load(::std::memory_order_relaxed);
+        stats.hardBudget = state.hardBudget.load(::std::memory_order_relaxed);
+    }
+
+    for(const ThreadState* thread = _threadStates.load(::std::memory_order_acquire); thread; thread = thread->next)
+    {
+        for(u32 i = 0; i < tagCount; ++i)
+        {
+            const i64 allocations = thread->allocations[i].load(::std::memory_order_relaxed);
+            snapshot.tags[i].bytes += thread->pendingBytes[i].load(::std::memory_order_relaxed);
+            snapshot.tags[i].allocations += allocations;
+            snapshot.tags[i].liveAllocations += allocations - thread->deallocations[i].load(::std::memory_order_relaxed);
+
+            for(u32 j = 0; j < SizeClassCount; ++j)
+            { snapshot.histogram[i * SizeClassCount + j] += thread->histogram[i * SizeClassCount + j].load(::std::memory_order_relaxed); }
+        }
+    }
+
+    for(TagStats& stats : snapshot.tags)
+    {
+        if(stats.bytes > stats.peakBytes)
+        { stats.peakBytes = stats.bytes; }
+    }
+
+    ::std::lock_guard<::std::mutex> lock(_callSiteMutex);
+    if(_callSites)
+    {
+        snapshot.callSites.reserve(_callSites->size());
+        for(const auto& site : *_callSites)
+        { snapshot.callSites.push_back(site.second); }
+    }
+
+    return snapshot;
+}
+
+AllocationTracker::Snapshot AllocationTracker::diff(const Snapshot& before, const Snapshot& after) noexcept
+{
+    Snapshot diff;
+    diff.sampleInterval = after.sampleInterval;
+    diff.tags = after.tags;
+    diff.histogram = after.histogram;
+
+    // Tags are never unregistered, so `after` has every tag `before` has.
+    for(uSys i = 0; i < before.tags.size() && i < diff.tags.size(); ++i)
+    {
+        diff.tags[i].bytes -= before.tags[i].bytes;
+        diff.tags[i].allocations -= before.tags[i].allocations;
+        diff.tags[i].liveAllocations -= before.tags[i].liveAllocations;
+        diff.tags[i].rejected -= before.tags[i].rejected;
+    }
+
+    for(uSys i = 0; i < before.histogram.size() && i < diff.histogram.size(); ++i)
+    { diff.histogram[i] -= before.histogram[i]; }
+
+    for(const CallSite& site : after.callSites)
+    {
+        CallSite delta = site;
+        for(const CallSite& old : before.callSites)
+        {
+            if(old.tag == site.tag && old.depth == site.depth && ::std::memcmp(old.frames, site.frames, sizeof(void*) * site.depth) == 0)
+            {
+                delta.samples -= old.samples;
+                delta.sampledBytes -= old.sampledBytes;
+                break;
+            }
+        }
+
+        if(delta.samples)
+        { diff.callSites.push_back(delta); }
+    }
+
+    return diff;
+}
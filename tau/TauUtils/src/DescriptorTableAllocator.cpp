@@ -0,0 +1,214 @@
+#include "allocator/DescriptorTableAllocator.hpp"
+#include "TUMaths.hpp"
+
+/**
+ * The order of the smallest block that can hold `count` descriptors.
+ */
+[[nodiscard]] static inline u32 blockOrder(const u32 count) noexcept
+{ return count <= 1 ? 0 : 32 - _clz(count - 1); }
+
+DescriptorTableAllocator::DescriptorTableAllocator(const u32 persistentCount, const u32 transientCount, const u32 maxFramesInFlight) noexcept
+    : _persistentCount(persistentCount)
+    , _transientCount(transientCount)
+    , _blockState(persistentCount)
+    , _freeNext(persistentCount)
+    , _freePrev(persistentCount)
+    , _freeHeads { }
+    , _freeOrders(0)
+    , _persistentFree(0)
+    , _pendingFrees(persistentCount)
+    , _pendingHead(0)
+    , _pendingCount(0)
+    , _transientHead(0)
+    , _transientUsed(0)
+    , _transientFrameUsed(0)
+    , _frames(maxFramesInFlight ? maxFramesInFlight : 1)
+    , _frameHead(0)
+    , _frameCount(0)
+    , _frameFence(0)
+{
+    for(u32 i = 0; i < MaxOrder; ++i)
+    { _freeHeads[i] = InvalidIndex; }
+
+    for(u32 i = 0; i < persistentCount; ++i)
+    { _blockState[i] = Interior; }
+
+    // Cover the region with the largest naturally aligned blocks that fit.
+    u32 offset = 0;
+    while(offset < persistentCount)
+    {
+        u32 order = offset ? _ctz(offset) : MaxOrder - 1;
+        while(order > 0 && (static_cast<u64>(offset) + (1ull << order) > persistentCount))
+        { --order; }
+
+        pushFree(offset, order);
+        _persistentFree += 1u << order;
+        offset += 1u << order;
+    }
+}
+
+DescriptorRange DescriptorTableAllocator::allocate(const u32 count) noexcept
+{
+    if(!count || count > _persistentCount)
+    { return DescriptorRange(); }
+
+    const u32 order = blockOrder(count);
+    const u32 available = order < MaxOrder ? _freeOrders & ~((1u << order) - 1) : 0;
+    if(!available)
+    { return DescriptorRange(); }
+
+    u32 freeOrder = _ctz(available);
+    const u32 offset = _freeHeads[freeOrder];
+    removeFree(offset, freeOrder);
+
+    // Return the upper halves until the block is the right size.
+    while(freeOrder > order)
+    {
+        --freeOrder;
+        pushFree(offset + (1u << freeOrder), freeOrder);
+    }
+
+    _blockState[offset] = static_cast<u8>(order);
+    _persistentFree -= 1u << order;
+    return DescriptorRange(offset, count);
+}
+
+void DescriptorTableAllocator::free(const DescriptorRange& range) noexcept
+{
+    if(!range.count || range.offset >= _persistentCount)
+    { return; }
+
+    // Anything still pending is at most one per live table, so this only fills up on repeated frees.
+    if(_pendingCount == _pendingFrees.count())
+    { return; }
+
+    PendingFree& pending = _pendingFrees[(_pendingHead + _pendingCount) % _pendingFrees.count()];
+    pending.fence = _frameFence;
+    pending.offset = range.offset;
+    pending.count = range.count;
+    ++_pendingCount;
+}
+
+DescriptorRange DescriptorTableAllocator::allocateTransient(const u32 count) noexcept
+{
+    if(!count || count > _transientCount)
+    { return DescriptorRange(); }
+
+    u32 offset = _transientHead;
+    u32 skipped = 0;
+
+    // Tables have to be contiguous, skip whatever is left at the end of the ring.
+    if(offset + count > _transientCount)
+    {
+        skipped = _transientCount - offset;
+        offset = 0;
+    }
+
+    if(_transientUsed + skipped + count > _transientCount)
+    { return DescriptorRange(); }
+
+    _transientHead = offset + count;
+    if(_transientHead == _transientCount)
+    { _transientHead = 0; }
+
+    _transientUsed += skipped + count;
+    _transientFrameUsed += skipped + count;
+    return DescriptorRange(_persistentCount + offset, count);
+}
+
+bool DescriptorTableAllocator::beginFrame(const u64 frameFence, const u64 completedFence) noexcept
+{
+    retire(completedFence);
+
+    if(_frameCount == _frames.count())
+    { return false; }
+
+    FrameMarker& marker = _frames[(_frameHead + _frameCount) % _frames.count()];
+    marker.fence = _frameFence;
+    marker.used = _transientFrameUsed;
+    ++_frameCount;
+
+    _frameFence = frameFence;
+    _transientFrameUsed = 0;
+
+    // The frame that just ended may have completed already.
+    retire(completedFence);
+    return true;
+}
+
+void DescriptorTableAllocator::retire(const u64 completedFence) noexcept
+{
+    while(_frameCount && _frames[_frameHead].fence <= completedFence)
+    {
+        _transientUsed -= _frames[_frameHead].used;
+        _frameHead = (_frameHead + 1) % _frames.count();
+        --_frameCount;
+    }
+
+    while(_pendingCount && _pendingFrees[_pendingHead].fence <= completedFence)
+    {
+        const PendingFree& pending = _pendingFrees[_pendingHead];
+        freeBlock(pending.offset, blockOrder(pending.count));
+        _pendingHead = (_pendingHead + 1) % _pendingFrees.count();
+        --_pendingCount;
+    }
+}
+
+void DescriptorTableAllocator::freeBlock(u32 offset, u32 order) noexcept
+{
+    // Only the start of an allocated block of the same size can be freed, this catches double frees.
+    if(_blockState[offset] != order)
+    { return; }
+
+    _persistentFree += 1u << order;
+
+    while(order + 1 < MaxOrder)
+    {
+        const u32 buddy = offset ^ (1u << order);
+        if(buddy >= _persistentCount || _blockState[buddy] != (FreeBit | order))
+        { break; }
+
+        // The upper half is absorbed, it must not look like the start of a block anymore.
+        removeFree(buddy, order);
+        _blockState[offset < buddy ? buddy : offset] = Interior;
+        offset = offset < buddy ? offset : buddy;
+        ++order;
+    }
+
+    pushFree(offset, order);
+}
+
+void DescriptorTableAllocator::pushFree(const u32 offset, const u32 order) noexcept
+{
+    const u32 head = _freeHeads[order];
+
+    _blockState[offset] = static_cast<u8>(FreeBit | order);
+    _freeNext[offset] = head;
+    _freePrev[offset] = InvalidIndex;
+
+    if(head != InvalidIndex)
+    { _freePrev[head] = offset; }
+
+    _freeHeads[order] = offset;
+    _freeOrders |= 1u << order;
+}
+
+void DescriptorTableAllocator::removeFree(const u32 offset, const u32 order) noexcept
+{
+    const u32 next = _freeNext[offset];
+    const u32 prev = _freePrev[offset];
+
+    if(prev != InvalidIndex)
+    { _freeNext[prev] = next; }
+    else
+    { _freeHeads[order] = next; }
+
+    if(next != InvalidIndex)
+    { _freePrev[next] = prev; }
+
+    if(_freeHeads[order] == InvalidIndex)
+    { _freeOrders &= ~(1u << order); }
+
+    // Either absorbed into a larger block or about to be allocated, which sets its state again.
+    _blockState[offset] = Interior;
+}
@@ -0,0 +1,178 @@
+#include "LZ.hpp"
+
+#pragma warning(push, 0)
+#include <cstring>
+#pragma warning(pop)
+
+static inline u32 read32(const u8* const ptr) noexcept
+{
+    u32 ret;
+    ::std::memcpy(&ret, ptr, sizeof(ret));
+    return ret;
+}
+
+static inline u32 hash32(const u32 sequence) noexcept
+{ return (sequence * 2654435761u) >> (32 - LZ::HashLog); }
+
+static inline u8* writeLength(u8* dst, uSys length) noexcept
+{
+    while(length >= 255)
+    {
+        *dst++ = 255;
+        length -= 255;
+    }
+    *dst++ = static_cast<u8>(length);
+    return dst;
+}
+
+static inline u8* writeLiterals(u8* dst, const u8* const literals, const uSys literalLength, const uSys matchToken) noexcept
+{
+    u8* const token = dst++;
+
+    if(literalLength >= 15)
+    {
+        *token = static_cast<u8>((15 << 4) | matchToken);
+        dst = writeLength(dst, literalLength - 15);
+    }
+    else
+    {
+        *token = static_cast<u8>((literalLength << 4) | matchToken);
+    }
+
+    ::std::memcpy(dst, literals, literalLength);
+    return dst + literalLength;
+}
+
+uSys LZ::compress(const u8* const src, const uSys length, u8* const dst, const uSys capacity) noexcept
+{
+    if(capacity < compressBound(length))
+    { return 0; }
+
+    /**
+     *   Positions are stored offset by one so that a zeroed
+     * table means no entry.
+     */
+    u32 table[1 << HashLog];
+    ::std::memset(table, 0, sizeof(table));
+
+    uSys anchor = 0;
+    uSys ip = 0;
+    u8* op = dst;
+
+    while(ip + MatchFindLimit <= length)
+    {
+        const u32 sequence = read32(src + ip);
+        const u32 hash = hash32(sequence);
+        const uSys ref = table[hash];
+        table[hash] = static_cast<u32>(ip + 1);
+
+        if(!ref || ip - (ref - 1) > MaxOffset || read32(src + ref - 1) != sequence)
+        {
+            ++ip;
+            continue;
+        }
+
+        const uSys matchPos = ref - 1;
+        const uSys maxLength = length - LastLiterals - ip;
+        uSys matchLength = MinMatch;
+        while(matchLength < maxLength && src[ip + matchLength] == src[matchPos + matchLength])
+        { ++matchLength; }
+
+        const uSys extraMatch = matchLength - MinMatch;
+        op = writeLiterals(op, src + anchor, ip - anchor, extraMatch >= 15 ? 15 : extraMatch);
+
+        const uSys offset = ip - matchPos;
+        *op++ = static_cast<u8>(offset);
+        *op++ = static_cast<u8>(offset >> 8);
+
+        if(extraMatch >= 15)
+        { op = writeLength(op, extraMatch - 15); }
+
+        ip += matchLength;
+        anchor = ip;
+    }
+
+    op = writeLiterals(op, src + anchor, length - anchor, 0);
+
+    return static_cast<uSys>(op - dst);
+}
+
+uSys LZ::decompress(const u8* const src, const uSys length, u8* const dst, const uSys capacity) noexcept
+{
+    const u8* ip = src;
+    const u8* const end = src + length;
+    uSys op = 0;
+
+    while(ip < end)
+    {
+        const u8 token = *ip++;
+
+        uSys literalLength = token >> 4;
+        if(literalLength == 15)
+        {
+            u8 b;
+            do
+            {
+                if(ip >= end)
+                { return 0; }
+                b = *ip++;
+                literalLength += b;
+            } while(b == 255);
+        }
+
+        if(literalLength > static_cast<uSys>(end - ip) || literalLength > capacity - op)
+        { return 0; }
+
+        ::std::memcpy(dst + op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        if(ip >= end)
+        { break; }
+
+        if(end - ip < 2)
+        { return 0; }
+
+        const uSys offset = static_cast<uSys>(ip[0]) | (static_cast<uSys>(ip[1]) << 8);
+        ip += 2;
+
+        if(offset == 0 || offset > op)
+        { return 0; }
+
+        uSys matchLength = token & 0x0F;
+        if(matchLength == 15)
+        {
+            u8 b;
+            do
+            {
+                if(ip >= end)
+                { return 0; }
+                b = *ip++;
+                matchLength += b;
+            } while(b == 255);
+        }
+        matchLength += MinMatch;
+
+        if(matchLength > capacity - op)
+        { return 0; }
+
+        /**
+         *   The match may overlap the output, such as a run of a
+         * single byte, so this has to be copied forward one byte
+         * at a time unless the regions are disjoint.
+         */
+        const u8* match = dst + op - offset;
+        if(offset >= matchLength)
+        {
+            ::std::memcpy(dst + op, match, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            for(uSys i = 0; i < matchLength; ++i)
+            { dst[op++] = match[i]; }
+        }
+    }
+
+    return op;
+}
@@ -0,0 +1,105 @@
+#include "allocator/LinearAllocator.hpp"
+
+#pragma warning(push, 0)
+#include <new>
+#pragma warning(pop)
+
+LinearArenaAllocator::LinearArenaAllocator(const PageCountVal numReservedPages, const uSys allocPages) noexcept
+    : _allocPages(allocPages ? allocPages : 1)
+    , _numReservedPages(static_cast<uSys>(numReservedPages))
+    , _pages(reinterpret_cast<u8*>(PageAllocator::reserve(_numReservedPages)))
+    , _committedBytes(0)
+    , _allocIndex(0)
+    , _highWater(0)
+{ }
+
+LinearArenaAllocator::~LinearArenaAllocator() noexcept
+{
+    if(_pages)
+    { PageAllocator::free(_pages); }
+}
+
+void LinearArenaAllocator::rewind(const Marker marker) noexcept
+{
+    if(marker < _allocIndex)
+    { _allocIndex = marker; }
+}
+
+void LinearArenaAllocator::trim(const uSys keepPages) noexcept
+{
+    const uSys pageSize = PageAllocator::pageSize();
+
+    uSys usedPages = (_allocIndex + pageSize - 1) / pageSize;
+    if(usedPages < keepPages)
+    { usedPages = keepPages; }
+
+    const uSys committedPages = _committedBytes / pageSize;
+    if(usedPages >= committedPages)
+    { return; }
+
+    PageAllocator::decommitPages(_pages + usedPages * pageSize, committedPages - usedPages);
+    _committedBytes = usedPages * pageSize;
+}
+
+bool LinearArenaAllocator::commit(const uSys start, const uSys size) noexcept
+{
+    if(!_pages)
+    { return false; }
+
+    const uSys pageSize = PageAllocator::pageSize();
+    const uSys committedPages = _committedBytes / pageSize;
+    const uSys reservedBytes = _numReservedPages * pageSize;
+
+    if(start > reservedBytes || size > reservedBytes - start)
+    { return false; }
+
+    uSys requiredPages = (start + size + pageSize - 1) / pageSize;
+
+    // Commit in whole chunks to amortize the system calls, without running past the reservation.
+    requiredPages = ((requiredPages + _allocPages - 1) / _allocPages) * _allocPages;
+    if(requiredPages > _numReservedPages)
+    { requiredPages = _numReservedPages; }
+
+    if(!PageAllocator::commitPages(_pages + _committedBytes, requiredPages - committedPages))
+    { return false; }
+
+    _committedBytes = requiredPages * pageSize;
+    return true;
+}
+
+ScratchAllocator& ScratchAllocator::threadLocal() noexcept
+{
+    static thread_local ScratchAllocator allocator;
+    return allocator;
+}
+
+FrameArenaAllocator::FrameArenaAllocator(const uSys frameCount, const PageCountVal numReservedPagesPerFrame, const uSys allocPages) noexcept
+    : _arenas(reinterpret_cast<LinearArenaAllocator*>(operator new(sizeof(LinearArenaAllocator) * (frameCount ? frameCount : 1), ::std::nothrow)))
+    , _frameCount(_arenas ? (frameCount ? frameCount : 1) : 0)
+    , _frameIndex(0)
+{
+    for(uSys i = 0; i < _frameCount; ++i)
+    { (void) new(_arenas + i) LinearArenaAllocator(numReservedPagesPerFrame, allocPages); }
+}
+
+FrameArenaAllocator::~FrameArenaAllocator() noexcept
+{
+    for(uSys i = 0; i < _frameCount; ++i)
+    { _arenas[i].~LinearArenaAllocator(); }
+    operator delete(_arenas, ::std::nothrow);
+}
+
+FrameArenaAllocator& FrameArenaAllocator::threadLocal() noexcept
+{
+    static thread_local FrameArenaAllocator allocator;
+    return allocator;
+}
+
+void FrameArenaAllocator::nextFrame() noexcept
+{
+    if(!_frameCount)
+    { return; }
+
+    _frameIndex = (_frameIndex + 1) % _frameCount;
+    _arenas[_frameIndex].reset();
+}
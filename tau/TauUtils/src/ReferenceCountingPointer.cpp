@@ -0,0 +1,196 @@
+#include "ReferenceCountingPointer.hpp"
+
+namespace _ReferenceCountingPointerUtils {
+
+namespace {
+
+/**
+ *   Owns the queue of a thread. Anything left in the queue is
+ * processed when the thread exits, the queue itself is left
+ * allocated as other threads may still hold a pointer to it.
+ */
+struct LocalQueue final
+{
+    DELETE_CM(LocalQueue);
+public:
+    _BiasedRefCountQueue* queue;
+public:
+    LocalQueue() noexcept
+        : queue(new _BiasedRefCountQueue)
+    { }
+
+    ~LocalQueue() noexcept
+    {
+        // Destroying an object may release more of this thread's objects.
+        while(queue->process()) { }
+    }
+};
+
+/**
+ * The flags are masked off first so that negative counts round correctly.
+ */
+[[nodiscard]] inline i64 sharedCount(const i64 shared) noexcept
+{ return (shared & ~(_BiasedRefCount::One - 1)) / _BiasedRefCount::One; }
+
+}
+
+/**
+ *   Checked on every count, a trivially initialized thread local
+ * avoids the initialization guard that LocalQueue needs.
+ */
+static thread_local _BiasedRefCountQueue* localQueue = nullptr;
+
+static _BiasedRefCountQueue* createLocalQueue() noexcept
+{
+    static thread_local LocalQueue queue;
+    return queue.queue;
+}
+
+_BiasedRefCountQueue* _BiasedRefCountQueue::local() noexcept
+{
+    if(!localQueue)
+    { localQueue = createLocalQueue(); }
+    return localQueue;
+}
+
+void _BiasedRefCountQueue::push(_BiasedRefCount* const refCount) noexcept
+{
+    _BiasedRefCount* head = _head;
+    while(true)
+    {
+        refCount->_next = head;
+        _BiasedRefCount* const prev = atomicCompareExchangePointer(&_head, refCount, head);
+        if(prev == head)
+        { return; }
+        head = prev;
+    }
+}
+
+uSys _BiasedRefCountQueue::process() noexcept
+{
+    _BiasedRefCount* refCount = atomicExchangePointer<_BiasedRefCount>(&_head, nullptr);
+
+    uSys count = 0;
+    while(refCount)
+    {
+        // The object may be destroyed or queued again.
+        _BiasedRefCount* const next = refCount->_next;
+        refCount->processQueued();
+        refCount = next;
+        ++count;
+    }
+    return count;
+}
+
+_BiasedRefCount::_BiasedRefCount(const Destroy destroy, const bool deferred) noexcept
+    : _biased(1)
+    , _shared(deferred ? Deferred : 0)
+    , _owner(_BiasedRefCountQueue::local())
+    , _next(nullptr)
+    , _destroy(destroy)
+{ }
+
+uSys _BiasedRefCount::count() const noexcept
+{
+    const i64 count = static_cast<i64>(_biased) + sharedCount(_shared);
+    return count > 0 ? static_cast<uSys>(count) : 0;
+}
+
+uSys _BiasedRefCount::addRef() noexcept
+{
+    if(_owner == _BiasedRefCountQueue::local() && _biased)
+    { return ++_biased; }
+
+    return static_cast<uSys>(sharedCount(atomicAdd<i64>(&_shared, One)) + 1);
+}
+
+uSys _BiasedRefCount::release() noexcept
+{
+    const bool owner = _owner == _BiasedRefCountQueue::local();
+
+    if(owner && _biased)
+    {
+        if(--_biased)
+        { return _biased; }
+
+        // The owner has released everything it held, from now on only the shared count is used.
+        const i64 shared = atomicAdd<i64>(&_shared, Merged) + Merged;
+        return sharedCount(shared) < 1 && !(shared & Queued) ? 0 : 1;
+    }
+
+    i64 shared = _shared;
+
+    if((shared & Merged) && !(shared & Deferred))
+    {
+        // Neither flag is ever cleared, nothing can need queuing.
+        const i64 newShared = atomicAdd<i64>(&_shared, -One) - One;
+        if(!(newShared & Queued) && sharedCount(newShared) < 1)
+        { return 0; }
+        return sharedCount(newShared) > 0 ? static_cast<uSys>(sharedCount(newShared)) : 1;
+    }
+
+    while(true)
+    {
+        i64 newShared = shared - One;
+        bool push = false;
+
+        if(!(shared & Queued))
+        {
+            if(!(shared & Merged))
+            {
+                // The owner holds references that are owed to other threads, it needs to be told to merge.
+                push = sharedCount(newShared) < 0;
+            }
+            else if(!owner && (shared & Deferred))
+            {
+                push = sharedCount(newShared) < 1;
+            }
+        }
+
+        if(push)
+        { newShared |= Queued; }
+
+        const i64 prev = atomicCompareExchange<i64>(&_shared, newShared, shared);
+        if(prev != shared)
+        {
+            shared = prev;
+            continue;
+        }
+
+        if(push)
+        {
+            _owner->push(this);
+            return 1;
+        }
+
+        if((newShared & Merged) && !(newShared & Queued) && sharedCount(newShared) < 1)
+        { return 0; }
+
+        return sharedCount(newShared) > 0 ? static_cast<uSys>(sharedCount(newShared)) : 1;
+    }
+}
+
+void _BiasedRefCount::processQueued() noexcept
+{
+    i64 add = -Queued;
+    if(_biased)
+    {
+        add += static_cast<i64>(_biased) * One + Merged;
+        _biased = 0;
+    }
+
+    const i64 shared = atomicAdd<i64>(&_shared, add) + add;
+    if(sharedCount(shared) < 1)
+    { _destroy(this); }
+}
+
+}
+
+uSys rcpProcessPendingReleases() noexcept
+{
+#if TAU_DEFAULT_ATOMIC == TAU_RCP_BIASED
+    return _ReferenceCountingPointerUtils::_BiasedRefCountQueue::local()->process();
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,527 @@
+#include "allocator/TLSFAllocator.hpp"
+#include "TUMaths.hpp"
+#include <cstring>
+#include <new>
+#include <utility>
+
+/**
+ *   Finds the bin a block of `size` belongs in. Sizes below
+ * SLCount all share the first level linearly.
+ */
+static inline void mapping(const u64 size, u32* const fl, u32* const sl) noexcept
+{
+    if(size < TLSFAllocator::SLCount)
+    {
+        *fl = 0;
+        *sl = static_cast<u32>(size);
+        return;
+    }
+
+    const u32 log2 = 63 - static_cast<u32>(_clz(size));
+    *fl = log2 - TLSFAllocator::SLLog2 + 1;
+    *sl = static_cast<u32>(size >> (log2 - TLSFAllocator::SLLog2)) - TLSFAllocator::SLCount;
+}
+
+/**
+ *   Rounds `size` up to the start of the next bin so that every
+ * block in the bin it maps to is large enough.
+ */
+[[nodiscard]] static inline u64 roundUpToBin(const u64 size) noexcept
+{
+    if(size < TLSFAllocator::SLCount)
+    { return size; }
+
+    const u32 log2 = 63 - static_cast<u32>(_clz(size));
+    const u64 round = (1ull << (log2 - TLSFAllocator::SLLog2)) - 1;
+    return size + round;
+}
+
+TLSFAllocator::TLSFAllocator(const u64 size, const u32 initialNodes) noexcept
+    : _size(size)
+    , _used(0)
+    , _allocationCount(0)
+    , _freeBlockCount(0)
+    , _nodes(initialNodes ? initialNodes : 1)
+    , _nodeCount(0)
+    , _unusedNodes(InvalidNode)
+    , _firstPhys(InvalidNode)
+    , _flBitmap(0)
+    , _slBitmaps { }
+    , _heads { }
+{
+    ::std::memset(_heads, 0xFF, sizeof(_heads));
+
+    if(!size)
+    { return; }
+
+    const u32 node = createNode();
+    _nodes[node].offset = 0;
+    _nodes[node].size = size;
+    _nodes[node].prevPhys = InvalidNode;
+    _nodes[node].nextPhys = InvalidNode;
+    _firstPhys = node;
+    insertFree(node);
+}
+
+TLSFAllocator::Allocation TLSFAllocator::allocate(const u64 size, const u64 alignment, void* const userData) noexcept
+{
+    if(!size || size > _size || !alignment || (alignment & (alignment - 1)))
+    { return { 0, 0, InvalidNode }; }
+
+    // Any block this large can fit the allocation no matter where it starts.
+    const u64 searchSize = size + (alignment - 1);
+    if(searchSize > _size)
+    { return { 0, 0, InvalidNode }; }
+
+    const u32 node = findFree(searchSize);
+    if(node == InvalidNode)
+    { return { 0, 0, InvalidNode }; }
+
+    removeFree(node);
+
+    const u64 offset = _nodes[node].offset;
+    const u64 alignedOffset = (offset + (alignment - 1)) & ~(alignment - 1);
+
+    // The neighbours of a free block are never free, so the split off blocks can't be merged with anything.
+    if(alignedOffset != offset)
+    {
+        const u32 padding = createNode();
+        Node& block = _nodes[node];
+        _nodes[padding].offset = offset;
+        _nodes[padding].size = alignedOffset - offset;
+        _nodes[padding].prevPhys = block.prevPhys;
+        _nodes[padding].nextPhys = node;
+
+        if(block.prevPhys != InvalidNode)
+        { _nodes[block.prevPhys].nextPhys = padding; }
+        else
+        { _firstPhys = padding; }
+
+        block.prevPhys = padding;
+        block.offset = alignedOffset;
+        block.size -= alignedOffset - offset;
+        insertFree(padding);
+    }
+
+    if(_nodes[node].size != size)
+    {
+        const u32 remainder = createNode();
+        Node& block = _nodes[node];
+        _nodes[remainder].offset = block.offset + size;
+        _nodes[remainder].size = block.size - size;
+        _nodes[remainder].prevPhys = node;
+        _nodes[remainder].nextPhys = block.nextPhys;
+
+        if(block.nextPhys != InvalidNode)
+        { _nodes[block.nextPhys].prevPhys = remainder; }
+
+        block.nextPhys = remainder;
+        block.size = size;
+        insertFree(remainder);
+    }
+
+    Node& block = _nodes[node];
+    block.userData = userData;
+    block.alignmentLog2 = static_cast<u8>(_ctz(alignment));
+
+    _used += size;
+    ++_allocationCount;
+
+    return { block.offset, size, node };
+}
+
+void TLSFAllocator::free(u32 node) noexcept
+{
+    if(node >= _nodeCount || _nodes[node].isFree)
+    { return; }
+
+    _used -= _nodes[node].size;
+    --_allocationCount;
+
+    const u32 prev = _nodes[node].prevPhys;
+    if(prev != InvalidNode && _nodes[prev].isFree)
+    {
+        removeFree(prev);
+        _nodes[prev].size += _nodes[node].size;
+        _nodes[prev].nextPhys = _nodes[node].nextPhys;
+        if(_nodes[node].nextPhys != InvalidNode)
+        { _nodes[_nodes[node].nextPhys].prevPhys = prev; }
+
+        releaseNode(node);
+        node = prev;
+    }
+
+    const u32 next = _nodes[node].nextPhys;
+    if(next != InvalidNode && _nodes[next].isFree)
+    {
+        removeFree(next);
+        _nodes[node].size += _nodes[next].size;
+        _nodes[node].nextPhys = _nodes[next].nextPhys;
+        if(_nodes[next].nextPhys != InvalidNode)
+        { _nodes[_nodes[next].nextPhys].prevPhys = node; }
+
+        releaseNode(next);
+    }
+
+    insertFree(node);
+}
+
+TLSFAllocator::Stats TLSFAllocator::stats() const noexcept
+{
+    u64 largestFree = 0;
+
+    // Every block in the highest bin is at least as large as any block in a lower bin.
+    if(_flBitmap)
+    {
+        const u32 fl = 63 - static_cast<u32>(_clz(_flBitmap));
+        const u32 sl = 31 - _clz(_slBitmaps[fl]);
+        for(u32 node = _heads[fl][sl]; node != InvalidNode; node = _nodes[node].nextFree)
+        {
+            if(_nodes[node].size > largestFree)
+            { largestFree = _nodes[node].size; }
+        }
+    }
+
+    return { _size, _used, largestFree, _allocationCount, _freeBlockCount };
+}
+
+u32 TLSFAllocator::createNode() noexcept
+{
+    if(_unusedNodes != InvalidNode)
+    {
+        const u32 node = _unusedNodes;
+        _unusedNodes = _nodes[node].nextFree;
+        _nodes[node].isFree = 0;
+        return node;
+    }
+
+    if(_nodeCount == _nodes.count())
+    {
+        DynArray<Node> nodes(_nodes.count() * 2);
+        ::std::memcpy(nodes.arr(), _nodes.arr(), _nodeCount * sizeof(Node));
+        _nodes = ::std::move(nodes);
+    }
+
+    _nodes[_nodeCount].isFree = 0;
+    return _nodeCount++;
+}
+
+void TLSFAllocator::releaseNode(const u32 node) noexcept
+{
+    // Marking the node free catches freeing it again.
+    _nodes[node].isFree = 1;
+    _nodes[node].nextFree = _unusedNodes;
+    _unusedNodes = node;
+}
+
+void TLSFAllocator::insertFree(const u32 node) noexcept
+{
+    u32 fl;
+    u32 sl;
+    mapping(_nodes[node].size, &fl, &sl);
+
+    const u32 head = _heads[fl][sl];
+
+    Node& block = _nodes[node];
+    block.isFree = 1;
+    block.userData = nullptr;
+    block.alignmentLog2 = 0;
+    block.prevFree = InvalidNode;
+    block.nextFree = head;
+
+    if(head != InvalidNode)
+    { _nodes[head].prevFree = node; }
+
+    _heads[fl][sl] = node;
+    _slBitmaps[fl] |= 1u << sl;
+    _flBitmap |= 1ull << fl;
+    ++_freeBlockCount;
+}
+
+void TLSFAllocator::removeFree(const u32 node) noexcept
+{
+    u32 fl;
+    u32 sl;
+    mapping(_nodes[node].size, &fl, &sl);
+
+    Node& block = _nodes[node];
+
+    if(block.prevFree != InvalidNode)
+    { _nodes[block.prevFree].nextFree = block.nextFree; }
+    else
+    { _heads[fl][sl] = block.nextFree; }
+
+    if(block.nextFree != InvalidNode)
+    { _nodes[block.nextFree].prevFree = block.prevFree; }
+
+    if(_heads[fl][sl] == InvalidNode)
+    {
+        _slBitmaps[fl] &= ~(1u << sl);
+        if(!_slBitmaps[fl])
+        { _flBitmap &= ~(1ull << fl); }
+    }
+
+    block.isFree = 0;
+    --_freeBlockCount;
+}
+
+u32 TLSFAllocator::findFree(const u64 size) const noexcept
+{
+    u32 fl;
+    u32 sl;
+    mapping(roundUpToBin(size), &fl, &sl);
+
+    u32 slMap = _slBitmaps[fl] & (~0u << sl);
+    if(!slMap)
+    {
+        const u64 flMap = _flBitmap & (~0ull << (fl + 1));
+        if(!flMap)
+        { return findFreeExact(size); }
+
+        fl = static_cast<u32>(_ctz(flMap));
+        slMap = _slBitmaps[fl];
+    }
+
+    return _heads[fl][_ctz(slMap)];
+}
+
+u32 TLSFAllocator::findFreeExact(const u64 size) const noexcept
+{
+    u32 fl;
+    u32 sl;
+    mapping(size, &fl, &sl);
+
+    // Only reached when nothing larger is free, so this list holds the largest blocks left.
+    for(u32 node = _heads[fl][sl]; node != InvalidNode; node = _nodes[node].nextFree)
+    {
+        if(_nodes[node].size >= size)
+        { return node; }
+    }
+
+    return InvalidNode;
+}
+
+TLSFBlockAllocator::TLSFBlockAllocator(const u64 blockSize, const u32 maxBlocks) noexcept
+    : _blockSize(blockSize)
+    , _blocks(maxBlocks)
+    , _blockCount(0)
+    , _spareBlock(InvalidBlock)
+{
+    for(uSys i = 0; i < _blocks.count(); ++i)
+    {
+        _blocks[i].allocator = nullptr;
+        _blocks[i].handle = nullptr;
+        _blocks[i].dedicated = false;
+    }
+}
+
+void TLSFBlockAllocator::release() noexcept
+{
+    for(uSys i = 0; i < _blocks.count(); ++i)
+    {
+        if(_blocks[i].allocator)
+        { destroyBlockSlot(static_cast<u32>(i)); }
+    }
+
+    _spareBlock = InvalidBlock;
+}
+
+TLSFBlockAllocator::Allocation TLSFBlockAllocator::allocate(const u64 size, const u64 alignment, void* const userData) noexcept
+{
+    if(!size)
+    { return Allocation(); }
+
+    if(size > _blockSize / 2)
+    {
+        const u32 block = createBlockSlot(size, true);
+        if(block == InvalidBlock)
+        { return Allocation(); }
+
+        const TLSFAllocator::Allocation allocation = _blocks[block].allocator->allocate(size, 1, userData);
+        return Allocation(_blocks[block].handle, allocation.offset, allocation.size, block, allocation.node);
+    }
+
+    Allocation allocation = allocateExcluding(size, alignment, userData, InvalidBlock);
+    if(allocation)
+    { return allocation; }
+
+    const u32 block = createBlockSlot(_blockSize, false);
+    if(block == InvalidBlock)
+    { return Allocation(); }
+
+    const TLSFAllocator::Allocation blockAllocation = _blocks[block].allocator->allocate(size, alignment, userData);
+    if(!blockAllocation.valid())
+    {
+        // Only an alignment larger than the block can fail here.
+        destroyBlockSlot(block);
+        return Allocation();
+    }
+
+    return Allocation(_blocks[block].handle, blockAllocation.offset, blockAllocation.size, block, blockAllocation.node);
+}
+
+void TLSFBlockAllocator::free(const Allocation& allocation) noexcept
+{
+    if(allocation.block >= _blocks.count() || !_blocks[allocation.block].allocator)
+    { return; }
+
+    Block& block = _blocks[allocation.block];
+    block.allocator->free(allocation.node);
+
+    if(!block.allocator->empty())
+    { return; }
+
+    if(block.dedicated || _spareBlock != InvalidBlock)
+    { destroyBlockSlot(allocation.block); }
+    else
+    { _spareBlock = allocation.block; }
+}
+
+u64 TLSFBlockAllocator::defragment(const u64 maxBytes) noexcept
+{
+    u32 victim = InvalidBlock;
+    u64 victimUsed = 0;
+    u32 regularBlocks = 0;
+
+    for(uSys i = 0; i < _blocks.count(); ++i)
+    {
+        const Block& block = _blocks[i];
+        if(!block.allocator || block.dedicated)
+        { continue; }
+
+        ++regularBlocks;
+
+        const u64 used = block.allocator->used();
+        if(used && (victim == InvalidBlock || used < victimUsed))
+        {
+            victim = static_cast<u32>(i);
+            victimUsed = used;
+        }
+    }
+
+    if(victim == InvalidBlock || regularBlocks < 2)
+    { return 0; }
+
+    TLSFAllocator& allocator = *_blocks[victim].allocator;
+    void* const handle = _blocks[victim].handle;
+
+    u64 moved = 0;
+
+    u32 node = allocator.firstNode();
+    while(node != TLSFAllocator::InvalidNode && allocator.isFree(node))
+    { node = allocator.nextNode(node); }
+
+    while(node != TLSFAllocator::InvalidNode && moved < maxBytes)
+    {
+        // Freeing can merge the free blocks around this node, but never another allocated node.
+        u32 next = allocator.nextNode(node);
+        while(next != TLSFAllocator::InvalidNode && allocator.isFree(next))
+        { next = allocator.nextNode(next); }
+
+        const u64 size = allocator.size(node);
+        void* const userData = allocator.userData(node);
+
+        const Allocation to = allocateExcluding(size, allocator.alignment(node), userData, victim);
+        if(!to)
+        { break; }
+
+        const Allocation from(handle, allocator.offset(node), size, victim, node);
+        moveAllocation(from, to, userData);
+        allocator.free(node);
+
+        moved += size;
+        node = next;
+    }
+
+    if(allocator.empty())
+    { destroyBlockSlot(victim); }
+
+    return moved;
+}
+
+TLSFBlockAllocator::Stats TLSFBlockAllocator::stats() const noexcept
+{
+    Stats stats { };
+
+    for(uSys i = 0; i < _blocks.count(); ++i)
+    {
+        if(!_blocks[i].allocator)
+        { continue; }
+
+        const TLSFAllocator::Stats blockStats = _blocks[i].allocator->stats();
+        stats.reserved += blockStats.size;
+        stats.used += blockStats.used;
+        if(blockStats.largestFree > stats.largestFree)
+        { stats.largestFree = blockStats.largestFree; }
+        ++stats.blockCount;
+        stats.allocationCount += blockStats.allocationCount;
+        stats.freeBlockCount += blockStats.freeBlockCount;
+    }
+
+    return stats;
+}
+
+u32 TLSFBlockAllocator::createBlockSlot(const u64 size, const bool dedicated) noexcept
+{
+    for(uSys i = 0; i < _blocks.count(); ++i)
+    {
+        Block& block = _blocks[i];
+        if(block.allocator)
+        { continue; }
+
+        if(!createBlock(size, &block.handle))
+        { return InvalidBlock; }
+
+        block.allocator = new(::std::nothrow) TLSFAllocator(size);
+        if(!block.allocator)
+        {
+            destroyBlock(block.handle);
+            block.handle = nullptr;
+            return InvalidBlock;
+        }
+
+        block.dedicated = dedicated;
+        ++_blockCount;
+        return static_cast<u32>(i);
+    }
+
+    return InvalidBlock;
+}
+
+void TLSFBlockAllocator::destroyBlockSlot(const u32 block) noexcept
+{
+    Block& slot = _blocks[block];
+
+    destroyBlock(slot.handle);
+    delete slot.allocator;
+
+    slot.allocator = nullptr;
+    slot.handle = nullptr;
+    slot.dedicated = false;
+    --_blockCount;
+
+    if(_spareBlock == block)
+    { _spareBlock = InvalidBlock; }
+}
+
+TLSFBlockAllocator::Allocation TLSFBlockAllocator::allocateExcluding(const u64 size, const u64 alignment, void* const userData, const u32 excludedBlock) noexcept
+{
+    // First fit by block keeps the lower blocks full, leaving the higher ones to be emptied by defragmenting.
+    for(uSys i = 0; i < _blocks.count(); ++i)
+    {
+        const Block& block = _blocks[i];
+        if(!block.allocator || block.dedicated || i == excludedBlock)
+        { continue; }
+
+        const TLSFAllocator::Allocation allocation = block.allocator->allocate(size, alignment, userData);
+        if(!allocation.valid())
+        { continue; }
+
+        if(_spareBlock == i)
+        { _spareBlock = InvalidBlock; }
+
+        return Allocation(block.handle, allocation.offset, allocation.size, static_cast<u32>(i), allocation.node);
+    }
+
+    return Allocation();
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace AllocationTrackerTest {
+void runTests();
+}
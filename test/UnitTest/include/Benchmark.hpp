@@ -0,0 +1,243 @@
+#pragma once
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#endif
+
+/**
+ *   Settings for a benchmark run, filled in from the command
+ * line by Benchmarks::parseArgs. UnitTest runs the benchmarks
+ * instead of the tests when it is passed --benchmark.
+ *
+ *   --benchmark-filter=<text>     Only runs benchmarks whose name contains text.
+ *   --benchmark-samples=<count>   The number of timed samples per benchmark.
+ *   --benchmark-min-time=<ms>     The shortest a sample may take, iterations are doubled until it is reached.
+ *   --benchmark-warmup=<ms>       How long each benchmark is run before it is measured.
+ *   --benchmark-out=<file>        Writes the results as JSON.
+ *   --benchmark-baseline=<file>   Compares the results against a JSON file written by an earlier run.
+ *   --benchmark-threshold=<%>     How much slower than the baseline the median can be before it is a regression.
+ */
+struct BenchmarkOptions final
+{
+    const char* filter = nullptr;
+    const char* outFile = nullptr;
+    const char* baselineFile = nullptr;
+    u32 samples = 15;
+    double minSampleTime = 2.0;
+    double warmupTime = 50.0;
+    double threshold = 5.0;
+};
+
+/**
+ * The measurements of a single sample, totals over every iteration.
+ */
+struct BenchmarkSample final
+{
+    double nanoseconds;
+    u64 timestamp;
+    /**
+     * Hardware counters, ~0 if they aren't available.
+     */
+    u64 cycles;
+    u64 cacheMisses;
+    u64 branchMisses;
+};
+
+/**
+ *   Passed to each benchmark, the timed part of the benchmark is
+ * a range for over the state. Anything before or after the loop
+ * isn't measured, and the loop must not be broken out of.
+ *
+ *     TAU_BENCHMARK(ArrayList, add)
+ *     {
+ *         ArrayList<u32> list(state.iterations());
+ *         for(const uSys i : state)
+ *         { list.add(static_cast<u32>(i)); }
+ *     }
+ *
+ *   A benchmark that can't run on this machine calls skip and
+ * returns without running the loop. One that has a budget over
+ * another benchmark calls relativeTo before the loop.
+ */
+class BenchmarkState final
+{
+    DEFAULT_DESTRUCT(BenchmarkState);
+    DELETE_CM(BenchmarkState);
+public:
+    class Iterator final
+    {
+        DEFAULT_DESTRUCT(Iterator);
+        DEFAULT_CM_PU(Iterator);
+    private:
+        BenchmarkState* _state;
+        uSys _index;
+    public:
+        Iterator(BenchmarkState* const state, const uSys index) noexcept
+            : _state(state)
+            , _index(index)
+        { }
+
+        [[nodiscard]] uSys operator*() const noexcept { return _index; }
+
+        Iterator& operator++() noexcept
+        {
+            ++_index;
+            return *this;
+        }
+
+        /**
+         * Stops the measurement once the last iteration finishes.
+         */
+        [[nodiscard]] bool operator!=(const Iterator& end) noexcept
+        {
+            if(_index != end._index)
+            { return true; }
+            _state->stop();
+            return false;
+        }
+    };
+private:
+    uSys _iterations;
+    BenchmarkSample _sample;
+    const char* _skipped;
+    const char* _reference;
+    double _target;
+    bool _running;
+public:
+    BenchmarkState(const uSys iterations) noexcept
+        : _iterations(iterations)
+        , _sample { }
+        , _skipped(nullptr)
+        , _reference(nullptr)
+        , _target(0.0)
+        , _running(false)
+    { }
+
+    [[nodiscard]] uSys iterations() const noexcept { return _iterations; }
+    [[nodiscard]] const BenchmarkSample& sample() const noexcept { return _sample; }
+
+    /**
+     * The reason is reported in place of the results, it must outlive the run.
+     */
+    void skip(const char* const reason) noexcept { _skipped = reason; }
+    [[nodiscard]] const char* skipped() const noexcept { return _skipped; }
+
+    /**
+     *   Reports the median as a percentage over the median of
+     * `reference`, a "Suite.case" name that has to run earlier.
+     * Being more than `target` percent slower counts as a
+     * regression.
+     */
+    void relativeTo(const char* const reference, const double target) noexcept
+    {
+        _reference = reference;
+        _target = target;
+    }
+
+    [[nodiscard]] const char* reference() const noexcept { return _reference; }
+    [[nodiscard]] double target() const noexcept { return _target; }
+
+    [[nodiscard]] Iterator begin() noexcept
+    {
+        start();
+        return Iterator(this, 0);
+    }
+
+    [[nodiscard]] Iterator end() noexcept { return Iterator(this, _iterations); }
+private:
+    void start() noexcept;
+    void stop() noexcept;
+};
+
+class IBenchmarkCase
+{
+    DEFAULT_DESTRUCT_VI(IBenchmarkCase);
+    DELETE_CM(IBenchmarkCase);
+protected:
+    const char* _suite;
+    const char* _name;
+    IBenchmarkCase* _next;
+protected:
+    IBenchmarkCase(const char* const suite, const char* const name) noexcept
+        : _suite(suite)
+        , _name(name)
+        , _next(nullptr)
+    { }
+public:
+    [[nodiscard]] const char* suite() const noexcept { return _suite; }
+    [[nodiscard]] const char* name() const noexcept { return _name; }
+
+    virtual void run(BenchmarkState& state) noexcept = 0;
+private:
+    friend class Benchmarks;
+};
+
+class Benchmarks final
+{
+    DELETE_CONSTRUCT(Benchmarks);
+    DELETE_DESTRUCT(Benchmarks);
+    DELETE_CM(Benchmarks);
+public:
+    /**
+     * Called by TAU_BENCHMARK, cases are run grouped by suite in the order they were registered.
+     */
+    static void registerCase(IBenchmarkCase* benchmark) noexcept;
+
+    [[nodiscard]] static BenchmarkOptions parseArgs(int argCount, char* args[]) noexcept;
+
+    /**
+     *   Runs every registered benchmark. Returns the number of
+     * regressions against the baseline and of benchmarks over
+     * their target.
+     */
+    static u32 runAll(const BenchmarkOptions& options) noexcept;
+
+    /**
+     *   Forces `value` to be computed, without the compiler being
+     * able to remove or hoist the work that produced it.
+     */
+    template<typename _T>
+    static inline void doNotOptimize(const _T& value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile u8 sink = *reinterpret_cast<const volatile u8*>(&value);
+        (void) sink;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    /**
+     * Forces any pending writes to memory to happen.
+     */
+    static inline void clobberMemory() noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+};
+
+#define TAU_BENCHMARK(_Suite, _Case)                                 \
+    namespace _Suite##Benchmarks {                                   \
+        class _Case##Benchmark final : public IBenchmarkCase {       \
+            DEFAULT_DESTRUCT_VI(_Case##Benchmark);                   \
+            DELETE_CM(_Case##Benchmark);                             \
+        private:                                                     \
+            static _Case##Benchmark _instance;                       \
+        public:                                                      \
+            _Case##Benchmark() noexcept                              \
+                : IBenchmarkCase(#_Suite, #_Case)                    \
+            { Benchmarks::registerCase(this); }                      \
+                                                                     \
+            void run(BenchmarkState& state) noexcept override;       \
+        };                                                           \
+        _Case##Benchmark _Case##Benchmark::_instance;                \
+    }                                                                \
+    void _Suite##Benchmarks::_Case##Benchmark::run(BenchmarkState& state) noexcept
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace DescriptorTableAllocatorTest {
+void runTests();
+}
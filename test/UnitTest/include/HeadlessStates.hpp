@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Objects.hpp>
+#include <Safeties.hpp>
+#include <RunTimeType.hpp>
+#include <graphics/BlendingState.hpp>
+#include <graphics/DepthStencilState.hpp>
+#include <graphics/RasterizerState.hpp>
+#include <graphics/InputLayout.hpp>
+#include <graphics/PipelineState.hpp>
+
+/**
+ *   States and builders that don't touch a graphics API, so
+ * the StateCache can be checked without a device.
+ */
+template<typename _Base, typename _Args>
+class HeadlessState final : public _Base
+{
+    DEFAULT_DESTRUCT(HeadlessState);
+    DEFAULT_CM_PU(HeadlessState);
+    RTT_IMPL(HeadlessState, _Base);
+public:
+    HeadlessState(const _Args& args) noexcept
+        : _Base(args)
+    { }
+};
+
+class HeadlessInputLayout final : public IInputLayout
+{
+    DEFAULT_CONSTRUCT_PU(HeadlessInputLayout);
+    DEFAULT_DESTRUCT(HeadlessInputLayout);
+    DEFAULT_CM_PU(HeadlessInputLayout);
+    INPUT_LAYOUT_IMPL(HeadlessInputLayout);
+};
+
+template<typename _Builder, typename _Base, typename _Args>
+class HeadlessStateBuilder final : public _Builder
+{
+    DEFAULT_CONSTRUCT_PU(HeadlessStateBuilder);
+    DEFAULT_DESTRUCT(HeadlessStateBuilder);
+    DEFAULT_CM_PU(HeadlessStateBuilder);
+public:
+    using Error = typename _Builder::Error;
+    using State = HeadlessState<_Base, _Args>;
+public:
+    mutable u32 builds = 0;
+
+    [[nodiscard]] _Base* build(const _Args& args, [[tau::out]] Error* error) const noexcept override
+    {
+        ++builds;
+        State* const state = new(::std::nothrow) State(args);
+        ERROR_CODE_COND_N(!state, Error::SystemMemoryAllocationFailure);
+        ERROR_CODE_V(Error::NoError, state);
+    }
+
+    [[nodiscard]] _Base* build(const _Args& args, [[tau::out]] Error* error, TauAllocator& allocator) const noexcept override
+    {
+        ++builds;
+        State* const state = allocator.allocateT<State>(args);
+        ERROR_CODE_COND_N(!state, Error::SystemMemoryAllocationFailure);
+        ERROR_CODE_V(Error::NoError, state);
+    }
+
+    [[nodiscard]] CPPRef<_Base> buildCPPRef(const _Args& args, [[tau::out]] Error* error) const noexcept override
+    {
+        ++builds;
+        const CPPRef<State> state = CPPRef<State>(new(::std::nothrow) State(args));
+        ERROR_CODE_COND_N(!state, Error::SystemMemoryAllocationFailure);
+        ERROR_CODE_V(Error::NoError, state);
+    }
+
+    [[nodiscard]] NullableRef<_Base> buildTauRef(const _Args& args, [[tau::out]] Error* error, TauAllocator& allocator) const noexcept override
+    {
+        ++builds;
+        const NullableRef<State> state(allocator, args);
+        ERROR_CODE_COND_N(!state, Error::SystemMemoryAllocationFailure);
+        ERROR_CODE_V(Error::NoError, state);
+    }
+
+    [[nodiscard]] NullableStrongRef<_Base> buildTauSRef(const _Args& args, [[tau::out]] Error* error, TauAllocator& allocator) const noexcept override
+    {
+        ++builds;
+        const NullableStrongRef<State> state(allocator, args);
+        ERROR_CODE_COND_N(!state, Error::SystemMemoryAllocationFailure);
+        ERROR_CODE_V(Error::NoError, state);
+    }
+};
+
+class HeadlessInputLayoutBuilder final : public IInputLayoutBuilder
+{
+    DEFAULT_CONSTRUCT_PU(HeadlessInputLayoutBuilder);
+    DEFAULT_DESTRUCT(HeadlessInputLayoutBuilder);
+    DEFAULT_CM_PU(HeadlessInputLayoutBuilder);
+public:
+    mutable u32 builds = 0;
+
+    [[nodiscard]] NullableRef<IInputLayout> buildTauRef(const InputLayoutArgs& args, [[tau::out]] Error* error, TauAllocator& allocator) const noexcept override
+    {
+        UNUSED(args);
+        ++builds;
+        const NullableRef<HeadlessInputLayout> inputLayout(allocator);
+        ERROR_CODE_COND_N(!inputLayout, Error::SystemMemoryAllocationFailure);
+        ERROR_CODE_V(Error::NoError, inputLayout);
+    }
+protected:
+    [[nodiscard]] uSys _allocSize() const noexcept override { return sizeof(HeadlessInputLayout); }
+};
+
+class HeadlessPipelineBuilder final : public PipelineStateBuilder
+{
+    DEFAULT_CONSTRUCT_PU(HeadlessPipelineBuilder);
+    DEFAULT_DESTRUCT(HeadlessPipelineBuilder);
+    DEFAULT_CM_PU(HeadlessPipelineBuilder);
+public:
+    mutable u32 builds = 0;
+
+    [[nodiscard]] NullableRef<IPipelineState> build(const PipelineArgs& args, [[tau::out]] Error* error, TauAllocator& allocator) const noexcept override
+    {
+        ++builds;
+        const NullableRef<SimplePipelineState> pipelineState(allocator, args);
+        ERROR_CODE_COND_N(!pipelineState, SystemMemoryAllocationFailure);
+        ERROR_CODE_V(NoError, pipelineState);
+    }
+};
+
+using HeadlessBlendingBuilder = HeadlessStateBuilder<IBlendingStateBuilder, IBlendingState, BlendingArgs>;
+using HeadlessDepthStencilBuilder = HeadlessStateBuilder<IDepthStencilStateBuilder, IDepthStencilState, DepthStencilArgs>;
+using HeadlessRasterizerBuilder = HeadlessStateBuilder<IRasterizerStateBuilder, IRasterizerState, RasterizerArgs>;
+
+static constexpr u32 HeadlessVariants = 4;
+
+/**
+ *   Builds one of four distinct descriptions of each kind.
+ * Copies of the same variant are separate args objects that
+ * differ in fields the cache ignores, so the cache has to
+ * compare them by value.
+ */
+inline BlendingArgs headlessBlendingArgs(const u32 variant, const u32 copy) noexcept
+{
+    BlendingArgs args(tau::Recommended);
+    args.frameBuffers[0].enableBlending = (variant & 1) != 0;
+    args.frameBuffers[0].colorDstFactor = (variant & 2) ? BlendingArgs::BlendFactor::One : BlendingArgs::BlendFactor::InvSrcAlpha;
+    // Ignored without independent blending.
+    args.frameBuffers[1].colorSrcFactor = copy ? BlendingArgs::BlendFactor::DestColor : BlendingArgs::BlendFactor::Zero;
+    return args;
+}
+
+inline DepthStencilArgs headlessDepthStencilArgs(const u32 variant) noexcept
+{
+    DepthStencilArgs args(tau::Recommended);
+    args.depthWriteMask = (variant & 1) ? DepthStencilArgs::DepthWriteMask::Zero : DepthStencilArgs::DepthWriteMask::All;
+    args.depthCompareFunc = (variant & 2) ? DepthStencilArgs::CompareFunc::LessThanOrEqual : DepthStencilArgs::CompareFunc::LessThan;
+    return args;
+}
+
+inline RasterizerArgs headlessRasterizerArgs(const u32 variant) noexcept
+{
+    RasterizerArgs args(tau::Recommended);
+    args.frontFaceCounterClockwise = (variant & 1) != 0;
+    args.cullMode = (variant & 2) ? RasterizerArgs::CullMode::None : RasterizerArgs::CullMode::Back;
+    return args;
+}
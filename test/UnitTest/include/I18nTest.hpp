@@ -0,0 +1,5 @@
+#pragma once
+
+namespace I18nTest {
+void runTests();
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace LinearAllocatorTest {
+void runTests();
+}
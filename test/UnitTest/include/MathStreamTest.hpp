@@ -0,0 +1,5 @@
+#pragma once
+
+namespace MathStreamTest {
+void runTests();
+}
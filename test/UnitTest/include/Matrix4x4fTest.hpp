@@ -11,4 +11,10 @@ void mulScalarTest() noexcept;
 void divScalarTest() noexcept;
 
 void mulVecTest() noexcept;
+
+void transposeTest() noexcept;
+void inverseTest() noexcept;
+void affineInverseTest() noexcept;
+void mulOrderTest() noexcept;
+void dispatchTest() noexcept;
 }
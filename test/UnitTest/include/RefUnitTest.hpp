@@ -26,4 +26,11 @@ void nullableStrongRefResetTest() noexcept;
 
 void strongParentChildTest() noexcept;
 void strongParentChildReverseTest() noexcept;
+
+void biasedRefCountTest() noexcept;
+void biasedDeferredReleaseTest() noexcept;
+
+void biasedRefPtrMergeTest() noexcept;
+void biasedRefPtrHandOffTest() noexcept;
+void biasedRefPtrDeferredReleaseTest() noexcept;
 }
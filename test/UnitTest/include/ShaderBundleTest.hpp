@@ -0,0 +1,5 @@
+#pragma once
+
+namespace ShaderBundleTest {
+void runTests();
+}
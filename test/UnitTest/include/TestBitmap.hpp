@@ -0,0 +1,71 @@
+#pragma once
+
+#include <NumTypes.hpp>
+#include <cstring>
+#include <vector>
+
+/**
+ *   Encodes an uncompressed BMP in memory, so the texture decoders
+ * can be run without any files. Rows are given bottom up, the way
+ * BMP stores them and the way DecodedTexture holds them.
+ *
+ *   24 bit pixels are given as RGB and stored as BGR. 8 bit pixels
+ * are palette indices, `palette` holds 256 RGB colors.
+ */
+[[nodiscard]] inline ::std::vector<u8> encodeBitmap(const u32 width, const u32 height, const u32 bitsPerPixel, const u8* const pixels, const u8* const palette = nullptr) noexcept
+{
+    const auto writeU16 = [](u8* const dst, const u16 value) noexcept { ::std::memcpy(dst, &value, sizeof(value)); };
+    const auto writeU32 = [](u8* const dst, const u32 value) noexcept { ::std::memcpy(dst, &value, sizeof(value)); };
+
+    const u32 bytesPerPixel = bitsPerPixel / 8;
+    const u32 paletteSize = bitsPerPixel == 8 ? 256 * 4 : 0;
+    const u32 headerSize = 14 + 40 + paletteSize;
+    const u32 stride = (width * bytesPerPixel + 3) & ~3u;
+
+    ::std::vector<u8> file(headerSize + stride * height, 0);
+    u8* const header = file.data();
+
+    header[0] = 'B';
+    header[1] = 'M';
+    writeU32(header + 2, static_cast<u32>(file.size()));
+    writeU32(header + 10, headerSize);
+    writeU32(header + 14, 40);
+    writeU32(header + 18, width);
+    writeU32(header + 22, height);
+    writeU16(header + 26, 1);
+    writeU16(header + 28, static_cast<u16>(bitsPerPixel));
+    writeU32(header + 34, stride * height);
+
+    if(bitsPerPixel == 8)
+    {
+        writeU32(header + 46, 256);
+        for(u32 i = 0; i < 256; ++i)
+        {
+            u8* const color = header + 54 + i * 4;
+            color[0] = palette[i * 3 + 2];
+            color[1] = palette[i * 3 + 1];
+            color[2] = palette[i * 3 + 0];
+        }
+    }
+
+    for(u32 y = 0; y < height; ++y)
+    {
+        const u8* const src = pixels + static_cast<uSys>(y) * width * bytesPerPixel;
+        u8* const row = header + headerSize + y * stride;
+
+        if(bitsPerPixel == 8)
+        {
+            ::std::memcpy(row, src, width);
+            continue;
+        }
+
+        for(u32 x = 0; x < width; ++x)
+        {
+            row[x * 3 + 0] = src[x * 3 + 2];
+            row[x * 3 + 1] = src[x * 3 + 1];
+            row[x * 3 + 2] = src[x * 3 + 0];
+        }
+    }
+
+    return file;
+}
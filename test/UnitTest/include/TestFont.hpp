@@ -0,0 +1,35 @@
+#pragma once
+
+#include <DynArray.hpp>
+#include <cstdio>
+
+/**
+ *   A font from the repository used by the text tests and
+ * benchmarks, relative to the project directory.
+ */
+static constexpr const char* TestFontPath = "../../libs/imgui-1.68/misc/fonts/DroidSans.ttf";
+
+/**
+ *   Reads the test font. Like IFile::readFile the data is
+ * followed by a null terminator that is not part of the font.
+ */
+[[nodiscard]] inline RefDynArray<u8> loadTestFont() noexcept
+{
+    FILE* const file = ::std::fopen(TestFontPath, "rb");
+    if(!file)
+    { return RefDynArray<u8>(0); }
+
+    (void) ::std::fseek(file, 0, SEEK_END);
+    const long size = ::std::ftell(file);
+    (void) ::std::fseek(file, 0, SEEK_SET);
+
+    RefDynArray<u8> data(static_cast<uSys>(size) + 1);
+    const uSys read = ::std::fread(data.arr(), 1, static_cast<uSys>(size), file);
+    ::std::fclose(file);
+
+    if(read != static_cast<uSys>(size))
+    { return RefDynArray<u8>(0); }
+
+    data.arr()[size] = 0;
+    return data;
+}
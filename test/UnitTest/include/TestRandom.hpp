@@ -0,0 +1,15 @@
+#pragma once
+
+#include <NumTypes.hpp>
+
+/**
+ *   A xorshift generator shared by the tests and benchmarks.
+ * Deterministic across platforms, unlike rand().
+ */
+[[nodiscard]] inline u32 nextRandom(u32& state) noexcept
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace TextureDecodeTest {
+void runTests();
+}
@@ -0,0 +1,144 @@
+#include "UnitTest.hpp"
+#include "AllocationTrackerTest.hpp"
+#include <allocator/AllocationTracker.hpp>
+#include <cstring>
+
+/**
+ *   The tracker is global, so every test uses its own tags and
+ * compares snapshots rather than absolute counts.
+ */
+static const AllocationTracker::TagStats& stats(const AllocationTracker::Snapshot& snapshot, const AllocationTag tag) noexcept
+{ return snapshot.tags[tag]; }
+
+TAU_TEST(AllocationTracker, registerTagTest)
+{
+    const AllocationTag a = AllocationTracker::registerTag("RegisterTagA");
+    const AllocationTag b = AllocationTracker::registerTag("RegisterTagB");
+
+    TAU_EXPECT_NEQ(a, AllocationTracker::Untagged);
+    TAU_EXPECT_NEQ(a, b);
+    TAU_EXPECT_EQ(AllocationTracker::registerTag("RegisterTagA"), a);
+    TAU_EXPECT_EQ(::std::strcmp(AllocationTracker::tagName(b), "RegisterTagB"), 0);
+    TAU_EXPECT_EQ(AllocationTracker::registerTag(nullptr), AllocationTracker::Untagged);
+}
+
+TAU_TEST(AllocationTracker, sizeClassTest)
+{
+    TAU_EXPECT_EQ(AllocationTracker::sizeClass(0), 0u);
+    TAU_EXPECT_EQ(AllocationTracker::sizeClass(1), 1u);
+    TAU_EXPECT_EQ(AllocationTracker::sizeClass(63), 6u);
+    TAU_EXPECT_EQ(AllocationTracker::sizeClass(64), 7u);
+    TAU_EXPECT_EQ(AllocationTracker::sizeClass(~static_cast<uSys>(0)), AllocationTracker::SizeClassCount - 1);
+}
+
+#if TAU_ALLOCATION_TRACKING
+TAU_TEST(AllocationTracker, trackedAllocatorTest)
+{
+    TrackedAllocator allocator("TrackedAllocatorTest");
+    const AllocationTracker::Snapshot before = AllocationTracker::snapshot();
+
+    void* const a = allocator.allocate(100);
+    void* const b = allocator.allocate(20);
+    TAU_EXPECT(a && b);
+
+    AllocationTracker::Snapshot diff = AllocationTracker::diff(before, AllocationTracker::snapshot());
+    TAU_EXPECT_EQ(stats(diff, allocator.tag()).bytes, 120);
+    TAU_EXPECT_EQ(stats(diff, allocator.tag()).allocations, 2);
+    TAU_EXPECT_EQ(stats(diff, allocator.tag()).liveAllocations, 2);
+    TAU_EXPECT_GEQ(stats(diff, allocator.tag()).peakBytes, 120);
+    TAU_EXPECT_EQ(diff.histogramCount(allocator.tag(), AllocationTracker::sizeClass(100)), 1);
+    TAU_EXPECT_EQ(diff.histogramCount(allocator.tag(), AllocationTracker::sizeClass(20)), 1);
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+
+    diff = AllocationTracker::diff(before, AllocationTracker::snapshot());
+    TAU_EXPECT_EQ(stats(diff, allocator.tag()).bytes, 0);
+    TAU_EXPECT_EQ(stats(diff, allocator.tag()).allocations, 2);
+    TAU_EXPECT_EQ(stats(diff, allocator.tag()).liveAllocations, 0);
+}
+
+struct BudgetEvents final
+{
+    u32 soft;
+    u32 hard;
+    u64 lastBytes;
+};
+
+static void onBudget(AllocationTag, const AllocationTracker::BudgetLevel level, const u64 bytes, u64, void* const userParam) noexcept
+{
+    BudgetEvents* const events = reinterpret_cast<BudgetEvents*>(userParam);
+    if(level == AllocationTracker::BudgetLevel::Soft)
+    { ++events->soft; }
+    else
+    { ++events->hard; }
+    events->lastBytes = bytes;
+}
+
+TAU_TEST(AllocationTracker, budgetTest)
+{
+    TrackedAllocator allocator("BudgetTest");
+    BudgetEvents events { 0, 0, 0 };
+    AllocationTracker::setBudget(allocator.tag(), 1000, 2000, onBudget, &events);
+
+    void* const a = allocator.allocate(900);
+    TAU_EXPECT_EQ(events.soft, 0u);
+
+    void* const b = allocator.allocate(200);
+    TAU_EXPECT_EQ(events.soft, 1u);
+    TAU_EXPECT_EQ(events.lastBytes, 1100u);
+
+    // Only crossing the soft budget notifies.
+    void* const c = allocator.allocate(100);
+    TAU_EXPECT_EQ(events.soft, 1u);
+
+    void* const rejected = allocator.allocate(1000);
+    TAU_EXPECT_EQ(rejected, nullptr);
+    TAU_EXPECT_EQ(events.hard, 1u);
+    TAU_EXPECT_EQ(events.lastBytes, 2200u);
+
+    const AllocationTracker::Snapshot snapshot = AllocationTracker::snapshot();
+    TAU_EXPECT_EQ(stats(snapshot, allocator.tag()).bytes, 1200);
+    TAU_EXPECT_EQ(stats(snapshot, allocator.tag()).rejected, 1);
+    TAU_EXPECT_EQ(stats(snapshot, allocator.tag()).hardBudget, 2000u);
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(c);
+    AllocationTracker::setBudget(allocator.tag(), 0, 0);
+}
+
+TAU_TEST(AllocationTracker, samplingTest)
+{
+    TrackedAllocator allocator("SamplingTest");
+    AllocationTracker::setSampleInterval(1);
+    const AllocationTracker::Snapshot before = AllocationTracker::snapshot();
+
+    for(uSys i = 0; i < 8; ++i)
+    { allocator.deallocate(allocator.allocate(32)); }
+
+    const AllocationTracker::Snapshot diff = AllocationTracker::diff(before, AllocationTracker::snapshot());
+    AllocationTracker::setSampleInterval(AllocationTracker::DefaultSampleInterval);
+
+    i64 samples = 0;
+    i64 sampledBytes = 0;
+    for(const AllocationTracker::CallSite& site : diff.callSites)
+    {
+        if(site.tag == allocator.tag())
+        {
+            samples += site.samples;
+            sampledBytes += site.sampledBytes;
+        }
+    }
+
+    TAU_EXPECT_EQ(samples, 8);
+    TAU_EXPECT_EQ(sampledBytes, 8 * 32);
+}
+#endif
+
+namespace AllocationTrackerTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
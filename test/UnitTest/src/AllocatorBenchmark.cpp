@@ -0,0 +1,197 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <allocator/FixedBlockAllocator.hpp>
+#include <allocator/TLSFAllocator.hpp>
+#include <allocator/LinearAllocator.hpp>
+#include <allocator/AllocationTracker.hpp>
+#include <cstring>
+#include <vector>
+
+static constexpr uSys LiveCount = 4096;
+
+/**
+ * The reference the other allocators are compared against.
+ */
+TAU_BENCHMARK(Heap, newDelete)
+{
+    ::std::vector<u8*> live(LiveCount, nullptr);
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        u8*& slot = live[nextRandom(random) & (LiveCount - 1)];
+        delete[] slot;
+        slot = new(::std::nothrow) u8[64];
+        (void) i;
+    }
+
+    for(u8* const allocation : live)
+    { delete[] allocation; }
+}
+
+TAU_BENCHMARK(FixedBlockAllocator, allocate)
+{
+    FixedBlockAllocator<AllocationTracking::None> allocator(64, state.iterations());
+    for(const uSys i : state)
+    {
+        Benchmarks::doNotOptimize(allocator.allocate());
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(FixedBlockAllocator, allocateFree)
+{
+    FixedBlockAllocator<AllocationTracking::None> allocator(64, LiveCount * 2);
+    ::std::vector<void*> live(LiveCount, nullptr);
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        void*& slot = live[nextRandom(random) & (LiveCount - 1)];
+        if(slot)
+        { allocator.deallocate(slot); }
+        slot = allocator.allocate();
+        (void) i;
+    }
+
+    for(void* const allocation : live)
+    {
+        if(allocation)
+        { allocator.deallocate(allocation); }
+    }
+}
+
+TAU_BENCHMARK(TLSFAllocator, allocateFree)
+{
+    TLSFAllocator allocator(256ull << 20, LiveCount);
+    ::std::vector<TLSFAllocator::Allocation> live(LiveCount, TLSFAllocator::Allocation { 0, 0, TLSFAllocator::InvalidNode });
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        TLSFAllocator::Allocation& slot = live[nextRandom(random) & (LiveCount - 1)];
+        if(slot.valid())
+        { allocator.free(slot); }
+        slot = allocator.allocate(256 + nextRandom(random) % (64 << 10), 256);
+        (void) i;
+    }
+}
+
+/**
+ *   A frame's worth of variable sized temporaries, released
+ * together at the end of the frame.
+ */
+static constexpr uSys FrameAllocations = 1024;
+
+TAU_BENCHMARK(DefaultTauAllocator, frameTemporaries)
+{
+    DefaultTauAllocator& allocator = DefaultTauAllocator::Instance();
+    ::std::vector<void*> frame(FrameAllocations, nullptr);
+
+    u32 random = 0x9E3779B9;
+    uSys index = 0;
+    for(const uSys i : state)
+    {
+        frame[index] = allocator.allocate(16 + (nextRandom(random) & 255));
+        if(++index == FrameAllocations)
+        {
+            for(void* const allocation : frame)
+            { allocator.deallocate(allocation); }
+            index = 0;
+        }
+        (void) i;
+    }
+
+    for(uSys j = 0; j < index; ++j)
+    { allocator.deallocate(frame[j]); }
+}
+
+TAU_BENCHMARK(LinearArenaAllocator, frameTemporaries)
+{
+    LinearArenaAllocator arena;
+
+    u32 random = 0x9E3779B9;
+    uSys index = 0;
+    for(const uSys i : state)
+    {
+        Benchmarks::doNotOptimize(arena.allocate(16 + (nextRandom(random) & 255)));
+        if(++index == FrameAllocations)
+        {
+            arena.reset();
+            index = 0;
+        }
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(DefaultTauAllocator, scratchPushPop)
+{
+    DefaultTauAllocator& allocator = DefaultTauAllocator::Instance();
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        void* const outer = allocator.allocate(64 + (nextRandom(random) & 1023));
+        void* const inner = allocator.allocate(16 + (nextRandom(random) & 255));
+        Benchmarks::doNotOptimize(inner);
+        allocator.deallocate(inner);
+        allocator.deallocate(outer);
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(ScratchAllocator, scratchPushPop)
+{
+    ScratchAllocator& scratch = ScratchAllocator::threadLocal();
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        void* const outer = scratch.allocate(64 + (nextRandom(random) & 1023));
+        void* const inner = scratch.allocate(16 + (nextRandom(random) & 255));
+        Benchmarks::doNotOptimize(inner);
+        scratch.deallocate(inner);
+        scratch.deallocate(outer);
+        (void) i;
+    }
+}
+
+/**
+ *   The same allocate and free pattern with and without a tag,
+ * the difference is the cost of tracking. Each allocation is
+ * touched as its owner would, so the overhead is relative to a
+ * realistic use of the memory rather than to the bare allocator.
+ */
+static void randomAllocateFree(TauAllocator& allocator, BenchmarkState& state) noexcept
+{
+    ::std::vector<void*> live(LiveCount, nullptr);
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        void*& slot = live[nextRandom(random) & (LiveCount - 1)];
+        allocator.deallocate(slot);
+
+        const uSys size = 16 + (nextRandom(random) & 511);
+        slot = allocator.allocate(size);
+        if(slot)
+        { ::std::memset(slot, 0, size); }
+        (void) i;
+    }
+
+    for(void* const allocation : live)
+    { allocator.deallocate(allocation); }
+}
+
+TAU_BENCHMARK(DefaultTauAllocator, untracked)
+{ randomAllocateFree(DefaultTauAllocator::Instance(), state); }
+
+/**
+ * Tracking is meant to cost less than 5% over the untracked allocator.
+ */
+TAU_BENCHMARK(TrackedAllocator, tracked)
+{
+    state.relativeTo("DefaultTauAllocator.untracked", 5.0);
+    TrackedAllocator allocator("Benchmark");
+    randomAllocateFree(allocator, state);
+}
@@ -0,0 +1,520 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if !defined(_MSC_VER) && (defined(__x86_64__) || defined(__i386__))
+  #include <x86intrin.h>
+#endif
+
+#ifdef __linux__
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+
+constexpr u64 CounterUnavailable = ~0ull;
+constexpr uSys MaxIterations = static_cast<uSys>(1) << 30;
+
+[[nodiscard]] u64 readTimestamp() noexcept
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ *   Cycles, cache misses and branch misses of this thread, read
+ * through perf_event on Linux. Opening them fails if the kernel
+ * doesn't allow unprivileged counters, every counter then reads
+ * as CounterUnavailable.
+ */
+class HardwareCounters final
+{
+    DELETE_CM(HardwareCounters);
+public:
+    static constexpr u32 CounterCount = 3;
+private:
+    int _fds[CounterCount];
+public:
+    HardwareCounters() noexcept
+        : _fds { -1, -1, -1 }
+    {
+#ifdef __linux__
+        const u64 configs[CounterCount] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+        for(u32 i = 0; i < CounterCount; ++i)
+        {
+            perf_event_attr attr;
+            ::std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            // The first counter leads the group so they are all scheduled together.
+            _fds[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : _fds[0], 0));
+            if(_fds[i] < 0)
+            {
+                close();
+                return;
+            }
+        }
+#endif
+    }
+
+    ~HardwareCounters() noexcept
+    { close(); }
+
+    [[nodiscard]] bool available() const noexcept { return _fds[0] >= 0; }
+
+    void start() noexcept
+    {
+#ifdef __linux__
+        if(!available())
+        { return; }
+        (void) ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        (void) ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void stop(BenchmarkSample& sample) noexcept
+    {
+        sample.cycles = CounterUnavailable;
+        sample.cacheMisses = CounterUnavailable;
+        sample.branchMisses = CounterUnavailable;
+
+#ifdef __linux__
+        if(!available())
+        { return; }
+        (void) ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        u64 values[1 + CounterCount];
+        if(read(_fds[0], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[0] != CounterCount)
+        { return; }
+
+        sample.cycles = values[1];
+        sample.cacheMisses = values[2];
+        sample.branchMisses = values[3];
+#else
+        (void) sample;
+#endif
+    }
+private:
+    void close() noexcept
+    {
+        for(int& fd : _fds)
+        {
+#ifdef __linux__
+            if(fd >= 0)
+            { (void) ::close(fd); }
+#endif
+            fd = -1;
+        }
+    }
+};
+
+IBenchmarkCase* benchmarkHead = nullptr;
+HardwareCounters* activeCounters = nullptr;
+
+::std::chrono::steady_clock::time_point sampleStart;
+u64 sampleStartTimestamp;
+
+struct Statistics final
+{
+    double min;
+    double median;
+    double p10;
+    double p90;
+    double mean;
+};
+
+[[nodiscard]] double percentile(const ::std::vector<double>& sorted, const double p) noexcept
+{
+    const double position = p * static_cast<double>(sorted.size() - 1);
+    const uSys lower = static_cast<uSys>(position);
+    const uSys upper = ::std::min(lower + 1, sorted.size() - 1);
+    const double t = position - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * t;
+}
+
+[[nodiscard]] Statistics computeStatistics(::std::vector<double> values) noexcept
+{
+    ::std::sort(values.begin(), values.end());
+
+    double sum = 0.0;
+    for(const double value : values)
+    { sum += value; }
+
+    return { values.front(), percentile(values, 0.5), percentile(values, 0.1), percentile(values, 0.9), sum / static_cast<double>(values.size()) };
+}
+
+/**
+ * The median of a counter per iteration, negative if it isn't available.
+ */
+[[nodiscard]] double counterMedian(const ::std::vector<BenchmarkSample>& samples, u64 BenchmarkSample::* const counter, const uSys iterations) noexcept
+{
+    ::std::vector<double> values;
+    for(const BenchmarkSample& sample : samples)
+    {
+        if(sample.*counter == CounterUnavailable)
+        { return -1.0; }
+        values.push_back(static_cast<double>(sample.*counter) / static_cast<double>(iterations));
+    }
+    return computeStatistics(::std::move(values)).median;
+}
+
+struct Result final
+{
+    ::std::string name;
+    uSys iterations;
+    Statistics nanoseconds;
+    double timestamp;
+    double cycles;
+    double cacheMisses;
+    double branchMisses;
+    double baseline;
+    const char* skipped;
+    const char* reference;
+    double target;
+};
+
+/**
+ * Fills in what the benchmark declared about itself if `result` isn't null.
+ */
+[[nodiscard]] BenchmarkSample runSample(IBenchmarkCase* const benchmark, const uSys iterations, Result* const result = nullptr) noexcept
+{
+    BenchmarkState state(iterations);
+    benchmark->run(state);
+    if(result)
+    {
+        result->skipped = state.skipped();
+        result->reference = state.reference();
+        result->target = state.target();
+    }
+    return state.sample();
+}
+
+[[nodiscard]] Result runBenchmark(IBenchmarkCase* const benchmark, const BenchmarkOptions& options) noexcept
+{
+    const double minSampleNs = options.minSampleTime * 1000000.0;
+    const double warmupNs = options.warmupTime * 1000000.0;
+
+    Result result { };
+    result.name = ::std::string(benchmark->suite()) + "." + benchmark->name();
+    result.baseline = -1.0;
+
+    /**
+     *   Grows the iteration count until a sample is long enough for
+     * the clock to be accurate, this also serves as the warmup.
+     */
+    uSys iterations = 1;
+    double warmedUp = 0.0;
+    while(true)
+    {
+        const BenchmarkSample sample = runSample(benchmark, iterations, &result);
+        if(result.skipped)
+        { return result; }
+        warmedUp += sample.nanoseconds;
+
+        if(iterations >= MaxIterations)
+        { break; }
+
+        if(sample.nanoseconds >= minSampleNs)
+        {
+            if(warmedUp >= warmupNs)
+            { break; }
+            continue;
+        }
+
+        const double scale = sample.nanoseconds > 0.0 ? minSampleNs * 1.2 / sample.nanoseconds : 10.0;
+        iterations = ::std::min(MaxIterations, static_cast<uSys>(static_cast<double>(iterations) * ::std::min(10.0, ::std::max(2.0, scale))));
+    }
+
+    ::std::vector<BenchmarkSample> samples;
+    samples.reserve(options.samples);
+    for(u32 i = 0; i < options.samples; ++i)
+    { samples.push_back(runSample(benchmark, iterations)); }
+
+    ::std::vector<double> nanoseconds;
+    ::std::vector<double> timestamps;
+    for(const BenchmarkSample& sample : samples)
+    {
+        nanoseconds.push_back(sample.nanoseconds / static_cast<double>(iterations));
+        timestamps.push_back(static_cast<double>(sample.timestamp) / static_cast<double>(iterations));
+    }
+
+    result.iterations = iterations;
+    result.nanoseconds = computeStatistics(::std::move(nanoseconds));
+    result.timestamp = computeStatistics(::std::move(timestamps)).median;
+    result.cycles = counterMedian(samples, &BenchmarkSample::cycles, iterations);
+    result.cacheMisses = counterMedian(samples, &BenchmarkSample::cacheMisses, iterations);
+    result.branchMisses = counterMedian(samples, &BenchmarkSample::branchMisses, iterations);
+    return result;
+}
+
+[[nodiscard]] ::std::string readFile(const char* const path) noexcept
+{
+    ::std::string ret;
+    FILE* const file = fopen(path, "rb");
+    if(!file)
+    { return ret; }
+
+    char buffer[4096];
+    uSys read;
+    while((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    { ret.append(buffer, read); }
+
+    fclose(file);
+    return ret;
+}
+
+/**
+ *   Finds the median of a benchmark in a file written by
+ * writeJson, this only understands that layout rather than
+ * JSON in general.
+ */
+[[nodiscard]] double findBaseline(const ::std::string& json, const ::std::string& name) noexcept
+{
+    const ::std::string key = "\"name\": \"" + name + "\"";
+    const uSys begin = json.find(key);
+    if(begin == ::std::string::npos)
+    { return -1.0; }
+
+    const uSys end = json.find('}', begin);
+    const uSys median = json.find("\"median_ns\":", begin);
+    if(median == ::std::string::npos || median > end)
+    { return -1.0; }
+
+    return strtod(json.c_str() + median + sizeof("\"median_ns\":") - 1, nullptr);
+}
+
+void writeJsonCounter(FILE* const file, const char* const name, const double value, const char* const separator) noexcept
+{
+    if(value < 0.0)
+    { fprintf(file, "      \"%s\": null%s\n", name, separator); }
+    else
+    { fprintf(file, "      \"%s\": %.4f%s\n", name, value, separator); }
+}
+
+void writeJson(const char* const path, const ::std::vector<Result>& results, const bool countersAvailable) noexcept
+{
+    FILE* const file = fopen(path, "w");
+    if(!file)
+    {
+        printf("Failed to open \"%s\" for writing.\n", path);
+        return;
+    }
+
+    fprintf(file, "{\n  \"hardware_counters\": %s,\n  \"benchmarks\": [\n", countersAvailable ? "true" : "false");
+    for(uSys i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"name\": \"%s\",\n", result.name.c_str());
+        fprintf(file, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(result.iterations));
+        fprintf(file, "      \"min_ns\": %.4f,\n", result.nanoseconds.min);
+        fprintf(file, "      \"median_ns\": %.4f,\n", result.nanoseconds.median);
+        fprintf(file, "      \"p10_ns\": %.4f,\n", result.nanoseconds.p10);
+        fprintf(file, "      \"p90_ns\": %.4f,\n", result.nanoseconds.p90);
+        fprintf(file, "      \"mean_ns\": %.4f,\n", result.nanoseconds.mean);
+        fprintf(file, "      \"timestamp_ticks\": %.4f,\n", result.timestamp);
+        writeJsonCounter(file, "cycles", result.cycles, ",");
+        writeJsonCounter(file, "cache_misses", result.cacheMisses, ",");
+        writeJsonCounter(file, "branch_misses", result.branchMisses, "");
+        fprintf(file, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    fclose(file);
+}
+
+void printCounter(const double value) noexcept
+{
+    if(value < 0.0)
+    { printf(" %10s", "-"); }
+    else
+    { printf(" %10.2f", value); }
+}
+
+}
+
+void BenchmarkState::start() noexcept
+{
+    _running = true;
+    if(activeCounters)
+    { activeCounters->start(); }
+    sampleStartTimestamp = readTimestamp();
+    sampleStart = ::std::chrono::steady_clock::now();
+}
+
+void BenchmarkState::stop() noexcept
+{
+    const auto end = ::std::chrono::steady_clock::now();
+    const u64 endTimestamp = readTimestamp();
+
+    if(!_running)
+    { return; }
+    _running = false;
+
+    _sample.nanoseconds = ::std::chrono::duration<double, ::std::nano>(end - sampleStart).count();
+    _sample.timestamp = endTimestamp - sampleStartTimestamp;
+    if(activeCounters)
+    { activeCounters->stop(_sample); }
+    else
+    { _sample.cycles = _sample.cacheMisses = _sample.branchMisses = CounterUnavailable; }
+}
+
+void Benchmarks::registerCase(IBenchmarkCase* const benchmark) noexcept
+{
+    if(!benchmarkHead)
+    {
+        benchmarkHead = benchmark;
+        return;
+    }
+
+    // Insert after the last case of the same suite, or at the end.
+    IBenchmarkCase* insertAfter = nullptr;
+    IBenchmarkCase* last = benchmarkHead;
+    for(IBenchmarkCase* curr = benchmarkHead; curr; curr = curr->_next)
+    {
+        if(::std::strcmp(curr->_suite, benchmark->_suite) == 0)
+        { insertAfter = curr; }
+        last = curr;
+    }
+
+    if(!insertAfter)
+    { insertAfter = last; }
+
+    benchmark->_next = insertAfter->_next;
+    insertAfter->_next = benchmark;
+}
+
+BenchmarkOptions Benchmarks::parseArgs(const int argCount, char* args[]) noexcept
+{
+    BenchmarkOptions options;
+
+    const auto value = [](const char* const arg, const char* const name) noexcept -> const char*
+    {
+        const uSys length = ::std::strlen(name);
+        if(::std::strncmp(arg, name, length) == 0 && arg[length] == '=')
+        { return arg + length + 1; }
+        return nullptr;
+    };
+
+    for(int i = 1; i < argCount; ++i)
+    {
+        const char* v;
+        if((v = value(args[i], "--benchmark-filter")))
+        { options.filter = v; }
+        else if((v = value(args[i], "--benchmark-out")))
+        { options.outFile = v; }
+        else if((v = value(args[i], "--benchmark-baseline")))
+        { options.baselineFile = v; }
+        else if((v = value(args[i], "--benchmark-samples")))
+        { options.samples = ::std::max(1u, static_cast<u32>(strtoul(v, nullptr, 10))); }
+        else if((v = value(args[i], "--benchmark-min-time")))
+        { options.minSampleTime = strtod(v, nullptr); }
+        else if((v = value(args[i], "--benchmark-warmup")))
+        { options.warmupTime = strtod(v, nullptr); }
+        else if((v = value(args[i], "--benchmark-threshold")))
+        { options.threshold = strtod(v, nullptr); }
+    }
+
+    return options;
+}
+
+u32 Benchmarks::runAll(const BenchmarkOptions& options) noexcept
+{
+    HardwareCounters counters;
+    activeCounters = counters.available() ? &counters : nullptr;
+
+    const ::std::string baseline = options.baselineFile ? readFile(options.baselineFile) : ::std::string();
+    if(options.baselineFile && baseline.empty())
+    { printf("Failed to read the baseline \"%s\".\n", options.baselineFile); }
+
+    printf("%u samples of at least %.1f ms each, %.1f ms warmup. Hardware counters %s.\n",
+           options.samples, options.minSampleTime, options.warmupTime, activeCounters ? "enabled" : "unavailable");
+    printf("%-40s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+           "per iteration", "iterations", "median ns", "p10 ns", "p90 ns", "rdtsc", "cycles", "cache miss", "br. miss", "baseline");
+
+    ::std::vector<Result> results;
+    u32 regressions = 0;
+    u32 targets = 0;
+    u32 overTarget = 0;
+    for(IBenchmarkCase* benchmark = benchmarkHead; benchmark; benchmark = benchmark->_next)
+    {
+        const ::std::string name = ::std::string(benchmark->suite()) + "." + benchmark->name();
+        if(options.filter && name.find(options.filter) == ::std::string::npos)
+        { continue; }
+
+        Result result = runBenchmark(benchmark, options);
+        if(result.skipped)
+        {
+            printf("%-40s skipped, %s\n", result.name.c_str(), result.skipped);
+            continue;
+        }
+
+        if(!baseline.empty())
+        { result.baseline = findBaseline(baseline, result.name); }
+
+        printf("%-40s %10llu %10.2f %10.2f %10.2f %10.1f", result.name.c_str(), static_cast<unsigned long long>(result.iterations),
+               result.nanoseconds.median, result.nanoseconds.p10, result.nanoseconds.p90, result.timestamp);
+        printCounter(result.cycles);
+        printCounter(result.cacheMisses);
+        printCounter(result.branchMisses);
+
+        if(result.baseline > 0.0)
+        {
+            const double change = (result.nanoseconds.median / result.baseline - 1.0) * 100.0;
+            const bool regressed = change > options.threshold;
+            printf(" %+9.1f%%%s\n", change, regressed ? " REGRESSION" : "");
+            if(regressed)
+            { ++regressions; }
+        }
+        else
+        { printf(" %10s\n", "-"); }
+
+        if(result.reference)
+        {
+            const auto reference = ::std::find_if(results.begin(), results.end(), [&](const Result& r) { return r.name == result.reference; });
+            if(reference == results.end())
+            { printf("    %s wasn't run, can't compare against it.\n", result.reference); }
+            else
+            {
+                const double overhead = (result.nanoseconds.median / reference->nanoseconds.median - 1.0) * 100.0;
+                const bool over = overhead > result.target;
+                printf("    %+.1f%% over %s, %s the %.1f%% target.\n", overhead, result.reference, over ? "OVER" : "within", result.target);
+                ++targets;
+                if(over)
+                { ++overTarget; }
+            }
+        }
+
+        results.push_back(::std::move(result));
+    }
+
+    activeCounters = nullptr;
+
+    if(options.outFile)
+    { writeJson(options.outFile, results, counters.available()); }
+
+    if(!baseline.empty())
+    { printf("%u regression(s) of more than %.1f%% against the baseline.\n", regressions, options.threshold); }
+
+    if(targets)
+    { printf("%u of %u benchmark(s) over their target.\n", overTarget, targets); }
+
+    return regressions + overTarget;
+}
@@ -0,0 +1,171 @@
+/**
+ *   The rest of the tree is built with the default counting
+ * mode, this translation unit is built with biased counting so
+ * the real pointer types are tested in that mode.
+ *
+ *   Every type instantiated here is in an anonymous namespace,
+ * so none of the pointer instantiations are shared with the
+ * other translation units.
+ *
+ *   TauUtils itself is built in the default mode, where
+ * rcpProcessPendingReleases() does nothing, so the calling
+ * thread's queue is processed directly.
+ */
+#define TAU_DEFAULT_ATOMIC TAU_RCP_BIASED
+
+#include <ReferenceCountingPointer.hpp>
+#include "RefUnitTest.hpp"
+#include "UnitTest.hpp"
+#include <thread>
+
+static_assert(TAU_DEFAULT_ATOMIC == TAU_RCP_BIASED);
+
+namespace {
+
+uSys _destroyCount = 0;
+::std::thread::id _destroyThread;
+
+class BiasedData
+{
+    DELETE_CM(BiasedData);
+private:
+    int _x;
+public:
+    BiasedData(const int x) noexcept
+        : _x(x)
+    { }
+
+    ~BiasedData() noexcept
+    {
+        ++_destroyCount;
+        _destroyThread = ::std::this_thread::get_id();
+    }
+
+    [[nodiscard]] int x() const noexcept { return _x; }
+};
+
+/**
+ * Must be destroyed on the thread that created it, like a graphics resource.
+ */
+class BiasedResource final : public BiasedData, public RCPDeferredRelease
+{
+    DELETE_CM(BiasedResource);
+public:
+    BiasedResource(const int x) noexcept
+        : BiasedData(x)
+    { }
+};
+
+uSys processLocalQueue() noexcept
+{ return _ReferenceCountingPointerUtils::_BiasedRefCountQueue::local()->process(); }
+
+}
+
+namespace RefPtrTest {
+
+/**
+ *   Another thread takes and releases a reference while the
+ * owner still holds one, the owner's release destroys it.
+ */
+void biasedRefPtrMergeTest() noexcept
+{
+    UNIT_TEST();
+
+    _destroyCount = 0;
+    ReferenceCountingPointer<BiasedData> p(DefaultTauAllocator::Instance(), 3);
+    Assert(p.refCount() == 1);
+    {
+        const ReferenceCountingPointer<BiasedData> p1 = p;
+        Assert(p.refCount() == 2);
+    }
+    Assert(p.refCount() == 1);
+
+    ::std::thread([&p]()
+    {
+        const ReferenceCountingPointer<BiasedData> copy = p;
+        Assert(copy->x() == 3);
+    }).join();
+
+    Assert(p.refCount() == 1);
+    Assert(_destroyCount == 0);
+
+    p = nullptr;
+    Assert(_destroyCount == 1);
+    Assert(_destroyThread == ::std::this_thread::get_id());
+}
+
+/**
+ *   The owner hands a reference to another thread which releases
+ * it, the owner has to merge before its last release can
+ * destroy the object.
+ */
+void biasedRefPtrHandOffTest() noexcept
+{
+    UNIT_TEST();
+
+    _destroyCount = 0;
+    ReferenceCountingPointer<BiasedData> p(DefaultTauAllocator::Instance(), 5);
+    ReferenceCountingPointer<BiasedData> handed = p;
+
+    ::std::thread([moved = ::std::move(handed)]() mutable { moved = nullptr; }).join();
+    Assert(_destroyCount == 0);
+    Assert(p.refCount() == 1);
+
+    Assert(processLocalQueue() == 1);
+    Assert(_destroyCount == 0);
+    Assert(p.refCount() == 1);
+
+    p = nullptr;
+    Assert(_destroyCount == 1);
+    Assert(_destroyThread == ::std::this_thread::get_id());
+}
+
+/**
+ *   The last reference is released by another thread. An
+ * ordinary object is destroyed there, a deferred release object
+ * is left for its owner.
+ */
+void biasedRefPtrDeferredReleaseTest() noexcept
+{
+    UNIT_TEST();
+
+    {
+        _destroyCount = 0;
+        ReferenceCountingPointer<BiasedData> p(DefaultTauAllocator::Instance(), 7);
+        ReferenceCountingPointer<BiasedData> holder;
+
+        ::std::thread([&]() { holder = p; }).join();
+        p = nullptr;
+        Assert(_destroyCount == 0);
+        Assert(holder.refCount() == 1);
+
+        ::std::thread::id releaseThread;
+        ::std::thread([&]()
+        {
+            releaseThread = ::std::this_thread::get_id();
+            holder = nullptr;
+        }).join();
+        Assert(_destroyCount == 1);
+        Assert(_destroyThread == releaseThread);
+        Assert(processLocalQueue() == 0);
+    }
+
+    {
+        _destroyCount = 0;
+        ReferenceCountingPointer<BiasedResource> p(DefaultTauAllocator::Instance(), 9);
+        ReferenceCountingPointer<BiasedResource> holder;
+
+        ::std::thread([&]() { holder = p; }).join();
+        p = nullptr;
+        Assert(_destroyCount == 0);
+
+        ::std::thread([&]() { holder = nullptr; }).join();
+        Assert(_destroyCount == 0);
+
+        Assert(processLocalQueue() == 1);
+        Assert(_destroyCount == 1);
+        Assert(_destroyThread == ::std::this_thread::get_id());
+    }
+}
+
+}
@@ -0,0 +1,120 @@
+#include "CompressionTest.hpp"
+#include "UnitTest.hpp"
+#include <LZ.hpp>
+#include <VarInt.hpp>
+#include <cstring>
+#include <vector>
+
+static bool roundTrip(const ::std::vector<u8>& src) noexcept
+{
+    ::std::vector<u8> compressed(LZ::compressBound(src.size()));
+    ::std::vector<u8> decompressed(src.size());
+
+    const uSys compressedSize = LZ::compress(src.data(), src.size(), compressed.data(), compressed.size());
+    if(!compressedSize)
+    { return false; }
+
+    const uSys decompressedSize = LZ::decompress(compressed.data(), compressedSize, decompressed.data(), decompressed.size());
+    return decompressedSize == src.size() && ::std::memcmp(src.data(), decompressed.data(), src.size()) == 0;
+}
+
+TAU_TEST(VarInt, roundTripTest)
+{
+    const u64 values[] = { 0, 1, 127, 128, 255, 16383, 16384, 0xFFFFFFFF, 0x7FFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull };
+
+    for(const u64 value : values)
+    {
+        u8 buffer[VarInt::MaxBytes];
+        const uSys written = VarInt::encode(value, buffer);
+        TAU_EXPECT_EQ(written, VarInt::encodedSize(value));
+
+        u64 decoded;
+        const uSys read = VarInt::decode(buffer, buffer + written, &decoded);
+        TAU_EXPECT_EQ(read, written);
+        TAU_EXPECT_EQ(decoded, value);
+    }
+}
+
+TAU_TEST(VarInt, signedRoundTripTest)
+{
+    const i64 values[] = { 0, 1, -1, 63, -64, 64, -65, 0x7FFFFFFFFFFFFFFFll, -0x7FFFFFFFFFFFFFFFll - 1 };
+
+    for(const i64 value : values)
+    {
+        u8 buffer[VarInt::MaxBytes];
+        const uSys written = VarInt::encodeSigned(value, buffer);
+
+        i64 decoded;
+        TAU_EXPECT_EQ(VarInt::decodeSigned(buffer, buffer + written, &decoded), written);
+        TAU_EXPECT_EQ(decoded, value);
+    }
+
+    TAU_EXPECT_EQ(VarInt::encodedSize(VarInt::zigZag(-1)), 1u);
+}
+
+TAU_TEST(VarInt, truncatedTest)
+{
+    u8 buffer[VarInt::MaxBytes];
+    const uSys written = VarInt::encode(1ull << 40, buffer);
+
+    u64 decoded;
+    TAU_EXPECT_EQ(VarInt::decode(buffer, buffer + written - 1, &decoded), 0u);
+}
+
+TAU_TEST(LZ, emptyTest)
+{
+    TAU_EXPECT(roundTrip({ }));
+}
+
+TAU_TEST(LZ, literalTest)
+{
+    ::std::vector<u8> src(4096);
+    u32 state = 0x12345678;
+    for(u8& b : src)
+    {
+        state = state * 1664525 + 1013904223;
+        b = static_cast<u8>(state >> 24);
+    }
+
+    TAU_EXPECT(roundTrip(src));
+}
+
+TAU_TEST(LZ, repetitiveTest)
+{
+    ::std::vector<u8> src(65536);
+    for(uSys i = 0; i < src.size(); ++i)
+    { src[i] = static_cast<u8>((i / 64) % 7); }
+
+    ::std::vector<u8> compressed(LZ::compressBound(src.size()));
+    const uSys compressedSize = LZ::compress(src.data(), src.size(), compressed.data(), compressed.size());
+    TAU_EXPECT_LS(compressedSize, src.size() / 8);
+
+    TAU_EXPECT(roundTrip(src));
+}
+
+TAU_TEST(LZ, overlappingMatchTest)
+{
+    ::std::vector<u8> src(1000, 0xAB);
+    src[0] = 1;
+    src[999] = 2;
+
+    TAU_EXPECT(roundTrip(src));
+}
+
+TAU_TEST(LZ, corruptTest)
+{
+    ::std::vector<u8> src(512);
+    for(uSys i = 0; i < src.size(); ++i)
+    { src[i] = static_cast<u8>(i % 13); }
+
+    ::std::vector<u8> compressed(LZ::compressBound(src.size()));
+    const uSys compressedSize = LZ::compress(src.data(), src.size(), compressed.data(), compressed.size());
+
+    ::std::vector<u8> decompressed(src.size() / 2);
+    TAU_EXPECT_EQ(LZ::decompress(compressed.data(), compressedSize, decompressed.data(), decompressed.size()), 0u);
+}
+
+void CompressionTest::runTests()
+{
+    RUN_ALL_TESTS();
+}
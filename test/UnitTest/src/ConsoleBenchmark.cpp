@@ -0,0 +1,161 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <console/ConsoleController.hpp>
+#include <console/ConsoleVariable.hpp>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static constexpr u32 CVarCount = 64;
+static constexpr u32 ScriptLines = 10000;
+
+/**
+ *   A config of 10,000 lines over 64 f32 cvars, mostly
+ * assignments with the occasional comment.
+ */
+class ConsoleScript final
+{
+    DEFAULT_DESTRUCT(ConsoleScript);
+    DELETE_CM(ConsoleScript);
+public:
+    char names[CVarCount][16];
+    ::std::vector<::std::unique_ptr<Console::CVar<f32>>> cvars;
+    Console::Controller controller;
+    ::std::unordered_map<DynString, Console::Command*> legacyCommands;
+    ::std::string script;
+public:
+    ConsoleScript() noexcept
+        : controller({
+            [](void*, const char*) { },
+            [](void*, const char*) { },
+            [](void*) { },
+            [](void*, const char*, va_list) { }
+        }, nullptr)
+    {
+        for(u32 i = 0; i < CVarCount; ++i)
+        {
+            (void) ::std::snprintf(names[i], sizeof(names[i]), "bench_var%u", i);
+            cvars.emplace_back(new Console::CVar<f32>(names[i], "", 0.0f));
+            controller.addCVar(cvars.back().get());
+            legacyCommands[names[i]] = cvars.back().get();
+        }
+
+        u32 random = 0xC0F;
+        for(u32 i = 0; i < ScriptLines; ++i)
+        {
+            char line[64];
+            if(i % 16 == 0)
+            { (void) ::std::snprintf(line, sizeof(line), "# Section %u\n", i / 16); }
+            else
+            { (void) ::std::snprintf(line, sizeof(line), "bench_var%u %u.%u\n", nextRandom(random) % CVarCount, nextRandom(random) % 100, nextRandom(random) % 100); }
+            script += line;
+        }
+    }
+};
+
+/**
+ * How Controller used to split a command, every token in its own heap allocation.
+ */
+static void legacySplit(const char* command, ::std::vector<const char*>& sections) noexcept
+{
+    u32 count = 0;
+
+    while(*command != '\0')
+    {
+        if(*command == ' ')
+        {
+            char* str = new char[count + 1];
+            str[count] = '\0';
+            memcpy(str, command - count, count);
+            count = 0;
+            sections.push_back(str);
+            do
+            {
+                ++command;
+            } while(*command == ' ');
+            continue;
+        }
+
+        ++count;
+        ++command;
+    }
+
+    if(count)
+    {
+        char* str = new char[count + 1];
+        str[count] = '\0';
+        memcpy(str, command - count, count);
+        sections.push_back(str);
+    }
+}
+
+/**
+ * The script run through the old heap tokens and map lookup, once per iteration.
+ */
+TAU_BENCHMARK(Console, legacyScript)
+{
+    ConsoleScript config;
+    ::std::vector<const char*> sections;
+
+    for(const uSys i : state)
+    {
+        u32 failures = 0;
+        uSys begin = 0;
+        while(begin < config.script.size())
+        {
+            const uSys end = config.script.find('\n', begin);
+            const ::std::string line = config.script.substr(begin, end - begin);
+            begin = end + 1;
+
+            if(line.empty() || line[0] == '#')
+            { continue; }
+
+            sections.clear();
+            legacySplit(line.c_str(), sections);
+            const auto command = config.legacyCommands.find(sections[0]);
+            if(command != config.legacyCommands.end())
+            { failures += command->second->execute(sections[0], sections.data() + 1, static_cast<u32>(sections.size() - 1), &config.controller) != 0; }
+            else
+            { ++failures; }
+
+            for(const char* section : sections)
+            { delete[] section; }
+        }
+        config.controller.flushCVarChanges();
+        Benchmarks::doNotOptimize(failures);
+        (void) i;
+    }
+}
+
+/**
+ * The script run through Controller::runScript, once per iteration.
+ */
+TAU_BENCHMARK(Console, runScript)
+{
+    ConsoleScript config;
+
+    for(const uSys i : state)
+    {
+        const u32 failures = config.controller.runScript(config.script.data(), config.script.size());
+        config.controller.flushCVarChanges();
+        Benchmarks::doNotOptimize(failures);
+        (void) i;
+    }
+}
+
+/**
+ * Reading a cvar from hot code is a relaxed load.
+ */
+TAU_BENCHMARK(Console, cvarRead)
+{
+    ConsoleScript config;
+    f32 sum = 0.0f;
+
+    for(const uSys i : state)
+    { sum += config.cvars[i % CVarCount]->get(); }
+
+    Benchmarks::doNotOptimize(sum);
+}
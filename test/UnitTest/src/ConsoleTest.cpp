@@ -0,0 +1,395 @@
+#include "UnitTest.hpp"
+#include "ConsoleTest.hpp"
+#include <console/ConsoleController.hpp>
+#include <console/ConsoleVariable.hpp>
+#include <VariableLengthArray.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const Console::PrintFunctions SilentPrint {
+    [](void*, const char*) { },
+    [](void*, const char*) { },
+    [](void*) { },
+    [](void*, const char*, va_list) { }
+};
+
+/**
+ * Records the arguments it was last run with.
+ */
+class RecordCommand final : public Console::Command
+{
+    DEFAULT_DESTRUCT(RecordCommand);
+    DELETE_CM(RecordCommand);
+public:
+    ::std::string commandName;
+    ::std::vector<::std::string> args;
+    uSys runCount;
+private:
+    ::std::string _name;
+public:
+    RecordCommand(const char* const name) noexcept
+        : runCount(0)
+        , _name(name)
+    { }
+
+    [[nodiscard]] const char* name() const noexcept override { return _name.c_str(); }
+    [[nodiscard]] const char* usage() const noexcept override { return ""; }
+    [[nodiscard]] const char* info() const noexcept override { return ""; }
+
+    [[nodiscard]] i32 execute(const char* const name, const char* argv[], const u32 argCount, Console::Controller*) noexcept override
+    {
+        commandName = name;
+        args.assign(argv, argv + argCount);
+        ++runCount;
+        return 0;
+    }
+};
+
+static bool argsEqual(const RecordCommand& command, const ::std::vector<::std::string>& expected) noexcept
+{ return command.args == expected; }
+
+TAU_TEST(Console, tokenizeSeparators)
+{
+    Console::Controller controller(SilentPrint, nullptr);
+    RecordCommand* const command = new RecordCommand("rec");
+    controller.addCommand(command);
+
+    TAU_EXPECT_EQ(controller.runCommand("rec  a\tb   c\r"), 0);
+    TAU_EXPECT(command->commandName == "rec");
+    TAU_EXPECT(argsEqual(*command, { "a", "b", "c" }));
+
+    TAU_EXPECT_EQ(controller.runCommand("   rec"), 0);
+    TAU_EXPECT(command->args.empty());
+}
+
+TAU_TEST(Console, tokenizeQuotes)
+{
+    Console::Controller controller(SilentPrint, nullptr);
+    RecordCommand* const command = new RecordCommand("rec");
+    controller.addCommand(command);
+
+    TAU_EXPECT_EQ(controller.runCommand(R"(rec "hello world" "say \"hi\"" "back\\slash" "" "a\b" x)"), 0);
+    TAU_EXPECT(argsEqual(*command, { "hello world", "say \"hi\"", "back\\slash", "", "a\\b", "x" }));
+
+    // A quote without its closing quote runs to the end of the line.
+    TAU_EXPECT_EQ(controller.runCommand("rec \"open end"), 0);
+    TAU_EXPECT(argsEqual(*command, { "open end" }));
+
+    // The command name itself can be quoted.
+    TAU_EXPECT_EQ(controller.runCommand("\"rec\" a"), 0);
+    TAU_EXPECT(argsEqual(*command, { "a" }));
+}
+
+TAU_TEST(Console, tokenLimit)
+{
+    Console::Controller controller(SilentPrint, nullptr);
+    RecordCommand* const command = new RecordCommand("rec");
+    controller.addCommand(command);
+
+    ::std::string line = "rec";
+    for(u32 i = 1; i < Console::Controller::MaxTokens; ++i)
+    { line += " a"; }
+
+    TAU_EXPECT_EQ(controller.runCommand(line.c_str()), 0);
+    TAU_EXPECT_EQ(command->args.size(), static_cast<uSys>(Console::Controller::MaxTokens - 1));
+
+    line += " a";
+    TAU_EXPECT_EQ(controller.runCommand(line.c_str()), -1);
+    TAU_EXPECT_EQ(command->runCount, static_cast<uSys>(1));
+}
+
+/**
+ * Lines too long for the stack buffer are copied to the heap.
+ */
+TAU_TEST(Console, longLine)
+{
+    Console::Controller controller(SilentPrint, nullptr);
+    RecordCommand* const command = new RecordCommand("rec");
+    controller.addCommand(command);
+
+    const ::std::string longArg(VLA_MAX_LEN, 'x');
+    const ::std::string line = "rec " + longArg + " \"quoted " + longArg + "\"";
+
+    TAU_EXPECT_EQ(controller.runCommand(line.c_str()), 0);
+    TAU_EXPECT(argsEqual(*command, { longArg, "quoted " + longArg }));
+
+    const ::std::string script = "# comment\n" + line + "\n";
+    TAU_EXPECT_EQ(controller.runScript(script.data(), script.size()), 0u);
+    TAU_EXPECT_EQ(command->runCount, static_cast<uSys>(2));
+}
+
+TAU_TEST(Console, commandTable)
+{
+    static constexpr u32 CommandCount = 200;
+
+    Console::Controller controller(SilentPrint, nullptr);
+    TAU_EXPECT(!controller.findCommand("cmd0"));
+
+    ::std::vector<RecordCommand*> commands;
+    for(u32 i = 0; i < CommandCount; ++i)
+    {
+        commands.push_back(new RecordCommand(("cmd" + ::std::to_string(i)).c_str()));
+        controller.addCommand(commands.back());
+    }
+
+    // Every lookup still resolves after the table has grown several times.
+    for(u32 i = 0; i < CommandCount; ++i)
+    {
+        const ::std::string name = "cmd" + ::std::to_string(i);
+        TAU_EXPECT(controller.findCommand(name.c_str()) == commands[i]);
+        TAU_EXPECT_EQ(controller.runCommand(name.c_str()), 0);
+        TAU_EXPECT_EQ(commands[i]->runCount, static_cast<uSys>(1));
+    }
+
+    TAU_EXPECT(!controller.findCommand("cmd"));
+    TAU_EXPECT(!controller.findCommand("cmd200"));
+    TAU_EXPECT(!controller.findCommand(""));
+    TAU_EXPECT_EQ(controller.runCommand("cmd200"), NO_COMMAND_FOUND);
+    TAU_EXPECT_EQ(controller.runCommand(""), NO_COMMAND_FOUND);
+    TAU_EXPECT_EQ(controller.runCommand("  \t "), NO_COMMAND_FOUND);
+
+    TAU_EXPECT(controller.addAlias("cmd7", "seven"));
+    TAU_EXPECT(controller.findCommand("seven") == commands[7]);
+    TAU_EXPECT(!controller.addAlias("missing", "alias"));
+    TAU_EXPECT(!controller.findCommand("alias"));
+
+    // The alias and the replaced command are each deleted once when the controller is destroyed.
+    RecordCommand* const replacement = new RecordCommand("cmd3");
+    controller.addCommand(replacement);
+    TAU_EXPECT(controller.findCommand("cmd3") == replacement);
+    TAU_EXPECT(controller.findCommand("cmd4") == commands[4]);
+}
+
+TAU_TEST(Console, parseFloat)
+{
+    Console::ParseIntError error;
+
+    TAU_EXPECT_EQ(Console::Controller::parseF32("1.5", &error), 1.5f);
+    TAU_EXPECT(error == Console::ParseIntError::None);
+    TAU_EXPECT_EQ(Console::Controller::parseF32("-2.5e3", &error), -2500.0f);
+    TAU_EXPECT(error == Console::ParseIntError::None);
+    TAU_EXPECT_EQ(Console::Controller::parseF64("0.25", &error), 0.25);
+    TAU_EXPECT(error == Console::ParseIntError::None);
+
+    (void) Console::Controller::parseF32("", &error);
+    TAU_EXPECT(error == Console::ParseIntError::ZeroLengthStr);
+    (void) Console::Controller::parseF32("abc", &error);
+    TAU_EXPECT(error == Console::ParseIntError::InvalidCharacter);
+    (void) Console::Controller::parseF32("1.5x", &error);
+    TAU_EXPECT(error == Console::ParseIntError::InvalidCharacter);
+    (void) Console::Controller::parseF64("", &error);
+    TAU_EXPECT(error == Console::ParseIntError::ZeroLengthStr);
+    (void) Console::Controller::parseF64("2..0", &error);
+    TAU_EXPECT(error == Console::ParseIntError::InvalidCharacter);
+}
+
+TAU_TEST(CVar, parse)
+{
+    Console::CVar<f32> f("f", "", 1.0f);
+    Console::CVar<i32> i("i", "", 0);
+    Console::CVar<u32> u("u", "", 7);
+    Console::CVar<bool> b("b", "", false);
+    Console::Controller controller(SilentPrint, nullptr);
+    controller.addCVar(&f);
+    controller.addCVar(&i);
+    controller.addCVar(&u);
+    controller.addCVar(&b);
+
+    TAU_EXPECT_EQ(controller.runCommand("f 2.5"), 0);
+    TAU_EXPECT_EQ(f.get(), 2.5f);
+    TAU_EXPECT_NEQ(controller.runCommand("f abc"), 0);
+    TAU_EXPECT_NEQ(controller.runCommand("f 3.5x"), 0);
+    TAU_EXPECT_NEQ(controller.runCommand("f \"\""), 0);
+    TAU_EXPECT_EQ(f.get(), 2.5f);
+
+    TAU_EXPECT_EQ(controller.runCommand("i -5"), 0);
+    TAU_EXPECT_EQ(i.get(), -5);
+    TAU_EXPECT_NEQ(controller.runCommand("i 1.5"), 0);
+    TAU_EXPECT_EQ(i.get(), -5);
+
+    TAU_EXPECT_NEQ(controller.runCommand("u -1"), 0);
+    TAU_EXPECT_EQ(u.get(), 7u);
+
+    TAU_EXPECT_EQ(controller.runCommand("b yes"), 0);
+    TAU_EXPECT(b.get());
+    TAU_EXPECT_NEQ(controller.runCommand("b maybe"), 0);
+    TAU_EXPECT(b.get());
+
+    // No arguments prints the value, two is a usage error.
+    TAU_EXPECT_EQ(controller.runCommand("f"), 0);
+    TAU_EXPECT_NEQ(controller.runCommand("f 1 2"), 0);
+    TAU_EXPECT_EQ(f.get(), 2.5f);
+}
+
+static void countChange(Console::CVarBase&, void* const userParam) noexcept
+{ ++*static_cast<u32*>(userParam); }
+
+TAU_TEST(CVar, flushChanges)
+{
+    u32 changes = 0;
+    Console::CVar<i32> cvar("cvar", "", 0, countChange, &changes);
+    Console::Controller controller(SilentPrint, nullptr);
+    controller.addCVar(&cvar);
+
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(changes, 0u);
+
+    // Setting the current value isn't a change.
+    cvar = 0;
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(changes, 0u);
+
+    // Any number of sets between flushes is one callback.
+    cvar = 1;
+    cvar = 2;
+    TAU_EXPECT_EQ(controller.runCommand("cvar 3"), 0);
+    TAU_EXPECT_EQ(changes, 0u);
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(changes, 1u);
+    TAU_EXPECT_EQ(cvar.get(), 3);
+
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(changes, 1u);
+
+    cvar = 4;
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(changes, 2u);
+}
+
+/**
+ * A cvar set from its own callback is queued for the next flush, not run again in this one.
+ */
+TAU_TEST(CVar, setFromCallback)
+{
+    struct Bounce final
+    {
+        Console::CVar<u32>* cvar;
+        u32 calls;
+    };
+
+    Bounce bounce { nullptr, 0 };
+    Console::CVar<u32> cvar("cvar", "", 0, [](Console::CVarBase&, void* const userParam)
+    {
+        Bounce* const b = static_cast<Bounce*>(userParam);
+        ++b->calls;
+        if(b->cvar->get() < 3)
+        { b->cvar->set(b->cvar->get() + 1); }
+    }, &bounce);
+    bounce.cvar = &cvar;
+
+    Console::Controller controller(SilentPrint, nullptr);
+    controller.addCVar(&cvar);
+
+    cvar = 1;
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(bounce.calls, 1u);
+    TAU_EXPECT_EQ(cvar.get(), 2u);
+
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(bounce.calls, 2u);
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(bounce.calls, 3u);
+    TAU_EXPECT_EQ(cvar.get(), 3u);
+
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(bounce.calls, 3u);
+}
+
+TAU_TEST(CVar, setBeforeRegistering)
+{
+    u32 changes = 0;
+    Console::CVar<f32> cvar("cvar", "", 0.0f, countChange, &changes);
+    cvar = 1.0f;
+
+    Console::Controller controller(SilentPrint, nullptr);
+    controller.addCVar(&cvar);
+    controller.flushCVarChanges();
+    TAU_EXPECT_EQ(changes, 1u);
+}
+
+TAU_TEST(CVar, concurrentSets)
+{
+    static constexpr u32 CVarCount = 16;
+    static constexpr u32 ThreadCount = 4;
+
+    u32 changes[CVarCount] = { };
+    char names[CVarCount][16];
+    ::std::vector<Console::CVar<u32>*> cvars;
+    Console::Controller controller(SilentPrint, nullptr);
+    for(u32 i = 0; i < CVarCount; ++i)
+    {
+        (void) ::std::snprintf(names[i], sizeof(names[i]), "cvar%u", i);
+        cvars.push_back(new Console::CVar<u32>(names[i], "", 0, countChange, &changes[i]));
+        controller.addCVar(cvars.back());
+    }
+
+    ::std::thread threads[ThreadCount];
+    for(u32 t = 0; t < ThreadCount; ++t)
+    {
+        threads[t] = ::std::thread([&cvars, t]()
+        {
+            for(u32 i = 0; i < 1000; ++i)
+            { cvars[i % CVarCount]->set(t * 1000 + i + 1); }
+        });
+    }
+
+    for(::std::thread& thread : threads)
+    { thread.join(); }
+
+    controller.flushCVarChanges();
+    for(u32 i = 0; i < CVarCount; ++i)
+    { TAU_EXPECT_EQ(changes[i], 1u); }
+
+    controller.flushCVarChanges();
+    for(u32 i = 0; i < CVarCount; ++i)
+    {
+        TAU_EXPECT_EQ(changes[i], 1u);
+        delete cvars[i];
+    }
+}
+
+TAU_TEST(Console, runScript)
+{
+    Console::CVar<f32> scale("scale", "", 1.0f);
+    Console::CVar<u32> count("count", "", 0);
+    Console::Controller controller(SilentPrint, nullptr);
+    controller.addCVar(&scale);
+    controller.addCVar(&count);
+    RecordCommand* const command = new RecordCommand("rec");
+    controller.addCommand(command);
+
+    static constexpr char Script[] =
+        "# A comment\n"
+        "// Another comment\n"
+        "\n"
+        "   \t\n"
+        "scale 2.5\r\n"
+        "  count 4\n"
+        "count abc\n"
+        "unknown 1\n"
+        "\trec \"a b\" c\n"
+        "# scale 9\n"
+        "scale 3";
+
+    TAU_EXPECT_EQ(controller.runScript(Script, sizeof(Script) - 1), 2u);
+    TAU_EXPECT_EQ(scale.get(), 3.0f);
+    TAU_EXPECT_EQ(count.get(), 4u);
+    TAU_EXPECT_EQ(command->runCount, static_cast<uSys>(1));
+    TAU_EXPECT(argsEqual(*command, { "a b", "c" }));
+
+    // Only the given length is run.
+    TAU_EXPECT_EQ(controller.runScript("scale 4\nscale 5\n", 8), 0u);
+    TAU_EXPECT_EQ(scale.get(), 4.0f);
+
+    TAU_EXPECT_EQ(controller.runScript("", 0), 0u);
+}
+
+namespace ConsoleTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <ArrayList.hpp>
+#include <ds/AVLTree.hpp>
+#include <SkylinePacker2D.hpp>
+#include <vector>
+
+static constexpr uSys LookupCount = 65536;
+
+TAU_BENCHMARK(ArrayList, add)
+{
+    ArrayList<u32> list(state.iterations());
+    for(const uSys i : state)
+    { list.add(static_cast<u32>(i)); }
+    Benchmarks::doNotOptimize(list.arr());
+}
+
+TAU_BENCHMARK(ArrayList, iterate4096)
+{
+    ArrayList<u32> list(4096);
+    for(u32 i = 0; i < 4096; ++i)
+    { list.add(i); }
+
+    for(const uSys i : state)
+    {
+        u32 sum = 0;
+        for(const u32 value : list)
+        { sum += value; }
+        Benchmarks::doNotOptimize(sum);
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(ArrayList, removeFast)
+{
+    ArrayList<u32> list(state.iterations());
+    for(uSys i = 0; i < state.iterations(); ++i)
+    { list.add(static_cast<u32>(i)); }
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    { list.removeFast(nextRandom(random) % (state.iterations() - i)); }
+}
+
+TAU_BENCHMARK(AVLTree, insert)
+{
+    FastAVLTree<u32> tree;
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        (void) tree.insert(nextRandom(random));
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(AVLTree, find)
+{
+    FastAVLTree<u32> tree;
+    ::std::vector<u32> keys(LookupCount);
+
+    u32 random = 0x9E3779B9;
+    for(u32& key : keys)
+    {
+        key = nextRandom(random);
+        (void) tree.insert(key);
+    }
+
+    for(const uSys i : state)
+    { Benchmarks::doNotOptimize(tree.find(keys[(i * 2654435761u) & (LookupCount - 1)])); }
+}
+
+TAU_BENCHMARK(SkylinePacker2D, insert)
+{
+    SkylinePacker2D<u32, u16> packer(4096, 4096, 4);
+
+    u32 random = 0x9E3779B9;
+    for(const uSys i : state)
+    {
+        const u16 width = static_cast<u16>(nextRandom(random) % 28 + 4);
+        const u16 height = static_cast<u16>(nextRandom(random) % 28 + 4);
+        if(!packer.insert(static_cast<u32>(i), width, height))
+        { packer.clear(); }
+    }
+}
@@ -0,0 +1,130 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <renderer/CullingBVH.hpp>
+#include <maths/Frustum.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+static constexpr u32 ObjectCount = 100000;
+static constexpr u32 Frames = 16;
+static constexpr float SceneSize = 2000.0f;
+
+static float randomFloat(u32& random, const float min, const float max) noexcept
+{ return min + (max - min) * static_cast<float>(nextRandom(random) & 0xFFFFFF) / static_cast<float>(0xFFFFFF); }
+
+/**
+ *   100,000 objects spread over a flat scene, seen from its
+ * center by a camera that turns a full circle over 16 frames.
+ */
+class CullingScene final
+{
+    DEFAULT_DESTRUCT(CullingScene);
+    DELETE_CM(CullingScene);
+public:
+    ::std::vector<BoundingBox> boxes;
+    ::std::vector<CullingBVH::Proxy> proxies;
+    ::std::vector<Frustum> frustums;
+    CullingBVH bvh;
+    u32 random;
+public:
+    CullingScene() noexcept
+        : random(0x7A0)
+    {
+        boxes.reserve(ObjectCount);
+        proxies.reserve(ObjectCount);
+        for(u32 i = 0; i < ObjectCount; ++i)
+        {
+            const Vector3f center(randomFloat(random, -SceneSize * 0.5f, SceneSize * 0.5f), randomFloat(random, -SceneSize * 0.05f, SceneSize * 0.05f), randomFloat(random, -SceneSize * 0.5f, SceneSize * 0.5f));
+            const Vector3f extent(randomFloat(random, 0.5f, 4.0f), randomFloat(random, 0.5f, 4.0f), randomFloat(random, 0.5f, 4.0f));
+            boxes.emplace_back(center, extent);
+            proxies.push_back(bvh.insert(boxes.back(), i));
+        }
+        bvh.maintain();
+
+        const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1920.0f / 1080.0f, 0.1f, SceneSize * 0.5f);
+        for(u32 frame = 0; frame < Frames; ++frame)
+        {
+            const float angle = static_cast<float>(frame) * (6.2831853f / Frames);
+            const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(::std::cos(angle), 0.0f, ::std::sin(angle)), glm::vec3(0.0f, 1.0f, 0.0f));
+            frustums.emplace_back(projection * view);
+        }
+    }
+};
+
+static u32 workerCount() noexcept
+{ return ::std::thread::hardware_concurrency() ? ::std::thread::hardware_concurrency() : 1; }
+
+/**
+ * Testing every object against the frustum, one frame per iteration.
+ */
+TAU_BENCHMARK(Culling, bruteForce)
+{
+    CullingScene scene;
+
+    for(const uSys i : state)
+    {
+        const Frustum& frustum = scene.frustums[i % Frames];
+        uSys visible = 0;
+        for(const BoundingBox& box : scene.boxes)
+        { visible += frustum.intersects(box); }
+        Benchmarks::doNotOptimize(visible);
+    }
+}
+
+TAU_BENCHMARK(Culling, bvh)
+{
+    CullingScene scene;
+    ::std::vector<u32> visible;
+
+    for(const uSys i : state)
+    {
+        scene.bvh.cull(scene.frustums[i % Frames], visible, 1);
+        Benchmarks::doNotOptimize(visible.data());
+    }
+}
+
+TAU_BENCHMARK(Culling, bvhParallel)
+{
+    CullingScene scene;
+    ::std::vector<u32> visible;
+    const u32 workers = workerCount();
+
+    for(const uSys i : state)
+    {
+        scene.bvh.cull(scene.frustums[i % Frames], visible, workers);
+        Benchmarks::doNotOptimize(visible.data());
+    }
+}
+
+TAU_BENCHMARK(Culling, build)
+{
+    CullingScene scene;
+
+    for(const uSys i : state)
+    {
+        scene.bvh.rebuild();
+        (void) i;
+    }
+}
+
+/**
+ *   A tenth of the objects move every frame, each iteration
+ * updates them then refits and rebuilds degraded treelets.
+ */
+TAU_BENCHMARK(Culling, moveAndMaintain)
+{
+    CullingScene scene;
+
+    for(const uSys i : state)
+    {
+        for(uSys j = i % 10; j < ObjectCount; j += 10)
+        {
+            BoundingBox& box = scene.boxes[j];
+            box.center = Vector3f(box.center.x() + randomFloat(scene.random, -2.0f, 2.0f), box.center.y(), box.center.z() + randomFloat(scene.random, -2.0f, 2.0f));
+            scene.bvh.update(scene.proxies[j], box);
+        }
+        scene.bvh.maintain();
+    }
+}
@@ -0,0 +1,277 @@
+#include "UnitTest.hpp"
+#include "CullingTest.hpp"
+#include "TestRandom.hpp"
+#include <renderer/CullingBVH.hpp>
+#include <maths/Frustum.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static constexpr float SceneSize = 2000.0f;
+static constexpr u32 ObjectCount = 20000;
+
+static bool nearlyEqual(const float a, const float b) noexcept
+{ return ::std::abs(a - b) <= 1.0e-4f * ::std::max(1.0f, ::std::abs(b)); }
+
+static float randomFloat(u32& random, const float min, const float max) noexcept
+{ return min + (max - min) * static_cast<float>(nextRandom(random) & 0xFFFFFF) / static_cast<float>(0xFFFFFF); }
+
+static BoundingBox randomBox(u32& random) noexcept
+{
+    const float x = randomFloat(random, -SceneSize * 0.5f, SceneSize * 0.5f);
+    const float y = randomFloat(random, -SceneSize * 0.05f, SceneSize * 0.05f);
+    const float z = randomFloat(random, -SceneSize * 0.5f, SceneSize * 0.5f);
+    return BoundingBox(Vector3f(x, y, z), Vector3f(randomFloat(random, 0.5f, 4.0f), randomFloat(random, 0.5f, 4.0f), randomFloat(random, 0.5f, 4.0f)));
+}
+
+/**
+ * A camera at the center of the scene looking along the horizon.
+ */
+static Frustum sceneFrustum(const float angle) noexcept
+{
+    const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1920.0f / 1080.0f, 0.1f, SceneSize * 0.5f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(::std::cos(angle), 0.0f, ::std::sin(angle)), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum(projection * view);
+}
+
+/**
+ * The user ids of every live box inside the frustum, in ascending order.
+ */
+static ::std::vector<u32> bruteForce(const Frustum& frustum, const ::std::vector<BoundingBox>& boxes, const ::std::vector<bool>& live) noexcept
+{
+    ::std::vector<u32> visible;
+    for(u32 i = 0; i < boxes.size(); ++i)
+    {
+        if(live[i] && frustum.intersects(boxes[i]))
+        { visible.push_back(i); }
+    }
+    return visible;
+}
+
+static ::std::vector<u32> sorted(::std::vector<u32> ids) noexcept
+{
+    ::std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/**
+ *   An orthographic frustum looking down -z with the identity
+ * view, so every plane is axis aligned.
+ */
+static Frustum boxFrustum() noexcept
+{ return Frustum(glm::ortho(-10.0f, 10.0f, -5.0f, 5.0f, 1.0f, 100.0f)); }
+
+TAU_TEST(Frustum, planeExtraction)
+{
+    const Frustum frustum = boxFrustum();
+
+    const float expected[Frustum::PLANE_COUNT][4] = {
+        {  1.0f,  0.0f,  0.0f,  10.0f },
+        { -1.0f,  0.0f,  0.0f,  10.0f },
+        {  0.0f,  1.0f,  0.0f,   5.0f },
+        {  0.0f, -1.0f,  0.0f,   5.0f },
+        {  0.0f,  0.0f, -1.0f,  -1.0f },
+        {  0.0f,  0.0f,  1.0f, 100.0f }
+    };
+
+    for(uSys i = 0; i < Frustum::PLANE_COUNT; ++i)
+    {
+        TAU_EXPECT(nearlyEqual(frustum.normalX()[i], expected[i][0]));
+        TAU_EXPECT(nearlyEqual(frustum.normalY()[i], expected[i][1]));
+        TAU_EXPECT(nearlyEqual(frustum.normalZ()[i], expected[i][2]));
+        TAU_EXPECT(nearlyEqual(frustum.distance()[i], expected[i][3]));
+    }
+
+    /**
+     * The padding planes contain everything.
+     */
+    for(uSys i = Frustum::PLANE_COUNT; i < Frustum::PADDED_PLANE_COUNT; ++i)
+    {
+        const BoundingBox far(Vector3f(1.0e6f, -1.0e6f, 1.0e6f), Vector3f(1.0f));
+        const float d = frustum.normalX()[i] * far.center.x() + frustum.normalY()[i] * far.center.y() + frustum.normalZ()[i] * far.center.z() + frustum.distance()[i];
+        TAU_EXPECT(d >= 0.0f);
+    }
+}
+
+TAU_TEST(Frustum, classifyBox)
+{
+    const Frustum frustum = boxFrustum();
+
+    const BoundingBox inside(Vector3f(0.0f, 0.0f, -50.0f), Vector3f(1.0f));
+    const BoundingBox onLeft(Vector3f(-10.0f, 0.0f, -50.0f), Vector3f(1.0f));
+    const BoundingBox onFar(Vector3f(0.0f, 0.0f, -100.0f), Vector3f(1.0f));
+    const BoundingBox left(Vector3f(-20.0f, 0.0f, -50.0f), Vector3f(1.0f));
+    const BoundingBox above(Vector3f(0.0f, 8.0f, -50.0f), Vector3f(1.0f));
+    const BoundingBox behind(Vector3f(0.0f, 0.0f, 10.0f), Vector3f(1.0f));
+    const BoundingBox enclosing(Vector3f(0.0f, 0.0f, -50.0f), Vector3f(1000.0f));
+
+    TAU_EXPECT_EQ(frustum.classify(inside), Frustum::Result::Inside);
+    TAU_EXPECT_EQ(frustum.classify(onLeft), Frustum::Result::Intersecting);
+    TAU_EXPECT_EQ(frustum.classify(onFar), Frustum::Result::Intersecting);
+    TAU_EXPECT_EQ(frustum.classify(enclosing), Frustum::Result::Intersecting);
+    TAU_EXPECT_EQ(frustum.classify(left), Frustum::Result::Outside);
+    TAU_EXPECT_EQ(frustum.classify(above), Frustum::Result::Outside);
+    TAU_EXPECT_EQ(frustum.classify(behind), Frustum::Result::Outside);
+
+    for(const BoundingBox* box : { &inside, &onLeft, &onFar, &enclosing, &left, &above, &behind })
+    {
+        TAU_EXPECT_EQ(frustum.intersects(*box), frustum.classify(*box) != Frustum::Result::Outside);
+        TAU_EXPECT_EQ(frustum.intersects(box->sphere()), frustum.classify(*box) != Frustum::Result::Outside);
+    }
+
+    TAU_EXPECT_EQ(Frustum().classify(enclosing), Frustum::Result::Inside);
+}
+
+TAU_TEST(CullingBVH, insertAndCull)
+{
+    u32 random = 0xC011;
+    ::std::vector<BoundingBox> boxes;
+    for(u32 i = 0; i < ObjectCount; ++i)
+    { boxes.push_back(randomBox(random)); }
+    const ::std::vector<bool> live(ObjectCount, true);
+
+    CullingBVH bvh;
+    for(u32 i = 0; i < ObjectCount; ++i)
+    { (void) bvh.insert(boxes[i], i); }
+
+    TAU_EXPECT_EQ(bvh.size(), ObjectCount);
+    TAU_EXPECT_EQ(bvh.pendingCount(), ObjectCount);
+
+    ::std::vector<u32> visible;
+    const Frustum frustum = sceneFrustum(0.0f);
+
+    /**
+     * Objects that are not in the tree yet are still culled.
+     */
+    bvh.cull(frustum, visible);
+    TAU_EXPECT(sorted(visible) == bruteForce(frustum, boxes, live));
+
+    bvh.maintain();
+    TAU_EXPECT_EQ(bvh.pendingCount(), 0u);
+    TAU_EXPECT(bvh.treeletCount() > 1);
+
+    for(u32 frame = 0; frame < 8; ++frame)
+    {
+        const Frustum rotated = sceneFrustum(static_cast<float>(frame) * 0.785398f);
+        const ::std::vector<u32> expected = bruteForce(rotated, boxes, live);
+
+        bvh.cull(rotated, visible, 1);
+        TAU_EXPECT(!visible.empty());
+        TAU_EXPECT(sorted(visible) == expected);
+
+        ::std::vector<u32> parallel;
+        bvh.cull(rotated, parallel, 4);
+        TAU_EXPECT(parallel == visible);
+    }
+}
+
+TAU_TEST(CullingBVH, remove)
+{
+    u32 random = 0xDE1;
+    ::std::vector<BoundingBox> boxes;
+    for(u32 i = 0; i < ObjectCount; ++i)
+    { boxes.push_back(randomBox(random)); }
+    ::std::vector<bool> live(ObjectCount, true);
+
+    CullingBVH bvh;
+    ::std::vector<CullingBVH::Proxy> proxies;
+    for(u32 i = 0; i < ObjectCount; ++i)
+    { proxies.push_back(bvh.insert(boxes[i], i)); }
+    bvh.maintain();
+
+    const Frustum frustum = sceneFrustum(1.0f);
+    ::std::vector<u32> visible;
+
+    /**
+     *   Removing a tenth keeps the tree, removed objects are left
+     * in place and must never be reported.
+     */
+    for(u32 i = 0; i < ObjectCount; i += 10)
+    {
+        bvh.remove(proxies[i]);
+        live[i] = false;
+    }
+    TAU_EXPECT_EQ(bvh.size(), ObjectCount - ObjectCount / 10);
+
+    bvh.cull(frustum, visible);
+    TAU_EXPECT(sorted(visible) == bruteForce(frustum, boxes, live));
+    bvh.maintain();
+    bvh.cull(frustum, visible);
+    TAU_EXPECT(sorted(visible) == bruteForce(frustum, boxes, live));
+
+    /**
+     * Removing more than a quarter forces a full rebuild.
+     */
+    for(u32 i = 1; i < ObjectCount; i += 3)
+    {
+        if(!live[i])
+        { continue; }
+        bvh.remove(proxies[i]);
+        live[i] = false;
+    }
+    bvh.maintain();
+    bvh.cull(frustum, visible, 4);
+    TAU_EXPECT(sorted(visible) == bruteForce(frustum, boxes, live));
+
+    /**
+     * Proxies of the surviving objects still refer to them after the rebuild.
+     */
+    for(u32 i = 2; i < ObjectCount; i += 3)
+    {
+        if(!live[i])
+        { continue; }
+        boxes[i] = BoundingBox(Vector3f(SceneSize * 4.0f), Vector3f(1.0f));
+        bvh.update(proxies[i], boxes[i]);
+    }
+    bvh.maintain();
+    bvh.cull(frustum, visible);
+    TAU_EXPECT(sorted(visible) == bruteForce(frustum, boxes, live));
+}
+
+TAU_TEST(CullingBVH, refit)
+{
+    u32 random = 0x4EF17;
+    ::std::vector<BoundingBox> boxes;
+    for(u32 i = 0; i < ObjectCount; ++i)
+    { boxes.push_back(randomBox(random)); }
+    const ::std::vector<bool> live(ObjectCount, true);
+
+    CullingBVH bvh;
+    ::std::vector<CullingBVH::Proxy> proxies;
+    for(u32 i = 0; i < ObjectCount; ++i)
+    { proxies.push_back(bvh.insert(boxes[i], i)); }
+    bvh.maintain();
+
+    ::std::vector<u32> visible;
+
+    /**
+     *   A tenth of the objects move every frame, some far enough
+     * to degrade their treelets into being rebuilt.
+     */
+    for(u32 frame = 0; frame < 16; ++frame)
+    {
+        const float step = frame % 4 == 0 ? 200.0f : 2.0f;
+        for(u32 i = frame % 10; i < ObjectCount; i += 10)
+        {
+            boxes[i].center = Vector3f(boxes[i].center.x() + randomFloat(random, -step, step), boxes[i].center.y(), boxes[i].center.z() + randomFloat(random, -step, step));
+            bvh.update(proxies[i], boxes[i]);
+        }
+
+        bvh.maintain();
+
+        const Frustum frustum = sceneFrustum(static_cast<float>(frame) * 0.4f);
+        bvh.cull(frustum, visible, 4);
+        TAU_EXPECT(sorted(visible) == bruteForce(frustum, boxes, live));
+    }
+
+    TAU_EXPECT_EQ(bvh.size(), ObjectCount);
+    TAU_EXPECT_EQ(bvh.pendingCount(), 0u);
+}
+
+namespace CullingTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
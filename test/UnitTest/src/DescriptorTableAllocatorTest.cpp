@@ -0,0 +1,232 @@
+#include "UnitTest.hpp"
+#include "DescriptorTableAllocatorTest.hpp"
+#include "TestRandom.hpp"
+#include <allocator/DescriptorTableAllocator.hpp>
+#include <vector>
+
+TAU_TEST(DescriptorTableAllocator, persistentTest)
+{
+    DescriptorTableAllocator allocator(1024, 0);
+    TAU_EXPECT_EQ(allocator.persistentFree(), 1024u);
+
+    const DescriptorRange a = allocator.allocate(1);
+    const DescriptorRange b = allocator.allocate(3);
+    const DescriptorRange c = allocator.allocate(16);
+
+    TAU_EXPECT(a && b && c);
+    TAU_EXPECT_EQ(b.count, 3u);
+    // Blocks are rounded up to a power of two and aligned to their size.
+    TAU_EXPECT_EQ(b.offset % 4, 0u);
+    TAU_EXPECT_EQ(c.offset % 16, 0u);
+    TAU_EXPECT_EQ(allocator.persistentFree(), 1024u - 1 - 4 - 16);
+
+    TAU_EXPECT(!allocator.allocate(0));
+    TAU_EXPECT(!allocator.allocate(1025));
+    TAU_EXPECT(!allocator.allocate(1024));
+}
+
+TAU_TEST(DescriptorTableAllocator, nonPowerOfTwoTest)
+{
+    // Split into blocks of 512, 256, 128, 64, 32 and 8.
+    DescriptorTableAllocator allocator(1000, 0);
+    TAU_EXPECT_EQ(allocator.persistentFree(), 1000u);
+
+    const DescriptorRange a = allocator.allocate(512);
+    TAU_EXPECT(a);
+    TAU_EXPECT_EQ(a.offset, 0u);
+    TAU_EXPECT(!allocator.allocate(512));
+    TAU_EXPECT(!allocator.allocate(257));
+
+    const DescriptorRange b = allocator.allocate(256);
+    TAU_EXPECT(b);
+    TAU_EXPECT_EQ(b.offset, 512u);
+
+    // Nothing may extend past the end of the region.
+    for(DescriptorRange range = allocator.allocate(8); range; range = allocator.allocate(8))
+    { TAU_EXPECT_LEQ(range.offset + 8, 1000u); }
+    TAU_EXPECT_EQ(allocator.persistentFree(), 0u);
+}
+
+TAU_TEST(DescriptorTableAllocator, deferredFreeTest)
+{
+    DescriptorTableAllocator allocator(1024, 0);
+    TAU_EXPECT(allocator.beginFrame(1, 0));
+
+    ::std::vector<DescriptorRange> ranges;
+    for(DescriptorRange range = allocator.allocate(1); range; range = allocator.allocate(1))
+    { ranges.push_back(range); }
+    TAU_EXPECT_EQ(ranges.size(), 1024u);
+
+    for(const DescriptorRange& range : ranges)
+    { allocator.free(range); }
+
+    // The GPU hasn't finished frame 1 yet.
+    TAU_EXPECT(allocator.beginFrame(2, 0));
+    TAU_EXPECT_EQ(allocator.pendingFrees(), 1024u);
+    TAU_EXPECT_EQ(allocator.persistentFree(), 0u);
+    TAU_EXPECT(!allocator.allocate(1));
+
+    TAU_EXPECT(allocator.beginFrame(3, 1));
+    TAU_EXPECT_EQ(allocator.pendingFrees(), 0u);
+    TAU_EXPECT_EQ(allocator.persistentFree(), 1024u);
+
+    // Every buddy should have been merged back together.
+    const DescriptorRange all = allocator.allocate(1024);
+    TAU_EXPECT(all);
+    TAU_EXPECT_EQ(all.offset, 0u);
+}
+
+TAU_TEST(DescriptorTableAllocator, doubleFreeTest)
+{
+    DescriptorTableAllocator allocator(64, 0);
+    TAU_EXPECT(allocator.beginFrame(1, 0));
+
+    const DescriptorRange a = allocator.allocate(4);
+    allocator.free(a);
+    allocator.free(a);
+
+    TAU_EXPECT(allocator.beginFrame(2, 1));
+    TAU_EXPECT_EQ(allocator.persistentFree(), 64u);
+
+    // Freeing a range that doesn't start a block is ignored.
+    const DescriptorRange b = allocator.allocate(8);
+    allocator.free(DescriptorRange(b.offset + 1, 7));
+    TAU_EXPECT(allocator.beginFrame(3, 2));
+    TAU_EXPECT_EQ(allocator.persistentFree(), 56u);
+
+    // Freeing a block again after it was merged with its buddy is ignored too.
+    DescriptorTableAllocator small(4, 0);
+    TAU_EXPECT(small.beginFrame(1, 0));
+
+    const DescriptorRange c = small.allocate(1);
+    const DescriptorRange d = small.allocate(1);
+    small.free(c);
+    small.free(d);
+    TAU_EXPECT(small.beginFrame(2, 1));
+    TAU_EXPECT_EQ(small.persistentFree(), 4u);
+
+    small.free(d);
+    TAU_EXPECT(small.beginFrame(3, 2));
+    TAU_EXPECT_EQ(small.persistentFree(), 4u);
+
+    TAU_EXPECT(small.allocate(4));
+    TAU_EXPECT(!small.allocate(1));
+}
+
+TAU_TEST(DescriptorTableAllocator, transientTest)
+{
+    DescriptorTableAllocator allocator(16, 100, 2);
+    TAU_EXPECT(allocator.beginFrame(1, 0));
+
+    const DescriptorRange a = allocator.allocateTransient(60);
+    TAU_EXPECT(a);
+    // Transient tables follow the persistent region.
+    TAU_EXPECT_EQ(a.offset, 16u);
+    TAU_EXPECT(!allocator.allocateTransient(50));
+    const DescriptorRange b = allocator.allocateTransient(40);
+    TAU_EXPECT(b);
+    TAU_EXPECT_EQ(b.offset, 76u);
+
+    TAU_EXPECT(allocator.beginFrame(2, 0));
+    TAU_EXPECT(!allocator.allocateTransient(1));
+
+    // Two frames in flight is the limit.
+    TAU_EXPECT(allocator.beginFrame(3, 0));
+    TAU_EXPECT(!allocator.beginFrame(4, 0));
+
+    TAU_EXPECT(allocator.beginFrame(4, 1));
+    TAU_EXPECT_EQ(allocator.transientUsed(), 0u);
+
+    const DescriptorRange c = allocator.allocateTransient(70);
+    TAU_EXPECT(c);
+    TAU_EXPECT_EQ(c.offset, 16u);
+
+    TAU_EXPECT(allocator.beginFrame(5, 4));
+    TAU_EXPECT_EQ(allocator.transientUsed(), 0u);
+
+    // The 30 descriptors left at the end are skipped as the table has to be contiguous.
+    const DescriptorRange d = allocator.allocateTransient(40);
+    TAU_EXPECT(d);
+    TAU_EXPECT_EQ(d.offset, 16u);
+    TAU_EXPECT_EQ(allocator.transientUsed(), 70u);
+}
+
+TAU_TEST(DescriptorTableAllocator, randomTest)
+{
+    static constexpr u32 PersistentCount = 4096;
+    static constexpr u32 TransientCount = 2048;
+    static constexpr u32 FramesInFlight = 3;
+
+    DescriptorTableAllocator allocator(PersistentCount, TransientCount, FramesInFlight);
+
+    // The owner of every descriptor, so that any overlap is caught.
+    ::std::vector<u32> owners(PersistentCount, 0);
+    ::std::vector<DescriptorRange> live;
+    u32 nextOwner = 1;
+    u32 random = 0x12345678;
+    bool overlap = false;
+
+    for(u64 frame = 1; frame <= 256; ++frame)
+    {
+        const u64 completed = frame > FramesInFlight ? frame - FramesInFlight : 0;
+        TAU_EXPECT(allocator.beginFrame(frame, completed));
+
+        for(u32 i = 0; i < 64; ++i)
+        {
+            if(!live.empty() && nextRandom(random) % 2)
+            {
+                const uSys index = nextRandom(random) % live.size();
+                const DescriptorRange range = live[index];
+                live[index] = live.back();
+                live.pop_back();
+
+                for(u32 j = 0; j < range.count; ++j)
+                { owners[range.offset + j] = 0; }
+                allocator.free(range);
+            }
+            else
+            {
+                const DescriptorRange range = allocator.allocate(1 + nextRandom(random) % 24);
+                if(!range)
+                { continue; }
+
+                TAU_EXPECT_LEQ(range.offset + range.count, PersistentCount);
+                for(u32 j = 0; j < range.count; ++j)
+                {
+                    overlap = overlap || owners[range.offset + j];
+                    owners[range.offset + j] = nextOwner;
+                }
+                ++nextOwner;
+                live.push_back(range);
+            }
+        }
+
+        u32 transientUsed = 0;
+        for(DescriptorRange range = allocator.allocateTransient(1 + nextRandom(random) % 64); range; range = allocator.allocateTransient(1 + nextRandom(random) % 64))
+        {
+            TAU_EXPECT_GEQ(range.offset, PersistentCount);
+            TAU_EXPECT_LEQ(range.offset + range.count, PersistentCount + TransientCount);
+            transientUsed += range.count;
+            if(transientUsed > TransientCount / FramesInFlight)
+            { break; }
+        }
+    }
+
+    TAU_EXPECT(!overlap);
+
+    for(const DescriptorRange& range : live)
+    { allocator.free(range); }
+
+    TAU_EXPECT(allocator.beginFrame(257, 256));
+    TAU_EXPECT_EQ(allocator.pendingFrees(), 0u);
+    TAU_EXPECT_EQ(allocator.persistentFree(), PersistentCount);
+    TAU_EXPECT_EQ(allocator.transientUsed(), 0u);
+    TAU_EXPECT(allocator.allocate(PersistentCount));
+}
+
+namespace DescriptorTableAllocatorTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
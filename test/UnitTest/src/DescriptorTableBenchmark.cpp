@@ -0,0 +1,84 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <allocator/DescriptorTableAllocator.hpp>
+#include <vector>
+
+static constexpr u32 OpsPerFrame = 100000;
+static constexpr u32 FramesInFlight = 3;
+static constexpr u32 PersistentCount = 1 << 21;
+static constexpr u32 TransientCount = 1 << 20;
+
+/**
+ *   Every iteration is a frame, with the GPU treated as being
+ * `FramesInFlight - 1` frames behind. Sizes of 1 to 4 descriptors
+ * are generated up front so that only the allocator is timed.
+ */
+class DescriptorFrames final
+{
+    DEFAULT_DESTRUCT(DescriptorFrames);
+    DELETE_CM(DescriptorFrames);
+public:
+    DescriptorTableAllocator allocator;
+    ::std::vector<DescriptorRange> live;
+    ::std::vector<u32> sizes;
+    u64 frame;
+public:
+    DescriptorFrames() noexcept
+        : allocator(PersistentCount, TransientCount, FramesInFlight)
+        , sizes(OpsPerFrame)
+        , frame(0)
+    {
+        live.reserve(OpsPerFrame);
+
+        u32 random = 0x9E3779B9;
+        for(u32& size : sizes)
+        { size = 1 + nextRandom(random) % 4; }
+    }
+
+    void beginFrame() noexcept
+    {
+        ++frame;
+        const u64 completed = frame >= FramesInFlight ? frame - (FramesInFlight - 1) : 0;
+        (void) allocator.beginFrame(frame, completed);
+    }
+};
+
+/**
+ *   Frees every persistent table allocated the frame before and
+ * allocates as many new ones.
+ */
+TAU_BENCHMARK(DescriptorTable, persistentFrame)
+{
+    DescriptorFrames frames;
+
+    for(const uSys i : state)
+    {
+        frames.beginFrame();
+
+        for(const DescriptorRange& range : frames.live)
+        { frames.allocator.free(range); }
+        frames.live.clear();
+
+        for(const u32 size : frames.sizes)
+        {
+            const DescriptorRange range = frames.allocator.allocate(size);
+            if(range)
+            { frames.live.push_back(range); }
+        }
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(DescriptorTable, transientFrame)
+{
+    DescriptorFrames frames;
+
+    for(const uSys i : state)
+    {
+        frames.beginFrame();
+
+        for(const u32 size : frames.sizes)
+        { Benchmarks::doNotOptimize(frames.allocator.allocateTransient(size)); }
+        (void) i;
+    }
+}
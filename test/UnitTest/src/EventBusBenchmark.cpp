@@ -0,0 +1,247 @@
+#include "Benchmark.hpp"
+#include <events/EventBus.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr u32 Sources = 3;
+static constexpr u32 LayerCount = 50;
+/**
+ * A frame of 1M events/s at 60Hz.
+ */
+static constexpr u32 FrameEvents = 1000000 / 60;
+
+/**
+ * An event posted by one of the input, loader or network threads.
+ */
+template<u32 _Source>
+class SourceEvent final : public Event
+{
+    DEFAULT_DESTRUCT(SourceEvent);
+private:
+    u32 _value;
+public:
+    SourceEvent(const u32 value) noexcept
+        : _value(value)
+    { }
+
+    [[nodiscard]] u32 value() const noexcept { return _value; }
+
+    EVENT_IMPL(SourceEvent);
+};
+
+/**
+ * Listens to the events of a single source, like most layers do.
+ */
+class SourceLayer final
+{
+private:
+    u32 _source;
+    u64 _sum;
+public:
+    SourceLayer(const u32 source) noexcept
+        : _source(source)
+        , _sum(0)
+    { }
+
+    [[nodiscard]] u32 source() const noexcept { return _source; }
+    [[nodiscard]] u64 sum() const noexcept { return _sum; }
+
+    void onEvent(Event& e) noexcept
+    {
+        EventDispatcher dispatcher(e);
+        switch(_source)
+        {
+            case 0: dispatcher.dispatch<SourceEvent<0>>(this, &SourceLayer::onSource<0>); break;
+            case 1: dispatcher.dispatch<SourceEvent<1>>(this, &SourceLayer::onSource<1>); break;
+            default: dispatcher.dispatch<SourceEvent<2>>(this, &SourceLayer::onSource<2>); break;
+        }
+    }
+
+    template<u32 _Source>
+    bool onSource(SourceEvent<_Source>& e) noexcept
+    {
+        _sum += e.value();
+        return false;
+    }
+};
+
+/**
+ *   50 layers, each listening to one of 3 sources, reached either
+ * through a locked queue of heap events dispatched through every
+ * layer, or through an EventBus.
+ */
+class EventLayers final
+{
+    DEFAULT_DESTRUCT(EventLayers);
+    DELETE_CM(EventLayers);
+public:
+    ::std::vector<SourceLayer> layers;
+    EventBus bus;
+    ::std::mutex mutex;
+    ::std::vector<Event*> queue;
+    ::std::vector<Event*> pending;
+public:
+    EventLayers() noexcept
+    {
+        layers.reserve(LayerCount);
+        for(u32 i = 0; i < LayerCount; ++i)
+        { layers.emplace_back(i % Sources); }
+
+        for(SourceLayer& layer : layers)
+        {
+            switch(layer.source())
+            {
+                case 0: bus.subscribe<SourceEvent<0>, &SourceLayer::onSource<0>>(&layer); break;
+                case 1: bus.subscribe<SourceEvent<1>, &SourceLayer::onSource<1>>(&layer); break;
+                default: bus.subscribe<SourceEvent<2>, &SourceLayer::onSource<2>>(&layer); break;
+            }
+        }
+    }
+
+    void postLocked(const u32 source, const u32 value) noexcept
+    {
+        Event* e;
+        switch(source)
+        {
+            case 0: e = new(::std::nothrow) SourceEvent<0>(value); break;
+            case 1: e = new(::std::nothrow) SourceEvent<1>(value); break;
+            default: e = new(::std::nothrow) SourceEvent<2>(value); break;
+        }
+        ::std::lock_guard<::std::mutex> lock(mutex);
+        queue.push_back(e);
+    }
+
+    uSys dispatchLocked() noexcept
+    {
+        {
+            ::std::lock_guard<::std::mutex> lock(mutex);
+            pending.swap(queue);
+        }
+        const uSys count = pending.size();
+        for(Event* const e : pending)
+        {
+            for(SourceLayer& layer : layers)
+            { layer.onEvent(*e); }
+            delete e;
+        }
+        pending.clear();
+        return count;
+    }
+
+    void postBus(const u32 source, const u32 value) noexcept
+    {
+        switch(source)
+        {
+            case 0: (void) bus.post<SourceEvent<0>>(value); break;
+            case 1: (void) bus.post<SourceEvent<1>>(value); break;
+            default: (void) bus.post<SourceEvent<2>>(value); break;
+        }
+    }
+
+    [[nodiscard]] u64 checksum() const noexcept
+    {
+        u64 sum = 0;
+        for(const SourceLayer& layer : layers)
+        { sum += layer.sum(); }
+        return sum;
+    }
+};
+
+/**
+ *   Runs one producer thread per source, each posting its share
+ * of a frame with `post`, while `consume` is called on this
+ * thread until it returns 0 after every producer finished.
+ */
+template<typename _Post, typename _Consume>
+static void runProducers(const _Post& post, const _Consume& consume) noexcept
+{
+    ::std::atomic<u32> finished(0);
+    ::std::thread producers[Sources];
+
+    for(u32 source = 0; source < Sources; ++source)
+    {
+        producers[source] = ::std::thread([&, source]()
+        {
+            for(u32 i = 0; i < FrameEvents / Sources; ++i)
+            { post(source, i); }
+            finished.fetch_add(1, ::std::memory_order_release);
+        });
+    }
+
+    while(true)
+    {
+        const bool done = finished.load(::std::memory_order_acquire) == Sources;
+        if(consume() == 0 && done)
+        { break; }
+    }
+
+    for(::std::thread& producer : producers)
+    { producer.join(); }
+}
+
+/**
+ * A frame of events posted ahead of time and then dispatched through every layer.
+ */
+TAU_BENCHMARK(EventBus, lockedQueueFrame)
+{
+    EventLayers events;
+
+    for(const uSys i : state)
+    {
+        for(u32 j = 0; j < FrameEvents; ++j)
+        { events.postLocked(j % Sources, j); }
+        Benchmarks::doNotOptimize(events.dispatchLocked());
+        (void) i;
+    }
+
+    Benchmarks::doNotOptimize(events.checksum());
+}
+
+TAU_BENCHMARK(EventBus, busFrame)
+{
+    EventLayers events;
+
+    for(const uSys i : state)
+    {
+        for(u32 j = 0; j < FrameEvents; ++j)
+        { events.postBus(j % Sources, j); }
+        Benchmarks::doNotOptimize(events.bus.dispatch());
+        (void) i;
+    }
+
+    Benchmarks::doNotOptimize(events.checksum());
+}
+
+/**
+ *   A frame of events posted from 3 threads while this one
+ * dispatches, thread creation included.
+ */
+TAU_BENCHMARK(EventBus, lockedQueueThreads)
+{
+    EventLayers events;
+
+    for(const uSys i : state)
+    {
+        runProducers([&](const u32 source, const u32 value) { events.postLocked(source, value); },
+                     [&]() { return events.dispatchLocked(); });
+        (void) i;
+    }
+
+    Benchmarks::doNotOptimize(events.checksum());
+}
+
+TAU_BENCHMARK(EventBus, busThreads)
+{
+    EventLayers events;
+
+    for(const uSys i : state)
+    {
+        runProducers([&](const u32 source, const u32 value) { events.postBus(source, value); },
+                     [&]() { return events.bus.dispatch(); });
+        (void) i;
+    }
+
+    Benchmarks::doNotOptimize(events.checksum());
+}
@@ -0,0 +1,366 @@
+#include "UnitTest.hpp"
+#include "EventBusTest.hpp"
+#include <events/EventBus.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+template<u32 _Id>
+class ValueEvent final : public Event
+{
+    DEFAULT_DESTRUCT(ValueEvent);
+private:
+    u32 _value;
+public:
+    ValueEvent(const u32 value) noexcept
+        : _value(value)
+    { }
+
+    [[nodiscard]] u32 value() const noexcept { return _value; }
+
+    EVENT_IMPL(ValueEvent);
+};
+
+class KeyEvent final : public Event
+{
+    DEFAULT_DESTRUCT(KeyEvent);
+private:
+    u32 _key;
+public:
+    KeyEvent(const u32 key) noexcept
+        : _key(key)
+    { }
+
+    [[nodiscard]] u32 key() const noexcept { return _key; }
+
+    EVENT_IMPL(KeyEvent);
+    EVENT_INTERCEPTABLE(true);
+};
+
+/**
+ * Counts its destructions and fills a payload large enough to outgrow a chunk quickly.
+ */
+class LargeEvent final : public Event
+{
+public:
+    static u32 destroyed;
+private:
+    u8 _payload[1000];
+public:
+    LargeEvent(const u8 fill) noexcept
+    { ::std::memset(_payload, fill, sizeof(_payload)); }
+
+    ~LargeEvent() noexcept override
+    { ++destroyed; }
+
+    [[nodiscard]] bool filledWith(const u8 fill) const noexcept
+    {
+        for(const u8 b : _payload)
+        {
+            if(b != fill)
+            { return false; }
+        }
+        return true;
+    }
+
+    EVENT_IMPL(LargeEvent);
+};
+
+u32 LargeEvent::destroyed = 0;
+
+/**
+ * Records every event it's sent, in the order it received them.
+ */
+class Recorder final
+{
+    DEFAULT_DESTRUCT(Recorder);
+    DELETE_CM(Recorder);
+public:
+    ::std::vector<u32> values;
+    EventBus* forwardTo;
+    bool interceptEven;
+public:
+    Recorder() noexcept
+        : values()
+        , forwardTo(nullptr)
+        , interceptEven(false)
+    { }
+
+    template<u32 _Id>
+    bool onValue(ValueEvent<_Id>& e) noexcept
+    {
+        values.push_back(e.value());
+        if(forwardTo)
+        { (void) forwardTo->post<ValueEvent<_Id + 1>>(e.value()); }
+        return true;
+    }
+
+    bool onKey(KeyEvent& e) noexcept
+    {
+        values.push_back(e.key());
+        return interceptEven && e.key() % 2 == 0;
+    }
+
+    bool onLarge(LargeEvent& e) noexcept
+    {
+        values.push_back(e.filledWith(static_cast<u8>(values.size())));
+        return false;
+    }
+};
+
+TAU_TEST(EventBus, dispatchDelivers)
+{
+    EventBus bus;
+    Recorder recorder;
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&recorder);
+
+    TAU_EXPECT_EQ(bus.dispatch(), 0u);
+
+    for(u32 i = 0; i < 5; ++i)
+    { TAU_EXPECT(bus.post<ValueEvent<0>>(i)); }
+    // Nothing is delivered until dispatch.
+    TAU_EXPECT(recorder.values.empty());
+
+    TAU_EXPECT_EQ(bus.dispatch(), 5u);
+    TAU_EXPECT((recorder.values == ::std::vector<u32> { 0, 1, 2, 3, 4 }));
+
+    TAU_EXPECT_EQ(bus.dispatch(), 0u);
+    TAU_EXPECT_EQ(recorder.values.size(), 5u);
+}
+
+TAU_TEST(EventBus, postFromHandler)
+{
+    EventBus bus;
+    Recorder first;
+    Recorder second;
+    first.forwardTo = &bus;
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&first);
+    bus.subscribe<ValueEvent<1>, &Recorder::onValue<1>>(&second);
+
+    for(u32 i = 0; i < 3; ++i)
+    { (void) bus.post<ValueEvent<0>>(i + 10); }
+
+    // Events posted by handlers go into the other frame.
+    TAU_EXPECT_EQ(bus.dispatch(), 3u);
+    TAU_EXPECT_EQ(first.values.size(), 3u);
+    TAU_EXPECT(second.values.empty());
+
+    TAU_EXPECT_EQ(bus.dispatch(), 3u);
+    TAU_EXPECT((second.values == ::std::vector<u32> { 10, 11, 12 }));
+
+    // Every dispatch after the first also delivers what the previous one forwarded.
+    for(u32 round = 0; round < 4; ++round)
+    {
+        (void) bus.post<ValueEvent<0>>(round);
+        TAU_EXPECT_EQ(bus.dispatch(), round == 0 ? 1u : 2u);
+    }
+    TAU_EXPECT_EQ(bus.dispatch(), 1u);
+    TAU_EXPECT_EQ(bus.dispatch(), 0u);
+    TAU_EXPECT((second.values == ::std::vector<u32> { 10, 11, 12, 0, 1, 2, 3 }));
+}
+
+TAU_TEST(EventBus, perTypeOrdering)
+{
+    EventBus bus;
+    Recorder a;
+    Recorder b;
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&a);
+    bus.subscribe<ValueEvent<1>, &Recorder::onValue<1>>(&b);
+
+    for(u32 i = 0; i < 100; ++i)
+    {
+        if(i % 3 == 0)
+        { (void) bus.post<ValueEvent<1>>(i); }
+        else
+        { (void) bus.post<ValueEvent<0>>(i); }
+    }
+
+    TAU_EXPECT_EQ(bus.dispatch(), 100u);
+    TAU_EXPECT_EQ(a.values.size() + b.values.size(), 100u);
+
+    bool ordered = true;
+    for(uSys i = 1; i < a.values.size(); ++i)
+    { ordered = ordered && a.values[i - 1] < a.values[i] && a.values[i] % 3 != 0; }
+    for(uSys i = 1; i < b.values.size(); ++i)
+    { ordered = ordered && b.values[i - 1] < b.values[i] && b.values[i] % 3 == 0; }
+    TAU_EXPECT(ordered);
+}
+
+/**
+ *   Several threads post two types while this one dispatches,
+ * every event arrives once and each thread's events of a type
+ * arrive in the order they were posted.
+ */
+TAU_TEST(EventBus, concurrentPosting)
+{
+    static constexpr u32 Threads = 4;
+    static constexpr u32 PerThread = 20000;
+
+    EventBus bus;
+    Recorder a;
+    Recorder b;
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&a);
+    bus.subscribe<ValueEvent<1>, &Recorder::onValue<1>>(&b);
+
+    ::std::atomic<u32> finished(0);
+    ::std::atomic<u32> failedPosts(0);
+    ::std::thread producers[Threads];
+    for(u32 t = 0; t < Threads; ++t)
+    {
+        producers[t] = ::std::thread([&, t]()
+        {
+            for(u32 i = 0; i < PerThread; ++i)
+            {
+                const u32 value = (t << 24) | i;
+                const bool posted = i % 2 ? bus.post<ValueEvent<1>>(value) : bus.post<ValueEvent<0>>(value);
+                if(!posted)
+                { failedPosts.fetch_add(1, ::std::memory_order_relaxed); }
+            }
+            finished.fetch_add(1, ::std::memory_order_release);
+        });
+    }
+
+    uSys delivered = 0;
+    while(true)
+    {
+        const bool done = finished.load(::std::memory_order_acquire) == Threads;
+        const uSys count = bus.dispatch();
+        delivered += count;
+        if(count == 0 && done)
+        { break; }
+    }
+
+    for(::std::thread& producer : producers)
+    { producer.join(); }
+
+    TAU_EXPECT_EQ(failedPosts.load(), 0u);
+    TAU_EXPECT_EQ(delivered, static_cast<uSys>(Threads) * PerThread);
+    TAU_EXPECT_EQ(a.values.size() + b.values.size(), static_cast<uSys>(Threads) * PerThread);
+
+    bool ordered = true;
+    for(const Recorder* const recorder : { &a, &b })
+    {
+        i64 last[Threads];
+        for(i64& l : last)
+        { l = -1; }
+
+        for(const u32 value : recorder->values)
+        {
+            const u32 thread = value >> 24;
+            const i64 sequence = value & 0xFFFFFF;
+            ordered = ordered && thread < Threads && sequence > last[thread];
+            if(thread < Threads)
+            { last[thread] = sequence; }
+        }
+    }
+    TAU_EXPECT(ordered);
+}
+
+TAU_TEST(EventBus, interception)
+{
+    EventBus bus;
+    Recorder interceptor;
+    Recorder after;
+    interceptor.interceptEven = true;
+    bus.subscribe<KeyEvent, &Recorder::onKey>(&interceptor);
+    bus.subscribe<KeyEvent, &Recorder::onKey>(&after);
+
+    // The batch handler sees every event, intercepted or not.
+    static ::std::vector<u32> intercepted;
+    intercepted.clear();
+    bus.subscribeBatch(KeyEvent::getStaticType(), [](void*, Event* const* events, const uSys count) noexcept
+    {
+        for(uSys i = 0; i < count; ++i)
+        { intercepted.push_back(events[i]->intercepted()); }
+    }, &intercepted);
+
+    for(u32 i = 0; i < 6; ++i)
+    { (void) bus.post<KeyEvent>(i); }
+    TAU_EXPECT_EQ(bus.dispatch(), 6u);
+
+    TAU_EXPECT((interceptor.values == ::std::vector<u32> { 0, 1, 2, 3, 4, 5 }));
+    TAU_EXPECT((after.values == ::std::vector<u32> { 1, 3, 5 }));
+    TAU_EXPECT((intercepted == ::std::vector<u32> { 1, 0, 1, 0, 1, 0 }));
+
+    // Returning true from the handler of an event that can't be intercepted changes nothing.
+    Recorder first;
+    Recorder second;
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&first);
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&second);
+    (void) bus.post<ValueEvent<0>>(7);
+    (void) bus.post<ValueEvent<0>>(8);
+    TAU_EXPECT_EQ(bus.dispatch(), 2u);
+    TAU_EXPECT((second.values == ::std::vector<u32> { 7, 8 }));
+}
+
+TAU_TEST(EventBus, unsubscribe)
+{
+    EventBus bus;
+    Recorder kept;
+    Recorder removed;
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&kept);
+    bus.subscribe<ValueEvent<0>, &Recorder::onValue<0>>(&removed);
+    bus.subscribe<KeyEvent, &Recorder::onKey>(&removed);
+
+    bus.unsubscribe(&removed);
+
+    (void) bus.post<ValueEvent<0>>(1);
+    (void) bus.post<KeyEvent>(2);
+    TAU_EXPECT_EQ(bus.dispatch(), 2u);
+    TAU_EXPECT_EQ(kept.values.size(), 1u);
+    TAU_EXPECT(removed.values.empty());
+}
+
+TAU_TEST(EventBus, arenaGrowth)
+{
+    static constexpr u32 Count = 3 * EventBus::ChunkSize / sizeof(LargeEvent);
+
+    LargeEvent::destroyed = 0;
+    {
+        EventBus bus;
+        Recorder recorder;
+        bus.subscribe<LargeEvent, &Recorder::onLarge>(&recorder);
+
+        // The second round reuses the single chunk the first one was merged into.
+        for(u32 round = 0; round < 2; ++round)
+        {
+            recorder.values.clear();
+            for(u32 i = 0; i < Count; ++i)
+            { TAU_EXPECT(bus.post<LargeEvent>(static_cast<u8>(i))); }
+
+            TAU_EXPECT_EQ(bus.dispatch(), Count);
+            TAU_EXPECT_EQ(recorder.values.size(), Count);
+            TAU_EXPECT(::std::find(recorder.values.begin(), recorder.values.end(), 0u) == recorder.values.end());
+            TAU_EXPECT_EQ(LargeEvent::destroyed, Count * (round + 1));
+
+            // Skip a frame so the same one is used again.
+            TAU_EXPECT_EQ(bus.dispatch(), 0u);
+        }
+    }
+    TAU_EXPECT_EQ(LargeEvent::destroyed, Count * 2);
+}
+
+TAU_TEST(EventBus, destroyPending)
+{
+    LargeEvent::destroyed = 0;
+    Recorder recorder;
+    {
+        EventBus bus;
+        bus.subscribe<LargeEvent, &Recorder::onLarge>(&recorder);
+        for(u32 i = 0; i < 10; ++i)
+        { (void) bus.post<LargeEvent>(static_cast<u8>(i)); }
+    }
+
+    // Pending events are destroyed without being delivered.
+    TAU_EXPECT_EQ(LargeEvent::destroyed, 10u);
+    TAU_EXPECT(recorder.values.empty());
+}
+
+namespace EventBusTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
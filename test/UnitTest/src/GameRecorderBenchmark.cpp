@@ -0,0 +1,80 @@
+#include "Benchmark.hpp"
+#include <GameRecorder.hpp>
+#include <cstring>
+
+static constexpr u32 RecordedTicks = 10000;
+
+struct BenchBlipData final
+{
+    float position[3];
+    float velocity[3];
+    i32 dMouseX;
+    i32 dMouseY;
+};
+
+static RunTimeType<GameRecorder::Blip> benchBlip() noexcept
+{
+    static RunTimeType<GameRecorder::Blip> type = RunTimeType<GameRecorder::Blip>::define();
+    return type;
+}
+
+static bool __cdecl benchHandler(GameRecorder::Blip&, void*) noexcept
+{ return true; }
+
+static GameRecorder::Blip __cdecl benchInitial(void* userParam) noexcept
+{ return { GameRecorder::BlipType::Initial, benchBlip(), userParam }; }
+
+static uSys __cdecl benchSerialize(const GameRecorder::Blip& blip, u8* const buffer, const uSys bufferSize, void*) noexcept
+{
+    if(bufferSize < sizeof(BenchBlipData))
+    { return 0; }
+    ::std::memcpy(buffer, blip.data, sizeof(BenchBlipData));
+    return sizeof(BenchBlipData);
+}
+
+static void recordTick(GameRecorder& recorder, BenchBlipData& data, const uSys tick) noexcept
+{
+    recorder.addBeginUpdate();
+
+    data.velocity[0] = (tick & 64) ? 1.0f : 0.0f;
+    data.position[0] += data.velocity[0];
+    data.dMouseX = static_cast<i32>(tick % 7) - 3;
+    recorder.addBlip({ GameRecorder::BlipType::Update, benchBlip(), &data });
+
+    recorder.addBeginRender();
+}
+
+/**
+ * The per tick cost of recording a single update blip.
+ */
+TAU_BENCHMARK(GameRecorder, record)
+{
+    BenchBlipData data { };
+
+    GameRecorder recorder;
+    recorder.addBlipHandler(benchBlip(), benchHandler, benchInitial, { 1, benchSerialize }, &data);
+
+    recorder.startRecording();
+    for(const uSys i : state)
+    { recordTick(recorder, data, i); }
+    recorder.stopRecording();
+}
+
+/**
+ * Random seeks within a recording of 10,000 ticks.
+ */
+TAU_BENCHMARK(GameRecorder, seek)
+{
+    BenchBlipData data { };
+
+    GameRecorder recorder;
+    recorder.addBlipHandler(benchBlip(), benchHandler, benchInitial, { 1, benchSerialize }, &data);
+
+    recorder.startRecording();
+    for(u32 i = 0; i < RecordedTicks; ++i)
+    { recordTick(recorder, data, i); }
+    recorder.stopRecording();
+
+    for(const uSys i : state)
+    { Benchmarks::doNotOptimize(recorder.seek(static_cast<u32>((static_cast<u64>(i) * 2654435761u) % RecordedTicks))); }
+}
@@ -0,0 +1,69 @@
+#include "Benchmark.hpp"
+#include "TestFont.hpp"
+#include <GlyphCache.hpp>
+#include <thread>
+#include <vector>
+
+static constexpr FT_UInt PixelHeight = 48;
+
+/**
+ * Every character the test font maps to a glyph, as UTF-16.
+ */
+static ::std::vector<wchar_t> fontCharacters(const FT_Library ft, const RefDynArray<u8>& font) noexcept
+{
+    ::std::vector<wchar_t> characters;
+
+    FT_Face face;
+    if(FT_New_Memory_Face(ft, font.arr(), static_cast<FT_Long>(font.size() - 1), 0, &face))
+    { return characters; }
+
+    FT_UInt index;
+    for(FT_ULong c = FT_Get_First_Char(face, &index); index; c = FT_Get_Next_Char(face, c, &index))
+    {
+        if(c < 0xD800 || (c > 0xDFFF && c <= 0xFFFF))
+        { characters.push_back(static_cast<wchar_t>(c)); }
+    }
+
+    FT_Done_Face(face);
+    return characters;
+}
+
+/**
+ *   Each iteration rasterizes and packs every glyph of the test
+ * font into an empty cache, about 900 glyphs.
+ */
+static void rasterizeFont(BenchmarkState& state, const u32 workerCount) noexcept
+{
+    FT_Library ft;
+    if(FT_Init_FreeType(&ft))
+    { return; }
+
+    {
+        const RefDynArray<u8> font = loadTestFont();
+        const ::std::vector<wchar_t> characters = fontCharacters(ft, font);
+
+        GlyphCacheArgs args;
+        args.workerCount = workerCount;
+        args.maxPages = 16;
+
+        for(const uSys i : state)
+        {
+            GlyphCache cache(ft, font, PixelHeight, args);
+            if(cache.init())
+            { break; }
+
+            cache.prefetch(characters.data(), characters.size());
+            cache.update(true);
+            Benchmarks::doNotOptimize(cache.pages().data());
+            (void) i;
+        }
+    }
+
+    FT_Done_FreeType(ft);
+}
+
+TAU_BENCHMARK(GlyphCache, rasterizeSerial)
+{ rasterizeFont(state, 1); }
+
+TAU_BENCHMARK(GlyphCache, rasterizeParallel)
+{ rasterizeFont(state, ::std::thread::hardware_concurrency() ? ::std::thread::hardware_concurrency() : 1); }
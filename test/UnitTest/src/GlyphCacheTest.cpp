@@ -0,0 +1,226 @@
+#include "UnitTest.hpp"
+#include "GlyphCacheTest.hpp"
+#include "TestFont.hpp"
+#include <GlyphCache.hpp>
+
+/**
+ * Owns a FreeType library for the duration of a test.
+ */
+class FreeTypeLibrary final
+{
+    DELETE_CM(FreeTypeLibrary);
+public:
+    FT_Library ft;
+    FT_Error error;
+public:
+    FreeTypeLibrary() noexcept
+        : ft(null)
+        , error(FT_Init_FreeType(&ft))
+    { }
+
+    ~FreeTypeLibrary() noexcept
+    {
+        if(!error)
+        { FT_Done_FreeType(ft); }
+    }
+};
+
+static GlyphCacheArgs testArgs(const u32 maxPages) noexcept
+{
+    GlyphCacheArgs args;
+    args.pageSize = 256;
+    args.maxPages = maxPages;
+    args.workerCount = 2;
+    args.padding = 1;
+    return args;
+}
+
+static u32 nonZeroTexels(const GlyphCache& cache, const CachedGlyph& glyph) noexcept
+{
+    const GlyphCache::Page& page = cache.pages()[glyph.page];
+    u32 count = 0;
+    for(u32 y = 0; y < glyph.height; ++y)
+    {
+        for(u32 x = 0; x < glyph.width; ++x)
+        {
+            if(page.pixels[static_cast<uSys>(glyph.y + y) * cache.args().pageSize + glyph.x + x])
+            { ++count; }
+        }
+    }
+    return count;
+}
+
+TAU_TEST(GlyphCache, residentGlyph)
+{
+    const RefDynArray<u8> font = loadTestFont();
+    TAU_ASSERT(font.size() > 1);
+    FreeTypeLibrary library;
+    TAU_ASSERT(!library.error);
+
+    GlyphCache cache(library.ft, font, 32, testArgs(1));
+    TAU_ASSERT(!cache.init());
+
+    TAU_EXPECT_EQ(cache.find('A')->state, CachedGlyph::State::Pending);
+    cache.update(true);
+
+    const CachedGlyph* const glyph = cache.find('A');
+    TAU_ASSERT(glyph->state == CachedGlyph::State::Resident);
+    TAU_EXPECT(glyph->width > 0 && glyph->height > 0);
+    TAU_EXPECT(glyph->advance > 0);
+    TAU_EXPECT(nonZeroTexels(cache, *glyph) > 0);
+
+    const GlyphCache::Page& page = cache.pages()[glyph->page];
+    TAU_EXPECT(page.dirty());
+    TAU_EXPECT(page.dirtyTop <= glyph->y);
+    TAU_EXPECT(page.dirtyBottom >= static_cast<u32>(glyph->y + glyph->height));
+    TAU_EXPECT(page.dirtyBottom < cache.args().pageSize);
+}
+
+TAU_TEST(GlyphCache, blankAndMissing)
+{
+    const RefDynArray<u8> font = loadTestFont();
+    TAU_ASSERT(font.size() > 1);
+    FreeTypeLibrary library;
+    TAU_ASSERT(!library.error);
+
+    GlyphCache cache(library.ft, font, 32, testArgs(1));
+    TAU_ASSERT(!cache.init());
+
+    (void) cache.find(' ');
+    (void) cache.find(0x4E00);
+    cache.update(true);
+
+    const CachedGlyph* const space = cache.find(' ');
+    TAU_EXPECT_EQ(space->state, CachedGlyph::State::Blank);
+    TAU_EXPECT(space->advance > 0);
+    TAU_EXPECT_EQ(cache.find(0x4E00)->state, CachedGlyph::State::Missing);
+
+    const u64 rasterized = cache.stats().rasterized;
+    (void) cache.find(' ');
+    (void) cache.find(0x4E00);
+    cache.update(true);
+    TAU_EXPECT_EQ(cache.stats().rasterized, rasterized);
+    TAU_EXPECT(cache.pages().empty());
+}
+
+TAU_TEST(GlyphCache, oversizedGlyph)
+{
+    const RefDynArray<u8> font = loadTestFont();
+    TAU_ASSERT(font.size() > 1);
+    FreeTypeLibrary library;
+    TAU_ASSERT(!library.error);
+
+    GlyphCache cache(library.ft, font, 400, testArgs(1));
+    TAU_ASSERT(!cache.init());
+
+    (void) cache.find('W');
+    cache.update(true);
+
+    const CachedGlyph* const glyph = cache.find('W');
+    TAU_EXPECT_EQ(glyph->state, CachedGlyph::State::Oversized);
+    TAU_EXPECT(glyph->advance > 0);
+    TAU_EXPECT(cache.pages().empty());
+
+    /**
+     * The glyph is not requested again on later frames.
+     */
+    const u64 rasterized = cache.stats().rasterized;
+    for(u32 frame = 0; frame < 4; ++frame)
+    {
+        (void) cache.find('W');
+        cache.update(true);
+    }
+    TAU_EXPECT_EQ(cache.stats().rasterized, rasterized);
+    TAU_EXPECT_EQ(cache.glyphCount(), 1u);
+
+    GlyphBatch batch;
+    cache.buildQuads(L"W", 1, 0.0f, 0.0f, 1.0f, batch);
+    TAU_EXPECT(batch.quads.empty());
+    TAU_EXPECT_EQ(batch.pendingGlyphs, 0u);
+    TAU_EXPECT(batch.endX > 0.0f);
+}
+
+TAU_TEST(GlyphCache, buildQuads)
+{
+    const RefDynArray<u8> font = loadTestFont();
+    TAU_ASSERT(font.size() > 1);
+    FreeTypeLibrary library;
+    TAU_ASSERT(!library.error);
+
+    GlyphCache cache(library.ft, font, 32, testArgs(1));
+    TAU_ASSERT(!cache.init());
+
+    static constexpr wchar_t Text[] = L"AB A";
+    static constexpr uSys Length = sizeof(Text) / sizeof(wchar_t) - 1;
+
+    GlyphBatch batch;
+    cache.buildQuads(Text, Length, 0.0f, 0.0f, 1.0f, batch);
+    TAU_EXPECT_EQ(batch.pendingGlyphs, 4u);
+    TAU_EXPECT(batch.quads.empty());
+
+    cache.update(true);
+    cache.buildQuads(Text, Length, 0.0f, 0.0f, 1.0f, batch);
+    TAU_EXPECT_EQ(batch.pendingGlyphs, 0u);
+    TAU_EXPECT_EQ(batch.quads.size(), 3u);
+    TAU_ASSERT(batch.ranges.size() == 1);
+    TAU_EXPECT_EQ(batch.ranges[0].vertexCount, 18u);
+    TAU_EXPECT_EQ(batch.positions.size(), 36u);
+
+    const u32 advance = (cache.find('A')->advance >> 6) * 2 + (cache.find('B')->advance >> 6) + (cache.find(' ')->advance >> 6);
+    TAU_EXPECT_EQ(batch.endX, static_cast<float>(advance));
+}
+
+TAU_TEST(GlyphCache, evictLeastRecentlyUsed)
+{
+    const RefDynArray<u8> font = loadTestFont();
+    TAU_ASSERT(font.size() > 1);
+    FreeTypeLibrary library;
+    TAU_ASSERT(!library.error);
+
+    GlyphCache cache(library.ft, font, 64, testArgs(1));
+    TAU_ASSERT(!cache.init());
+
+    (void) cache.find('A');
+    cache.update(true);
+    TAU_ASSERT(cache.find('A')->state == CachedGlyph::State::Resident);
+
+    /**
+     *   A single page holds a few dozen glyphs at this size, keep
+     * requesting new glyphs until the page is full and evicted.
+     */
+    for(u32 frame = 0, codepoint = 'a'; frame < 16 && cache.stats().evictions == 0; ++frame)
+    {
+        for(u32 i = 0; i < 16; ++i, ++codepoint)
+        { (void) cache.find(codepoint > 'z' ? codepoint - 'z' + '0' - 1 : codepoint); }
+        cache.update(true);
+    }
+
+    TAU_ASSERT(cache.stats().evictions > 0);
+    TAU_EXPECT_EQ(cache.pages().size(), 1u);
+    TAU_EXPECT_EQ(cache.find('A')->state, CachedGlyph::State::Pending);
+
+    const GlyphCache::Page& page = cache.pages()[0];
+    TAU_EXPECT_EQ(page.dirtyTop, 0u);
+    TAU_EXPECT_EQ(page.dirtyBottom, cache.args().pageSize);
+}
+
+TAU_TEST(GlyphCache, pageSizeRounding)
+{
+    const RefDynArray<u8> font = loadTestFont();
+    TAU_ASSERT(font.size() > 1);
+    FreeTypeLibrary library;
+    TAU_ASSERT(!library.error);
+
+    GlyphCacheArgs args = testArgs(1);
+    args.pageSize = 300;
+
+    const GlyphCache cache(library.ft, font, 32, args);
+    TAU_EXPECT_EQ(cache.args().pageSize, 512u);
+}
+
+namespace GlyphCacheTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
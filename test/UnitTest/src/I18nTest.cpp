@@ -0,0 +1,227 @@
+#include "UnitTest.hpp"
+#include "I18nTest.hpp"
+#include <I18n.hpp>
+#include <MemoryFile.hpp>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <vector>
+
+static constexpr u32 LegacyMagic = 0x4C614E67;
+static constexpr u32 TranslationCount = 1000;
+
+static CPPRef<IFile> writeFile(const wchar_t* const path, const void* const data, const uSys length) noexcept
+{
+    {
+        const CPPRef<IFile> file = MemoryFileLoader::Instance()->load(path, FileProps::WriteOverwrite);
+        (void) file->writeBytes(reinterpret_cast<const u8*>(data), length);
+    }
+    return MemoryFileLoader::Instance()->load(path, FileProps::Read);
+}
+
+static void testKey(const u32 index, char (&key)[32]) noexcept
+{ (void) ::std::snprintf(key, sizeof(key), "menu.item.%u", index); }
+
+/**
+ * The value of each key is the key itself, widened.
+ */
+static void testValue(const char* const key, wchar_t (&value)[32]) noexcept
+{
+    uSys i = 0;
+    for(; key[i] && i < 31; ++i)
+    { value[i] = static_cast<wchar_t>(key[i]); }
+    value[i] = L'\0';
+}
+
+static I18nTableBuilder testBuilder(const u32 count) noexcept
+{
+    I18nTableBuilder builder;
+    builder.language(L"Test", 4);
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        char key[32];
+        wchar_t value[32];
+        testKey(i, key);
+        testValue(key, value);
+        builder.add(DynString(key), value, ::std::wcslen(value));
+    }
+
+    return builder;
+}
+
+static CPPRef<IFile> compileTable(const I18nTableBuilder& builder) noexcept
+{
+    ::std::vector<u8> image;
+    if(!builder.build(image))
+    { return null; }
+    return writeFile(L"i18nTest\\table.tlng", image.data(), image.size());
+}
+
+template<typename _T>
+static void append(::std::vector<u8>& file, const _T& value) noexcept
+{
+    const u8* const bytes = reinterpret_cast<const u8*>(&value);
+    file.insert(file.end(), bytes, bytes + sizeof(_T));
+}
+
+/**
+ * Encodes the same translations in the legacy `LaNg` format.
+ */
+static CPPRef<IFile> writeLegacy(const u32 count) noexcept
+{
+    ::std::vector<u8> file;
+    append(file, LegacyMagic);
+    append(file, count);
+    append(file, 4u);
+    for(const wchar_t c : L"Test")
+    {
+        if(c)
+        { append(file, c); }
+    }
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        char key[32];
+        wchar_t value[32];
+        testKey(i, key);
+        testValue(key, value);
+
+        const u32 keyLength = static_cast<u32>(::std::strlen(key));
+        const u32 valueLength = static_cast<u32>(::std::wcslen(value));
+        append(file, keyLength);
+        append(file, valueLength);
+        file.insert(file.end(), key, key + keyLength);
+        for(u32 j = 0; j < valueLength; ++j)
+        { append(file, value[j]); }
+    }
+
+    return writeFile(L"i18nTest\\legacy.lang", file.data(), file.size());
+}
+
+static u32 countMatches(const I18n& i18n, const u32 count) noexcept
+{
+    u32 matches = 0;
+    for(u32 i = 0; i < count; ++i)
+    {
+        char key[32];
+        wchar_t value[32];
+        testKey(i, key);
+        testValue(key, value);
+
+        I18n::Error error;
+        const wchar_t* const translation = i18n.translate(key, &error);
+        if(error == I18n::Error::NoError && ::std::wcscmp(translation, value) == 0)
+        { ++matches; }
+    }
+    return matches;
+}
+
+TAU_TEST(I18n, perfectHashLookup)
+{
+    const I18nTableBuilder builder = testBuilder(TranslationCount);
+
+    ::std::vector<u8> image;
+    I18nTableBuilder::Error error;
+    TAU_ASSERT(builder.build(image, &error));
+
+    const i18n::bin::Header& header = *reinterpret_cast<const i18n::bin::Header*>(image.data());
+    const i32* const seeds = reinterpret_cast<const i32*>(image.data() + header.seedOffset);
+
+    // Every key has to land on its own slot.
+    ::std::vector<bool> occupied(header.entryCount, false);
+    u32 collisions = 0;
+    for(u32 i = 0; i < TranslationCount; ++i)
+    {
+        char key[32];
+        testKey(i, key);
+
+        const u64 hash = i18n::bin::hashKey(key, ::std::strlen(key));
+        const i32 seed = seeds[i18n::bin::bucket(hash, header.entryCount)];
+        const u32 slot = seed < 0 ? static_cast<u32>(-(seed + 1)) : i18n::bin::slot(hash, seed, header.entryCount);
+
+        if(slot >= header.entryCount || occupied[slot])
+        { ++collisions; }
+        else
+        { occupied[slot] = true; }
+    }
+
+    TAU_EXPECT_EQ(header.entryCount, TranslationCount);
+    TAU_EXPECT_EQ(collisions, 0u);
+}
+
+TAU_TEST(I18n, mappedLoad)
+{
+    I18n i18n;
+    TAU_ASSERT(i18n.loadTranslations(compileTable(testBuilder(TranslationCount))));
+
+    TAU_EXPECT_EQ(i18n.count(), TranslationCount);
+    TAU_EXPECT(::std::wcscmp(i18n.language(), L"Test") == 0);
+    TAU_EXPECT_EQ(countMatches(i18n, TranslationCount), TranslationCount);
+}
+
+TAU_TEST(I18n, legacyFallback)
+{
+    I18n i18n;
+    TAU_ASSERT(i18n.loadTranslations(writeLegacy(TranslationCount)));
+
+    TAU_EXPECT_EQ(i18n.count(), TranslationCount);
+    TAU_EXPECT(::std::wcscmp(i18n.language(), L"Test") == 0);
+    TAU_EXPECT_EQ(countMatches(i18n, TranslationCount), TranslationCount);
+}
+
+TAU_TEST(I18n, missingKeys)
+{
+    I18n i18n;
+
+    I18n::Error error;
+    TAU_EXPECT(::std::wcscmp(i18n.translate("menu.item.0", &error), L"") == 0);
+    TAU_EXPECT_EQ(error, I18n::Error::UnknownTranslationKey);
+
+    TAU_ASSERT(i18n.loadTranslations(compileTable(testBuilder(TranslationCount))));
+
+    static const char* const missing[] = {
+        "",
+        "menu.item.",
+        "menu.item.1000",
+        "menu.item.00",
+        "menu.iten.1",
+        "Menu.item.1"
+    };
+
+    for(const char* const key : missing)
+    {
+        TAU_EXPECT(::std::wcscmp(i18n.translate(key, &error), L"") == 0);
+        TAU_EXPECT_EQ(error, I18n::Error::UnknownTranslationKey);
+    }
+}
+
+TAU_TEST(I18n, rejectedLoadKeepsLanguage)
+{
+    I18n i18n;
+    TAU_ASSERT(i18n.loadTranslations(compileTable(testBuilder(16))));
+
+    const u32 garbage[] = { 0x12345678, 0, 0 };
+    TAU_EXPECT(!i18n.loadTranslations(writeFile(L"i18nTest\\garbage.lang", garbage, sizeof(garbage))));
+
+    TAU_EXPECT_EQ(i18n.count(), 16u);
+    TAU_EXPECT_EQ(countMatches(i18n, 16), 16u);
+}
+
+TAU_TEST(I18n, duplicateKey)
+{
+    I18nTableBuilder builder = testBuilder(16);
+    builder.add(DynString("menu.item.3"), L"Again", 5);
+
+    ::std::vector<u8> image;
+    I18nTableBuilder::Error error;
+    TAU_EXPECT(!builder.build(image, &error));
+    TAU_EXPECT_EQ(error, I18nTableBuilder::Error::DuplicateKey);
+}
+
+namespace I18nTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
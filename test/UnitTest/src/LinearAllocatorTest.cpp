@@ -0,0 +1,196 @@
+#include "UnitTest.hpp"
+#include "LinearAllocatorTest.hpp"
+#include <allocator/LinearAllocator.hpp>
+#include <Safeties.hpp>
+
+static bool aligned(const void* const ptr, const uSys alignment) noexcept
+{ return (reinterpret_cast<uSys>(ptr) & (alignment - 1)) == 0; }
+
+TAU_TEST(LinearArenaAllocator, allocateTest)
+{
+    LinearArenaAllocator arena(static_cast<PageCountVal>(64), 4);
+
+    u8* const a = reinterpret_cast<u8*>(arena.allocate(3));
+    u8* const b = reinterpret_cast<u8*>(arena.allocate(100));
+    u8* const c = reinterpret_cast<u8*>(arena.allocate(1, static_cast<AllocationAlignment>(256)));
+
+    TAU_EXPECT(a && b && c);
+    TAU_EXPECT(aligned(a, LinearArenaAllocator::DefaultAlignment));
+    TAU_EXPECT(aligned(b, LinearArenaAllocator::DefaultAlignment));
+    TAU_EXPECT(aligned(c, 256));
+    TAU_EXPECT_EQ(b - a, 16);
+    TAU_EXPECT(arena.owns(a) && arena.owns(c));
+
+    // Deallocating is a no-op, only rewinding releases memory.
+    arena.deallocate(c);
+    TAU_EXPECT_EQ(arena.allocIndex(), static_cast<uSys>(c - a) + 1);
+}
+
+TAU_TEST(LinearArenaAllocator, rewindTest)
+{
+    LinearArenaAllocator arena(static_cast<PageCountVal>(64), 4);
+
+    (void) arena.allocate(40);
+    const LinearArenaAllocator::Marker marker = arena.mark();
+    void* const first = arena.allocate(1000);
+    (void) arena.allocate(5000);
+    const uSys highWater = arena.allocIndex();
+
+    arena.rewind(marker);
+    TAU_EXPECT_EQ(arena.allocIndex(), marker);
+    TAU_EXPECT_EQ(arena.allocate(1000), first);
+
+    arena.reset();
+    TAU_EXPECT_EQ(arena.allocIndex(), 0u);
+    TAU_EXPECT_EQ(arena.highWater(), highWater);
+
+    // Rewinding forwards doesn't do anything.
+    arena.rewind(highWater);
+    TAU_EXPECT_EQ(arena.allocIndex(), 0u);
+}
+
+TAU_TEST(LinearArenaAllocator, commitTest)
+{
+    const uSys pageSize = PageAllocator::pageSize();
+    LinearArenaAllocator arena(static_cast<PageCountVal>(8), 2);
+
+    TAU_EXPECT_EQ(arena.committedPages(), 0u);
+
+    (void) arena.allocate(1);
+    TAU_EXPECT_EQ(arena.committedPages(), 2u);
+
+    u8* const end = reinterpret_cast<u8*>(arena.allocate(pageSize * 4));
+    TAU_EXPECT(end != nullptr);
+    TAU_EXPECT_EQ(arena.committedPages(), 6u);
+
+    // The whole reservation is writable.
+    end[pageSize * 4 - 1] = 0xAB;
+
+    TAU_EXPECT(arena.allocate(pageSize * 4) == nullptr);
+    TAU_EXPECT(arena.allocate(pageSize * 2) != nullptr);
+    TAU_EXPECT_EQ(arena.committedPages(), 8u);
+
+    arena.reset();
+    TAU_EXPECT_EQ(arena.committedPages(), 8u);
+    arena.trim(2);
+    TAU_EXPECT_EQ(arena.committedPages(), 2u);
+
+    TAU_EXPECT(arena.allocate(pageSize * 3) != nullptr);
+    TAU_EXPECT_EQ(arena.committedPages(), 4u);
+}
+
+TAU_TEST(LinearArenaAllocator, overflowTest)
+{
+    LinearArenaAllocator arena(static_cast<PageCountVal>(8), 2);
+
+    (void) arena.allocate(100);
+    const uSys index = arena.allocIndex();
+
+    // Sizes that would wrap the end offset around to inside the reservation.
+    TAU_EXPECT(arena.allocate(~static_cast<uSys>(0)) == nullptr);
+    TAU_EXPECT(arena.allocate(~static_cast<uSys>(0) - 64) == nullptr);
+    TAU_EXPECT(arena.allocate(~static_cast<uSys>(0) - 100, static_cast<AllocationAlignment>(256)) == nullptr);
+    TAU_EXPECT_EQ(arena.allocIndex(), index);
+    TAU_EXPECT(arena.allocate(16) != nullptr);
+}
+
+TAU_TEST(ScratchAllocator, lifoTest)
+{
+    ScratchAllocator scratch(static_cast<PageCountVal>(16), 1);
+
+    void* const a = scratch.allocate(64);
+    void* const b = scratch.allocate(64);
+    void* const c = scratch.allocate(64, static_cast<AllocationAlignment>(64));
+    TAU_EXPECT(aligned(c, 64));
+
+    // Freeing out of order is ignored.
+    const uSys index = scratch.arena().allocIndex();
+    scratch.deallocate(b);
+    TAU_EXPECT_EQ(scratch.arena().allocIndex(), index);
+
+    scratch.deallocate(c);
+    TAU_EXPECT_EQ(scratch.allocate(64, static_cast<AllocationAlignment>(64)), c);
+    scratch.deallocate(c);
+    scratch.deallocate(b);
+    scratch.deallocate(a);
+    TAU_EXPECT_EQ(scratch.arena().allocIndex(), 0u);
+}
+
+TAU_TEST(ScratchAllocator, overflowTest)
+{
+    ScratchAllocator scratch(static_cast<PageCountVal>(16), 1);
+
+    void* const a = scratch.allocate(64);
+    TAU_EXPECT(scratch.allocate(~static_cast<uSys>(0)) == nullptr);
+    TAU_EXPECT(scratch.allocate(~static_cast<uSys>(0) - 8) == nullptr);
+    TAU_EXPECT(scratch.allocate(~static_cast<uSys>(0) - 16, static_cast<AllocationAlignment>(64)) == nullptr);
+
+    // The failed allocations left the stack untouched.
+    scratch.deallocate(a);
+    TAU_EXPECT_EQ(scratch.arena().allocIndex(), 0u);
+}
+
+TAU_TEST(ScratchAllocator, scopeTest)
+{
+    ScratchAllocator scratch(static_cast<PageCountVal>(16), 1);
+
+    void* const outer = scratch.allocate(32);
+    {
+        ScratchScope scope(scratch);
+        u32* const values = scope.allocateArray<u32>(256);
+        TAU_EXPECT(values != nullptr);
+        for(u32 i = 0; i < 256; ++i)
+        { values[i] = i; }
+        TAU_EXPECT_EQ(values[255], 255u);
+    }
+
+    // The scope released its allocations and the outer one is on top again.
+    scratch.deallocate(outer);
+    TAU_EXPECT_EQ(scratch.arena().allocIndex(), 0u);
+
+    TAU_EXPECT(&ScratchAllocator::threadLocal() == &ScratchAllocator::threadLocal());
+}
+
+TAU_TEST(ScratchAllocator, tauRefTest)
+{
+    ScratchAllocator scratch(static_cast<PageCountVal>(16), 1);
+
+    {
+        const NullableRef<u64> ref(static_cast<TauAllocator&>(scratch), 42ull);
+        TAU_EXPECT(ref != nullptr);
+        TAU_EXPECT_EQ(*ref, 42ull);
+        TAU_EXPECT_GR(scratch.arena().allocIndex(), 0u);
+    }
+
+    // Releasing the last reference popped the allocation.
+    TAU_EXPECT_EQ(scratch.arena().allocIndex(), 0u);
+}
+
+TAU_TEST(FrameArenaAllocator, frameTest)
+{
+    FrameArenaAllocator frames(2, static_cast<PageCountVal>(16), 1);
+    TAU_EXPECT_EQ(frames.frameCount(), 2u);
+
+    u32* const first = reinterpret_cast<u32*>(frames.allocate(sizeof(u32)));
+    *first = 0xCAFEBABE;
+
+    frames.nextFrame();
+    TAU_EXPECT_EQ(frames.frameIndex(), 1u);
+    u32* const second = reinterpret_cast<u32*>(frames.allocate(sizeof(u32)));
+    TAU_EXPECT(second != first);
+
+    // Last frame's data is still intact.
+    TAU_EXPECT_EQ(*first, 0xCAFEBABEu);
+
+    frames.nextFrame();
+    TAU_EXPECT_EQ(frames.frameIndex(), 0u);
+    TAU_EXPECT_EQ(frames.current().allocIndex(), 0u);
+    TAU_EXPECT(frames.allocate(sizeof(u32)) == first);
+}
+
+namespace LinearAllocatorTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -10,16 +10,36 @@
 #include "Vector4fTest.hpp"
 #include "Matrix4x4fTest.hpp"
 #include "SlabAllocatorTest.hpp"
+#include "DescriptorTableAllocatorTest.hpp"
+#include "TLSFAllocatorTest.hpp"
+#include "LinearAllocatorTest.hpp"
+#include "AllocationTrackerTest.hpp"
+#include "StateCacheTest.hpp"
+#include "ShaderBundleTest.hpp"
+#include "I18nTest.hpp"
+#include "GlyphCacheTest.hpp"
+#include "SDFTest.hpp"
+#include "CullingTest.hpp"
+#include "ReflectionTest.hpp"
+#include "ConsoleTest.hpp"
+#include "VertexQuantizationTest.hpp"
+#include "EventBusTest.hpp"
+#include "TextureDecodeTest.hpp"
 #include "MathTest.hpp"
+#include "MathStreamTest.hpp"
 #include "UnitTest.hpp"
 #include "ConPrinter.hpp"
 #include "MemoryFileTest.hpp"
 #include "TexturePackingTest.hpp"
+#include "CompressionTest.hpp"
+#include "Benchmark.hpp"
 #include <cstdio>
+#include <cstring>
 
 #include "allocator/PageAllocator.hpp"
 
 #define SHOULD_PAUSE 0
+#define RUN_BENCHMARKS 0
 
 #if SHOULD_PAUSE
   #include <conio.h>
@@ -28,10 +48,20 @@
   #define PAUSE(_MSG)
 #endif
 
+/**
+ *   `--benchmark` runs the benchmarks instead of the tests and
+ * fails if any of them regressed against the baseline.
+ */
 int main(int argCount, char* args[])
 {
     PageAllocator::init();
 
+    for(int i = 1; i < argCount; ++i)
+    {
+        if(::std::strcmp(args[i], "--benchmark") == 0)
+        { return Benchmarks::runAll(Benchmarks::parseArgs(argCount, args)) == 0 ? 0 : 1; }
+    }
+
     PAUSE("Start");
 
     printf("\nArrayList Tests:\n\n");
@@ -73,6 +103,12 @@ int main(int argCount, char* args[])
 
     RefPtrTest::strongParentChildTest();
     RefPtrTest::strongParentChildReverseTest();
+
+    RefPtrTest::biasedRefCountTest();
+    RefPtrTest::biasedDeferredReleaseTest();
+    RefPtrTest::biasedRefPtrMergeTest();
+    RefPtrTest::biasedRefPtrHandOffTest();
+    RefPtrTest::biasedRefPtrDeferredReleaseTest();
     printf("Reference Counting Pointer Tests Finished\n");
 
     PAUSE("Continue");
@@ -146,10 +182,22 @@ int main(int argCount, char* args[])
     Matrix4x4fTests::divScalarTest();
 
     Matrix4x4fTests::mulVecTest();
+
+    Matrix4x4fTests::transposeTest();
+    Matrix4x4fTests::inverseTest();
+    Matrix4x4fTests::affineInverseTest();
+    Matrix4x4fTests::mulOrderTest();
+    Matrix4x4fTests::dispatchTest();
     printf("Matrix4x4f Tests Finished\n");
 
     PAUSE("Continue");
 
+    printf("\nMath Stream Tests:\n\n");
+    MathStreamTest::runTests();
+    printf("Math Stream Tests Finished\n");
+
+    PAUSE("Continue");
+
     printf("\nAVL Tree Tests:\n\n");
     AVLTreeUnitTest::insertIgnoreTest();
     AVLTreeUnitTest::insertDuplicateIgnoreTest();
@@ -236,6 +284,96 @@ int main(int argCount, char* args[])
         
     PAUSE("Continue");
 
+    printf("\nDescriptor Table Allocator Tests:\n\n");
+    DescriptorTableAllocatorTest::runTests();
+    printf("Descriptor Table Allocator Tests Finished\n");
+        
+    PAUSE("Continue");
+
+    printf("\nTLSF Allocator Tests:\n\n");
+    TLSFAllocatorTest::runTests();
+    printf("TLSF Allocator Tests Finished\n");
+        
+    PAUSE("Continue");
+
+    printf("\nLinear Allocator Tests:\n\n");
+    LinearAllocatorTest::runTests();
+    printf("Linear Allocator Tests Finished\n");
+        
+    PAUSE("Continue");
+
+    printf("\nAllocation Tracker Tests:\n\n");
+    AllocationTrackerTest::runTests();
+    printf("Allocation Tracker Tests Finished\n");
+        
+    PAUSE("Continue");
+
+    printf("\nState Cache Tests:\n\n");
+    StateCacheTest::runTests();
+    printf("State Cache Tests Finished\n");
+        
+    PAUSE("Continue");
+
+    printf("\nShader Bundle Tests:\n\n");
+    ShaderBundleTest::runTests();
+    printf("Shader Bundle Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nI18n Tests:\n\n");
+    I18nTest::runTests();
+    printf("I18n Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nGlyph Cache Tests:\n\n");
+    GlyphCacheTest::runTests();
+    printf("Glyph Cache Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nSDF Tests:\n\n");
+    SDFTest::runTests();
+    printf("SDF Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nCulling Tests:\n\n");
+    CullingTest::runTests();
+    printf("Culling Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nReflection Tests:\n\n");
+    ReflectionTest::runTests();
+    printf("Reflection Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nConsole Tests:\n\n");
+    ConsoleTest::runTests();
+    printf("Console Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nVertex Quantization Tests:\n\n");
+    VertexQuantizationTest::runTests();
+    printf("Vertex Quantization Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nEvent Bus Tests:\n\n");
+    EventBusTest::runTests();
+    printf("Event Bus Tests Finished\n");
+
+    PAUSE("Continue");
+
+    printf("\nTexture Decode Tests:\n\n");
+    TextureDecodeTest::runTests();
+    printf("Texture Decode Tests Finished\n");
+
+    PAUSE("Continue");
+
     printf("\nMath Tests:\n\n");
     MathTest::runTests();
     printf("Math Tests Finished\n");
@@ -252,6 +390,20 @@ int main(int argCount, char* args[])
     TexturePackingTests::runTests();
     printf("Texture Packing Tests Tests Finished\n");
 
+    PAUSE("Continue");
+
+    printf("\nCompression Tests:\n\n");
+    CompressionTest::runTests();
+    printf("Compression Tests Finished\n");
+
+#if RUN_BENCHMARKS
+    PAUSE("Continue");
+
+    printf("\nBenchmarks:\n\n");
+    (void) Benchmarks::runAll(Benchmarks::parseArgs(argCount, args));
+    printf("Benchmarks Finished\n");
+#endif
+
     printf("\nTests Performed: %d\n", UnitTests::testsPerformed());
     printf("Tests Passed: %d\n", UnitTests::testsPassed());
     printf("Tests Failed: %d\n", UnitTests::testsFailed());
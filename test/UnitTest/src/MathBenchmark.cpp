@@ -0,0 +1,533 @@
+#include "Benchmark.hpp"
+#include <Matrix4x4f.hpp>
+#include <Matrix4x4fIntrin.h>
+#include <Vector4f.hpp>
+#include <Vector4fIntrin.h>
+#include <MathStream.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <cstring>
+#include <vector>
+
+static constexpr uSys DataCount = 1024;
+static constexpr uSys StreamCount = 4096;
+
+[[nodiscard]] static const char* unsupportedReason(const MathISA isa) noexcept
+{
+    switch(isa)
+    {
+        case MathISA::AVX2: return "AVX2 isn't supported";
+        case MathISA::AVX512: return "AVX-512 isn't supported";
+        default: return "SSE4.1 isn't supported";
+    }
+}
+
+/**
+ *   Runs `func` with the dispatched entry points forced to `isa`,
+ * skipping the benchmark if this machine doesn't support it.
+ */
+template<typename _F>
+static void withISA(BenchmarkState& state, const MathISA isa, _F func) noexcept
+{
+    const MathISA previous = mathActiveISA();
+
+    if(mathForceISA(isa) == isa)
+    { func(); }
+    else
+    { state.skip(unsupportedReason(isa)); }
+
+    (void) mathForceISA(previous);
+}
+
+/**
+ *   1024 random matrices, affine matrices and vectors, with glm
+ * copies of each. Every iteration is one operation on the next
+ * element, the outputs are kept so the work can't be removed.
+ */
+class MathData final
+{
+    DEFAULT_DESTRUCT(MathData);
+    DELETE_CM(MathData);
+public:
+    ::std::vector<Matrix4x4f> matrices;
+    ::std::vector<Matrix4x4f> affine;
+    ::std::vector<Vector4f> vectors;
+    ::std::vector<glm::mat4> glmMatrices;
+    ::std::vector<glm::mat4> glmAffine;
+    ::std::vector<glm::vec4> glmVectors;
+
+    ::std::vector<Matrix4x4f> matrixOut;
+    ::std::vector<Vector4f> vectorOut;
+    ::std::vector<glm::mat4> glmMatrixOut;
+    ::std::vector<glm::vec4> glmVectorOut;
+    ::std::vector<float> scalarOut;
+public:
+    MathData() noexcept
+        : matrices(DataCount)
+        , affine(DataCount)
+        , vectors(DataCount)
+        , glmMatrices(DataCount)
+        , glmAffine(DataCount)
+        , glmVectors(DataCount)
+        , matrixOut(DataCount)
+        , vectorOut(DataCount)
+        , glmMatrixOut(DataCount)
+        , glmVectorOut(DataCount)
+        , scalarOut(DataCount)
+    {
+        u32 seed = 0x1234567;
+        const auto random = [&seed]() noexcept
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 2.0f - 1.0f;
+        };
+
+        for(uSys i = 0; i < DataCount; ++i)
+        {
+            for(uSys j = 0; j < 16; ++j)
+            {
+                matrices[i].mRaw[j] = random();
+                affine[i].mRaw[j] = (j & 3) == 3 ? 0.0f : random();
+            }
+            matrices[i].mRaw[0] += 4.0f;
+            matrices[i].mRaw[5] += 4.0f;
+            matrices[i].mRaw[10] += 4.0f;
+            matrices[i].mRaw[15] += 4.0f;
+            affine[i].mRaw[0] += 4.0f;
+            affine[i].mRaw[5] += 4.0f;
+            affine[i].mRaw[10] += 4.0f;
+            affine[i].mRaw[15] = 1.0f;
+
+            vectors[i] = Vector4f(random(), random(), random(), random());
+
+            ::std::memcpy(&glmMatrices[i], matrices[i].mRaw, sizeof(glm::mat4));
+            ::std::memcpy(&glmAffine[i], affine[i].mRaw, sizeof(glm::mat4));
+            ::std::memcpy(&glmVectors[i], &vectors[i], sizeof(glm::vec4));
+        }
+    }
+
+    [[nodiscard]] static uSys next(const uSys i) noexcept { return (i + 1) & (DataCount - 1); }
+};
+
+template<typename _F>
+static void timeOps(BenchmarkState& state, _F func) noexcept
+{
+    for(const uSys i : state)
+    { func(i & (DataCount - 1)); }
+    Benchmarks::clobberMemory();
+}
+
+template<typename _F>
+static void timeDispatched(BenchmarkState& state, const MathISA isa, _F func) noexcept
+{ withISA(state, isa, [&]() noexcept { timeOps(state, func); }); }
+
+TAU_BENCHMARK(Math, vectorAddLL)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.vectorOut[i] = vector4f_add(d.vectors[i].vec, d.vectors[MathData::next(i)].vec); });
+}
+
+TAU_BENCHMARK(Math, vectorAddInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.vectorOut[i] = d.vectors[i] + d.vectors[MathData::next(i)]; });
+}
+
+TAU_BENCHMARK(Math, vectorAddGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmVectorOut[i] = d.glmVectors[i] + d.glmVectors[MathData::next(i)]; });
+}
+
+TAU_BENCHMARK(Math, vectorDotLL)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.scalarOut[i] = vector4f_dot(d.vectors[i].vec, d.vectors[MathData::next(i)].vec); });
+}
+
+TAU_BENCHMARK(Math, vectorDotInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.scalarOut[i] = simd::vector4f_dot(d.vectors[i].vec, d.vectors[MathData::next(i)].vec); });
+}
+
+TAU_BENCHMARK(Math, vectorDotGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.scalarOut[i] = glm::dot(d.glmVectors[i], d.glmVectors[MathData::next(i)]); });
+}
+
+TAU_BENCHMARK(Math, normalizeLL)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.vectorOut[i] = vector4f_normalizeExact(d.vectors[i].vec); });
+}
+
+TAU_BENCHMARK(Math, normalizeInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.vectorOut[i] = simd::vector4f_normalizeExact(d.vectors[i].vec); });
+}
+
+TAU_BENCHMARK(Math, normalizeGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmVectorOut[i] = glm::normalize(d.glmVectors[i]); });
+}
+
+TAU_BENCHMARK(Math, matrixMulLL)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { matrix4x4f_mul(d.matrices[i].mRaw, d.matrices[MathData::next(i)].mRaw, d.matrixOut[i].mRaw); });
+}
+
+TAU_BENCHMARK(Math, matrixMulSSE41)
+{
+    MathData d;
+    timeDispatched(state, MathISA::SSE41, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::mul(d.matrices[i], d.matrices[MathData::next(i)]); });
+}
+
+TAU_BENCHMARK(Math, matrixMulAVX2)
+{
+    MathData d;
+    timeDispatched(state, MathISA::AVX2, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::mul(d.matrices[i], d.matrices[MathData::next(i)]); });
+}
+
+TAU_BENCHMARK(Math, matrixMulInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.matrixOut[i] = d.matrices[i] * d.matrices[MathData::next(i)]; });
+}
+
+TAU_BENCHMARK(Math, matrixMulGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmMatrixOut[i] = d.glmMatrices[i] * d.glmMatrices[MathData::next(i)]; });
+}
+
+TAU_BENCHMARK(Math, matrixVectorLL)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.vectorOut[i] = matrix4x4f_mulVector(d.matrices[i].mRaw, d.vectors[i].vec); });
+}
+
+TAU_BENCHMARK(Math, matrixVectorSSE41)
+{
+    MathData d;
+    timeDispatched(state, MathISA::SSE41, [&](const uSys i) noexcept { d.vectorOut[i] = Matrix4x4f::mul(d.matrices[i], d.vectors[i]); });
+}
+
+TAU_BENCHMARK(Math, matrixVectorAVX2)
+{
+    MathData d;
+    timeDispatched(state, MathISA::AVX2, [&](const uSys i) noexcept { d.vectorOut[i] = Matrix4x4f::mul(d.matrices[i], d.vectors[i]); });
+}
+
+TAU_BENCHMARK(Math, matrixVectorInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.vectorOut[i] = d.matrices[i] * d.vectors[i]; });
+}
+
+TAU_BENCHMARK(Math, matrixVectorGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmVectorOut[i] = d.glmMatrices[i] * d.glmVectors[i]; });
+}
+
+TAU_BENCHMARK(Math, transposeLL)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { matrix4x4f_transpose(d.matrices[i].mRaw, d.matrixOut[i].mRaw); });
+}
+
+TAU_BENCHMARK(Math, transposeSSE41)
+{
+    MathData d;
+    timeDispatched(state, MathISA::SSE41, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::transpose(d.matrices[i]); });
+}
+
+TAU_BENCHMARK(Math, transposeAVX2)
+{
+    MathData d;
+    timeDispatched(state, MathISA::AVX2, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::transpose(d.matrices[i]); });
+}
+
+TAU_BENCHMARK(Math, transposeInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { simd::matrix4x4f_transpose(d.matrices[i].columns(), d.matrixOut[i].columns()); });
+}
+
+TAU_BENCHMARK(Math, transposeGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmMatrixOut[i] = glm::transpose(d.glmMatrices[i]); });
+}
+
+TAU_BENCHMARK(Math, inverseSSE41)
+{
+    MathData d;
+    timeDispatched(state, MathISA::SSE41, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::inverse(d.matrices[i]); });
+}
+
+TAU_BENCHMARK(Math, inverseAVX2)
+{
+    MathData d;
+    timeDispatched(state, MathISA::AVX2, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::inverse(d.matrices[i]); });
+}
+
+TAU_BENCHMARK(Math, inverseInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { (void) simd::matrix4x4f_inverse(d.matrices[i].columns(), d.matrixOut[i].columns()); });
+}
+
+TAU_BENCHMARK(Math, inverseGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmMatrixOut[i] = glm::inverse(d.glmMatrices[i]); });
+}
+
+TAU_BENCHMARK(Math, affineInverseSSE41)
+{
+    MathData d;
+    timeDispatched(state, MathISA::SSE41, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::affineInverse(d.affine[i]); });
+}
+
+TAU_BENCHMARK(Math, affineInverseAVX2)
+{
+    MathData d;
+    timeDispatched(state, MathISA::AVX2, [&](const uSys i) noexcept { d.matrixOut[i] = Matrix4x4f::affineInverse(d.affine[i]); });
+}
+
+TAU_BENCHMARK(Math, affineInverseInline)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { (void) simd::matrix4x4f_affineInverse(d.affine[i].columns(), d.matrixOut[i].columns()); });
+}
+
+TAU_BENCHMARK(Math, affineInverseGlm)
+{
+    MathData d;
+    timeOps(state, [&](const uSys i) noexcept { d.glmMatrixOut[i] = glm::affineInverse(d.glmAffine[i]); });
+}
+
+/**
+ *   4096 points in structure of arrays layout, the same points as
+ * Vector4fs for the one at a time versions, and the six planes of
+ * a box centered on the origin. Every iteration processes all of
+ * them, divide by StreamCount for the time per element.
+ */
+class StreamData final
+{
+    DEFAULT_DESTRUCT(StreamData);
+    DELETE_CM(StreamData);
+public:
+    ::std::vector<float> x, y, z;
+    ::std::vector<float> outX, outY, outZ;
+    ::std::vector<float> radius;
+    ::std::vector<float> aos;
+    ::std::vector<Vector4f> vectors;
+    ::std::vector<Vector4f> vectorOut;
+    ::std::vector<u8> visible;
+    Matrix4x4f matrix;
+    Vector4f planes[6];
+public:
+    StreamData() noexcept
+        : x(StreamCount), y(StreamCount), z(StreamCount)
+        , outX(StreamCount), outY(StreamCount), outZ(StreamCount)
+        , radius(StreamCount)
+        , aos(StreamCount * 3)
+        , vectors(StreamCount)
+        , vectorOut(StreamCount)
+        , visible(StreamCount)
+        , matrix(Matrix4x4f::identity())
+        , planes {
+            Vector4f( 1.0f,  0.0f,  0.0f, 6.0f),
+            Vector4f(-1.0f,  0.0f,  0.0f, 6.0f),
+            Vector4f( 0.0f,  1.0f,  0.0f, 6.0f),
+            Vector4f( 0.0f, -1.0f,  0.0f, 6.0f),
+            Vector4f( 0.0f,  0.0f,  1.0f, 6.0f),
+            Vector4f( 0.0f,  0.0f, -1.0f, 6.0f)
+        }
+    {
+        for(uSys i = 0; i < StreamCount; ++i)
+        {
+            x[i] = static_cast<float>(i % 17) - 8.0f;
+            y[i] = static_cast<float>(i % 13) - 6.0f;
+            z[i] = static_cast<float>(i % 11) - 5.0f;
+            radius[i] = 1.0f;
+            vectors[i] = Vector4f(x[i], y[i], z[i], 1.0f);
+        }
+
+        matrix.m[3][0] = 1.0f;
+        matrix.m[3][1] = 2.0f;
+        matrix.m[3][2] = 3.0f;
+    }
+
+    void transformPoints() noexcept { MathStream::transformPoints(matrix, x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data(), StreamCount); }
+    void normalize() noexcept { MathStream::normalize(x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data(), StreamCount); }
+    void spheresVisible() noexcept { MathStream::spheresVisible(planes, 6, x.data(), y.data(), z.data(), radius.data(), visible.data(), StreamCount); }
+    void aabbsVisible() noexcept { MathStream::aabbsVisible(planes, 6, x.data(), y.data(), z.data(), radius.data(), radius.data(), radius.data(), visible.data(), StreamCount); }
+    void soaToAoS() noexcept { MathStream::soaToAoS(x.data(), y.data(), z.data(), aos.data(), 3, StreamCount); }
+    void aosToSoA() noexcept { MathStream::aosToSoA(aos.data(), 3, outX.data(), outY.data(), outZ.data(), StreamCount); }
+};
+
+template<typename _F>
+static void timeStream(BenchmarkState& state, _F func) noexcept
+{
+    for(const uSys i : state)
+    {
+        func();
+        Benchmarks::clobberMemory();
+        (void) i;
+    }
+}
+
+template<typename _F>
+static void timeStream(BenchmarkState& state, const MathISA isa, _F func) noexcept
+{ withISA(state, isa, [&]() noexcept { timeStream(state, func); }); }
+
+TAU_BENCHMARK(MathStream, transformSingle)
+{
+    StreamData d;
+    timeStream(state, [&]() noexcept
+    {
+        for(uSys i = 0; i < StreamCount; ++i)
+        { d.vectorOut[i] = d.matrix * d.vectors[i]; }
+    });
+}
+
+TAU_BENCHMARK(MathStream, transformSSE41)
+{
+    StreamData d;
+    timeStream(state, MathISA::SSE41, [&]() noexcept { d.transformPoints(); });
+}
+
+TAU_BENCHMARK(MathStream, transformAVX2)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX2, [&]() noexcept { d.transformPoints(); });
+}
+
+TAU_BENCHMARK(MathStream, transformAVX512)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX512, [&]() noexcept { d.transformPoints(); });
+}
+
+TAU_BENCHMARK(MathStream, normalizeSingle)
+{
+    StreamData d;
+    timeStream(state, [&]() noexcept
+    {
+        for(uSys i = 0; i < StreamCount; ++i)
+        { d.vectorOut[i] = simd::vector4f_normalizeExact(d.vectors[i].vec); }
+    });
+}
+
+TAU_BENCHMARK(MathStream, normalizeSSE41)
+{
+    StreamData d;
+    timeStream(state, MathISA::SSE41, [&]() noexcept { d.normalize(); });
+}
+
+TAU_BENCHMARK(MathStream, normalizeAVX2)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX2, [&]() noexcept { d.normalize(); });
+}
+
+TAU_BENCHMARK(MathStream, normalizeAVX512)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX512, [&]() noexcept { d.normalize(); });
+}
+
+TAU_BENCHMARK(MathStream, sphereCullingSingle)
+{
+    StreamData d;
+    timeStream(state, [&]() noexcept
+    {
+        for(uSys i = 0; i < StreamCount; ++i)
+        {
+            bool inside = true;
+            for(uSys p = 0; p < 6; ++p)
+            { inside &= simd::vector4f_dot(d.planes[p].vec, d.vectors[i].vec) >= -d.radius[i]; }
+            d.visible[i] = inside ? 1 : 0;
+        }
+    });
+}
+
+TAU_BENCHMARK(MathStream, sphereCullingSSE41)
+{
+    StreamData d;
+    timeStream(state, MathISA::SSE41, [&]() noexcept { d.spheresVisible(); });
+}
+
+TAU_BENCHMARK(MathStream, sphereCullingAVX2)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX2, [&]() noexcept { d.spheresVisible(); });
+}
+
+TAU_BENCHMARK(MathStream, sphereCullingAVX512)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX512, [&]() noexcept { d.spheresVisible(); });
+}
+
+TAU_BENCHMARK(MathStream, aabbCullingSSE41)
+{
+    StreamData d;
+    timeStream(state, MathISA::SSE41, [&]() noexcept { d.aabbsVisible(); });
+}
+
+TAU_BENCHMARK(MathStream, aabbCullingAVX2)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX2, [&]() noexcept { d.aabbsVisible(); });
+}
+
+TAU_BENCHMARK(MathStream, aabbCullingAVX512)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX512, [&]() noexcept { d.aabbsVisible(); });
+}
+
+TAU_BENCHMARK(MathStream, soaToAoSSSE41)
+{
+    StreamData d;
+    timeStream(state, MathISA::SSE41, [&]() noexcept { d.soaToAoS(); });
+}
+
+TAU_BENCHMARK(MathStream, soaToAoSAVX2)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX2, [&]() noexcept { d.soaToAoS(); });
+}
+
+TAU_BENCHMARK(MathStream, soaToAoSAVX512)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX512, [&]() noexcept { d.soaToAoS(); });
+}
+
+TAU_BENCHMARK(MathStream, aosToSoASSE41)
+{
+    StreamData d;
+    timeStream(state, MathISA::SSE41, [&]() noexcept { d.aosToSoA(); });
+}
+
+TAU_BENCHMARK(MathStream, aosToSoAAVX2)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX2, [&]() noexcept { d.aosToSoA(); });
+}
+
+TAU_BENCHMARK(MathStream, aosToSoAAVX512)
+{
+    StreamData d;
+    timeStream(state, MathISA::AVX512, [&]() noexcept { d.aosToSoA(); });
+}
@@ -0,0 +1,210 @@
+#include "UnitTest.hpp"
+#include "MathStreamTest.hpp"
+#include <MathStream.hpp>
+#include <cmath>
+
+/**
+ *   Every count up to this is tested so that each combination
+ * of wide lanes, 4 wide lanes and single lanes is covered.
+ */
+static constexpr uSys MaxCount = 37;
+
+static float valueAt(const uSys i, const uSys component) noexcept
+{ return static_cast<float>((i * 7 + component * 13) % 23) * 0.5f - 5.0f; }
+
+template<typename _F>
+static void forEachISA(_F func) noexcept
+{
+    const MathISA detected = mathDetectISA();
+    for(i32 isa = 0; isa <= static_cast<i32>(detected); ++isa)
+    {
+        (void) mathForceISA(static_cast<MathISA>(isa));
+        func();
+    }
+    (void) mathForceISA(detected);
+}
+
+TAU_TEST(MathStream, transformTest)
+{
+    Matrix4x4f matrix;
+    for(uSys i = 0; i < 16; ++i)
+    { matrix.mRaw[i] = static_cast<float>(i) * 0.25f - 1.0f; }
+
+    forEachISA([&]()
+    {
+        for(uSys count = 0; count <= MaxCount; ++count)
+        {
+            float x[MaxCount], y[MaxCount], z[MaxCount];
+            float outX[MaxCount], outY[MaxCount], outZ[MaxCount];
+            for(uSys i = 0; i < count; ++i)
+            {
+                x[i] = valueAt(i, 0);
+                y[i] = valueAt(i, 1);
+                z[i] = valueAt(i, 2);
+            }
+
+            MathStream::transformPoints(matrix, x, y, z, outX, outY, outZ, count);
+            for(uSys i = 0; i < count; ++i)
+            {
+                const Vector4f expected = Matrix4x4f::mul(matrix, Vector4f(x[i], y[i], z[i], 1.0f));
+                TAU_EXPECT_FPE_EQ_ABS(outX[i], expected.x, 1e-4f);
+                TAU_EXPECT_FPE_EQ_ABS(outY[i], expected.y, 1e-4f);
+                TAU_EXPECT_FPE_EQ_ABS(outZ[i], expected.z, 1e-4f);
+            }
+
+            MathStream::transformNormals(matrix, x, y, z, outX, outY, outZ, count);
+            for(uSys i = 0; i < count; ++i)
+            {
+                const Vector4f expected = Matrix4x4f::mul(matrix, Vector4f(x[i], y[i], z[i], 0.0f));
+                TAU_EXPECT_FPE_EQ_ABS(outX[i], expected.x, 1e-4f);
+                TAU_EXPECT_FPE_EQ_ABS(outY[i], expected.y, 1e-4f);
+                TAU_EXPECT_FPE_EQ_ABS(outZ[i], expected.z, 1e-4f);
+            }
+        }
+    });
+}
+
+TAU_TEST(MathStream, normalizeTest)
+{
+    forEachISA([&]()
+    {
+        for(uSys count = 0; count <= MaxCount; ++count)
+        {
+            float x[MaxCount], y[MaxCount], z[MaxCount];
+            for(uSys i = 0; i < count; ++i)
+            {
+                x[i] = valueAt(i, 0);
+                y[i] = valueAt(i, 1);
+                z[i] = valueAt(i, 2);
+            }
+
+            // A zero vector in the middle of the wide lanes.
+            if(count > 5)
+            {
+                x[5] = 0.0f;
+                y[5] = 0.0f;
+                z[5] = 0.0f;
+            }
+
+            float outX[MaxCount], outY[MaxCount], outZ[MaxCount];
+            MathStream::normalize(x, y, z, outX, outY, outZ, count);
+
+            for(uSys i = 0; i < count; ++i)
+            {
+                const float length = ::std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+                if(length == 0.0f)
+                {
+                    TAU_EXPECT_FP_EQ_ABS(outX[i], 0.0f);
+                    TAU_EXPECT_FP_EQ_ABS(outY[i], 0.0f);
+                    TAU_EXPECT_FP_EQ_ABS(outZ[i], 0.0f);
+                }
+                else
+                {
+                    TAU_EXPECT_FPE_EQ_ABS(outX[i], x[i] / length, 1e-5f);
+                    TAU_EXPECT_FPE_EQ_ABS(outY[i], y[i] / length, 1e-5f);
+                    TAU_EXPECT_FPE_EQ_ABS(outZ[i], z[i] / length, 1e-5f);
+                }
+            }
+
+            // In place.
+            MathStream::normalize(x, y, z, x, y, z, count);
+            for(uSys i = 0; i < count; ++i)
+            {
+                TAU_EXPECT_FP_EQ_ABS(x[i], outX[i]);
+                TAU_EXPECT_FP_EQ_ABS(y[i], outY[i]);
+                TAU_EXPECT_FP_EQ_ABS(z[i], outZ[i]);
+            }
+        }
+    });
+}
+
+TAU_TEST(MathStream, cullingTest)
+{
+    // The box [-10, 10] on each axis, with the normals facing inwards.
+    const Vector4f planes[6] = {
+        Vector4f( 1.0f,  0.0f,  0.0f, 10.0f),
+        Vector4f(-1.0f,  0.0f,  0.0f, 10.0f),
+        Vector4f( 0.0f,  1.0f,  0.0f, 10.0f),
+        Vector4f( 0.0f, -1.0f,  0.0f, 10.0f),
+        Vector4f( 0.0f,  0.0f,  1.0f, 10.0f),
+        Vector4f( 0.0f,  0.0f, -1.0f, 10.0f)
+    };
+
+    forEachISA([&]()
+    {
+        for(uSys count = 0; count <= MaxCount; ++count)
+        {
+            float x[MaxCount], y[MaxCount], z[MaxCount], size[MaxCount];
+            u8 spheres[MaxCount + 1];
+            u8 boxes[MaxCount + 1];
+            spheres[count] = 0xCC;
+            boxes[count] = 0xCC;
+
+            for(uSys i = 0; i < count; ++i)
+            {
+                // Every third object is placed outside of the box.
+                x[i] = i % 3 == 0 ? 12.0f + static_cast<float>(i % 4) : valueAt(i, 0);
+                y[i] = valueAt(i, 1);
+                z[i] = valueAt(i, 2);
+                size[i] = i % 6 == 0 ? 3.0f : 1.0f;
+            }
+
+            MathStream::spheresVisible(planes, 6, x, y, z, size, spheres, count);
+            MathStream::aabbsVisible(planes, 6, x, y, z, size, size, size, boxes, count);
+
+            for(uSys i = 0; i < count; ++i)
+            {
+                const bool visible = x[i] - size[i] <= 10.0f;
+                TAU_EXPECT_EQ(spheres[i], visible ? 1 : 0);
+                TAU_EXPECT_EQ(boxes[i], visible ? 1 : 0);
+            }
+
+            TAU_EXPECT_EQ(spheres[count], 0xCC);
+            TAU_EXPECT_EQ(boxes[count], 0xCC);
+        }
+    });
+}
+
+TAU_TEST(MathStream, layoutTest)
+{
+    forEachISA([&]()
+    {
+        for(uSys stride = 3; stride <= 5; ++stride)
+        {
+            for(uSys count = 0; count <= MaxCount; ++count)
+            {
+                float aos[MaxCount * 5];
+                float result[MaxCount * 5];
+                for(uSys i = 0; i < count * stride; ++i)
+                {
+                    aos[i] = static_cast<float>(i);
+                    result[i] = -1.0f;
+                }
+
+                float x[MaxCount], y[MaxCount], z[MaxCount];
+                MathStream::aosToSoA(aos, stride, x, y, z, count);
+
+                for(uSys i = 0; i < count; ++i)
+                {
+                    TAU_EXPECT_FP_EQ_ABS(x[i], aos[i * stride + 0]);
+                    TAU_EXPECT_FP_EQ_ABS(y[i], aos[i * stride + 1]);
+                    TAU_EXPECT_FP_EQ_ABS(z[i], aos[i * stride + 2]);
+                }
+
+                MathStream::soaToAoS(x, y, z, result, stride, count);
+
+                for(uSys i = 0; i < count * stride; ++i)
+                {
+                    // The padding between the vectors must be left alone.
+                    const float expected = i % stride < 3 ? aos[i] : -1.0f;
+                    TAU_EXPECT_FP_EQ_ABS(result[i], expected);
+                }
+            }
+        }
+    });
+}
+
+void MathStreamTest::runTests()
+{
+    RUN_ALL_TESTS();
+}
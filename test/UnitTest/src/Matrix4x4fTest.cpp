@@ -1,6 +1,7 @@
 #include "UnitTest.hpp"
 #include "Matrix4x4fTest.hpp"
 #include <Matrix4x4f.hpp>
+#include <Matrix4x4fIntrin.h>
 #include <Vector4f.hpp>
 
 namespace Matrix4x4fTests {
@@ -202,5 +203,211 @@ void mulVecTest() noexcept
     Assert(rEpsilonEquals(d.y, 104.0f));
     Assert(rEpsilonEquals(d.z, 176.0f));
     Assert(rEpsilonEquals(d.w, 248.0f));
+
+    const Vector4f e = a * b;
+    const Vector4f f = b * a;
+
+    Assert(rEpsilonEquals(e.x, 128.0f));
+    Assert(rEpsilonEquals(e.w, 182.0f));
+    Assert(rEpsilonEquals(f.x, 32.0f));
+    Assert(rEpsilonEquals(f.w, 248.0f));
+}
+
+void transposeTest() noexcept
+{
+    UNIT_TEST();
+    Matrix4x4f a { };
+    for(int i = 0; i < 16; ++i)
+    {
+        a.mRaw[i] = static_cast<float>(i);
+    }
+
+    const Matrix4x4f b = Matrix4x4f::transpose(a);
+
+    for(int i = 0; i < 4; ++i)
+    {
+        for(int j = 0; j < 4; ++j)
+        {
+            Assert(rEpsilonEquals(b.m[i][j], a.m[j][i]));
+        }
+    }
+}
+
+/**
+ * A matrix with a known inverse, all of the entries of both are integers.
+ */
+static Matrix4x4f invertibleMatrix() noexcept
+{
+    Matrix4x4f a { };
+    const float values[16] = {
+        2.0f, 1.0f, 0.0f, 0.0f,
+        1.0f, 2.0f, 1.0f, 0.0f,
+        0.0f, 1.0f, 2.0f, 1.0f,
+        0.0f, 0.0f, 1.0f, 2.0f
+    };
+    for(int i = 0; i < 16; ++i)
+    {
+        a.mRaw[i] = values[i];
+    }
+    return a;
+}
+
+void inverseTest() noexcept
+{
+    UNIT_TEST();
+    const Matrix4x4f a = invertibleMatrix();
+
+    bool invertible = false;
+    const Matrix4x4f b = Matrix4x4f::inverse(a, &invertible);
+    Assert(invertible);
+
+    const Matrix4x4f identity = Matrix4x4f::mul(a, b);
+    for(int i = 0; i < 4; ++i)
+    {
+        for(int j = 0; j < 4; ++j)
+        {
+            Assert(rEpsilonEquals(identity.m[i][j], i == j ? 1.0f : 0.0f));
+        }
+    }
+
+    // The inverse of the tridiagonal matrix is (1/5) * [4 -3 2 -1; ...].
+    Assert(rEpsilonEquals(b.m[0][0], 0.8f));
+    Assert(rEpsilonEquals(b.m[0][1], -0.6f));
+    Assert(rEpsilonEquals(b.m[0][2], 0.4f));
+    Assert(rEpsilonEquals(b.m[0][3], -0.2f));
+
+    Matrix4x4f singular { };
+    for(int i = 0; i < 16; ++i)
+    {
+        singular.mRaw[i] = static_cast<float>(i);
+    }
+
+    (void) Matrix4x4f::inverse(singular, &invertible);
+    Assert(!invertible);
+}
+
+void affineInverseTest() noexcept
+{
+    UNIT_TEST();
+    // Rotate 90 degrees about Z, scale by 2, then translate by (3, 4, 5).
+    Matrix4x4f a { };
+    a.m[0][1] = 2.0f;
+    a.m[1][0] = -2.0f;
+    a.m[2][2] = 2.0f;
+    a.m[3][0] = 3.0f;
+    a.m[3][1] = 4.0f;
+    a.m[3][2] = 5.0f;
+    a.m[3][3] = 1.0f;
+
+    bool invertible = false;
+    const Matrix4x4f b = Matrix4x4f::affineInverse(a, &invertible);
+    Assert(invertible);
+
+    const Matrix4x4f c = Matrix4x4f::inverse(a);
+    for(int i = 0; i < 16; ++i)
+    {
+        Assert(rEpsilonEquals(b.mRaw[i], c.mRaw[i]));
+    }
+
+    const Vector4f point(3.0f, 4.0f, 5.0f, 1.0f);
+    const Vector4f origin = Matrix4x4f::mul(b, point);
+    Assert(rEpsilonEquals(origin.x, 0.0f));
+    Assert(rEpsilonEquals(origin.y, 0.0f));
+    Assert(rEpsilonEquals(origin.z, 0.0f));
+    Assert(rEpsilonEquals(origin.w, 1.0f));
+}
+
+/**
+ *   `a * b` alone can't tell the operand order apart, so this
+ * uses two different matrices and checks every path against
+ * the IR function and a scalar reference.
+ */
+void mulOrderTest() noexcept
+{
+    UNIT_TEST();
+    const Matrix4x4f a = invertibleMatrix();
+    Matrix4x4f b { };
+    for(int i = 0; i < 16; ++i)
+    {
+        b.mRaw[i] = static_cast<float>(i);
+    }
+
+    Matrix4x4f ir { };
+    matrix4x4f_mul(a.mRaw, b.mRaw, ir.mRaw);
+
+    // m[column][row], the product applies `a` first and then `b`.
+    Matrix4x4f reference { };
+    for(int column = 0; column < 4; ++column)
+    {
+        for(int row = 0; row < 4; ++row)
+        {
+            float sum = 0.0f;
+            for(int k = 0; k < 4; ++k)
+            {
+                sum += b.m[k][row] * a.m[column][k];
+            }
+            reference.m[column][row] = sum;
+        }
+    }
+
+    const Vector4f v(3.0f, -4.0f, 5.0f, 1.0f);
+    const Vector4f applied = b * (a * v);
+
+    const MathISA detected = mathDetectISA();
+    for(int isa = 0; isa <= static_cast<int>(detected); ++isa)
+    {
+        Assert(mathForceISA(static_cast<MathISA>(isa)) == static_cast<MathISA>(isa));
+
+        const Matrix4x4f mul = Matrix4x4f::mul(a, b);
+        const Matrix4x4f inlineMul = a * b;
+
+        for(int i = 0; i < 16; ++i)
+        {
+            Assert(rEpsilonEquals(ir.mRaw[i], reference.mRaw[i]));
+            Assert(rEpsilonEquals(mul.mRaw[i], ir.mRaw[i]));
+            Assert(rEpsilonEquals(inlineMul.mRaw[i], ir.mRaw[i]));
+        }
+
+        const Vector4f product = mul * v;
+        Assert(rEpsilonEquals(product.x, applied.x));
+        Assert(rEpsilonEquals(product.y, applied.y));
+        Assert(rEpsilonEquals(product.z, applied.z));
+        Assert(rEpsilonEquals(product.w, applied.w));
+    }
+
+    (void) mathForceISA(detected);
+}
+
+void dispatchTest() noexcept
+{
+    UNIT_TEST();
+    const Matrix4x4f a = invertibleMatrix();
+    Matrix4x4f b { };
+    for(int i = 0; i < 16; ++i)
+    {
+        b.mRaw[i] = static_cast<float>(i);
+    }
+
+    // Every supported instruction set must match the inline layer.
+    const MathISA detected = mathDetectISA();
+    for(int isa = 0; isa <= static_cast<int>(detected); ++isa)
+    {
+        Assert(mathForceISA(static_cast<MathISA>(isa)) == static_cast<MathISA>(isa));
+
+        const Matrix4x4f mul = Matrix4x4f::mul(a, b);
+        const Matrix4x4f inlineMul = a * b;
+        const Matrix4x4f inverse = Matrix4x4f::inverse(a);
+
+        Matrix4x4f inlineInverse { };
+        (void) simd::matrix4x4f_inverse(a.columns(), inlineInverse.columns());
+
+        for(int i = 0; i < 16; ++i)
+        {
+            Assert(rEpsilonEquals(mul.mRaw[i], inlineMul.mRaw[i]));
+            Assert(rEpsilonEquals(inverse.mRaw[i], inlineInverse.mRaw[i]));
+        }
+    }
+
+    (void) mathForceISA(detected);
 }
 }
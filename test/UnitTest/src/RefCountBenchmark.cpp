@@ -0,0 +1,135 @@
+#include "Benchmark.hpp"
+#include <ReferenceCountingPointer.hpp>
+#include <AtomicIntrinsics.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using _ReferenceCountingPointerUtils::_BiasedRefCount;
+
+/*
+ *   The counting mode of the pointers is fixed at compile time,
+ * so each mode's counter is timed directly. A pointer copy and
+ * destruction is one increment and one decrement, which is what
+ * every iteration does.
+ *
+ *   The non-atomic count is volatile, otherwise the pair would be
+ * optimized away entirely.
+ */
+struct NonatomicCount final
+{
+    volatile uSys count = 1;
+
+    void addRef() noexcept { count = count + 1; }
+    void release() noexcept { count = count - 1; }
+};
+
+struct AtomicCount final
+{
+    volatile uSys count = 1;
+
+    void addRef() noexcept { (void) atomicIncrement(&count); }
+    void release() noexcept { (void) atomicDecrement(&count); }
+};
+
+struct BiasedCount final
+{
+    _BiasedRefCount count;
+
+    BiasedCount() noexcept
+        : count([](_BiasedRefCount*) noexcept { }, false)
+    { }
+
+    void addRef() noexcept { (void) count.addRef(); }
+    void release() noexcept { (void) count.release(); }
+};
+
+template<typename _Count>
+static void timeCopies(BenchmarkState& state, _Count& count) noexcept
+{
+    for(const uSys i : state)
+    {
+        count.addRef();
+        count.release();
+        (void) i;
+    }
+}
+
+/**
+ *   Every other hardware thread copies the pointer for as long as
+ * it is alive, as when loader threads hold references to resources
+ * that the render thread uses. Only the owning thread is timed.
+ */
+template<typename _Count>
+class ContendedCount final
+{
+    DELETE_CM(ContendedCount);
+public:
+    _Count count;
+private:
+    ::std::atomic<bool> _running;
+    ::std::vector<::std::thread> _threads;
+public:
+    ContendedCount() noexcept
+        : count()
+        , _running(true)
+    {
+        const uSys hardwareThreads = ::std::thread::hardware_concurrency();
+        const uSys threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+        for(uSys i = 0; i < threadCount; ++i)
+        {
+            _threads.emplace_back([this]()
+            {
+                while(_running.load(::std::memory_order_relaxed))
+                {
+                    for(uSys j = 0; j < 1024; ++j)
+                    {
+                        count.addRef();
+                        count.release();
+                    }
+                }
+            });
+        }
+    }
+
+    ~ContendedCount() noexcept
+    {
+        _running = false;
+        for(::std::thread& thread : _threads)
+        { thread.join(); }
+    }
+};
+
+TAU_BENCHMARK(RefCount, nonatomic)
+{
+    NonatomicCount count;
+    timeCopies(state, count);
+}
+
+TAU_BENCHMARK(RefCount, atomic)
+{
+    AtomicCount count;
+    timeCopies(state, count);
+}
+
+TAU_BENCHMARK(RefCount, biased)
+{
+    BiasedCount count;
+    timeCopies(state, count);
+}
+
+/**
+ * Non-atomic counting can't be shared between threads.
+ */
+TAU_BENCHMARK(RefCount, atomicShared)
+{
+    ContendedCount<AtomicCount> shared;
+    timeCopies(state, shared.count);
+}
+
+TAU_BENCHMARK(RefCount, biasedShared)
+{
+    ContendedCount<BiasedCount> shared;
+    timeCopies(state, shared.count);
+}
@@ -1,5 +1,6 @@
 #include <ReferenceCountingPointer.hpp>
 #include "UnitTest.hpp"
+#include <thread>
 
 static int _dataIndex = 0;
 
@@ -293,4 +294,77 @@ void strongParentChildReverseTest() noexcept
     parent->destroyChild();
 }
 
+
+static uSys _biasedDestroyCount = 0;
+static ::std::thread::id _biasedDestroyThread;
+
+static void biasedDestroy(_ReferenceCountingPointerUtils::_BiasedRefCount*) noexcept
+{
+    ++_biasedDestroyCount;
+    _biasedDestroyThread = ::std::this_thread::get_id();
+}
+
+/*
+ *   These use the counter directly so that they run regardless
+ * of the counting mode the pointers were compiled with.
+ */
+void biasedRefCountTest() noexcept
+{
+    UNIT_TEST();
+
+    using _ReferenceCountingPointerUtils::_BiasedRefCount;
+    using _ReferenceCountingPointerUtils::_BiasedRefCountQueue;
+
+    _biasedDestroyCount = 0;
+    _BiasedRefCount refCount(biasedDestroy, false);
+    Assert(refCount.addRef() == 2);
+    Assert(refCount.count() == 2);
+
+    // Another thread releases a reference the owner handed to it, it can't be destroyed until the owner merges.
+    ::std::thread([&refCount]() { Assert(refCount.release() != 0); }).join();
+    Assert(_biasedDestroyCount == 0);
+
+    Assert(_BiasedRefCountQueue::local()->process() == 1);
+    Assert(refCount._biased == 0);
+    Assert(refCount.count() == 1);
+    Assert(_biasedDestroyCount == 0);
+
+    Assert(refCount.release() == 0);
+}
+
+void biasedDeferredReleaseTest() noexcept
+{
+    UNIT_TEST();
+
+    using _ReferenceCountingPointerUtils::_BiasedRefCount;
+    using _ReferenceCountingPointerUtils::_BiasedRefCountQueue;
+
+    _biasedDestroyCount = 0;
+    _BiasedRefCount refCount(biasedDestroy, true);
+    Assert(refCount.addRef() == 2);
+
+    ::std::thread other([&refCount]()
+    {
+        (void) refCount.addRef();
+        Assert(refCount.release() != 0);
+    });
+    other.join();
+
+    // The owner releases everything it holds while the other thread keeps its reference.
+    ::std::thread holder([&refCount]() { (void) refCount.addRef(); });
+    holder.join();
+    Assert(refCount.release() != 0);
+    Assert(refCount.release() != 0);
+    Assert(refCount._biased == 0);
+    Assert(refCount.count() == 1);
+
+    // The last reference is released elsewhere, destruction is left to the owner.
+    ::std::thread([&refCount]() { Assert(refCount.release() != 0); }).join();
+    Assert(_biasedDestroyCount == 0);
+
+    Assert(_BiasedRefCountQueue::local()->process() == 1);
+    Assert(_biasedDestroyCount == 1);
+    Assert(_biasedDestroyThread == ::std::this_thread::get_id());
+}
+
 }
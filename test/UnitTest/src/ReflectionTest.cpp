@@ -0,0 +1,179 @@
+#include "UnitTest.hpp"
+#include "ReflectionTest.hpp"
+#include "TestRandom.hpp"
+#include <reflection/processing/PerfectHash.hpp>
+#include "../../../utils/TauReflectionGenerator/test/Base.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using tau::reflection::processing::PerfectHash;
+
+/**
+ *   The tables the generator writes into a class's body, and
+ * the lookup its generated `PropertyIndex` performs with them.
+ */
+struct GeneratedLookup final
+{
+    ::std::vector<const char*> names;
+    ::std::vector<unsigned> lengths;
+    ::std::vector<u32> seeds;
+    ::std::vector<u32> indices;
+
+    GeneratedLookup(const ::std::vector<DynString>& properties, const PerfectHash& hash) noexcept
+        : seeds(hash.seeds())
+        , indices(hash.slots())
+    {
+        for(const u32 index : hash.slots())
+        {
+            names.push_back(properties[index].c_str());
+            lengths.push_back(static_cast<unsigned>(properties[index].length()));
+        }
+    }
+
+    [[nodiscard]] unsigned propertyIndex(const char* const propName) const noexcept
+    {
+        const unsigned length = _tauNameLength(propName);
+        const unsigned hash = _tauNameHash(propName, length);
+        const unsigned slot = _tauReduce(_tauSlotHash(hash, seeds[_tauReduce(hash, static_cast<unsigned>(seeds.size()))]), static_cast<unsigned>(indices.size()));
+        if(length != lengths[slot] || !_tauNameEquals(propName, names[slot], length))
+        { return static_cast<unsigned>(-1); }
+        return indices[slot];
+    }
+};
+
+/**
+ * Property style names, a mix of short and long ones with shared prefixes.
+ */
+static ::std::vector<DynString> propertyNames(const uSys count, u32 random) noexcept
+{
+    static constexpr const char* Prefixes[] = { "_", "_m", "_position", "_transform", "_renderTargetView", "_x" };
+
+    ::std::vector<DynString> names;
+    for(uSys i = 0; i < count; ++i)
+    {
+        ::std::string name = Prefixes[nextRandom(random) % (sizeof(Prefixes) / sizeof(Prefixes[0]))];
+        name += ::std::to_string(i);
+        names.emplace_back(name.c_str());
+    }
+    return names;
+}
+
+/**
+ *   The generator's hashes must produce the same values as the
+ * constexpr ones it writes into the base header.
+ */
+TAU_TEST(PerfectHash, hashesMatchBaseHeader)
+{
+    u32 random = 0x4A54;
+    for(const DynString& name : propertyNames(256, 0x4A54))
+    {
+        const u32 hash = tau::reflection::processing::nameHash(name.c_str(), name.length());
+        TAU_EXPECT_EQ(hash, _tauNameHash(name.c_str(), static_cast<unsigned>(name.length())));
+
+        const u32 seed = nextRandom(random);
+        TAU_EXPECT_EQ(tau::reflection::processing::slotHash(hash, seed), _tauSlotHash(hash, seed));
+
+        const u32 count = nextRandom(random) % 1000 + 1;
+        TAU_EXPECT_EQ(tau::reflection::processing::reduceHash(hash, count), _tauReduce(hash, count));
+    }
+}
+
+TAU_TEST(PerfectHash, everyNameResolves)
+{
+    for(const uSys count : { 1, 2, 3, 5, 16, 64, 200, 500 })
+    {
+        const ::std::vector<DynString> names = propertyNames(count, static_cast<u32>(count));
+        const PerfectHash hash(names);
+        TAU_ASSERT(hash.slotCount() == count);
+        TAU_EXPECT(hash.bucketCount() >= 1 && hash.bucketCount() <= count);
+
+        /**
+         * The slots are a permutation of the names.
+         */
+        ::std::vector<bool> used(count, false);
+        for(const u32 index : hash.slots())
+        {
+            TAU_ASSERT(index < count);
+            TAU_EXPECT(!used[index]);
+            used[index] = true;
+        }
+
+        const GeneratedLookup lookup(names, hash);
+        for(uSys i = 0; i < count; ++i)
+        {
+            const u32 slot = hash.slot(tau::reflection::processing::nameHash(names[i].c_str(), names[i].length()));
+            TAU_ASSERT(slot < count);
+            TAU_EXPECT_EQ(hash.slots()[slot], static_cast<u32>(i));
+            TAU_EXPECT_EQ(lookup.propertyIndex(names[i].c_str()), static_cast<unsigned>(i));
+        }
+    }
+}
+
+/**
+ * The index of the name by a linear search, what the lookup must return.
+ */
+static unsigned linearIndex(const ::std::vector<DynString>& names, const ::std::string& name) noexcept
+{
+    for(uSys i = 0; i < names.size(); ++i)
+    {
+        if(name == names[i].c_str())
+        { return static_cast<unsigned>(i); }
+    }
+    return static_cast<unsigned>(-1);
+}
+
+TAU_TEST(PerfectHash, unknownNamesRejected)
+{
+    static constexpr unsigned Invalid = static_cast<unsigned>(-1);
+
+    for(const uSys count : { 1, 5, 64, 200 })
+    {
+        const ::std::vector<DynString> names = propertyNames(count, static_cast<u32>(count) * 3);
+        const PerfectHash hash(names);
+        TAU_ASSERT(hash.slotCount() == count);
+        const GeneratedLookup lookup(names, hash);
+
+        TAU_EXPECT_EQ(lookup.propertyIndex(""), Invalid);
+        TAU_EXPECT_EQ(lookup.propertyIndex("_unknown"), Invalid);
+
+        for(const DynString& name : names)
+        {
+            const ::std::string original = name.c_str();
+
+            /**
+             *   Prefixes, extensions and single character changes of
+             * every name, some of which share a length and slot with
+             * a real name. A prefix may itself be another name.
+             */
+            ::std::string changed = original.substr(0, original.size() - 1);
+            TAU_EXPECT_EQ(lookup.propertyIndex(changed.c_str()), linearIndex(names, changed));
+
+            changed = original + "_";
+            TAU_EXPECT_EQ(lookup.propertyIndex(changed.c_str()), Invalid);
+
+            changed = original;
+            changed.back() = changed.back() == 'z' ? 'y' : 'z';
+            TAU_EXPECT_EQ(lookup.propertyIndex(changed.c_str()), Invalid);
+
+            changed = original;
+            changed[0] = '-';
+            TAU_EXPECT_EQ(lookup.propertyIndex(changed.c_str()), Invalid);
+        }
+    }
+}
+
+TAU_TEST(PerfectHash, emptySet)
+{
+    const PerfectHash hash({ });
+    TAU_EXPECT_EQ(hash.slotCount(), 0u);
+    TAU_EXPECT_EQ(hash.bucketCount(), 0u);
+    TAU_EXPECT_EQ(hash.slot(tau::reflection::processing::nameHash("_x", 2)), PerfectHash::INVALID_SLOT);
+}
+
+namespace ReflectionTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -0,0 +1,43 @@
+#include "Benchmark.hpp"
+#include "TestFont.hpp"
+#include <SDFGenerator.hpp>
+#include <thread>
+
+/**
+ *   Each iteration generates the printable ASCII range of the
+ * test font, 95 glyphs, at a 32 pixel em size.
+ */
+static void generateASCII(BenchmarkState& state, const u32 workerCount) noexcept
+{
+    FT_Library ft;
+    if(FT_Init_FreeType(&ft))
+    { return; }
+
+    {
+        const RefDynArray<u8> font = loadTestFont();
+
+        u32 codepoints[95];
+        for(u32 i = 0; i < 95; ++i)
+        { codepoints[i] = 32 + i; }
+
+        SDFArgs args;
+        args.emSize = 32;
+        args.spread = 4.0f;
+        args.workerCount = workerCount;
+
+        for(const uSys i : state)
+        {
+            const ::std::vector<SDFGlyph> glyphs = SDFGenerator::generate(ft, font, codepoints, 95, args);
+            Benchmarks::doNotOptimize(glyphs.data());
+            (void) i;
+        }
+    }
+
+    FT_Done_FreeType(ft);
+}
+
+TAU_BENCHMARK(SDF, generateSerial)
+{ generateASCII(state, 1); }
+
+TAU_BENCHMARK(SDF, generateParallel)
+{ generateASCII(state, ::std::thread::hardware_concurrency() ? ::std::thread::hardware_concurrency() : 1); }
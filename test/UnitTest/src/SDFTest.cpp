@@ -0,0 +1,237 @@
+#include "UnitTest.hpp"
+#include "SDFTest.hpp"
+#include "TestFont.hpp"
+#include <SDFGenerator.hpp>
+#include <algorithm>
+
+static constexpr u32 EmSize = 32;
+static constexpr u8 Edge = 128;
+
+/**
+ * Owns a FreeType library and a face of the test font for the duration of a test.
+ */
+class SDFFont final
+{
+    DELETE_CM(SDFFont);
+public:
+    RefDynArray<u8> data;
+    FT_Library ft;
+    FT_Face face;
+    bool valid;
+public:
+    SDFFont() noexcept
+        : data(loadTestFont())
+        , ft(null)
+        , face(null)
+        , valid(false)
+    {
+        if(data.size() <= 1 || FT_Init_FreeType(&ft))
+        { return; }
+
+        valid = !FT_New_Memory_Face(ft, data.arr(), static_cast<FT_Long>(data.size() - 1), 0, &face);
+    }
+
+    ~SDFFont() noexcept
+    {
+        if(face)
+        { FT_Done_Face(face); }
+        if(ft)
+        { FT_Done_FreeType(ft); }
+    }
+};
+
+static SDFArgs testArgs() noexcept
+{
+    SDFArgs args;
+    args.emSize = EmSize;
+    args.spread = 4.0f;
+    args.workerCount = 1;
+    return args;
+}
+
+/**
+ *   Every texel that FreeType fully covers is inside the field,
+ * and every texel it doesn't touch is outside.
+ */
+TAU_TEST(SDF, distanceSign)
+{
+    SDFFont font;
+    TAU_ASSERT(font.valid);
+
+    for(const u32 codepoint : { u32 { 'I' }, u32 { 'O' }, u32 { 'g' } })
+    {
+        SDFGlyph glyph;
+        TAU_ASSERT(SDFGenerator::generate(font.face, codepoint, testArgs(), &glyph));
+        TAU_ASSERT(glyph.width > 0 && glyph.height > 0);
+
+        TAU_ASSERT(!FT_Load_Char(font.face, codepoint, FT_LOAD_RENDER | FT_LOAD_NO_HINTING));
+        const FT_Bitmap& bitmap = font.face->glyph->bitmap;
+        const i32 offsetX = font.face->glyph->bitmap_left - glyph.bearingX;
+        const i32 offsetY = glyph.bearingY - font.face->glyph->bitmap_top;
+
+        u32 inside = 0;
+        u32 outside = 0;
+        u32 wrong = 0;
+
+        for(u32 row = 0; row < glyph.height; ++row)
+        {
+            for(u32 column = 0; column < glyph.width; ++column)
+            {
+                const i32 x = static_cast<i32>(column) - offsetX;
+                const i32 y = static_cast<i32>(row) - offsetY;
+                const u8 coverage = x >= 0 && y >= 0 && x < static_cast<i32>(bitmap.width) && y < static_cast<i32>(bitmap.rows) ?
+                    bitmap.buffer[y * bitmap.pitch + x] : 0;
+                const u8 distance = glyph.pixels[static_cast<uSys>(row) * glyph.width + column];
+
+                if(coverage == 255)
+                {
+                    ++inside;
+                    if(distance <= Edge) { ++wrong; }
+                }
+                else if(coverage == 0)
+                {
+                    ++outside;
+                    if(distance >= Edge) { ++wrong; }
+                }
+            }
+        }
+
+        TAU_EXPECT(inside > 0);
+        TAU_EXPECT(outside > 0);
+        TAU_EXPECT_EQ(wrong, 0u);
+    }
+}
+
+/**
+ *   The padding is the spread rounded up, so border texel
+ * centers are at least `spread - 0.5` outside the outline. With
+ * a spread of 4 that is at most 255 * (0.5 - 3.5 / 8), 16.
+ */
+TAU_TEST(SDF, distanceRange)
+{
+    static constexpr u8 MaxBorder = 16;
+
+    SDFFont font;
+    TAU_ASSERT(font.valid);
+
+    SDFGlyph glyph;
+    TAU_ASSERT(SDFGenerator::generate(font.face, 'I', testArgs(), &glyph));
+
+    u8 border = 0;
+    for(u32 column = 0; column < glyph.width; ++column)
+    {
+        border = ::std::max(border, glyph.pixels[column]);
+        border = ::std::max(border, glyph.pixels[static_cast<uSys>(glyph.height - 1) * glyph.width + column]);
+    }
+    for(u32 row = 0; row < glyph.height; ++row)
+    {
+        border = ::std::max(border, glyph.pixels[static_cast<uSys>(row) * glyph.width]);
+        border = ::std::max(border, glyph.pixels[static_cast<uSys>(row) * glyph.width + glyph.width - 1]);
+    }
+    TAU_EXPECT(border <= MaxBorder);
+
+    /**
+     *   Across the stem of the I at half height the field rises to
+     * a single maximum inside the stem and falls off either side.
+     */
+    const u8* const middle = glyph.pixels.data() + static_cast<uSys>(glyph.height / 2) * glyph.width;
+    u32 peak = 0;
+    for(u32 column = 1; column < glyph.width; ++column)
+    {
+        if(middle[column] > middle[peak])
+        { peak = column; }
+    }
+
+    TAU_EXPECT(middle[peak] > Edge);
+    for(u32 column = 1; column <= peak; ++column)
+    { TAU_EXPECT(middle[column] >= middle[column - 1]); }
+    for(u32 column = peak + 1; column < glyph.width; ++column)
+    { TAU_EXPECT(middle[column] <= middle[column - 1]); }
+}
+
+TAU_TEST(SDF, blankAndMissing)
+{
+    SDFFont font;
+    TAU_ASSERT(font.valid);
+
+    SDFGlyph glyph;
+    TAU_EXPECT(SDFGenerator::generate(font.face, ' ', testArgs(), &glyph));
+    TAU_EXPECT_EQ(glyph.width, 0u);
+    TAU_EXPECT(glyph.pixels.empty());
+    TAU_EXPECT(glyph.advance > 0);
+
+    TAU_EXPECT(!SDFGenerator::generate(font.face, 0x4E00, testArgs(), &glyph));
+    TAU_EXPECT_EQ(glyph.advance, 0u);
+}
+
+/**
+ * Splitting a set across workers produces the same glyphs as generating them one at a time.
+ */
+TAU_TEST(SDF, parallelMatchesSerial)
+{
+    SDFFont font;
+    TAU_ASSERT(font.valid);
+
+    u32 codepoints[95];
+    for(u32 i = 0; i < 95; ++i)
+    { codepoints[i] = 32 + i; }
+
+    SDFArgs args = testArgs();
+    args.workerCount = 4;
+    const ::std::vector<SDFGlyph> glyphs = SDFGenerator::generate(font.ft, font.data, codepoints, 95, args);
+    TAU_ASSERT(glyphs.size() == 95);
+
+    for(u32 i = 0; i < 95; ++i)
+    {
+        SDFGlyph serial;
+        (void) SDFGenerator::generate(font.face, codepoints[i], testArgs(), &serial);
+
+        TAU_EXPECT_EQ(glyphs[i].codepoint, codepoints[i]);
+        TAU_EXPECT_EQ(glyphs[i].width, serial.width);
+        TAU_EXPECT_EQ(glyphs[i].height, serial.height);
+        TAU_EXPECT_EQ(glyphs[i].advance, serial.advance);
+        TAU_EXPECT(glyphs[i].pixels == serial.pixels);
+    }
+}
+
+/**
+ *   A single SDF set replaces a bitmap set per drawn size, and
+ * is smaller than the bitmap sets for the common text sizes.
+ */
+TAU_TEST(SDF, smallerThanBitmapSets)
+{
+    static constexpr FT_UInt BitmapSizes[] = { 16, 24, 32, 48, 64, 96 };
+
+    SDFFont font;
+    TAU_ASSERT(font.valid);
+
+    uSys sdfBytes = 0;
+    for(u32 c = 32; c < 127; ++c)
+    {
+        SDFGlyph glyph;
+        if(SDFGenerator::generate(font.face, c, testArgs(), &glyph))
+        { sdfBytes += glyph.pixels.size(); }
+    }
+
+    uSys bitmapBytes = 0;
+    for(const FT_UInt size : BitmapSizes)
+    {
+        FT_Set_Pixel_Sizes(font.face, 0, size);
+        for(u32 c = 32; c < 127; ++c)
+        {
+            if(FT_Load_Char(font.face, c, FT_LOAD_RENDER))
+            { continue; }
+            bitmapBytes += static_cast<uSys>(font.face->glyph->bitmap.width) * font.face->glyph->bitmap.rows;
+        }
+    }
+
+    TAU_EXPECT(sdfBytes > 0);
+    TAU_EXPECT(sdfBytes < bitmapBytes);
+}
+
+namespace SDFTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
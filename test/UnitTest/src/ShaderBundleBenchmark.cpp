@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+#include <shader/bundle/ShaderBundleBinary.hpp>
+#include <shader/bundle/ShaderInfoExtractorVisitor.hpp>
+#include <MemoryFile.hpp>
+#include <cstring>
+
+/**
+ * The deferred lighting bundle from the editor resources.
+ */
+static constexpr const char* BenchBundle =
+    "DirectX10, DirectX11: {\n"
+    "    Vertex: {\n"
+    "        File: \"FBVertex.cso\"\n"
+    "    },\n"
+    "    Pixel: {\n"
+    "        File: \"FBPixel.cso\",\n"
+    "        Uniforms: {\n"
+    "            0: 0,\n"
+    "            1: 1,\n"
+    "            CRMUniformBindingCameraStatic: 2\n"
+    "        },\n"
+    "        Textures: {\n"
+    "            CRMTextureDiffuse: 0,\n"
+    "            CRMTexturePosition: 1,\n"
+    "            CRMTextureNormal: 2,\n"
+    "            CRMTexturePBRCompound: 3,\n"
+    "            CRMTextureDepth: 4\n"
+    "        }\n"
+    "    }\n"
+    "},\n"
+    "OpenGL4_5, OpenGL4_6: {\n"
+    "    Vertex: {\n"
+    "        File: \"FBVertex.glsl\"\n"
+    "    },\n"
+    "    Pixel: {\n"
+    "        File: \"FBPixel.glsl\",\n"
+    "        Textures: {\n"
+    "            CRMTextureDiffuse: 0,\n"
+    "            CRMTexturePosition: 1,\n"
+    "            CRMTextureNormal: 2,\n"
+    "            CRMTexturePBRCompound: 3,\n"
+    "            CRMTextureDepth: 4\n"
+    "        }\n"
+    "    }\n"
+    "}\n";
+
+static constexpr const wchar_t* TextPath = L"shaderBundleBenchmark\\bundle.tausi";
+static constexpr const wchar_t* BinaryPath = L"shaderBundleBenchmark\\bundle.tausb";
+
+static void writeBenchBundles() noexcept
+{
+    {
+        const CPPRef<IFile> text = MemoryFileLoader::Instance()->load(TextPath, FileProps::WriteOverwrite);
+        (void) text->writeBytes(reinterpret_cast<const u8*>(BenchBundle), ::std::strlen(BenchBundle));
+    }
+
+    ShaderBundleCompiler::Error error;
+    (void) ShaderBundleCompiler::compile(MemoryFileLoader::Instance()->load(TextPath, FileProps::Read), MemoryFileLoader::Instance()->load(BinaryPath, FileProps::WriteOverwrite), &error);
+}
+
+/**
+ * Loading the text bundle runs the lexer and parser every time.
+ */
+TAU_BENCHMARK(ShaderBundle, loadText)
+{
+    writeBenchBundles();
+    ShaderInfoExtractorVisitor visitor(RenderingMode::Mode::DirectX11);
+
+    for(const uSys i : state)
+    {
+        (void) ShaderBundleLoader::load(MemoryFileLoader::Instance()->load(TextPath, FileProps::Read), visitor);
+        Benchmarks::doNotOptimize(visitor);
+        (void) i;
+    }
+}
+
+/**
+ * The compiled bundle is validated and read in place.
+ */
+TAU_BENCHMARK(ShaderBundle, loadCompiled)
+{
+    writeBenchBundles();
+    ShaderInfoExtractorVisitor visitor(RenderingMode::Mode::DirectX11);
+
+    for(const uSys i : state)
+    {
+        (void) ShaderBundleLoader::load(MemoryFileLoader::Instance()->load(BinaryPath, FileProps::Read), visitor);
+        Benchmarks::doNotOptimize(visitor);
+        (void) i;
+    }
+}
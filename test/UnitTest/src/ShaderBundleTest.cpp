@@ -0,0 +1,183 @@
+#include "UnitTest.hpp"
+#include "ShaderBundleTest.hpp"
+#include <shader/bundle/ShaderBundleBinary.hpp>
+#include <shader/bundle/ShaderBundleParser.hpp>
+#include <MemoryFile.hpp>
+#include <cstring>
+#include <vector>
+
+static constexpr const char* TestBundle =
+    "DirectX11: {\n"
+    "    Vertex: {\n"
+    "        File: \"Vertex.cso\",\n"
+    "        Uniforms: {\n"
+    "            0: \"CameraMatrices\"\n"
+    "        }\n"
+    "    },\n"
+    "    Pixel: {\n"
+    "        File: \"Pixel.cso\",\n"
+    "        Textures: {\n"
+    "            CRMTextureDiffuse: 0\n"
+    "        }\n"
+    "    }\n"
+    "}\n";
+
+static CPPRef<IFile> writeFile(const wchar_t* const path, const void* const data, const uSys length) noexcept
+{
+    {
+        const CPPRef<IFile> file = MemoryFileLoader::Instance()->load(path, FileProps::WriteOverwrite);
+        (void) file->writeBytes(reinterpret_cast<const u8*>(data), length);
+    }
+    return MemoryFileLoader::Instance()->load(path, FileProps::Read);
+}
+
+static ::std::vector<u8> compileTestBundle() noexcept
+{
+    const CPPRef<IFile> text = writeFile(L"shaderBundleTest\\bundle.tausi", TestBundle, ::std::strlen(TestBundle));
+
+    ShaderBundleParser parser(text);
+    ShaderBundleParser::Error parseError;
+    const NullableStrongRef<sbp::AST> ast = parser.parse(&parseError);
+
+    ::std::vector<u8> image;
+    if(!ast || parseError != ShaderBundleParser::Error::NoError)
+    { return image; }
+
+    ShaderBundleCompiler compiler;
+    ShaderBundleCompiler::Error error;
+    (void) compiler.compile(*ast.get(), image, &error);
+    return image;
+}
+
+static sbp::bin::Header& header(::std::vector<u8>& image) noexcept
+{ return *reinterpret_cast<sbp::bin::Header*>(image.data()); }
+
+/**
+ *   Restores the checksum after a deliberate corruption, so the
+ * structural checks are what rejects the bundle.
+ */
+static void reseal(::std::vector<u8>& image) noexcept
+{ header(image).checksum = sbp::bin::checksum(image.data() + sizeof(sbp::bin::Header), image.size() - sizeof(sbp::bin::Header)); }
+
+static CompiledShaderBundle::Error loadImage(const ::std::vector<u8>& image) noexcept
+{
+    const CPPRef<IFile> file = writeFile(L"shaderBundleTest\\bundle.tausb", image.data(), image.size());
+
+    CompiledShaderBundle::Error error;
+    const CompiledShaderBundle bundle = CompiledShaderBundle::load(file, &error);
+    if(error == CompiledShaderBundle::Error::NoError && !bundle)
+    { return CompiledShaderBundle::Error::InvalidFile; }
+    return error;
+}
+
+static sbp::bin::Binding* findBinding(::std::vector<u8>& image, const sbp::bin::Binding::Type type) noexcept
+{
+    const sbp::bin::Header& head = header(image);
+    const sbp::bin::APIBlock* const block = reinterpret_cast<const sbp::bin::APIBlock*>(image.data() + head.apiBlockOffset);
+
+    for(uSys i = 0; i < sbp::bin::StageCount; ++i)
+    {
+        if(!block->stageOffsets[i])
+        { continue; }
+
+        sbp::bin::Stage* const stage = reinterpret_cast<sbp::bin::Stage*>(image.data() + block->stageOffsets[i]);
+        sbp::bin::Binding* const bindings = const_cast<sbp::bin::Binding*>(stage->bindings());
+        for(uSys j = 0; j < static_cast<uSys>(stage->uniformCount + stage->textureCount); ++j)
+        {
+            if(bindings[j].type == type)
+            { return &bindings[j]; }
+        }
+    }
+    return nullptr;
+}
+
+TAU_TEST(ShaderBundle, validBundle)
+{
+    const ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::NoError);
+}
+
+TAU_TEST(ShaderBundle, corruptChecksum)
+{
+    ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+
+    image.back() ^= 0xFF;
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+}
+
+TAU_TEST(ShaderBundle, corruptStringBinding)
+{
+    ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+
+    sbp::bin::Binding* const binding = findBinding(image, sbp::bin::Binding::Str);
+    TAU_ASSERT(binding);
+
+    binding->value = header(image).stringTableSize;
+    reseal(image);
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+
+    binding->value = 0xFFFFFFF0;
+    reseal(image);
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+}
+
+TAU_TEST(ShaderBundle, unterminatedString)
+{
+    ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+
+    const sbp::bin::Header& head = header(image);
+    u8* const table = image.data() + head.stringTableOffset;
+    for(u32 i = 0; i < head.stringTableSize; ++i)
+    {
+        if(table[i] == '\0')
+        { table[i] = 'x'; }
+    }
+    reseal(image);
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+}
+
+TAU_TEST(ShaderBundle, corruptBindingType)
+{
+    ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+
+    sbp::bin::Binding* const binding = findBinding(image, sbp::bin::Binding::Number);
+    TAU_ASSERT(binding);
+
+    binding->type = static_cast<sbp::bin::Binding::Type>(7);
+    reseal(image);
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+}
+
+TAU_TEST(ShaderBundle, misalignedStringTable)
+{
+    ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+
+    header(image).stringTableOffset += 1;
+    header(image).stringTableSize -= 1;
+    reseal(image);
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+}
+
+TAU_TEST(ShaderBundle, truncatedBundle)
+{
+    ::std::vector<u8> image = compileTestBundle();
+    TAU_ASSERT(!image.empty());
+
+    image.resize(image.size() - 4);
+    header(image).fileSize = static_cast<u32>(image.size());
+    reseal(image);
+    TAU_EXPECT_EQ(loadImage(image), CompiledShaderBundle::Error::CorruptFile);
+}
+
+namespace ShaderBundleTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -0,0 +1,186 @@
+#include "Benchmark.hpp"
+#include "HeadlessStates.hpp"
+#include "TestRandom.hpp"
+#include <graphics/StateCache.hpp>
+#include <vector>
+
+static constexpr uSys FrameDraws = 4096;
+
+static bool sameArgs(const BlendingArgs& a, const BlendingArgs& b) noexcept
+{
+    if(a.independentBlending != b.independentBlending)
+    { return false; }
+
+    for(uSys i = 0; i < 8; ++i)
+    {
+        const BlendingArgs::FrameBufferBlendingArgs& fa = a.frameBuffers[i];
+        const BlendingArgs::FrameBufferBlendingArgs& fb = b.frameBuffers[i];
+        if(fa.enableBlending != fb.enableBlending ||
+           fa.colorSrcFactor != fb.colorSrcFactor || fa.colorDstFactor != fb.colorDstFactor ||
+           fa.alphaSrcFactor != fb.alphaSrcFactor || fa.alphaDstFactor != fb.alphaDstFactor ||
+           fa.colorBlendOp != fb.colorBlendOp || fa.alphaBlendOp != fb.alphaBlendOp)
+        { return false; }
+    }
+    return true;
+}
+
+static bool sameArgs(const DepthStencilArgs::StencilOpArgs& a, const DepthStencilArgs::StencilOpArgs& b) noexcept
+{
+    return a.failOp == b.failOp && a.stencilPassDepthFailOp == b.stencilPassDepthFailOp &&
+           a.passOp == b.passOp && a.compareFunc == b.compareFunc;
+}
+
+static bool sameArgs(const DepthStencilArgs& a, const DepthStencilArgs& b) noexcept
+{
+    return a.enableDepthTest == b.enableDepthTest && a.enableStencilTest == b.enableStencilTest &&
+           a.depthWriteMask == b.depthWriteMask && a.depthCompareFunc == b.depthCompareFunc &&
+           a.stencilReadMask == b.stencilReadMask && a.stencilWriteMask == b.stencilWriteMask &&
+           sameArgs(a.frontFace, b.frontFace) && sameArgs(a.backFace, b.backFace);
+}
+
+static bool sameArgs(const RasterizerArgs& a, const RasterizerArgs& b) noexcept
+{
+    return a.enableScissorTest == b.enableScissorTest && a.frontFaceCounterClockwise == b.frontFaceCounterClockwise &&
+           a.cullMode == b.cullMode && a.fillMode == b.fillMode && a.depthBias == b.depthBias &&
+           a.slopeScaledDepthBias == b.slopeScaledDepthBias && a.depthBiasClamp == b.depthBiasClamp;
+}
+
+/**
+ *   A frame of draws built from cached states. Draws are mostly
+ * sorted by state, so most consecutive draws share their states,
+ * as they would in a real frame.
+ */
+class StateCacheFrame final
+{
+    DEFAULT_DESTRUCT(StateCacheFrame);
+    DELETE_CM(StateCacheFrame);
+public:
+    struct Draw final
+    {
+        const IBlendingState* blendingState;
+        const IDepthStencilState* depthStencilState;
+        const IRasterizerState* rasterizerState;
+    };
+public:
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    StateCache cache;
+
+    NullableRef<IBlendingState> blendingStates[HeadlessVariants];
+    NullableRef<IDepthStencilState> depthStencilStates[HeadlessVariants];
+    NullableRef<IRasterizerState> rasterizerStates[HeadlessVariants];
+
+    ::std::vector<Draw> draws;
+public:
+    StateCacheFrame() noexcept
+        : cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder)
+        , draws(FrameDraws)
+    {
+        for(u32 i = 0; i < HeadlessVariants; ++i)
+        {
+            blendingStates[i] = cache.blendingState(headlessBlendingArgs(i, 0));
+            depthStencilStates[i] = cache.depthStencilState(headlessDepthStencilArgs(i));
+            rasterizerStates[i] = cache.rasterizerState(headlessRasterizerArgs(i));
+        }
+
+        u32 random = 0x5747E;
+        Draw current { blendingStates[0].get(), depthStencilStates[0].get(), rasterizerStates[0].get() };
+        for(Draw& draw : draws)
+        {
+            if(nextRandom(random) % 8 == 0) { current.blendingState = blendingStates[nextRandom(random) % HeadlessVariants].get(); }
+            if(nextRandom(random) % 8 == 0) { current.depthStencilState = depthStencilStates[nextRandom(random) % HeadlessVariants].get(); }
+            if(nextRandom(random) % 8 == 0) { current.rasterizerState = rasterizerStates[nextRandom(random) % HeadlessVariants].get(); }
+            draw = current;
+        }
+    }
+};
+
+/**
+ * The cost of requesting a state that is already in the cache.
+ */
+TAU_BENCHMARK(StateCache, internHit)
+{
+    StateCacheFrame frame;
+
+    BlendingArgs args[HeadlessVariants];
+    for(u32 i = 0; i < HeadlessVariants; ++i)
+    { args[i] = headlessBlendingArgs(i, 1); }
+
+    for(const uSys i : state)
+    {
+        const NullableRef<IBlendingState> blendingState = frame.cache.blendingState(args[i & (HeadlessVariants - 1)]);
+        Benchmarks::doNotOptimize(blendingState.get());
+    }
+}
+
+/**
+ * Deciding whether each draw needs a state bound by diffing descriptions.
+ */
+TAU_BENCHMARK(StateCache, bindByDescription)
+{
+    StateCacheFrame frame;
+
+    const IBlendingState* boundBlending = frame.draws[0].blendingState;
+    const IDepthStencilState* boundDepthStencil = frame.draws[0].depthStencilState;
+    const IRasterizerState* boundRasterizer = frame.draws[0].rasterizerState;
+    uSys binds = 0;
+
+    for(const uSys i : state)
+    {
+        const StateCacheFrame::Draw& draw = frame.draws[i & (FrameDraws - 1)];
+        if(!sameArgs(boundBlending->args(), draw.blendingState->args()))
+        {
+            boundBlending = draw.blendingState;
+            ++binds;
+        }
+        if(!sameArgs(boundDepthStencil->args(), draw.depthStencilState->args()))
+        {
+            boundDepthStencil = draw.depthStencilState;
+            ++binds;
+        }
+        if(!sameArgs(boundRasterizer->args(), draw.rasterizerState->args()))
+        {
+            boundRasterizer = draw.rasterizerState;
+            ++binds;
+        }
+    }
+
+    Benchmarks::doNotOptimize(binds);
+}
+
+/**
+ * Deciding whether each draw needs a state bound by comparing state ids.
+ */
+TAU_BENCHMARK(StateCache, bindById)
+{
+    StateCacheFrame frame;
+
+    u32 boundBlending = frame.draws[0].blendingState->stateId();
+    u32 boundDepthStencil = frame.draws[0].depthStencilState->stateId();
+    u32 boundRasterizer = frame.draws[0].rasterizerState->stateId();
+    uSys binds = 0;
+
+    for(const uSys i : state)
+    {
+        const StateCacheFrame::Draw& draw = frame.draws[i & (FrameDraws - 1)];
+        if(draw.blendingState->stateId() != boundBlending)
+        {
+            boundBlending = draw.blendingState->stateId();
+            ++binds;
+        }
+        if(draw.depthStencilState->stateId() != boundDepthStencil)
+        {
+            boundDepthStencil = draw.depthStencilState->stateId();
+            ++binds;
+        }
+        if(draw.rasterizerState->stateId() != boundRasterizer)
+        {
+            boundRasterizer = draw.rasterizerState->stateId();
+            ++binds;
+        }
+    }
+
+    Benchmarks::doNotOptimize(binds);
+}
@@ -0,0 +1,227 @@
+#include "UnitTest.hpp"
+#include "StateCacheTest.hpp"
+#include "HeadlessStates.hpp"
+#include <graphics/StateCache.hpp>
+
+TAU_TEST(StateCache, internTest)
+{
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    StateCache cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder);
+
+    NullableRef<IBlendingState> blendingStates[HeadlessVariants];
+    NullableRef<IDepthStencilState> depthStencilStates[HeadlessVariants];
+    NullableRef<IRasterizerState> rasterizerStates[HeadlessVariants];
+
+    for(u32 copy = 0; copy < 2; ++copy)
+    {
+        for(u32 i = 0; i < HeadlessVariants; ++i)
+        {
+            const NullableRef<IBlendingState> blendingState = cache.blendingState(headlessBlendingArgs(i, copy));
+            const NullableRef<IDepthStencilState> depthStencilState = cache.depthStencilState(headlessDepthStencilArgs(i));
+            const NullableRef<IRasterizerState> rasterizerState = cache.rasterizerState(headlessRasterizerArgs(i));
+
+            TAU_EXPECT(blendingState && depthStencilState && rasterizerState);
+
+            if(copy == 0)
+            {
+                blendingStates[i] = blendingState;
+                depthStencilStates[i] = depthStencilState;
+                rasterizerStates[i] = rasterizerState;
+            }
+            else
+            {
+                TAU_EXPECT(blendingState.get() == blendingStates[i].get());
+                TAU_EXPECT(depthStencilState.get() == depthStencilStates[i].get());
+                TAU_EXPECT(rasterizerState.get() == rasterizerStates[i].get());
+            }
+        }
+    }
+
+    TAU_EXPECT_EQ(blendingBuilder.builds, HeadlessVariants);
+    TAU_EXPECT_EQ(depthStencilBuilder.builds, HeadlessVariants);
+    TAU_EXPECT_EQ(rasterizerBuilder.builds, HeadlessVariants);
+    TAU_EXPECT_EQ(cache.stats().misses, HeadlessVariants * 3);
+    TAU_EXPECT_EQ(cache.stats().hits, HeadlessVariants * 3);
+}
+
+TAU_TEST(StateCache, stateIdTest)
+{
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    StateCache cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder);
+
+    NullableRef<IBlendingState> blendingStates[HeadlessVariants];
+    NullableRef<IRasterizerState> rasterizerStates[HeadlessVariants];
+
+    for(u32 i = 0; i < HeadlessVariants; ++i)
+    {
+        blendingStates[i] = cache.blendingState(headlessBlendingArgs(i, 0));
+        rasterizerStates[i] = cache.rasterizerState(headlessRasterizerArgs(i));
+
+        TAU_EXPECT_NEQ(blendingStates[i]->stateId(), 0u);
+        TAU_EXPECT_NEQ(rasterizerStates[i]->stateId(), 0u);
+        TAU_EXPECT_EQ(cache.blendingState(headlessBlendingArgs(i, 1))->stateId(), blendingStates[i]->stateId());
+
+        for(u32 j = 0; j < i; ++j)
+        {
+            TAU_EXPECT_NEQ(blendingStates[i]->stateId(), blendingStates[j]->stateId());
+            TAU_EXPECT_NEQ(rasterizerStates[i]->stateId(), rasterizerStates[j]->stateId());
+        }
+    }
+}
+
+TAU_TEST(StateCache, collectTest)
+{
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    StateCache cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder);
+
+    NullableRef<IBlendingState> held = cache.blendingState(headlessBlendingArgs(0, 0));
+    for(u32 i = 1; i < HeadlessVariants; ++i)
+    {
+        (void) cache.blendingState(headlessBlendingArgs(i, 0));
+        (void) cache.depthStencilState(headlessDepthStencilArgs(i));
+        (void) cache.rasterizerState(headlessRasterizerArgs(i));
+    }
+
+    TAU_EXPECT_EQ(cache.size(), 1 + (HeadlessVariants - 1) * 3);
+    TAU_EXPECT_EQ(cache.collect(), (HeadlessVariants - 1) * 3);
+    TAU_EXPECT_EQ(cache.size(), 1);
+    TAU_EXPECT(cache.blendingState(headlessBlendingArgs(0, 1)).get() == held.get());
+
+    held = null;
+    TAU_EXPECT_EQ(cache.collect(), 1);
+    TAU_EXPECT_EQ(cache.size(), 0);
+}
+
+static BufferDescriptor headlessDescriptor(const ShaderDataType::Type uvType, const bool instanced) noexcept
+{
+    BufferDescriptorBuilder builder(2, instanced);
+    builder.addDescriptor(ShaderSemantic::Position, ShaderDataType::Vector3Float);
+    builder.addDescriptor(ShaderSemantic::TextureCoord, uvType);
+    return builder.build();
+}
+
+TAU_TEST(StateCache, inputLayoutTest)
+{
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    StateCache cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder);
+
+    // Separately built descriptors, so only their contents match.
+    BufferDescriptor first = headlessDescriptor(ShaderDataType::Vector2Float, false);
+    BufferDescriptor copy = headlessDescriptor(ShaderDataType::Vector2Float, false);
+    BufferDescriptor otherType = headlessDescriptor(ShaderDataType::Vector2UNorm16, false);
+    BufferDescriptor instanced = headlessDescriptor(ShaderDataType::Vector2Float, true);
+
+    const NullableRef<IInputLayout> inputLayout = cache.inputLayout({ null, 1, &first });
+    TAU_EXPECT(inputLayout);
+    TAU_EXPECT(cache.inputLayout({ null, 1, &copy }).get() == inputLayout.get());
+    TAU_EXPECT_EQ(inputLayoutBuilder.builds, 1);
+
+    TAU_EXPECT(cache.inputLayout({ null, 1, &otherType }).get() != inputLayout.get());
+    TAU_EXPECT(cache.inputLayout({ null, 1, &instanced }).get() != inputLayout.get());
+    TAU_EXPECT(cache.inputLayout({ null, 0, null }).get() != inputLayout.get());
+    TAU_EXPECT_EQ(inputLayoutBuilder.builds, 4);
+    TAU_EXPECT_NEQ(cache.inputLayout({ null, 1, &otherType })->stateId(), inputLayout->stateId());
+}
+
+TAU_TEST(StateCache, pipelineStateTest)
+{
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    HeadlessPipelineBuilder pipelineBuilder;
+    StateCache cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder);
+
+    u32 programs[2];
+
+    PipelineArgs args;
+    args.blendingState = cache.blendingState(headlessBlendingArgs(0, 0));
+    args.depthStencilState = cache.depthStencilState(headlessDepthStencilArgs(0));
+    args.rasterizerState = cache.rasterizerState(headlessRasterizerArgs(0));
+    args.shaderProgram = ShaderProgram(&programs[0]);
+    args.inputLayout = cache.inputLayout({ null, 0, null });
+    args.numRenderTargets = 1;
+
+    const NullableRef<IPipelineState> pipelineState = cache.pipelineState(pipelineBuilder, args);
+    TAU_EXPECT(pipelineState);
+    TAU_EXPECT_NEQ(pipelineState->stateId(), 0u);
+
+    // The cache returns the same states for equal descriptions, so the pipeline is found again.
+    PipelineArgs copy = args;
+    copy.rasterizerState = cache.rasterizerState(headlessRasterizerArgs(0));
+    TAU_EXPECT(cache.pipelineState(pipelineBuilder, copy).get() == pipelineState.get());
+    TAU_EXPECT_EQ(pipelineBuilder.builds, 1);
+
+    PipelineArgs otherRasterizer = args;
+    otherRasterizer.rasterizerState = cache.rasterizerState(headlessRasterizerArgs(1));
+    PipelineArgs otherProgram = args;
+    otherProgram.shaderProgram = ShaderProgram(&programs[1]);
+    PipelineArgs otherTargets = args;
+    otherTargets.numRenderTargets = 2;
+
+    TAU_EXPECT(cache.pipelineState(pipelineBuilder, otherRasterizer).get() != pipelineState.get());
+    TAU_EXPECT(cache.pipelineState(pipelineBuilder, otherProgram).get() != pipelineState.get());
+    TAU_EXPECT(cache.pipelineState(pipelineBuilder, otherTargets).get() != pipelineState.get());
+    TAU_EXPECT_EQ(pipelineBuilder.builds, 4);
+}
+
+TAU_TEST(StateCache, releaseShaderProgramTest)
+{
+    HeadlessBlendingBuilder blendingBuilder;
+    HeadlessDepthStencilBuilder depthStencilBuilder;
+    HeadlessRasterizerBuilder rasterizerBuilder;
+    HeadlessInputLayoutBuilder inputLayoutBuilder;
+    HeadlessPipelineBuilder pipelineBuilder;
+    StateCache cache(blendingBuilder, depthStencilBuilder, rasterizerBuilder, inputLayoutBuilder);
+
+    u32 programs[2];
+
+    PipelineArgs args;
+    args.blendingState = cache.blendingState(headlessBlendingArgs(0, 0));
+    args.depthStencilState = cache.depthStencilState(headlessDepthStencilArgs(0));
+    args.rasterizerState = cache.rasterizerState(headlessRasterizerArgs(0));
+    args.shaderProgram = ShaderProgram(&programs[0]);
+    args.numRenderTargets = 1;
+
+    PipelineArgs otherArgs = args;
+    otherArgs.shaderProgram = ShaderProgram(&programs[1]);
+
+    NullableRef<IPipelineState> released = cache.pipelineState(pipelineBuilder, args);
+    const NullableRef<IPipelineState> kept = cache.pipelineState(pipelineBuilder, otherArgs);
+
+    cache.releaseShaderProgram(ShaderProgram(&programs[0]));
+    TAU_EXPECT(cache.pipelineState(pipelineBuilder, otherArgs).get() == kept.get());
+
+    // A new program at the released address must not be given the old pipeline.
+    const NullableRef<IPipelineState> rebuilt = cache.pipelineState(pipelineBuilder, args);
+    TAU_EXPECT(rebuilt.get() != released.get());
+    TAU_EXPECT_NEQ(rebuilt->stateId(), released->stateId());
+    TAU_EXPECT(cache.pipelineState(pipelineBuilder, args).get() == rebuilt.get());
+    TAU_EXPECT_EQ(pipelineBuilder.builds, 3);
+
+    // The retired pipeline stays in the cache until nothing else references it.
+    const uSys size = cache.size();
+    TAU_EXPECT_EQ(cache.collect(), 0);
+    released = null;
+    TAU_EXPECT_EQ(cache.collect(), 1);
+    TAU_EXPECT_EQ(cache.size(), size - 1);
+}
+
+namespace StateCacheTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
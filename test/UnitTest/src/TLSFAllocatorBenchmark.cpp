@@ -0,0 +1,191 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <allocator/TLSFAllocator.hpp>
+#include <map>
+#include <vector>
+
+static constexpr u64 HeapSize = 256ull << 20;
+static constexpr u32 Ops = 200000;
+static constexpr u32 MaxLive = 20000;
+
+/**
+ *   A first fit allocator over an ordered map of free ranges,
+ * which is what a sub-allocator usually starts out as.
+ */
+class FirstFitAllocator final
+{
+private:
+    ::std::map<u64, u64> _free;
+public:
+    FirstFitAllocator(const u64 size) noexcept
+    { _free[0] = size; }
+
+    [[nodiscard]] u64 allocate(const u64 size, const u64 alignment) noexcept
+    {
+        for(auto it = _free.begin(); it != _free.end(); ++it)
+        {
+            const u64 offset = it->first;
+            const u64 end = offset + it->second;
+            const u64 aligned = (offset + (alignment - 1)) & ~(alignment - 1);
+            if(aligned + size > end)
+            { continue; }
+
+            _free.erase(it);
+            if(aligned != offset)
+            { _free[offset] = aligned - offset; }
+            if(aligned + size != end)
+            { _free[aligned + size] = end - (aligned + size); }
+            return aligned;
+        }
+
+        return ~0ull;
+    }
+
+    void free(u64 offset, u64 size) noexcept
+    {
+        auto next = _free.lower_bound(offset);
+        if(next != _free.end() && offset + size == next->first)
+        {
+            size += next->second;
+            next = _free.erase(next);
+        }
+
+        if(next != _free.begin())
+        {
+            auto prev = ::std::prev(next);
+            if(prev->first + prev->second == offset)
+            {
+                prev->second += size;
+                return;
+            }
+        }
+
+        _free[offset] = size;
+    }
+};
+
+struct Op final
+{
+    u64 size;
+    u64 alignment;
+    u32 index;
+    bool allocate;
+};
+
+/**
+ *   Buffers of 256B to 64KiB and textures of 64KiB to 4MiB with
+ * GPU like alignments, freed in a random order. The live count
+ * hovers around MaxLive so that the heap stays fragmented.
+ */
+static ::std::vector<Op> generateOps() noexcept
+{
+    ::std::vector<Op> ops;
+    ops.reserve(Ops);
+
+    u32 random = 0x9E3779B9;
+    u32 live = 0;
+    for(u32 i = 0; i < Ops; ++i)
+    {
+        Op op { };
+        op.allocate = !live || (live < MaxLive && nextRandom(random) % 2);
+        if(op.allocate)
+        {
+            if(nextRandom(random) % 8)
+            {
+                op.size = 256 + nextRandom(random) % (64 << 10);
+                op.alignment = 256;
+            }
+            else
+            {
+                op.size = (64 << 10) + (nextRandom(random) % 64) * (64 << 10);
+                op.alignment = 64 << 10;
+            }
+            ++live;
+        }
+        else
+        {
+            op.index = nextRandom(random) % live;
+            --live;
+        }
+        ops.push_back(op);
+    }
+
+    return ops;
+}
+
+struct LiveAllocation final
+{
+    u64 offset;
+    u64 size;
+    u32 node;
+};
+
+/**
+ *   Every iteration replays the whole sequence of operations and
+ * then frees whatever is left, so each one starts from an empty
+ * heap. A failed allocation is skipped, like a caller falling back
+ * to a new heap would.
+ */
+template<typename _Allocate, typename _Free>
+static void replay(BenchmarkState& state, _Allocate allocate, _Free free) noexcept
+{
+    const ::std::vector<Op> ops = generateOps();
+    ::std::vector<LiveAllocation> live;
+    live.reserve(MaxLive);
+
+    for(const uSys i : state)
+    {
+        for(const Op& op : ops)
+        {
+            if(op.allocate)
+            {
+                LiveAllocation allocation { 0, op.size, 0 };
+                if(allocate(op.size, op.alignment, allocation))
+                { live.push_back(allocation); }
+            }
+            else if(!live.empty())
+            {
+                const uSys index = op.index % live.size();
+                free(live[index]);
+                live[index] = live.back();
+                live.pop_back();
+            }
+        }
+
+        for(const LiveAllocation& allocation : live)
+        { free(allocation); }
+        live.clear();
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(TLSFAllocator, replay)
+{
+    TLSFAllocator tlsf(HeapSize, 1024);
+
+    replay(state,
+        [&](const u64 size, const u64 alignment, LiveAllocation& out) noexcept
+        {
+            const TLSFAllocator::Allocation allocation = tlsf.allocate(size, alignment);
+            out.offset = allocation.offset;
+            out.node = allocation.node;
+            return allocation.valid();
+        },
+        [&](const LiveAllocation& allocation) noexcept { tlsf.free(allocation.node); });
+}
+
+/**
+ * The same sequence as TLSFAllocator.replay.
+ */
+TAU_BENCHMARK(FirstFitAllocator, replay)
+{
+    FirstFitAllocator firstFit(HeapSize);
+
+    replay(state,
+        [&](const u64 size, const u64 alignment, LiveAllocation& out) noexcept
+        {
+            out.offset = firstFit.allocate(size, alignment);
+            return out.offset != ~0ull;
+        },
+        [&](const LiveAllocation& allocation) noexcept { firstFit.free(allocation.offset, allocation.size); });
+}
@@ -0,0 +1,299 @@
+#include "UnitTest.hpp"
+#include "TLSFAllocatorTest.hpp"
+#include "TestRandom.hpp"
+#include <allocator/TLSFAllocator.hpp>
+#include <cstring>
+#include <vector>
+
+/**
+ * Backs each block with CPU memory so that moves can be checked.
+ */
+class TestBlockAllocator final : public TLSFBlockAllocator
+{
+public:
+    u32 created;
+    u32 destroyed;
+    u32 moves;
+public:
+    TestBlockAllocator(const u64 blockSize, const u32 maxBlocks) noexcept
+        : TLSFBlockAllocator(blockSize, maxBlocks)
+        , created(0)
+        , destroyed(0)
+        , moves(0)
+    { }
+
+    ~TestBlockAllocator() noexcept override
+    { release(); }
+protected:
+    bool createBlock(const u64 size, void** const handle) noexcept override
+    {
+        *handle = new(::std::nothrow) u8[size];
+        ++created;
+        return *handle;
+    }
+
+    void destroyBlock(void* const handle) noexcept override
+    {
+        delete[] static_cast<u8*>(handle);
+        ++destroyed;
+    }
+
+    void moveAllocation(const Allocation& from, const Allocation& to, void* const userData) noexcept override
+    {
+        ::std::memcpy(static_cast<u8*>(to.blockHandle) + to.offset, static_cast<u8*>(from.blockHandle) + from.offset, from.size);
+        *static_cast<Allocation*>(userData) = to;
+        ++moves;
+    }
+};
+
+TAU_TEST(TLSFAllocator, allocateTest)
+{
+    TLSFAllocator allocator(1024);
+
+    const TLSFAllocator::Allocation a = allocator.allocate(100);
+    const TLSFAllocator::Allocation b = allocator.allocate(200);
+    const TLSFAllocator::Allocation c = allocator.allocate(724);
+
+    TAU_EXPECT(a.valid() && b.valid() && c.valid());
+    TAU_EXPECT_EQ(a.offset, 0u);
+    TAU_EXPECT_EQ(b.offset, 100u);
+    TAU_EXPECT_EQ(c.offset, 300u);
+    TAU_EXPECT_EQ(allocator.used(), 1024u);
+    TAU_EXPECT(!allocator.allocate(1).valid());
+
+    TAU_EXPECT(!allocator.allocate(0).valid());
+    TAU_EXPECT(!allocator.allocate(1, 3).valid());
+
+    allocator.free(b);
+    TAU_EXPECT_EQ(allocator.used(), 824u);
+    const TLSFAllocator::Allocation d = allocator.allocate(200);
+    TAU_EXPECT(d.valid());
+    TAU_EXPECT_EQ(d.offset, 100u);
+}
+
+TAU_TEST(TLSFAllocator, alignmentTest)
+{
+    TLSFAllocator allocator(1 << 20);
+
+    const TLSFAllocator::Allocation a = allocator.allocate(3);
+    const TLSFAllocator::Allocation b = allocator.allocate(1000, 256);
+    const TLSFAllocator::Allocation c = allocator.allocate(5, 65536);
+
+    TAU_EXPECT(a.valid() && b.valid() && c.valid());
+    TAU_EXPECT_EQ(b.offset % 256, 0u);
+    TAU_EXPECT_EQ(c.offset % 65536, 0u);
+    TAU_EXPECT_EQ(allocator.alignment(c.node), 65536u);
+    TAU_EXPECT_EQ(allocator.used(), 1008u);
+
+    // The padding in front of an aligned allocation is still usable.
+    const TLSFAllocator::Allocation d = allocator.allocate(200);
+    TAU_EXPECT(d.valid());
+    TAU_EXPECT_LEQ(d.offset + 200, b.offset);
+
+    TAU_EXPECT(!allocator.allocate(1, 1 << 21).valid());
+}
+
+TAU_TEST(TLSFAllocator, mergeTest)
+{
+    TLSFAllocator allocator(4096);
+
+    ::std::vector<TLSFAllocator::Allocation> allocations;
+    for(TLSFAllocator::Allocation allocation = allocator.allocate(64); allocation.valid(); allocation = allocator.allocate(64))
+    { allocations.push_back(allocation); }
+    TAU_EXPECT_EQ(allocations.size(), 64u);
+    TAU_EXPECT_EQ(allocator.stats().freeBlockCount, 0u);
+
+    // Free every other block, then the rest, so every case of merging is hit.
+    for(uSys i = 0; i < allocations.size(); i += 2)
+    { allocator.free(allocations[i]); }
+    TAU_EXPECT_EQ(allocator.stats().freeBlockCount, 32u);
+    TAU_EXPECT_EQ(allocator.stats().largestFree, 64u);
+
+    for(uSys i = 1; i < allocations.size(); i += 2)
+    { allocator.free(allocations[i]); }
+
+    const TLSFAllocator::Stats stats = allocator.stats();
+    TAU_EXPECT_EQ(stats.used, 0u);
+    TAU_EXPECT_EQ(stats.freeBlockCount, 1u);
+    TAU_EXPECT_EQ(stats.largestFree, 4096u);
+    TAU_EXPECT(allocator.allocate(4096).valid());
+}
+
+TAU_TEST(TLSFAllocator, doubleFreeTest)
+{
+    TLSFAllocator allocator(256);
+
+    const TLSFAllocator::Allocation a = allocator.allocate(16);
+    const TLSFAllocator::Allocation b = allocator.allocate(16);
+    allocator.free(a);
+    allocator.free(a);
+    allocator.free(TLSFAllocator::InvalidNode);
+
+    TAU_EXPECT_EQ(allocator.used(), 16u);
+    TAU_EXPECT_EQ(allocator.allocationCount(), 1u);
+
+    allocator.free(b);
+    TAU_EXPECT(allocator.empty());
+    TAU_EXPECT_EQ(allocator.stats().largestFree, 256u);
+}
+
+TAU_TEST(TLSFAllocator, randomTest)
+{
+    static constexpr u32 Size = 1 << 16;
+
+    TLSFAllocator allocator(Size, 1);
+
+    // The owner of every byte, so that any overlap is caught.
+    ::std::vector<u32> owners(Size, 0);
+    ::std::vector<TLSFAllocator::Allocation> live;
+    u32 nextOwner = 1;
+    u32 random = 0x12345678;
+    bool overlap = false;
+    bool misaligned = false;
+
+    for(u32 i = 0; i < 20000; ++i)
+    {
+        if(!live.empty() && nextRandom(random) % 2)
+        {
+            const uSys index = nextRandom(random) % live.size();
+            const TLSFAllocator::Allocation allocation = live[index];
+            live[index] = live.back();
+            live.pop_back();
+
+            for(u64 j = 0; j < allocation.size; ++j)
+            { owners[allocation.offset + j] = 0; }
+            allocator.free(allocation);
+        }
+        else
+        {
+            const u64 alignment = 1ull << (nextRandom(random) % 9);
+            const TLSFAllocator::Allocation allocation = allocator.allocate(1 + nextRandom(random) % 1024, alignment);
+            if(!allocation.valid())
+            { continue; }
+
+            TAU_EXPECT_LEQ(allocation.offset + allocation.size, Size);
+            misaligned = misaligned || allocation.offset % alignment;
+            for(u64 j = 0; j < allocation.size; ++j)
+            {
+                overlap = overlap || owners[allocation.offset + j];
+                owners[allocation.offset + j] = nextOwner;
+            }
+            ++nextOwner;
+            live.push_back(allocation);
+        }
+    }
+
+    TAU_EXPECT(!overlap);
+    TAU_EXPECT(!misaligned);
+
+    // The blocks have to tile the whole range in order.
+    u64 end = 0;
+    for(u32 node = allocator.firstNode(); node != TLSFAllocator::InvalidNode; node = allocator.nextNode(node))
+    {
+        TAU_EXPECT_EQ(allocator.offset(node), end);
+        end = allocator.offset(node) + allocator.size(node);
+    }
+    TAU_EXPECT_EQ(end, static_cast<u64>(Size));
+
+    for(const TLSFAllocator::Allocation& allocation : live)
+    { allocator.free(allocation); }
+
+    TAU_EXPECT(allocator.empty());
+    TAU_EXPECT_EQ(allocator.stats().freeBlockCount, 1u);
+    TAU_EXPECT(allocator.allocate(Size).valid());
+}
+
+TAU_TEST(TLSFBlockAllocator, blockTest)
+{
+    TestBlockAllocator allocator(1024, 8);
+
+    const TLSFBlockAllocator::Allocation a = allocator.allocate(400);
+    const TLSFBlockAllocator::Allocation b = allocator.allocate(400);
+    const TLSFBlockAllocator::Allocation c = allocator.allocate(400);
+
+    TAU_EXPECT(a && b && c);
+    TAU_EXPECT_EQ(a.block, b.block);
+    TAU_EXPECT(a.block != c.block);
+    TAU_EXPECT_EQ(allocator.blockCount(), 2u);
+
+    // Larger than half a block, so it gets its own.
+    const TLSFBlockAllocator::Allocation d = allocator.allocate(4000);
+    TAU_EXPECT(d);
+    TAU_EXPECT_EQ(d.offset, 0u);
+    TAU_EXPECT_EQ(allocator.blockCount(), 3u);
+    allocator.free(d);
+    TAU_EXPECT_EQ(allocator.blockCount(), 2u);
+
+    // The first empty block is kept around, the second isn't.
+    allocator.free(c);
+    TAU_EXPECT_EQ(allocator.blockCount(), 2u);
+    allocator.free(a);
+    allocator.free(b);
+    TAU_EXPECT_EQ(allocator.blockCount(), 1u);
+
+    const TLSFBlockAllocator::Allocation e = allocator.allocate(400);
+    TAU_EXPECT(e);
+    TAU_EXPECT_EQ(allocator.created, 3u);
+    allocator.free(e);
+
+    const TLSFBlockAllocator::Stats stats = allocator.stats();
+    TAU_EXPECT_EQ(stats.reserved, 1024u);
+    TAU_EXPECT_EQ(stats.used, 0u);
+}
+
+TAU_TEST(TLSFBlockAllocator, defragmentTest)
+{
+    static constexpr u32 Count = 64;
+
+    TestBlockAllocator allocator(1024, 16);
+
+    TLSFBlockAllocator::Allocation allocations[Count];
+    for(u32 i = 0; i < Count; ++i)
+    {
+        allocations[i] = allocator.allocate(100, 16, &allocations[i]);
+        TAU_EXPECT(allocations[i]);
+        ::std::memset(static_cast<u8*>(allocations[i].blockHandle) + allocations[i].offset, static_cast<int>(i), 100);
+    }
+    TAU_EXPECT_EQ(allocator.blockCount(), 8u);
+
+    // Leave a quarter of the allocations scattered across every block.
+    for(u32 i = 0; i < Count; ++i)
+    {
+        if(i % 4)
+        { allocator.free(allocations[i]); }
+    }
+
+    const u32 blocksBefore = allocator.blockCount();
+    u64 moved;
+    do
+    {
+        moved = allocator.defragment(~0ull);
+    } while(moved);
+
+    TAU_EXPECT_LEQ(allocator.blockCount(), 2u);
+    TAU_EXPECT_LEQ(allocator.blockCount(), blocksBefore);
+    TAU_EXPECT(allocator.moves);
+
+    // Every move has to have updated its owner and carried the contents along.
+    bool intact = true;
+    for(u32 i = 0; i < Count; i += 4)
+    {
+        const u8* const data = static_cast<const u8*>(allocations[i].blockHandle) + allocations[i].offset;
+        for(u32 j = 0; j < 100; ++j)
+        { intact = intact && data[j] == static_cast<u8>(i); }
+        TAU_EXPECT_EQ(allocations[i].offset % 16, 0u);
+    }
+    TAU_EXPECT(intact);
+    TAU_EXPECT_EQ(allocator.stats().allocationCount, Count / 4);
+
+    for(u32 i = 0; i < Count; i += 4)
+    { allocator.free(allocations[i]); }
+    TAU_EXPECT_EQ(allocator.stats().used, 0u);
+}
+
+namespace TLSFAllocatorTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -0,0 +1,66 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include "TestBitmap.hpp"
+#include <texture/FITextureLoader.hpp>
+#include <texture/TextureDecodeQueue.hpp>
+#include <vector>
+
+static constexpr u32 TextureSize = 512;
+static constexpr u32 BatchSize = 32;
+
+/**
+ *   A 24 bit BMP of random pixels. The 24 bit path swizzles and
+ * widens every pixel into RGBA8, the same conversion every other
+ * format goes through once FreeImage has decoded it.
+ */
+static ::std::vector<u8> randomBitmap(const u32 width, const u32 height) noexcept
+{
+    ::std::vector<u8> pixels(static_cast<uSys>(width) * height * 3);
+
+    u32 random = 0x7E47;
+    for(u8& channel : pixels)
+    { channel = static_cast<u8>(nextRandom(random)); }
+
+    return encodeBitmap(width, height, 24, pixels.data());
+}
+
+/**
+ *   Each iteration decodes a batch of 32 textures of 512x512,
+ * 32 MiB of RGBA8, on the calling thread.
+ */
+TAU_BENCHMARK(TextureDecode, serial)
+{
+    const ::std::vector<u8> file = randomBitmap(TextureSize, TextureSize);
+    DecodedTexture texture;
+
+    for(const uSys i : state)
+    {
+        for(u32 j = 0; j < BatchSize; ++j)
+        { (void) TextureLoader::decodeTexture(file.data(), file.size(), nullptr, &texture); }
+        Benchmarks::doNotOptimize(texture.pixels.data());
+        (void) i;
+    }
+}
+
+/**
+ * The same batch decoded on the worker threads of a TextureDecodeQueue.
+ */
+TAU_BENCHMARK(TextureDecode, queue)
+{
+    const ::std::vector<u8> file = randomBitmap(TextureSize, TextureSize);
+    TextureDecodeQueue queue;
+    ::std::vector<TextureDecodeQueue::Result> results;
+
+    for(const uSys i : state)
+    {
+        for(u32 j = 0; j < BatchSize; ++j)
+        { queue.push(j, file.data(), file.size()); }
+
+        while(queue.busy())
+        {
+            queue.poll(results, true);
+            results.clear();
+        }
+        (void) i;
+    }
+}
@@ -0,0 +1,117 @@
+#include "UnitTest.hpp"
+#include "TextureDecodeTest.hpp"
+#include "TestRandom.hpp"
+#include "TestBitmap.hpp"
+#include <texture/FITextureLoader.hpp>
+#include <vector>
+
+/**
+ *   The 24 bit SIMD loop converts 4 pixels at a time once a scanline
+ * has at least 6, every width up to 9 covers the scalar only path,
+ * the vector loop with each tail length, and then a longer scanline.
+ */
+static constexpr u32 Widths[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 33 };
+static constexpr u32 Height = 3;
+
+static ::std::vector<u8> randomBytes(const uSys count, u32& random) noexcept
+{
+    ::std::vector<u8> bytes(count);
+    for(u8& byte : bytes)
+    { byte = static_cast<u8>(nextRandom(random)); }
+    return bytes;
+}
+
+TAU_TEST(TextureDecode, swapsRedAndBlue)
+{
+    const u8 pixels[] = {
+        0xFF, 0x00, 0x00,
+        0x00, 0xFF, 0x00,
+        0x00, 0x00, 0xFF,
+        0x10, 0x20, 0x30
+    };
+    const ::std::vector<u8> file = encodeBitmap(4, 1, 24, pixels);
+
+    DecodedTexture texture;
+    TAU_EXPECT(TextureLoader::decodeTexture(file.data(), file.size(), nullptr, &texture) == TextureLoader::TextureLoadError::NONE);
+    TAU_EXPECT_EQ(texture.width, 4u);
+    TAU_EXPECT_EQ(texture.height, 1u);
+
+    const u8 expected[] = {
+        0xFF, 0x00, 0x00, 0xFF,
+        0x00, 0xFF, 0x00, 0xFF,
+        0x00, 0x00, 0xFF, 0xFF,
+        0x10, 0x20, 0x30, 0xFF
+    };
+    TAU_EXPECT((texture.pixels == ::std::vector<u8>(expected, expected + sizeof(expected))));
+}
+
+TAU_TEST(TextureDecode, scanline24)
+{
+    u32 random = 0x24B1;
+    for(const u32 width : Widths)
+    {
+        const ::std::vector<u8> pixels = randomBytes(static_cast<uSys>(width) * Height * 3, random);
+        const ::std::vector<u8> file = encodeBitmap(width, Height, 24, pixels.data());
+
+        DecodedTexture texture;
+        TAU_EXPECT(TextureLoader::decodeTexture(file.data(), file.size(), nullptr, &texture) == TextureLoader::TextureLoadError::NONE);
+        TAU_EXPECT_EQ(texture.width, width);
+        TAU_EXPECT_EQ(texture.height, Height);
+        TAU_EXPECT_EQ(texture.pixels.size(), static_cast<uSys>(width) * Height * 4);
+
+        bool matches = texture.pixels.size() == static_cast<uSys>(width) * Height * 4;
+        for(uSys i = 0; matches && i < static_cast<uSys>(width) * Height; ++i)
+        {
+            matches = texture.pixels[i * 4 + 0] == pixels[i * 3 + 0] &&
+                      texture.pixels[i * 4 + 1] == pixels[i * 3 + 1] &&
+                      texture.pixels[i * 4 + 2] == pixels[i * 3 + 2] &&
+                      texture.pixels[i * 4 + 3] == 0xFF;
+        }
+        TAU_EXPECT(matches);
+    }
+}
+
+TAU_TEST(TextureDecode, scanline8)
+{
+    u32 random = 0x8B17;
+    const ::std::vector<u8> palette = randomBytes(256 * 3, random);
+
+    for(const u32 width : Widths)
+    {
+        const ::std::vector<u8> indices = randomBytes(static_cast<uSys>(width) * Height, random);
+        const ::std::vector<u8> file = encodeBitmap(width, Height, 8, indices.data(), palette.data());
+
+        DecodedTexture texture;
+        TAU_EXPECT(TextureLoader::decodeTexture(file.data(), file.size(), nullptr, &texture) == TextureLoader::TextureLoadError::NONE);
+        TAU_EXPECT_EQ(texture.width, width);
+        TAU_EXPECT_EQ(texture.height, Height);
+        TAU_EXPECT_EQ(texture.pixels.size(), static_cast<uSys>(width) * Height * 4);
+
+        bool matches = texture.pixels.size() == static_cast<uSys>(width) * Height * 4;
+        for(uSys i = 0; matches && i < static_cast<uSys>(width) * Height; ++i)
+        {
+            const u8* const color = &palette[indices[i] * 3];
+            matches = texture.pixels[i * 4 + 0] == color[0] &&
+                      texture.pixels[i * 4 + 1] == color[1] &&
+                      texture.pixels[i * 4 + 2] == color[2] &&
+                      texture.pixels[i * 4 + 3] == 0xFF;
+        }
+        TAU_EXPECT(matches);
+    }
+}
+
+TAU_TEST(TextureDecode, invalidData)
+{
+    DecodedTexture texture;
+    TAU_EXPECT(TextureLoader::decodeTexture(nullptr, 0, nullptr, &texture) == TextureLoader::TextureLoadError::NULL_TEXTURE_DATA);
+
+    const u8 garbage[64] = { 0x12, 0x34, 0x56, 0x78 };
+    TAU_EXPECT(TextureLoader::decodeTexture(garbage, sizeof(garbage), nullptr, &texture) != TextureLoader::TextureLoadError::NONE);
+}
+
+namespace TextureDecodeTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -0,0 +1,147 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <TexturePacker2D.hpp>
+#include <SkylinePacker2D.hpp>
+#include <vector>
+
+using TexturePacker = TexturePacker2D<u32, u16>;
+using SkylinePacker = SkylinePacker2D<u32, u16>;
+
+static constexpr u16 PageSize = 4096;
+static constexpr u32 MaxPages = 16;
+static constexpr uSys IncrementalCount = 20000;
+
+/**
+ * Glyph and sprite sized textures, 4 to 31 pixels on a side.
+ */
+static ::std::vector<SkylinePacker::Texture> generateTextures(const uSys count) noexcept
+{
+    ::std::vector<SkylinePacker::Texture> textures(count);
+
+    u32 random = 0x9E3779B9;
+    for(uSys i = 0; i < count; ++i)
+    {
+        textures[i].handle = static_cast<u32>(i);
+        textures[i].width = static_cast<u16>(nextRandom(random) % 28 + 4);
+        textures[i].height = static_cast<u16>(nextRandom(random) % 28 + 4);
+    }
+
+    return textures;
+}
+
+/**
+ *   TexturePacker2D repacks everything at every step of its
+ * search, it isn't run on more than 10,000 textures.
+ */
+static void timeRepack(BenchmarkState& state, const uSys count) noexcept
+{
+    const ::std::vector<SkylinePacker::Texture> textures = generateTextures(count);
+    TexturePacker packer(count);
+
+    for(const uSys i : state)
+    {
+        packer.pack(textures.data(), count, PageSize, 1);
+        Benchmarks::doNotOptimize(packer.packedWidth());
+        (void) i;
+    }
+}
+
+static void timeSkyline(BenchmarkState& state, const uSys count, const u32 threadCount) noexcept
+{
+    const ::std::vector<SkylinePacker::Texture> textures = generateTextures(count);
+    SkylinePacker packer(PageSize, PageSize, MaxPages);
+
+    for(const uSys i : state)
+    {
+        Benchmarks::doNotOptimize(packer.pack(textures.data(), count, threadCount));
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(TexturePacking, repack1000)
+{ timeRepack(state, 1000); }
+
+TAU_BENCHMARK(TexturePacking, repack10000)
+{ timeRepack(state, 10000); }
+
+TAU_BENCHMARK(TexturePacking, skyline1000)
+{ timeSkyline(state, 1000, 1); }
+
+TAU_BENCHMARK(TexturePacking, skyline10000)
+{ timeSkyline(state, 10000, 1); }
+
+TAU_BENCHMARK(TexturePacking, skylineThreads1000)
+{ timeSkyline(state, 1000, 0); }
+
+TAU_BENCHMARK(TexturePacking, skylineThreads10000)
+{ timeSkyline(state, 10000, 0); }
+
+/**
+ * Inserts 20,000 textures one at a time into an empty atlas.
+ */
+static void timeInsert(BenchmarkState& state, const SkylinePacker::Heuristic heuristic) noexcept
+{
+    const ::std::vector<SkylinePacker::Texture> textures = generateTextures(IncrementalCount);
+    SkylinePacker packer(PageSize, PageSize, MaxPages, heuristic);
+
+    for(const uSys i : state)
+    {
+        packer.clear();
+        for(const SkylinePacker::Texture& texture : textures)
+        { Benchmarks::doNotOptimize(packer.insert(texture.handle, texture.width, texture.height)); }
+        (void) i;
+    }
+}
+
+/**
+ *   Starts from 20,000 inserted textures, then every iteration
+ * inserts or removes a random texture so the atlas has to reuse
+ * the holes left behind, like a glyph cache evicting glyphs.
+ */
+static void timeChurn(BenchmarkState& state, const SkylinePacker::Heuristic heuristic) noexcept
+{
+    const ::std::vector<SkylinePacker::Texture> textures = generateTextures(IncrementalCount);
+    SkylinePacker packer(PageSize, PageSize, MaxPages, heuristic);
+    ::std::vector<SkylinePacker::Placement> live;
+    live.reserve(IncrementalCount * 2);
+
+    for(const SkylinePacker::Texture& texture : textures)
+    {
+        SkylinePacker::Placement placement;
+        if(packer.insert(texture.handle, texture.width, texture.height, &placement))
+        { live.push_back(placement); }
+    }
+
+    u32 random = 0x2545F491;
+    for(const uSys i : state)
+    {
+        if(live.empty() || nextRandom(random) % 2)
+        {
+            const SkylinePacker::Texture& texture = textures[nextRandom(random) % IncrementalCount];
+            SkylinePacker::Placement placement;
+            if(packer.insert(texture.handle, texture.width, texture.height, &placement))
+            { live.push_back(placement); }
+        }
+        else
+        {
+            const uSys index = nextRandom(random) % live.size();
+            packer.remove(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        (void) i;
+    }
+}
+
+TAU_BENCHMARK(TexturePacking, insertBottomLeft)
+{ timeInsert(state, SkylinePacker::Heuristic::BottomLeft); }
+
+TAU_BENCHMARK(TexturePacking, insertMinWaste)
+{ timeInsert(state, SkylinePacker::Heuristic::MinWaste); }
+
+TAU_BENCHMARK(TexturePacking, churnBottomLeft)
+{ timeChurn(state, SkylinePacker::Heuristic::BottomLeft); }
+
+TAU_BENCHMARK(TexturePacking, churnMinWaste)
+{ timeChurn(state, SkylinePacker::Heuristic::MinWaste); }
+
@@ -1,10 +1,13 @@
 #include "UnitTest.hpp"
 #include "TexturePackingTest.hpp"
+#include "TestRandom.hpp"
 #include <TexturePacker2D.hpp>
+#include <SkylinePacker2D.hpp>
 #include <cstdio>
 #include <cstdlib>
 
 #include "DynArray.hpp"
+#include <vector>
 
 #define SHOULD_PRINT 1
 
@@ -198,6 +201,142 @@ void writeBitmap(const char* const fileName, const u8* const textureData, const
     fclose(file);
 }
 
+using SkylinePacker = SkylinePacker2D<u32, u16>;
+
+/**
+ * Returns true if every placement is inside its page and no two placements overlap.
+ */
+static bool validPlacements(const SkylinePacker& packer, const SkylinePacker::Placement* const placements, const uSys count) noexcept
+{
+    const uSys pageSize = static_cast<uSys>(packer.pageWidth()) * packer.pageHeight();
+    ::std::vector<u8> used(pageSize * packer.pageCount(), 0);
+
+    for(uSys i = 0; i < count; ++i)
+    {
+        const SkylinePacker::Placement& placement = placements[i];
+        if(placement.page >= packer.pageCount() ||
+           placement.x + placement.width > packer.pageWidth() ||
+           placement.y + placement.height > packer.pageHeight())
+        { return false; }
+
+        for(uSys y = placement.y; y < static_cast<uSys>(placement.y + placement.height); ++y)
+        {
+            for(uSys x = placement.x; x < static_cast<uSys>(placement.x + placement.width); ++x)
+            {
+                u8& pixel = used[placement.page * pageSize + y * packer.pageWidth() + x];
+                if(pixel)
+                { return false; }
+                pixel = 1;
+            }
+        }
+    }
+
+    return true;
+}
+
+TAU_TEST(TexturePacking, skylineInsertTest)
+{
+    SkylinePacker packer(64, 64);
+
+    ::std::vector<SkylinePacker::Placement> placements(16);
+    for(u32 i = 0; i < 16; ++i)
+    { TAU_ASSERT(packer.insert(i, 16, 16, &placements[i])); }
+
+    TAU_EXPECT(validPlacements(packer, placements.data(), placements.size()));
+    TAU_EXPECT_EQ(packer.pageCount(), 1u);
+    TAU_EXPECT_EQ(packer.usedArea(), 64u * 64u);
+    TAU_EXPECT_FP_EQ_ABS(packer.occupancy(), 1.0);
+
+    TAU_EXPECT(!packer.insert(16, 1, 1));
+    TAU_EXPECT(!packer.insert(17, 0, 8));
+    TAU_EXPECT(!packer.insert(18, 65, 8));
+}
+
+TAU_TEST(TexturePacking, skylineRemoveTest)
+{
+    SkylinePacker packer(64, 64);
+
+    ::std::vector<SkylinePacker::Placement> placements(16);
+    for(u32 i = 0; i < 16; ++i)
+    { TAU_ASSERT(packer.insert(i, 16, 16, &placements[i])); }
+
+    // A freed hole is reused, as is a hole merged from two neighbours.
+    packer.remove(placements[5]);
+    SkylinePacker::Placement placement;
+    TAU_ASSERT(packer.insert(16, 16, 16, &placement));
+    TAU_EXPECT_EQ(placement.x, placements[5].x);
+    TAU_EXPECT_EQ(placement.y, placements[5].y);
+    placements[5] = placement;
+
+    packer.remove(placements[1]);
+    packer.remove(placements[2]);
+    TAU_ASSERT(packer.insert(17, 32, 16, &placement));
+    placements[1] = placement;
+    placements.erase(placements.begin() + 2);
+    TAU_EXPECT(validPlacements(packer, placements.data(), placements.size()));
+
+    // Removing everything resets the page.
+    for(const SkylinePacker::Placement& p : placements)
+    { packer.remove(p); }
+    TAU_EXPECT_EQ(packer.usedArea(), 0u);
+    TAU_EXPECT(packer.insert(18, 64, 64));
+}
+
+TAU_TEST(TexturePacking, skylineMultiPageTest)
+{
+    SkylinePacker packer(64, 64, 2);
+
+    SkylinePacker::Placement placements[2];
+    TAU_ASSERT(packer.insert(0, 64, 48, &placements[0]));
+    TAU_ASSERT(packer.insert(1, 32, 32, &placements[1]));
+    TAU_EXPECT_EQ(placements[0].page, 0u);
+    TAU_EXPECT_EQ(placements[1].page, 1u);
+    TAU_EXPECT_EQ(packer.pageCount(), 2u);
+
+    // Small textures still go to the first page with room.
+    SkylinePacker::Placement placement;
+    TAU_ASSERT(packer.insert(2, 16, 16, &placement));
+    TAU_EXPECT_EQ(placement.page, 0u);
+
+    TAU_EXPECT(!packer.insert(3, 64, 64));
+}
+
+TAU_TEST(TexturePacking, skylinePackTest)
+{
+    constexpr uSys textureCount = 1000;
+
+    ::std::vector<SkylinePacker::Texture> textures(textureCount);
+
+    u32 random = 0x5C1;
+    for(uSys i = 0; i < textureCount; ++i)
+    {
+        textures[i].handle = static_cast<u32>(i);
+        textures[i].width = static_cast<u16>(nextRandom(random) % 28 + 4);
+        textures[i].height = static_cast<u16>(nextRandom(random) % 28 + 4);
+    }
+
+    SkylinePacker packer(512, 512, 4);
+    TAU_ASSERT(packer.pack(textures.data(), textures.size()));
+    TAU_EXPECT_EQ(packer.placements().size(), textureCount);
+    TAU_EXPECT(validPlacements(packer, packer.placements().data(), packer.placements().size()));
+
+    ::std::vector<bool> placed(textureCount, false);
+    for(const SkylinePacker::Placement& placement : packer.placements())
+    {
+        TAU_EXPECT(!placed[placement.handle]);
+        TAU_EXPECT_EQ(placement.width, textures[placement.handle].width);
+        TAU_EXPECT_EQ(placement.height, textures[placement.handle].height);
+        placed[placement.handle] = true;
+    }
+
+    // A single thread has to find the same packing.
+    SkylinePacker serial(512, 512, 4);
+    TAU_ASSERT(serial.pack(textures.data(), textures.size(), 1));
+    TAU_EXPECT_EQ(serial.pageCount(), packer.pageCount());
+    TAU_EXPECT_EQ(serial.heuristic(), packer.heuristic());
+    TAU_EXPECT_FP_EQ_ABS(serial.occupancy(), packer.occupancy());
+}
+
 
 namespace TexturePackingTests {
 void runTests()
@@ -0,0 +1,188 @@
+#include "Benchmark.hpp"
+#include "TestRandom.hpp"
+#include <graphics/VertexQuantization.hpp>
+#include <model/MeshGenerator.hpp>
+#include <cmath>
+#include <vector>
+
+static constexpr uSys VertexCount = 65536;
+static constexpr float Extent = 100.0f;
+
+static float randomFloat(u32& random, const float min, const float max) noexcept
+{ return min + (max - min) * static_cast<float>(nextRandom(random) & 0xFFFFFF) / static_cast<float>(0xFFFFFF); }
+
+static void randomDirection(u32& random, float* const dst) noexcept
+{
+    float length;
+    do
+    {
+        dst[0] = randomFloat(random, -1.0f, 1.0f);
+        dst[1] = randomFloat(random, -1.0f, 1.0f);
+        dst[2] = randomFloat(random, -1.0f, 1.0f);
+        length = ::std::sqrt(dst[0] * dst[0] + dst[1] * dst[1] + dst[2] * dst[2]);
+    } while(length < 1e-3f || length > 1.0f);
+
+    dst[0] /= length;
+    dst[1] /= length;
+    dst[2] /= length;
+}
+
+/**
+ *   65,536 vertices with random positions, normals, tangents and
+ * texture coordinates, converted whole once per iteration.
+ */
+class VertexBatch final
+{
+    DELETE_CM(VertexBatch);
+public:
+    ::std::vector<float> positions;
+    ::std::vector<float> normals;
+    ::std::vector<float> tangents;
+    ::std::vector<float> textures;
+    ::std::vector<u32> indices;
+    ::std::vector<u16> halves;
+    ::std::vector<i16> octahedral;
+    ::std::vector<u32> packed;
+    ::std::vector<u16> unorms;
+    float textureMin[2];
+    float textureMax[2];
+public:
+    VertexBatch(const bool scalar) noexcept
+        : positions(VertexCount * 3)
+        , normals(VertexCount * 3)
+        , tangents(VertexCount * 3)
+        , textures(VertexCount * 2)
+        , indices(VertexCount)
+        , halves(VertexCount * 3)
+        , octahedral(VertexCount * 2)
+        , packed(VertexCount)
+        , unorms(VertexCount * 2)
+    {
+        u32 random = 0x9E7;
+        for(uSys i = 0; i < VertexCount; ++i)
+        {
+            positions[i * 3 + 0] = randomFloat(random, -Extent, Extent);
+            positions[i * 3 + 1] = randomFloat(random, -Extent, Extent);
+            positions[i * 3 + 2] = randomFloat(random, -Extent, Extent);
+            randomDirection(random, &normals[i * 3]);
+            randomDirection(random, &tangents[i * 3]);
+            textures[i * 2 + 0] = randomFloat(random, 0.0f, 4.0f);
+            textures[i * 2 + 1] = randomFloat(random, 0.0f, 4.0f);
+            indices[i] = static_cast<u32>(i);
+        }
+
+        VertexQuantization::computeBounds(textures.data(), VertexCount, 2, textureMin, textureMax);
+        VertexQuantization::forceScalar(scalar);
+    }
+
+    ~VertexBatch() noexcept
+    { VertexQuantization::forceScalar(false); }
+
+    [[nodiscard]] MeshGenerator::Mesh mesh() noexcept
+    { return { VertexCount, VertexCount, positions.data(), normals.data(), tangents.data(), null, textures.data(), indices.data() }; }
+};
+
+TAU_BENCHMARK(VertexQuantization, floatToHalfScalar)
+{
+    VertexBatch batch(true);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::floatToHalf(batch.positions.data(), batch.halves.data(), VertexCount * 3);
+        Benchmarks::doNotOptimize(batch.halves[i % batch.halves.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, floatToHalf)
+{
+    VertexBatch batch(false);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::floatToHalf(batch.positions.data(), batch.halves.data(), VertexCount * 3);
+        Benchmarks::doNotOptimize(batch.halves[i % batch.halves.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, octahedralScalar)
+{
+    VertexBatch batch(true);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::encodeOctahedral(batch.normals.data(), batch.octahedral.data(), VertexCount);
+        Benchmarks::doNotOptimize(batch.octahedral[i % batch.octahedral.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, octahedral)
+{
+    VertexBatch batch(false);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::encodeOctahedral(batch.normals.data(), batch.octahedral.data(), VertexCount);
+        Benchmarks::doNotOptimize(batch.octahedral[i % batch.octahedral.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, unitVectorsScalar)
+{
+    VertexBatch batch(true);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::encodeUnitVectors(batch.tangents.data(), batch.packed.data(), VertexCount);
+        Benchmarks::doNotOptimize(batch.packed[i % batch.packed.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, unitVectors)
+{
+    VertexBatch batch(false);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::encodeUnitVectors(batch.tangents.data(), batch.packed.data(), VertexCount);
+        Benchmarks::doNotOptimize(batch.packed[i % batch.packed.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, unorm16Scalar)
+{
+    VertexBatch batch(true);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::quantizeUNorm16(batch.textures.data(), batch.unorms.data(), VertexCount, 2, batch.textureMin, batch.textureMax);
+        Benchmarks::doNotOptimize(batch.unorms[i % batch.unorms.size()]);
+    }
+}
+
+TAU_BENCHMARK(VertexQuantization, unorm16)
+{
+    VertexBatch batch(false);
+
+    for(const uSys i : state)
+    {
+        VertexQuantization::quantizeUNorm16(batch.textures.data(), batch.unorms.data(), VertexCount, 2, batch.textureMin, batch.textureMax);
+        Benchmarks::doNotOptimize(batch.unorms[i % batch.unorms.size()]);
+    }
+}
+
+/**
+ * Quantizing and interleaving a whole mesh, allocations included.
+ */
+TAU_BENCHMARK(VertexQuantization, quantizeMesh)
+{
+    VertexBatch batch(false);
+    const MeshGenerator::Mesh mesh = batch.mesh();
+
+    for(const uSys i : state)
+    {
+        MeshGenerator::QuantizedMesh quantized = MeshGenerator::quantizeMesh(mesh);
+        Benchmarks::doNotOptimize(quantized.vertices);
+        quantized.destroy();
+        (void) i;
+    }
+}
@@ -0,0 +1,437 @@
+#include "UnitTest.hpp"
+#include "VertexQuantizationTest.hpp"
+#include "TestRandom.hpp"
+#include <graphics/VertexQuantization.hpp>
+#include <graphics/BufferDescriptor.hpp>
+#include <model/MeshGenerator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+static constexpr uSys VectorCount = 10003;
+
+static u32 floatBits(const f32 f) noexcept
+{
+    u32 ret;
+    ::std::memcpy(&ret, &f, sizeof(ret));
+    return ret;
+}
+
+static f32 bitsFloat(const u32 u) noexcept
+{
+    f32 ret;
+    ::std::memcpy(&ret, &u, sizeof(ret));
+    return ret;
+}
+
+static u32 toHalf(const f32 value) noexcept
+{
+    u16 ret;
+    VertexQuantization::floatToHalf(&value, &ret, 1);
+    return ret;
+}
+
+static float randomFloat(u32& random, const float min, const float max) noexcept
+{ return min + (max - min) * static_cast<float>(nextRandom(random) & 0xFFFFFF) / static_cast<float>(0xFFFFFF); }
+
+/**
+ *   `count` unit vectors, the axes and the edges of the octahedron
+ * first, then random directions.
+ */
+static ::std::vector<f32> unitVectors(const uSys count) noexcept
+{
+    static constexpr f32 Edges[][3] = {
+        {  1,  0,  0 }, { -1,  0,  0 }, {  0,  1,  0 }, {  0, -1,  0 }, {  0,  0,  1 }, {  0,  0, -1 },
+        {  1,  1,  0 }, { -1,  1,  0 }, {  1, -1,  0 }, { -1, -1,  0 },
+        {  1,  0, -1 }, { -1,  0, -1 }, {  0,  1, -1 }, {  0, -1, -1 },
+        {  1,  1,  1 }, { -1, -1, -1 }, {  1, -1, -1 }, { -1,  1, -1 }
+    };
+
+    ::std::vector<f32> ret;
+    ret.reserve(count * 3);
+
+    u32 random = 0x9E7;
+    for(uSys i = 0; i < count; ++i)
+    {
+        f32 v[3];
+        f32 length;
+        if(i < sizeof(Edges) / sizeof(Edges[0]))
+        {
+            ::std::memcpy(v, Edges[i], sizeof(v));
+            length = ::std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        }
+        else
+        {
+            // Rejecting points outside of the sphere keeps the directions uniform.
+            do
+            {
+                v[0] = randomFloat(random, -1.0f, 1.0f);
+                v[1] = randomFloat(random, -1.0f, 1.0f);
+                v[2] = randomFloat(random, -1.0f, 1.0f);
+                length = ::std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            } while(length < 1e-3f || length > 1.0f);
+        }
+
+        ret.push_back(v[0] / length);
+        ret.push_back(v[1] / length);
+        ret.push_back(v[2] / length);
+    }
+
+    return ret;
+}
+
+/**
+ * The angle between two directions in degrees.
+ */
+static double angleBetween(const f32* const a, const f32* const b) noexcept
+{
+    const double cx = static_cast<double>(a[1]) * b[2] - static_cast<double>(a[2]) * b[1];
+    const double cy = static_cast<double>(a[2]) * b[0] - static_cast<double>(a[0]) * b[2];
+    const double cz = static_cast<double>(a[0]) * b[1] - static_cast<double>(a[1]) * b[0];
+    const double dot = static_cast<double>(a[0]) * b[0] + static_cast<double>(a[1]) * b[1] + static_cast<double>(a[2]) * b[2];
+    return ::std::atan2(::std::sqrt(cx * cx + cy * cy + cz * cz), dot) * (180.0 / 3.14159265358979);
+}
+
+/**
+ * Runs `convert` with the scalar code and with SSE, and compares both outputs byte for byte.
+ */
+template<typename _T, typename _F>
+static bool scalarMatchesSimd(const uSys count, const _F& convert) noexcept
+{
+    ::std::vector<_T> scalar(count);
+    ::std::vector<_T> simd(count);
+
+    VertexQuantization::forceScalar(true);
+    convert(scalar.data());
+    VertexQuantization::forceScalar(false);
+    convert(simd.data());
+
+    return ::std::memcmp(scalar.data(), simd.data(), count * sizeof(_T)) == 0;
+}
+
+TAU_TEST(VertexQuantization, halfExactValues)
+{
+    TAU_EXPECT_EQ(toHalf(0.0f), 0x0000u);
+    TAU_EXPECT_EQ(toHalf(-0.0f), 0x8000u);
+    TAU_EXPECT_EQ(toHalf(1.0f), 0x3C00u);
+    TAU_EXPECT_EQ(toHalf(-2.0f), 0xC000u);
+    TAU_EXPECT_EQ(toHalf(0.5f), 0x3800u);
+    TAU_EXPECT_EQ(toHalf(0.1f), 0x2E66u);
+    TAU_EXPECT_EQ(toHalf(65504.0f), 0x7BFFu);
+    // The smallest normal and denormal halves.
+    TAU_EXPECT_EQ(toHalf(::std::ldexp(1.0f, -14)), 0x0400u);
+    TAU_EXPECT_EQ(toHalf(::std::ldexp(1.0f, -24)), 0x0001u);
+    TAU_EXPECT_EQ(toHalf(::std::ldexp(-1.0f, -24)), 0x8001u);
+}
+
+TAU_TEST(VertexQuantization, halfRoundsToNearestEven)
+{
+    // Halfway between 1 and the next half rounds down to the even mantissa.
+    TAU_EXPECT_EQ(toHalf(1.0f + ::std::ldexp(1.0f, -11)), 0x3C00u);
+    TAU_EXPECT_EQ(toHalf(1.0f + ::std::ldexp(3.0f, -11)), 0x3C02u);
+    // Just above halfway rounds up.
+    TAU_EXPECT_EQ(toHalf(bitsFloat(floatBits(1.0f + ::std::ldexp(1.0f, -11)) + 1)), 0x3C01u);
+    // The same in the denormal range.
+    TAU_EXPECT_EQ(toHalf(::std::ldexp(1.0f, -25)), 0x0000u);
+    TAU_EXPECT_EQ(toHalf(::std::ldexp(3.0f, -25)), 0x0002u);
+    TAU_EXPECT_EQ(toHalf(::std::ldexp(1.0f, -26)), 0x0000u);
+}
+
+TAU_TEST(VertexQuantization, halfOverflowAndNaN)
+{
+    // 65520 is halfway between the largest half and infinity.
+    TAU_EXPECT_EQ(toHalf(65519.0f), 0x7BFFu);
+    TAU_EXPECT_EQ(toHalf(65520.0f), 0x7C00u);
+    TAU_EXPECT_EQ(toHalf(1.0e6f), 0x7C00u);
+    TAU_EXPECT_EQ(toHalf(-1.0e6f), 0xFC00u);
+    TAU_EXPECT_EQ(toHalf(::std::numeric_limits<f32>::infinity()), 0x7C00u);
+    TAU_EXPECT_EQ(toHalf(-::std::numeric_limits<f32>::infinity()), 0xFC00u);
+    TAU_EXPECT_EQ(toHalf(::std::numeric_limits<f32>::quiet_NaN()), 0x7E00u);
+    TAU_EXPECT_EQ(toHalf(-::std::numeric_limits<f32>::quiet_NaN()), 0xFE00u);
+    // A NaN whose payload would be truncated away must stay a NaN.
+    TAU_EXPECT_EQ(toHalf(bitsFloat(0x7F800001u)), 0x7E00u);
+}
+
+TAU_TEST(VertexQuantization, halfRoundTrip)
+{
+    ::std::vector<u16> halves(0x10000);
+    for(uSys i = 0; i < halves.size(); ++i)
+    { halves[i] = static_cast<u16>(i); }
+
+    ::std::vector<f32> floats(halves.size());
+    ::std::vector<u16> back(halves.size());
+    VertexQuantization::halfToFloat(halves.data(), floats.data(), halves.size());
+    VertexQuantization::floatToHalf(floats.data(), back.data(), floats.size());
+
+    uSys mismatches = 0;
+    for(uSys i = 0; i < halves.size(); ++i)
+    {
+        const bool isNaN = (halves[i] & 0x7C00u) == 0x7C00u && (halves[i] & 0x03FFu) != 0;
+        if(isNaN)
+        { mismatches += !::std::isnan(floats[i]) || (back[i] & 0x7FFFu) != 0x7E00u; }
+        else
+        { mismatches += back[i] != halves[i]; }
+    }
+    TAU_EXPECT_EQ(mismatches, 0u);
+
+    TAU_EXPECT_EQ(floats[0x3C00], 1.0f);
+    TAU_EXPECT_EQ(floats[0xC000], -2.0f);
+    TAU_EXPECT_EQ(floats[0x0001], ::std::ldexp(1.0f, -24));
+    TAU_EXPECT_EQ(floats[0x7BFF], 65504.0f);
+    TAU_EXPECT(::std::isinf(floats[0x7C00]));
+}
+
+TAU_TEST(VertexQuantization, halfScalarMatchesSimd)
+{
+    // Random bit patterns cover every exponent, denormals and NaNs.
+    ::std::vector<f32> floats(VectorCount);
+    u32 random = 0x4A1F;
+    for(f32& f : floats)
+    { f = bitsFloat(nextRandom(random)); }
+
+    TAU_EXPECT((scalarMatchesSimd<u16>(floats.size(), [&](u16* const out) { VertexQuantization::floatToHalf(floats.data(), out, floats.size()); })));
+
+    ::std::vector<u16> halves(0x10000 + 3);
+    for(uSys i = 0; i < halves.size(); ++i)
+    { halves[i] = static_cast<u16>(i); }
+
+    TAU_EXPECT((scalarMatchesSimd<f32>(halves.size(), [&](f32* const out) { VertexQuantization::halfToFloat(halves.data(), out, halves.size()); })));
+}
+
+TAU_TEST(VertexQuantization, octahedralError)
+{
+    const ::std::vector<f32> normals = unitVectors(VectorCount);
+    ::std::vector<i16> encoded(VectorCount * 2);
+    ::std::vector<f32> decoded(VectorCount * 3);
+    VertexQuantization::encodeOctahedral(normals.data(), encoded.data(), VectorCount);
+    VertexQuantization::decodeOctahedral(encoded.data(), decoded.data(), VectorCount);
+
+    double maxError = 0.0;
+    double maxLengthError = 0.0;
+    for(uSys i = 0; i < VectorCount; ++i)
+    {
+        const f32* const n = &decoded[i * 3];
+        maxError = ::std::max(maxError, angleBetween(&normals[i * 3], n));
+        maxLengthError = ::std::max(maxLengthError, ::std::abs(::std::sqrt(static_cast<double>(n[0]) * n[0] + static_cast<double>(n[1]) * n[1] + static_cast<double>(n[2]) * n[2]) - 1.0));
+    }
+
+    TAU_EXPECT_LS(maxError, 0.01);
+    TAU_EXPECT_LS(maxLengthError, 1e-5);
+}
+
+TAU_TEST(VertexQuantization, octahedralAxes)
+{
+    static constexpr f32 Axes[] = { 0, 0, 1, 1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0 };
+    i16 encoded[10];
+    VertexQuantization::encodeOctahedral(Axes, encoded, 5);
+
+    // +z is the center of the map, -z its corners.
+    TAU_EXPECT_EQ(encoded[0], 0);
+    TAU_EXPECT_EQ(encoded[1], 0);
+    TAU_EXPECT_EQ(encoded[2], 32767);
+    TAU_EXPECT_EQ(encoded[3], 0);
+    TAU_EXPECT_EQ(encoded[4], 0);
+    TAU_EXPECT_EQ(encoded[5], -32767);
+    TAU_EXPECT_EQ(::std::abs(encoded[6]), 32767);
+    TAU_EXPECT_EQ(::std::abs(encoded[7]), 32767);
+    // Zero length normals encode to the center.
+    TAU_EXPECT_EQ(encoded[8], 0);
+    TAU_EXPECT_EQ(encoded[9], 0);
+}
+
+TAU_TEST(VertexQuantization, octahedralScalarMatchesSimd)
+{
+    // Unnormalized and zero length normals go through the same path.
+    ::std::vector<f32> normals = unitVectors(VectorCount);
+    for(uSys i = 0; i < normals.size(); i += 7)
+    { normals[i] *= 3.0f; }
+    normals[30] = normals[31] = normals[32] = 0.0f;
+
+    ::std::vector<i16> encoded(VectorCount * 2);
+    TAU_EXPECT((scalarMatchesSimd<i16>(encoded.size(), [&](i16* const out) { VertexQuantization::encodeOctahedral(normals.data(), out, VectorCount); })));
+
+    VertexQuantization::encodeOctahedral(normals.data(), encoded.data(), VectorCount);
+    TAU_EXPECT((scalarMatchesSimd<f32>(normals.size(), [&](f32* const out) { VertexQuantization::decodeOctahedral(encoded.data(), out, VectorCount); })));
+}
+
+TAU_TEST(VertexQuantization, unitVectors)
+{
+    static constexpr f32 Corners[] = { -1, -1, -1, 1, 1, 1 };
+    u32 corners[2];
+    VertexQuantization::encodeUnitVectors(Corners, corners, 2);
+    TAU_EXPECT_EQ(corners[0], 0xC0000000u);
+    TAU_EXPECT_EQ(corners[1], 0xFFFFFFFFu);
+
+    const ::std::vector<f32> vectors = unitVectors(VectorCount);
+    ::std::vector<u32> encoded(VectorCount);
+    VertexQuantization::encodeUnitVectors(vectors.data(), encoded.data(), VectorCount);
+
+    f32 maxError = 0.0f;
+    for(uSys i = 0; i < VectorCount; ++i)
+    {
+        for(uSys c = 0; c < 3; ++c)
+        {
+            const f32 decoded = static_cast<f32>((encoded[i] >> (c * 10)) & 0x3FF) / 511.5f - 1.0f;
+            maxError = ::std::max(maxError, ::std::abs(decoded - vectors[i * 3 + c]));
+        }
+    }
+    TAU_EXPECT_LEQ(maxError, 1.0f / 1023.0f + 1e-6f);
+
+    TAU_EXPECT((scalarMatchesSimd<u32>(VectorCount, [&](u32* const out) { VertexQuantization::encodeUnitVectors(vectors.data(), out, VectorCount); })));
+}
+
+TAU_TEST(VertexQuantization, unorm16)
+{
+    static constexpr uSys Components = 3;
+
+    ::std::vector<f32> values(VectorCount * Components);
+    u32 random = 0x7E4;
+    for(f32& value : values)
+    { value = randomFloat(random, -50.0f, 150.0f); }
+
+    f32 min[Components];
+    f32 max[Components];
+    VertexQuantization::computeBounds(values.data(), VectorCount, Components, min, max);
+
+    ::std::vector<u16> quantized(values.size());
+    VertexQuantization::quantizeUNorm16(values.data(), quantized.data(), VectorCount, Components, min, max);
+
+    uSys outOfBounds = 0;
+    f32 maxError[Components] = { };
+    u32 lowest[Components] = { 65535, 65535, 65535 };
+    u32 highest[Components] = { };
+    for(uSys i = 0; i < VectorCount; ++i)
+    {
+        for(uSys c = 0; c < Components; ++c)
+        {
+            const f32 value = values[i * Components + c];
+            outOfBounds += value < min[c] || value > max[c];
+            const f32 decoded = min[c] + quantized[i * Components + c] / 65535.0f * (max[c] - min[c]);
+            maxError[c] = ::std::max(maxError[c], ::std::abs(decoded - value));
+            lowest[c] = ::std::min<u32>(lowest[c], quantized[i * Components + c]);
+            highest[c] = ::std::max<u32>(highest[c], quantized[i * Components + c]);
+        }
+    }
+    TAU_EXPECT_EQ(outOfBounds, 0u);
+
+    for(uSys c = 0; c < Components; ++c)
+    {
+        // Half a step, and some room for the float error of decoding.
+        TAU_EXPECT_LEQ(maxError[c], (max[c] - min[c]) / 65535.0f * 0.5f + 1e-4f);
+        // The bounds map to both ends of the range.
+        TAU_EXPECT_EQ(lowest[c], 0u);
+        TAU_EXPECT_EQ(highest[c], 65535u);
+    }
+
+    TAU_EXPECT((scalarMatchesSimd<u16>(quantized.size(), [&](u16* const out) { VertexQuantization::quantizeUNorm16(values.data(), out, VectorCount, Components, min, max); })));
+}
+
+TAU_TEST(VertexQuantization, unorm16FlatBounds)
+{
+    static constexpr f32 Values[] = { 2.0f, 5.0f, 2.0f, 6.0f, 2.0f, 7.0f };
+    f32 min[2];
+    f32 max[2];
+    VertexQuantization::computeBounds(Values, 3, 2, min, max);
+    TAU_EXPECT_EQ(min[0], 2.0f);
+    TAU_EXPECT_EQ(max[0], 2.0f);
+    TAU_EXPECT_EQ(min[1], 5.0f);
+    TAU_EXPECT_EQ(max[1], 7.0f);
+
+    u16 quantized[6];
+    VertexQuantization::quantizeUNorm16(Values, quantized, 3, 2, min, max);
+    TAU_EXPECT_EQ(quantized[0], 0);
+    TAU_EXPECT_EQ(quantized[2], 0);
+    TAU_EXPECT_EQ(quantized[4], 0);
+    TAU_EXPECT_EQ(quantized[1], 0);
+    TAU_EXPECT_EQ(quantized[3], 32768);
+    TAU_EXPECT_EQ(quantized[5], 65535);
+}
+
+TAU_TEST(VertexQuantization, quantizeMesh)
+{
+    static constexpr uSys Count = 1001;
+
+    const ::std::vector<f32> normals = unitVectors(Count);
+    ::std::vector<f32> positions(Count * 3);
+    ::std::vector<f32> textures(Count * 2);
+    ::std::vector<u32> indices(Count);
+    u32 random = 0x3E5;
+    for(uSys i = 0; i < Count; ++i)
+    {
+        for(uSys c = 0; c < 3; ++c)
+        { positions[i * 3 + c] = randomFloat(random, -100.0f, 100.0f); }
+        textures[i * 2 + 0] = randomFloat(random, 0.0f, 4.0f);
+        textures[i * 2 + 1] = randomFloat(random, 0.0f, 4.0f);
+        indices[i] = static_cast<u32>(Count - 1 - i);
+    }
+
+    const MeshGenerator::Mesh mesh { Count, Count, positions.data(), normals.data(), normals.data(), null, textures.data(), indices.data() };
+    MeshGenerator::QuantizedMesh quantized = MeshGenerator::quantizeMesh(mesh);
+    TAU_ASSERT(quantized.vertices != null);
+
+    const uSys stride = quantized.descriptor.stride();
+    // Vector4UNorm16, Vector2SNorm16, Vector4UNorm10_10_10_2 and Vector2UNorm16.
+    TAU_EXPECT_EQ(stride, 20u);
+    TAU_EXPECT_EQ(quantized.indiceCount, Count);
+    TAU_EXPECT(::std::memcmp(quantized.indices, indices.data(), Count * sizeof(u32)) == 0);
+
+    const auto& elements = quantized.descriptor.elements();
+    f32 positionError = 0.0f;
+    f32 textureError = 0.0f;
+    double normalError = 0.0;
+    uSys wrongW = 0;
+    for(uSys i = 0; i < Count; ++i)
+    {
+        const u8* const vertex = quantized.vertices + i * stride;
+
+        u16 position[4];
+        i16 normal[2];
+        u16 texture[2];
+        ::std::memcpy(position, vertex + elements[0].offset(), sizeof(position));
+        ::std::memcpy(normal, vertex + elements[1].offset(), sizeof(normal));
+        ::std::memcpy(texture, vertex + elements[3].offset(), sizeof(texture));
+
+        wrongW += position[3] != 0xFFFF;
+        for(uSys c = 0; c < 3; ++c)
+        { positionError = ::std::max(positionError, ::std::abs(quantized.positionOffset[c] + position[c] / 65535.0f * quantized.positionScale[c] - positions[i * 3 + c])); }
+        for(uSys c = 0; c < 2; ++c)
+        { textureError = ::std::max(textureError, ::std::abs(quantized.textureOffset[c] + texture[c] / 65535.0f * quantized.textureScale[c] - textures[i * 2 + c])); }
+
+        f32 decoded[3];
+        VertexQuantization::decodeOctahedral(normal, decoded, 1);
+        normalError = ::std::max(normalError, angleBetween(&normals[i * 3], decoded));
+    }
+
+    TAU_EXPECT_EQ(wrongW, 0u);
+    TAU_EXPECT_LEQ(positionError, 200.0f / 65535.0f);
+    TAU_EXPECT_LEQ(textureError, 4.0f / 65535.0f);
+    TAU_EXPECT_LS(normalError, 0.01);
+
+    quantized.destroy();
+}
+
+TAU_TEST(ShaderDataType, floatTypes)
+{
+    TAU_EXPECT(ShaderDataType::isFloat(ShaderDataType::Vector4Float));
+    TAU_EXPECT(ShaderDataType::isFloat(ShaderDataType::Vector2Half));
+    TAU_EXPECT(ShaderDataType::isFloat(ShaderDataType::Vector4Half));
+    TAU_EXPECT(!ShaderDataType::isFloat(ShaderDataType::Vector4Double));
+    TAU_EXPECT(!ShaderDataType::isFloat(ShaderDataType::Vector2SNorm16));
+    TAU_EXPECT(ShaderDataType::isDouble(ShaderDataType::Vector4Double));
+    TAU_EXPECT(!ShaderDataType::isDouble(ShaderDataType::Vector4Half));
+
+    TAU_EXPECT(ShaderDataType::isPacked(ShaderDataType::Vector4Half));
+    TAU_EXPECT(ShaderDataType::isPacked(ShaderDataType::Vector4UNorm10_10_10_2));
+    TAU_EXPECT(!ShaderDataType::isPacked(ShaderDataType::Vector4Float));
+    TAU_EXPECT_EQ(ShaderDataType::size(ShaderDataType::Vector4Half), 8u);
+    TAU_EXPECT_EQ(ShaderDataType::size(ShaderDataType::Vector4UNorm10_10_10_2), 4u);
+}
+
+namespace VertexQuantizationTest {
+void runTests()
+{
+    RUN_ALL_TESTS();
+}
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+ *   Times every image kernel on each instruction set and with every
+ * hardware thread, and prints the throughput in megapixels per
+ * second next to the loops the kernels replaced.
+ */
+int imageBenchmark() noexcept;
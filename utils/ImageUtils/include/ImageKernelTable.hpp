@@ -0,0 +1,38 @@
+#pragma once
+
+#include <NumTypes.hpp>
+
+/**
+ *   The kernels for a single instruction set. Each one processes a
+ * span of pixels, or a single row, tiling and threading is done
+ * by the callers in ImageKernels.cpp.
+ *
+ *   The tables are built from ImageKernels.inl by one translation
+ * unit per instruction set, each compiled with its own flags.
+ */
+struct ImageKernelTable final
+{
+    void (*blend)(const u8* img0, const u8* img1, u8* out, uSys pixelCount, u32 weight) noexcept;
+    void (*average)(const u8* img0, const u8* img1, u8* out, uSys pixelCount) noexcept;
+    void (*multiply)(const u8* img0, const u8* img1, u8* out, uSys pixelCount) noexcept;
+    void (*premultiply)(const u8* in, u8* out, uSys pixelCount) noexcept;
+    void (*swizzle)(const u8* in, u8* out, uSys pixelCount, const u8* order) noexcept;
+    void (*toFloat)(const u8* in, f32* out, uSys pixelCount) noexcept;
+    void (*fromFloat)(const f32* in, u8* out, uSys pixelCount) noexcept;
+    /**
+     *   Bilinearly samples one output row from two input rows.
+     * `x0` and `x1` are the left and right input pixel of every
+     * output pixel and `fx` the weight of the right one.
+     */
+    void (*resizeRow)(const u8* row0, const u8* row1, f32 fy, const u32* x0, const u32* x1, const f32* fx, u8* out, u32 outWidth) noexcept;
+    void (*mandelbrotRow)(u8* out, u32 width, u32 height, u32 y, u32 iters) noexcept;
+};
+
+extern const ImageKernelTable imageKernelsScalar;
+extern const ImageKernelTable imageKernelsSSE41;
+extern const ImageKernelTable imageKernelsAVX2;
+
+/**
+ * The kernels for the active instruction set.
+ */
+const ImageKernelTable& imageKernels() noexcept;
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <NumTypes.hpp>
+
+/**
+ *   Image processing kernels for 32 bit BGRA images, the layout
+ * every Texture in ImageUtils uses. Images are tightly packed,
+ * with a stride of width * 4 bytes.
+ *
+ *   Every kernel splits the image into cache sized tiles which are
+ * processed across a shared thread pool. Each tile runs the widest
+ * implementation the processor supports, this is detected once
+ * and can be overridden with imageForceISA.
+ *
+ *   Inputs and outputs may only alias where noted.
+ */
+
+/**
+ * The instruction sets the kernels are built for.
+ */
+enum class ImageISA : u8
+{
+    /**
+     * Plain C++, the reference the other paths are checked against.
+     */
+    Scalar = 0,
+    SSE41,
+    AVX2
+};
+
+/**
+ * Detects the highest supported instruction set of this processor.
+ */
+ImageISA imageDetectISA() noexcept;
+
+/**
+ * The instruction set the kernels dispatch to.
+ */
+ImageISA imageActiveISA() noexcept;
+
+/**
+ *   Overrides the instruction set the kernels dispatch to, this is
+ * clamped to the detected instruction set.
+ *
+ * @return
+ *      The instruction set that is now active.
+ */
+ImageISA imageForceISA(ImageISA isa) noexcept;
+
+/**
+ *   Sets the number of threads the kernels use, including the
+ * calling thread. This defaults to the number of hardware threads.
+ * Must not be called while a kernel is running.
+ */
+void imageThreadCount(u32 count) noexcept;
+u32 imageThreadCount() noexcept;
+
+/**
+ *   Linearly interpolates between two images, a ratio of 0 returns
+ * img0 and 1 returns img1. The ratio is quantized to 1/256 steps.
+ * `out` may alias either input.
+ */
+void imageBlend(const u8* img0, const u8* img1, u8* out, u32 width, u32 height, f32 ratio) noexcept;
+
+/**
+ * The rounded average of two images. `out` may alias either input.
+ */
+void imageAverage(const u8* img0, const u8* img1, u8* out, u32 width, u32 height) noexcept;
+
+/**
+ *   Multiplies two images as if each channel was in [0, 1], the
+ * result is rounded. `out` may alias either input.
+ */
+void imageMultiply(const u8* img0, const u8* img1, u8* out, u32 width, u32 height) noexcept;
+
+/**
+ * Multiplies the color channels by alpha. `out` may alias `in`.
+ */
+void imagePremultiply(const u8* in, u8* out, u32 width, u32 height) noexcept;
+
+/**
+ *   Reorders the channels of every pixel, output channel i is input
+ * channel `order[i]`. Every entry of `order` must be less than 4.
+ * `out` may alias `in`.
+ */
+void imageSwizzle(const u8* in, u8* out, u32 width, u32 height, const u8 order[4]) noexcept;
+
+/**
+ * Converts to 4 floats per pixel in [0, 1].
+ */
+void imageToFloat(const u8* in, f32* out, u32 width, u32 height) noexcept;
+
+/**
+ *   Converts from 4 floats per pixel, values are clamped to [0, 1]
+ * and rounded. NaNs become 0.
+ */
+void imageFromFloat(const f32* in, u8* out, u32 width, u32 height) noexcept;
+
+/**
+ *   Resizes with bilinear filtering, sampling at pixel centers.
+ * Intended for factors of up to 2, larger reductions skip pixels.
+ */
+void imageResize(const u8* in, u32 inWidth, u32 inHeight, u8* out, u32 outWidth, u32 outHeight) noexcept;
+
+/**
+ *   Renders the mandelbrot set into the red channel, the other
+ * color channels are 0 and alpha is opaque.
+ */
+void imageMandelbrot(u8* out, u32 width, u32 height, u32 iters) noexcept;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Texture.hpp>
+#include <ImageKernels.hpp>
 #include <Utils.hpp>
 #include <ratio>
 
@@ -38,20 +39,9 @@ TextureBlend* mix(const _Img0* const img0, const _Img1* const img1, const double
     if(img0->width != img1->width || img0->height != img1->height || img0->bitsPerPixel != img1->bitsPerPixel)
     { return null; }
 
-    const u8* const pix0 = img0->pixels;
-    const u8* const pix1 = img1->pixels;
-    const u32 len = img0->width * img0->height * 4;
-    u8* const ret = new u8[len];
+    u8* const ret = new u8[img0->width * img0->height * 4];
 
-    const double invRatio = 1.0 - ratio;
-
-    for(u32 i = 0; i < len; ++i)
-    {
-        const double a = pix0[i] * invRatio;
-        const double b = pix1[i] * ratio;
-        const double mixed = a + b;
-        ret[i] = fastRound<double, u8>(mixed);
-    }
+    imageBlend(img0->pixels, img1->pixels, ret, img0->width, img0->height, static_cast<f32>(ratio));
 
     return new TextureBlend(new Texture(img0->width, img0->height, ret, 32));
 }
@@ -62,21 +52,9 @@ TextureBlend* mix(const _Img0* const img0, const _Img1* const img1) noexcept
     if(img0->width != img1->width || img0->height != img1->height || img0->bitsPerPixel != img1->bitsPerPixel)
     { return null; }
 
-    const u8* const pix0 = img0->pixels;
-    const u8* const pix1 = img1->pixels;
-    const u32 len = img0->width * img0->height * 4;
-    u8* const ret = new u8[len];
+    u8* const ret = new u8[img0->width * img0->height * 4];
 
-    const double ratio = static_cast<double>(_RatioNum) / static_cast<double>(_RatioDen);
-    const double invRatio = 1.0 - ratio;
-
-    for(u32 i = 0; i < len; ++i)
-    {
-        const double a = pix0[i] * invRatio;
-        const double b = pix1[i] * ratio;
-        const double mixed = a + b;
-        ret[i] = fastRound<double, u8>(mixed);
-    }
+    imageBlend(img0->pixels, img1->pixels, ret, img0->width, img0->height, static_cast<f32>(_RatioNum) / static_cast<f32>(_RatioDen));
 
     return new TextureBlend(new Texture(img0->width, img0->height, ret, 32));
 }
@@ -87,16 +65,9 @@ TextureBlend* avg(const _Img0* const img0, const _Img1* const img1) noexcept
     if(img0->width != img1->width || img0->height != img1->height || img0->bitsPerPixel != img1->bitsPerPixel)
     { return null; }
 
-    const u8* const pix0 = img0->pixels;
-    const u8* const pix1 = img1->pixels;
-    const u32 len = img0->width * img0->height * 4;
-    u8* const ret = new u8[len];
+    u8* const ret = new u8[img0->width * img0->height * 4];
 
-    for(u32 i = 0; i < len; ++i)
-    {
-        const double mixed = (pix0[i] + pix1[i]) * 0.5;
-        ret[i] = fastRound<double, u8>(mixed);
-    }
+    imageAverage(img0->pixels, img1->pixels, ret, img0->width, img0->height);
 
     return new TextureBlend(new Texture(img0->width, img0->height, ret, 32));
 }
@@ -107,16 +78,9 @@ TextureBlend* mulImages(const _Img0* const img0, const _Img1* const img1) noexce
     if(img0->width != img1->width || img0->height != img1->height || img0->bitsPerPixel != img1->bitsPerPixel)
     { return null; }
 
-    const u8* const pix0 = img0->pixels;
-    const u8* const pix1 = img1->pixels;
-    const u32 len = img0->width * img0->height * 4;
-    u8* const ret = new u8[len];
+    u8* const ret = new u8[img0->width * img0->height * 4];
 
-    for(u32 i = 0; i < len; ++i)
-    {
-        const u32 multiplied = static_cast<u32>(pix0[i]) * static_cast<u32>(pix1[i]);
-        ret[i] = fastRound<double, u8>(multiplied / 255.0);
-    }
+    imageMultiply(img0->pixels, img1->pixels, ret, img0->width, img0->height);
 
     return new TextureBlend(new Texture(img0->width, img0->height, ret, 32));
 }
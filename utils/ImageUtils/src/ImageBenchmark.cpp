@@ -0,0 +1,212 @@
+#include "ImageBenchmark.hpp"
+#include <ImageKernels.hpp>
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static constexpr u32 Width = 2048;
+static constexpr u32 Height = 2048;
+static constexpr uSys PixelCount = static_cast<uSys>(Width) * Height;
+static constexpr u32 MandelbrotSize = 512;
+static constexpr u32 MandelbrotIters = 256;
+static constexpr u32 Runs = 5;
+
+/**
+ * The per channel double loop mix and avg used before the kernels.
+ */
+static void legacyMix(const u8* const pix0, const u8* const pix1, u8* const ret, const double ratio) noexcept
+{
+    const double invRatio = 1.0 - ratio;
+    for(uSys i = 0; i < PixelCount * 4; ++i)
+    { ret[i] = static_cast<u8>(pix0[i] * invRatio + pix1[i] * ratio + 0.5); }
+}
+
+static void legacyAvg(const u8* const pix0, const u8* const pix1, u8* const ret) noexcept
+{
+    for(uSys i = 0; i < PixelCount * 4; ++i)
+    { ret[i] = static_cast<u8>((pix0[i] + pix1[i]) * 0.5 + 0.5); }
+}
+
+static void legacyMul(const u8* const pix0, const u8* const pix1, u8* const ret) noexcept
+{
+    for(uSys i = 0; i < PixelCount * 4; ++i)
+    { ret[i] = static_cast<u8>(static_cast<u32>(pix0[i]) * pix1[i] / 255.0 + 0.5); }
+}
+
+/**
+ * The std::complex, column major renderer used before the kernels.
+ */
+static void legacyMandelbrot(u8* const ret, const u32 width, const u32 height, const u32 iters) noexcept
+{
+    const float fWidth = static_cast<float>(width);
+    const float fHeight = static_cast<float>(height);
+
+    u32 index = 0;
+    for(u32 i = 0; i < width; ++i)
+    {
+        for(u32 j = 0; j < height; ++j)
+        {
+            const std::complex<float> point(((j / fWidth) - 0.75f) * 2.25f, ((i / fHeight) - 0.5f) * 2.25f);
+            std::complex<float> z(0.0f, 0.0f);
+            u32 nbIter;
+            for(nbIter = 0; abs(z) < 2 && nbIter <= iters; ++nbIter)
+            { z = z * z + point; }
+
+            ret[index++] = 0;
+            ret[index++] = 0;
+            ret[index++] = nbIter < iters ? static_cast<u8>((255 * nbIter) / (iters - 1)) : 0;
+            ret[index++] = 0xFF;
+        }
+    }
+}
+
+template<typename _F>
+static double megapixelsPerSecond(const uSys pixels, const _F& func) noexcept
+{
+    double best = 1e30;
+    for(u32 i = 0; i < Runs; ++i)
+    {
+        const auto start = ::std::chrono::high_resolution_clock::now();
+        func();
+        const auto end = ::std::chrono::high_resolution_clock::now();
+        best = ::std::min(best, ::std::chrono::duration<double>(end - start).count());
+    }
+    return static_cast<double>(pixels) / best / 1e6;
+}
+
+struct Kernel final
+{
+    const char* name;
+    uSys pixels;
+    /**
+     * The output of the kernel, compared against the scalar path.
+     */
+    const u8* output;
+    uSys outputSize;
+    void (*run)(void* context) noexcept;
+    void (*legacy)(void* context) noexcept;
+};
+
+struct Buffers final
+{
+    ::std::vector<u8> img0;
+    ::std::vector<u8> img1;
+    ::std::vector<u8> out;
+    ::std::vector<f32> floats;
+    ::std::vector<u8> resized;
+    ::std::vector<u8> fractal;
+};
+
+int imageBenchmark() noexcept
+{
+    Buffers buffers;
+    buffers.img0.resize(PixelCount * 4);
+    buffers.img1.resize(PixelCount * 4);
+    buffers.out.resize(PixelCount * 4);
+    buffers.floats.resize(PixelCount * 4);
+    buffers.resized.resize(PixelCount);
+    buffers.fractal.resize(static_cast<uSys>(MandelbrotSize) * MandelbrotSize * 4);
+
+    u32 random = 0x9E3779B9;
+    for(uSys i = 0; i < PixelCount * 4; ++i)
+    {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        buffers.img0[i] = static_cast<u8>(random);
+        buffers.img1[i] = static_cast<u8>(random >> 8);
+    }
+    imageToFloat(buffers.img0.data(), buffers.floats.data(), Width, Height);
+
+    void* const context = &buffers;
+#define BUFFERS (*static_cast<Buffers*>(context))
+    const Kernel kernels[] = {
+        { "blend", PixelCount, buffers.out.data(), buffers.out.size(),
+          [](void* context) noexcept { imageBlend(BUFFERS.img0.data(), BUFFERS.img1.data(), BUFFERS.out.data(), Width, Height, 0.3f); },
+          [](void* context) noexcept { legacyMix(BUFFERS.img0.data(), BUFFERS.img1.data(), BUFFERS.out.data(), 0.3); } },
+        { "average", PixelCount, buffers.out.data(), buffers.out.size(),
+          [](void* context) noexcept { imageAverage(BUFFERS.img0.data(), BUFFERS.img1.data(), BUFFERS.out.data(), Width, Height); },
+          [](void* context) noexcept { legacyAvg(BUFFERS.img0.data(), BUFFERS.img1.data(), BUFFERS.out.data()); } },
+        { "multiply", PixelCount, buffers.out.data(), buffers.out.size(),
+          [](void* context) noexcept { imageMultiply(BUFFERS.img0.data(), BUFFERS.img1.data(), BUFFERS.out.data(), Width, Height); },
+          [](void* context) noexcept { legacyMul(BUFFERS.img0.data(), BUFFERS.img1.data(), BUFFERS.out.data()); } },
+        { "premultiply", PixelCount, buffers.out.data(), buffers.out.size(),
+          [](void* context) noexcept { imagePremultiply(BUFFERS.img0.data(), BUFFERS.out.data(), Width, Height); },
+          nullptr },
+        { "swizzle", PixelCount, buffers.out.data(), buffers.out.size(),
+          [](void* context) noexcept
+          {
+              static const u8 order[4] = { 2, 1, 0, 3 };
+              imageSwizzle(BUFFERS.img0.data(), BUFFERS.out.data(), Width, Height, order);
+          },
+          nullptr },
+        { "to float", PixelCount, reinterpret_cast<const u8*>(buffers.floats.data()), buffers.floats.size() * sizeof(f32),
+          [](void* context) noexcept { imageToFloat(BUFFERS.img1.data(), BUFFERS.floats.data(), Width, Height); },
+          nullptr },
+        { "from float", PixelCount, buffers.out.data(), buffers.out.size(),
+          [](void* context) noexcept { imageFromFloat(BUFFERS.floats.data(), BUFFERS.out.data(), Width, Height); },
+          nullptr },
+        { "resize 1/2", PixelCount / 4, buffers.resized.data(), buffers.resized.size(),
+          [](void* context) noexcept { imageResize(BUFFERS.img0.data(), Width, Height, BUFFERS.resized.data(), Width / 2, Height / 2); },
+          nullptr },
+        { "mandelbrot", static_cast<uSys>(MandelbrotSize) * MandelbrotSize, buffers.fractal.data(), buffers.fractal.size(),
+          [](void* context) noexcept { imageMandelbrot(BUFFERS.fractal.data(), MandelbrotSize, MandelbrotSize, MandelbrotIters); },
+          [](void* context) noexcept { legacyMandelbrot(BUFFERS.fractal.data(), MandelbrotSize, MandelbrotSize, MandelbrotIters); } },
+    };
+#undef BUFFERS
+
+    const ImageISA detected = imageDetectISA();
+    const u32 hardwareThreads = ::std::max(::std::thread::hardware_concurrency(), 1u);
+
+    ::std::printf("%ux%u images, mandelbrot %ux%u with %u iterations, best of %u runs.\n", Width, Height, MandelbrotSize, MandelbrotSize, MandelbrotIters, Runs);
+    ::std::printf("MPix/s       %10s %10s %10s %10s %10s %12s\n", "legacy", "scalar", "SSE4.1", "AVX2", "threads", "mismatches");
+
+    ::std::vector<u8> reference;
+    for(const Kernel& kernel : kernels)
+    {
+        double results[5] = { };
+        u32 mismatches = 0;
+
+        imageThreadCount(1);
+
+        if(kernel.legacy)
+        { results[0] = megapixelsPerSecond(kernel.pixels, [&]() { kernel.legacy(context); }); }
+
+        for(u32 isa = 0; isa <= static_cast<u32>(ImageISA::AVX2); ++isa)
+        {
+            if(isa > static_cast<u32>(detected))
+            { break; }
+
+            imageForceISA(static_cast<ImageISA>(isa));
+            results[1 + isa] = megapixelsPerSecond(kernel.pixels, [&]() { kernel.run(context); });
+
+            if(isa == 0)
+            { reference.assign(kernel.output, kernel.output + kernel.outputSize); }
+            else
+            {
+                for(uSys i = 0; i < kernel.outputSize; ++i)
+                { mismatches += kernel.output[i] != reference[i]; }
+            }
+        }
+
+        imageThreadCount(hardwareThreads);
+        results[4] = megapixelsPerSecond(kernel.pixels, [&]() { kernel.run(context); });
+
+        ::std::printf("%-12s", kernel.name);
+        for(const double result : results)
+        {
+            if(result > 0.0)
+            { ::std::printf(" %10.1f", result); }
+            else
+            { ::std::printf(" %10s", "-"); }
+        }
+        ::std::printf(" %12u\n", mismatches);
+    }
+
+    ::std::printf("Threads: %u, active ISA: %u\n", hardwareThreads, static_cast<u32>(detected));
+    return 0;
+}
@@ -0,0 +1,394 @@
+#include "ImageKernels.hpp"
+#include "ImageKernelTable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#else
+  #include <cpuid.h>
+#endif
+
+/**
+ *   The number of pixels in a tile, each input and output of a
+ * tile fits into the L2 cache alongside the others.
+ */
+static constexpr uSys TilePixels = 16384;
+
+static void cpuid(int* const registers, const int leaf, const int subLeaf) noexcept
+{
+#ifdef _MSC_VER
+    __cpuidex(registers, leaf, subLeaf);
+#else
+    unsigned eax, ebx, ecx, edx;
+    __cpuid_count(leaf, subLeaf, eax, ebx, ecx, edx);
+    registers[0] = static_cast<int>(eax);
+    registers[1] = static_cast<int>(ebx);
+    registers[2] = static_cast<int>(ecx);
+    registers[3] = static_cast<int>(edx);
+#endif
+}
+
+/**
+ * The register state the OS saves on a context switch.
+ */
+static unsigned long long xcr0() noexcept
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+ImageISA imageDetectISA() noexcept
+{
+    int registers[4];
+    cpuid(registers, 0, 0);
+    const int maxLeaf = registers[0];
+
+    cpuid(registers, 1, 0);
+    const bool sse41 = (registers[2] & (1 << 19)) != 0;
+    const bool osxsave = (registers[2] & (1 << 27)) != 0;
+    const bool avx = (registers[2] & (1 << 28)) != 0;
+
+    if(!sse41)
+    { return ImageISA::Scalar; }
+
+    // The XMM and YMM registers.
+    if(maxLeaf < 7 || !osxsave || !avx || (xcr0() & 0x6) != 0x6)
+    { return ImageISA::SSE41; }
+
+    cpuid(registers, 7, 0);
+    const bool avx2 = (registers[1] & (1 << 5)) != 0;
+
+    return avx2 ? ImageISA::AVX2 : ImageISA::SSE41;
+}
+
+static const ImageKernelTable* kernelsFor(const ImageISA isa) noexcept
+{
+    switch(isa)
+    {
+        case ImageISA::AVX2: return &imageKernelsAVX2;
+        case ImageISA::SSE41: return &imageKernelsSSE41;
+        case ImageISA::Scalar:
+        default: return &imageKernelsScalar;
+    }
+}
+
+static ::std::atomic<int> activeISA(-1);
+static ::std::atomic<const ImageKernelTable*> activeKernels(nullptr);
+
+ImageISA imageActiveISA() noexcept
+{
+    (void) imageKernels();
+    return static_cast<ImageISA>(activeISA.load(::std::memory_order_relaxed));
+}
+
+ImageISA imageForceISA(ImageISA isa) noexcept
+{
+    const ImageISA detected = imageDetectISA();
+    if(static_cast<int>(isa) > static_cast<int>(detected))
+    { isa = detected; }
+
+    activeISA.store(static_cast<int>(isa), ::std::memory_order_relaxed);
+    activeKernels.store(kernelsFor(isa), ::std::memory_order_release);
+    return isa;
+}
+
+const ImageKernelTable& imageKernels() noexcept
+{
+    const ImageKernelTable* kernels = activeKernels.load(::std::memory_order_acquire);
+    if(!kernels)
+    {
+        // Detection is idempotent, racing threads all store the same values.
+        (void) imageForceISA(ImageISA::AVX2);
+        kernels = activeKernels.load(::std::memory_order_acquire);
+    }
+    return *kernels;
+}
+
+/**
+ *   A fixed set of threads that take tiles off of a shared counter.
+ * The calling thread takes tiles as well and returns once every
+ * tile is done.
+ */
+class ImageThreadPool final
+{
+public:
+    using TaskFunc = void(*)(const void* context, u32 task) noexcept;
+private:
+    ::std::vector<::std::thread> _threads;
+
+    ::std::mutex _runMutex;
+
+    ::std::mutex _mutex;
+    ::std::condition_variable _wake;
+    ::std::condition_variable _done;
+    u64 _generation;
+    u32 _running;
+    bool _stop;
+
+    TaskFunc _func;
+    const void* _context;
+    u32 _taskCount;
+    ::std::atomic<u32> _nextTask;
+public:
+    ImageThreadPool(const u32 threadCount) noexcept
+        : _threads()
+        , _runMutex()
+        , _mutex()
+        , _wake()
+        , _done()
+        , _generation(0)
+        , _running(0)
+        , _stop(false)
+        , _func(nullptr)
+        , _context(nullptr)
+        , _taskCount(0)
+        , _nextTask(0)
+    {
+        _threads.reserve(threadCount);
+        for(u32 i = 0; i < threadCount; ++i)
+        {
+            _threads.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~ImageThreadPool() noexcept
+    {
+        {
+            ::std::lock_guard<::std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+
+        for(::std::thread& thread : _threads)
+        { thread.join(); }
+    }
+
+    ImageThreadPool(const ImageThreadPool& copy) noexcept = delete;
+    ImageThreadPool(ImageThreadPool&& move) noexcept = delete;
+
+    ImageThreadPool& operator =(const ImageThreadPool& copy) noexcept = delete;
+    ImageThreadPool& operator =(ImageThreadPool&& move) noexcept = delete;
+
+    [[nodiscard]] u32 threadCount() const noexcept { return static_cast<u32>(_threads.size()) + 1; }
+
+    void run(const u32 taskCount, const TaskFunc func, const void* const context) noexcept
+    {
+        // Kernels may be called from several threads, they take turns.
+        ::std::lock_guard<::std::mutex> runLock(_runMutex);
+
+        {
+            ::std::lock_guard<::std::mutex> lock(_mutex);
+            _func = func;
+            _context = context;
+            _taskCount = taskCount;
+            _nextTask.store(0, ::std::memory_order_relaxed);
+            _running = static_cast<u32>(_threads.size());
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        drain();
+
+        ::std::unique_lock<::std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _running == 0; });
+    }
+private:
+    void drain() noexcept
+    {
+        for(u32 task = _nextTask.fetch_add(1, ::std::memory_order_relaxed); task < _taskCount; task = _nextTask.fetch_add(1, ::std::memory_order_relaxed))
+        { _func(_context, task); }
+    }
+
+    void work() noexcept
+    {
+        u64 seen = 0;
+        for(;;)
+        {
+            {
+                ::std::unique_lock<::std::mutex> lock(_mutex);
+                _wake.wait(lock, [this, seen]() { return _stop || _generation != seen; });
+                if(_stop)
+                { return; }
+                seen = _generation;
+            }
+
+            drain();
+
+            ::std::lock_guard<::std::mutex> lock(_mutex);
+            if(--_running == 0)
+            { _done.notify_one(); }
+        }
+    }
+};
+
+static ::std::unique_ptr<ImageThreadPool> threadPool;
+static ::std::once_flag threadPoolInit;
+
+static ImageThreadPool& pool() noexcept
+{
+    ::std::call_once(threadPoolInit, []()
+    {
+        if(!threadPool)
+        { threadPool = ::std::make_unique<ImageThreadPool>(::std::max(::std::thread::hardware_concurrency(), 1u) - 1); }
+    });
+    return *threadPool;
+}
+
+void imageThreadCount(const u32 count) noexcept
+{
+    // Claims the lazy initialization, so that it can't replace this pool.
+    ::std::call_once(threadPoolInit, []() { });
+    threadPool = ::std::make_unique<ImageThreadPool>(::std::max(count, 1u) - 1);
+}
+
+u32 imageThreadCount() noexcept
+{ return pool().threadCount(); }
+
+template<typename _F>
+static void parallelFor(const u32 taskCount, const _F& func) noexcept
+{
+    ImageThreadPool& threads = pool();
+    if(taskCount <= 1 || threads.threadCount() == 1)
+    {
+        for(u32 i = 0; i < taskCount; ++i)
+        { func(i); }
+        return;
+    }
+
+    threads.run(taskCount, [](const void* const context, const u32 task) noexcept { (*static_cast<const _F*>(context))(task); }, &func);
+}
+
+/**
+ * Calls `func(firstPixel, pixelCount)` for every tile.
+ */
+template<typename _F>
+static void forEachTile(const u32 width, const u32 height, const _F& func) noexcept
+{
+    const uSys pixelCount = static_cast<uSys>(width) * height;
+    const u32 tileCount = static_cast<u32>((pixelCount + TilePixels - 1) / TilePixels);
+
+    parallelFor(tileCount, [&](const u32 tile)
+    {
+        const uSys first = static_cast<uSys>(tile) * TilePixels;
+        func(first, ::std::min(TilePixels, pixelCount - first));
+    });
+}
+
+void imageBlend(const u8* const img0, const u8* const img1, u8* const out, const u32 width, const u32 height, const f32 ratio) noexcept
+{
+    const f32 clamped = ratio > 0.0f ? (ratio < 1.0f ? ratio : 1.0f) : 0.0f;
+    const u32 weight = static_cast<u32>(clamped * 256.0f + 0.5f);
+
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.blend(img0 + first * 4, img1 + first * 4, out + first * 4, count, weight); });
+}
+
+void imageAverage(const u8* const img0, const u8* const img1, u8* const out, const u32 width, const u32 height) noexcept
+{
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.average(img0 + first * 4, img1 + first * 4, out + first * 4, count); });
+}
+
+void imageMultiply(const u8* const img0, const u8* const img1, u8* const out, const u32 width, const u32 height) noexcept
+{
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.multiply(img0 + first * 4, img1 + first * 4, out + first * 4, count); });
+}
+
+void imagePremultiply(const u8* const in, u8* const out, const u32 width, const u32 height) noexcept
+{
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.premultiply(in + first * 4, out + first * 4, count); });
+}
+
+void imageSwizzle(const u8* const in, u8* const out, const u32 width, const u32 height, const u8 order[4]) noexcept
+{
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.swizzle(in + first * 4, out + first * 4, count, order); });
+}
+
+void imageToFloat(const u8* const in, f32* const out, const u32 width, const u32 height) noexcept
+{
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.toFloat(in + first * 4, out + first * 4, count); });
+}
+
+void imageFromFloat(const f32* const in, u8* const out, const u32 width, const u32 height) noexcept
+{
+    const ImageKernelTable& kernels = imageKernels();
+    forEachTile(width, height, [&](const uSys first, const uSys count)
+    { kernels.fromFloat(in + first * 4, out + first * 4, count); });
+}
+
+/**
+ *   Maps an output coordinate to the two input coordinates it sits
+ * between, and the weight of the second one.
+ */
+static void sourceCoordinate(const u32 outCoord, const u32 inSize, const u32 outSize, u32* const first, u32* const second, f32* const weight) noexcept
+{
+    const f32 source = (static_cast<f32>(outCoord) + 0.5f) * (static_cast<f32>(inSize) / static_cast<f32>(outSize)) - 0.5f;
+    const f32 clamped = source > 0.0f ? source : 0.0f;
+
+    *first = ::std::min(static_cast<u32>(clamped), inSize - 1);
+    *second = ::std::min(*first + 1, inSize - 1);
+    *weight = clamped - static_cast<f32>(*first);
+    if(*weight > 1.0f)
+    { *weight = 1.0f; }
+}
+
+void imageResize(const u8* const in, const u32 inWidth, const u32 inHeight, u8* const out, const u32 outWidth, const u32 outHeight) noexcept
+{
+    if(!inWidth || !inHeight || !outWidth || !outHeight)
+    { return; }
+
+    ::std::vector<u32> x0(outWidth);
+    ::std::vector<u32> x1(outWidth);
+    ::std::vector<f32> fx(outWidth);
+    for(u32 x = 0; x < outWidth; ++x)
+    { sourceCoordinate(x, inWidth, outWidth, &x0[x], &x1[x], &fx[x]); }
+
+    const u32 rowsPerTile = static_cast<u32>(::std::max<uSys>(TilePixels / outWidth, 1));
+    const u32 tileCount = (outHeight + rowsPerTile - 1) / rowsPerTile;
+    const uSys inStride = static_cast<uSys>(inWidth) * 4;
+    const uSys outStride = static_cast<uSys>(outWidth) * 4;
+
+    const ImageKernelTable& kernels = imageKernels();
+    parallelFor(tileCount, [&](const u32 tile)
+    {
+        const u32 end = ::std::min(outHeight, (tile + 1) * rowsPerTile);
+        for(u32 y = tile * rowsPerTile; y < end; ++y)
+        {
+            u32 y0, y1;
+            f32 fy;
+            sourceCoordinate(y, inHeight, outHeight, &y0, &y1, &fy);
+            kernels.resizeRow(in + y0 * inStride, in + y1 * inStride, fy, x0.data(), x1.data(), fx.data(), out + y * outStride, outWidth);
+        }
+    });
+}
+
+void imageMandelbrot(u8* const out, const u32 width, const u32 height, const u32 iters) noexcept
+{
+    const uSys stride = static_cast<uSys>(width) * 4;
+
+    // The cost of a row varies wildly, single rows balance the best.
+    const ImageKernelTable& kernels = imageKernels();
+    parallelFor(height, [&](const u32 y)
+    { kernels.mandelbrotRow(out + y * stride, width, height, y, iters); });
+}
@@ -0,0 +1,618 @@
+/**
+ *   Builds an image kernel table. The including file must define
+ * IMAGE_KERNEL_TABLE, and IMAGE_KERNEL_LEVEL as 0 for scalar, 1 for
+ * SSE4.1 or 2 for AVX2, before including this.
+ *
+ *   Everything here has internal linkage, so the copies compiled
+ * for different instruction sets never get mixed up by the linker.
+ *
+ *   Each kernel runs its widest loop first and finishes the tail
+ * with the narrower ones, the scalar loop is the reference every
+ * other loop has to match.
+ */
+#include "ImageKernelTable.hpp"
+#include <cstring>
+
+#if IMAGE_KERNEL_LEVEL >= 1
+  #include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ *   x / 255 rounded to the nearest integer, exact for every x up to
+ * 255 * 255.
+ */
+inline u32 div255(u32 x) noexcept
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/**
+ * Pixels are only byte aligned.
+ */
+inline int loadPixel(const u8* const p) noexcept
+{
+    int pixel;
+    ::std::memcpy(&pixel, p, sizeof(pixel));
+    return pixel;
+}
+
+inline void storePixel(u8* const p, const int pixel) noexcept
+{ ::std::memcpy(p, &pixel, sizeof(pixel)); }
+
+inline u8 floatToU8(const f32 x) noexcept
+{
+    // Written so that NaN fails the first comparison.
+    const f32 clamped = x > 0.0f ? (x < 1.0f ? x : 1.0f) : 0.0f;
+    return static_cast<u8>(static_cast<u32>(clamped * 255.0f + 0.5f));
+}
+
+#if IMAGE_KERNEL_LEVEL >= 1
+inline __m128i div255(__m128i x) noexcept
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 2
+inline __m256i div255(__m256i x) noexcept
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+#endif
+
+void blend(const u8* const img0, const u8* const img1, u8* const out, const uSys pixelCount, const u32 weight) noexcept
+{
+    const uSys count = pixelCount * 4;
+    const u32 invWeight = 256 - weight;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i w0 = _mm256_set1_epi16(static_cast<short>(invWeight));
+        const __m256i w1 = _mm256_set1_epi16(static_cast<short>(weight));
+        const __m256i round = _mm256_set1_epi16(128);
+
+        for(; i + 32 <= count; i += 32)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img0 + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img1 + i));
+
+            const __m256i lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), w0), _mm256_mullo_epi16(_mm256_unpacklo_epi8(b, zero), w1)), round);
+            const __m256i hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), w0), _mm256_mullo_epi16(_mm256_unpackhi_epi8(b, zero), w1)), round);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8)));
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i w0 = _mm_set1_epi16(static_cast<short>(invWeight));
+        const __m128i w1 = _mm_set1_epi16(static_cast<short>(weight));
+        const __m128i round = _mm_set1_epi16(128);
+
+        for(; i + 16 <= count; i += 16)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img0 + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img1 + i));
+
+            const __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w0), _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w1)), round);
+            const __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w0), _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w1)), round);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+        }
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        out[i] = static_cast<u8>((img0[i] * invWeight + img1[i] * weight + 128) >> 8);
+    }
+}
+
+void average(const u8* const img0, const u8* const img1, u8* const out, const uSys pixelCount) noexcept
+{
+    const uSys count = pixelCount * 4;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    for(; i + 32 <= count; i += 32)
+    {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img0 + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img1 + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_avg_epu8(a, b));
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    for(; i + 16 <= count; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img0 + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img1 + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_avg_epu8(a, b));
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        out[i] = static_cast<u8>((img0[i] + img1[i] + 1) >> 1);
+    }
+}
+
+void multiply(const u8* const img0, const u8* const img1, u8* const out, const uSys pixelCount) noexcept
+{
+    const uSys count = pixelCount * 4;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        for(; i + 32 <= count; i += 32)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img0 + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img1 + i));
+
+            const __m256i lo = div255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero)));
+            const __m256i hi = div255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_packus_epi16(lo, hi));
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128i zero = _mm_setzero_si128();
+        for(; i + 16 <= count; i += 16)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img0 + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img1 + i));
+
+            const __m128i lo = div255(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+            const __m128i hi = div255(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+        }
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        out[i] = static_cast<u8>(div255(static_cast<u32>(img0[i]) * img1[i]));
+    }
+}
+
+void premultiply(const u8* const in, u8* const out, const uSys pixelCount) noexcept
+{
+    const uSys count = pixelCount * 4;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i alphaShuffle = _mm256_setr_epi8(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15, 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+        for(; i + 32 <= count; i += 32)
+        {
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i a = _mm256_shuffle_epi8(c, alphaShuffle);
+
+            const __m256i lo = div255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero), _mm256_unpacklo_epi8(a, zero)));
+            const __m256i hi = div255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero), _mm256_unpackhi_epi8(a, zero)));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_blendv_epi8(_mm256_packus_epi16(lo, hi), c, alphaMask));
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaShuffle = _mm_setr_epi8(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+        for(; i + 16 <= count; i += 16)
+        {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i a = _mm_shuffle_epi8(c, alphaShuffle);
+
+            const __m128i lo = div255(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(a, zero)));
+            const __m128i hi = div255(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(a, zero)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_blendv_epi8(_mm_packus_epi16(lo, hi), c, alphaMask));
+        }
+    }
+#endif
+
+    for(; i < count; i += 4)
+    {
+        const u32 alpha = in[i + 3];
+        out[i + 0] = static_cast<u8>(div255(in[i + 0] * alpha));
+        out[i + 1] = static_cast<u8>(div255(in[i + 1] * alpha));
+        out[i + 2] = static_cast<u8>(div255(in[i + 2] * alpha));
+        out[i + 3] = static_cast<u8>(alpha);
+    }
+}
+
+void swizzle(const u8* const in, u8* const out, const uSys pixelCount, const u8* const order) noexcept
+{
+    const uSys count = pixelCount * 4;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        alignas(16) u8 mask[16];
+        for(u32 j = 0; j < 16; ++j)
+        {
+            mask[j] = static_cast<u8>((j & ~3u) + order[j & 3]);
+        }
+        const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+
+  #if IMAGE_KERNEL_LEVEL >= 2
+        // The shuffle works within each 128 bit half, and pixels never cross one.
+        const __m256i shuffle256 = _mm256_broadcastsi128_si256(shuffle);
+        for(; i + 32 <= count; i += 32)
+        {
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(c, shuffle256));
+        }
+  #endif
+
+        for(; i + 16 <= count; i += 16)
+        {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(c, shuffle));
+        }
+    }
+#endif
+
+    for(; i < count; i += 4)
+    {
+        const u8 pixel[4] = { in[i + 0], in[i + 1], in[i + 2], in[i + 3] };
+        out[i + 0] = pixel[order[0]];
+        out[i + 1] = pixel[order[1]];
+        out[i + 2] = pixel[order[2]];
+        out[i + 3] = pixel[order[3]];
+    }
+}
+
+void toFloat(const u8* const in, f32* const out, const uSys pixelCount) noexcept
+{
+    static constexpr f32 Scale = 1.0f / 255.0f;
+
+    const uSys count = pixelCount * 4;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256 scale = _mm256_set1_ps(Scale);
+        for(; i + 16 <= count; i += 16)
+        {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(c)), scale));
+            _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(c, 8))), scale));
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128 scale = _mm_set1_ps(Scale);
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128i c = _mm_cvtsi32_si128(loadPixel(in + i));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(c)), scale));
+        }
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        out[i] = static_cast<f32>(in[i]) * Scale;
+    }
+}
+
+void fromFloat(const f32* const in, u8* const out, const uSys pixelCount) noexcept
+{
+    const uSys count = pixelCount * 4;
+    uSys i = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        // Undoes the interleaving of the 128 bit halves by the packs.
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        const auto convert = [&](const f32* const src)
+        {
+            // max returns its second operand for NaN.
+            const __m256 clamped = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src), zero), one);
+            return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(clamped, scale), half));
+        };
+
+        for(; i + 32 <= count; i += 32)
+        {
+            const __m256i ab = _mm256_packus_epi32(convert(in + i), convert(in + i + 8));
+            const __m256i cd = _mm256_packus_epi32(convert(in + i + 16), convert(in + i + 24));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), order));
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), zero), one);
+            const __m128i c = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+            const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(c, c), _mm_setzero_si128());
+            storePixel(out + i, _mm_cvtsi128_si32(packed));
+        }
+    }
+#endif
+
+    for(; i < count; ++i)
+    {
+        out[i] = floatToU8(in[i]);
+    }
+}
+
+void resizeRow(const u8* const row0, const u8* const row1, const f32 fy, const u32* const x0, const u32* const x1, const f32* const fx, u8* const out, const u32 outWidth) noexcept
+{
+    u32 x = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    const auto load = [](const u8* const row, const u32 pixel)
+    {
+        return _mm_cvtsi32_si128(loadPixel(row + pixel * 4));
+    };
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256 wy = _mm256_set1_ps(fy);
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        // Two output pixels at a time, one in each 128 bit half.
+        const auto loadPair = [&](const u8* const row, const u32* const columns)
+        {
+            return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpacklo_epi32(load(row, columns[x]), load(row, columns[x + 1]))));
+        };
+
+        for(; x + 2 <= outWidth; x += 2)
+        {
+            const __m256 wx = _mm256_setr_m128(_mm_set1_ps(fx[x]), _mm_set1_ps(fx[x + 1]));
+
+            const __m256 a0 = loadPair(row0, x0);
+            const __m256 b0 = loadPair(row0, x1);
+            const __m256 a1 = loadPair(row1, x0);
+            const __m256 b1 = loadPair(row1, x1);
+
+            const __m256 top = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_sub_ps(b0, a0), wx));
+            const __m256 bottom = _mm256_add_ps(a1, _mm256_mul_ps(_mm256_sub_ps(b1, a1), wx));
+            const __m256 value = _mm256_add_ps(top, _mm256_mul_ps(_mm256_sub_ps(bottom, top), wy));
+
+            const __m256i c = _mm256_cvttps_epi32(_mm256_add_ps(value, half));
+            const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(c, c), c);
+
+            storePixel(out + x * 4, _mm_cvtsi128_si32(_mm256_castsi256_si128(packed)));
+            storePixel(out + x * 4 + 4, _mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1)));
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128 wy = _mm_set1_ps(fy);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        for(; x < outWidth; ++x)
+        {
+            const __m128 wx = _mm_set1_ps(fx[x]);
+
+            const __m128 a0 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(load(row0, x0[x])));
+            const __m128 b0 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(load(row0, x1[x])));
+            const __m128 a1 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(load(row1, x0[x])));
+            const __m128 b1 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(load(row1, x1[x])));
+
+            const __m128 top = _mm_add_ps(a0, _mm_mul_ps(_mm_sub_ps(b0, a0), wx));
+            const __m128 bottom = _mm_add_ps(a1, _mm_mul_ps(_mm_sub_ps(b1, a1), wx));
+            const __m128 value = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), wy));
+
+            const __m128i c = _mm_cvttps_epi32(_mm_add_ps(value, half));
+            storePixel(out + x * 4, _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packus_epi32(c, c), c)));
+        }
+    }
+#endif
+
+    for(; x < outWidth; ++x)
+    {
+        for(u32 c = 0; c < 4; ++c)
+        {
+            const f32 a0 = row0[x0[x] * 4 + c];
+            const f32 b0 = row0[x1[x] * 4 + c];
+            const f32 a1 = row1[x0[x] * 4 + c];
+            const f32 b1 = row1[x1[x] * 4 + c];
+
+            const f32 top = a0 + (b0 - a0) * fx[x];
+            const f32 bottom = a1 + (b1 - a1) * fx[x];
+            const f32 value = top + (bottom - top) * fy;
+
+            out[x * 4 + c] = static_cast<u8>(static_cast<u32>(value + 0.5f));
+        }
+    }
+}
+
+/**
+ *   The same mapping and escape test as the original renderer,
+ * without going through std::complex. Counts iterations until
+ * |z| >= 2, up to iters + 1 of them.
+ */
+inline u32 mandelbrotIterations(const f32 cx, const f32 cy, const u32 iters) noexcept
+{
+    f32 zr = 0.0f;
+    f32 zi = 0.0f;
+    u32 n = 0;
+    for(; n <= iters; ++n)
+    {
+        const f32 zr2 = zr * zr;
+        const f32 zi2 = zi * zi;
+        if(!(zr2 + zi2 < 4.0f))
+        {
+            break;
+        }
+
+        const f32 zrzi = zr * zi;
+        zi = (zrzi + zrzi) + cy;
+        zr = (zr2 - zi2) + cx;
+    }
+    return n;
+}
+
+inline u32 mandelbrotPixel(const u32 n, const u32 iters) noexcept
+{
+    const u32 red = n < iters ? (255 * n) / (iters - 1) : 0;
+    return 0xFF000000 | (red << 16);
+}
+
+inline f32 mandelbrotX(const f32 x, const f32 width) noexcept
+{ return ((x / width) - 0.75f) * 2.25f; }
+
+inline f32 mandelbrotY(const f32 y, const f32 height) noexcept
+{ return ((y / height) - 0.5f) * 2.25f; }
+
+void mandelbrotRow(u8* const out, const u32 width, const u32 height, const u32 y, const u32 iters) noexcept
+{
+    u32* const pixels = reinterpret_cast<u32*>(out);
+    const f32 fWidth = static_cast<f32>(width);
+    const f32 cy = mandelbrotY(static_cast<f32>(y), static_cast<f32>(height));
+    u32 x = 0;
+
+#if IMAGE_KERNEL_LEVEL >= 2
+    {
+        const __m256 four = _mm256_set1_ps(4.0f);
+        const __m256 vWidth = _mm256_set1_ps(fWidth);
+        const __m256 vCy = _mm256_set1_ps(cy);
+        const __m256 offset = _mm256_set1_ps(0.75f);
+        const __m256 scale = _mm256_set1_ps(2.25f);
+        const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+        for(; x + 8 <= width; x += 8)
+        {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(static_cast<f32>(x)), lanes);
+            const __m256 cx = _mm256_mul_ps(_mm256_sub_ps(_mm256_div_ps(px, vWidth), offset), scale);
+
+            __m256 zr = _mm256_setzero_ps();
+            __m256 zi = _mm256_setzero_ps();
+            __m256i count = _mm256_setzero_si256();
+            __m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            // Lanes that escaped keep iterating, but stop counting.
+            for(u32 n = 0; n <= iters; ++n)
+            {
+                const __m256 zr2 = _mm256_mul_ps(zr, zr);
+                const __m256 zi2 = _mm256_mul_ps(zi, zi);
+                active = _mm256_and_ps(active, _mm256_cmp_ps(_mm256_add_ps(zr2, zi2), four, _CMP_LT_OQ));
+                if(!_mm256_movemask_ps(active))
+                {
+                    break;
+                }
+
+                count = _mm256_sub_epi32(count, _mm256_castps_si256(active));
+
+                const __m256 zrzi = _mm256_mul_ps(zr, zi);
+                zi = _mm256_add_ps(_mm256_add_ps(zrzi, zrzi), vCy);
+                zr = _mm256_add_ps(_mm256_sub_ps(zr2, zi2), cx);
+            }
+
+            alignas(32) u32 counts[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(counts), count);
+            for(u32 i = 0; i < 8; ++i)
+            {
+                pixels[x + i] = mandelbrotPixel(counts[i], iters);
+            }
+        }
+    }
+#endif
+
+#if IMAGE_KERNEL_LEVEL >= 1
+    {
+        const __m128 four = _mm_set1_ps(4.0f);
+        const __m128 vWidth = _mm_set1_ps(fWidth);
+        const __m128 vCy = _mm_set1_ps(cy);
+        const __m128 offset = _mm_set1_ps(0.75f);
+        const __m128 scale = _mm_set1_ps(2.25f);
+        const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+        for(; x + 4 <= width; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<f32>(x)), lanes);
+            const __m128 cx = _mm_mul_ps(_mm_sub_ps(_mm_div_ps(px, vWidth), offset), scale);
+
+            __m128 zr = _mm_setzero_ps();
+            __m128 zi = _mm_setzero_ps();
+            __m128i count = _mm_setzero_si128();
+            __m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for(u32 n = 0; n <= iters; ++n)
+            {
+                const __m128 zr2 = _mm_mul_ps(zr, zr);
+                const __m128 zi2 = _mm_mul_ps(zi, zi);
+                active = _mm_and_ps(active, _mm_cmplt_ps(_mm_add_ps(zr2, zi2), four));
+                if(!_mm_movemask_ps(active))
+                {
+                    break;
+                }
+
+                count = _mm_sub_epi32(count, _mm_castps_si128(active));
+
+                const __m128 zrzi = _mm_mul_ps(zr, zi);
+                zi = _mm_add_ps(_mm_add_ps(zrzi, zrzi), vCy);
+                zr = _mm_add_ps(_mm_sub_ps(zr2, zi2), cx);
+            }
+
+            alignas(16) u32 counts[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(counts), count);
+            for(u32 i = 0; i < 4; ++i)
+            {
+                pixels[x + i] = mandelbrotPixel(counts[i], iters);
+            }
+        }
+    }
+#endif
+
+    for(; x < width; ++x)
+    {
+        pixels[x] = mandelbrotPixel(mandelbrotIterations(mandelbrotX(static_cast<f32>(x), fWidth), cy, iters), iters);
+    }
+}
+
+}
+
+extern const ImageKernelTable IMAGE_KERNEL_TABLE = {
+    blend,
+    average,
+    multiply,
+    premultiply,
+    swizzle,
+    toFloat,
+    fromFloat,
+    resizeRow,
+    mandelbrotRow
+};
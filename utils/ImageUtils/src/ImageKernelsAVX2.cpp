@@ -0,0 +1,7 @@
+/**
+ *   This file is compiled with AVX2 enabled, it is only called
+ * once the processor has been checked for support.
+ */
+#define IMAGE_KERNEL_LEVEL 2
+#define IMAGE_KERNEL_TABLE imageKernelsAVX2
+#include "ImageKernels.inl"
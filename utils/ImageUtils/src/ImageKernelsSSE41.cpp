@@ -0,0 +1,3 @@
+#define IMAGE_KERNEL_LEVEL 1
+#define IMAGE_KERNEL_TABLE imageKernelsSSE41
+#include "ImageKernels.inl"
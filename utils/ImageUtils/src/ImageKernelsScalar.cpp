@@ -0,0 +1,3 @@
+#define IMAGE_KERNEL_LEVEL 0
+#define IMAGE_KERNEL_TABLE imageKernelsScalar
+#include "ImageKernels.inl"
@@ -2,7 +2,9 @@
 #include <TextureLoader.h>
 #include <TextureBlend.hpp>
 #include "Mandelbrot.hpp"
+#include <ImageBenchmark.hpp>
 #include <cstdio>
+#include <cstring>
 #include <string>
 
 int main0(u32 argCount, char* args[])
@@ -171,7 +173,14 @@ int main(int argCount, char* args[])
     int ret = -1;
     try
     {
-        ret = main3(argCount, args);
+        if(argCount > 1 && strcmp(args[1], "bench") == 0)
+        {
+            ret = imageBenchmark();
+        }
+        else
+        {
+            ret = main3(argCount, args);
+        }
     }
     catch(...)
     {
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <typeinfo>
-
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 class AbstractNode;
 
@@ -12,9 +14,14 @@ protected:
     const char* _name;
     AbstractNode& _holder;
     const type_info& _type;
+    /**
+     * The size and alignment of the value, used to lay it out in a compiled plan.
+     */
+    std::uint32_t _size;
+    std::uint32_t _alignment;
 protected:
-    AbstractConnection(const char* name, AbstractNode& holder, const type_info& type) noexcept
-        : _name(name), _holder(holder), _type(type)
+    AbstractConnection(const char* name, AbstractNode& holder, const type_info& type, std::uint32_t size, std::uint32_t alignment) noexcept
+        : _name(name), _holder(holder), _type(type), _size(size), _alignment(alignment)
     { }
 public:
     const char* name() const noexcept { return _name; }
@@ -22,6 +29,8 @@ public:
     AbstractNode& node() const noexcept { return _holder; }
     //AbstractNode&& node() noexcept { return _holder; }
     const type_info& type() const noexcept { return _type; }
+    std::uint32_t size() const noexcept { return _size; }
+    std::uint32_t alignment() const noexcept { return _alignment; }
 };
 
 class ConnectionPointOut;
@@ -33,52 +42,53 @@ protected:
     ConnectionPointOut* _connection;
     friend ConnectionPointOut;
 protected:
-    ConnectionPointIn(const char* name, AbstractNode& holder, const type_info& type, bool required, ConnectionPointOut* connection) noexcept
-        : AbstractConnection(name, holder, type), _required(required), _connection(connection)
-    { }
-
-    ConnectionPointIn(const char* name, AbstractNode& holder, const type_info& type, bool required) noexcept
-        : AbstractConnection(name, holder, type), _required(required), _connection(nullptr)
+    ConnectionPointIn(const char* name, AbstractNode& holder, const type_info& type, std::uint32_t size, std::uint32_t alignment, bool required) noexcept
+        : AbstractConnection(name, holder, type, size, alignment), _required(required), _connection(nullptr)
     { }
 public:
+    virtual ~ConnectionPointIn() noexcept = default;
+
+    /**
+     * Replaces any existing connection.
+     */
     virtual void connect(ConnectionPointOut* connection) noexcept;
 
     bool required() const noexcept { return _required; }
 
     ConnectionPointOut* connection() const noexcept { return _connection; }
-    ConnectionPointOut*& connection() noexcept { return _connection; }
 };
 
+/**
+ *   An output can feed any number of inputs, all of which share
+ * the output's value.
+ */
 class ConnectionPointOut : public AbstractConnection
 {
 protected:
-    ConnectionPointIn* _connection;
+    std::vector<ConnectionPointIn*> _connections;
     friend ConnectionPointIn;
 protected:
-    ConnectionPointOut(const char* name, AbstractNode& holder, const type_info& type, ConnectionPointIn* connection) noexcept
-        : AbstractConnection(name, holder, type), _connection(connection)
-    { }
-
-    ConnectionPointOut(const char* name, AbstractNode& holder, const type_info& type) noexcept
-        : AbstractConnection(name, holder, type), _connection(nullptr)
+    ConnectionPointOut(const char* name, AbstractNode& holder, const type_info& type, std::uint32_t size, std::uint32_t alignment) noexcept
+        : AbstractConnection(name, holder, type, size, alignment), _connections()
     { }
 public:
-    virtual void connect(ConnectionPointIn* connection) noexcept;
+    virtual ~ConnectionPointOut() noexcept = default;
+
+    void connect(ConnectionPointIn* connection) noexcept { connection->connect(this); }
 
-    ConnectionPointIn* connection() const noexcept { return _connection; }
-    ConnectionPointIn*& connection() noexcept { return _connection; }
+    const std::vector<ConnectionPointIn*>& connections() const noexcept { return _connections; }
 };
 
 inline void ConnectionPointIn::connect(ConnectionPointOut* connection) noexcept
 {
-    _connection = connection;
-    connection->_connection = this;
-}
+    if(_connection)
+    {
+        std::vector<ConnectionPointIn*>& previous = _connection->_connections;
+        previous.erase(std::remove(previous.begin(), previous.end(), this), previous.end());
+    }
 
-inline void ConnectionPointOut::connect(ConnectionPointIn* connection) noexcept
-{
     _connection = connection;
-    connection->_connection = this;
+    connection->_connections.push_back(this);
 }
 
 template<typename _T>
@@ -88,64 +98,48 @@ template<typename _T>
 class ConnectionInValueHolder final : public ConnectionPointIn
 {
 private:
-    std::shared_ptr<std::shared_ptr<_T>> _value;
-    friend ConnectionOutValueHolder<_T>;
+    /**
+     *   The cell holding the value. Once connected this is the
+     * output's cell, so the value computed by the output is seen
+     * without being copied.
+     */
+    std::shared_ptr<_T> _value;
 public:
-    // ConnectionInValueHolder(const char* name, AbstractNode& holder, bool required, _T* value) noexcept
-    //     : ConnectionPointIn(name, holder, typeid(_T), required), _value(value)
-    // { }
-
     ConnectionInValueHolder(const char* name, AbstractNode& holder, bool required, _T value) noexcept
-        : ConnectionPointIn(name, holder, typeid(_T), required), _value(new _T*(new _T(value)))
-    {}
+        : ConnectionPointIn(name, holder, typeid(_T), sizeof(_T), alignof(_T), required), _value(std::make_shared<_T>(value))
+    { }
 
     ConnectionInValueHolder(const char* name, AbstractNode& holder, bool required) noexcept
-        : ConnectionPointIn(name, holder, typeid(_T), required), _value(new _T*(new _T(nullptr)))
+        : ConnectionPointIn(name, holder, typeid(_T), sizeof(_T), alignof(_T), required), _value(std::make_shared<_T>())
     { }
 
     void connect(ConnectionPointOut* connection) noexcept override;
 
-    _T* value() const noexcept { return _value; }
-    _T*& value() noexcept { return _value; }
+    _T* value() const noexcept { return _value.get(); }
 };
 
 template<typename _T>
 class ConnectionOutValueHolder final : public ConnectionPointOut
 {
 private:
-    std::shared_ptr<std::shared_ptr<_T>> _value;
+    std::shared_ptr<_T> _value;
     friend ConnectionInValueHolder<_T>;
 public:
-    // ConnectionOutValueHolder(const char* name, AbstractNode& holder, _T* value) noexcept
-    //     : ConnectionPointOut(name, holder, typeid(_T)), _value(value)
-    // { }
-
     ConnectionOutValueHolder(const char* name, AbstractNode& holder, _T value) noexcept
-        : ConnectionPointOut(name, holder, typeid(_T)), _value(new _T*(new _T(value)))
+        : ConnectionPointOut(name, holder, typeid(_T), sizeof(_T), alignof(_T)), _value(std::make_shared<_T>(value))
     { }
 
     ConnectionOutValueHolder(const char* name, AbstractNode& holder) noexcept
-        : ConnectionPointOut(name, holder, typeid(_T)), _value(new _T*(nullptr))
+        : ConnectionPointOut(name, holder, typeid(_T), sizeof(_T), alignof(_T)), _value(std::make_shared<_T>())
     { }
 
-    void connect(ConnectionPointIn* connection) noexcept override;
-
-    _T* value() const noexcept { return _value; }
-    _T*& value() noexcept { return _value; }
+    _T* value() const noexcept { return _value.get(); }
 };
 
 template <typename _T>
-void ConnectionInValueHolder<_T>::connect(ConnectionPointOut* connection) noexcept 
-{ 
+void ConnectionInValueHolder<_T>::connect(ConnectionPointOut* connection) noexcept
+{
     ConnectionPointIn::connect(connection);
 
     _value = static_cast<ConnectionOutValueHolder<_T>*>(connection)->_value;
 }
-
-template <typename _T>
-void ConnectionOutValueHolder<_T>::connect(ConnectionPointIn* connection) noexcept 
-{
-    ConnectionPointOut::connect(connection);
-
-    static_cast<ConnectionOutValueHolder<_T>*>(connection)->_value = _value;
-}
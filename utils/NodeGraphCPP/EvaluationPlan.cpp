@@ -0,0 +1,622 @@
+#include "EvaluationPlan.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+/**
+ *   Slots never need more than a cache line of alignment, and
+ * giving each batch slot a whole line keeps the lanes of different
+ * slots from sharing one.
+ */
+static constexpr std::uint32_t MaxSlotAlignment = 64;
+
+/**
+ *   The number of consecutive steps a worker takes at a time.
+ * Outputs are laid out in step order, so neighbouring steps mostly
+ * write to the same cache lines and should stay on one thread.
+ */
+static constexpr std::uint32_t ChunkSize = 64;
+
+static std::uint32_t alignTo(const std::uint32_t value, const std::uint32_t alignment) noexcept
+{
+    return (value + (alignment - 1)) & ~(alignment - 1);
+}
+
+static unsigned char* alignPointer(unsigned char* const ptr) noexcept
+{
+    const std::uintptr_t misalignment = reinterpret_cast<std::uintptr_t>(ptr) & (MaxSlotAlignment - 1);
+    return misalignment == 0 ? ptr : ptr + (MaxSlotAlignment - misalignment);
+}
+
+/**
+ *   A fixed set of threads that help evaluate a single level at a
+ * time. The calling thread takes part as well and returns once the
+ * whole level is done.
+ */
+struct EvaluationPlan::Workers final
+{
+    EvaluationPlan* plan;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::uint64_t generation;
+    std::uint32_t running;
+    bool stop;
+
+    std::uint32_t end;
+    std::atomic<std::uint32_t> next;
+
+    Workers(EvaluationPlan* const owner, const std::uint32_t threadCount) noexcept
+        : plan(owner), threads(), mutex(), wake(), done(), generation(0), running(0), stop(false), end(0), next(0)
+    {
+        threads.reserve(threadCount);
+        for(std::uint32_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~Workers() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void run(const std::uint32_t begin, const std::uint32_t last) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            end = last;
+            next.store(begin, std::memory_order_relaxed);
+            running = static_cast<std::uint32_t>(threads.size());
+            ++generation;
+        }
+        wake.notify_all();
+
+        drain();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return running == 0; });
+    }
+
+    void drain() noexcept
+    {
+        for(;;)
+        {
+            const std::uint32_t begin = next.fetch_add(ChunkSize, std::memory_order_relaxed);
+            if(begin >= end)
+            {
+                return;
+            }
+
+            plan->evaluateSteps(begin, std::min(begin + ChunkSize, end));
+        }
+    }
+
+    void work() noexcept
+    {
+        std::uint64_t seen = 0;
+        for(;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this, seen]() { return stop || generation != seen; });
+                if(stop)
+                {
+                    return;
+                }
+                seen = generation;
+            }
+
+            drain();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--running == 0)
+            {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+EvaluationPlan::EvaluationPlan() noexcept
+    : _steps(), _levels(), _producers(),
+    _inputSlots(), _outputSlots(), _slotOffsets(), _slotSizes(), _portSlots(), _nodeSteps(),
+    _arena(), _arenaBase(nullptr), _inputs(), _outputs(),
+    _batchArena(), _batchArenaBase(nullptr), _batchInputs(), _batchOutputs(), _batchSlotOffsets(), _batchSkip(), _batchFeeds(),
+    _dirty(), _changed(), _workers(), _failedNode(nullptr)
+{ }
+
+EvaluationPlan::~EvaluationPlan() noexcept = default;
+
+void EvaluationPlan::clear() noexcept
+{
+    _steps.clear();
+    _levels.clear();
+    _producers.clear();
+    _inputSlots.clear();
+    _outputSlots.clear();
+    _slotOffsets.clear();
+    _slotSizes.clear();
+    _portSlots.clear();
+    _nodeSteps.clear();
+    _arena.reset();
+    _arenaBase = nullptr;
+    _inputs.clear();
+    _outputs.clear();
+    _batchArena.reset();
+    _batchArenaBase = nullptr;
+    _batchInputs.clear();
+    _batchOutputs.clear();
+    _batchSlotOffsets.clear();
+    _dirty.clear();
+    _changed.clear();
+    _failedNode = nullptr;
+}
+
+NodeValidationCode EvaluationPlan::compile(AbstractNode* const* const roots, const std::uint32_t rootCount) noexcept
+{
+    clear();
+
+    if(roots == nullptr && rootCount > 0)
+    {
+        return NodeValidationCode::NullConnectionPoint;
+    }
+
+    // Gather everything the roots depend on.
+    std::vector<AbstractNode*> nodes;
+    std::unordered_map<const AbstractNode*, std::uint32_t> indices;
+    std::vector<AbstractNode*> stack;
+
+    for(std::uint32_t i = 0; i < rootCount; ++i)
+    {
+        if(roots[i] == nullptr)
+        {
+            return NodeValidationCode::NullConnectionPoint;
+        }
+
+        if(indices.emplace(roots[i], static_cast<std::uint32_t>(nodes.size())).second)
+        {
+            nodes.push_back(roots[i]);
+            stack.push_back(roots[i]);
+        }
+    }
+
+    while(!stack.empty())
+    {
+        AbstractNode* node = stack.back();
+        stack.pop_back();
+
+        const std::uint32_t inputCount = node->inputCount();
+        for(std::uint32_t i = 0; i < inputCount; ++i)
+        {
+            const ConnectionPointIn* input = node->input(i);
+            if(input == nullptr || input->connection() == nullptr)
+            {
+                continue;
+            }
+
+            AbstractNode* producer = &input->connection()->node();
+            if(indices.emplace(producer, static_cast<std::uint32_t>(nodes.size())).second)
+            {
+                nodes.push_back(producer);
+                stack.push_back(producer);
+            }
+        }
+    }
+
+    // Validate each node once, and collect the distinct producers of each.
+    const std::uint32_t nodeCount = static_cast<std::uint32_t>(nodes.size());
+    std::vector<std::vector<std::uint32_t>> producers(nodeCount);
+    std::vector<std::vector<std::uint32_t>> consumers(nodeCount);
+    std::uint32_t maxSize = 1;
+
+    for(std::uint32_t n = 0; n < nodeCount; ++n)
+    {
+        AbstractNode* node = nodes[n];
+
+        const NodeValidationCode code = node->validateConnections();
+        if(code != NodeValidationCode::Success)
+        {
+            _failedNode = node;
+            return code;
+        }
+
+        const std::uint32_t inputCount = node->inputCount();
+        const std::uint32_t outputCount = node->outputCount();
+        if(inputCount > AbstractNode::MaxConnectionPoints || outputCount > AbstractNode::MaxConnectionPoints)
+        {
+            _failedNode = node;
+            return NodeValidationCode::TooManyConnectionPoints;
+        }
+
+        for(std::uint32_t i = 0; i < outputCount; ++i)
+        {
+            const ConnectionPointOut* output = node->output(i);
+            if(output == nullptr)
+            {
+                _failedNode = node;
+                return NodeValidationCode::NullConnectionPoint;
+            }
+            maxSize = std::max(maxSize, output->size());
+        }
+
+        for(std::uint32_t i = 0; i < inputCount; ++i)
+        {
+            const ConnectionPointIn* input = node->input(i);
+            if(input == nullptr)
+            {
+                _failedNode = node;
+                return NodeValidationCode::NullConnectionPoint;
+            }
+
+            maxSize = std::max(maxSize, input->size());
+
+            if(input->connection() == nullptr)
+            {
+                if(input->required())
+                {
+                    _failedNode = node;
+                    return NodeValidationCode::RequiredConnectionsNotFulfilled;
+                }
+                continue;
+            }
+
+            if(input->connection()->type() != input->type())
+            {
+                _failedNode = node;
+                return NodeValidationCode::InvalidSource;
+            }
+
+            const std::uint32_t producer = indices[&input->connection()->node()];
+            if(std::find(producers[n].begin(), producers[n].end(), producer) == producers[n].end())
+            {
+                producers[n].push_back(producer);
+                consumers[producer].push_back(n);
+            }
+        }
+    }
+
+    // Kahn's algorithm, tracking the longest path to each node as its level.
+    std::vector<std::uint32_t> pending(nodeCount);
+    std::vector<std::uint32_t> levels(nodeCount, 0);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(nodeCount);
+
+    for(std::uint32_t n = 0; n < nodeCount; ++n)
+    {
+        pending[n] = static_cast<std::uint32_t>(producers[n].size());
+        if(pending[n] == 0)
+        {
+            queue.push_back(n);
+        }
+    }
+
+    std::uint32_t levelCount = 0;
+    for(std::uint32_t head = 0; head < queue.size(); ++head)
+    {
+        const std::uint32_t n = queue[head];
+        levelCount = std::max(levelCount, levels[n] + 1);
+
+        for(const std::uint32_t consumer : consumers[n])
+        {
+            levels[consumer] = std::max(levels[consumer], levels[n] + 1);
+            if(--pending[consumer] == 0)
+            {
+                queue.push_back(consumer);
+            }
+        }
+    }
+
+    if(queue.size() != nodeCount)
+    {
+        for(std::uint32_t n = 0; n < nodeCount; ++n)
+        {
+            if(pending[n] != 0)
+            {
+                _failedNode = nodes[n];
+                break;
+            }
+        }
+        return NodeValidationCode::RecursiveConnection;
+    }
+
+    // Order the steps by level.
+    _levels.assign(levelCount + 1, 0);
+    for(std::uint32_t n = 0; n < nodeCount; ++n)
+    {
+        ++_levels[levels[n] + 1];
+    }
+    for(std::uint32_t l = 0; l < levelCount; ++l)
+    {
+        _levels[l + 1] += _levels[l];
+    }
+
+    std::vector<std::uint32_t> order(nodeCount);
+    std::vector<std::uint32_t> stepOf(nodeCount);
+    {
+        std::vector<std::uint32_t> cursors(_levels.begin(), _levels.end() - 1);
+        for(std::uint32_t n = 0; n < nodeCount; ++n)
+        {
+            const std::uint32_t step = cursors[levels[n]]++;
+            order[step] = n;
+            stepOf[n] = step;
+        }
+    }
+
+    // Lay out the slots, slot 0 is the shared zero slot.
+    _slotOffsets.push_back(0);
+    _slotSizes.push_back(maxSize);
+    std::uint32_t arenaSize = alignTo(maxSize, MaxSlotAlignment);
+
+    _steps.reserve(nodeCount);
+    for(std::uint32_t s = 0; s < nodeCount; ++s)
+    {
+        const std::uint32_t n = order[s];
+        AbstractNode* node = nodes[n];
+
+        Step step;
+        step.node = node;
+        step.firstInput = static_cast<std::uint32_t>(_inputSlots.size());
+        step.firstOutput = static_cast<std::uint32_t>(_outputSlots.size());
+        step.firstProducer = static_cast<std::uint32_t>(_producers.size());
+        step.producerCount = static_cast<std::uint32_t>(producers[n].size());
+
+        for(const std::uint32_t producer : producers[n])
+        {
+            _producers.push_back(stepOf[producer]);
+        }
+
+        // Producers are always in an earlier level, so their slots already exist.
+        const std::uint32_t inputCount = node->inputCount();
+        for(std::uint32_t i = 0; i < inputCount; ++i)
+        {
+            const ConnectionPointOut* connection = node->input(i)->connection();
+            _inputSlots.push_back(connection == nullptr ? 0 : _portSlots[connection]);
+        }
+
+        const std::uint32_t outputCount = node->outputCount();
+        for(std::uint32_t i = 0; i < outputCount; ++i)
+        {
+            const ConnectionPointOut* output = node->output(i);
+            const std::uint32_t slot = static_cast<std::uint32_t>(_slotOffsets.size());
+            const std::uint32_t offset = alignTo(arenaSize, std::min(std::max(output->alignment(), 1u), MaxSlotAlignment));
+
+            _slotOffsets.push_back(offset);
+            _slotSizes.push_back(output->size());
+            _portSlots[output] = slot;
+            _outputSlots.push_back(slot);
+            arenaSize = offset + output->size();
+        }
+
+        _nodeSteps[node] = s;
+        _steps.push_back(step);
+    }
+
+    // Everything is resolved to a pointer once, up front.
+    _arena = std::make_unique<unsigned char[]>(arenaSize + MaxSlotAlignment);
+    _arenaBase = alignPointer(_arena.get());
+
+    _inputs.reserve(_inputSlots.size());
+    for(const std::uint32_t slot : _inputSlots)
+    {
+        _inputs.push_back(_arenaBase + _slotOffsets[slot]);
+    }
+
+    _outputs.reserve(_outputSlots.size());
+    for(const std::uint32_t slot : _outputSlots)
+    {
+        _outputs.push_back(_arenaBase + _slotOffsets[slot]);
+    }
+
+    _dirty.assign(nodeCount, 1);
+    _changed.assign(nodeCount, 0);
+
+    return NodeValidationCode::Success;
+}
+
+void EvaluationPlan::threadCount(const std::uint32_t count) noexcept
+{
+    _workers.reset();
+
+    if(count > 1)
+    {
+        _workers = std::make_unique<Workers>(this, count - 1);
+    }
+}
+
+std::uint32_t EvaluationPlan::threadCount() const noexcept
+{
+    return _workers ? static_cast<std::uint32_t>(_workers->threads.size()) + 1 : 1;
+}
+
+void EvaluationPlan::evaluateSteps(const std::uint32_t begin, const std::uint32_t end) noexcept
+{
+    for(std::uint32_t s = begin; s < end; ++s)
+    {
+        const Step& step = _steps[s];
+
+        std::uint8_t changed = _dirty[s];
+        for(std::uint32_t p = 0; p < step.producerCount && !changed; ++p)
+        {
+            changed = _changed[_producers[step.firstProducer + p]];
+        }
+
+        _changed[s] = changed;
+
+        if(changed)
+        {
+            step.node->evaluate(_inputs.data() + step.firstInput, _outputs.data() + step.firstOutput);
+        }
+    }
+}
+
+void EvaluationPlan::evaluate() noexcept
+{
+    const std::uint32_t levelCount = this->levelCount();
+    for(std::uint32_t l = 0; l < levelCount; ++l)
+    {
+        const std::uint32_t begin = _levels[l];
+        const std::uint32_t end = _levels[l + 1];
+
+        if(_workers && end - begin >= MinParallelSteps)
+        {
+            _workers->run(begin, end);
+        }
+        else
+        {
+            evaluateSteps(begin, end);
+        }
+    }
+
+    std::fill(_dirty.begin(), _dirty.end(), static_cast<std::uint8_t>(0));
+}
+
+void EvaluationPlan::buildBatchArena() noexcept
+{
+    _batchSlotOffsets.resize(_slotOffsets.size());
+
+    std::uint32_t arenaSize = 0;
+    for(std::uint32_t slot = 0; slot < _slotOffsets.size(); ++slot)
+    {
+        _batchSlotOffsets[slot] = arenaSize;
+        arenaSize = alignTo(arenaSize + _slotSizes[slot] * BatchLanes, MaxSlotAlignment);
+    }
+
+    _batchArena = std::make_unique<unsigned char[]>(arenaSize + MaxSlotAlignment);
+    _batchArenaBase = alignPointer(_batchArena.get());
+
+    _batchInputs.reserve(_inputSlots.size());
+    for(const std::uint32_t slot : _inputSlots)
+    {
+        _batchInputs.push_back(_batchArenaBase + _batchSlotOffsets[slot]);
+    }
+
+    _batchOutputs.reserve(_outputSlots.size());
+    for(const std::uint32_t slot : _outputSlots)
+    {
+        _batchOutputs.push_back(_batchArenaBase + _batchSlotOffsets[slot]);
+    }
+}
+
+bool EvaluationPlan::evaluateBatch(const std::uint32_t count, const BatchInput* const inputs, const std::uint32_t inputCount, const BatchOutput* const outputs, const std::uint32_t outputCount) noexcept
+{
+    for(std::uint32_t i = 0; i < outputCount; ++i)
+    {
+        if(_portSlots.find(outputs[i].port) == _portSlots.end())
+        {
+            return false;
+        }
+    }
+
+    _batchFeeds.clear();
+    _batchSkip.assign(_steps.size(), 0);
+
+    for(std::uint32_t i = 0; i < inputCount; ++i)
+    {
+        const auto slot = _portSlots.find(inputs[i].port);
+        if(slot == _portSlots.end())
+        {
+            return false;
+        }
+
+        const std::uint32_t step = _nodeSteps[&inputs[i].port->node()];
+        _batchFeeds.push_back({ step, slot->second, static_cast<const unsigned char*>(inputs[i].values) });
+        ++_batchSkip[step];
+    }
+
+    // A node is only skipped once every one of its outputs is fed.
+    for(const BatchFeed& feed : _batchFeeds)
+    {
+        if(_batchSkip[feed.step] < _steps[feed.step].node->outputCount())
+        {
+            _batchSkip[feed.step] = 0;
+        }
+    }
+
+    std::sort(_batchFeeds.begin(), _batchFeeds.end(), [](const BatchFeed& a, const BatchFeed& b) { return a.step < b.step; });
+
+    if(count == 0 || _steps.empty())
+    {
+        return true;
+    }
+
+    if(!_batchArena)
+    {
+        buildBatchArena();
+    }
+
+    const std::uint32_t stepCount = static_cast<std::uint32_t>(_steps.size());
+    for(std::uint32_t base = 0; base < count; base += BatchLanes)
+    {
+        const std::uint32_t lanes = std::min(BatchLanes, count - base);
+
+        std::uint32_t feed = 0;
+        for(std::uint32_t s = 0; s < stepCount; ++s)
+        {
+            const Step& step = _steps[s];
+
+            if(!_batchSkip[s])
+            {
+                step.node->evaluateBatch(_batchInputs.data() + step.firstInput, _batchOutputs.data() + step.firstOutput, lanes);
+            }
+
+            for(; feed < _batchFeeds.size() && _batchFeeds[feed].step == s; ++feed)
+            {
+                const BatchFeed& batchFeed = _batchFeeds[feed];
+                const std::uint32_t size = _slotSizes[batchFeed.slot];
+                std::memcpy(_batchArenaBase + _batchSlotOffsets[batchFeed.slot], batchFeed.values + static_cast<std::size_t>(base) * size, static_cast<std::size_t>(lanes) * size);
+            }
+        }
+
+        for(std::uint32_t i = 0; i < outputCount; ++i)
+        {
+            const std::uint32_t slot = _portSlots[outputs[i].port];
+            const std::uint32_t size = _slotSizes[slot];
+            std::memcpy(static_cast<unsigned char*>(outputs[i].values) + static_cast<std::size_t>(base) * size, _batchArenaBase + _batchSlotOffsets[slot], static_cast<std::size_t>(lanes) * size);
+        }
+    }
+
+    return true;
+}
+
+bool EvaluationPlan::markDirty(const AbstractNode* const node) noexcept
+{
+    const auto step = _nodeSteps.find(node);
+    if(step == _nodeSteps.end())
+    {
+        return false;
+    }
+
+    _dirty[step->second] = 1;
+    return true;
+}
+
+void EvaluationPlan::markAllDirty() noexcept
+{
+    std::fill(_dirty.begin(), _dirty.end(), static_cast<std::uint8_t>(1));
+}
+
+const void* EvaluationPlan::value(const ConnectionPointOut* const port) const noexcept
+{
+    const auto slot = _portSlots.find(port);
+    if(slot == _portSlots.end())
+    {
+        return nullptr;
+    }
+
+    return _arenaBase + _slotOffsets[slot->second];
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Node.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ *   A graph compiled for repeated evaluation.
+ *
+ *   Compiling validates every node once, sorts them topologically
+ * and gives every output a slot in a single flat arena. Evaluating
+ * then walks the sorted steps and calls AbstractNode::evaluate with
+ * pointers into the arena that were worked out at compile time, so
+ * every node is computed exactly once no matter how many consumers
+ * it has, and nothing is looked up or allocated.
+ *
+ *   Steps are grouped into levels, a step only depends on steps in
+ * earlier levels. Steps within a level are independent and are
+ * spread across worker threads when there are enough of them.
+ *
+ *   Steps are only evaluated when they, or one of their inputs,
+ * are dirty. Everything is dirty after compiling, call markDirty
+ * after changing a node.
+ *
+ *   The plan holds pointers to the nodes and their connection
+ * points. Changing the graph requires compiling it again.
+ */
+class EvaluationPlan final
+{
+public:
+    /**
+     * The number of sets of values evaluated at a time in batch mode.
+     */
+    static constexpr std::uint32_t BatchLanes = 256;
+
+    /**
+     *   Levels with fewer steps than this are evaluated on the
+     * calling thread, waking the workers would cost more.
+     */
+    static constexpr std::uint32_t MinParallelSteps = 256;
+
+    /**
+     *   Feeds a packed array of values into the slot of `port`. The
+     * node owning it isn't evaluated once all of its outputs are fed.
+     */
+    struct BatchInput final
+    {
+        const ConnectionPointOut* port;
+        const void* values;
+    };
+
+    /**
+     * Receives a packed array of the values of `port`.
+     */
+    struct BatchOutput final
+    {
+        const ConnectionPointOut* port;
+        void* values;
+    };
+private:
+    struct Step final
+    {
+        AbstractNode* node;
+        std::uint32_t firstInput;
+        std::uint32_t firstOutput;
+        std::uint32_t firstProducer;
+        std::uint32_t producerCount;
+    };
+
+    /**
+     * A BatchInput resolved to the step producing it.
+     */
+    struct BatchFeed final
+    {
+        std::uint32_t step;
+        std::uint32_t slot;
+        const unsigned char* values;
+    };
+
+    struct Workers;
+
+    std::vector<Step> _steps;
+    /**
+     * The first step of every level, followed by the step count.
+     */
+    std::vector<std::uint32_t> _levels;
+    /**
+     * The steps producing the inputs of each step, without duplicates.
+     */
+    std::vector<std::uint32_t> _producers;
+
+    /**
+     *   The slot of every input and output of every step. Slot 0 is
+     * zeroed and backs unconnected optional inputs.
+     */
+    std::vector<std::uint32_t> _inputSlots;
+    std::vector<std::uint32_t> _outputSlots;
+    std::vector<std::uint32_t> _slotOffsets;
+    std::vector<std::uint32_t> _slotSizes;
+    std::unordered_map<const ConnectionPointOut*, std::uint32_t> _portSlots;
+    std::unordered_map<const AbstractNode*, std::uint32_t> _nodeSteps;
+
+    std::unique_ptr<unsigned char[]> _arena;
+    unsigned char* _arenaBase;
+    std::vector<const void*> _inputs;
+    std::vector<void*> _outputs;
+
+    /**
+     *   The batch arena and pointers are built on the first call to
+     * evaluateBatch, slots hold BatchLanes values.
+     */
+    std::unique_ptr<unsigned char[]> _batchArena;
+    unsigned char* _batchArenaBase;
+    std::vector<const void*> _batchInputs;
+    std::vector<void*> _batchOutputs;
+    std::vector<std::uint32_t> _batchSlotOffsets;
+    std::vector<std::uint8_t> _batchSkip;
+    std::vector<BatchFeed> _batchFeeds;
+
+    std::vector<std::uint8_t> _dirty;
+    std::vector<std::uint8_t> _changed;
+
+    std::unique_ptr<Workers> _workers;
+
+    const AbstractNode* _failedNode;
+public:
+    EvaluationPlan() noexcept;
+    ~EvaluationPlan() noexcept;
+
+    EvaluationPlan(const EvaluationPlan& copy) noexcept = delete;
+    EvaluationPlan(EvaluationPlan&& move) noexcept = delete;
+
+    EvaluationPlan& operator =(const EvaluationPlan& copy) noexcept = delete;
+    EvaluationPlan& operator =(EvaluationPlan&& move) noexcept = delete;
+
+    /**
+     *   Compiles every node `roots` depends on, including the roots.
+     * On failure the plan is left empty and failedNode returns the
+     * node that was rejected.
+     */
+    NodeValidationCode compile(AbstractNode* const* roots, std::uint32_t rootCount) noexcept;
+
+    /**
+     *   Sets the number of threads used by evaluate, including the
+     * calling thread. The workers are kept alive until the plan is
+     * destroyed or this is called again.
+     */
+    void threadCount(std::uint32_t count) noexcept;
+    std::uint32_t threadCount() const noexcept;
+
+    void evaluate() noexcept;
+
+    /**
+     *   Evaluates `count` independent sets of values. Inputs not
+     * covered by `inputs` keep the values their nodes hold. This
+     * doesn't touch the values seen by evaluate or the dirty state.
+     *
+     *   Returns false, without evaluating anything, if one of the
+     * ports isn't part of the plan.
+     */
+    bool evaluateBatch(std::uint32_t count, const BatchInput* inputs, std::uint32_t inputCount, const BatchOutput* outputs, std::uint32_t outputCount) noexcept;
+
+    /**
+     * Returns false if the node isn't part of the plan.
+     */
+    bool markDirty(const AbstractNode* node) noexcept;
+    void markAllDirty() noexcept;
+
+    /**
+     *   The value `port` held after the last evaluate, or null if it
+     * isn't part of the plan.
+     */
+    const void* value(const ConnectionPointOut* port) const noexcept;
+
+    template<typename _T>
+    const _T* value(const ConnectionOutValueHolder<_T>* port) const noexcept
+    {
+        return static_cast<const _T*>(value(static_cast<const ConnectionPointOut*>(port)));
+    }
+
+    std::uint32_t stepCount() const noexcept { return static_cast<std::uint32_t>(_steps.size()); }
+    std::uint32_t levelCount() const noexcept { return _levels.empty() ? 0 : static_cast<std::uint32_t>(_levels.size() - 1); }
+    std::uint32_t arenaSize() const noexcept { return _slotOffsets.empty() ? 0 : _slotOffsets.back() + _slotSizes.back(); }
+
+    const AbstractNode* failedNode() const noexcept { return _failedNode; }
+private:
+    void clear() noexcept;
+
+    void evaluateSteps(std::uint32_t begin, std::uint32_t end) noexcept;
+
+    void buildBatchArena() noexcept;
+};
@@ -0,0 +1,151 @@
+#include "GraphBenchmark.hpp"
+#include "EvaluationPlan.hpp"
+#include "TestGraph.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace GraphBenchmark {
+
+using namespace TestGraph;
+
+template<typename _F>
+static double time(const std::uint32_t repetitions, _F func)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for(std::uint32_t i = 0; i < repetitions; ++i)
+    {
+        func(i);
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(repetitions);
+}
+
+static void report(const char* name, const double micros, const float result)
+{
+    std::printf("%-36s %12.2f %14g\n", name, micros, static_cast<double>(result));
+}
+
+static void treeBenchmark()
+{
+    static constexpr std::uint32_t LeafCount = 5000;
+    static constexpr std::uint32_t Repetitions = 200;
+
+    Graph graph;
+    buildTree(graph, LeafCount);
+
+    AbstractNode* root = graph.root;
+    EvaluationPlan plan;
+    const NodeValidationCode code = plan.compile(&root, 1);
+    if(code != NodeValidationCode::Success)
+    {
+        std::printf("Failed to compile the tree: %d\n", static_cast<int>(code));
+        return;
+    }
+
+    const ConnectionOutValueHolder<float>* rootOut = static_cast<ConnectionOutValueHolder<float>*>(graph.root->output(0));
+
+    std::printf("Tree of %u nodes, %u levels.\n", plan.stepCount(), plan.levelCount());
+    std::printf("%-36s %12s %14s\n", "", "us per run", "result");
+
+    const double recursive = time(Repetitions, [&](std::uint32_t) { graph.root->compute(); });
+    report("Recursive compute", recursive, *rootOut->value());
+
+    const double full = time(Repetitions, [&](std::uint32_t)
+    {
+        plan.markAllDirty();
+        plan.evaluate();
+    });
+    report("Plan, everything dirty", full, *plan.value(rootOut));
+
+    const double single = time(Repetitions, [&](const std::uint32_t i)
+    {
+        FloatNode* leaf = graph.leaves[(i * 7919) % LeafCount];
+        leaf->value(leaf->value() + 1.0f);
+        plan.markDirty(leaf);
+        plan.evaluate();
+    });
+    report("Plan, one leaf dirty", single, *plan.value(rootOut));
+
+    const std::uint32_t threads = std::max(std::thread::hardware_concurrency(), 2u);
+    plan.threadCount(threads);
+    const double parallel = time(Repetitions, [&](std::uint32_t)
+    {
+        plan.markAllDirty();
+        plan.evaluate();
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "Plan, everything dirty, %u threads", threads);
+    report(name, parallel, *plan.value(rootOut));
+    plan.threadCount(1);
+
+    // Every leaf gets a different value in every set.
+    static constexpr std::uint32_t Sets = 1024;
+    std::vector<float> leafValues(static_cast<std::size_t>(LeafCount) * Sets);
+    for(std::size_t i = 0; i < leafValues.size(); ++i)
+    {
+        leafValues[i] = static_cast<float>(i % 23);
+    }
+
+    std::vector<EvaluationPlan::BatchInput> inputs;
+    for(std::uint32_t i = 0; i < LeafCount; ++i)
+    {
+        inputs.push_back({ graph.leaves[i]->output(0), leafValues.data() + static_cast<std::size_t>(i) * Sets });
+    }
+
+    std::vector<float> results(Sets);
+    const EvaluationPlan::BatchOutput output { rootOut, results.data() };
+
+    const double perSet = time(Sets, [&](const std::uint32_t set)
+    {
+        for(std::uint32_t i = 0; i < LeafCount; ++i)
+        {
+            graph.leaves[i]->value(leafValues[static_cast<std::size_t>(i) * Sets + set]);
+            plan.markDirty(graph.leaves[i]);
+        }
+        plan.evaluate();
+    }) * Sets;
+    report("Plan, 1024 sets one at a time", perSet, *plan.value(rootOut));
+
+    const double batch = time(10, [&](std::uint32_t) { plan.evaluateBatch(Sets, inputs.data(), LeafCount, &output, 1); });
+    report("Plan, 1024 sets in a batch", batch, results[Sets - 1]);
+}
+
+static void diamondBenchmark()
+{
+    static constexpr std::uint32_t Depth = 20;
+
+    Graph graph;
+    buildDiamonds(graph, Depth);
+
+    AbstractNode* root = graph.root;
+    EvaluationPlan plan;
+    plan.compile(&root, 1);
+
+    const ConnectionOutValueHolder<float>* rootOut = static_cast<ConnectionOutValueHolder<float>*>(graph.root->output(0));
+
+    std::printf("\nDiamond chain of %u nodes.\n", plan.stepCount());
+    std::printf("%-36s %12s %14s\n", "", "us per run", "result");
+
+    const double recursive = time(5, [&](std::uint32_t) { graph.root->compute(); });
+    report("Recursive compute", recursive, *rootOut->value());
+
+    const double full = time(1000, [&](std::uint32_t)
+    {
+        plan.markAllDirty();
+        plan.evaluate();
+    });
+    report("Plan, everything dirty", full, *plan.value(rootOut));
+}
+
+void run() noexcept
+{
+    treeBenchmark();
+    diamondBenchmark();
+}
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace GraphBenchmark {
+
+/**
+ *   Times recursive computation against compiled plans on large
+ * graphs and prints the results.
+ */
+void run() noexcept;
+
+}
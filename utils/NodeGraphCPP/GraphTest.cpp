@@ -0,0 +1,267 @@
+#include "GraphTest.hpp"
+#include "EvaluationPlan.hpp"
+#include "TestGraph.hpp"
+#include <cstdio>
+
+namespace GraphTest {
+
+using namespace TestGraph;
+
+static int failures = 0;
+
+static void check(const bool condition, const char* const description)
+{
+    if(!condition)
+    {
+        std::printf("FAILED: %s\n", description);
+        ++failures;
+    }
+}
+
+/**
+ *   A single input node that only implements evaluate, so batches
+ * go through the default AbstractNode::evaluateBatch.
+ */
+class NegateNode final : public AbstractNode
+{
+    ConnectionInValueHolder<float> _in;
+    ConnectionOutValueHolder<float> _out;
+public:
+    NegateNode()
+        : AbstractNode("Negate", "Negate"),
+        _in("X", *this, true),
+        _out("Result", *this)
+    { }
+
+    NodeValidationCode validateConnections() const noexcept override
+    {
+        return _in.connection() ? NodeValidationCode::Success : NodeValidationCode::RequiredConnectionsNotFulfilled;
+    }
+
+    ConnectionPointIn* findConnectionIn(const type_info&, const char*) noexcept override { return &_in; }
+    ConnectionPointOut* findConnectionOut(const type_info&, const char*) noexcept override { return &_out; }
+
+    std::uint32_t inputCount() const noexcept override { return 1; }
+    ConnectionPointIn* input(std::uint32_t index) noexcept override { return index == 0 ? &_in : nullptr; }
+
+    std::uint32_t outputCount() const noexcept override { return 1; }
+    ConnectionPointOut* output(std::uint32_t index) noexcept override { return index == 0 ? &_out : nullptr; }
+
+    void compute() noexcept override
+    {
+        _in.connection()->node().compute();
+        *_out.value() = -*_in.value();
+    }
+
+    void evaluate(const void* const* inputs, void* const* outputs) noexcept override
+    {
+        *static_cast<float*>(outputs[0]) = -*static_cast<const float*>(inputs[0]);
+    }
+};
+
+static const float* outputOf(AbstractNode* node)
+{
+    return static_cast<ConnectionOutValueHolder<float>*>(node->output(0))->value();
+}
+
+/**
+ * Recomputes the graph recursively and compares every node with the plan.
+ */
+static bool matchesRecursive(Graph& graph, const EvaluationPlan& plan)
+{
+    graph.root->compute();
+
+    for(AddNode* node : graph.adds)
+    {
+        const float* planned = plan.value(static_cast<ConnectionOutValueHolder<float>*>(node->output(0)));
+        if(!planned || *planned != *outputOf(node))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void changeLeaves(Graph& graph, EvaluationPlan& plan, const std::uint32_t stride, const float delta)
+{
+    for(std::size_t i = 0; i < graph.leaves.size(); i += stride)
+    {
+        graph.leaves[i]->value(graph.leaves[i]->value() + delta);
+        plan.markDirty(graph.leaves[i]);
+    }
+}
+
+static void testTree()
+{
+    Graph graph;
+    buildTree(graph, 1000);
+
+    AbstractNode* root = graph.root;
+    EvaluationPlan plan;
+    check(plan.compile(&root, 1) == NodeValidationCode::Success, "Compiling a tree");
+    check(plan.stepCount() == 1999, "A tree of 1000 leaves has 1999 steps");
+    check(plan.levelCount() == 11, "A tree of 1000 leaves has 11 levels");
+
+    plan.evaluate();
+    check(matchesRecursive(graph, plan), "A tree matches recursive compute");
+
+    changeLeaves(graph, plan, 97, 3.0f);
+    plan.evaluate();
+    check(matchesRecursive(graph, plan), "A tree matches recursive compute after a few leaves changed");
+
+    // Changing values without marking them dirty changes nothing.
+    const float before = *plan.value(static_cast<ConnectionOutValueHolder<float>*>(graph.root->output(0)));
+    graph.leaves[0]->value(graph.leaves[0]->value() + 100.0f);
+    plan.evaluate();
+    check(*plan.value(static_cast<ConnectionOutValueHolder<float>*>(graph.root->output(0))) == before, "Clean steps aren't evaluated again");
+
+    plan.markAllDirty();
+    plan.evaluate();
+    check(matchesRecursive(graph, plan), "A tree matches recursive compute after marking everything dirty");
+}
+
+static void testDiamonds()
+{
+    static constexpr std::uint32_t Depth = 12;
+
+    Graph graph;
+    buildDiamonds(graph, Depth);
+
+    AbstractNode* root = graph.root;
+    EvaluationPlan plan;
+    check(plan.compile(&root, 1) == NodeValidationCode::Success, "Compiling a diamond chain");
+    check(plan.stepCount() == Depth + 1, "Every shared node of a diamond chain is one step");
+
+    plan.evaluate();
+    check(matchesRecursive(graph, plan), "A diamond chain matches recursive compute");
+
+    graph.leaves[0]->value(2.0f);
+    plan.markDirty(graph.leaves[0]);
+    plan.evaluate();
+    check(matchesRecursive(graph, plan), "A diamond chain matches recursive compute after its leaf changed");
+}
+
+/**
+ * Levels wide enough to be split across the workers.
+ */
+static void testParallel()
+{
+    Graph graph;
+    buildTree(graph, EvaluationPlan::MinParallelSteps * 8 + 3);
+
+    AbstractNode* root = graph.root;
+    EvaluationPlan plan;
+    check(plan.compile(&root, 1) == NodeValidationCode::Success, "Compiling a wide tree");
+
+    for(const std::uint32_t threads : { 2u, 4u, 7u })
+    {
+        plan.threadCount(threads);
+        check(plan.threadCount() == threads, "The thread count is kept");
+
+        plan.markAllDirty();
+        plan.evaluate();
+        check(matchesRecursive(graph, plan), "A parallel plan matches recursive compute");
+
+        changeLeaves(graph, plan, 3, 1.0f);
+        plan.evaluate();
+        check(matchesRecursive(graph, plan), "A parallel plan matches recursive compute after some leaves changed");
+    }
+
+    plan.threadCount(1);
+    changeLeaves(graph, plan, 5, -1.0f);
+    plan.evaluate();
+    check(matchesRecursive(graph, plan), "A plan matches recursive compute after going back to one thread");
+}
+
+static void testBatch()
+{
+    static constexpr std::uint32_t LeafCount = 40;
+    // Several full batches and a partial one.
+    static constexpr std::uint32_t Sets = EvaluationPlan::BatchLanes * 2 + 37;
+
+    Graph graph;
+    buildTree(graph, LeafCount);
+
+    NegateNode negate;
+    negate.connect(0, graph.root->output(0));
+
+    AbstractNode* root = &negate;
+    EvaluationPlan plan;
+    check(plan.compile(&root, 1) == NodeValidationCode::Success, "Compiling a tree with a negated root");
+
+    // The first leaf keeps the value its node holds.
+    std::vector<float> leafValues(static_cast<std::size_t>(LeafCount) * Sets);
+    for(std::size_t i = 0; i < leafValues.size(); ++i)
+    {
+        leafValues[i] = static_cast<float>((i * 31) % 101) * 0.25f;
+    }
+
+    std::vector<EvaluationPlan::BatchInput> inputs;
+    for(std::uint32_t i = 1; i < LeafCount; ++i)
+    {
+        inputs.push_back({ graph.leaves[i]->output(0), leafValues.data() + static_cast<std::size_t>(i) * Sets });
+    }
+
+    std::vector<float> sums(Sets);
+    std::vector<float> negated(Sets);
+    const EvaluationPlan::BatchOutput outputs[2] = { { graph.root->output(0), sums.data() }, { negate.output(0), negated.data() } };
+
+    check(plan.evaluateBatch(Sets, inputs.data(), static_cast<std::uint32_t>(inputs.size()), outputs, 2), "Evaluating a batch");
+
+    bool matches = true;
+    for(std::uint32_t set = 0; set < Sets; ++set)
+    {
+        for(std::uint32_t i = 1; i < LeafCount; ++i)
+        {
+            graph.leaves[i]->value(leafValues[static_cast<std::size_t>(i) * Sets + set]);
+        }
+
+        negate.compute();
+        matches = matches && sums[set] == *outputOf(graph.root) && negated[set] == *outputOf(&negate);
+    }
+    check(matches, "Every set of a batch matches recursive compute");
+
+    // A port outside of the plan is rejected.
+    FloatNode stray("Float", "Stray", 1.0f);
+    const EvaluationPlan::BatchInput strayInput { stray.output(0), leafValues.data() };
+    check(!plan.evaluateBatch(Sets, &strayInput, 1, outputs, 2), "A batch input outside of the plan is rejected");
+}
+
+static void testInvalid()
+{
+    FloatNode x("Float", "X", 1.0f);
+    AddNode add("Add", "Add", TestGraph::add);
+    add.connect(0, x.output(0));
+
+    AbstractNode* root = &add;
+    EvaluationPlan plan;
+    check(plan.compile(&root, 1) == NodeValidationCode::RequiredConnectionsNotFulfilled, "A missing input fails to compile");
+    check(plan.failedNode() == &add, "The node missing an input is reported");
+    check(plan.stepCount() == 0, "A failed plan is empty");
+    check(!plan.markDirty(&x), "A failed plan has no nodes");
+}
+
+int run() noexcept
+{
+    failures = 0;
+
+    testTree();
+    testDiamonds();
+    testParallel();
+    testBatch();
+    testInvalid();
+
+    if(failures)
+    {
+        std::printf("%d graph tests failed.\n", failures);
+    }
+    else
+    {
+        std::printf("Graph tests passed.\n");
+    }
+
+    return failures;
+}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace GraphTest {
+
+/**
+ *   Checks compiled plans against recursive computation, memoized,
+ * dirty, parallel and batched, and prints every mismatch.
+ *
+ * @return
+ *      The number of failed checks.
+ */
+int run() noexcept;
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Connection.hpp"
+#include <cstdint>
 #include <cstring>
 
 enum class NodeValidationCode
@@ -12,11 +13,18 @@ enum class NodeValidationCode
     NeitherSourceNorDestination,
     RequiredConnectionsNotFulfilled,
     InvalidDestination,
-    InvalidSource
+    InvalidSource,
+    TooManyConnectionPoints
 };
 
 class AbstractNode
 {
+public:
+    /**
+     *   The most inputs or outputs a node may have, so that the
+     * default batch evaluation can keep its pointers on the stack.
+     */
+    static constexpr std::uint32_t MaxConnectionPoints = 16;
 protected:
     const char* _nodeTypeName;
     const char* _arbitraryName;
@@ -69,13 +77,159 @@ public:
         return true;
     }
 
+    bool connect(std::uint32_t inputIndex, ConnectionPointOut* output) noexcept
+    {
+        if(output == nullptr || inputIndex >= inputCount())
+        {
+            return false;
+        }
+
+        ConnectionPointIn* conn = input(inputIndex);
+
+        if(conn->type() != output->type())
+        {
+            return false;
+        }
+
+        conn->connect(output);
+        return true;
+    }
+
+    const char* nodeTypeName() const noexcept { return _nodeTypeName; }
+    const char* arbitraryName() const noexcept { return _arbitraryName; }
+
     virtual NodeValidationCode validateConnections() const noexcept = 0;
 
     virtual ConnectionPointIn* findConnectionIn(const type_info& type, const char* targetConnectionName) noexcept = 0;
 
     virtual ConnectionPointOut* findConnectionOut(const type_info& type, const char* targetConnectionName) noexcept = 0;
 
+    virtual std::uint32_t inputCount() const noexcept = 0;
+    virtual ConnectionPointIn* input(std::uint32_t index) noexcept = 0;
+
+    virtual std::uint32_t outputCount() const noexcept = 0;
+    virtual ConnectionPointOut* output(std::uint32_t index) noexcept = 0;
+
+    /**
+     *   Recursively computes every input, then this node. Inputs
+     * shared by several consumers are computed once per consumer.
+     */
     virtual void compute() noexcept = 0;
+
+    /**
+     *   Computes this node from values held outside of the node,
+     * this is what an EvaluationPlan calls. There is one pointer
+     * per input and output, in port order.
+     */
+    virtual void evaluate(const void* const* inputs, void* const* outputs) noexcept = 0;
+
+    /**
+     *   Computes `count` independent sets of values. Every input and
+     * output points to a packed array of `count` values.
+     *
+     *   The default calls evaluate once per set, nodes with a cheap
+     * body should override it with a tight loop.
+     */
+    virtual void evaluateBatch(const void* const* inputs, void* const* outputs, std::uint32_t count) noexcept
+    {
+        const std::uint32_t inCount = inputCount();
+        const std::uint32_t outCount = outputCount();
+
+        const void* laneInputs[MaxConnectionPoints];
+        void* laneOutputs[MaxConnectionPoints];
+
+        for(std::uint32_t lane = 0; lane < count; ++lane)
+        {
+            for(std::uint32_t i = 0; i < inCount; ++i)
+            {
+                laneInputs[i] = static_cast<const unsigned char*>(inputs[i]) + static_cast<std::size_t>(lane) * input(i)->size();
+            }
+
+            for(std::uint32_t i = 0; i < outCount; ++i)
+            {
+                laneOutputs[i] = static_cast<unsigned char*>(outputs[i]) + static_cast<std::size_t>(lane) * output(i)->size();
+            }
+
+            evaluate(laneInputs, laneOutputs);
+        }
+    }
+};
+
+/**
+ *   A node with no inputs and a single value, the leaves of a
+ * graph. After changing the value of a node in a compiled plan
+ * call EvaluationPlan::markDirty on it.
+ */
+template<typename _T>
+class ValueNode : public AbstractNode
+{
+protected:
+    ConnectionOutValueHolder<_T> _outValue;
+    _T _value;
+public:
+    ValueNode(const char* nodeTypeName, const char* arbitraryName, _T value = _T())
+        : AbstractNode(nodeTypeName, arbitraryName),
+        _outValue("Value", *this, value),
+        _value(value)
+    { }
+
+    virtual ~ValueNode() noexcept = default;
+
+    ValueNode(const ValueNode& copy) noexcept = delete;
+    ValueNode(ValueNode&& move) noexcept = delete;
+
+    ValueNode& operator =(const ValueNode& copy) noexcept = delete;
+    ValueNode& operator =(ValueNode&& move) noexcept = delete;
+
+    const _T& value() const noexcept { return _value; }
+    void value(const _T& value) noexcept { _value = value; }
+
+    ConnectionOutValueHolder<_T>* out() noexcept { return &_outValue; }
+
+    NodeValidationCode validateConnections() const noexcept override
+    {
+        return NodeValidationCode::Success;
+    }
+
+    ConnectionPointIn* findConnectionIn(const type_info&, const char*) noexcept override
+    {
+        return nullptr;
+    }
+
+    ConnectionPointOut* findConnectionOut(const type_info& type, const char* targetConnectionName) noexcept override
+    {
+        if(type == typeid(_T) && strcmp(targetConnectionName, "Value") == 0)
+        {
+            return &_outValue;
+        }
+
+        return nullptr;
+    }
+
+    std::uint32_t inputCount() const noexcept override { return 0; }
+    ConnectionPointIn* input(std::uint32_t) noexcept override { return nullptr; }
+
+    std::uint32_t outputCount() const noexcept override { return 1; }
+    ConnectionPointOut* output(std::uint32_t index) noexcept override { return index == 0 ? &_outValue : nullptr; }
+
+    void compute() noexcept override
+    {
+        *_outValue.value() = _value;
+    }
+
+    void evaluate(const void* const*, void* const* outputs) noexcept override
+    {
+        *static_cast<_T*>(outputs[0]) = _value;
+    }
+
+    void evaluateBatch(const void* const*, void* const* outputs, std::uint32_t count) noexcept override
+    {
+        _T* out = static_cast<_T*>(outputs[0]);
+        for(std::uint32_t i = 0; i < count; ++i)
+        {
+            out[i] = _value;
+        }
+    }
 };
 
 template<typename _InputX, typename _InputY, typename _Output>
@@ -114,7 +268,7 @@ public:
             return NodeValidationCode::RequiredConnectionsNotFulfilled;
         }
 
-        if(this == &(_outResult.node()))
+        if(&_inX.connection()->node() == this || &_inY.connection()->node() == this)
         {
             return NodeValidationCode::RecursiveConnection;
         }
@@ -147,6 +301,21 @@ public:
         return nullptr;
     }
 
+    std::uint32_t inputCount() const noexcept override { return 2; }
+
+    ConnectionPointIn* input(std::uint32_t index) noexcept override
+    {
+        switch(index)
+        {
+            case 0: return &_inX;
+            case 1: return &_inY;
+            default: return nullptr;
+        }
+    }
+
+    std::uint32_t outputCount() const noexcept override { return 1; }
+    ConnectionPointOut* output(std::uint32_t index) noexcept override { return index == 0 ? &_outResult : nullptr; }
+
     void compute() noexcept override
     {
         if(_inX.connection() == nullptr || _inY.connection() == nullptr)
@@ -158,9 +327,23 @@ public:
         _inY.connection()->node().compute();
 
         *_outResult.value() = _func(*_inX.value(), *_inY.value());
-        if(_outResult.connection() != nullptr)
+    }
+
+    void evaluate(const void* const* inputs, void* const* outputs) noexcept override
+    {
+        *static_cast<_Output*>(outputs[0]) = _func(*static_cast<const _InputX*>(inputs[0]), *static_cast<const _InputY*>(inputs[1]));
+    }
+
+    void evaluateBatch(const void* const* inputs, void* const* outputs, std::uint32_t count) noexcept override
+    {
+        const _InputX* x = static_cast<const _InputX*>(inputs[0]);
+        const _InputY* y = static_cast<const _InputY*>(inputs[1]);
+        _Output* out = static_cast<_Output*>(outputs[0]);
+
+        const func_f func = _func;
+        for(std::uint32_t i = 0; i < count; ++i)
         {
-            static_cast<ConnectionInValueHolder<_Output>*>(_outResult.connection())->value() = _outResult.value();
+            out[i] = func(x[i], y[i]);
         }
     }
 };
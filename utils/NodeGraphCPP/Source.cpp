@@ -1,45 +1,10 @@
 #include "Node.hpp"
+#include "EvaluationPlan.hpp"
+#include "GraphBenchmark.hpp"
+#include "GraphTest.hpp"
+#include <cstring>
 #include <iostream>
 
-struct ConstNode : public AbstractNode
-{
-    ConnectionOutValueHolder<int> _outValue;
-
-    ConstNode(const char* nodeTypeName, const char* arbitraryName, int value)
-        : AbstractNode(nodeTypeName, arbitraryName),
-        _outValue("Result", *this, value)
-    { }
-
-
-    NodeValidationCode validateConnections() const noexcept override
-    {
-        return NodeValidationCode::Success;
-    }
-
-    ConnectionPointIn* findConnectionIn(const type_info& type, const char* targetConnectionName) noexcept override
-    {
-        return nullptr;
-    }
-
-    ConnectionPointOut* findConnectionOut(const type_info& type, const char* targetConnectionName) noexcept override
-    {
-        if(type == typeid(int))
-        {
-            return &_outValue;
-        }
-
-        return nullptr;
-    }
-
-    void compute() noexcept override
-    {
-        if(_outValue.connection() != nullptr)
-        {
-            static_cast<ConnectionInValueHolder<int>*>(_outValue.connection())->value() = _outValue.value();
-        }
-    }
-};
-
 struct PrintNode : public AbstractNode
 {
     ConnectionInValueHolder<float> _inValue;
@@ -55,7 +20,7 @@ struct PrintNode : public AbstractNode
         return NodeValidationCode::Success;
     }
 
-    ConnectionPointIn* findConnectionIn(const type_info& type, const char* targetConnectionName) noexcept override
+    ConnectionPointIn* findConnectionIn(const type_info& type, const char*) noexcept override
     {
         if(type == typeid(float))
         {
@@ -65,36 +30,76 @@ struct PrintNode : public AbstractNode
         return nullptr;
     }
 
-    ConnectionPointOut* findConnectionOut(const type_info& type, const char* targetConnectionName) noexcept override
+    ConnectionPointOut* findConnectionOut(const type_info&, const char*) noexcept override
     {
         return nullptr;
     }
 
+    std::uint32_t inputCount() const noexcept override { return 1; }
+    ConnectionPointIn* input(std::uint32_t index) noexcept override { return index == 0 ? &_inValue : nullptr; }
+
+    std::uint32_t outputCount() const noexcept override { return 0; }
+    ConnectionPointOut* output(std::uint32_t) noexcept override { return nullptr; }
+
     void compute() noexcept override
     {
         _inValue.connection()->node().compute();
 
-        std::cout << _inValue.value() << std::endl;
+        std::cout << *_inValue.value() << std::endl;
+    }
 
+    void evaluate(const void* const* inputs, void* const*) noexcept override
+    {
+        std::cout << *static_cast<const float*>(inputs[0]) << std::endl;
     }
 };
 
-int main()
+/**
+ *   `--test` checks compiled plans against recursive computation
+ * and `--benchmark` times them, both exit afterwards.
+ */
+int main(int argCount, char* args[])
 {
+    for(int i = 1; i < argCount; ++i)
+    {
+        if(std::strcmp(args[i], "--test") == 0)
+        {
+            return GraphTest::run() ? 1 : 0;
+        }
+
+        if(std::strcmp(args[i], "--benchmark") == 0)
+        {
+            GraphBenchmark::run();
+            return 0;
+        }
+    }
+
     BinaryOperatorNode<int, int, float> divNode("Div Node", "Test", [](int x, int y) { return (float) x / (float) y; });
 
-    ConstNode x("X", "X", 13);
-    ConstNode y("Y", "Y", 7);
+    ValueNode<int> x("X", "X", 13);
+    ValueNode<int> y("Y", "Y", 7);
     
     PrintNode printer("Print", "Print");
 
-    divNode.connect(&x._outValue, typeid(int), "X");
-    divNode.connect(&y._outValue, typeid(int), "Y");
+    divNode.connect(x.out(), typeid(int), "X");
+    divNode.connect(y.out(), typeid(int), "Y");
 
     divNode.connect(&printer._inValue, typeid(float), "Result");
 
     printer.compute();
 
+    AbstractNode* root = &printer;
+    EvaluationPlan plan;
+    if(plan.compile(&root, 1) == NodeValidationCode::Success)
+    {
+        plan.evaluate();
+
+        // Only the nodes downstream of y are evaluated again.
+        y.value(2);
+        plan.markDirty(&y);
+        plan.evaluate();
+    }
+
     std::getchar();
 
     return 0;
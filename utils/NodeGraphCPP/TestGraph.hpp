@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Node.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ *   Graphs of float additions shared by the tests and the
+ * benchmark. The operation isn't commutative, so connecting an
+ * input to the wrong port changes the result.
+ */
+namespace TestGraph {
+
+using FloatNode = ValueNode<float>;
+using AddNode = BinaryOperatorNode<float, float, float>;
+
+inline float add(float x, float y) { return x + y * 0.5f; }
+
+/**
+ * Owns every node of a graph, inputs before their consumers.
+ */
+struct Graph final
+{
+    std::vector<std::unique_ptr<AbstractNode>> nodes;
+    std::vector<FloatNode*> leaves;
+    std::vector<AddNode*> adds;
+    AddNode* root = nullptr;
+
+    FloatNode* leaf(float value)
+    {
+        FloatNode* node = new FloatNode("Float", "Leaf", value);
+        nodes.emplace_back(node);
+        leaves.push_back(node);
+        return node;
+    }
+
+    AddNode* combine(ConnectionPointOut* x, ConnectionPointOut* y)
+    {
+        AddNode* node = new AddNode("Add", "Add", add);
+        nodes.emplace_back(node);
+        adds.push_back(node);
+        node->connect(0, x);
+        node->connect(1, y);
+        return node;
+    }
+};
+
+/**
+ * A balanced tree, `leafCount` leaves make for 2 * leafCount - 1 nodes.
+ */
+inline void buildTree(Graph& graph, const std::uint32_t leafCount)
+{
+    std::vector<ConnectionPointOut*> level;
+    for(std::uint32_t i = 0; i < leafCount; ++i)
+    {
+        level.push_back(graph.leaf(static_cast<float>(i % 17))->output(0));
+    }
+
+    while(level.size() > 1)
+    {
+        std::vector<ConnectionPointOut*> next;
+        for(std::size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            graph.root = graph.combine(level[i], level[i + 1]);
+            next.push_back(graph.root->output(0));
+        }
+
+        if(level.size() % 2)
+        {
+            next.push_back(level.back());
+        }
+
+        level.swap(next);
+    }
+}
+
+/**
+ *   A chain where every node uses the previous one twice. A recursive
+ * pull computes the first node 2^depth times, a plan computes it once.
+ */
+inline void buildDiamonds(Graph& graph, const std::uint32_t depth)
+{
+    ConnectionPointOut* previous = graph.leaf(1.0f)->output(0);
+    for(std::uint32_t i = 0; i < depth; ++i)
+    {
+        graph.root = graph.combine(previous, previous);
+        previous = graph.root->output(0);
+    }
+}
+
+}
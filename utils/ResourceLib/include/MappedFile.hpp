@@ -0,0 +1,74 @@
+/**
+ * @file
+ *
+ * Describes a read only memory mapped view of a file.
+ */
+#pragma once
+
+#include <Objects.hpp>
+#include <NumTypes.hpp>
+#include <Safeties.hpp>
+#include <DynArray.hpp>
+
+#include "IFile.hpp"
+
+/**
+ * A read only view of an entire file.
+ *
+ *   If the file exists on a physical disk the file is mapped
+ * directly into the address space of the process, this lets
+ * flat binary formats be used in place without being copied
+ * into an intermediate buffer. If the file cannot be mapped
+ * (such as a {@link MemoryFile @endlink} or a file within an
+ * archive) the file is instead read into a single heap
+ * buffer. Either way the data is contiguous and stays valid
+ * for the lifetime of the object.
+ *
+ *   The data is never null terminated, use
+ * {@link MappedFile::size() @endlink} for bounds checking.
+ */
+class MappedFile final
+{
+    DELETE_CM(MappedFile);
+public:
+    /**
+     * Maps a file from its physical path.
+     *
+     * @return
+     *      Null if the file could not be opened or mapped.
+     */
+    [[nodiscard]] static CPPRef<MappedFile> map(const wchar_t* path) noexcept;
+
+    /**
+     * Maps a file that is already open.
+     *
+     *   This first attempts to map the file using the name of
+     * the file as its physical path. If that fails the file is
+     * read from its current position into a heap buffer.
+     */
+    [[nodiscard]] static CPPRef<MappedFile> map(const CPPRef<IFile>& file) noexcept;
+private:
+    const u8* _data;
+    uSys _size;
+    void* _fileHandle;
+    void* _mappingHandle;
+    RefDynArray<u8> _buffer;
+public:
+    MappedFile(const u8* data, uSys size, void* fileHandle, void* mappingHandle) noexcept;
+    MappedFile(const RefDynArray<u8>& buffer, uSys size) noexcept;
+
+    ~MappedFile() noexcept;
+
+    [[nodiscard]] const u8* data() const noexcept { return _data; }
+    [[nodiscard]] uSys size() const noexcept { return _size; }
+
+    /**
+     * Whether or not the data is backed by the page cache
+     * instead of a heap copy.
+     */
+    [[nodiscard]] bool isMapped() const noexcept { return _mappingHandle; }
+
+    template<typename _T>
+    [[nodiscard]] const _T* at(const uSys offset) const noexcept
+    { return reinterpret_cast<const _T*>(_data + offset); }
+};
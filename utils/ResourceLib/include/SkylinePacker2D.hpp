@@ -0,0 +1,790 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "TexturePacker2D.hpp"
+#include <TUMaths.hpp>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/**
+ *   An incremental atlas packer, textures can be inserted and
+ * removed one at a time without repacking the others.
+ *
+ *   Each page keeps a skyline, the lowest edge of the free space
+ * above everything placed so far, stored as segments sorted by
+ * x. New textures are placed on the skyline, either as low as
+ * possible or where they leave the least space underneath them.
+ *
+ *   Space that can't be reached from the skyline any more, the
+ * gaps left under a texture and textures that were removed, is
+ * kept in maps ordered by height, one per power of two of the
+ * width. Those are checked before the skylines, every map of
+ * wider rectangles only needs a lower_bound to find the shortest
+ * one that fits, so finding a hole is logarithmic instead of a
+ * scan of every free rectangle. Free rectangles
+ * are merged with neighbours that share a whole edge, and once
+ * one reaches the skyline the skyline is lowered instead. A page
+ * that becomes empty is reset.
+ *
+ *   When a texture doesn't fit on any page a new page is added,
+ * up to `maxPages`.
+ *
+ * @tparam _HandleT
+ *      A type for a handle back to the texture.
+ * @tparam _CoordT
+ *      An integer type for the coordinate, see TexturePacker2D.
+ */
+template<typename _HandleT, typename _CoordT = u16>
+class SkylinePacker2D final
+{
+    DEFAULT_DESTRUCT(SkylinePacker2D);
+    DELETE_COPY(SkylinePacker2D);
+    DEFAULT_MOVE_PU(SkylinePacker2D);
+public:
+    using Texture = typename TexturePacker2D<_HandleT, _CoordT>::Texture;
+
+    enum class Heuristic : u8
+    {
+        /**
+         * Places textures as low as possible, then as far left as possible.
+         */
+        BottomLeft = 0,
+        /**
+         *   Places textures where they leave the least area between
+         * themselves and the skyline, then as low as possible.
+         */
+        MinWaste
+    };
+
+    struct Placement final
+    {
+        _HandleT handle;
+        u32 page;
+        _CoordT x;
+        _CoordT y;
+        _CoordT width;
+        _CoordT height;
+    };
+
+    /**
+     *   The number of free rectangles looked at in the map with the
+     * same power of two width as the texture, where they can still
+     * be too narrow. This bounds the cost of an insert when there
+     * are a lot of narrow holes.
+     */
+    static constexpr uSys MaxFreeCandidates = 32;
+    static constexpr u32 WidthClasses = sizeof(_CoordT) * 8;
+private:
+    struct Segment final
+    {
+        _CoordT x;
+        _CoordT y;
+        _CoordT width;
+    };
+
+    struct FreeRect final
+    {
+        u32 page;
+        _CoordT x;
+        _CoordT y;
+        _CoordT width;
+        _CoordT height;
+    };
+
+    using FreeIterator = typename ::std::multimap<_CoordT, FreeRect>::iterator;
+
+    /**
+     * A page and a corner of a free rectangle.
+     */
+    using CornerKey = ::std::tuple<u32, _CoordT, _CoordT>;
+
+    struct Page final
+    {
+        ::std::vector<Segment> skyline;
+        /**
+         * The lowest point of the skyline, used to skip full pages.
+         */
+        _CoordT minY;
+        /**
+         *   The smallest texture that didn't fit on the skyline since
+         * it was last lowered, anything at least as large in both
+         * dimensions won't fit either.
+         */
+        _CoordT failedWidth;
+        _CoordT failedHeight;
+        _CoordT usedWidth;
+        _CoordT usedHeight;
+        uSys usedArea;
+    };
+private:
+    _CoordT _pageWidth;
+    _CoordT _pageHeight;
+    u32 _maxPages;
+    Heuristic _heuristic;
+
+    ::std::vector<Page> _pages;
+    /**
+     * The free rectangles by height, indexed by widthClass.
+     */
+    ::std::multimap<_CoordT, FreeRect> _freeRects[WidthClasses];
+    /**
+     *   The free rectangles by their bottom left corner, their
+     * bottom right corner and their top left corner, to find the
+     * neighbours to merge with.
+     */
+    ::std::map<CornerKey, FreeIterator> _freeByOrigin;
+    ::std::map<CornerKey, FreeIterator> _freeByRight;
+    ::std::map<CornerKey, FreeIterator> _freeByTop;
+    ::std::vector<Placement> _placements;
+    uSys _usedArea;
+public:
+    SkylinePacker2D(const _CoordT pageWidth, const _CoordT pageHeight, const u32 maxPages = 1, const Heuristic heuristic = Heuristic::BottomLeft) noexcept
+        : _pageWidth(pageWidth)
+        , _pageHeight(pageHeight)
+        , _maxPages(maxPages)
+        , _heuristic(heuristic)
+        , _pages()
+        , _freeRects{ }
+        , _freeByOrigin()
+        , _freeByRight()
+        , _freeByTop()
+        , _placements()
+        , _usedArea(0)
+    { }
+
+    [[nodiscard]] _CoordT pageWidth() const noexcept { return _pageWidth; }
+    [[nodiscard]] _CoordT pageHeight() const noexcept { return _pageHeight; }
+    [[nodiscard]] u32 maxPages() const noexcept { return _maxPages; }
+    [[nodiscard]] Heuristic heuristic() const noexcept { return _heuristic; }
+
+    [[nodiscard]] u32 pageCount() const noexcept { return static_cast<u32>(_pages.size()); }
+
+    /**
+     *   The furthest extent textures have reached on a page, this
+     * doesn't shrink when textures are removed.
+     */
+    [[nodiscard]] _CoordT usedWidth(const u32 page) const noexcept { return _pages[page].usedWidth; }
+    [[nodiscard]] _CoordT usedHeight(const u32 page) const noexcept { return _pages[page].usedHeight; }
+
+    /**
+     * The area of every texture currently in the atlas.
+     */
+    [[nodiscard]] uSys usedArea() const noexcept { return _usedArea; }
+
+    /**
+     *   The used area divided by the area of the used extent of
+     * every page, comparable to packing into a TexturePacker2D
+     * of `packedWidth` by `packedHeight`.
+     */
+    [[nodiscard]] double occupancy() const noexcept
+    {
+        const uSys extent = usedExtent();
+        return extent ? static_cast<double>(_usedArea) / static_cast<double>(extent) : 0.0;
+    }
+
+    /**
+     * The placements of the textures given to the last call to pack.
+     */
+    [[nodiscard]] const ::std::vector<Placement>& placements() const noexcept { return _placements; }
+
+    /**
+     *   Places a single texture. Returns false if it doesn't fit in
+     * any page and no more pages can be added.
+     */
+    bool insert(_HandleT handle, _CoordT width, _CoordT height, Placement* placement = nullptr) noexcept;
+
+    /**
+     * Returns the space of a placement returned by insert or pack.
+     */
+    void remove(const Placement& placement) noexcept;
+
+    /**
+     * Removes every texture and page.
+     */
+    void clear() noexcept
+    {
+        _pages.clear();
+        for(auto& freeRects : _freeRects)
+        { freeRects.clear(); }
+        _freeByOrigin.clear();
+        _freeByRight.clear();
+        _freeByTop.clear();
+        _placements.clear();
+        _usedArea = 0;
+    }
+
+    /**
+     *   Clears the packer and inserts every texture, trying a few
+     * sort orders with both heuristics and keeping whichever uses
+     * the fewest pages and then the least height. The candidates
+     * are evaluated on up to `threadCount` threads, 0 uses one per
+     * hardware thread.
+     *
+     *   The heuristic the packer was constructed with is replaced
+     * by the one that won. Returns false if no candidate fit every
+     * texture, the packer then holds the best partial packing.
+     */
+    template<typename _TextureComparator = typename TexturePacker2D<_HandleT, _CoordT>::TextureGreater>
+    bool pack(const Texture* textures, uSys textureCount, u32 threadCount = 0) noexcept;
+private:
+    bool insertFree(_HandleT handle, _CoordT width, _CoordT height, Placement* placement) noexcept;
+
+    /**
+     *   Finds where a texture fits on the skyline of a page. Returns
+     * false if it doesn't fit anywhere on it.
+     */
+    bool findPosition(const Page& page, _CoordT width, _CoordT height, uSys* segmentIndex, _CoordT* y) const noexcept;
+
+    void placeOnSkyline(u32 pageIndex, uSys segmentIndex, _CoordT y, _CoordT width, _CoordT height) noexcept;
+
+    /**
+     *   Lowers the skyline to `y` between `x` and `x + width` if it
+     * is at `y + height` across all of it.
+     */
+    bool lowerSkyline(u32 pageIndex, _CoordT x, _CoordT y, _CoordT width, _CoordT height) noexcept;
+
+    void addFreeRect(u32 page, _CoordT x, _CoordT y, _CoordT width, _CoordT height) noexcept;
+    void eraseFreeRect(FreeIterator it) noexcept;
+    void resetPage(u32 pageIndex) noexcept;
+
+    void markUsed(Placement& placement) noexcept;
+
+    [[nodiscard]] static u32 widthClass(_CoordT width) noexcept
+    {
+        u32 ret = 0;
+        while(width >>= 1)
+        { ++ret; }
+        return ret;
+    }
+
+    static void mergeSegments(Page& page) noexcept;
+    static void updateMinY(Page& page) noexcept;
+
+    /**
+     * The sum of the used width times the used height of every page.
+     */
+    [[nodiscard]] uSys usedExtent() const noexcept;
+};
+
+template<typename _HandleT, typename _CoordT>
+bool SkylinePacker2D<_HandleT, _CoordT>::insert(const _HandleT handle, const _CoordT width, const _CoordT height, Placement* const placement) noexcept
+{
+    if(width == 0 || height == 0 || width > _pageWidth || height > _pageHeight)
+    { return false; }
+
+    if(insertFree(handle, width, height, placement))
+    { return true; }
+
+    for(u32 i = 0; i <= _pages.size(); ++i)
+    {
+        if(i == _pages.size())
+        {
+            if(_pages.size() >= _maxPages)
+            { return false; }
+
+            Page page;
+            page.skyline.push_back({ 0, 0, _pageWidth });
+            page.minY = 0;
+            page.failedWidth = static_cast<_CoordT>(~static_cast<_CoordT>(0));
+            page.failedHeight = static_cast<_CoordT>(~static_cast<_CoordT>(0));
+            page.usedWidth = 0;
+            page.usedHeight = 0;
+            page.usedArea = 0;
+            _pages.push_back(::std::move(page));
+        }
+
+        Page& page = _pages[i];
+        if(static_cast<uSys>(page.minY) + height > _pageHeight ||
+           (width >= page.failedWidth && height >= page.failedHeight))
+        { continue; }
+
+        uSys segmentIndex;
+        _CoordT y;
+        if(!findPosition(page, width, height, &segmentIndex, &y))
+        {
+            if(static_cast<uSys>(width) * height < static_cast<uSys>(page.failedWidth) * page.failedHeight)
+            {
+                page.failedWidth = width;
+                page.failedHeight = height;
+            }
+            continue;
+        }
+
+        Placement ret { handle, i, page.skyline[segmentIndex].x, y, width, height };
+        placeOnSkyline(i, segmentIndex, y, width, height);
+        markUsed(ret);
+
+        if(placement)
+        { *placement = ret; }
+        return true;
+    }
+
+    return false;
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::remove(const Placement& placement) noexcept
+{
+    Page& page = _pages[placement.page];
+    page.usedArea -= static_cast<uSys>(placement.width) * placement.height;
+    _usedArea -= static_cast<uSys>(placement.width) * placement.height;
+
+    if(page.usedArea == 0)
+    {
+        resetPage(placement.page);
+        return;
+    }
+
+    addFreeRect(placement.page, placement.x, placement.y, placement.width, placement.height);
+}
+
+template<typename _HandleT, typename _CoordT>
+template<typename _TextureComparator>
+bool SkylinePacker2D<_HandleT, _CoordT>::pack(const Texture* const textures, const uSys textureCount, u32 threadCount) noexcept
+{
+    using Packer = TexturePacker2D<_HandleT, _CoordT>;
+
+    struct Candidate final
+    {
+        SkylinePacker2D packer;
+        ::std::vector<Texture> sorted;
+        bool success;
+    };
+
+    ::std::vector<Candidate> candidates;
+    for(const Heuristic heuristic : { Heuristic::BottomLeft, Heuristic::MinWaste })
+    {
+        for(u32 order = 0; order < 3; ++order)
+        { candidates.push_back({ SkylinePacker2D(_pageWidth, _pageHeight, _maxPages, heuristic), ::std::vector<Texture>(textures, textures + textureCount), false }); }
+    }
+
+    const auto evaluate = [&candidates](const uSys index) noexcept
+    {
+        Candidate& candidate = candidates[index];
+        switch(index % 3)
+        {
+            case 0: ::std::sort(candidate.sorted.begin(), candidate.sorted.end(), _TextureComparator()); break;
+            case 1: ::std::sort(candidate.sorted.begin(), candidate.sorted.end(), typename Packer::TextureHeightGreater()); break;
+            default: ::std::sort(candidate.sorted.begin(), candidate.sorted.end(), typename Packer::TextureSideGreater()); break;
+        }
+
+        candidate.success = true;
+        candidate.packer._placements.reserve(candidate.sorted.size());
+        for(const Texture& texture : candidate.sorted)
+        {
+            Placement placement;
+            if(candidate.packer.insert(texture.handle, texture.width, texture.height, &placement))
+            { candidate.packer._placements.push_back(placement); }
+            else
+            { candidate.success = false; }
+        }
+    };
+
+    if(threadCount == 0)
+    { threadCount = ::std::thread::hardware_concurrency(); }
+    threadCount = minT(maxT(threadCount, 1u), static_cast<u32>(candidates.size()));
+
+    if(threadCount == 1)
+    {
+        for(uSys i = 0; i < candidates.size(); ++i)
+        { evaluate(i); }
+    }
+    else
+    {
+        ::std::vector<::std::thread> threads;
+        for(u32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&evaluate, &candidates, t, threadCount]()
+            {
+                for(uSys i = t; i < candidates.size(); i += threadCount)
+                { evaluate(i); }
+            });
+        }
+
+        for(::std::thread& thread : threads)
+        { thread.join(); }
+    }
+
+    Candidate* best = &candidates[0];
+    for(Candidate& candidate : candidates)
+    {
+        if(candidate.success != best->success)
+        {
+            if(candidate.success)
+            { best = &candidate; }
+            continue;
+        }
+
+        if(candidate.packer._placements.size() != best->packer._placements.size())
+        {
+            if(candidate.packer._placements.size() > best->packer._placements.size())
+            { best = &candidate; }
+            continue;
+        }
+
+        if(candidate.packer.pageCount() != best->packer.pageCount())
+        {
+            if(candidate.packer.pageCount() < best->packer.pageCount())
+            { best = &candidate; }
+            continue;
+        }
+
+        if(candidate.packer.usedExtent() < best->packer.usedExtent())
+        { best = &candidate; }
+    }
+
+    *this = ::std::move(best->packer);
+    return best->success;
+}
+
+template<typename _HandleT, typename _CoordT>
+bool SkylinePacker2D<_HandleT, _CoordT>::insertFree(const _HandleT handle, const _CoordT width, const _CoordT height, Placement* const placement) noexcept
+{
+    FreeIterator best;
+    uSys bestArea = ~static_cast<uSys>(0);
+
+    const u32 firstClass = widthClass(width);
+    for(u32 i = firstClass; i < WidthClasses; ++i)
+    {
+        ::std::multimap<_CoordT, FreeRect>& freeRects = _freeRects[i];
+
+        uSys candidates = 0;
+        for(auto it = freeRects.lower_bound(height); it != freeRects.end() && candidates < MaxFreeCandidates; ++it, ++candidates)
+        {
+            const FreeRect& rect = it->second;
+            if(rect.width < width)
+            { continue; }
+
+            const uSys area = static_cast<uSys>(rect.width) * rect.height;
+            if(area < bestArea)
+            {
+                best = it;
+                bestArea = area;
+            }
+
+            // Everything in the wider classes fits, the first one is the shortest.
+            if(i != firstClass)
+            { break; }
+        }
+    }
+
+    if(bestArea == ~static_cast<uSys>(0))
+    { return false; }
+
+    const FreeRect rect = best->second;
+    eraseFreeRect(best);
+
+    // Split the remainder along the shorter leftover side.
+    const _CoordT rightWidth = static_cast<_CoordT>(rect.width - width);
+    const _CoordT topHeight = static_cast<_CoordT>(rect.height - height);
+    if(rightWidth < topHeight)
+    {
+        addFreeRect(rect.page, static_cast<_CoordT>(rect.x + width), rect.y, rightWidth, height);
+        addFreeRect(rect.page, rect.x, static_cast<_CoordT>(rect.y + height), rect.width, topHeight);
+    }
+    else
+    {
+        addFreeRect(rect.page, static_cast<_CoordT>(rect.x + width), rect.y, rightWidth, rect.height);
+        addFreeRect(rect.page, rect.x, static_cast<_CoordT>(rect.y + height), width, topHeight);
+    }
+
+    Placement ret { handle, rect.page, rect.x, rect.y, width, height };
+    markUsed(ret);
+
+    if(placement)
+    { *placement = ret; }
+    return true;
+}
+
+template<typename _HandleT, typename _CoordT>
+bool SkylinePacker2D<_HandleT, _CoordT>::findPosition(const Page& page, const _CoordT width, const _CoordT height, uSys* const segmentIndex, _CoordT* const y) const noexcept
+{
+    const ::std::vector<Segment>& skyline = page.skyline;
+
+    uSys bestY = ~static_cast<uSys>(0);
+    uSys bestWaste = ~static_cast<uSys>(0);
+    uSys bestIndex = skyline.size();
+
+    for(uSys i = 0; i < skyline.size(); ++i)
+    {
+        const uSys left = skyline[i].x;
+        const uSys right = left + width;
+        if(right > _pageWidth)
+        { break; }
+
+        /**
+         *   A texture starting on a segment can't be any lower than
+         * it, nor leave less than no waste.
+         */
+        if(static_cast<uSys>(skyline[i].y) + height > _pageHeight ||
+           ((_heuristic == Heuristic::BottomLeft || bestWaste == 0) && skyline[i].y >= bestY))
+        { continue; }
+
+        uSys top = 0;
+        uSys end = i;
+        for(; end < skyline.size() && skyline[end].x < right; ++end)
+        { top = maxT(top, static_cast<uSys>(skyline[end].y)); }
+
+        if(top + height > _pageHeight)
+        { continue; }
+
+        if(_heuristic == Heuristic::BottomLeft)
+        {
+            if(top < bestY)
+            {
+                bestY = top;
+                bestIndex = i;
+            }
+            continue;
+        }
+
+        uSys waste = 0;
+        for(uSys j = i; j < end; ++j)
+        {
+            const uSys segmentRight = minT(static_cast<uSys>(skyline[j].x) + skyline[j].width, right);
+            waste += (segmentRight - skyline[j].x) * (top - skyline[j].y);
+        }
+
+        if(waste < bestWaste || (waste == bestWaste && top < bestY))
+        {
+            bestWaste = waste;
+            bestY = top;
+            bestIndex = i;
+        }
+    }
+
+    if(bestIndex == skyline.size())
+    { return false; }
+
+    *segmentIndex = bestIndex;
+    *y = static_cast<_CoordT>(bestY);
+    return true;
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::placeOnSkyline(const u32 pageIndex, const uSys segmentIndex, const _CoordT y, const _CoordT width, const _CoordT height) noexcept
+{
+    ::std::vector<Segment>& skyline = _pages[pageIndex].skyline;
+
+    const _CoordT x = skyline[segmentIndex].x;
+    const uSys right = static_cast<uSys>(x) + width;
+
+    // The gaps between the texture and the segments it covers can only be reached through the free map now.
+    for(uSys i = segmentIndex; i < skyline.size() && skyline[i].x < right; ++i)
+    {
+        const Segment& segment = skyline[i];
+        if(segment.y < y)
+        {
+            const uSys segmentRight = minT(static_cast<uSys>(segment.x) + segment.width, right);
+            addFreeRect(pageIndex, segment.x, segment.y, static_cast<_CoordT>(segmentRight - segment.x), static_cast<_CoordT>(y - segment.y));
+        }
+    }
+
+    skyline.insert(skyline.begin() + segmentIndex, { x, static_cast<_CoordT>(y + height), width });
+
+    for(uSys i = segmentIndex + 1; i < skyline.size();)
+    {
+        Segment& segment = skyline[i];
+        if(segment.x >= right)
+        { break; }
+
+        const uSys segmentRight = static_cast<uSys>(segment.x) + segment.width;
+        if(segmentRight <= right)
+        {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+
+        segment.width = static_cast<_CoordT>(segmentRight - right);
+        segment.x = static_cast<_CoordT>(right);
+        break;
+    }
+
+    Page& page = _pages[pageIndex];
+    mergeSegments(page);
+    updateMinY(page);
+}
+
+template<typename _HandleT, typename _CoordT>
+bool SkylinePacker2D<_HandleT, _CoordT>::lowerSkyline(const u32 pageIndex, const _CoordT x, const _CoordT y, const _CoordT width, const _CoordT height) noexcept
+{
+    Page& page = _pages[pageIndex];
+    ::std::vector<Segment>& skyline = page.skyline;
+
+    const uSys left = x;
+    const uSys right = left + width;
+    const uSys top = static_cast<uSys>(y) + height;
+
+    // The segment containing the left edge.
+    uSys first = static_cast<uSys>(::std::upper_bound(skyline.begin(), skyline.end(), left,
+                                                      [](const uSys value, const Segment& segment) { return value < segment.x; }) - skyline.begin()) - 1;
+
+    for(uSys i = first; i < skyline.size() && skyline[i].x < right; ++i)
+    {
+        if(skyline[i].y != top)
+        { return false; }
+    }
+
+    // Split the segments at both edges, then replace everything between them.
+    if(skyline[first].x < left)
+    {
+        Segment& segment = skyline[first];
+        const Segment split { x, segment.y, static_cast<_CoordT>(segment.x + segment.width - left) };
+        segment.width = static_cast<_CoordT>(left - segment.x);
+        skyline.insert(skyline.begin() + ++first, split);
+    }
+
+    uSys last = first;
+    while(skyline[last].x + static_cast<uSys>(skyline[last].width) < right)
+    { ++last; }
+
+    if(skyline[last].x + static_cast<uSys>(skyline[last].width) > right)
+    {
+        Segment& segment = skyline[last];
+        const Segment split { static_cast<_CoordT>(right), segment.y, static_cast<_CoordT>(segment.x + segment.width - right) };
+        segment.width = static_cast<_CoordT>(right - segment.x);
+        skyline.insert(skyline.begin() + last + 1, split);
+    }
+
+    skyline[first].y = y;
+    skyline[first].width = width;
+    skyline.erase(skyline.begin() + first + 1, skyline.begin() + last + 1);
+
+    mergeSegments(page);
+    updateMinY(page);
+    page.failedWidth = static_cast<_CoordT>(~static_cast<_CoordT>(0));
+    page.failedHeight = static_cast<_CoordT>(~static_cast<_CoordT>(0));
+    return true;
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::addFreeRect(const u32 page, _CoordT x, _CoordT y, _CoordT width, _CoordT height) noexcept
+{
+    if(width == 0 || height == 0)
+    { return; }
+
+    while(true)
+    {
+        auto neighbour = _freeByOrigin.find(CornerKey(page, static_cast<_CoordT>(x + width), y));
+        if(neighbour != _freeByOrigin.end() && neighbour->second->second.height == height)
+        {
+            width = static_cast<_CoordT>(width + neighbour->second->second.width);
+            eraseFreeRect(neighbour->second);
+            continue;
+        }
+
+        neighbour = _freeByRight.find(CornerKey(page, x, y));
+        if(neighbour != _freeByRight.end() && neighbour->second->second.height == height)
+        {
+            x = neighbour->second->second.x;
+            width = static_cast<_CoordT>(width + neighbour->second->second.width);
+            eraseFreeRect(neighbour->second);
+            continue;
+        }
+
+        neighbour = _freeByOrigin.find(CornerKey(page, x, static_cast<_CoordT>(y + height)));
+        if(neighbour != _freeByOrigin.end() && neighbour->second->second.width == width)
+        {
+            height = static_cast<_CoordT>(height + neighbour->second->second.height);
+            eraseFreeRect(neighbour->second);
+            continue;
+        }
+
+        neighbour = _freeByTop.find(CornerKey(page, x, y));
+        if(neighbour != _freeByTop.end() && neighbour->second->second.width == width)
+        {
+            y = neighbour->second->second.y;
+            height = static_cast<_CoordT>(height + neighbour->second->second.height);
+            eraseFreeRect(neighbour->second);
+            continue;
+        }
+
+        break;
+    }
+
+    if(lowerSkyline(page, x, y, width, height))
+    { return; }
+
+    const FreeIterator it = _freeRects[widthClass(width)].emplace(height, FreeRect { page, x, y, width, height });
+    _freeByOrigin.emplace(CornerKey(page, x, y), it);
+    _freeByRight.emplace(CornerKey(page, static_cast<_CoordT>(x + width), y), it);
+    _freeByTop.emplace(CornerKey(page, x, static_cast<_CoordT>(y + height)), it);
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::eraseFreeRect(const FreeIterator it) noexcept
+{
+    const FreeRect& rect = it->second;
+    _freeByOrigin.erase(CornerKey(rect.page, rect.x, rect.y));
+    _freeByRight.erase(CornerKey(rect.page, static_cast<_CoordT>(rect.x + rect.width), rect.y));
+    _freeByTop.erase(CornerKey(rect.page, rect.x, static_cast<_CoordT>(rect.y + rect.height)));
+    _freeRects[widthClass(rect.width)].erase(it);
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::resetPage(const u32 pageIndex) noexcept
+{
+    for(auto& freeRects : _freeRects)
+    {
+        for(auto it = freeRects.begin(); it != freeRects.end();)
+        {
+            const auto next = ::std::next(it);
+            if(it->second.page == pageIndex)
+            { eraseFreeRect(it); }
+            it = next;
+        }
+    }
+
+    Page& page = _pages[pageIndex];
+    page.skyline.clear();
+    page.skyline.push_back({ 0, 0, _pageWidth });
+    page.minY = 0;
+    page.failedWidth = static_cast<_CoordT>(~static_cast<_CoordT>(0));
+    page.failedHeight = static_cast<_CoordT>(~static_cast<_CoordT>(0));
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::markUsed(Placement& placement) noexcept
+{
+    Page& page = _pages[placement.page];
+    page.usedWidth = maxT(page.usedWidth, static_cast<_CoordT>(placement.x + placement.width));
+    page.usedHeight = maxT(page.usedHeight, static_cast<_CoordT>(placement.y + placement.height));
+    page.usedArea += static_cast<uSys>(placement.width) * placement.height;
+    _usedArea += static_cast<uSys>(placement.width) * placement.height;
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::mergeSegments(Page& page) noexcept
+{
+    ::std::vector<Segment>& skyline = page.skyline;
+    uSys write = 0;
+    for(uSys read = 1; read < skyline.size(); ++read)
+    {
+        if(skyline[read].y == skyline[write].y)
+        { skyline[write].width = static_cast<_CoordT>(skyline[write].width + skyline[read].width); }
+        else
+        { skyline[++write] = skyline[read]; }
+    }
+    skyline.resize(write + 1);
+}
+
+template<typename _HandleT, typename _CoordT>
+void SkylinePacker2D<_HandleT, _CoordT>::updateMinY(Page& page) noexcept
+{
+    page.minY = page.skyline[0].y;
+    for(const Segment& segment : page.skyline)
+    { page.minY = minT(page.minY, segment.y); }
+}
+
+template<typename _HandleT, typename _CoordT>
+uSys SkylinePacker2D<_HandleT, _CoordT>::usedExtent() const noexcept
+{
+    uSys ret = 0;
+    for(const Page& page : _pages)
+    { ret += static_cast<uSys>(page.usedWidth) * page.usedHeight; }
+    return ret;
+}
@@ -0,0 +1,91 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+  #pragma warning(push, 0)
+  #include <Windows.h>
+  #pragma warning(pop)
+#endif
+
+MappedFile::MappedFile(const u8* const data, const uSys size, void* const fileHandle, void* const mappingHandle) noexcept
+    : _data(data)
+    , _size(size)
+    , _fileHandle(fileHandle)
+    , _mappingHandle(mappingHandle)
+    , _buffer(0)
+{ }
+
+MappedFile::MappedFile(const RefDynArray<u8>& buffer, const uSys size) noexcept
+    : _data(buffer.arr())
+    , _size(size)
+    , _fileHandle(nullptr)
+    , _mappingHandle(nullptr)
+    , _buffer(buffer)
+{ }
+
+#ifdef _WIN32
+MappedFile::~MappedFile() noexcept
+{
+    if(_mappingHandle)
+    {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mappingHandle);
+        CloseHandle(_fileHandle);
+    }
+}
+
+CPPRef<MappedFile> MappedFile::map(const wchar_t* const path) noexcept
+{
+    const HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    { return nullptr; }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(!mapping)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    const void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    return CPPRef<MappedFile>(new(::std::nothrow) MappedFile(reinterpret_cast<const u8*>(view), static_cast<uSys>(size.QuadPart), file, mapping));
+}
+#else
+MappedFile::~MappedFile() noexcept = default;
+
+CPPRef<MappedFile> MappedFile::map(const wchar_t*) noexcept
+{ return nullptr; }
+#endif
+
+CPPRef<MappedFile> MappedFile::map(const CPPRef<IFile>& file) noexcept
+{
+    if(!file)
+    { return nullptr; }
+
+    CPPRef<MappedFile> mapped = map(file->name());
+    if(mapped)
+    { return mapped; }
+
+    const i64 size = file->size();
+    if(size <= 0)
+    { return nullptr; }
+
+    RefDynArray<u8> buffer(static_cast<uSys>(size));
+    if(file->readBytes(buffer.arr(), static_cast<uSys>(size)) != size)
+    { return nullptr; }
+
+    return CPPRef<MappedFile>(new(::std::nothrow) MappedFile(buffer, static_cast<uSys>(size)));
+}
@@ -12,7 +12,7 @@ namespace clang {
 }
 
 namespace llvm {
-    class raw_fd_ostream;
+    class raw_ostream;
 }
 
 namespace tau { namespace reflection {
@@ -85,9 +85,14 @@ public:
 
     virtual void destroyData(AttributeData& data) const noexcept { }
 
-    virtual void generateBaseTauClass(::llvm::raw_fd_ostream& base) const noexcept { }
-    virtual void generateImplTauClass(::llvm::raw_fd_ostream& base, const Ref<Class>& clazz) const noexcept { }
-    virtual void generateImplClass(::llvm::raw_fd_ostream& base, const Ref<Class>& clazz) const noexcept { }
+    /**
+     *   Generates code in the base header before `ITauClass`,
+     * for any types or functions the generated classes share.
+     */
+    virtual void generateBaseHeader(::llvm::raw_ostream& base) const noexcept { }
+    virtual void generateBaseTauClass(::llvm::raw_ostream& base) const noexcept { }
+    virtual void generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept { }
+    virtual void generateImplClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept { }
 protected:
     static const clang::Token* getNextToken(const clang::Token* currentToken) noexcept;
 };
@@ -111,7 +116,13 @@ public:
     };
 private:
     static AttribHandlerSet _attributeHandlers;
-    static FBAllocator _attribTreeAllocator;
+
+    /**
+     *   Each thread has its own allocator as headers are processed
+     * in parallel, tag declarations must be destroyed on the thread
+     * that created them.
+     */
+    static thread_local FBAllocator _attribTreeAllocator;
 public:
     template<typename _T, typename... _Args>
     static void registerAttribute(const DynString& attribName, _Args&&... args) noexcept
@@ -121,7 +132,12 @@ public:
     static void registerAttribute(DynString&& attribName, _Args&&... args) noexcept
     { _attributeHandlers.emplace(::std::move(attribName), Ref<_T>(DefaultTauAllocator::Instance(), ::std::forward<_Args>(args)...)); }
 
-    static Ref<IAttribute> getAttribute(const DynString& attribName) noexcept;
+    /**
+     *   Returns a null reference if the attribute wasn't registered.
+     * Attributes must all be registered before any headers are
+     * processed.
+     */
+    static const Ref<IAttribute>& getAttribute(const DynString& attribName) noexcept;
 
     [[nodiscard]] static AttribIterator getAttributes() noexcept
     { return { _attributeHandlers.begin(), _attributeHandlers.end() }; }
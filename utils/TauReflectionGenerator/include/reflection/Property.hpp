@@ -1,6 +1,7 @@
 #pragma once
 
 // #include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/Specifiers.h>
 #include "Attribute.hpp"
 #include "TagDeclaration.hpp"
 #include <vector>
@@ -16,18 +17,33 @@ private:
     Ref<Class> _parentClass;
     DynString _name;
     DynString _typeName;
+    unsigned _fieldIndex;
+    ::clang::AccessSpecifier _access;
+    bool _triviallyCopyable;
 public:
-    Property(const Ref<TagDeclaration>& declaration, const Ref<Class>& parentClass, const DynString& name, const DynString& typeName) noexcept
+    Property(const Ref<TagDeclaration>& declaration, const Ref<Class>& parentClass, const DynString& name, const DynString& typeName, const unsigned fieldIndex, const ::clang::AccessSpecifier access, const bool triviallyCopyable) noexcept
         : _declaration(declaration)
         , _parentClass(parentClass)
         , _name(name)
         , _typeName(typeName)
+        , _fieldIndex(fieldIndex)
+        , _access(access)
+        , _triviallyCopyable(triviallyCopyable)
     { }
 
     [[nodiscard]] const Ref<TagDeclaration>& declaration() const noexcept { return _declaration; }
     [[nodiscard]] const Ref<Class>& parentClass() const noexcept { return _parentClass; }
     [[nodiscard]] const DynString& name() const noexcept { return _name; }
     [[nodiscard]] const DynString& typeName() const noexcept { return _typeName; }
+
+    /**
+     *   The index of the field within all of the fields of its
+     * class, including those that aren't reflected. Fields with
+     * adjacent indices and the same access are laid out in order.
+     */
+    [[nodiscard]] unsigned fieldIndex() const noexcept { return _fieldIndex; }
+    [[nodiscard]] ::clang::AccessSpecifier access() const noexcept { return _access; }
+    [[nodiscard]] bool triviallyCopyable() const noexcept { return _triviallyCopyable; }
 };
 
 using PropertyList = ::std::vector<Ref<Property>>;
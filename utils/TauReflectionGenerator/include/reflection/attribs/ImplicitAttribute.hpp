@@ -13,8 +13,10 @@ public:
 
     AttributeData parseAttribute(const DynString& attribName, const ::clang::MacroArgs* args, const ::clang::Token*& currentToken) const noexcept override;
 
-    void generateBaseTauClass(::llvm::raw_fd_ostream& base) const noexcept override;
-    void generateImplTauClass(::llvm::raw_fd_ostream& base, const Ref<Class>& clazz) const noexcept override;
+    void generateBaseTauClass(::llvm::raw_ostream& base) const noexcept override;
+    void generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept override;
+private:
+    static void generatePropertyLookup(::llvm::raw_ostream& base, const Ref<Class>& clazz) noexcept;
 };
 
 } } }
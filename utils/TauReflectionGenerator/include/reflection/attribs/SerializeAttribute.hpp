@@ -0,0 +1,35 @@
+#pragma once
+
+#include "reflection/Attribute.hpp"
+
+namespace tau { namespace reflection { namespace attribs {
+
+/**
+ * Generates a binary serializer for the tagged properties.
+ *
+ *   A serialized object is a header, a table with the name hash,
+ * type hash, offset and size of every property, then the data.
+ * Runs of adjacent trivially copyable properties are copied as a
+ * single block, padding included. Anything else goes through
+ * `TauSerializer`, which reflected types and trivially copyable
+ * types already support, other types need a specialization.
+ *
+ *   The header holds a hash of the layout, when it matches the
+ * reader the blocks are copied straight out of the buffer.
+ * Otherwise the properties are matched up through the table,
+ * properties that were removed or changed type are skipped and
+ * properties that were added keep their current value.
+ */
+class SerializeAttribute final : public IAttribute
+{
+public:
+    [[nodiscard]] bool isForProperty() const noexcept override { return true; }
+
+    AttributeData parseAttribute(const DynString& attribName, const ::clang::MacroArgs* args, const ::clang::Token*& currentToken) const noexcept override;
+
+    void generateBaseHeader(::llvm::raw_ostream& base) const noexcept override;
+    void generateBaseTauClass(::llvm::raw_ostream& base) const noexcept override;
+    void generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept override;
+};
+
+} } }
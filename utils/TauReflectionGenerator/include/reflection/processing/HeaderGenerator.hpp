@@ -15,29 +15,34 @@ namespace tau { namespace reflection { namespace processing {
 class BaseGenerator
 {
 private:
-    ::std::error_code _ec;
-    ::llvm::raw_fd_ostream _header;
+    ::llvm::raw_ostream& _header;
 public:
-    BaseGenerator(const DynString& header) noexcept
-        : _header(::llvm::StringRef(header.c_str(), header.length()), _ec)
+    BaseGenerator(::llvm::raw_ostream& header) noexcept
+        : _header(header)
     { }
 
     void generate() noexcept;
 private:
     void printHeaderBegin() noexcept;
     void printBasicMacros() noexcept;
+    void printNameHash() noexcept;
+    void printAttributeHeaders() noexcept;
     void printClass() noexcept;
 };
 
 
+/**
+ *   Writes to a stream rather than a file so that the output can
+ * be compared against what is already on disk before replacing
+ * it, see writeIfChanged.
+ */
 class HeaderGenerator
 {
 private:
-    ::std::error_code _ec;
-    ::llvm::raw_fd_ostream _header;
+    ::llvm::raw_ostream& _header;
 public:
-    HeaderGenerator(const DynString& header) noexcept
-        : _header(::llvm::StringRef(header.c_str(), header.length()), _ec)
+    HeaderGenerator(::llvm::raw_ostream& header) noexcept
+        : _header(header)
     { }
 
     void generateDummy() noexcept;
@@ -49,4 +54,12 @@ private:
     void printDummyMacros() noexcept;
 };
 
+/**
+ *   Replaces the file only if its contents differ, leaving its
+ * modification time alone otherwise so that nothing including it
+ * is rebuilt. Missing directories are created. Returns false if
+ * the file couldn't be written.
+ */
+bool writeIfChanged(const DynString& path, ::llvm::StringRef contents, bool* changed = nullptr) noexcept;
+
 } } }
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace tau { namespace reflection { namespace processing {
+
+/**
+ *   Writes a tree of 1000 synthetic headers to `dir` and times
+ * a cold run on one thread and on `threadCount` threads, a warm
+ * run with nothing changed and a run after editing 10 headers.
+ */
+int runIncrementalBenchmark(const char* dir, unsigned threadCount) noexcept;
+
+} } }
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <NumTypes.hpp>
+#include <Objects.hpp>
+#include <String.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang { namespace tooling {
+    class CompilationDatabase;
+} }
+
+namespace tau { namespace reflection { namespace processing {
+
+/**
+ *   Part of every header's hash so that a new generator doesn't
+ * reuse output from an old one. Increment this whenever the
+ * generated code changes.
+ */
+static constexpr u32 GENERATOR_VERSION = 3;
+
+/**
+ *   Maps each source to the hash of its preprocessed tokens from
+ * the last run that generated it. Stored as a line of the hash in
+ * hex followed by the path for each source.
+ */
+class GeneratorCache final
+{
+    DEFAULT_DESTRUCT(GeneratorCache);
+    DELETE_CM(GeneratorCache);
+private:
+    DynString _path;
+    ::std::unordered_map<::std::string, u64> _hashes;
+    ::std::mutex _mutex;
+    bool _dirty;
+public:
+    /**
+     * A missing or unreadable cache is treated as empty.
+     */
+    GeneratorCache(const DynString& path) noexcept;
+
+    [[nodiscard]] bool matches(const ::std::string& source, u64 hash) noexcept;
+
+    void update(const ::std::string& source, u64 hash) noexcept;
+    void remove(const ::std::string& source) noexcept;
+
+    /**
+     * Only writes the cache if anything changed.
+     */
+    bool save() noexcept;
+};
+
+/**
+ *   Generates a header for each source on a pool of threads.
+ *
+ *   Every source is preprocessed first, hashing the token stream
+ * along the way. If the hash matches the last run and the output
+ * still exists the source isn't parsed any further. Otherwise the
+ * output is generated in memory and only written if it differs,
+ * so unchanged headers keep their modification time.
+ *
+ *   While a source is processed its generated header is replaced
+ * with one that defines TAU_GENERATED_BODY as nothing. The real
+ * one may be out of date and fail to compile, and it would also
+ * make the hash depend on the previous output.
+ *
+ *   Outputs mirror the directories of their sources below the
+ * source root, so headers with the same name in different
+ * directories don't overwrite each other. Sources that would
+ * still share an output fail.
+ */
+class IncrementalGenerator final
+{
+    DEFAULT_DESTRUCT(IncrementalGenerator);
+    DELETE_CM(IncrementalGenerator);
+public:
+    struct Stats final
+    {
+        uSys written;
+        uSys unchanged;
+        uSys cached;
+        uSys failed;
+    };
+private:
+    enum class Result
+    {
+        Written,
+        Unchanged,
+        Cached,
+        Failed
+    };
+private:
+    const ::clang::tooling::CompilationDatabase& _compilations;
+    DynString _outDir;
+    DynString _sourceRoot;
+    GeneratorCache _cache;
+    unsigned _threadCount;
+    ::std::string _dummyHeader;
+public:
+    /**
+     * A thread count of 0 uses every hardware thread.
+     */
+    IncrementalGenerator(const ::clang::tooling::CompilationDatabase& compilations, const DynString& outDir, const DynString& sourceRoot, const DynString& cachePath, unsigned threadCount) noexcept;
+
+    Stats run(const ::std::vector<::std::string>& sources) noexcept;
+
+    /**
+     *   `<outDir>/<source directory relative to sourceRoot>/<source
+     * name without extension>.generated.hpp`, made absolute. Sources
+     * outside of the root are generated directly into `outDir`.
+     */
+    [[nodiscard]] static DynString outputPath(const DynString& outDir, const DynString& sourceRoot, const ::std::string& source) noexcept;
+private:
+    [[nodiscard]] Result process(const ::std::string& source, const DynString& outPath) noexcept;
+};
+
+} } }
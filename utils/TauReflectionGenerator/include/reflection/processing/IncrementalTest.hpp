@@ -0,0 +1,15 @@
+#pragma once
+
+namespace tau { namespace reflection { namespace processing {
+
+/**
+ *   Tests output paths, the generator cache and change detection
+ * over synthetic headers written to `dir`. Each failure is
+ * printed.
+ *
+ * @return
+ *      0 if every test passed, 1 otherwise.
+ */
+int runIncrementalTests(const char* dir, unsigned threadCount) noexcept;
+
+} } }
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace tau { namespace reflection { namespace processing {
+
+/**
+ *   Times name lookups through the generated perfect hash
+ * against the chain of strcmp calls it replaced, for classes of
+ * 5 to 200 properties.
+ */
+void runLookupBenchmark() noexcept;
+
+} } }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <NumTypes.hpp>
+#include <String.hpp>
+#include <vector>
+
+namespace tau { namespace reflection { namespace processing {
+
+/**
+ *   The hashes used for name lookups, these must match
+ * `_tauNameHash` and `_tauSlotHash` which the base generator
+ * writes into the base header.
+ *
+ *   The name is only hashed once, 4 bytes at a time, followed
+ * by a finalizer as the tables are indexed by the high bits. The
+ * slot hash remixes that with the seed of the name's bucket.
+ */
+[[nodiscard]] u32 nameHash(const char* str, uSys length) noexcept;
+[[nodiscard]] u32 slotHash(u32 hash, u32 seed) noexcept;
+
+/**
+ *   Maps a hash onto [0, count) with a multiply instead of a
+ * remainder, this must match `_tauReduce`.
+ */
+[[nodiscard]] inline u32 reduceHash(const u32 hash, const u32 count) noexcept
+{ return static_cast<u32>((static_cast<u64>(hash) * count) >> 32); }
+
+/**
+ *   A minimal perfect hash over a set of names, built with
+ * hash and displace. Each name is assigned a bucket by its
+ * hash, then every bucket is given the first seed that moves all
+ * of its names into unused slots. Lookups hash the name once,
+ * remix it with the seed of its bucket and compare against the
+ * single name in the resulting slot.
+ *
+ *   Buckets are placed largest first, with half as many buckets
+ * as names placing the last few singleton buckets only takes a
+ * few thousand attempts for a couple hundred names.
+ */
+class PerfectHash final
+{
+public:
+    static constexpr u32 INVALID_SLOT = 0xFFFFFFFF;
+private:
+    ::std::vector<u32> _seeds;
+    ::std::vector<u32> _slots;
+public:
+    /**
+     *   The names must be unique and their hashes must not
+     * collide, if they do the build falls back to a bucket per
+     * name, which still fails for the colliding pair.
+     */
+    PerfectHash(const ::std::vector<DynString>& names) noexcept;
+
+    [[nodiscard]] uSys bucketCount() const noexcept { return _seeds.size(); }
+    [[nodiscard]] uSys slotCount() const noexcept { return _slots.size(); }
+
+    [[nodiscard]] const ::std::vector<u32>& seeds() const noexcept { return _seeds; }
+
+    /**
+     * The index of the name in each slot.
+     */
+    [[nodiscard]] const ::std::vector<u32>& slots() const noexcept { return _slots; }
+
+    /**
+     * The slot the name would occupy, the caller still has to compare the name.
+     */
+    [[nodiscard]] u32 slot(u32 hash) const noexcept;
+private:
+    bool build(const ::std::vector<DynString>& names, uSys bucketCount) noexcept;
+};
+
+} } }
@@ -20,11 +20,25 @@ private:
     TagDeclQueue& _classTags;
     TagDeclQueue& _propertyTags;
     TagDeclQueue& _functionTags;
+    u64* _tokenHash;
 public:
     TagPreProcessorAction(TagDeclQueue& classTags, TagDeclQueue& propertyTags, TagDeclQueue& functionTags) noexcept
         : _classTags(classTags)
         , _propertyTags(propertyTags)
         , _functionTags(functionTags)
+        , _tokenHash(nullptr)
+    { }
+
+    /**
+     *   Also hashes the preprocessed token stream into tokenHash,
+     * which should be seeded beforehand. Whitespace, comments and
+     * anything removed by the preprocessor don't affect the hash.
+     */
+    TagPreProcessorAction(TagDeclQueue& classTags, TagDeclQueue& propertyTags, TagDeclQueue& functionTags, u64* const tokenHash) noexcept
+        : _classTags(classTags)
+        , _propertyTags(propertyTags)
+        , _functionTags(functionTags)
+        , _tokenHash(tokenHash)
     { }
 protected:
     void ExecuteAction() override;
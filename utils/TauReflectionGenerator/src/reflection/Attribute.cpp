@@ -6,7 +6,7 @@
 namespace tau { namespace reflection {
 
 AttributeManager::AttribHandlerSet AttributeManager::_attributeHandlers;
-AttributeManager::FBAllocator AttributeManager::_attribTreeAllocator(sizeof(TagDeclaration::AttributeSet::Node), 8192);
+thread_local AttributeManager::FBAllocator AttributeManager::_attribTreeAllocator(sizeof(TagDeclaration::AttributeSet::Node), 8192);
 
 const clang::Token* IAttribute::getNextToken(const clang::Token* currentToken) noexcept
 {
@@ -20,12 +20,15 @@ const clang::Token* IAttribute::getNextToken(const clang::Token* currentToken) n
     return nextToken;
 }
 
-Ref<IAttribute> AttributeManager::getAttribute(const DynString& attribName) noexcept
+const Ref<IAttribute>& AttributeManager::getAttribute(const DynString& attribName) noexcept
 {
-    if(_attributeHandlers.count(attribName) == 0)
-    { return nullptr; }
+    static const Ref<IAttribute> null(nullptr);
+
+    const auto handler = _attributeHandlers.find(attribName);
+    if(handler == _attributeHandlers.end())
+    { return null; }
 
-    return _attributeHandlers[attribName];
+    return handler->second;
 }
 
 } }
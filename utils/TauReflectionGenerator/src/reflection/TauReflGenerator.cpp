@@ -5,8 +5,13 @@
 #include "reflection/processing/ReflectionASTWalker.hpp"
 #include "reflection/processing/TagPreProcessor.hpp"
 #include "reflection/processing/HeaderGenerator.hpp"
+#include "reflection/processing/LookupBenchmark.hpp"
+#include "reflection/processing/IncrementalGenerator.hpp"
+#include "reflection/processing/IncrementalBenchmark.hpp"
+#include "reflection/processing/IncrementalTest.hpp"
 #include "reflection/attribs/GetAttribute.hpp"
 #include "reflection/attribs/SetAttribute.hpp"
+#include "reflection/attribs/SerializeAttribute.hpp"
 #include "reflection/attribs/ImplicitAttribute.hpp"
 #include "reflection/attribs/NoListAttribute.hpp"
 
@@ -15,6 +20,9 @@
 #include "codegen/StringTemplateRepairVisitor.hpp"
 #include "codegen/StringTemplateDumpVisitor.hpp"
 #include "codegen/ast/StringTemplateAST.hpp"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
 #include <fstream>
 
 #ifndef TRG_RELEASE
@@ -25,6 +33,13 @@ static ::llvm::cl::OptionCategory tauReflCategory("tau-reflection-generator opti
 
 static ::llvm::cl::opt<::std::string> baseHeaderLoc("base-loc", ::llvm::cl::desc("The path to where the base header should be placed"), ::llvm::cl::cat(tauReflCategory));
 static ::llvm::cl::opt<::std::string> outHeader("o", ::llvm::cl::desc("The path and name of the output file"), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<::std::string> outDir("out-dir", ::llvm::cl::desc("Generate <name>.generated.hpp for each source into this directory, skipping sources that haven't changed"), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<::std::string> sourceRoot("source-root", ::llvm::cl::desc("Outputs of -out-dir mirror the source directories below this one, defaults to the current directory"), ::llvm::cl::init("."), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<::std::string> cacheFile("cache", ::llvm::cl::desc("The cache used by -out-dir, defaults to <out-dir>/.taurefl-cache"), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<unsigned> threadCount("j", ::llvm::cl::desc("The number of threads used by -out-dir, defaults to every hardware thread"), ::llvm::cl::init(0), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<bool> benchLookup("bench-lookup", ::llvm::cl::desc("Time the generated property lookups and exit"), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<::std::string> benchIncremental("bench-incremental", ::llvm::cl::desc("Time incremental runs over 1000 headers written to this directory and exit"), ::llvm::cl::cat(tauReflCategory));
+static ::llvm::cl::opt<::std::string> testIncremental("test-incremental", ::llvm::cl::desc("Test the generator cache and change detection with headers written to this directory and exit"), ::llvm::cl::cat(tauReflCategory));
 
 static void parseTest(::std::istream& file) noexcept;
 static void dumpTokens(::std::istream& file) noexcept;
@@ -45,8 +60,22 @@ int main(int argCount, const char* args[])
     tau::reflection::AttributeManager::registerAttribute<tau::reflection::attribs::NoListAttribute>("nolist");
     tau::reflection::AttributeManager::registerAttribute<tau::reflection::attribs::GetPropertyAttribute>("get");
     tau::reflection::AttributeManager::registerAttribute<tau::reflection::attribs::SetPropertyAttribute>("set");
+    tau::reflection::AttributeManager::registerAttribute<tau::reflection::attribs::SerializeAttribute>("serialize");
 
-    ::clang::tooling::CommonOptionsParser op(argCount, args, tauReflCategory);
+    // Sources are optional so that the benchmark can be run on its own.
+    ::clang::tooling::CommonOptionsParser op(argCount, args, tauReflCategory, ::llvm::cl::ZeroOrMore);
+
+    if(benchLookup)
+    {
+        tau::reflection::processing::runLookupBenchmark();
+        return 0;
+    }
+
+    if(!benchIncremental.getValue().empty())
+    { return tau::reflection::processing::runIncrementalBenchmark(benchIncremental.getValue().c_str(), threadCount.getValue()); }
+
+    if(!testIncremental.getValue().empty())
+    { return tau::reflection::processing::runIncrementalTests(testIncremental.getValue().c_str(), threadCount.getValue()); }
 
     if(!baseHeaderLoc.getValue().empty())
     {
@@ -58,20 +87,54 @@ int main(int argCount, const char* args[])
 
         pathBuilder.append("Base.hpp");
 
-        tau::reflection::processing::BaseGenerator baseGen(pathBuilder.toString());
+        ::std::string base;
+        ::llvm::raw_string_ostream stream(base);
+        tau::reflection::processing::BaseGenerator baseGen(stream);
         baseGen.generate();
+        stream.flush();
+
+        if(!tau::reflection::processing::writeIfChanged(pathBuilder.toString(), base))
+        {
+            ::llvm::errs() << "Failed to write " << pathBuilder.toString().c_str() << ".\n";
+            return 1;
+        }
+    }
+
+    if(!outDir.getValue().empty())
+    {
+        DynString cachePath(cacheFile.getValue().c_str());
+        if(cacheFile.getValue().empty())
+        {
+            ::llvm::SmallString<256> path(outDir.getValue());
+            ::llvm::sys::path::append(path, ".taurefl-cache");
+            cachePath = DynString(path.c_str());
+        }
+
+        tau::reflection::processing::IncrementalGenerator generator(op.getCompilations(), DynString(outDir.getValue().c_str()), DynString(sourceRoot.getValue().c_str()), cachePath, threadCount.getValue());
+        const tau::reflection::processing::IncrementalGenerator::Stats stats = generator.run(op.getSourcePathList());
+
+        ::llvm::outs() << stats.written << " written, " << stats.unchanged << " unchanged, " << stats.cached << " cached, " << stats.failed << " failed.\n";
+        return stats.failed ? 1 : 0;
     }
 
     if(outHeader.getValue().empty())
     { return 0; }
 
+    ::llvm::SmallString<256> absOutPath(outHeader.getValue());
+    (void) ::llvm::sys::fs::make_absolute(absOutPath);
+    const DynString outPath(absOutPath.c_str());
+
+    ::std::string dummy;
     {
-        tau::reflection::processing::HeaderGenerator headerGen(outHeader.getValue().c_str());
+        ::llvm::raw_string_ostream stream(dummy);
+        tau::reflection::processing::HeaderGenerator headerGen(stream);
         headerGen.generateBegin();
         headerGen.generateDummy();
     }
 
     ::clang::tooling::ClangTool tool(op.getCompilations(), op.getSourcePathList());
+    // Parse against the dummy in memory, the output on disk is only replaced if it changes.
+    tool.mapVirtualFile(absOutPath, dummy);
 
     tau::reflection::TagDeclQueue classTags;
     tau::reflection::TagDeclQueue propertyTags;
@@ -87,12 +150,21 @@ int main(int argCount, const char* args[])
     { return result; }
 
     {
-        tau::reflection::processing::HeaderGenerator headerGen(outHeader.getValue().c_str());
+        ::std::string generated;
+        ::llvm::raw_string_ostream stream(generated);
+        tau::reflection::processing::HeaderGenerator headerGen(stream);
         headerGen.generateBegin();
         for(const auto& clazz : classes)
         {
             headerGen.generateClassBody(clazz);
         }
+        stream.flush();
+
+        if(!tau::reflection::processing::writeIfChanged(outPath, generated))
+        {
+            ::llvm::errs() << "Failed to write " << outPath.c_str() << ".\n";
+            return 1;
+        }
     }
 
     return result;
@@ -4,6 +4,19 @@
 
 namespace tau { namespace reflection { namespace attribs {
 
+/**
+ * Classes without any are given an empty getter, which must not name the object.
+ */
+static bool hasGetProperty(const Ref<Class>& clazz) noexcept
+{
+    for(const Ref<Property>& property : clazz->properties())
+    {
+        if(property->declaration()->hasAttribute("get"))
+        { return true; }
+    }
+    return false;
+}
+
 AttributeData GetPropertyAttribute::parseAttribute(const DynString& attribName, const ::clang::MacroArgs*, const ::clang::Token*& currentToken) const noexcept
 {
     currentToken = getNextToken(currentToken);
@@ -11,7 +24,7 @@ AttributeData GetPropertyAttribute::parseAttribute(const DynString& attribName,
     return AttributeData(this, nullptr, attribName);
 }
 
-void GetPropertyAttribute::generateBaseTauClass(::llvm::raw_fd_ostream& base) const noexcept
+void GetPropertyAttribute::generateBaseTauClass(::llvm::raw_ostream& base) const noexcept
 {
     base << 
         "public:\n"
@@ -27,7 +40,7 @@ void GetPropertyAttribute::generateBaseTauClass(::llvm::raw_fd_ostream& base) co
         "    [[nodiscard]] virtual const void* _getProperty(const void* object, unsigned propIndex) const noexcept = 0;\n";
 }
 
-void GetPropertyAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, const Ref<Class>& clazz) const noexcept
+void GetPropertyAttribute::generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept
 {
     base << 
         "        public:                                                                                                                                \\\n"
@@ -46,24 +59,18 @@ void GetPropertyAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, co
         "            { return getPropertyImpl(reinterpret_cast<const " << clazz->name() << "*>(object), propIndex); }                                   \\\n"
         "                                                                                                                                               \\\n"
         "            [[nodiscard]] const void* getPropertyImpl(const " << clazz->name() << "* const object, const char* const propName) const noexcept  \\\n"
+        "            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \\\n"
+        "                                                                                                                                               \\\n"
+        "            [[nodiscard]] const void* getPropertyImpl(const " << clazz->name() << "* const object, const unsigned propIndex) const noexcept    \\\n"
         "            {                                                                                                                                  \\\n";
 
-    for(uSys i = 0; i < clazz->properties().size(); ++i)
+    if(!hasGetProperty(clazz))
     {
-        if(!clazz->properties()[i]->declaration()->hasAttribute("get"))
-        { continue; }
-
         base <<
-            "                if(::std::strcmp(propName, \"" << clazz->properties()[i]->name() << "\") == 0) \\\n"
-            "                { return &object->" << clazz->properties()[i]->name() << "; }                  \\\n";
+            "                (void) object;                                                                                                                 \\\n";
     }
 
-    base << 
-        "                return nullptr;                                                                                                                \\\n"
-        "            }                                                                                                                                  \\\n"
-        "                                                                                                                                               \\\n"
-        "            [[nodiscard]] const void* getPropertyImpl(const " << clazz->name() << "* const object, const unsigned propIndex) const noexcept    \\\n"
-        "            {                                                                                                                                  \\\n"
+    base <<
         "                switch(propIndex)                                                                                                              \\\n"
         "                {                                                                                                                              \\\n";
     
@@ -1,6 +1,7 @@
 #include <llvm/Support/raw_ostream.h>
 #include "reflection/attribs/ImplicitAttribute.hpp"
 #include "reflection/Class.hpp"
+#include "reflection/processing/PerfectHash.hpp"
 
 namespace tau { namespace reflection { namespace attribs { 
 
@@ -11,7 +12,7 @@ AttributeData ImplicitAttribute::parseAttribute(const DynString& attribName, con
     return AttributeData(this, nullptr, attribName);
 }
 
-void ImplicitAttribute::generateBaseTauClass(::llvm::raw_fd_ostream& base) const noexcept
+void ImplicitAttribute::generateBaseTauClass(::llvm::raw_ostream& base) const noexcept
 {
     base <<
         "public:\n"
@@ -21,7 +22,7 @@ void ImplicitAttribute::generateBaseTauClass(::llvm::raw_fd_ostream& base) const
         "    [[nodiscard]] virtual unsigned getFunctionIndex(const char* funcName) const noexcept = 0;\n";
 }
 
-void ImplicitAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, const Ref<Class>& clazz) const noexcept
+void ImplicitAttribute::generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept
 {
     base <<
         "        public:                                                                                            \\\n"
@@ -88,26 +89,19 @@ void ImplicitAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, const
         "            }                                                                                              \\\n"
         "                                                                                                           \\\n"
         "            [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \\\n"
+        "            {                                                                                              \\\n"
+        "                const unsigned index = propertyIndexImpl(propName);                                        \\\n"
+        "                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \\\n"
+        "            }                                                                                              \\\n"
+        "                                                                                                           \\\n"
+        "            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \\\n"
         "            {                                                                                              \\\n";
 
-    uSys propIndex = 0;
-
-    for(uSys i = 0; i < clazz->properties().size(); ++i)
+    if(!funcCount)
     {
-        if(clazz->properties()[i]->declaration()->hasAttribute("nolist"))
-        { continue; }
-
         base <<
-            "                if(::std::strcmp(propName, \"" << clazz->properties()[i]->name() << "\") == 0)         \\\n"
-            "                { return " << propIndex++ << "; }                                                      \\\n";
+            "                (void) funcName;                                                                           \\\n";
     }
-
-    base <<
-        "                return static_cast<unsigned>(-1);                                                          \\\n"
-        "            }                                                                                              \\\n"
-        "                                                                                                           \\\n"
-        "            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \\\n"
-        "            {                                                                                              \\\n";
     
     uSys funcIndex = 0;
 
@@ -125,6 +119,125 @@ void ImplicitAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, const
         "                return static_cast<unsigned>(-1);                                                          \\\n"
         "            }                                                                                              \\\n";
 
+    generatePropertyLookup(base, clazz);
+}
+
+/**
+ *   Property names are resolved with a minimal perfect hash
+ * built here, so a lookup is two hashes of the name, a length
+ * check and a single memcmp regardless of the property count.
+ *
+ *   The tables are in slot order, `PropertyIndex` is constexpr
+ * so callers can resolve names at compile time and access
+ * properties by index, `propertyIndexImpl` is the runtime form.
+ * Both return the index used by `getProperty` and `setProperty`,
+ * `_propertyListIndices` maps those to the `getProperties` list.
+ */
+void ImplicitAttribute::generatePropertyLookup(::llvm::raw_ostream& base, const Ref<Class>& clazz) noexcept
+{
+    const PropertyList& properties = clazz->properties();
+
+    if(properties.empty())
+    {
+        base <<
+            "        public:                                                                                            \\\n"
+            "            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const) noexcept              \\\n"
+            "            { return static_cast<unsigned>(-1); }                                                          \\\n"
+            "                                                                                                           \\\n"
+            "            [[nodiscard]] static unsigned propertyIndexImpl(const char* const) noexcept                    \\\n"
+            "            { return static_cast<unsigned>(-1); }                                                          \\\n"
+            "        private:                                                                                           \\\n"
+            "            static constexpr unsigned _propertyListIndices[1] = { static_cast<unsigned>(-1) };             \\\n";
+        return;
+    }
+
+    ::std::vector<DynString> names;
+    names.reserve(properties.size());
+    for(const auto& property : properties)
+    { names.push_back(property->name()); }
+
+    const processing::PerfectHash hash(names);
+
+    // The tables are in slot order, or declaration order if the hash couldn't be built.
+    const bool hashed = hash.slotCount() != 0;
+    const auto nameAt = [&](const uSys i) noexcept -> const DynString& { return names[hashed ? hash.slots()[i] : i]; };
+
+    base <<
+        "        private:                                                                                           \\\n"
+        "            static constexpr const char* _propertyNames[" << names.size() << "] = {";
+    for(uSys i = 0; i < names.size(); ++i)
+    { base << (i ? ", " : " ") << "\"" << nameAt(i) << "\""; }
+    base << " }; \\\n"
+        "            static constexpr unsigned _propertyLengths[" << names.size() << "] = {";
+    for(uSys i = 0; i < names.size(); ++i)
+    { base << (i ? ", " : " ") << nameAt(i).length(); }
+    base << " }; \\\n"
+        "            static constexpr unsigned _propertyListIndices[" << names.size() << "] = {";
+
+    uSys listIndex = 0;
+    for(uSys i = 0; i < properties.size(); ++i)
+    {
+        base << (i ? ", " : " ");
+        if(properties[i]->declaration()->hasAttribute("nolist"))
+        { base << "static_cast<unsigned>(-1)"; }
+        else
+        { base << listIndex++; }
+    }
+    base << " }; \\\n";
+
+    if(!hashed)
+    {
+        base <<
+            "        public:                                                                                            \\\n"
+            "            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \\\n"
+            "            {                                                                                              \\\n"
+            "                const unsigned length = _tauNameLength(propName);                                          \\\n"
+            "                for(unsigned i = 0; i < " << names.size() << "u; ++i)                                      \\\n"
+            "                {                                                                                          \\\n"
+            "                    if(length == _propertyLengths[i] && _tauNameEquals(propName, _propertyNames[i], length)) \\\n"
+            "                    { return i; }                                                                          \\\n"
+            "                }                                                                                          \\\n"
+            "                return static_cast<unsigned>(-1);                                                          \\\n"
+            "            }                                                                                              \\\n"
+            "                                                                                                           \\\n"
+            "            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \\\n"
+            "            { return PropertyIndex(propName); }                                                            \\\n";
+        return;
+    }
+
+    base <<
+        "            static constexpr unsigned _propertySeeds[" << hash.bucketCount() << "] = {";
+    for(uSys i = 0; i < hash.bucketCount(); ++i)
+    { base << (i ? ", " : " ") << hash.seeds()[i] << "u"; }
+    base << " }; \\\n"
+        "            static constexpr unsigned _propertyIndices[" << hash.slotCount() << "] = {";
+    for(uSys i = 0; i < hash.slotCount(); ++i)
+    { base << (i ? ", " : " ") << hash.slots()[i]; }
+    base << " }; \\\n"
+        "                                                                                                           \\\n"
+        "            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \\\n"
+        "            {                                                                                              \\\n"
+        "                const unsigned hash = _tauNameHash(propName, length);                                      \\\n"
+        "                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, " << hash.bucketCount() << "u)]), " << hash.slotCount() << "u); \\\n"
+        "            }                                                                                              \\\n"
+        "        public:                                                                                            \\\n"
+        "            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \\\n"
+        "            {                                                                                              \\\n"
+        "                const unsigned length = _tauNameLength(propName);                                          \\\n"
+        "                const unsigned slot = _propertySlot(propName, length);                                     \\\n"
+        "                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \\\n"
+        "                { return static_cast<unsigned>(-1); }                                                      \\\n"
+        "                return _propertyIndices[slot];                                                             \\\n"
+        "            }                                                                                              \\\n"
+        "                                                                                                           \\\n"
+        "            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \\\n"
+        "            {                                                                                              \\\n"
+        "                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \\\n"
+        "                const unsigned slot = _propertySlot(propName, length);                                     \\\n"
+        "                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \\\n"
+        "                { return static_cast<unsigned>(-1); }                                                      \\\n"
+        "                return _propertyIndices[slot];                                                             \\\n"
+        "            }                                                                                              \\\n";
 }
 
 } } }
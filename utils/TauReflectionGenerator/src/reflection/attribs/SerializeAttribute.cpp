@@ -0,0 +1,488 @@
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/Format.h>
+#include "reflection/attribs/SerializeAttribute.hpp"
+#include "reflection/processing/PerfectHash.hpp"
+#include "reflection/Class.hpp"
+#include <vector>
+
+namespace tau { namespace reflection { namespace attribs {
+
+namespace {
+
+/**
+ *   A run of properties that is either copied as one block or,
+ * for a single property that isn't trivially copyable, written
+ * through TauSerializer.
+ */
+struct SerialRun final
+{
+    uSys first;
+    uSys count;
+    bool copy;
+};
+
+}
+
+static ::std::vector<Ref<Property>> serializedProperties(const Ref<Class>& clazz) noexcept;
+static ::std::vector<SerialRun> serialRuns(const ::std::vector<Ref<Property>>& properties) noexcept;
+
+static u32 propertyNameHash(const Ref<Property>& property) noexcept
+{ return processing::nameHash(property->name().c_str(), property->name().length()); }
+
+static u32 propertyTypeHash(const Ref<Property>& property) noexcept
+{ return processing::nameHash(property->typeName().c_str(), property->typeName().length()); }
+
+AttributeData SerializeAttribute::parseAttribute(const DynString& attribName, const ::clang::MacroArgs*, const ::clang::Token*& currentToken) const noexcept
+{
+    currentToken = getNextToken(currentToken);
+
+    return AttributeData(this, nullptr, attribName);
+}
+
+void SerializeAttribute::generateBaseHeader(::llvm::raw_ostream& base) const noexcept
+{
+    base <<
+        "#include <cstring>\n"
+        "#include <type_traits>\n"
+        "\n"
+        "/**\n"
+        " *   A serialized object is this header, a field for every\n"
+        " * serialized property, then the property data. Everything is\n"
+        " * in native byte order and may be unaligned.\n"
+        " */\n"
+        "struct TauSerialHeader final\n"
+        "{\n"
+        "    unsigned magic;\n"
+        "    unsigned schema;\n"
+        "    unsigned fieldCount;\n"
+        "    unsigned size;\n"
+        "};\n"
+        "\n"
+        "/**\n"
+        " * The offset is relative to the start of the property data.\n"
+        " */\n"
+        "struct TauSerialField final\n"
+        "{\n"
+        "    unsigned nameHash;\n"
+        "    unsigned typeHash;\n"
+        "    unsigned offset;\n"
+        "    unsigned size;\n"
+        "};\n"
+        "\n"
+        "constexpr unsigned TAU_SERIAL_MAGIC = 0x53554154u;\n"
+        "constexpr unsigned TAU_SERIAL_HEADER_SIZE = static_cast<unsigned>(sizeof(TauSerialHeader));\n"
+        "constexpr unsigned TAU_SERIAL_FIELD_SIZE = static_cast<unsigned>(sizeof(TauSerialField));\n"
+        "\n"
+        "[[nodiscard]] constexpr unsigned _tauSchemaHash(const unsigned schema, const unsigned nameHash, const unsigned typeHash, const unsigned size, const unsigned offset) noexcept\n"
+        "{ return _tauSlotHash(_tauSlotHash(_tauSlotHash(_tauSlotHash(schema, nameHash), typeHash), size), offset); }\n"
+        "\n"
+        "[[nodiscard]] constexpr bool _tauSerialInBounds(const unsigned offset, const unsigned size, const unsigned dataSize) noexcept\n"
+        "{ return offset <= dataSize && size <= dataSize - offset; }\n"
+        "\n"
+        "/**\n"
+        " * The distance from the start of a block to the end of one of its members.\n"
+        " */\n"
+        "[[nodiscard]] inline unsigned _tauSerialSpan(const void* const first, const void* const member, const ::std::size_t size) noexcept\n"
+        "{ return static_cast<unsigned>(static_cast<const unsigned char*>(member) - static_cast<const unsigned char*>(first) + size); }\n"
+        "\n"
+        "inline void _tauWriteSerialField(unsigned char* const table, const unsigned index, const unsigned nameHash, const unsigned typeHash, const unsigned offset, const unsigned size) noexcept\n"
+        "{\n"
+        "    const TauSerialField field { nameHash, typeHash, offset, size };\n"
+        "    ::std::memcpy(table + index * TAU_SERIAL_FIELD_SIZE, &field, TAU_SERIAL_FIELD_SIZE);\n"
+        "}\n"
+        "\n"
+        "[[nodiscard]] inline TauSerialField _tauReadSerialField(const unsigned char* const table, const unsigned index) noexcept\n"
+        "{\n"
+        "    TauSerialField field;\n"
+        "    ::std::memcpy(&field, table + index * TAU_SERIAL_FIELD_SIZE, TAU_SERIAL_FIELD_SIZE);\n"
+        "    return field;\n"
+        "}\n"
+        "\n"
+        "[[nodiscard]] inline bool _tauReadSerialHeader(TauSerialHeader& header, const void* const buffer, const unsigned size) noexcept\n"
+        "{\n"
+        "    if(size < TAU_SERIAL_HEADER_SIZE)\n"
+        "    { return false; }\n"
+        "\n"
+        "    ::std::memcpy(&header, buffer, TAU_SERIAL_HEADER_SIZE);\n"
+        "    return header.magic == TAU_SERIAL_MAGIC && header.size <= size && header.size >= TAU_SERIAL_HEADER_SIZE &&\n"
+        "           header.fieldCount <= (header.size - TAU_SERIAL_HEADER_SIZE) / TAU_SERIAL_FIELD_SIZE;\n"
+        "}\n"
+        "\n"
+        "/**\n"
+        " * Properties whose size changed are skipped.\n"
+        " */\n"
+        "inline void _tauReadSerialCopy(void* const value, const ::std::size_t size, const unsigned char* const data, const TauSerialField& field) noexcept\n"
+        "{\n"
+        "    if(field.size == size)\n"
+        "    { ::std::memcpy(value, data + field.offset, size); }\n"
+        "}\n"
+        "\n"
+        "/**\n"
+        " *   Serializes a property that isn't part of a copied block.\n"
+        " * Specialize this for any other types, `read` is given exactly\n"
+        " * the bytes `write` produced.\n"
+        " */\n"
+        "template<typename _T, typename = void>\n"
+        "struct TauSerializer final\n"
+        "{\n"
+        "    static_assert(::std::is_trivially_copyable<_T>::value, \"TauSerializer must be specialized for types that aren't trivially copyable or reflected.\");\n"
+        "    static_assert(!::std::is_pointer<_T>::value, \"Pointers can't be serialized.\");\n"
+        "\n"
+        "    [[nodiscard]] static unsigned size(const _T&) noexcept\n"
+        "    { return static_cast<unsigned>(sizeof(_T)); }\n"
+        "\n"
+        "    static void write(const _T& value, unsigned char* const buffer) noexcept\n"
+        "    { ::std::memcpy(buffer, &value, sizeof(_T)); }\n"
+        "\n"
+        "    [[nodiscard]] static bool read(_T& value, const unsigned char* const buffer, const unsigned size) noexcept\n"
+        "    {\n"
+        "        if(size != sizeof(_T))\n"
+        "        { return false; }\n"
+        "        ::std::memcpy(&value, buffer, sizeof(_T));\n"
+        "        return true;\n"
+        "    }\n"
+        "};\n"
+        "\n"
+        "template<typename _T>\n"
+        "struct TauSerializer<_T, ::std::void_t<typename _T::TauClassImpl>> final\n"
+        "{\n"
+        "    [[nodiscard]] static unsigned size(const _T& value) noexcept\n"
+        "    { return _T::GetStaticClass().serialSize(&value); }\n"
+        "\n"
+        "    static void write(const _T& value, unsigned char* const buffer) noexcept\n"
+        "    { (void) _T::GetStaticClass().serialize(&value, buffer, size(value)); }\n"
+        "\n"
+        "    [[nodiscard]] static bool read(_T& value, const unsigned char* const buffer, const unsigned size) noexcept\n"
+        "    { return _T::GetStaticClass().deserialize(&value, buffer, size) != 0; }\n"
+        "};\n"
+        "\n";
+}
+
+void SerializeAttribute::generateBaseTauClass(::llvm::raw_ostream& base) const noexcept
+{
+    base <<
+        "public:\n"
+        "    [[nodiscard]] unsigned serialSize(const void* const object) const noexcept\n"
+        "    { return _serialSize(object); }\n"
+        "\n"
+        "    /**\n"
+        "     * Returns the number of bytes written, or 0 if the buffer is too small.\n"
+        "     */\n"
+        "    unsigned serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept\n"
+        "    { return _serialize(object, buffer, capacity); }\n"
+        "\n"
+        "    /**\n"
+        "     *   Returns the number of bytes read, or 0 if the buffer is\n"
+        "     * malformed. The buffer is read in place, it can be memory\n"
+        "     * mapped.\n"
+        "     */\n"
+        "    unsigned deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept\n"
+        "    { return _deserialize(object, buffer, size); }\n"
+        "protected:\n"
+        "    [[nodiscard]] virtual unsigned _serialSize(const void* object) const noexcept = 0;\n"
+        "    virtual unsigned _serialize(const void* object, void* buffer, unsigned capacity) const noexcept = 0;\n"
+        "    virtual unsigned _deserialize(void* object, const void* buffer, unsigned size) const noexcept = 0;\n";
+}
+
+static void generateEmptySerializer(::llvm::raw_ostream& base, const Ref<Class>& clazz) noexcept;
+static void generateSerialize(::llvm::raw_ostream& base, const Ref<Class>& clazz, const ::std::vector<Ref<Property>>& properties, const ::std::vector<SerialRun>& runs) noexcept;
+static void generateDeserialize(::llvm::raw_ostream& base, const Ref<Class>& clazz, const ::std::vector<Ref<Property>>& properties, const ::std::vector<SerialRun>& runs) noexcept;
+
+void SerializeAttribute::generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept
+{
+    base <<
+        "        public:                                                                                                                                \\\n"
+        "            [[nodiscard]] unsigned serialSize(const " << clazz->name() << "* const object) const noexcept                                      \\\n"
+        "            { return serialSizeImpl(object); }                                                                                                 \\\n"
+        "                                                                                                                                               \\\n"
+        "            unsigned serialize(const " << clazz->name() << "* const object, void* const buffer, const unsigned capacity) const noexcept         \\\n"
+        "            { return serializeImpl(object, buffer, capacity); }                                                                                \\\n"
+        "                                                                                                                                               \\\n"
+        "            unsigned deserialize(" << clazz->name() << "* const object, const void* const buffer, const unsigned size) const noexcept           \\\n"
+        "            { return deserializeImpl(object, buffer, size); }                                                                                  \\\n"
+        "        protected:                                                                                                                             \\\n"
+        "            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \\\n"
+        "            { return serialSizeImpl(reinterpret_cast<const " << clazz->name() << "*>(object)); }                                               \\\n"
+        "                                                                                                                                               \\\n"
+        "            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \\\n"
+        "            { return serializeImpl(reinterpret_cast<const " << clazz->name() << "*>(object), buffer, capacity); }                              \\\n"
+        "                                                                                                                                               \\\n"
+        "            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \\\n"
+        "            { return deserializeImpl(reinterpret_cast<" << clazz->name() << "*>(object), buffer, size); }                                      \\\n"
+        "        private:                                                                                                                               \\\n";
+
+    const ::std::vector<Ref<Property>> properties = serializedProperties(clazz);
+
+    if(properties.empty())
+    {
+        generateEmptySerializer(base, clazz);
+        return;
+    }
+
+    const ::std::vector<SerialRun> runs = serialRuns(properties);
+
+    base <<
+        "            [[nodiscard]] static unsigned serialSchema(const " << clazz->name() << "* const object) noexcept                                   \\\n"
+        "            {                                                                                                                                  \\\n"
+        "                unsigned schema = " << properties.size() << "u; \\\n";
+
+    for(const SerialRun& run : runs)
+    {
+        const DynString& first = properties[run.first]->name();
+        for(uSys i = run.first; i < run.first + run.count; ++i)
+        {
+            const Ref<Property>& property = properties[i];
+            base << "                schema = _tauSchemaHash(schema, " << ::llvm::format_hex(propertyNameHash(property), 10) << "u, " << ::llvm::format_hex(propertyTypeHash(property), 10) << "u, ";
+            if(run.copy)
+            { base << "static_cast<unsigned>(sizeof(object->" << property->name() << ")), _tauSerialSpan(&object->" << first << ", &object->" << property->name() << ", 0)); \\\n"; }
+            else
+            { base << "0xFFFFFFFFu, 0xFFFFFFFFu); \\\n"; }
+        }
+    }
+
+    base <<
+        "                return schema;                                                                                                                 \\\n"
+        "            }                                                                                                                                  \\\n"
+        "                                                                                                                                               \\\n"
+        "            [[nodiscard]] static unsigned serialSizeImpl(const " << clazz->name() << "* const object) noexcept                                 \\\n"
+        "            {                                                                                                                                  \\\n"
+        "                unsigned size = TAU_SERIAL_HEADER_SIZE + " << properties.size() << "u * TAU_SERIAL_FIELD_SIZE; \\\n";
+
+    for(const SerialRun& run : runs)
+    {
+        const DynString& first = properties[run.first]->name();
+        const DynString& last = properties[run.first + run.count - 1]->name();
+        if(run.copy)
+        { base << "                size += _tauSerialSpan(&object->" << first << ", &object->" << last << ", sizeof(object->" << last << ")); \\\n"; }
+        else
+        { base << "                size += TauSerializer<decltype(object->" << first << ")>::size(object->" << first << "); \\\n"; }
+    }
+
+    base <<
+        "                return size;                                                                                                                   \\\n"
+        "            }                                                                                                                                  \\\n"
+        "                                                                                                                                               \\\n";
+
+    generateSerialize(base, clazz, properties, runs);
+    generateDeserialize(base, clazz, properties, runs);
+}
+
+static void generateEmptySerializer(::llvm::raw_ostream& base, const Ref<Class>& clazz) noexcept
+{
+    base <<
+        "            [[nodiscard]] static unsigned serialSizeImpl(const " << clazz->name() << "* const) noexcept                                        \\\n"
+        "            { return TAU_SERIAL_HEADER_SIZE; }                                                                                                 \\\n"
+        "                                                                                                                                               \\\n"
+        "            static unsigned serializeImpl(const " << clazz->name() << "* const, void* const buffer, const unsigned capacity) noexcept           \\\n"
+        "            {                                                                                                                                  \\\n"
+        "                if(capacity < TAU_SERIAL_HEADER_SIZE)                                                                                          \\\n"
+        "                { return 0; }                                                                                                                  \\\n"
+        "                const TauSerialHeader header { TAU_SERIAL_MAGIC, 0, 0, TAU_SERIAL_HEADER_SIZE };                                               \\\n"
+        "                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \\\n"
+        "                return TAU_SERIAL_HEADER_SIZE;                                                                                                 \\\n"
+        "            }                                                                                                                                  \\\n"
+        "                                                                                                                                               \\\n"
+        "            static unsigned deserializeImpl(" << clazz->name() << "* const, const void* const buffer, const unsigned size) noexcept             \\\n"
+        "            {                                                                                                                                  \\\n"
+        "                TauSerialHeader header;                                                                                                        \\\n"
+        "                return _tauReadSerialHeader(header, buffer, size) ? header.size : 0;                                                           \\\n"
+        "            }                                                                                                                                  \\\n";
+}
+
+static void generateSerialize(::llvm::raw_ostream& base, const Ref<Class>& clazz, const ::std::vector<Ref<Property>>& properties, const ::std::vector<SerialRun>& runs) noexcept
+{
+    base <<
+        "            static unsigned serializeImpl(const " << clazz->name() << "* const object, void* const buffer, const unsigned capacity) noexcept    \\\n"
+        "            {                                                                                                                                  \\\n";
+
+    for(const Ref<Property>& property : properties)
+    {
+        base << "                static_assert(!::std::is_pointer<decltype(object->" << property->name() << ")>::value, \"Pointers can't be serialized.\"); \\\n";
+    }
+
+    base <<
+        "                const unsigned size = serialSizeImpl(object);                                                                                  \\\n"
+        "                if(size > capacity)                                                                                                            \\\n"
+        "                { return 0; }                                                                                                                  \\\n"
+        "                                                                                                                                               \\\n"
+        "                const TauSerialHeader header { TAU_SERIAL_MAGIC, serialSchema(object), " << properties.size() << "u, size }; \\\n"
+        "                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \\\n"
+        "                                                                                                                                               \\\n"
+        "                unsigned char* const table = static_cast<unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                                     \\\n"
+        "                unsigned char* const data = table + " << properties.size() << "u * TAU_SERIAL_FIELD_SIZE; \\\n"
+        "                unsigned offset = 0;                                                                                                           \\\n";
+
+    for(const SerialRun& run : runs)
+    {
+        const DynString& first = properties[run.first]->name();
+        const DynString& last = properties[run.first + run.count - 1]->name();
+
+        base << "                                                                                                                                               \\\n";
+
+        if(run.copy)
+        {
+            for(uSys i = run.first; i < run.first + run.count; ++i)
+            {
+                const Ref<Property>& property = properties[i];
+                base << "                _tauWriteSerialField(table, " << i << ", " << ::llvm::format_hex(propertyNameHash(property), 10) << "u, " << ::llvm::format_hex(propertyTypeHash(property), 10) << "u, "
+                        "offset + _tauSerialSpan(&object->" << first << ", &object->" << property->name() << ", 0), static_cast<unsigned>(sizeof(object->" << property->name() << "))); \\\n";
+            }
+
+            base <<
+                "                {                                                                                                                              \\\n"
+                "                    const unsigned span = _tauSerialSpan(&object->" << first << ", &object->" << last << ", sizeof(object->" << last << ")); \\\n"
+                "                    ::std::memcpy(data + offset, &object->" << first << ", span);                                                              \\\n"
+                "                    offset += span;                                                                                                            \\\n"
+                "                }                                                                                                                              \\\n";
+        }
+        else
+        {
+            base <<
+                "                {                                                                                                                              \\\n"
+                "                    const unsigned fieldSize = TauSerializer<decltype(object->" << first << ")>::size(object->" << first << "); \\\n"
+                "                    _tauWriteSerialField(table, " << run.first << ", " << ::llvm::format_hex(propertyNameHash(properties[run.first]), 10) << "u, " << ::llvm::format_hex(propertyTypeHash(properties[run.first]), 10) << "u, offset, fieldSize); \\\n"
+                "                    TauSerializer<decltype(object->" << first << ")>::write(object->" << first << ", data + offset);                           \\\n"
+                "                    offset += fieldSize;                                                                                                       \\\n"
+                "                }                                                                                                                              \\\n";
+        }
+    }
+
+    base <<
+        "                                                                                                                                               \\\n"
+        "                return size;                                                                                                                   \\\n"
+        "            }                                                                                                                                  \\\n"
+        "                                                                                                                                               \\\n";
+}
+
+static void generateDeserialize(::llvm::raw_ostream& base, const Ref<Class>& clazz, const ::std::vector<Ref<Property>>& properties, const ::std::vector<SerialRun>& runs) noexcept
+{
+    base <<
+        "            static unsigned deserializeImpl(" << clazz->name() << "* const object, const void* const buffer, const unsigned size) noexcept      \\\n"
+        "            {                                                                                                                                  \\\n"
+        "                TauSerialHeader header;                                                                                                        \\\n"
+        "                if(!_tauReadSerialHeader(header, buffer, size))                                                                                \\\n"
+        "                { return 0; }                                                                                                                  \\\n"
+        "                                                                                                                                               \\\n"
+        "                const unsigned char* const table = static_cast<const unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                         \\\n"
+        "                const unsigned char* const data = table + header.fieldCount * TAU_SERIAL_FIELD_SIZE;                                           \\\n"
+        "                const unsigned dataSize = header.size - TAU_SERIAL_HEADER_SIZE - header.fieldCount * TAU_SERIAL_FIELD_SIZE;                    \\\n"
+        "                                                                                                                                               \\\n"
+        "                if(header.schema == serialSchema(object) && header.fieldCount == " << properties.size() << "u) \\\n"
+        "                {                                                                                                                              \\\n"
+        "                    TauSerialField field;                                                                                                      \\\n";
+
+    for(const SerialRun& run : runs)
+    {
+        const DynString& first = properties[run.first]->name();
+        const DynString& last = properties[run.first + run.count - 1]->name();
+
+        base <<
+            "                    field = _tauReadSerialField(table, " << run.first << "); \\\n";
+
+        if(run.copy)
+        {
+            base <<
+                "                    {                                                                                                                          \\\n"
+                "                        const unsigned span = _tauSerialSpan(&object->" << first << ", &object->" << last << ", sizeof(object->" << last << ")); \\\n"
+                "                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \\\n"
+                "                        { return 0; }                                                                                                          \\\n"
+                "                        ::std::memcpy(&object->" << first << ", data + field.offset, span);                                                    \\\n"
+                "                    }                                                                                                                          \\\n";
+        }
+        else
+        {
+            base <<
+                "                    if(!_tauSerialInBounds(field.offset, field.size, dataSize) ||                                                              \\\n"
+                "                       !TauSerializer<decltype(object->" << first << ")>::read(object->" << first << ", data + field.offset, field.size))      \\\n"
+                "                    { return 0; }                                                                                                              \\\n";
+        }
+    }
+
+    base <<
+        "                    return header.size;                                                                                                        \\\n"
+        "                }                                                                                                                              \\\n"
+        "                                                                                                                                               \\\n"
+        "                for(unsigned i = 0; i < header.fieldCount; ++i)                                                                                \\\n"
+        "                {                                                                                                                              \\\n"
+        "                    const TauSerialField field = _tauReadSerialField(table, i);                                                                \\\n"
+        "                    if(!_tauSerialInBounds(field.offset, field.size, dataSize))                                                                \\\n"
+        "                    { return 0; }                                                                                                              \\\n"
+        "                                                                                                                                               \\\n"
+        "                    switch(field.nameHash)                                                                                                     \\\n"
+        "                    {                                                                                                                          \\\n";
+
+    for(const SerialRun& run : runs)
+    {
+        for(uSys i = run.first; i < run.first + run.count; ++i)
+        {
+            const Ref<Property>& property = properties[i];
+
+            base <<
+                "                        case " << ::llvm::format_hex(propertyNameHash(property), 10) << "u: \\\n"
+                "                            if(field.typeHash == " << ::llvm::format_hex(propertyTypeHash(property), 10) << "u) \\\n";
+
+            if(run.copy)
+            {
+                base << "                            { _tauReadSerialCopy(&object->" << property->name() << ", sizeof(object->" << property->name() << "), data, field); } \\\n";
+            }
+            else
+            {
+                base <<
+                    "                            {                                                                                                                  \\\n"
+                    "                                if(!TauSerializer<decltype(object->" << property->name() << ")>::read(object->" << property->name() << ", data + field.offset, field.size)) \\\n"
+                    "                                { return 0; }                                                                                                  \\\n"
+                    "                            }                                                                                                                  \\\n";
+            }
+
+            base <<
+                "                            break;                                                                                                             \\\n";
+        }
+    }
+
+    base <<
+        "                        default: break;                                                                                                        \\\n"
+        "                    }                                                                                                                          \\\n"
+        "                }                                                                                                                              \\\n"
+        "                return header.size;                                                                                                            \\\n"
+        "            }                                                                                                                                  \\\n";
+}
+
+static ::std::vector<Ref<Property>> serializedProperties(const Ref<Class>& clazz) noexcept
+{
+    ::std::vector<Ref<Property>> properties;
+    for(const Ref<Property>& property : clazz->properties())
+    {
+        if(property->declaration()->hasAttribute("serialize"))
+        { properties.push_back(property); }
+    }
+    return properties;
+}
+
+/**
+ *   Properties are only merged into a block when nothing else
+ * lies between them, and only while the access is the same as
+ * the order of fields with different access is unspecified.
+ */
+static ::std::vector<SerialRun> serialRuns(const ::std::vector<Ref<Property>>& properties) noexcept
+{
+    ::std::vector<SerialRun> runs;
+    for(uSys i = 0; i < properties.size(); ++i)
+    {
+        const Ref<Property>& property = properties[i];
+
+        if(property->triviallyCopyable() && !runs.empty() && runs.back().copy)
+        {
+            const Ref<Property>& prev = properties[i - 1];
+            if(prev->fieldIndex() + 1 == property->fieldIndex() && prev->access() == property->access())
+            {
+                ++runs.back().count;
+                continue;
+            }
+        }
+
+        runs.push_back({ i, 1, property->triviallyCopyable() });
+    }
+    return runs;
+}
+
+} } }
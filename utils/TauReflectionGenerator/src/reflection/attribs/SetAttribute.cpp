@@ -4,6 +4,20 @@
 
 namespace tau { namespace reflection { namespace attribs {
 
+/**
+ *   Classes without any are given empty accessors, which must
+ * not name their parameters.
+ */
+static bool hasSetProperty(const Ref<Class>& clazz, const bool get) noexcept
+{
+    for(const Ref<Property>& property : clazz->properties())
+    {
+        if(property->declaration()->hasAttribute("set") && (!get || property->declaration()->hasAttribute("get")))
+        { return true; }
+    }
+    return false;
+}
+
 AttributeData SetPropertyAttribute::parseAttribute(const DynString& attribName, const ::clang::MacroArgs*, const ::clang::Token*& currentToken) const noexcept
 {
     currentToken = getNextToken(currentToken);
@@ -11,7 +25,7 @@ AttributeData SetPropertyAttribute::parseAttribute(const DynString& attribName,
     return AttributeData(this, nullptr, attribName);
 }
 
-void SetPropertyAttribute::generateBaseTauClass(::llvm::raw_fd_ostream& base) const noexcept
+void SetPropertyAttribute::generateBaseTauClass(::llvm::raw_ostream& base) const noexcept
 {
     base << 
         "public:\n"
@@ -37,7 +51,7 @@ void SetPropertyAttribute::generateBaseTauClass(::llvm::raw_fd_ostream& base) co
         "    virtual void _setProperty(void* object, const unsigned propIndex, const void* value) const noexcept = 0;\n";
 }
 
-void SetPropertyAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, const Ref<Class>& clazz) const noexcept
+void SetPropertyAttribute::generateImplTauClass(::llvm::raw_ostream& base, const Ref<Class>& clazz) const noexcept
 {
     base << 
         "        public:                                                                                                                                \\\n"
@@ -70,24 +84,18 @@ void SetPropertyAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, co
         "            { return setPropertyImpl(reinterpret_cast<" << clazz->name() << "*>(object), propIndex, value); }                                  \\\n"
         "                                                                                                                                               \\\n"
         "            [[nodiscard]] void* getPropertyImpl(" << clazz->name() << "* const object, const char* const propName) const noexcept              \\\n"
+        "            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \\\n"
+        "                                                                                                                                               \\\n"
+        "            [[nodiscard]] void* getPropertyImpl(" << clazz->name() << "* const object, const unsigned propIndex) const noexcept                \\\n"
         "            {                                                                                                                                  \\\n";
 
-    for(uSys i = 0; i < clazz->properties().size(); ++i)
+    if(!hasSetProperty(clazz, true))
     {
-        if(!clazz->properties()[i]->declaration()->hasAttribute("get") || !clazz->properties()[i]->declaration()->hasAttribute("set"))
-        { continue; }
-
         base <<
-            "                if(::std::strcmp(propName, \"" << clazz->properties()[i]->name() << "\") == 0) \\\n"
-            "                { return &object->" << clazz->properties()[i]->name() << "; }                  \\\n";
+            "                (void) object;                                                                                                                 \\\n";
     }
 
-    base << 
-        "                return nullptr;                                                                                                                \\\n"
-        "            }                                                                                                                                  \\\n"
-        "                                                                                                                                               \\\n"
-        "            [[nodiscard]] void* getPropertyImpl(" << clazz->name() << "* const object, const unsigned propIndex) const noexcept                \\\n"
-        "            {                                                                                                                                  \\\n"
+    base <<
         "                switch(propIndex)                                                                                                              \\\n"
         "                {                                                                                                                              \\\n";
     
@@ -106,23 +114,19 @@ void SetPropertyAttribute::generateImplTauClass(::llvm::raw_fd_ostream& base, co
         "            }                                                                                                                                  \\\n"
         "                                                                                                                                               \\\n"
         "            void setPropertyImpl(" << clazz->name() << "* const object, const char* const propName, const void* const value) const noexcept    \\\n"
+        "            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \\\n"
+        "                                                                                                                                               \\\n"
+        "            void setPropertyImpl(" << clazz->name() << "* const object, const unsigned propIndex, const void* const value) const noexcept      \\\n"
         "            {                                                                                                                                  \\\n";
-    
-    for(uSys i = 0; i < clazz->properties().size(); ++i)
-    {
-        if(!clazz->properties()[i]->declaration()->hasAttribute("set"))
-        { continue; }
 
+    if(!hasSetProperty(clazz, false))
+    {
         base <<
-            "                if(::std::strcmp(propName, \"" << clazz->properties()[i]->name() << "\") == 0)                                                         \\\n"
-            "                { object->" << clazz->properties()[i]->name() << " = *reinterpret_cast<" << clazz->properties()[i]->typeName() << " const*>(value); }  \\\n";
+            "                (void) object;                                                                                                                 \\\n"
+            "                (void) value;                                                                                                                  \\\n";
     }
 
     base <<
-        "            }                                                                                                                                  \\\n"
-        "                                                                                                                                               \\\n"
-        "            void setPropertyImpl(" << clazz->name() << "* const object, const unsigned propIndex, const void* const value) const noexcept      \\\n"
-        "            {                                                                                                                                  \\\n"
         "                switch(propIndex)                                                                                                              \\\n"
         "                {                                                                                                                              \\\n";
 
@@ -1,6 +1,10 @@
 #include "reflection/processing/HeaderGenerator.hpp"
 #include "reflection/Attribute.hpp"
 #include "reflection/Class.hpp"
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <fstream>
+#include <iterator>
 
 namespace tau { namespace reflection { namespace processing { 
 
@@ -8,6 +12,8 @@ void BaseGenerator::generate() noexcept
 {
     printHeaderBegin();
     printBasicMacros();
+    printNameHash();
+    printAttributeHeaders();
     printClass();
 }
 
@@ -29,6 +35,73 @@ void BaseGenerator::printBasicMacros() noexcept
         "\n";
 }
 
+/**
+ *   These have to match processing::nameHash, slotHash and
+ * reduceHash, which built the tables the generated lookups
+ * index.
+ */
+void BaseGenerator::printNameHash() noexcept
+{
+    _header <<
+        "[[nodiscard]] constexpr unsigned _tauFinalizeHash(unsigned hash) noexcept\n"
+        "{\n"
+        "    hash ^= hash >> 16;\n"
+        "    hash *= 0x85EBCA6Bu;\n"
+        "    hash ^= hash >> 13;\n"
+        "    hash *= 0xC2B2AE35u;\n"
+        "    hash ^= hash >> 16;\n"
+        "    return hash;\n"
+        "}\n"
+        "\n"
+        "[[nodiscard]] constexpr unsigned _tauNameHash(const char* const str, const unsigned length) noexcept\n"
+        "{\n"
+        "    unsigned hash = 2166136261u ^ length;\n"
+        "    unsigned i = 0;\n"
+        "    for(; i + 4 <= length; i += 4)\n"
+        "    {\n"
+        "        const unsigned word = static_cast<unsigned char>(str[i]) | (static_cast<unsigned char>(str[i + 1]) << 8) |\n"
+        "                              (static_cast<unsigned char>(str[i + 2]) << 16) | (static_cast<unsigned>(static_cast<unsigned char>(str[i + 3])) << 24);\n"
+        "        hash = (hash ^ word) * 0x9E3779B1u;\n"
+        "    }\n"
+        "    for(; i < length; ++i)\n"
+        "    { hash = (hash ^ static_cast<unsigned char>(str[i])) * 16777619u; }\n"
+        "    return _tauFinalizeHash(hash);\n"
+        "}\n"
+        "\n"
+        "[[nodiscard]] constexpr unsigned _tauSlotHash(const unsigned hash, const unsigned seed) noexcept\n"
+        "{ return _tauFinalizeHash(hash ^ (seed * 0x9E3779B9u)); }\n"
+        "\n"
+        "[[nodiscard]] constexpr unsigned _tauReduce(const unsigned hash, const unsigned count) noexcept\n"
+        "{ return static_cast<unsigned>((static_cast<unsigned long long>(hash) * count) >> 32); }\n"
+        "\n"
+        "[[nodiscard]] constexpr unsigned _tauNameLength(const char* const str) noexcept\n"
+        "{\n"
+        "    unsigned length = 0;\n"
+        "    while(str[length])\n"
+        "    { ++length; }\n"
+        "    return length;\n"
+        "}\n"
+        "\n"
+        "[[nodiscard]] constexpr bool _tauNameEquals(const char* const a, const char* const b, const unsigned length) noexcept\n"
+        "{\n"
+        "    for(unsigned i = 0; i < length; ++i)\n"
+        "    {\n"
+        "        if(a[i] != b[i])\n"
+        "        { return false; }\n"
+        "    }\n"
+        "    return true;\n"
+        "}\n"
+        "\n";
+}
+
+void BaseGenerator::printAttributeHeaders() noexcept
+{
+    for(const auto& handler : AttributeManager::getAttributes())
+    {
+        handler.second->generateBaseHeader(_header);
+    }
+}
+
 void BaseGenerator::printClass() noexcept
 {
     _header << 
@@ -150,4 +223,37 @@ void HeaderGenerator::printDummyMacros() noexcept
         "#define TAU_GENERATED_BODY(_CLASS) \n";
 }
 
+bool writeIfChanged(const DynString& path, const ::llvm::StringRef contents, bool* const changed) noexcept
+{
+    {
+        ::std::ifstream existing(path.c_str(), ::std::ios::binary);
+        if(existing)
+        {
+            const ::std::string current((::std::istreambuf_iterator<char>(existing)), ::std::istreambuf_iterator<char>());
+            if(current.size() == contents.size() && ::llvm::StringRef(current) == contents)
+            {
+                if(changed)
+                { *changed = false; }
+                return true;
+            }
+        }
+    }
+
+    if(changed)
+    { *changed = true; }
+
+    const ::llvm::StringRef parent = ::llvm::sys::path::parent_path(::llvm::StringRef(path.c_str(), path.length()));
+    if(!parent.empty() && ::llvm::sys::fs::create_directories(parent))
+    { return false; }
+
+    ::std::error_code ec;
+    ::llvm::raw_fd_ostream file(::llvm::StringRef(path.c_str(), path.length()), ec);
+    if(ec)
+    { return false; }
+
+    file << contents;
+    file.close();
+    return !file.has_error();
+}
+
 } } }
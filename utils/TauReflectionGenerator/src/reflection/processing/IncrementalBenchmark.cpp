@@ -0,0 +1,163 @@
+#include "reflection/processing/IncrementalBenchmark.hpp"
+#include "reflection/processing/IncrementalGenerator.hpp"
+#include "reflection/processing/HeaderGenerator.hpp"
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace tau { namespace reflection { namespace processing {
+
+static constexpr uSys HEADER_COUNT = 1000;
+static constexpr uSys EDIT_COUNT = 10;
+
+static ::std::string headerPath(const ::llvm::StringRef dir, const uSys index) noexcept
+{
+    ::llvm::SmallString<256> path(dir);
+    ::llvm::sys::path::append(path, "Header" + ::llvm::Twine(index) + ".hpp");
+    return path.str().str();
+}
+
+/**
+ * `revision` is the initial value of `_id`, so changing it changes the token stream.
+ */
+static ::std::string makeHeader(const uSys index, const uSys revision) noexcept
+{
+    ::std::string contents;
+    ::llvm::raw_string_ostream stream(contents);
+
+    stream << "#pragma once\n"
+              "\n"
+              "#include \"Base.hpp\"\n"
+              "#include \"Header" << index << ".generated.hpp\"\n"
+              "\n"
+              "TAU_CLASS()\n"
+              "class Header" << index << "\n"
+              "{\n"
+              "    TAU_GENERATED_BODY(Header" << index << ")\n"
+              "private:\n"
+              "    TAU_PROPERTY(get, set, serialize)\n"
+              "    int _id = " << revision << ";\n"
+              "    TAU_PROPERTY(get, set, serialize)\n"
+              "    float _x;\n"
+              "    TAU_PROPERTY(get, set, serialize)\n"
+              "    float _y;\n"
+              "    TAU_PROPERTY(get, set, serialize)\n"
+              "    float _z;\n"
+              "    TAU_PROPERTY(get)\n"
+              "    unsigned _flags;\n"
+              "    TAU_PROPERTY(nolist)\n"
+              "    double _weight;\n"
+              "};\n";
+
+    stream.flush();
+    return contents;
+}
+
+int runIncrementalBenchmark(const char* const dir, unsigned threadCount) noexcept
+{
+    if(!threadCount)
+    { threadCount = ::std::max(1u, ::std::thread::hardware_concurrency()); }
+
+    if(::llvm::sys::fs::create_directories(dir))
+    {
+        ::llvm::errs() << "Failed to create " << dir << ".\n";
+        return 1;
+    }
+
+    ::llvm::SmallString<256> absDir(dir);
+    (void) ::llvm::sys::fs::make_absolute(absDir);
+
+    {
+        ::llvm::SmallString<256> basePath(absDir);
+        ::llvm::sys::path::append(basePath, "Base.hpp");
+        ::std::string base;
+        ::llvm::raw_string_ostream stream(base);
+        BaseGenerator baseGen(stream);
+        baseGen.generate();
+        stream.flush();
+        if(!writeIfChanged(DynString(basePath.c_str()), base))
+        {
+            ::llvm::errs() << "Failed to write " << basePath << ".\n";
+            return 1;
+        }
+    }
+
+    ::std::vector<::std::string> sources;
+    sources.reserve(HEADER_COUNT);
+    for(uSys i = 0; i < HEADER_COUNT; ++i)
+    {
+        sources.push_back(headerPath(absDir, i));
+        if(!writeIfChanged(DynString(sources.back().c_str()), makeHeader(i, 0)))
+        {
+            ::llvm::errs() << "Failed to write " << sources.back() << ".\n";
+            return 1;
+        }
+    }
+
+    const ::std::string include = "-I" + absDir.str().str();
+    const ::clang::tooling::FixedCompilationDatabase compilations(absDir, { "-std=c++17", "-xc++", include });
+
+    ::llvm::SmallString<256> cachePath(absDir);
+    ::llvm::sys::path::append(cachePath, ".taurefl-cache");
+    const DynString outDir(absDir.c_str());
+    const DynString cache(cachePath.c_str());
+
+    const auto clean = [&]()
+    {
+        (void) ::llvm::sys::fs::remove(cachePath);
+        for(const ::std::string& source : sources)
+        {
+            const DynString output = IncrementalGenerator::outputPath(outDir, outDir, source);
+            (void) ::llvm::sys::fs::remove(output.c_str());
+        }
+    };
+
+    const auto timeRun = [&](const char* const name, const unsigned threads)
+    {
+        // Each run loads the cache from disk, as a new build would.
+        IncrementalGenerator generator(compilations, outDir, outDir, cache, threads);
+
+        const auto start = ::std::chrono::high_resolution_clock::now();
+        const IncrementalGenerator::Stats stats = generator.run(sources);
+        const auto end = ::std::chrono::high_resolution_clock::now();
+
+        const double seconds = ::std::chrono::duration<double>(end - start).count();
+        ::llvm::outs() << ::llvm::format("%-24s %8u %9.2f %8zu %10zu %7zu %7zu\n", name, threads, seconds, stats.written, stats.unchanged, stats.cached, stats.failed);
+        return stats.failed;
+    };
+
+    ::llvm::outs() << HEADER_COUNT << " headers in " << absDir << ".\n";
+    ::llvm::outs() << ::llvm::format("%-24s %8s %9s %8s %10s %7s %7s\n", "run", "threads", "seconds", "written", "unchanged", "cached", "failed");
+
+    uSys failed = 0;
+
+    clean();
+    failed += timeRun("cold", 1);
+    clean();
+    failed += timeRun("cold", threadCount);
+    failed += timeRun("warm, no changes", threadCount);
+
+    for(uSys i = 0; i < EDIT_COUNT; ++i)
+    {
+        const uSys index = i * (HEADER_COUNT / EDIT_COUNT);
+        (void) writeIfChanged(DynString(sources[index].c_str()), makeHeader(index, 1));
+    }
+    failed += timeRun("warm, 10 edited", threadCount);
+
+    // Put the edits back so that the benchmark can be run again.
+    for(uSys i = 0; i < EDIT_COUNT; ++i)
+    {
+        const uSys index = i * (HEADER_COUNT / EDIT_COUNT);
+        (void) writeIfChanged(DynString(sources[index].c_str()), makeHeader(index, 0));
+    }
+
+    return failed ? 1 : 0;
+}
+
+} } }
@@ -0,0 +1,221 @@
+#include "reflection/processing/IncrementalGenerator.hpp"
+#include "reflection/processing/FrontendFactoryHelper.hpp"
+#include "reflection/processing/ReflectionASTWalker.hpp"
+#include "reflection/processing/TagPreProcessor.hpp"
+#include "reflection/processing/HeaderGenerator.hpp"
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+namespace tau { namespace reflection { namespace processing {
+
+GeneratorCache::GeneratorCache(const DynString& path) noexcept
+    : _path(path)
+    , _dirty(false)
+{
+    ::std::ifstream file(path.c_str());
+    ::std::string line;
+    while(::std::getline(file, line))
+    {
+        u64 hash;
+        int pathStart;
+        if(::std::sscanf(line.c_str(), "%" SCNx64 " %n", &hash, &pathStart) == 1 && line.length() > static_cast<uSys>(pathStart))
+        { _hashes[line.substr(pathStart)] = hash; }
+    }
+}
+
+bool GeneratorCache::matches(const ::std::string& source, const u64 hash) noexcept
+{
+    ::std::lock_guard<::std::mutex> lock(_mutex);
+    const auto entry = _hashes.find(source);
+    return entry != _hashes.end() && entry->second == hash;
+}
+
+void GeneratorCache::update(const ::std::string& source, const u64 hash) noexcept
+{
+    ::std::lock_guard<::std::mutex> lock(_mutex);
+    u64& entry = _hashes[source];
+    if(entry != hash)
+    {
+        entry = hash;
+        _dirty = true;
+    }
+}
+
+void GeneratorCache::remove(const ::std::string& source) noexcept
+{
+    ::std::lock_guard<::std::mutex> lock(_mutex);
+    if(_hashes.erase(source))
+    { _dirty = true; }
+}
+
+bool GeneratorCache::save() noexcept
+{
+    ::std::lock_guard<::std::mutex> lock(_mutex);
+    if(!_dirty)
+    { return true; }
+
+    ::std::string contents;
+    {
+        ::llvm::raw_string_ostream stream(contents);
+        for(const auto& entry : _hashes)
+        { stream << ::llvm::format_hex_no_prefix(entry.second, 16) << ' ' << entry.first << '\n'; }
+    }
+
+    _dirty = !writeIfChanged(_path, contents);
+    return !_dirty;
+}
+
+IncrementalGenerator::IncrementalGenerator(const ::clang::tooling::CompilationDatabase& compilations, const DynString& outDir, const DynString& sourceRoot, const DynString& cachePath, const unsigned threadCount) noexcept
+    : _compilations(compilations)
+    , _outDir(outDir)
+    , _sourceRoot(sourceRoot)
+    , _cache(cachePath)
+    , _threadCount(threadCount ? threadCount : ::std::thread::hardware_concurrency())
+{
+    ::llvm::raw_string_ostream stream(_dummyHeader);
+    HeaderGenerator headerGen(stream);
+    headerGen.generateDummy();
+    stream.flush();
+}
+
+IncrementalGenerator::Stats IncrementalGenerator::run(const ::std::vector<::std::string>& sources) noexcept
+{
+    ::std::atomic<uSys> next(0);
+    ::std::atomic<uSys> counts[4] = { { 0 }, { 0 }, { 0 }, { 0 } };
+
+    ::std::vector<DynString> outputs;
+    outputs.reserve(sources.size());
+    ::std::unordered_map<::std::string, uSys> owners;
+    ::std::vector<bool> conflicts(sources.size(), false);
+    for(uSys i = 0; i < sources.size(); ++i)
+    {
+        outputs.push_back(outputPath(_outDir, _sourceRoot, sources[i]));
+
+        const auto owner = owners.emplace(outputs.back().c_str(), i);
+        if(!owner.second)
+        {
+            ::llvm::errs() << sources[owner.first->second] << " and " << sources[i] << " both generate " << outputs.back().c_str() << ".\n";
+            conflicts[owner.first->second] = true;
+            conflicts[i] = true;
+        }
+    }
+
+    const auto worker = [&]()
+    {
+        for(uSys i = next++; i < sources.size(); i = next++)
+        {
+            if(conflicts[i])
+            {
+                _cache.remove(sources[i]);
+                ++counts[static_cast<uSys>(Result::Failed)];
+                continue;
+            }
+
+            ++counts[static_cast<uSys>(process(sources[i], outputs[i]))];
+        }
+    };
+
+    const uSys threadCount = ::std::max<uSys>(1, ::std::min<uSys>(_threadCount, sources.size()));
+
+    // The calling thread is one of the workers.
+    ::std::vector<::std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for(uSys i = 1; i < threadCount; ++i)
+    { threads.emplace_back(worker); }
+    worker();
+    for(::std::thread& thread : threads)
+    { thread.join(); }
+
+    (void) _cache.save();
+
+    return {
+        counts[static_cast<uSys>(Result::Written)],
+        counts[static_cast<uSys>(Result::Unchanged)],
+        counts[static_cast<uSys>(Result::Cached)],
+        counts[static_cast<uSys>(Result::Failed)]
+    };
+}
+
+DynString IncrementalGenerator::outputPath(const DynString& outDir, const DynString& sourceRoot, const ::std::string& source) noexcept
+{
+    ::llvm::SmallString<256> root(::llvm::StringRef(sourceRoot.c_str(), sourceRoot.length()));
+    (void) ::llvm::sys::fs::make_absolute(root);
+    ::llvm::sys::path::remove_dots(root, true);
+
+    ::llvm::SmallString<256> sourceDir(::llvm::sys::path::parent_path(source));
+    (void) ::llvm::sys::fs::make_absolute(sourceDir);
+    ::llvm::sys::path::remove_dots(sourceDir, true);
+
+    ::llvm::SmallString<256> path(::llvm::StringRef(outDir.c_str(), outDir.length()));
+
+    // Only whole directories match, a root of "src" doesn't contain "src2".
+    const ::llvm::StringRef dir(sourceDir);
+    if(dir.startswith(root) && (dir.size() == root.size() || ::llvm::sys::path::is_separator(root.back()) || ::llvm::sys::path::is_separator(dir[root.size()])))
+    { ::llvm::sys::path::append(path, ::llvm::sys::path::relative_path(dir.substr(root.size()))); }
+
+    ::llvm::sys::path::append(path, ::llvm::sys::path::stem(source) + ".generated.hpp");
+    (void) ::llvm::sys::fs::make_absolute(path);
+    return DynString(path.c_str());
+}
+
+IncrementalGenerator::Result IncrementalGenerator::process(const ::std::string& source, const DynString& outPath) noexcept
+{
+    ::clang::tooling::ClangTool tool(_compilations, { source });
+    tool.mapVirtualFile(::llvm::StringRef(outPath.c_str(), outPath.length()), _dummyHeader);
+
+    TagDeclQueue classTags;
+    TagDeclQueue propertyTags;
+    TagDeclQueue functionTags;
+    ClassList classes;
+
+    u64 hash = (14695981039346656037ull ^ GENERATOR_VERSION) * 1099511628211ull;
+
+    if(tool.run(::clang::helperExt::newFrontendActionFactory<TagPreProcessorAction>(classTags, propertyTags, functionTags, &hash).get()))
+    {
+        _cache.remove(source);
+        return Result::Failed;
+    }
+
+    if(_cache.matches(source, hash) && ::llvm::sys::fs::exists(outPath.c_str()))
+    { return Result::Cached; }
+
+    if(tool.run(::clang::helperExt::newFrontendActionFactory<ReflectionASTWalkerAction>(classTags, propertyTags, functionTags, classes).get()))
+    {
+        _cache.remove(source);
+        return Result::Failed;
+    }
+
+    ::std::string contents;
+    {
+        ::llvm::raw_string_ostream stream(contents);
+        HeaderGenerator headerGen(stream);
+        headerGen.generateBegin();
+        for(const auto& clazz : classes)
+        {
+            headerGen.generateClassBody(clazz);
+        }
+    }
+
+    bool changed;
+    if(!writeIfChanged(outPath, contents, &changed))
+    {
+        _cache.remove(source);
+        return Result::Failed;
+    }
+
+    _cache.update(source, hash);
+    return changed ? Result::Written : Result::Unchanged;
+}
+
+} } }
@@ -0,0 +1,254 @@
+#include "reflection/processing/IncrementalTest.hpp"
+#include "reflection/processing/IncrementalGenerator.hpp"
+#include "reflection/processing/HeaderGenerator.hpp"
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+#include <fstream>
+
+namespace tau { namespace reflection { namespace processing {
+
+static constexpr uSys HEADER_COUNT = 8;
+
+static void check(const bool condition, const ::llvm::Twine& description, uSys& failures) noexcept
+{
+    if(!condition)
+    {
+        ::llvm::errs() << "FAILED: " << description << "\n";
+        ++failures;
+    }
+}
+
+static ::std::string joinPath(const ::llvm::StringRef dir, const ::llvm::Twine& a, const ::llvm::Twine& b = "", const ::llvm::Twine& c = "") noexcept
+{
+    ::llvm::SmallString<256> path(dir);
+    ::llvm::sys::path::append(path, a, b, c);
+    return path.str().str();
+}
+
+static ::std::string readFile(const ::std::string& path) noexcept
+{
+    ::std::ifstream file(path, ::std::ios::binary);
+    return ::std::string((::std::istreambuf_iterator<char>(file)), ::std::istreambuf_iterator<char>());
+}
+
+/**
+ *   `revision` only changes a default value, which changes the
+ * token stream but not the generated header. `comment` changes
+ * neither, `extraProperty` changes both.
+ */
+static ::std::string makeHeader(const ::llvm::StringRef className, const uSys revision, const bool comment, const bool extraProperty) noexcept
+{
+    ::std::string contents;
+    ::llvm::raw_string_ostream stream(contents);
+
+    stream << "#pragma once\n"
+              "\n"
+              "#include \"Base.hpp\"\n"
+              "#include \"" << ::llvm::sys::path::stem(className) << ".generated.hpp\"\n"
+              "\n";
+    if(comment)
+    { stream << "// An edit that only touches a comment.\n"; }
+    stream << "TAU_CLASS()\n"
+              "class " << className << "\n"
+              "{\n"
+              "    TAU_GENERATED_BODY(" << className << ")\n"
+              "private:\n"
+              "    TAU_PROPERTY(get, set, serialize)\n"
+              "    int _id = " << revision << ";\n"
+              "    TAU_PROPERTY(get)\n"
+              "    float _x;\n";
+    if(extraProperty)
+    {
+        stream << "    TAU_PROPERTY(get, set)\n"
+                  "    float _y;\n";
+    }
+    stream << "};\n";
+
+    stream.flush();
+    return contents;
+}
+
+static void testOutputPath(const ::llvm::StringRef dir, uSys& failures) noexcept
+{
+    const DynString outDir(joinPath(dir, "out").c_str());
+    const DynString root(joinPath(dir, "src").c_str());
+
+    const auto expectOutput = [&](const ::std::string& source, const ::std::string& expected)
+    {
+        const DynString output = IncrementalGenerator::outputPath(outDir, root, source);
+        check(::llvm::StringRef(output.c_str()) == expected, "outputPath(" + source + ") is " + output.c_str() + ", expected " + expected, failures);
+    };
+
+    expectOutput(joinPath(dir, "src", "Foo.hpp"), joinPath(dir, "out", "Foo.generated.hpp"));
+    expectOutput(joinPath(dir, "src", "a", "Foo.hpp"), joinPath(dir, "out", "a", "Foo.generated.hpp"));
+    expectOutput(joinPath(dir, "src", "b", "Foo.hpp"), joinPath(dir, "out", "b", "Foo.generated.hpp"));
+    expectOutput(joinPath(dir, "src", "a/../b", "Foo.hpp"), joinPath(dir, "out", "b", "Foo.generated.hpp"));
+
+    // Outside of the root, including a directory that only shares the root's name as a prefix.
+    expectOutput(joinPath(dir, "src2", "Foo.hpp"), joinPath(dir, "out", "Foo.generated.hpp"));
+    expectOutput(joinPath(dir, "Foo.hpp"), joinPath(dir, "out", "Foo.generated.hpp"));
+}
+
+static void testCache(const ::llvm::StringRef dir, uSys& failures) noexcept
+{
+    const ::std::string path = joinPath(dir, ".cache-test");
+    (void) ::llvm::sys::fs::remove(path);
+    const DynString cachePath(path.c_str());
+
+    {
+        GeneratorCache cache(cachePath);
+        check(!cache.matches("a/Foo.hpp", 0), "An empty cache matches nothing", failures);
+        check(cache.save(), "Saving an unchanged cache succeeds", failures);
+        check(!::llvm::sys::fs::exists(path), "An unchanged cache isn't written", failures);
+
+        cache.update("a/Foo.hpp", 0x1234);
+        cache.update("b/Foo.hpp", 0xFFFFFFFFFFFFFFFFull);
+        cache.update("c/With Spaces.hpp", 5);
+        check(cache.matches("a/Foo.hpp", 0x1234), "An updated hash matches", failures);
+        check(cache.save() && ::llvm::sys::fs::exists(path), "A changed cache is written", failures);
+    }
+
+    {
+        GeneratorCache cache(cachePath);
+        check(cache.matches("a/Foo.hpp", 0x1234), "A hash survives saving and loading", failures);
+        check(cache.matches("b/Foo.hpp", 0xFFFFFFFFFFFFFFFFull), "A full width hash survives saving and loading", failures);
+        check(cache.matches("c/With Spaces.hpp", 5), "A path with spaces survives saving and loading", failures);
+        check(!cache.matches("a/Foo.hpp", 0x1235), "A different hash doesn't match", failures);
+        check(!cache.matches("d/Foo.hpp", 0x1234), "An unknown source doesn't match", failures);
+
+        cache.remove("c/With Spaces.hpp");
+        check(cache.save(), "Saving after a removal succeeds", failures);
+    }
+
+    {
+        ::std::ofstream file(path, ::std::ios::app);
+        file << "not a hash\n";
+    }
+
+    {
+        GeneratorCache cache(cachePath);
+        check(!cache.matches("c/With Spaces.hpp", 5), "A removed source stays removed", failures);
+        check(cache.matches("a/Foo.hpp", 0x1234), "Malformed lines don't affect the rest of the cache", failures);
+    }
+
+    (void) ::llvm::sys::fs::remove(path);
+}
+
+static void testChangeDetection(const ::llvm::StringRef dir, const unsigned threadCount, uSys& failures) noexcept
+{
+    {
+        ::std::string base;
+        ::llvm::raw_string_ostream stream(base);
+        BaseGenerator baseGen(stream);
+        baseGen.generate();
+        stream.flush();
+        check(writeIfChanged(DynString(joinPath(dir, "Base.hpp").c_str()), base), "Writing Base.hpp", failures);
+    }
+
+    ::std::vector<::std::string> sources;
+    ::std::vector<::std::string> outputs;
+    for(uSys i = 0; i < HEADER_COUNT; ++i)
+    {
+        const ::std::string name = "Changed" + ::std::to_string(i);
+        sources.push_back(joinPath(dir, name + ".hpp"));
+        outputs.push_back(joinPath(dir, name + ".generated.hpp"));
+        (void) ::llvm::sys::fs::remove(outputs.back());
+        check(writeIfChanged(DynString(sources.back().c_str()), makeHeader(name, 0, false, false)), "Writing " + sources.back(), failures);
+    }
+
+    const ::std::string include = "-I" + dir.str();
+    const ::clang::tooling::FixedCompilationDatabase compilations(dir, { "-std=c++17", "-xc++", include });
+    const DynString outDir(dir.str().c_str());
+    const ::std::string cachePath = joinPath(dir, ".taurefl-cache");
+    (void) ::llvm::sys::fs::remove(cachePath);
+
+    const auto expectRun = [&](const char* const name, const ::std::vector<::std::string>& runSources, const DynString& root, const uSys written, const uSys unchanged, const uSys cached, const uSys failed)
+    {
+        // Each run loads the cache from disk, as a new build would.
+        IncrementalGenerator generator(compilations, outDir, root, DynString(cachePath.c_str()), threadCount);
+        const IncrementalGenerator::Stats stats = generator.run(runSources);
+
+        ::std::string actual;
+        ::llvm::raw_string_ostream stream(actual);
+        stream << stats.written << " written, " << stats.unchanged << " unchanged, " << stats.cached << " cached, " << stats.failed << " failed";
+        stream.flush();
+
+        check(stats.written == written && stats.unchanged == unchanged && stats.cached == cached && stats.failed == failed, ::llvm::Twine(name) + ": " + actual, failures);
+    };
+
+    expectRun("Cold run", sources, outDir, HEADER_COUNT, 0, 0, 0);
+    for(const ::std::string& output : outputs)
+    { check(::llvm::sys::fs::exists(output), output + " was generated", failures); }
+
+    expectRun("Warm run", sources, outDir, 0, 0, HEADER_COUNT, 0);
+
+    (void) writeIfChanged(DynString(sources[0].c_str()), makeHeader("Changed0", 0, true, false));
+    expectRun("Comment edited", sources, outDir, 0, 0, HEADER_COUNT, 0);
+
+    (void) writeIfChanged(DynString(sources[1].c_str()), makeHeader("Changed1", 1, false, false));
+    expectRun("Default value edited", sources, outDir, 0, 1, HEADER_COUNT - 1, 0);
+
+    const ::std::string before = readFile(outputs[2]);
+    (void) writeIfChanged(DynString(sources[2].c_str()), makeHeader("Changed2", 0, false, true));
+    expectRun("Property added", sources, outDir, 1, 0, HEADER_COUNT - 1, 0);
+    check(readFile(outputs[2]) != before && readFile(outputs[2]).find("_y") != ::std::string::npos, "The added property was generated", failures);
+
+    (void) ::llvm::sys::fs::remove(outputs[3]);
+    expectRun("Output removed", sources, outDir, 1, 0, HEADER_COUNT - 1, 0);
+    check(::llvm::sys::fs::exists(outputs[3]), "A removed output is regenerated", failures);
+
+    (void) ::llvm::sys::fs::remove(cachePath);
+    expectRun("Cache removed", sources, outDir, 0, HEADER_COUNT, 0, 0);
+
+    /**
+     *   Two headers named Item.hpp in different directories, each
+     * generated next to itself.
+     */
+    const ::std::vector<::std::string> items = { joinPath(dir, "a", "Item.hpp"), joinPath(dir, "b", "Item.hpp") };
+    const ::std::string itemOutputs[2] = { joinPath(dir, "a", "Item.generated.hpp"), joinPath(dir, "b", "Item.generated.hpp") };
+    (void) ::llvm::sys::fs::remove(itemOutputs[0]);
+    (void) ::llvm::sys::fs::remove(itemOutputs[1]);
+    (void) writeIfChanged(DynString(items[0].c_str()), makeHeader("Item", 0, false, false));
+    (void) writeIfChanged(DynString(items[1].c_str()), makeHeader("Item", 0, false, true));
+
+    expectRun("Same named headers", items, outDir, 2, 0, 0, 0);
+    check(readFile(itemOutputs[0]).find("_y") == ::std::string::npos && readFile(itemOutputs[1]).find("_y") != ::std::string::npos, "Same named headers have their own outputs", failures);
+
+    // With the root at a/ the header in b/ is outside of it and would share the output of the one in a/.
+    const ::std::string itemRoot = joinPath(dir, "a");
+    expectRun("Conflicting outputs", items, DynString(itemRoot.c_str()), 0, 0, 0, 2);
+
+    (void) ::llvm::sys::fs::remove(cachePath);
+}
+
+int runIncrementalTests(const char* const dir, const unsigned threadCount) noexcept
+{
+    if(::llvm::sys::fs::create_directories(dir))
+    {
+        ::llvm::errs() << "Failed to create " << dir << ".\n";
+        return 1;
+    }
+
+    ::llvm::SmallString<256> absDir(dir);
+    (void) ::llvm::sys::fs::make_absolute(absDir);
+    ::llvm::sys::path::remove_dots(absDir, true);
+
+    uSys failures = 0;
+    testOutputPath(absDir, failures);
+    testCache(absDir, failures);
+    testChangeDetection(absDir, threadCount, failures);
+
+    if(failures)
+    {
+        ::llvm::errs() << failures << " incremental tests failed.\n";
+        return 1;
+    }
+
+    ::llvm::outs() << "Incremental tests passed.\n";
+    return 0;
+}
+
+} } }
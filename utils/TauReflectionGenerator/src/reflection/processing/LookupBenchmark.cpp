@@ -0,0 +1,88 @@
+#include "reflection/processing/LookupBenchmark.hpp"
+#include "reflection/processing/PerfectHash.hpp"
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/Format.h>
+#include <chrono>
+#include <cstring>
+
+namespace tau { namespace reflection { namespace processing {
+
+static constexpr uSys LOOKUP_COUNT = 1 << 22;
+
+/**
+ * Names of mixed lengths and shared prefixes, similar to real member names.
+ */
+static ::std::vector<DynString> makeNames(const uSys count) noexcept
+{
+    static const char* const prefixes[] = { "_position", "_rotation", "_scale", "_color", "_enabled", "_name", "_velocity", "_mass" };
+
+    ::std::vector<DynString> names;
+    names.reserve(count);
+    for(uSys i = 0; i < count; ++i)
+    {
+        ::std::string name(prefixes[i % 8]);
+        name += ::std::to_string(i / 8);
+        names.emplace_back(name.c_str());
+    }
+    return names;
+}
+
+template<typename _F>
+static double nsPerLookup(const ::std::vector<DynString>& names, _F lookup) noexcept
+{
+    // Keeps the lookups from being optimized away.
+    volatile u32 sink = 0;
+
+    const auto start = ::std::chrono::high_resolution_clock::now();
+    for(uSys i = 0; i < LOOKUP_COUNT; ++i)
+    { sink = sink + lookup(names[i % names.size()].c_str()); }
+    const auto end = ::std::chrono::high_resolution_clock::now();
+
+    return ::std::chrono::duration<double, ::std::nano>(end - start).count() / static_cast<double>(LOOKUP_COUNT);
+}
+
+void runLookupBenchmark() noexcept
+{
+    static const uSys propertyCounts[] = { 5, 10, 25, 50, 100, 200 };
+
+    ::llvm::outs() << "Nanoseconds per property lookup, " << LOOKUP_COUNT << " lookups.\n";
+    ::llvm::outs() << ::llvm::format("%10s %10s %10s\n", "properties", "strcmp", "hash");
+
+    for(const uSys propertyCount : propertyCounts)
+    {
+        const ::std::vector<DynString> names = makeNames(propertyCount);
+        const PerfectHash hash(names);
+
+        // The tables as the generated code lays them out.
+        ::std::vector<const char*> slotNames(hash.slotCount());
+        ::std::vector<u32> slotLengths(hash.slotCount());
+        for(uSys i = 0; i < hash.slotCount(); ++i)
+        {
+            slotNames[i] = names[hash.slots()[i]].c_str();
+            slotLengths[i] = static_cast<u32>(names[hash.slots()[i]].length());
+        }
+
+        const double strcmpTime = nsPerLookup(names, [&names](const char* const propName) noexcept
+        {
+            for(u32 i = 0; i < names.size(); ++i)
+            {
+                if(::std::strcmp(propName, names[i].c_str()) == 0)
+                { return i; }
+            }
+            return static_cast<u32>(-1);
+        });
+
+        const double hashTime = nsPerLookup(names, [&](const char* const propName) noexcept
+        {
+            const uSys length = ::std::strlen(propName);
+            const u32 slot = hash.slot(nameHash(propName, length));
+            if(length != slotLengths[slot] || ::std::memcmp(propName, slotNames[slot], length) != 0)
+            { return static_cast<u32>(-1); }
+            return hash.slots()[slot];
+        });
+
+        ::llvm::outs() << ::llvm::format("%10u %10.2f %10.2f\n", static_cast<u32>(propertyCount), strcmpTime, hashTime);
+    }
+}
+
+} } }
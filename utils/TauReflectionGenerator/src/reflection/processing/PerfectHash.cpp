@@ -0,0 +1,121 @@
+#include "reflection/processing/PerfectHash.hpp"
+#include <algorithm>
+
+namespace tau { namespace reflection { namespace processing {
+
+/**
+ *   If a bucket can't be placed within this many seeds the
+ * build is restarted with more buckets.
+ */
+static constexpr u32 MAX_SEED_ATTEMPTS = 1 << 20;
+
+static u32 finalize(u32 hash) noexcept
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+u32 nameHash(const char* const str, const uSys length) noexcept
+{
+    const auto byte = [str](const uSys i) noexcept { return static_cast<u32>(static_cast<u8>(str[i])); };
+
+    u32 hash = 2166136261u ^ static_cast<u32>(length);
+    uSys i = 0;
+    for(; i + 4 <= length; i += 4)
+    {
+        const u32 word = byte(i) | (byte(i + 1) << 8) | (byte(i + 2) << 16) | (byte(i + 3) << 24);
+        hash = (hash ^ word) * 0x9E3779B1u;
+    }
+    for(; i < length; ++i)
+    { hash = (hash ^ byte(i)) * 16777619u; }
+    return finalize(hash);
+}
+
+u32 slotHash(const u32 hash, const u32 seed) noexcept
+{ return finalize(hash ^ (seed * 0x9E3779B9u)); }
+
+PerfectHash::PerfectHash(const ::std::vector<DynString>& names) noexcept
+{
+    if(names.empty())
+    { return; }
+
+    uSys bucketCount = (names.size() + 1) / 2;
+    while(!build(names, bucketCount))
+    {
+        if(bucketCount == names.size())
+        {
+            _seeds.clear();
+            _slots.clear();
+            return;
+        }
+        bucketCount = ::std::min(bucketCount * 2, names.size());
+    }
+}
+
+u32 PerfectHash::slot(const u32 hash) const noexcept
+{
+    if(_slots.empty())
+    { return INVALID_SLOT; }
+
+    const u32 bucket = reduceHash(hash, static_cast<u32>(_seeds.size()));
+    return reduceHash(slotHash(hash, _seeds[bucket]), static_cast<u32>(_slots.size()));
+}
+
+bool PerfectHash::build(const ::std::vector<DynString>& names, const uSys bucketCount) noexcept
+{
+    const u32 slotCount = static_cast<u32>(names.size());
+
+    ::std::vector<u32> hashes(slotCount);
+    ::std::vector<::std::vector<u32>> buckets(bucketCount);
+    for(u32 i = 0; i < slotCount; ++i)
+    {
+        hashes[i] = nameHash(names[i].c_str(), names[i].length());
+        buckets[reduceHash(hashes[i], static_cast<u32>(bucketCount))].push_back(i);
+    }
+
+    ::std::vector<u32> order(bucketCount);
+    for(u32 i = 0; i < bucketCount; ++i)
+    { order[i] = i; }
+    ::std::stable_sort(order.begin(), order.end(), [&buckets](const u32 a, const u32 b) { return buckets[a].size() > buckets[b].size(); });
+
+    _seeds.assign(bucketCount, 0);
+    _slots.assign(slotCount, INVALID_SLOT);
+
+    ::std::vector<u32> placed;
+    for(const u32 bucket : order)
+    {
+        if(buckets[bucket].empty())
+        { break; }
+
+        u32 seed = 1;
+        for(; seed < MAX_SEED_ATTEMPTS; ++seed)
+        {
+            placed.clear();
+            for(const u32 name : buckets[bucket])
+            {
+                const u32 slot = reduceHash(slotHash(hashes[name], seed), slotCount);
+                if(_slots[slot] != INVALID_SLOT || ::std::find(placed.begin(), placed.end(), slot) != placed.end())
+                { break; }
+                placed.push_back(slot);
+            }
+
+            if(placed.size() == buckets[bucket].size())
+            { break; }
+        }
+
+        if(seed == MAX_SEED_ATTEMPTS)
+        { return false; }
+
+        _seeds[bucket] = seed;
+        for(uSys i = 0; i < placed.size(); ++i)
+        { _slots[placed[i]] = buckets[bucket][i]; }
+    }
+
+    return true;
+}
+
+} } }
@@ -38,7 +38,10 @@ bool ReflectionASTVisitor::VisitFieldDecl(::clang::FieldDecl* const field) noexc
     if(!_propertyTags.empty() && !validateDoubleTag(tagDecl, _propertyTags.front(), field, TagType::Property))
     { return false; }
 
-    _currentClass->properties().emplace_back(tagDecl, _currentClass, field->getNameAsString().c_str(), field->getType().getAsString().c_str());
+    // Bit fields can't be copied by address.
+    const bool triviallyCopyable = !field->isBitField() && field->getType().isTriviallyCopyableType(*_ctx);
+
+    _currentClass->properties().emplace_back(tagDecl, _currentClass, field->getNameAsString().c_str(), field->getType().getAsString().c_str(), field->getFieldIndex(), field->getAccess(), triviallyCopyable);
 
     return true;
 }
@@ -4,6 +4,7 @@
 #include <clang/Lex/MacroInfo.h>
 #include <clang/Lex/MacroArgs.h>
 #include <clang/Frontend/CompilerInstance.h>
+#include <llvm/ADT/SmallString.h>
 
 namespace tau { namespace reflection { namespace processing { 
 
@@ -20,10 +21,40 @@ void TagPreProcessorAction::ExecuteAction()
     // Start parsing the specified input file.
     pp.EnterMainSourceFile();
 
+    if(!_tokenHash)
+    {
+        do 
+        {
+            pp.Lex(tok);
+        } while(tok.isNot(::clang::tok::eof));
+        return;
+    }
+
+    u64 hash = *_tokenHash;
+    const auto hashBytes = [&hash](const char* const bytes, const uSys length)
+    {
+        // FNV-1a
+        for(uSys i = 0; i < length; ++i)
+        { hash = (hash ^ static_cast<u8>(bytes[i])) * 1099511628211ull; }
+    };
+
+    ::llvm::SmallString<64> spellingBuffer;
     do 
     {
         pp.Lex(tok);
+
+        const u16 kind = static_cast<u16>(tok.getKind());
+        hashBytes(reinterpret_cast<const char*>(&kind), sizeof(kind));
+
+        // Punctuation and keywords are identified by their kind alone.
+        if(tok.is(::clang::tok::identifier) || tok.isLiteral())
+        {
+            const ::llvm::StringRef spelling = pp.getSpelling(tok, spellingBuffer);
+            hashBytes(spelling.data(), spelling.size());
+        }
     } while(tok.isNot(::clang::tok::eof));
+
+    *_tokenHash = hash;
 }
 
 static void reportIncorrectAttribForTag(TagType tagType, const Ref<IAttribute>& attribHandler, const ::clang::Token* token, ::clang::DiagnosticsEngine& diagEngine, unsigned diagID) noexcept;
@@ -83,7 +114,8 @@ void TagPreProcessorCallback::MacroExpands(const clang::Token& MacroNameTok, con
 
         const DynString attribName(token->getIdentifierInfo()->getName().str().c_str());
 
-        Ref<IAttribute> attribHandler = AttributeManager::getAttribute(attribName);
+        // Headers are processed in parallel, the shared handler is only referenced to leave its count alone.
+        const Ref<IAttribute>& attribHandler = AttributeManager::getAttribute(attribName);
 
         // Attribute was not registered.
         if(!attribHandler)
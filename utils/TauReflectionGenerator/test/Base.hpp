@@ -6,6 +6,169 @@
 #define TAU_PROPERTY(...)
 #define TAU_FUNCTION(...)
 
+[[nodiscard]] constexpr unsigned _tauFinalizeHash(unsigned hash) noexcept
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+[[nodiscard]] constexpr unsigned _tauNameHash(const char* const str, const unsigned length) noexcept
+{
+    unsigned hash = 2166136261u ^ length;
+    unsigned i = 0;
+    for(; i + 4 <= length; i += 4)
+    {
+        const unsigned word = static_cast<unsigned char>(str[i]) | (static_cast<unsigned char>(str[i + 1]) << 8) |
+                              (static_cast<unsigned char>(str[i + 2]) << 16) | (static_cast<unsigned>(static_cast<unsigned char>(str[i + 3])) << 24);
+        hash = (hash ^ word) * 0x9E3779B1u;
+    }
+    for(; i < length; ++i)
+    { hash = (hash ^ static_cast<unsigned char>(str[i])) * 16777619u; }
+    return _tauFinalizeHash(hash);
+}
+
+[[nodiscard]] constexpr unsigned _tauSlotHash(const unsigned hash, const unsigned seed) noexcept
+{ return _tauFinalizeHash(hash ^ (seed * 0x9E3779B9u)); }
+
+[[nodiscard]] constexpr unsigned _tauReduce(const unsigned hash, const unsigned count) noexcept
+{ return static_cast<unsigned>((static_cast<unsigned long long>(hash) * count) >> 32); }
+
+[[nodiscard]] constexpr unsigned _tauNameLength(const char* const str) noexcept
+{
+    unsigned length = 0;
+    while(str[length])
+    { ++length; }
+    return length;
+}
+
+[[nodiscard]] constexpr bool _tauNameEquals(const char* const a, const char* const b, const unsigned length) noexcept
+{
+    for(unsigned i = 0; i < length; ++i)
+    {
+        if(a[i] != b[i])
+        { return false; }
+    }
+    return true;
+}
+
+#include <cstring>
+#include <type_traits>
+
+/**
+ *   A serialized object is this header, a field for every
+ * serialized property, then the property data. Everything is
+ * in native byte order and may be unaligned.
+ */
+struct TauSerialHeader final
+{
+    unsigned magic;
+    unsigned schema;
+    unsigned fieldCount;
+    unsigned size;
+};
+
+/**
+ * The offset is relative to the start of the property data.
+ */
+struct TauSerialField final
+{
+    unsigned nameHash;
+    unsigned typeHash;
+    unsigned offset;
+    unsigned size;
+};
+
+constexpr unsigned TAU_SERIAL_MAGIC = 0x53554154u;
+constexpr unsigned TAU_SERIAL_HEADER_SIZE = static_cast<unsigned>(sizeof(TauSerialHeader));
+constexpr unsigned TAU_SERIAL_FIELD_SIZE = static_cast<unsigned>(sizeof(TauSerialField));
+
+[[nodiscard]] constexpr unsigned _tauSchemaHash(const unsigned schema, const unsigned nameHash, const unsigned typeHash, const unsigned size, const unsigned offset) noexcept
+{ return _tauSlotHash(_tauSlotHash(_tauSlotHash(_tauSlotHash(schema, nameHash), typeHash), size), offset); }
+
+[[nodiscard]] constexpr bool _tauSerialInBounds(const unsigned offset, const unsigned size, const unsigned dataSize) noexcept
+{ return offset <= dataSize && size <= dataSize - offset; }
+
+/**
+ * The distance from the start of a block to the end of one of its members.
+ */
+[[nodiscard]] inline unsigned _tauSerialSpan(const void* const first, const void* const member, const ::std::size_t size) noexcept
+{ return static_cast<unsigned>(static_cast<const unsigned char*>(member) - static_cast<const unsigned char*>(first) + size); }
+
+inline void _tauWriteSerialField(unsigned char* const table, const unsigned index, const unsigned nameHash, const unsigned typeHash, const unsigned offset, const unsigned size) noexcept
+{
+    const TauSerialField field { nameHash, typeHash, offset, size };
+    ::std::memcpy(table + index * TAU_SERIAL_FIELD_SIZE, &field, TAU_SERIAL_FIELD_SIZE);
+}
+
+[[nodiscard]] inline TauSerialField _tauReadSerialField(const unsigned char* const table, const unsigned index) noexcept
+{
+    TauSerialField field;
+    ::std::memcpy(&field, table + index * TAU_SERIAL_FIELD_SIZE, TAU_SERIAL_FIELD_SIZE);
+    return field;
+}
+
+[[nodiscard]] inline bool _tauReadSerialHeader(TauSerialHeader& header, const void* const buffer, const unsigned size) noexcept
+{
+    if(size < TAU_SERIAL_HEADER_SIZE)
+    { return false; }
+
+    ::std::memcpy(&header, buffer, TAU_SERIAL_HEADER_SIZE);
+    return header.magic == TAU_SERIAL_MAGIC && header.size <= size && header.size >= TAU_SERIAL_HEADER_SIZE &&
+           header.fieldCount <= (header.size - TAU_SERIAL_HEADER_SIZE) / TAU_SERIAL_FIELD_SIZE;
+}
+
+/**
+ * Properties whose size changed are skipped.
+ */
+inline void _tauReadSerialCopy(void* const value, const ::std::size_t size, const unsigned char* const data, const TauSerialField& field) noexcept
+{
+    if(field.size == size)
+    { ::std::memcpy(value, data + field.offset, size); }
+}
+
+/**
+ *   Serializes a property that isn't part of a copied block.
+ * Specialize this for any other types, `read` is given exactly
+ * the bytes `write` produced.
+ */
+template<typename _T, typename = void>
+struct TauSerializer final
+{
+    static_assert(::std::is_trivially_copyable<_T>::value, "TauSerializer must be specialized for types that aren't trivially copyable or reflected.");
+    static_assert(!::std::is_pointer<_T>::value, "Pointers can't be serialized.");
+
+    [[nodiscard]] static unsigned size(const _T&) noexcept
+    { return static_cast<unsigned>(sizeof(_T)); }
+
+    static void write(const _T& value, unsigned char* const buffer) noexcept
+    { ::std::memcpy(buffer, &value, sizeof(_T)); }
+
+    [[nodiscard]] static bool read(_T& value, const unsigned char* const buffer, const unsigned size) noexcept
+    {
+        if(size != sizeof(_T))
+        { return false; }
+        ::std::memcpy(&value, buffer, sizeof(_T));
+        return true;
+    }
+};
+
+template<typename _T>
+struct TauSerializer<_T, ::std::void_t<typename _T::TauClassImpl>> final
+{
+    [[nodiscard]] static unsigned size(const _T& value) noexcept
+    { return _T::GetStaticClass().serialSize(&value); }
+
+    static void write(const _T& value, unsigned char* const buffer) noexcept
+    { (void) _T::GetStaticClass().serialize(&value, buffer, size(value)); }
+
+    [[nodiscard]] static bool read(_T& value, const unsigned char* const buffer, const unsigned size) noexcept
+    { return _T::GetStaticClass().deserialize(&value, buffer, size) != 0; }
+};
+
 class ITauClass
 {
 protected:
@@ -55,4 +218,25 @@ protected:
     [[nodiscard]] virtual void* _getProperty(void* object, const unsigned propIndex) const noexcept = 0;
     virtual void _setProperty(void* object, const char* propName, const void* value) const noexcept = 0;
     virtual void _setProperty(void* object, const unsigned propIndex, const void* value) const noexcept = 0;
+public:
+    [[nodiscard]] unsigned serialSize(const void* const object) const noexcept
+    { return _serialSize(object); }
+
+    /**
+     * Returns the number of bytes written, or 0 if the buffer is too small.
+     */
+    unsigned serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept
+    { return _serialize(object, buffer, capacity); }
+
+    /**
+     *   Returns the number of bytes read, or 0 if the buffer is
+     * malformed. The buffer is read in place, it can be memory
+     * mapped.
+     */
+    unsigned deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept
+    { return _deserialize(object, buffer, size); }
+protected:
+    [[nodiscard]] virtual unsigned _serialSize(const void* object) const noexcept = 0;
+    virtual unsigned _serialize(const void* object, void* buffer, unsigned capacity) const noexcept = 0;
+    virtual unsigned _deserialize(void* object, const void* buffer, unsigned size) const noexcept = 0;
 };
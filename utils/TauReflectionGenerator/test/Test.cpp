@@ -1,6 +1,11 @@
 #include "Test.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
+static void serialTest() noexcept;
+static void serialBenchmark() noexcept;
+
 int main()
 {
     Test test;
@@ -42,7 +47,111 @@ int main()
     std::cout << "Foo::bar " << foo.bar() << std::endl;
     std::cout << "Foo::baz " << foo.baz() << std::endl;
 
+    std::cout << std::endl;
 
+    serialTest();
+    serialBenchmark();
 
     return 0;
 }
+
+static void serialTest() noexcept
+{
+    Entity entity;
+    entity._id = 42;
+    entity._flags = 0x5;
+    entity._transform._position = { 1.0f, 2.0f, 3.0f };
+    entity._mass = 12.5f;
+    entity._children = { 1, 2, 3 };
+
+    std::vector<unsigned char> buffer(Entity::GetStaticClass().serialSize(&entity));
+    const unsigned written = Entity::GetStaticClass().serialize(&entity, buffer.data(), static_cast<unsigned>(buffer.size()));
+
+    Entity copy;
+    const unsigned read = Entity::GetStaticClass().deserialize(&copy, buffer.data(), static_cast<unsigned>(buffer.size()));
+
+    std::cout << "Entity bytes " << written << " read " << read << std::endl;
+    std::cout << "Entity::id " << copy._id << " flags " << copy._flags << " mass " << copy._mass << " children " << copy._children.size() << std::endl;
+    std::cout << "Entity::position (" << copy._transform._position.x << ", " << copy._transform._position.y << ", " << copy._transform._position.z << ")" << std::endl;
+    std::cout << "Truncated read " << Entity::GetStaticClass().deserialize(&copy, buffer.data(), written - 1) << std::endl;
+
+    SettingsV1 v1;
+    v1._volume = 0.25f;
+    v1._width = 1920;
+    v1._fullscreen = true;
+    v1._legacy = 3.0;
+
+    unsigned char settings[256];
+    const unsigned settingsSize = SettingsV1::GetStaticClass().serialize(&v1, settings, sizeof(settings));
+
+    SettingsV2 v2;
+    SettingsV2::GetStaticClass().deserialize(&v2, settings, settingsSize);
+    std::cout << "SettingsV2 " << v2._width << "x" << v2._height << " volume " << v2._volume << " fullscreen " << v2._fullscreen << std::endl;
+
+    std::cout << std::endl;
+}
+
+/**
+ *   Round trips a scene of entities, each entity is a nested
+ * object with a block of properties and a vector.
+ */
+static void serialBenchmark() noexcept
+{
+    constexpr unsigned ENTITY_COUNT = 200000;
+
+    Scene scene;
+    scene._entities.resize(ENTITY_COUNT);
+    for(unsigned i = 0; i < ENTITY_COUNT; ++i)
+    {
+        Entity& entity = scene._entities[i];
+        entity._id = i;
+        entity._transform._position = { static_cast<float>(i), 0.0f, -static_cast<float>(i) };
+        for(unsigned j = 0; j < i % 5; ++j)
+        { entity._children.push_back((i + j + 1) % ENTITY_COUNT); }
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr unsigned RUNS = 5;
+
+    // The buffer is allocated outside of the timings, each timing is the best of several runs.
+    std::vector<unsigned char> buffer(Scene::GetStaticClass().serialSize(&scene));
+    double sizeMs = 1.0e9;
+    double serializeMs = 1.0e9;
+    double deserializeMs = 1.0e9;
+    unsigned written = 0;
+    unsigned read = 0;
+    Scene copy;
+
+    for(unsigned run = 0; run < RUNS; ++run)
+    {
+        const Clock::time_point sizeStart = Clock::now();
+        const unsigned size = Scene::GetStaticClass().serialSize(&scene);
+        const Clock::time_point serializeStart = Clock::now();
+        written = Scene::GetStaticClass().serialize(&scene, buffer.data(), size);
+        const Clock::time_point serializeEnd = Clock::now();
+
+        copy = Scene();
+        const Clock::time_point deserializeStart = Clock::now();
+        read = Scene::GetStaticClass().deserialize(&copy, buffer.data(), written);
+        const Clock::time_point deserializeEnd = Clock::now();
+
+        sizeMs = std::min(sizeMs, std::chrono::duration<double, std::milli>(serializeStart - sizeStart).count());
+        serializeMs = std::min(serializeMs, std::chrono::duration<double, std::milli>(serializeEnd - serializeStart).count());
+        deserializeMs = std::min(deserializeMs, std::chrono::duration<double, std::milli>(deserializeEnd - deserializeStart).count());
+    }
+
+    bool equal = read == written && copy._entities.size() == scene._entities.size();
+    for(unsigned i = 0; equal && i < ENTITY_COUNT; ++i)
+    {
+        equal = copy._entities[i]._id == scene._entities[i]._id &&
+                copy._entities[i]._transform._position.z == scene._entities[i]._transform._position.z &&
+                copy._entities[i]._children == scene._entities[i]._children;
+    }
+
+    const double megabytes = static_cast<double>(written) / (1024.0 * 1024.0);
+
+    std::cout << "Scene of " << ENTITY_COUNT << " entities, " << megabytes << " MiB, round trip " << (equal ? "matches" : "differs") << std::endl;
+    std::cout << "serialSize  " << sizeMs << " ms" << std::endl;
+    std::cout << "serialize   " << serializeMs << " ms, " << megabytes / (serializeMs / 1000.0) << " MiB/s" << std::endl;
+    std::cout << "deserialize " << deserializeMs << " ms, " << megabytes / (deserializeMs / 1000.0) << " MiB/s" << std::endl;
+}
@@ -54,17 +54,45 @@
                                                                                                            \
             [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
             {                                                                                              \
-                if(::std::strcmp(propName, "_time") == 0)         \
-                { return 0; }                                                      \
-                if(::std::strcmp(propName, "_vec") == 0)         \
-                { return 1; }                                                      \
-                return static_cast<unsigned>(-1);                                                          \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
             }                                                                                              \
                                                                                                            \
             [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
             {                                                                                              \
+                (void) funcName;                                                                           \
                 return static_cast<unsigned>(-1);                                                          \
             }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[2] = { "_time", "_vec" }; \
+            static constexpr unsigned _propertyLengths[2] = { 5, 4 }; \
+            static constexpr unsigned _propertyListIndices[2] = { 0, 1 }; \
+            static constexpr unsigned _propertySeeds[1] = { 2u }; \
+            static constexpr unsigned _propertyIndices[2] = { 0, 1 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 1u)]), 2u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
         public:                                                                                                                                \
             template<typename _T>                                                                                                              \
             [[nodiscard]] const _T* getProperty(const Test* const object, const char* const propName) const noexcept        \
@@ -81,13 +109,7 @@
             { return getPropertyImpl(reinterpret_cast<const Test*>(object), propIndex); }                                   \
                                                                                                                                                \
             [[nodiscard]] const void* getPropertyImpl(const Test* const object, const char* const propName) const noexcept  \
-            {                                                                                                                                  \
-                if(::std::strcmp(propName, "_time") == 0) \
-                { return &object->_time; }                  \
-                if(::std::strcmp(propName, "_vec") == 0) \
-                { return &object->_vec; }                  \
-                return nullptr;                                                                                                                \
-            }                                                                                                                                  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
                                                                                                                                                \
             [[nodiscard]] const void* getPropertyImpl(const Test* const object, const unsigned propIndex) const noexcept    \
             {                                                                                                                                  \
@@ -128,11 +150,7 @@
             { return setPropertyImpl(reinterpret_cast<Test*>(object), propIndex, value); }                                  \
                                                                                                                                                \
             [[nodiscard]] void* getPropertyImpl(Test* const object, const char* const propName) const noexcept              \
-            {                                                                                                                                  \
-                if(::std::strcmp(propName, "_time") == 0) \
-                { return &object->_time; }                  \
-                return nullptr;                                                                                                                \
-            }                                                                                                                                  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
                                                                                                                                                \
             [[nodiscard]] void* getPropertyImpl(Test* const object, const unsigned propIndex) const noexcept                \
             {                                                                                                                                  \
@@ -144,10 +162,7 @@
             }                                                                                                                                  \
                                                                                                                                                \
             void setPropertyImpl(Test* const object, const char* const propName, const void* const value) const noexcept    \
-            {                                                                                                                                  \
-                if(::std::strcmp(propName, "_time") == 0)                                                         \
-                { object->_time = *reinterpret_cast<int * const*>(value); }  \
-            }                                                                                                                                  \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
                                                                                                                                                \
             void setPropertyImpl(Test* const object, const unsigned propIndex, const void* const value) const noexcept      \
             {                                                                                                                                  \
@@ -157,6 +172,42 @@
                     default: break;                                                                                                            \
                 }                                                                                                                              \
             }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const Test* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const Test* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(Test* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const Test*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const Test*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<Test*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const Test* const) noexcept                                        \
+            { return TAU_SERIAL_HEADER_SIZE; }                                                                                                 \
+                                                                                                                                               \
+            static unsigned serializeImpl(const Test* const, void* const buffer, const unsigned capacity) noexcept           \
+            {                                                                                                                                  \
+                if(capacity < TAU_SERIAL_HEADER_SIZE)                                                                                          \
+                { return 0; }                                                                                                                  \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, 0, 0, TAU_SERIAL_HEADER_SIZE };                                               \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                return TAU_SERIAL_HEADER_SIZE;                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(Test* const, const void* const buffer, const unsigned size) noexcept             \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                return _tauReadSerialHeader(header, buffer, size) ? header.size : 0;                                                           \
+            }                                                                                                                                  \
         };                                                                         \
     [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
     {                                                                              \
@@ -206,11 +257,8 @@
                                                                                                            \
             [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
             {                                                                                              \
-                if(::std::strcmp(propName, "_bar") == 0)         \
-                { return 0; }                                                      \
-                if(::std::strcmp(propName, "_baz") == 0)         \
-                { return 1; }                                                      \
-                return static_cast<unsigned>(-1);                                                          \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
             }                                                                                              \
                                                                                                            \
             [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
@@ -219,6 +267,36 @@
                 { return 0; }                                                      \
                 return static_cast<unsigned>(-1);                                                          \
             }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[2] = { "_baz", "_bar" }; \
+            static constexpr unsigned _propertyLengths[2] = { 4, 4 }; \
+            static constexpr unsigned _propertyListIndices[2] = { 0, 1 }; \
+            static constexpr unsigned _propertySeeds[1] = { 1u }; \
+            static constexpr unsigned _propertyIndices[2] = { 1, 0 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 1u)]), 2u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
         public:                                                                                                                                \
             template<typename _T>                                                                                                              \
             [[nodiscard]] const _T* getProperty(const Foo* const object, const char* const propName) const noexcept        \
@@ -235,11 +313,7 @@
             { return getPropertyImpl(reinterpret_cast<const Foo*>(object), propIndex); }                                   \
                                                                                                                                                \
             [[nodiscard]] const void* getPropertyImpl(const Foo* const object, const char* const propName) const noexcept  \
-            {                                                                                                                                  \
-                if(::std::strcmp(propName, "_bar") == 0) \
-                { return &object->_bar; }                  \
-                return nullptr;                                                                                                                \
-            }                                                                                                                                  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
                                                                                                                                                \
             [[nodiscard]] const void* getPropertyImpl(const Foo* const object, const unsigned propIndex) const noexcept    \
             {                                                                                                                                  \
@@ -279,11 +353,7 @@
             { return setPropertyImpl(reinterpret_cast<Foo*>(object), propIndex, value); }                                  \
                                                                                                                                                \
             [[nodiscard]] void* getPropertyImpl(Foo* const object, const char* const propName) const noexcept              \
-            {                                                                                                                                  \
-                if(::std::strcmp(propName, "_bar") == 0) \
-                { return &object->_bar; }                  \
-                return nullptr;                                                                                                                \
-            }                                                                                                                                  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
                                                                                                                                                \
             [[nodiscard]] void* getPropertyImpl(Foo* const object, const unsigned propIndex) const noexcept                \
             {                                                                                                                                  \
@@ -295,12 +365,7 @@
             }                                                                                                                                  \
                                                                                                                                                \
             void setPropertyImpl(Foo* const object, const char* const propName, const void* const value) const noexcept    \
-            {                                                                                                                                  \
-                if(::std::strcmp(propName, "_bar") == 0)                                                         \
-                { object->_bar = *reinterpret_cast<int const*>(value); }  \
-                if(::std::strcmp(propName, "_baz") == 0)                                                         \
-                { object->_baz = *reinterpret_cast<float const*>(value); }  \
-            }                                                                                                                                  \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
                                                                                                                                                \
             void setPropertyImpl(Foo* const object, const unsigned propIndex, const void* const value) const noexcept      \
             {                                                                                                                                  \
@@ -311,6 +376,42 @@
                     default: break;                                                                                                            \
                 }                                                                                                                              \
             }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const Foo* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const Foo* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(Foo* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const Foo*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const Foo*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<Foo*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const Foo* const) noexcept                                        \
+            { return TAU_SERIAL_HEADER_SIZE; }                                                                                                 \
+                                                                                                                                               \
+            static unsigned serializeImpl(const Foo* const, void* const buffer, const unsigned capacity) noexcept           \
+            {                                                                                                                                  \
+                if(capacity < TAU_SERIAL_HEADER_SIZE)                                                                                          \
+                { return 0; }                                                                                                                  \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, 0, 0, TAU_SERIAL_HEADER_SIZE };                                               \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                return TAU_SERIAL_HEADER_SIZE;                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(Foo* const, const void* const buffer, const unsigned size) noexcept             \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                return _tauReadSerialHeader(header, buffer, size) ? header.size : 0;                                                           \
+            }                                                                                                                                  \
         };                                                                         \
     [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
     {                                                                              \
@@ -321,3 +422,1459 @@
     { return GetStaticClass(); }                                                   
 // End _TAU_GENERATED_BODY_Foo()
 
+#ifdef _TAU_GENERATED_BODY_Transform
+  #undef _TAU_GENERATED_BODY_Transform
+#endif
+
+#define _TAU_GENERATED_BODY_Transform() \
+    public:                                                                        \
+        class TauClassImpl final : public ITauClass                                \
+        {                                                                          \
+        public:                                                                    \
+            TauClassImpl() noexcept = default;                                     \
+            ~TauClassImpl() noexcept override = default;                           \
+                                                                                   \
+            TauClassImpl(const TauClassImpl& copy) noexcept = default;             \
+            TauClassImpl(TauClassImpl&& move) noexcept = default;                  \
+                                                                                   \
+            TauClassImpl& operator=(const TauClassImpl& copy) noexcept = default;  \
+            TauClassImpl& operator=(TauClassImpl&& move) noexcept = default;       \
+        public:                                                                                            \
+            const char* const * getProperties(unsigned* const count) const noexcept override               \
+            {                                                                                              \
+                static const char* _properties[] = {                                                       \
+                    "_position",                                                                                              \
+                    "_scale",                                                                                              \
+                    "_rotation"                                                                                               \
+                };                                                                                         \
+                *count = 3;                                                              \
+                return _properties;                                                                        \
+            }                                                                                              \
+                                                                                                           \
+            const char* const * getFunctions(unsigned* const count) const noexcept override                \
+            {                                                                                              \
+                static const char* _functions[] = {                                                        \
+                };                                                                                         \
+                *count = 0;                                                              \
+                return _functions;                                                                         \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
+            {                                                                                              \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
+            {                                                                                              \
+                (void) funcName;                                                                           \
+                return static_cast<unsigned>(-1);                                                          \
+            }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[3] = { "_position", "_scale", "_rotation" }; \
+            static constexpr unsigned _propertyLengths[3] = { 9, 6, 9 }; \
+            static constexpr unsigned _propertyListIndices[3] = { 0, 1, 2 }; \
+            static constexpr unsigned _propertySeeds[2] = { 1u, 1u }; \
+            static constexpr unsigned _propertyIndices[3] = { 0, 1, 2 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 2u)]), 3u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const Transform* const object, const char* const propName) const noexcept        \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propName)); }                                                         \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const Transform* const object, const unsigned propIndex) const noexcept          \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propIndex)); }                                                        \
+        protected:                                                                                                                             \
+            [[nodiscard]] const void* _getProperty(const void* const object, const char* const propName) const noexcept override               \
+            { return getPropertyImpl(reinterpret_cast<const Transform*>(object), propName); }                                    \
+                                                                                                                                               \
+            [[nodiscard]] const void* _getProperty(const void* const object, const unsigned propIndex) const noexcept override                 \
+            { return getPropertyImpl(reinterpret_cast<const Transform*>(object), propIndex); }                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const Transform* const object, const char* const propName) const noexcept  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const Transform* const object, const unsigned propIndex) const noexcept    \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(Transform* const object, const char* const propName) const noexcept                    \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propName)); }                                                               \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(Transform* const object, const unsigned propIndex) const noexcept                      \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propIndex)); }                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(Transform* const object, const char* const propName, const _T& value) const noexcept                \
+            { return setPropertyImpl(object, propName, &value); }                                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(Transform* const object, const unsigned propIndex, const _T& value) const noexcept                  \
+            { return setPropertyImpl(object, propIndex, &value); }                                                                             \
+        protected:                                                                                                                             \
+            [[nodiscard]] void* _getProperty(void* const object, const char* const propName) const noexcept override                           \
+            { return getPropertyImpl(reinterpret_cast<Transform*>(object), propName); }                                          \
+                                                                                                                                               \
+            [[nodiscard]] void* _getProperty(void* const object, const unsigned propIndex) const noexcept override                             \
+            { return getPropertyImpl(reinterpret_cast<Transform*>(object), propIndex); }                                         \
+                                                                                                                                               \
+            void _setProperty(void* const object, const char* const propName, const void* const value) const noexcept override                 \
+            { return setPropertyImpl(reinterpret_cast<Transform*>(object), propName, value); }                                   \
+                                                                                                                                               \
+            void _setProperty(void* const object, const unsigned propIndex, const void* const value) const noexcept override                   \
+            { return setPropertyImpl(reinterpret_cast<Transform*>(object), propIndex, value); }                                  \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(Transform* const object, const char* const propName) const noexcept              \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(Transform* const object, const unsigned propIndex) const noexcept                \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            void setPropertyImpl(Transform* const object, const char* const propName, const void* const value) const noexcept    \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
+                                                                                                                                               \
+            void setPropertyImpl(Transform* const object, const unsigned propIndex, const void* const value) const noexcept      \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                (void) value;                                                                                                                  \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: break;                                                                                                            \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const Transform* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const Transform* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(Transform* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const Transform*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const Transform*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<Transform*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSchema(const Transform* const object) noexcept                                   \
+            {                                                                                                                                  \
+                unsigned schema = 3u; \
+                schema = _tauSchemaHash(schema, 0x8d771c9bu, 0xc2fdadefu, static_cast<unsigned>(sizeof(object->_position)), _tauSerialSpan(&object->_position, &object->_position, 0)); \
+                schema = _tauSchemaHash(schema, 0x10dfc8a3u, 0xc2fdadefu, static_cast<unsigned>(sizeof(object->_scale)), _tauSerialSpan(&object->_position, &object->_scale, 0)); \
+                schema = _tauSchemaHash(schema, 0xcd2633d2u, 0x428ddf1eu, static_cast<unsigned>(sizeof(object->_rotation)), _tauSerialSpan(&object->_position, &object->_rotation, 0)); \
+                return schema;                                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const Transform* const object) noexcept                                 \
+            {                                                                                                                                  \
+                unsigned size = TAU_SERIAL_HEADER_SIZE + 3u * TAU_SERIAL_FIELD_SIZE; \
+                size += _tauSerialSpan(&object->_position, &object->_rotation, sizeof(object->_rotation)); \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned serializeImpl(const Transform* const object, void* const buffer, const unsigned capacity) noexcept    \
+            {                                                                                                                                  \
+                static_assert(!::std::is_pointer<decltype(object->_position)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_scale)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_rotation)>::value, "Pointers can't be serialized."); \
+                const unsigned size = serialSizeImpl(object);                                                                                  \
+                if(size > capacity)                                                                                                            \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, serialSchema(object), 3u, size }; \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                                                                                                                                               \
+                unsigned char* const table = static_cast<unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                                     \
+                unsigned char* const data = table + 3u * TAU_SERIAL_FIELD_SIZE; \
+                unsigned offset = 0;                                                                                                           \
+                                                                                                                                               \
+                _tauWriteSerialField(table, 0, 0x8d771c9bu, 0xc2fdadefu, offset + _tauSerialSpan(&object->_position, &object->_position, 0), static_cast<unsigned>(sizeof(object->_position))); \
+                _tauWriteSerialField(table, 1, 0x10dfc8a3u, 0xc2fdadefu, offset + _tauSerialSpan(&object->_position, &object->_scale, 0), static_cast<unsigned>(sizeof(object->_scale))); \
+                _tauWriteSerialField(table, 2, 0xcd2633d2u, 0x428ddf1eu, offset + _tauSerialSpan(&object->_position, &object->_rotation, 0), static_cast<unsigned>(sizeof(object->_rotation))); \
+                {                                                                                                                              \
+                    const unsigned span = _tauSerialSpan(&object->_position, &object->_rotation, sizeof(object->_rotation)); \
+                    ::std::memcpy(data + offset, &object->_position, span);                                                              \
+                    offset += span;                                                                                                            \
+                }                                                                                                                              \
+                                                                                                                                               \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(Transform* const object, const void* const buffer, const unsigned size) noexcept      \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                if(!_tauReadSerialHeader(header, buffer, size))                                                                                \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const unsigned char* const table = static_cast<const unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                         \
+                const unsigned char* const data = table + header.fieldCount * TAU_SERIAL_FIELD_SIZE;                                           \
+                const unsigned dataSize = header.size - TAU_SERIAL_HEADER_SIZE - header.fieldCount * TAU_SERIAL_FIELD_SIZE;                    \
+                                                                                                                                               \
+                if(header.schema == serialSchema(object) && header.fieldCount == 3u) \
+                {                                                                                                                              \
+                    TauSerialField field;                                                                                                      \
+                    field = _tauReadSerialField(table, 0); \
+                    {                                                                                                                          \
+                        const unsigned span = _tauSerialSpan(&object->_position, &object->_rotation, sizeof(object->_rotation)); \
+                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \
+                        { return 0; }                                                                                                          \
+                        ::std::memcpy(&object->_position, data + field.offset, span);                                                    \
+                    }                                                                                                                          \
+                    return header.size;                                                                                                        \
+                }                                                                                                                              \
+                                                                                                                                               \
+                for(unsigned i = 0; i < header.fieldCount; ++i)                                                                                \
+                {                                                                                                                              \
+                    const TauSerialField field = _tauReadSerialField(table, i);                                                                \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize))                                                                \
+                    { return 0; }                                                                                                              \
+                                                                                                                                               \
+                    switch(field.nameHash)                                                                                                     \
+                    {                                                                                                                          \
+                        case 0x8d771c9bu: \
+                            if(field.typeHash == 0xc2fdadefu) \
+                            { _tauReadSerialCopy(&object->_position, sizeof(object->_position), data, field); } \
+                            break;                                                                                                             \
+                        case 0x10dfc8a3u: \
+                            if(field.typeHash == 0xc2fdadefu) \
+                            { _tauReadSerialCopy(&object->_scale, sizeof(object->_scale), data, field); } \
+                            break;                                                                                                             \
+                        case 0xcd2633d2u: \
+                            if(field.typeHash == 0x428ddf1eu) \
+                            { _tauReadSerialCopy(&object->_rotation, sizeof(object->_rotation), data, field); } \
+                            break;                                                                                                             \
+                        default: break;                                                                                                        \
+                    }                                                                                                                          \
+                }                                                                                                                              \
+                return header.size;                                                                                                            \
+            }                                                                                                                                  \
+        };                                                                         \
+    [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
+    {                                                                              \
+        static TauClassImpl tauClass;                                              \
+        return tauClass;                                                           \
+    }                                                                              \
+    [[nodiscard]] TauClassImpl& getClass() const noexcept                          \
+    { return GetStaticClass(); }                                                   
+// End _TAU_GENERATED_BODY_Transform()
+
+#ifdef _TAU_GENERATED_BODY_Entity
+  #undef _TAU_GENERATED_BODY_Entity
+#endif
+
+#define _TAU_GENERATED_BODY_Entity() \
+    public:                                                                        \
+        class TauClassImpl final : public ITauClass                                \
+        {                                                                          \
+        public:                                                                    \
+            TauClassImpl() noexcept = default;                                     \
+            ~TauClassImpl() noexcept override = default;                           \
+                                                                                   \
+            TauClassImpl(const TauClassImpl& copy) noexcept = default;             \
+            TauClassImpl(TauClassImpl&& move) noexcept = default;                  \
+                                                                                   \
+            TauClassImpl& operator=(const TauClassImpl& copy) noexcept = default;  \
+            TauClassImpl& operator=(TauClassImpl&& move) noexcept = default;       \
+        public:                                                                                            \
+            const char* const * getProperties(unsigned* const count) const noexcept override               \
+            {                                                                                              \
+                static const char* _properties[] = {                                                       \
+                    "_id",                                                                                              \
+                    "_flags",                                                                                              \
+                    "_transform",                                                                                              \
+                    "_mass",                                                                                              \
+                    "_children"                                                                                               \
+                };                                                                                         \
+                *count = 5;                                                              \
+                return _properties;                                                                        \
+            }                                                                                              \
+                                                                                                           \
+            const char* const * getFunctions(unsigned* const count) const noexcept override                \
+            {                                                                                              \
+                static const char* _functions[] = {                                                        \
+                };                                                                                         \
+                *count = 0;                                                              \
+                return _functions;                                                                         \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
+            {                                                                                              \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
+            {                                                                                              \
+                (void) funcName;                                                                           \
+                return static_cast<unsigned>(-1);                                                          \
+            }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[5] = { "_flags", "_transform", "_id", "_mass", "_children" }; \
+            static constexpr unsigned _propertyLengths[5] = { 6, 10, 3, 5, 9 }; \
+            static constexpr unsigned _propertyListIndices[5] = { 0, 1, 2, 3, 4 }; \
+            static constexpr unsigned _propertySeeds[3] = { 10u, 0u, 1u }; \
+            static constexpr unsigned _propertyIndices[5] = { 1, 2, 0, 3, 4 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 3u)]), 5u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const Entity* const object, const char* const propName) const noexcept        \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propName)); }                                                         \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const Entity* const object, const unsigned propIndex) const noexcept          \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propIndex)); }                                                        \
+        protected:                                                                                                                             \
+            [[nodiscard]] const void* _getProperty(const void* const object, const char* const propName) const noexcept override               \
+            { return getPropertyImpl(reinterpret_cast<const Entity*>(object), propName); }                                    \
+                                                                                                                                               \
+            [[nodiscard]] const void* _getProperty(const void* const object, const unsigned propIndex) const noexcept override                 \
+            { return getPropertyImpl(reinterpret_cast<const Entity*>(object), propIndex); }                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const Entity* const object, const char* const propName) const noexcept  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const Entity* const object, const unsigned propIndex) const noexcept    \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(Entity* const object, const char* const propName) const noexcept                    \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propName)); }                                                               \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(Entity* const object, const unsigned propIndex) const noexcept                      \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propIndex)); }                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(Entity* const object, const char* const propName, const _T& value) const noexcept                \
+            { return setPropertyImpl(object, propName, &value); }                                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(Entity* const object, const unsigned propIndex, const _T& value) const noexcept                  \
+            { return setPropertyImpl(object, propIndex, &value); }                                                                             \
+        protected:                                                                                                                             \
+            [[nodiscard]] void* _getProperty(void* const object, const char* const propName) const noexcept override                           \
+            { return getPropertyImpl(reinterpret_cast<Entity*>(object), propName); }                                          \
+                                                                                                                                               \
+            [[nodiscard]] void* _getProperty(void* const object, const unsigned propIndex) const noexcept override                             \
+            { return getPropertyImpl(reinterpret_cast<Entity*>(object), propIndex); }                                         \
+                                                                                                                                               \
+            void _setProperty(void* const object, const char* const propName, const void* const value) const noexcept override                 \
+            { return setPropertyImpl(reinterpret_cast<Entity*>(object), propName, value); }                                   \
+                                                                                                                                               \
+            void _setProperty(void* const object, const unsigned propIndex, const void* const value) const noexcept override                   \
+            { return setPropertyImpl(reinterpret_cast<Entity*>(object), propIndex, value); }                                  \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(Entity* const object, const char* const propName) const noexcept              \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(Entity* const object, const unsigned propIndex) const noexcept                \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            void setPropertyImpl(Entity* const object, const char* const propName, const void* const value) const noexcept    \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
+                                                                                                                                               \
+            void setPropertyImpl(Entity* const object, const unsigned propIndex, const void* const value) const noexcept      \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                (void) value;                                                                                                                  \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: break;                                                                                                            \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const Entity* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const Entity* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(Entity* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const Entity*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const Entity*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<Entity*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSchema(const Entity* const object) noexcept                                   \
+            {                                                                                                                                  \
+                unsigned schema = 5u; \
+                schema = _tauSchemaHash(schema, 0xf604b207u, 0x33ac0ca7u, static_cast<unsigned>(sizeof(object->_id)), _tauSerialSpan(&object->_id, &object->_id, 0)); \
+                schema = _tauSchemaHash(schema, 0x09d2198du, 0x33ac0ca7u, static_cast<unsigned>(sizeof(object->_flags)), _tauSerialSpan(&object->_id, &object->_flags, 0)); \
+                schema = _tauSchemaHash(schema, 0x29cbcc48u, 0x92c92a8bu, static_cast<unsigned>(sizeof(object->_transform)), _tauSerialSpan(&object->_id, &object->_transform, 0)); \
+                schema = _tauSchemaHash(schema, 0xb3ab350cu, 0xdd25da60u, static_cast<unsigned>(sizeof(object->_mass)), _tauSerialSpan(&object->_mass, &object->_mass, 0)); \
+                schema = _tauSchemaHash(schema, 0xbaf5e96bu, 0xe09b7ecau, 0xFFFFFFFFu, 0xFFFFFFFFu); \
+                return schema;                                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const Entity* const object) noexcept                                 \
+            {                                                                                                                                  \
+                unsigned size = TAU_SERIAL_HEADER_SIZE + 5u * TAU_SERIAL_FIELD_SIZE; \
+                size += _tauSerialSpan(&object->_id, &object->_transform, sizeof(object->_transform)); \
+                size += _tauSerialSpan(&object->_mass, &object->_mass, sizeof(object->_mass)); \
+                size += TauSerializer<decltype(object->_children)>::size(object->_children); \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned serializeImpl(const Entity* const object, void* const buffer, const unsigned capacity) noexcept    \
+            {                                                                                                                                  \
+                static_assert(!::std::is_pointer<decltype(object->_id)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_flags)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_transform)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_mass)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_children)>::value, "Pointers can't be serialized."); \
+                const unsigned size = serialSizeImpl(object);                                                                                  \
+                if(size > capacity)                                                                                                            \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, serialSchema(object), 5u, size }; \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                                                                                                                                               \
+                unsigned char* const table = static_cast<unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                                     \
+                unsigned char* const data = table + 5u * TAU_SERIAL_FIELD_SIZE; \
+                unsigned offset = 0;                                                                                                           \
+                                                                                                                                               \
+                _tauWriteSerialField(table, 0, 0xf604b207u, 0x33ac0ca7u, offset + _tauSerialSpan(&object->_id, &object->_id, 0), static_cast<unsigned>(sizeof(object->_id))); \
+                _tauWriteSerialField(table, 1, 0x09d2198du, 0x33ac0ca7u, offset + _tauSerialSpan(&object->_id, &object->_flags, 0), static_cast<unsigned>(sizeof(object->_flags))); \
+                _tauWriteSerialField(table, 2, 0x29cbcc48u, 0x92c92a8bu, offset + _tauSerialSpan(&object->_id, &object->_transform, 0), static_cast<unsigned>(sizeof(object->_transform))); \
+                {                                                                                                                              \
+                    const unsigned span = _tauSerialSpan(&object->_id, &object->_transform, sizeof(object->_transform)); \
+                    ::std::memcpy(data + offset, &object->_id, span);                                                              \
+                    offset += span;                                                                                                            \
+                }                                                                                                                              \
+                                                                                                                                               \
+                _tauWriteSerialField(table, 3, 0xb3ab350cu, 0xdd25da60u, offset + _tauSerialSpan(&object->_mass, &object->_mass, 0), static_cast<unsigned>(sizeof(object->_mass))); \
+                {                                                                                                                              \
+                    const unsigned span = _tauSerialSpan(&object->_mass, &object->_mass, sizeof(object->_mass)); \
+                    ::std::memcpy(data + offset, &object->_mass, span);                                                              \
+                    offset += span;                                                                                                            \
+                }                                                                                                                              \
+                                                                                                                                               \
+                {                                                                                                                              \
+                    const unsigned fieldSize = TauSerializer<decltype(object->_children)>::size(object->_children); \
+                    _tauWriteSerialField(table, 4, 0xbaf5e96bu, 0xe09b7ecau, offset, fieldSize); \
+                    TauSerializer<decltype(object->_children)>::write(object->_children, data + offset);                           \
+                    offset += fieldSize;                                                                                                       \
+                }                                                                                                                              \
+                                                                                                                                               \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(Entity* const object, const void* const buffer, const unsigned size) noexcept      \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                if(!_tauReadSerialHeader(header, buffer, size))                                                                                \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const unsigned char* const table = static_cast<const unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                         \
+                const unsigned char* const data = table + header.fieldCount * TAU_SERIAL_FIELD_SIZE;                                           \
+                const unsigned dataSize = header.size - TAU_SERIAL_HEADER_SIZE - header.fieldCount * TAU_SERIAL_FIELD_SIZE;                    \
+                                                                                                                                               \
+                if(header.schema == serialSchema(object) && header.fieldCount == 5u) \
+                {                                                                                                                              \
+                    TauSerialField field;                                                                                                      \
+                    field = _tauReadSerialField(table, 0); \
+                    {                                                                                                                          \
+                        const unsigned span = _tauSerialSpan(&object->_id, &object->_transform, sizeof(object->_transform)); \
+                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \
+                        { return 0; }                                                                                                          \
+                        ::std::memcpy(&object->_id, data + field.offset, span);                                                    \
+                    }                                                                                                                          \
+                    field = _tauReadSerialField(table, 3); \
+                    {                                                                                                                          \
+                        const unsigned span = _tauSerialSpan(&object->_mass, &object->_mass, sizeof(object->_mass)); \
+                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \
+                        { return 0; }                                                                                                          \
+                        ::std::memcpy(&object->_mass, data + field.offset, span);                                                    \
+                    }                                                                                                                          \
+                    field = _tauReadSerialField(table, 4); \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize) ||                                                              \
+                       !TauSerializer<decltype(object->_children)>::read(object->_children, data + field.offset, field.size))      \
+                    { return 0; }                                                                                                              \
+                    return header.size;                                                                                                        \
+                }                                                                                                                              \
+                                                                                                                                               \
+                for(unsigned i = 0; i < header.fieldCount; ++i)                                                                                \
+                {                                                                                                                              \
+                    const TauSerialField field = _tauReadSerialField(table, i);                                                                \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize))                                                                \
+                    { return 0; }                                                                                                              \
+                                                                                                                                               \
+                    switch(field.nameHash)                                                                                                     \
+                    {                                                                                                                          \
+                        case 0xf604b207u: \
+                            if(field.typeHash == 0x33ac0ca7u) \
+                            { _tauReadSerialCopy(&object->_id, sizeof(object->_id), data, field); } \
+                            break;                                                                                                             \
+                        case 0x09d2198du: \
+                            if(field.typeHash == 0x33ac0ca7u) \
+                            { _tauReadSerialCopy(&object->_flags, sizeof(object->_flags), data, field); } \
+                            break;                                                                                                             \
+                        case 0x29cbcc48u: \
+                            if(field.typeHash == 0x92c92a8bu) \
+                            { _tauReadSerialCopy(&object->_transform, sizeof(object->_transform), data, field); } \
+                            break;                                                                                                             \
+                        case 0xb3ab350cu: \
+                            if(field.typeHash == 0xdd25da60u) \
+                            { _tauReadSerialCopy(&object->_mass, sizeof(object->_mass), data, field); } \
+                            break;                                                                                                             \
+                        case 0xbaf5e96bu: \
+                            if(field.typeHash == 0xe09b7ecau) \
+                            {                                                                                                                  \
+                                if(!TauSerializer<decltype(object->_children)>::read(object->_children, data + field.offset, field.size)) \
+                                { return 0; }                                                                                                  \
+                            }                                                                                                                  \
+                            break;                                                                                                             \
+                        default: break;                                                                                                        \
+                    }                                                                                                                          \
+                }                                                                                                                              \
+                return header.size;                                                                                                            \
+            }                                                                                                                                  \
+        };                                                                         \
+    [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
+    {                                                                              \
+        static TauClassImpl tauClass;                                              \
+        return tauClass;                                                           \
+    }                                                                              \
+    [[nodiscard]] TauClassImpl& getClass() const noexcept                          \
+    { return GetStaticClass(); }                                                   
+// End _TAU_GENERATED_BODY_Entity()
+
+#ifdef _TAU_GENERATED_BODY_Scene
+  #undef _TAU_GENERATED_BODY_Scene
+#endif
+
+#define _TAU_GENERATED_BODY_Scene() \
+    public:                                                                        \
+        class TauClassImpl final : public ITauClass                                \
+        {                                                                          \
+        public:                                                                    \
+            TauClassImpl() noexcept = default;                                     \
+            ~TauClassImpl() noexcept override = default;                           \
+                                                                                   \
+            TauClassImpl(const TauClassImpl& copy) noexcept = default;             \
+            TauClassImpl(TauClassImpl&& move) noexcept = default;                  \
+                                                                                   \
+            TauClassImpl& operator=(const TauClassImpl& copy) noexcept = default;  \
+            TauClassImpl& operator=(TauClassImpl&& move) noexcept = default;       \
+        public:                                                                                            \
+            const char* const * getProperties(unsigned* const count) const noexcept override               \
+            {                                                                                              \
+                static const char* _properties[] = {                                                       \
+                    "_version",                                                                                              \
+                    "_entities"                                                                                               \
+                };                                                                                         \
+                *count = 2;                                                              \
+                return _properties;                                                                        \
+            }                                                                                              \
+                                                                                                           \
+            const char* const * getFunctions(unsigned* const count) const noexcept override                \
+            {                                                                                              \
+                static const char* _functions[] = {                                                        \
+                };                                                                                         \
+                *count = 0;                                                              \
+                return _functions;                                                                         \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
+            {                                                                                              \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
+            {                                                                                              \
+                (void) funcName;                                                                           \
+                return static_cast<unsigned>(-1);                                                          \
+            }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[2] = { "_version", "_entities" }; \
+            static constexpr unsigned _propertyLengths[2] = { 8, 9 }; \
+            static constexpr unsigned _propertyListIndices[2] = { 0, 1 }; \
+            static constexpr unsigned _propertySeeds[1] = { 1u }; \
+            static constexpr unsigned _propertyIndices[2] = { 0, 1 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 1u)]), 2u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const Scene* const object, const char* const propName) const noexcept        \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propName)); }                                                         \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const Scene* const object, const unsigned propIndex) const noexcept          \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propIndex)); }                                                        \
+        protected:                                                                                                                             \
+            [[nodiscard]] const void* _getProperty(const void* const object, const char* const propName) const noexcept override               \
+            { return getPropertyImpl(reinterpret_cast<const Scene*>(object), propName); }                                    \
+                                                                                                                                               \
+            [[nodiscard]] const void* _getProperty(const void* const object, const unsigned propIndex) const noexcept override                 \
+            { return getPropertyImpl(reinterpret_cast<const Scene*>(object), propIndex); }                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const Scene* const object, const char* const propName) const noexcept  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const Scene* const object, const unsigned propIndex) const noexcept    \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(Scene* const object, const char* const propName) const noexcept                    \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propName)); }                                                               \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(Scene* const object, const unsigned propIndex) const noexcept                      \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propIndex)); }                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(Scene* const object, const char* const propName, const _T& value) const noexcept                \
+            { return setPropertyImpl(object, propName, &value); }                                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(Scene* const object, const unsigned propIndex, const _T& value) const noexcept                  \
+            { return setPropertyImpl(object, propIndex, &value); }                                                                             \
+        protected:                                                                                                                             \
+            [[nodiscard]] void* _getProperty(void* const object, const char* const propName) const noexcept override                           \
+            { return getPropertyImpl(reinterpret_cast<Scene*>(object), propName); }                                          \
+                                                                                                                                               \
+            [[nodiscard]] void* _getProperty(void* const object, const unsigned propIndex) const noexcept override                             \
+            { return getPropertyImpl(reinterpret_cast<Scene*>(object), propIndex); }                                         \
+                                                                                                                                               \
+            void _setProperty(void* const object, const char* const propName, const void* const value) const noexcept override                 \
+            { return setPropertyImpl(reinterpret_cast<Scene*>(object), propName, value); }                                   \
+                                                                                                                                               \
+            void _setProperty(void* const object, const unsigned propIndex, const void* const value) const noexcept override                   \
+            { return setPropertyImpl(reinterpret_cast<Scene*>(object), propIndex, value); }                                  \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(Scene* const object, const char* const propName) const noexcept              \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(Scene* const object, const unsigned propIndex) const noexcept                \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            void setPropertyImpl(Scene* const object, const char* const propName, const void* const value) const noexcept    \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
+                                                                                                                                               \
+            void setPropertyImpl(Scene* const object, const unsigned propIndex, const void* const value) const noexcept      \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                (void) value;                                                                                                                  \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: break;                                                                                                            \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const Scene* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const Scene* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(Scene* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const Scene*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const Scene*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<Scene*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSchema(const Scene* const object) noexcept                                   \
+            {                                                                                                                                  \
+                unsigned schema = 2u; \
+                schema = _tauSchemaHash(schema, 0x8c13f6dau, 0x33ac0ca7u, static_cast<unsigned>(sizeof(object->_version)), _tauSerialSpan(&object->_version, &object->_version, 0)); \
+                schema = _tauSchemaHash(schema, 0x72e7261bu, 0x231773a0u, 0xFFFFFFFFu, 0xFFFFFFFFu); \
+                return schema;                                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const Scene* const object) noexcept                                 \
+            {                                                                                                                                  \
+                unsigned size = TAU_SERIAL_HEADER_SIZE + 2u * TAU_SERIAL_FIELD_SIZE; \
+                size += _tauSerialSpan(&object->_version, &object->_version, sizeof(object->_version)); \
+                size += TauSerializer<decltype(object->_entities)>::size(object->_entities); \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned serializeImpl(const Scene* const object, void* const buffer, const unsigned capacity) noexcept    \
+            {                                                                                                                                  \
+                static_assert(!::std::is_pointer<decltype(object->_version)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_entities)>::value, "Pointers can't be serialized."); \
+                const unsigned size = serialSizeImpl(object);                                                                                  \
+                if(size > capacity)                                                                                                            \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, serialSchema(object), 2u, size }; \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                                                                                                                                               \
+                unsigned char* const table = static_cast<unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                                     \
+                unsigned char* const data = table + 2u * TAU_SERIAL_FIELD_SIZE; \
+                unsigned offset = 0;                                                                                                           \
+                                                                                                                                               \
+                _tauWriteSerialField(table, 0, 0x8c13f6dau, 0x33ac0ca7u, offset + _tauSerialSpan(&object->_version, &object->_version, 0), static_cast<unsigned>(sizeof(object->_version))); \
+                {                                                                                                                              \
+                    const unsigned span = _tauSerialSpan(&object->_version, &object->_version, sizeof(object->_version)); \
+                    ::std::memcpy(data + offset, &object->_version, span);                                                              \
+                    offset += span;                                                                                                            \
+                }                                                                                                                              \
+                                                                                                                                               \
+                {                                                                                                                              \
+                    const unsigned fieldSize = TauSerializer<decltype(object->_entities)>::size(object->_entities); \
+                    _tauWriteSerialField(table, 1, 0x72e7261bu, 0x231773a0u, offset, fieldSize); \
+                    TauSerializer<decltype(object->_entities)>::write(object->_entities, data + offset);                           \
+                    offset += fieldSize;                                                                                                       \
+                }                                                                                                                              \
+                                                                                                                                               \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(Scene* const object, const void* const buffer, const unsigned size) noexcept      \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                if(!_tauReadSerialHeader(header, buffer, size))                                                                                \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const unsigned char* const table = static_cast<const unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                         \
+                const unsigned char* const data = table + header.fieldCount * TAU_SERIAL_FIELD_SIZE;                                           \
+                const unsigned dataSize = header.size - TAU_SERIAL_HEADER_SIZE - header.fieldCount * TAU_SERIAL_FIELD_SIZE;                    \
+                                                                                                                                               \
+                if(header.schema == serialSchema(object) && header.fieldCount == 2u) \
+                {                                                                                                                              \
+                    TauSerialField field;                                                                                                      \
+                    field = _tauReadSerialField(table, 0); \
+                    {                                                                                                                          \
+                        const unsigned span = _tauSerialSpan(&object->_version, &object->_version, sizeof(object->_version)); \
+                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \
+                        { return 0; }                                                                                                          \
+                        ::std::memcpy(&object->_version, data + field.offset, span);                                                    \
+                    }                                                                                                                          \
+                    field = _tauReadSerialField(table, 1); \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize) ||                                                              \
+                       !TauSerializer<decltype(object->_entities)>::read(object->_entities, data + field.offset, field.size))      \
+                    { return 0; }                                                                                                              \
+                    return header.size;                                                                                                        \
+                }                                                                                                                              \
+                                                                                                                                               \
+                for(unsigned i = 0; i < header.fieldCount; ++i)                                                                                \
+                {                                                                                                                              \
+                    const TauSerialField field = _tauReadSerialField(table, i);                                                                \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize))                                                                \
+                    { return 0; }                                                                                                              \
+                                                                                                                                               \
+                    switch(field.nameHash)                                                                                                     \
+                    {                                                                                                                          \
+                        case 0x8c13f6dau: \
+                            if(field.typeHash == 0x33ac0ca7u) \
+                            { _tauReadSerialCopy(&object->_version, sizeof(object->_version), data, field); } \
+                            break;                                                                                                             \
+                        case 0x72e7261bu: \
+                            if(field.typeHash == 0x231773a0u) \
+                            {                                                                                                                  \
+                                if(!TauSerializer<decltype(object->_entities)>::read(object->_entities, data + field.offset, field.size)) \
+                                { return 0; }                                                                                                  \
+                            }                                                                                                                  \
+                            break;                                                                                                             \
+                        default: break;                                                                                                        \
+                    }                                                                                                                          \
+                }                                                                                                                              \
+                return header.size;                                                                                                            \
+            }                                                                                                                                  \
+        };                                                                         \
+    [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
+    {                                                                              \
+        static TauClassImpl tauClass;                                              \
+        return tauClass;                                                           \
+    }                                                                              \
+    [[nodiscard]] TauClassImpl& getClass() const noexcept                          \
+    { return GetStaticClass(); }                                                   
+// End _TAU_GENERATED_BODY_Scene()
+
+#ifdef _TAU_GENERATED_BODY_SettingsV1
+  #undef _TAU_GENERATED_BODY_SettingsV1
+#endif
+
+#define _TAU_GENERATED_BODY_SettingsV1() \
+    public:                                                                        \
+        class TauClassImpl final : public ITauClass                                \
+        {                                                                          \
+        public:                                                                    \
+            TauClassImpl() noexcept = default;                                     \
+            ~TauClassImpl() noexcept override = default;                           \
+                                                                                   \
+            TauClassImpl(const TauClassImpl& copy) noexcept = default;             \
+            TauClassImpl(TauClassImpl&& move) noexcept = default;                  \
+                                                                                   \
+            TauClassImpl& operator=(const TauClassImpl& copy) noexcept = default;  \
+            TauClassImpl& operator=(TauClassImpl&& move) noexcept = default;       \
+        public:                                                                                            \
+            const char* const * getProperties(unsigned* const count) const noexcept override               \
+            {                                                                                              \
+                static const char* _properties[] = {                                                       \
+                    "_volume",                                                                                              \
+                    "_width",                                                                                              \
+                    "_fullscreen",                                                                                              \
+                    "_legacy"                                                                                               \
+                };                                                                                         \
+                *count = 4;                                                              \
+                return _properties;                                                                        \
+            }                                                                                              \
+                                                                                                           \
+            const char* const * getFunctions(unsigned* const count) const noexcept override                \
+            {                                                                                              \
+                static const char* _functions[] = {                                                        \
+                };                                                                                         \
+                *count = 0;                                                              \
+                return _functions;                                                                         \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
+            {                                                                                              \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
+            {                                                                                              \
+                (void) funcName;                                                                           \
+                return static_cast<unsigned>(-1);                                                          \
+            }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[4] = { "_volume", "_fullscreen", "_legacy", "_width" }; \
+            static constexpr unsigned _propertyLengths[4] = { 7, 11, 7, 6 }; \
+            static constexpr unsigned _propertyListIndices[4] = { 0, 1, 2, 3 }; \
+            static constexpr unsigned _propertySeeds[2] = { 4u, 4u }; \
+            static constexpr unsigned _propertyIndices[4] = { 0, 2, 3, 1 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 2u)]), 4u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const SettingsV1* const object, const char* const propName) const noexcept        \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propName)); }                                                         \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const SettingsV1* const object, const unsigned propIndex) const noexcept          \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propIndex)); }                                                        \
+        protected:                                                                                                                             \
+            [[nodiscard]] const void* _getProperty(const void* const object, const char* const propName) const noexcept override               \
+            { return getPropertyImpl(reinterpret_cast<const SettingsV1*>(object), propName); }                                    \
+                                                                                                                                               \
+            [[nodiscard]] const void* _getProperty(const void* const object, const unsigned propIndex) const noexcept override                 \
+            { return getPropertyImpl(reinterpret_cast<const SettingsV1*>(object), propIndex); }                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const SettingsV1* const object, const char* const propName) const noexcept  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const SettingsV1* const object, const unsigned propIndex) const noexcept    \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(SettingsV1* const object, const char* const propName) const noexcept                    \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propName)); }                                                               \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(SettingsV1* const object, const unsigned propIndex) const noexcept                      \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propIndex)); }                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(SettingsV1* const object, const char* const propName, const _T& value) const noexcept                \
+            { return setPropertyImpl(object, propName, &value); }                                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(SettingsV1* const object, const unsigned propIndex, const _T& value) const noexcept                  \
+            { return setPropertyImpl(object, propIndex, &value); }                                                                             \
+        protected:                                                                                                                             \
+            [[nodiscard]] void* _getProperty(void* const object, const char* const propName) const noexcept override                           \
+            { return getPropertyImpl(reinterpret_cast<SettingsV1*>(object), propName); }                                          \
+                                                                                                                                               \
+            [[nodiscard]] void* _getProperty(void* const object, const unsigned propIndex) const noexcept override                             \
+            { return getPropertyImpl(reinterpret_cast<SettingsV1*>(object), propIndex); }                                         \
+                                                                                                                                               \
+            void _setProperty(void* const object, const char* const propName, const void* const value) const noexcept override                 \
+            { return setPropertyImpl(reinterpret_cast<SettingsV1*>(object), propName, value); }                                   \
+                                                                                                                                               \
+            void _setProperty(void* const object, const unsigned propIndex, const void* const value) const noexcept override                   \
+            { return setPropertyImpl(reinterpret_cast<SettingsV1*>(object), propIndex, value); }                                  \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(SettingsV1* const object, const char* const propName) const noexcept              \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(SettingsV1* const object, const unsigned propIndex) const noexcept                \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            void setPropertyImpl(SettingsV1* const object, const char* const propName, const void* const value) const noexcept    \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
+                                                                                                                                               \
+            void setPropertyImpl(SettingsV1* const object, const unsigned propIndex, const void* const value) const noexcept      \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                (void) value;                                                                                                                  \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: break;                                                                                                            \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const SettingsV1* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const SettingsV1* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(SettingsV1* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const SettingsV1*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const SettingsV1*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<SettingsV1*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSchema(const SettingsV1* const object) noexcept                                   \
+            {                                                                                                                                  \
+                unsigned schema = 4u; \
+                schema = _tauSchemaHash(schema, 0x0f338468u, 0xdd25da60u, static_cast<unsigned>(sizeof(object->_volume)), _tauSerialSpan(&object->_volume, &object->_volume, 0)); \
+                schema = _tauSchemaHash(schema, 0x0080217bu, 0x3eb35900u, static_cast<unsigned>(sizeof(object->_width)), _tauSerialSpan(&object->_volume, &object->_width, 0)); \
+                schema = _tauSchemaHash(schema, 0xf75595c2u, 0x10295a20u, static_cast<unsigned>(sizeof(object->_fullscreen)), _tauSerialSpan(&object->_volume, &object->_fullscreen, 0)); \
+                schema = _tauSchemaHash(schema, 0x17148c5fu, 0x49924522u, static_cast<unsigned>(sizeof(object->_legacy)), _tauSerialSpan(&object->_volume, &object->_legacy, 0)); \
+                return schema;                                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const SettingsV1* const object) noexcept                                 \
+            {                                                                                                                                  \
+                unsigned size = TAU_SERIAL_HEADER_SIZE + 4u * TAU_SERIAL_FIELD_SIZE; \
+                size += _tauSerialSpan(&object->_volume, &object->_legacy, sizeof(object->_legacy)); \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned serializeImpl(const SettingsV1* const object, void* const buffer, const unsigned capacity) noexcept    \
+            {                                                                                                                                  \
+                static_assert(!::std::is_pointer<decltype(object->_volume)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_width)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_fullscreen)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_legacy)>::value, "Pointers can't be serialized."); \
+                const unsigned size = serialSizeImpl(object);                                                                                  \
+                if(size > capacity)                                                                                                            \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, serialSchema(object), 4u, size }; \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                                                                                                                                               \
+                unsigned char* const table = static_cast<unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                                     \
+                unsigned char* const data = table + 4u * TAU_SERIAL_FIELD_SIZE; \
+                unsigned offset = 0;                                                                                                           \
+                                                                                                                                               \
+                _tauWriteSerialField(table, 0, 0x0f338468u, 0xdd25da60u, offset + _tauSerialSpan(&object->_volume, &object->_volume, 0), static_cast<unsigned>(sizeof(object->_volume))); \
+                _tauWriteSerialField(table, 1, 0x0080217bu, 0x3eb35900u, offset + _tauSerialSpan(&object->_volume, &object->_width, 0), static_cast<unsigned>(sizeof(object->_width))); \
+                _tauWriteSerialField(table, 2, 0xf75595c2u, 0x10295a20u, offset + _tauSerialSpan(&object->_volume, &object->_fullscreen, 0), static_cast<unsigned>(sizeof(object->_fullscreen))); \
+                _tauWriteSerialField(table, 3, 0x17148c5fu, 0x49924522u, offset + _tauSerialSpan(&object->_volume, &object->_legacy, 0), static_cast<unsigned>(sizeof(object->_legacy))); \
+                {                                                                                                                              \
+                    const unsigned span = _tauSerialSpan(&object->_volume, &object->_legacy, sizeof(object->_legacy)); \
+                    ::std::memcpy(data + offset, &object->_volume, span);                                                              \
+                    offset += span;                                                                                                            \
+                }                                                                                                                              \
+                                                                                                                                               \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(SettingsV1* const object, const void* const buffer, const unsigned size) noexcept      \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                if(!_tauReadSerialHeader(header, buffer, size))                                                                                \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const unsigned char* const table = static_cast<const unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                         \
+                const unsigned char* const data = table + header.fieldCount * TAU_SERIAL_FIELD_SIZE;                                           \
+                const unsigned dataSize = header.size - TAU_SERIAL_HEADER_SIZE - header.fieldCount * TAU_SERIAL_FIELD_SIZE;                    \
+                                                                                                                                               \
+                if(header.schema == serialSchema(object) && header.fieldCount == 4u) \
+                {                                                                                                                              \
+                    TauSerialField field;                                                                                                      \
+                    field = _tauReadSerialField(table, 0); \
+                    {                                                                                                                          \
+                        const unsigned span = _tauSerialSpan(&object->_volume, &object->_legacy, sizeof(object->_legacy)); \
+                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \
+                        { return 0; }                                                                                                          \
+                        ::std::memcpy(&object->_volume, data + field.offset, span);                                                    \
+                    }                                                                                                                          \
+                    return header.size;                                                                                                        \
+                }                                                                                                                              \
+                                                                                                                                               \
+                for(unsigned i = 0; i < header.fieldCount; ++i)                                                                                \
+                {                                                                                                                              \
+                    const TauSerialField field = _tauReadSerialField(table, i);                                                                \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize))                                                                \
+                    { return 0; }                                                                                                              \
+                                                                                                                                               \
+                    switch(field.nameHash)                                                                                                     \
+                    {                                                                                                                          \
+                        case 0x0f338468u: \
+                            if(field.typeHash == 0xdd25da60u) \
+                            { _tauReadSerialCopy(&object->_volume, sizeof(object->_volume), data, field); } \
+                            break;                                                                                                             \
+                        case 0x0080217bu: \
+                            if(field.typeHash == 0x3eb35900u) \
+                            { _tauReadSerialCopy(&object->_width, sizeof(object->_width), data, field); } \
+                            break;                                                                                                             \
+                        case 0xf75595c2u: \
+                            if(field.typeHash == 0x10295a20u) \
+                            { _tauReadSerialCopy(&object->_fullscreen, sizeof(object->_fullscreen), data, field); } \
+                            break;                                                                                                             \
+                        case 0x17148c5fu: \
+                            if(field.typeHash == 0x49924522u) \
+                            { _tauReadSerialCopy(&object->_legacy, sizeof(object->_legacy), data, field); } \
+                            break;                                                                                                             \
+                        default: break;                                                                                                        \
+                    }                                                                                                                          \
+                }                                                                                                                              \
+                return header.size;                                                                                                            \
+            }                                                                                                                                  \
+        };                                                                         \
+    [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
+    {                                                                              \
+        static TauClassImpl tauClass;                                              \
+        return tauClass;                                                           \
+    }                                                                              \
+    [[nodiscard]] TauClassImpl& getClass() const noexcept                          \
+    { return GetStaticClass(); }                                                   
+// End _TAU_GENERATED_BODY_SettingsV1()
+
+#ifdef _TAU_GENERATED_BODY_SettingsV2
+  #undef _TAU_GENERATED_BODY_SettingsV2
+#endif
+
+#define _TAU_GENERATED_BODY_SettingsV2() \
+    public:                                                                        \
+        class TauClassImpl final : public ITauClass                                \
+        {                                                                          \
+        public:                                                                    \
+            TauClassImpl() noexcept = default;                                     \
+            ~TauClassImpl() noexcept override = default;                           \
+                                                                                   \
+            TauClassImpl(const TauClassImpl& copy) noexcept = default;             \
+            TauClassImpl(TauClassImpl&& move) noexcept = default;                  \
+                                                                                   \
+            TauClassImpl& operator=(const TauClassImpl& copy) noexcept = default;  \
+            TauClassImpl& operator=(TauClassImpl&& move) noexcept = default;       \
+        public:                                                                                            \
+            const char* const * getProperties(unsigned* const count) const noexcept override               \
+            {                                                                                              \
+                static const char* _properties[] = {                                                       \
+                    "_width",                                                                                              \
+                    "_height",                                                                                              \
+                    "_volume",                                                                                              \
+                    "_fullscreen"                                                                                               \
+                };                                                                                         \
+                *count = 4;                                                              \
+                return _properties;                                                                        \
+            }                                                                                              \
+                                                                                                           \
+            const char* const * getFunctions(unsigned* const count) const noexcept override                \
+            {                                                                                              \
+                static const char* _functions[] = {                                                        \
+                };                                                                                         \
+                *count = 0;                                                              \
+                return _functions;                                                                         \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getPropertyIndex(const char* const propName) const noexcept override    \
+            {                                                                                              \
+                const unsigned index = propertyIndexImpl(propName);                                        \
+                return index == static_cast<unsigned>(-1) ? index : _propertyListIndices[index];           \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] unsigned getFunctionIndex(const char* const funcName) const noexcept override    \
+            {                                                                                              \
+                (void) funcName;                                                                           \
+                return static_cast<unsigned>(-1);                                                          \
+            }                                                                                              \
+        private:                                                                                           \
+            static constexpr const char* _propertyNames[4] = { "_height", "_volume", "_width", "_fullscreen" }; \
+            static constexpr unsigned _propertyLengths[4] = { 7, 7, 6, 11 }; \
+            static constexpr unsigned _propertyListIndices[4] = { 0, 1, 2, 3 }; \
+            static constexpr unsigned _propertySeeds[2] = { 1u, 1u }; \
+            static constexpr unsigned _propertyIndices[4] = { 1, 2, 0, 3 }; \
+                                                                                                           \
+            [[nodiscard]] static constexpr unsigned _propertySlot(const char* const propName, const unsigned length) noexcept \
+            {                                                                                              \
+                const unsigned hash = _tauNameHash(propName, length);                                      \
+                return _tauReduce(_tauSlotHash(hash, _propertySeeds[_tauReduce(hash, 2u)]), 4u); \
+            }                                                                                              \
+        public:                                                                                            \
+            [[nodiscard]] static constexpr unsigned PropertyIndex(const char* const propName) noexcept     \
+            {                                                                                              \
+                const unsigned length = _tauNameLength(propName);                                          \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || !_tauNameEquals(propName, _propertyNames[slot], length)) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+                                                                                                           \
+            [[nodiscard]] static unsigned propertyIndexImpl(const char* const propName) noexcept           \
+            {                                                                                              \
+                const unsigned length = static_cast<unsigned>(::std::strlen(propName));                    \
+                const unsigned slot = _propertySlot(propName, length);                                     \
+                if(length != _propertyLengths[slot] || ::std::memcmp(propName, _propertyNames[slot], length) != 0) \
+                { return static_cast<unsigned>(-1); }                                                      \
+                return _propertyIndices[slot];                                                             \
+            }                                                                                              \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const SettingsV2* const object, const char* const propName) const noexcept        \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propName)); }                                                         \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] const _T* getProperty(const SettingsV2* const object, const unsigned propIndex) const noexcept          \
+            { return reinterpret_cast<const _T*>(getPropertyImpl(object, propIndex)); }                                                        \
+        protected:                                                                                                                             \
+            [[nodiscard]] const void* _getProperty(const void* const object, const char* const propName) const noexcept override               \
+            { return getPropertyImpl(reinterpret_cast<const SettingsV2*>(object), propName); }                                    \
+                                                                                                                                               \
+            [[nodiscard]] const void* _getProperty(const void* const object, const unsigned propIndex) const noexcept override                 \
+            { return getPropertyImpl(reinterpret_cast<const SettingsV2*>(object), propIndex); }                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const SettingsV2* const object, const char* const propName) const noexcept  \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] const void* getPropertyImpl(const SettingsV2* const object, const unsigned propIndex) const noexcept    \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(SettingsV2* const object, const char* const propName) const noexcept                    \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propName)); }                                                               \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            [[nodiscard]] _T* getProperty(SettingsV2* const object, const unsigned propIndex) const noexcept                      \
+            { return reinterpret_cast<_T*>(getPropertyImpl(object, propIndex)); }                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(SettingsV2* const object, const char* const propName, const _T& value) const noexcept                \
+            { return setPropertyImpl(object, propName, &value); }                                                                              \
+                                                                                                                                               \
+            template<typename _T>                                                                                                              \
+            void setProperty(SettingsV2* const object, const unsigned propIndex, const _T& value) const noexcept                  \
+            { return setPropertyImpl(object, propIndex, &value); }                                                                             \
+        protected:                                                                                                                             \
+            [[nodiscard]] void* _getProperty(void* const object, const char* const propName) const noexcept override                           \
+            { return getPropertyImpl(reinterpret_cast<SettingsV2*>(object), propName); }                                          \
+                                                                                                                                               \
+            [[nodiscard]] void* _getProperty(void* const object, const unsigned propIndex) const noexcept override                             \
+            { return getPropertyImpl(reinterpret_cast<SettingsV2*>(object), propIndex); }                                         \
+                                                                                                                                               \
+            void _setProperty(void* const object, const char* const propName, const void* const value) const noexcept override                 \
+            { return setPropertyImpl(reinterpret_cast<SettingsV2*>(object), propName, value); }                                   \
+                                                                                                                                               \
+            void _setProperty(void* const object, const unsigned propIndex, const void* const value) const noexcept override                   \
+            { return setPropertyImpl(reinterpret_cast<SettingsV2*>(object), propIndex, value); }                                  \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(SettingsV2* const object, const char* const propName) const noexcept              \
+            { return getPropertyImpl(object, propertyIndexImpl(propName)); }                                                                   \
+                                                                                                                                               \
+            [[nodiscard]] void* getPropertyImpl(SettingsV2* const object, const unsigned propIndex) const noexcept                \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: return nullptr;                                                                                                   \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            void setPropertyImpl(SettingsV2* const object, const char* const propName, const void* const value) const noexcept    \
+            { setPropertyImpl(object, propertyIndexImpl(propName), value); }                                                                   \
+                                                                                                                                               \
+            void setPropertyImpl(SettingsV2* const object, const unsigned propIndex, const void* const value) const noexcept      \
+            {                                                                                                                                  \
+                (void) object;                                                                                                                 \
+                (void) value;                                                                                                                  \
+                switch(propIndex)                                                                                                              \
+                {                                                                                                                              \
+                    default: break;                                                                                                            \
+                }                                                                                                                              \
+            }                                                                                                                                  \
+        public:                                                                                                                                \
+            [[nodiscard]] unsigned serialSize(const SettingsV2* const object) const noexcept                                      \
+            { return serialSizeImpl(object); }                                                                                                 \
+                                                                                                                                               \
+            unsigned serialize(const SettingsV2* const object, void* const buffer, const unsigned capacity) const noexcept         \
+            { return serializeImpl(object, buffer, capacity); }                                                                                \
+                                                                                                                                               \
+            unsigned deserialize(SettingsV2* const object, const void* const buffer, const unsigned size) const noexcept           \
+            { return deserializeImpl(object, buffer, size); }                                                                                  \
+        protected:                                                                                                                             \
+            [[nodiscard]] unsigned _serialSize(const void* const object) const noexcept override                                               \
+            { return serialSizeImpl(reinterpret_cast<const SettingsV2*>(object)); }                                               \
+                                                                                                                                               \
+            unsigned _serialize(const void* const object, void* const buffer, const unsigned capacity) const noexcept override                 \
+            { return serializeImpl(reinterpret_cast<const SettingsV2*>(object), buffer, capacity); }                              \
+                                                                                                                                               \
+            unsigned _deserialize(void* const object, const void* const buffer, const unsigned size) const noexcept override                   \
+            { return deserializeImpl(reinterpret_cast<SettingsV2*>(object), buffer, size); }                                      \
+        private:                                                                                                                               \
+            [[nodiscard]] static unsigned serialSchema(const SettingsV2* const object) noexcept                                   \
+            {                                                                                                                                  \
+                unsigned schema = 4u; \
+                schema = _tauSchemaHash(schema, 0x0080217bu, 0x3eb35900u, static_cast<unsigned>(sizeof(object->_width)), _tauSerialSpan(&object->_width, &object->_width, 0)); \
+                schema = _tauSchemaHash(schema, 0x9dd87dd5u, 0x3eb35900u, static_cast<unsigned>(sizeof(object->_height)), _tauSerialSpan(&object->_width, &object->_height, 0)); \
+                schema = _tauSchemaHash(schema, 0x0f338468u, 0xdd25da60u, static_cast<unsigned>(sizeof(object->_volume)), _tauSerialSpan(&object->_width, &object->_volume, 0)); \
+                schema = _tauSchemaHash(schema, 0xf75595c2u, 0x10295a20u, static_cast<unsigned>(sizeof(object->_fullscreen)), _tauSerialSpan(&object->_width, &object->_fullscreen, 0)); \
+                return schema;                                                                                                                 \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            [[nodiscard]] static unsigned serialSizeImpl(const SettingsV2* const object) noexcept                                 \
+            {                                                                                                                                  \
+                unsigned size = TAU_SERIAL_HEADER_SIZE + 4u * TAU_SERIAL_FIELD_SIZE; \
+                size += _tauSerialSpan(&object->_width, &object->_fullscreen, sizeof(object->_fullscreen)); \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned serializeImpl(const SettingsV2* const object, void* const buffer, const unsigned capacity) noexcept    \
+            {                                                                                                                                  \
+                static_assert(!::std::is_pointer<decltype(object->_width)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_height)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_volume)>::value, "Pointers can't be serialized."); \
+                static_assert(!::std::is_pointer<decltype(object->_fullscreen)>::value, "Pointers can't be serialized."); \
+                const unsigned size = serialSizeImpl(object);                                                                                  \
+                if(size > capacity)                                                                                                            \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const TauSerialHeader header { TAU_SERIAL_MAGIC, serialSchema(object), 4u, size }; \
+                ::std::memcpy(buffer, &header, TAU_SERIAL_HEADER_SIZE);                                                                        \
+                                                                                                                                               \
+                unsigned char* const table = static_cast<unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                                     \
+                unsigned char* const data = table + 4u * TAU_SERIAL_FIELD_SIZE; \
+                unsigned offset = 0;                                                                                                           \
+                                                                                                                                               \
+                _tauWriteSerialField(table, 0, 0x0080217bu, 0x3eb35900u, offset + _tauSerialSpan(&object->_width, &object->_width, 0), static_cast<unsigned>(sizeof(object->_width))); \
+                _tauWriteSerialField(table, 1, 0x9dd87dd5u, 0x3eb35900u, offset + _tauSerialSpan(&object->_width, &object->_height, 0), static_cast<unsigned>(sizeof(object->_height))); \
+                _tauWriteSerialField(table, 2, 0x0f338468u, 0xdd25da60u, offset + _tauSerialSpan(&object->_width, &object->_volume, 0), static_cast<unsigned>(sizeof(object->_volume))); \
+                _tauWriteSerialField(table, 3, 0xf75595c2u, 0x10295a20u, offset + _tauSerialSpan(&object->_width, &object->_fullscreen, 0), static_cast<unsigned>(sizeof(object->_fullscreen))); \
+                {                                                                                                                              \
+                    const unsigned span = _tauSerialSpan(&object->_width, &object->_fullscreen, sizeof(object->_fullscreen)); \
+                    ::std::memcpy(data + offset, &object->_width, span);                                                              \
+                    offset += span;                                                                                                            \
+                }                                                                                                                              \
+                                                                                                                                               \
+                return size;                                                                                                                   \
+            }                                                                                                                                  \
+                                                                                                                                               \
+            static unsigned deserializeImpl(SettingsV2* const object, const void* const buffer, const unsigned size) noexcept      \
+            {                                                                                                                                  \
+                TauSerialHeader header;                                                                                                        \
+                if(!_tauReadSerialHeader(header, buffer, size))                                                                                \
+                { return 0; }                                                                                                                  \
+                                                                                                                                               \
+                const unsigned char* const table = static_cast<const unsigned char*>(buffer) + TAU_SERIAL_HEADER_SIZE;                         \
+                const unsigned char* const data = table + header.fieldCount * TAU_SERIAL_FIELD_SIZE;                                           \
+                const unsigned dataSize = header.size - TAU_SERIAL_HEADER_SIZE - header.fieldCount * TAU_SERIAL_FIELD_SIZE;                    \
+                                                                                                                                               \
+                if(header.schema == serialSchema(object) && header.fieldCount == 4u) \
+                {                                                                                                                              \
+                    TauSerialField field;                                                                                                      \
+                    field = _tauReadSerialField(table, 0); \
+                    {                                                                                                                          \
+                        const unsigned span = _tauSerialSpan(&object->_width, &object->_fullscreen, sizeof(object->_fullscreen)); \
+                        if(!_tauSerialInBounds(field.offset, span, dataSize))                                                                  \
+                        { return 0; }                                                                                                          \
+                        ::std::memcpy(&object->_width, data + field.offset, span);                                                    \
+                    }                                                                                                                          \
+                    return header.size;                                                                                                        \
+                }                                                                                                                              \
+                                                                                                                                               \
+                for(unsigned i = 0; i < header.fieldCount; ++i)                                                                                \
+                {                                                                                                                              \
+                    const TauSerialField field = _tauReadSerialField(table, i);                                                                \
+                    if(!_tauSerialInBounds(field.offset, field.size, dataSize))                                                                \
+                    { return 0; }                                                                                                              \
+                                                                                                                                               \
+                    switch(field.nameHash)                                                                                                     \
+                    {                                                                                                                          \
+                        case 0x0080217bu: \
+                            if(field.typeHash == 0x3eb35900u) \
+                            { _tauReadSerialCopy(&object->_width, sizeof(object->_width), data, field); } \
+                            break;                                                                                                             \
+                        case 0x9dd87dd5u: \
+                            if(field.typeHash == 0x3eb35900u) \
+                            { _tauReadSerialCopy(&object->_height, sizeof(object->_height), data, field); } \
+                            break;                                                                                                             \
+                        case 0x0f338468u: \
+                            if(field.typeHash == 0xdd25da60u) \
+                            { _tauReadSerialCopy(&object->_volume, sizeof(object->_volume), data, field); } \
+                            break;                                                                                                             \
+                        case 0xf75595c2u: \
+                            if(field.typeHash == 0x10295a20u) \
+                            { _tauReadSerialCopy(&object->_fullscreen, sizeof(object->_fullscreen), data, field); } \
+                            break;                                                                                                             \
+                        default: break;                                                                                                        \
+                    }                                                                                                                          \
+                }                                                                                                                              \
+                return header.size;                                                                                                            \
+            }                                                                                                                                  \
+        };                                                                         \
+    [[nodiscard]] static TauClassImpl& GetStaticClass() noexcept                   \
+    {                                                                              \
+        static TauClassImpl tauClass;                                              \
+        return tauClass;                                                           \
+    }                                                                              \
+    [[nodiscard]] TauClassImpl& getClass() const noexcept                          \
+    { return GetStaticClass(); }                                                   
+// End _TAU_GENERATED_BODY_SettingsV2()
+
@@ -2,6 +2,92 @@
 
 #include "Base.hpp"
 #include "Test.generated.hpp"
+#include <vector>
+
+/**
+ *   Trivially copyable elements are copied in one go, anything
+ * else is written with its size in front.
+ */
+template<typename _T>
+struct TauSerializer<std::vector<_T>> final
+{
+    [[nodiscard]] static unsigned size(const std::vector<_T>& value) noexcept
+    {
+        if constexpr(std::is_trivially_copyable<_T>::value)
+        { return static_cast<unsigned>(sizeof(unsigned) + value.size() * sizeof(_T)); }
+        else
+        {
+            unsigned size = sizeof(unsigned);
+            for(const _T& element : value)
+            { size += sizeof(unsigned) + TauSerializer<_T>::size(element); }
+            return size;
+        }
+    }
+
+    static void write(const std::vector<_T>& value, unsigned char* buffer) noexcept
+    {
+        const unsigned count = static_cast<unsigned>(value.size());
+        std::memcpy(buffer, &count, sizeof(count));
+        buffer += sizeof(count);
+
+        if constexpr(std::is_trivially_copyable<_T>::value)
+        {
+            if(!value.empty())
+            { std::memcpy(buffer, value.data(), value.size() * sizeof(_T)); }
+        }
+        else
+        {
+            for(const _T& element : value)
+            {
+                const unsigned elementSize = TauSerializer<_T>::size(element);
+                std::memcpy(buffer, &elementSize, sizeof(elementSize));
+                TauSerializer<_T>::write(element, buffer + sizeof(elementSize));
+                buffer += sizeof(elementSize) + elementSize;
+            }
+        }
+    }
+
+    [[nodiscard]] static bool read(std::vector<_T>& value, const unsigned char* buffer, unsigned size) noexcept
+    {
+        unsigned count;
+        if(size < sizeof(count))
+        { return false; }
+        std::memcpy(&count, buffer, sizeof(count));
+        buffer += sizeof(count);
+        size -= sizeof(count);
+
+        if constexpr(std::is_trivially_copyable<_T>::value)
+        {
+            if(size != count * sizeof(_T) || size / sizeof(_T) != count)
+            { return false; }
+            value.resize(count);
+            if(count)
+            { std::memcpy(value.data(), buffer, size); }
+        }
+        else
+        {
+            // Every element takes at least its size.
+            if(count > size / sizeof(unsigned))
+            { return false; }
+            value.resize(count);
+            for(_T& element : value)
+            {
+                unsigned elementSize;
+                if(size < sizeof(elementSize))
+                { return false; }
+                std::memcpy(&elementSize, buffer, sizeof(elementSize));
+                buffer += sizeof(elementSize);
+                size -= sizeof(elementSize);
+
+                if(elementSize > size || !TauSerializer<_T>::read(element, buffer, elementSize))
+                { return false; }
+                buffer += elementSize;
+                size -= elementSize;
+            }
+        }
+        return true;
+    }
+};
 
 struct Vector
 {
@@ -47,3 +133,77 @@ public:
     int testFunc() const noexcept { return 0; }
 };
 
+TAU_CLASS()
+class Transform
+{
+    TAU_GENERATED_BODY(Transform)
+public:
+    TAU_PROPERTY(serialize)
+    Vector _position { 0.0f, 0.0f, 0.0f };
+    TAU_PROPERTY(serialize)
+    Vector _scale { 1.0f, 1.0f, 1.0f };
+    TAU_PROPERTY(serialize)
+    float _rotation[4] { 0.0f, 0.0f, 0.0f, 1.0f };
+};
+
+TAU_CLASS()
+class Entity
+{
+    TAU_GENERATED_BODY(Entity)
+public:
+    TAU_PROPERTY(serialize)
+    unsigned _id = 0;
+    TAU_PROPERTY(serialize)
+    unsigned _flags = 0;
+    TAU_PROPERTY(serialize)
+    Transform _transform;
+    float _distance = 0.0f;
+    TAU_PROPERTY(serialize)
+    float _mass = 1.0f;
+    TAU_PROPERTY(serialize)
+    std::vector<unsigned> _children;
+};
+
+TAU_CLASS()
+class Scene
+{
+    TAU_GENERATED_BODY(Scene)
+public:
+    TAU_PROPERTY(serialize)
+    unsigned _version = 1;
+    TAU_PROPERTY(serialize)
+    std::vector<Entity> _entities;
+};
+
+TAU_CLASS()
+class SettingsV1
+{
+    TAU_GENERATED_BODY(SettingsV1)
+public:
+    TAU_PROPERTY(serialize)
+    float _volume = 0.5f;
+    TAU_PROPERTY(serialize)
+    int _width = 1280;
+    TAU_PROPERTY(serialize)
+    bool _fullscreen = false;
+    TAU_PROPERTY(serialize)
+    double _legacy = 0.0;
+};
+
+/**
+ * SettingsV1 with _legacy removed, _height added and the rest reordered.
+ */
+TAU_CLASS()
+class SettingsV2
+{
+    TAU_GENERATED_BODY(SettingsV2)
+public:
+    TAU_PROPERTY(serialize)
+    int _width = 1280;
+    TAU_PROPERTY(serialize)
+    int _height = 720;
+    TAU_PROPERTY(serialize)
+    float _volume = 0.5f;
+    TAU_PROPERTY(serialize)
+    bool _fullscreen = false;
+};